@@ -0,0 +1,235 @@
+#include "bbox-pruning.hpp"
+
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/function/table/table_scan.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/parser/constraints/check_constraint.hpp"
+#include "duckdb/parser/expression/columnref_expression.hpp"
+#include "duckdb/parser/expression/comparison_expression.hpp"
+#include "duckdb/parser/expression/function_expression.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckdb/planner/filter/conjunction_filter.hpp"
+#include "duckdb/planner/filter/constant_filter.hpp"
+#include "duckdb/planner/filter/null_filter.hpp"
+#include "duckdb/planner/operator/logical_filter.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+#include "geo-functions.hpp"
+#include "geometry.hpp"
+
+namespace duckdb {
+
+//! The predicates that can only hold when the boxes of their arguments intersect (grown by the distance for
+//! ST_DWITHIN), all of them are planar like the box columns
+static bool IsBoxPredicate(const string &name) {
+	static const std::unordered_set<string> predicates {"st_intersects", "st_contains", "st_within",
+	                                                    "st_covers",     "st_coveredby", "st_touches",
+	                                                    "st_equals",     "st_dwithin"};
+	return predicates.find(name) != predicates.end();
+}
+
+//! Name of the table column a column reference in the output of the scan reads
+static bool FindTableColumn(Expression &expr, LogicalGet &get, string &result) {
+	if (expr.GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+		return false;
+	}
+	auto &colref = (BoundColumnRefExpression &)expr;
+	if (colref.depth > 0 || colref.binding.table_index != get.table_index) {
+		return false;
+	}
+	auto idx = colref.binding.column_index;
+	auto column_id = get.column_ids[get.projection_ids.empty() ? idx : get.projection_ids[idx]];
+	if (column_id == COLUMN_IDENTIFIER_ROW_ID) {
+		return false;
+	}
+	result = get.names[column_id];
+	return true;
+}
+
+//! Matches a predicate between a geography column of the scan and a constant, giving the box the rows must overlap
+static bool MatchBoxCondition(ClientContext &context, Expression &expr, LogicalGet &get, string &column, GBOX &box) {
+	if (expr.GetExpressionClass() != ExpressionClass::BOUND_FUNCTION) {
+		return false;
+	}
+	auto &func = (BoundFunctionExpression &)expr;
+	if (!IsBoxPredicate(func.function.name)) {
+		return false;
+	}
+	// The geography ST_DWITHIN measures its distance in meters, which doesn't grow a box in degrees
+	bool dwithin = func.function.name == "st_dwithin";
+	if (func.children.size() != (dwithin ? 3 : 2)) {
+		return false;
+	}
+	// The overloads on the columnar types take no WKB constant, and no box columns go with their arguments
+	if (!GeoTypes::IsGeography(func.children[0]->return_type) ||
+	    !GeoTypes::IsGeography(func.children[1]->return_type)) {
+		return false;
+	}
+	idx_t constant_idx;
+	if (FindTableColumn(*func.children[0], get, column)) {
+		constant_idx = 1;
+	} else if (FindTableColumn(*func.children[1], get, column)) {
+		constant_idx = 0;
+	} else {
+		return false;
+	}
+	if (!func.children[constant_idx]->IsFoldable() || (dwithin && !func.children[2]->IsFoldable())) {
+		return false;
+	}
+
+	auto value = ExpressionExecutor::EvaluateScalar(context, *func.children[constant_idx]);
+	if (value.IsNull()) {
+		return false;
+	}
+	auto &blob = StringValue::Get(value);
+	int32_t srid;
+	if (!Geometry::GetBoundingBox(string_t(blob), box, srid)) {
+		// Nothing matches an empty geometry, but leave that to the predicate itself
+		return false;
+	}
+	if (dwithin) {
+		auto distance = ExpressionExecutor::EvaluateScalar(context, *func.children[2]);
+		if (distance.IsNull()) {
+			return false;
+		}
+		auto tolerance = DoubleValue::Get(distance.DefaultCastAs(LogicalType::DOUBLE));
+		if (!(tolerance >= 0)) {
+			return false;
+		}
+		box.xmin -= tolerance;
+		box.ymin -= tolerance;
+		box.xmax += tolerance;
+		box.ymax += tolerance;
+	}
+	return true;
+}
+
+static bool IsColumnRef(const ParsedExpression &expr, const string &name) {
+	return expr.GetExpressionClass() == ExpressionClass::COLUMN_REF &&
+	       StringUtil::CIEquals(((const ColumnRefExpression &)expr).GetColumnName(), name);
+}
+
+//! Whether expr is side(column), ST_XMIN(g) for the g_xmin column of g
+static bool IsBoxFunction(const ParsedExpression &expr, const string &side, const string &column) {
+	if (expr.GetExpressionClass() != ExpressionClass::FUNCTION) {
+		return false;
+	}
+	auto &func = (const FunctionExpression &)expr;
+	return StringUtil::CIEquals(func.function_name, "st_" + side) && func.children.size() == 1 &&
+	       IsColumnRef(*func.children[0], column);
+}
+
+//! Whether a CHECK constraint of the table keeps a box column equal to side(column). The constraint is verified on
+//! every insert and update of either column, so the statistics of the box column can be trusted; a box column that is
+//! NULL next to a geometry passes it, and such rows are kept by the filters
+static bool HasBoxConstraint(TableCatalogEntry &table, const string &box_column, const string &side,
+                             const string &column) {
+	for (auto &constraint : table.GetConstraints()) {
+		if (constraint->type != ConstraintType::CHECK) {
+			continue;
+		}
+		auto &check = (CheckConstraint &)*constraint;
+		if (check.expression->type != ExpressionType::COMPARE_EQUAL &&
+		    check.expression->type != ExpressionType::COMPARE_NOT_DISTINCT_FROM) {
+			continue;
+		}
+		auto &comparison = (ComparisonExpression &)*check.expression;
+		if ((IsColumnRef(*comparison.left, box_column) && IsBoxFunction(*comparison.right, side, column)) ||
+		    (IsColumnRef(*comparison.right, box_column) && IsBoxFunction(*comparison.left, side, column))) {
+			return true;
+		}
+	}
+	return false;
+}
+
+//! The DOUBLE table column holding one side of the boxes of a geography column, kept in sync by a CHECK constraint
+static bool FindBoxColumn(LogicalGet &get, TableCatalogEntry &table, const string &column, const string &side,
+                          column_t &result) {
+	auto name = column + "_" + side;
+	for (result = 0; result < get.names.size(); result++) {
+		if (StringUtil::CIEquals(get.names[result], name)) {
+			return get.returned_types[result] == LogicalType::DOUBLE &&
+			       HasBoxConstraint(table, get.names[result], side, column);
+		}
+	}
+	return false;
+}
+
+//! Position of a table column in the column ids of the scan, adding it when the scan doesn't read it yet
+static idx_t GetScanColumn(LogicalGet &get, column_t column_id) {
+	for (idx_t i = 0; i < get.column_ids.size(); i++) {
+		if (get.column_ids[i] == column_id) {
+			return i;
+		}
+	}
+	// A column that is only read for the filter stays out of the output of the scan
+	if (get.projection_ids.empty()) {
+		for (idx_t i = 0; i < get.column_ids.size(); i++) {
+			get.projection_ids.push_back(i);
+		}
+	}
+	get.column_ids.push_back(column_id);
+	return get.column_ids.size() - 1;
+}
+
+//! One side of the box of a row against the query box, or no box for the row: the geometry predicate decides then
+static unique_ptr<TableFilter> MakeBoxFilter(ExpressionType comparison, double bound) {
+	auto filter = make_unique<ConjunctionOrFilter>();
+	filter->child_filters.push_back(make_unique<ConstantFilter>(comparison, Value::DOUBLE(bound)));
+	filter->child_filters.push_back(make_unique<IsNullFilter>());
+	return move(filter);
+}
+
+static void PushBoxFilters(LogicalGet &get, const string &column, const GBOX &box) {
+	auto &table = *((TableScanBindData &)*get.bind_data).table;
+	column_t xmin, ymin, xmax, ymax;
+	if (!FindBoxColumn(get, table, column, "xmin", xmin) || !FindBoxColumn(get, table, column, "ymin", ymin) ||
+	    !FindBoxColumn(get, table, column, "xmax", xmax) || !FindBoxColumn(get, table, column, "ymax", ymax)) {
+		return;
+	}
+
+	// The row box overlaps the query box
+	auto upper = ExpressionType::COMPARE_LESSTHANOREQUAL;
+	auto lower = ExpressionType::COMPARE_GREATERTHANOREQUAL;
+	get.table_filters.PushFilter(GetScanColumn(get, xmin), MakeBoxFilter(upper, box.xmax));
+	get.table_filters.PushFilter(GetScanColumn(get, ymin), MakeBoxFilter(upper, box.ymax));
+	get.table_filters.PushFilter(GetScanColumn(get, xmax), MakeBoxFilter(lower, box.xmin));
+	get.table_filters.PushFilter(GetScanColumn(get, ymax), MakeBoxFilter(lower, box.ymin));
+}
+
+static void OptimizeBoxPruning(ClientContext &context, unique_ptr<LogicalOperator> &op) {
+	for (auto &child : op->children) {
+		OptimizeBoxPruning(context, child);
+	}
+	if (op->type != LogicalOperatorType::LOGICAL_FILTER ||
+	    op->children[0]->type != LogicalOperatorType::LOGICAL_GET) {
+		return;
+	}
+	auto &filter = (LogicalFilter &)*op;
+	auto &get = (LogicalGet &)*op->children[0];
+	if (get.function.name != "seq_scan" || !get.function.filter_pushdown) {
+		return;
+	}
+	// The spatial predicate stays in the filter, the box filters only skip what it would reject anyway
+	for (auto &expr : filter.expressions) {
+		string column;
+		GBOX box;
+		if (MatchBoxCondition(context, *expr, get, column, box)) {
+			PushBoxFilters(get, column, box);
+		}
+	}
+}
+
+void BoxPruningOptimizer::Optimize(ClientContext &context, OptimizerExtensionInfo *info,
+                                   unique_ptr<LogicalOperator> &plan) {
+	Value enabled;
+	if (context.TryGetCurrentSetting("geo_bbox_pruning", enabled) &&
+	    !BooleanValue::Get(enabled.DefaultCastAs(LogicalType::BOOLEAN))) {
+		return;
+	}
+	OptimizeBoxPruning(context, plan);
+}
+
+} // namespace duckdb
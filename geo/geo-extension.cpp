@@ -3,18 +3,22 @@
 #include "geo-extension.hpp"
 
 #include "accessor-functions.hpp"
+#include "bbox-pruning.hpp"
 #include "constructor-functions.hpp"
 #include "duckdb.hpp"
 #include "duckdb/catalog/catalog.hpp"
 #include "duckdb/function/aggregate/sum_helpers.hpp"
 #include "duckdb/parser/parsed_data/create_aggregate_function_info.hpp"
 #include "duckdb/parser/parsed_data/create_scalar_function_info.hpp"
+#include "duckdb/parser/parsed_data/create_table_function_info.hpp"
 #include "duckdb/parser/parsed_data/create_type_info.hpp"
 #include "formatter-functions.hpp"
 #include "geo_aggregate_function.hpp"
+#include "geojson-reader.hpp"
 #include "measure-functions.hpp"
 #include "parser-functions.hpp"
 #include "predicate-functions.hpp"
+#include "spatial-join.hpp"
 #include "transformation-functions.hpp"
 
 namespace duckdb {
@@ -25,27 +29,96 @@ void GeoExtension::Load(DuckDB &db) {
 
 	auto &catalog = Catalog::GetSystemCatalog(*con.context);
 
-	auto geo_type = LogicalType(LogicalTypeId::BLOB);
-	geo_type.SetAlias("GEOGRAPHY");
+	auto geo_type = GeoTypes::Geography();
 
 	CreateTypeInfo info("Geography", geo_type);
 	info.temporary = true;
 	info.internal = true;
 	catalog.CreateType(*con.context, &info);
 
+	// Points as STRUCTs of DOUBLE coordinates, so they are stored and compressed column by column
+	auto point_2d_type = GeoTypes::Point2D();
+	CreateTypeInfo point_2d_info("POINT_2D", point_2d_type);
+	point_2d_info.temporary = true;
+	point_2d_info.internal = true;
+	catalog.CreateType(*con.context, &point_2d_info);
+
+	auto point_3d_type = GeoTypes::Point3D();
+	CreateTypeInfo point_3d_info("POINT_3D", point_3d_type);
+	point_3d_info.temporary = true;
+	point_3d_info.internal = true;
+	catalog.CreateType(*con.context, &point_3d_info);
+
+	// Lines and polygons as LISTs of POINT_2D, so their coordinates are columns as well
+	auto line_2d_type = GeoTypes::LineString2D();
+	CreateTypeInfo line_2d_info("LINESTRING_2D", line_2d_type);
+	line_2d_info.temporary = true;
+	line_2d_info.internal = true;
+	catalog.CreateType(*con.context, &line_2d_info);
+
+	auto polygon_2d_type = GeoTypes::Polygon2D();
+	CreateTypeInfo polygon_2d_info("POLYGON_2D", polygon_2d_type);
+	polygon_2d_info.temporary = true;
+	polygon_2d_info.internal = true;
+	catalog.CreateType(*con.context, &polygon_2d_info);
+
+	// liblwgeom allocations go through the per-thread arena while a chunk is being processed
+	lwgeom_set_allocators(lwarena_alloc, lwarena_realloc, lwarena_free);
+
 	// add geo casts
 	auto &config = DBConfig::GetConfig(*con.context);
-
+	config.AddExtensionOption("geo_arena_allocator",
+	                          "Serve the liblwgeom allocations of each chunk from a per-thread arena",
+	                          LogicalType::BOOLEAN);
+
+	config.AddExtensionOption("geo_wkb_header",
+	                          "Write the box of each geography that is neither a point nor empty in a 24 byte "
+	                          "header in front of its WKB",
+	                          LogicalType::BOOLEAN);
+
+	config.AddExtensionOption("geo_spatial_join",
+	                          "Plan joins on a spatial predicate as a probe of an STRtree over the smaller side",
+	                          LogicalType::BOOLEAN);
+	OptimizerExtension spatial_join;
+	spatial_join.optimize_function = SpatialJoinOptimizer::Optimize;
+	config.optimizer_extensions.push_back(spatial_join);
+
+	config.AddExtensionOption("geo_bbox_pruning",
+	                          "Skip the row groups whose <column>_xmin/_ymin/_xmax/_ymax statistics rule out a spatial "
+	                          "predicate against a constant",
+	                          LogicalType::BOOLEAN);
+	OptimizerExtension bbox_pruning;
+	bbox_pruning.optimize_function = BoxPruningOptimizer::Optimize;
+	config.optimizer_extensions.push_back(bbox_pruning);
+
+	// The casts that decode or build geometries take the settings of the connection binding them
 	auto &casts = config.GetCastFunctions();
-	casts.RegisterCastFunction(LogicalType::VARCHAR, geo_type, GeoFunctions::CastVarcharToGEO, 100);
-	casts.RegisterCastFunction(geo_type, LogicalType::VARCHAR, GeoFunctions::CastGeoToVarchar);
+	casts.RegisterCastFunction(LogicalType::VARCHAR, geo_type,
+	                           GeoFunctions::BindWithSettings<GeoFunctions::CastVarcharToGEO>, 100);
+	casts.RegisterCastFunction(geo_type, LogicalType::VARCHAR,
+	                           GeoFunctions::BindWithSettings<GeoFunctions::CastGeoToVarchar>);
+	// The points go implicitly to GEOGRAPHY, so every function takes them
+	casts.RegisterCastFunction(point_2d_type, geo_type, GeoFunctions::CastPointToGEO, 100);
+	casts.RegisterCastFunction(point_3d_type, geo_type, GeoFunctions::CastPointToGEO, 100);
+	casts.RegisterCastFunction(geo_type, point_2d_type,
+	                           GeoFunctions::BindWithSettings<GeoFunctions::CastGEOToPoint>);
+	casts.RegisterCastFunction(geo_type, point_3d_type,
+	                           GeoFunctions::BindWithSettings<GeoFunctions::CastGEOToPoint>);
+	casts.RegisterCastFunction(line_2d_type, geo_type,
+	                           GeoFunctions::BindWithSettings<GeoFunctions::CastLineToGEO>, 100);
+	casts.RegisterCastFunction(polygon_2d_type, geo_type,
+	                           GeoFunctions::BindWithSettings<GeoFunctions::CastPolygonToGEO>, 100);
+	casts.RegisterCastFunction(geo_type, line_2d_type,
+	                           GeoFunctions::BindWithSettings<GeoFunctions::CastGEOToLine>);
+	casts.RegisterCastFunction(geo_type, polygon_2d_type,
+	                           GeoFunctions::BindWithSettings<GeoFunctions::CastGEOToPolygon>);
 
 	// add geo functions
 	std::vector<ScalarFunctionSet> geo_function_set {};
 	// **Constructors (3)**
 	auto constructor_func_set = GetConstructorScalarFunctions(geo_type);
 	geo_function_set.insert(geo_function_set.end(), constructor_func_set.begin(), constructor_func_set.end());
-	// **Formatters (4)**
+	// **Formatters (5)**
 	auto formatter_func_set = GetFormatterScalarFunctions(geo_type);
 	geo_function_set.insert(geo_function_set.end(), formatter_func_set.begin(), formatter_func_set.end());
 	// **Parsers (5)**
@@ -54,7 +127,7 @@ void GeoExtension::Load(DuckDB &db) {
 	// **Transformations (10)**
 	auto transformation_func_set = GetTransformationScalarFunctions(geo_type);
 	geo_function_set.insert(geo_function_set.end(), transformation_func_set.begin(), transformation_func_set.end());
-	//  **Accessors (15)**
+	//  **Accessors (19)**
 	auto accessor_func_set = GetAccessorScalarFunctions(geo_type);
 	geo_function_set.insert(geo_function_set.end(), accessor_func_set.begin(), accessor_func_set.end());
 	// **Predicates (9)**
@@ -65,6 +138,9 @@ void GeoExtension::Load(DuckDB &db) {
 	geo_function_set.insert(geo_function_set.end(), measure_func_set.begin(), measure_func_set.end());
 
 	for (auto func_set : geo_function_set) {
+		for (auto &func : func_set.functions) {
+			func.function = GeoFunctions::WithSettings(func.function);
+		}
 		CreateScalarFunctionInfo func_info(func_set);
 		catalog.AddFunction(*con.context, &func_info);
 	}
@@ -73,6 +149,41 @@ void GeoExtension::Load(DuckDB &db) {
 	CreateAggregateFunctionInfo cluster_db_scan_func_info(move(cluster_db_scan));
 	catalog.CreateFunction(*con.context, &cluster_db_scan_func_info);
 
+	auto cluster_db_scan_agg = GetClusterDBScanListAggregateFunction(geo_type);
+	CreateAggregateFunctionInfo cluster_db_scan_agg_func_info(move(cluster_db_scan_agg));
+	catalog.CreateFunction(*con.context, &cluster_db_scan_agg_func_info);
+
+	auto cluster_kmeans = GetClusterKMeansAggregateFunction(geo_type);
+	CreateAggregateFunctionInfo cluster_kmeans_func_info(move(cluster_kmeans));
+	catalog.CreateFunction(*con.context, &cluster_kmeans_func_info);
+
+	auto cluster_kmeans_agg = GetClusterKMeansListAggregateFunction(geo_type);
+	CreateAggregateFunctionInfo cluster_kmeans_agg_func_info(move(cluster_kmeans_agg));
+	catalog.CreateFunction(*con.context, &cluster_kmeans_agg_func_info);
+
+	auto extent_agg = GetExtentAggregateFunction(geo_type);
+	CreateAggregateFunctionInfo extent_agg_func_info(move(extent_agg));
+	catalog.CreateFunction(*con.context, &extent_agg_func_info);
+
+	auto union_agg = GetUnionAggregateFunction(geo_type);
+	CreateAggregateFunctionInfo union_agg_func_info(move(union_agg));
+	catalog.CreateFunction(*con.context, &union_agg_func_info);
+
+	auto collect_agg = GetCollectAggregateFunction(geo_type);
+	CreateAggregateFunctionInfo collect_agg_func_info(move(collect_agg));
+	catalog.CreateFunction(*con.context, &collect_agg_func_info);
+
+	auto makeline_agg = GetMakeLineAggregateFunction(geo_type);
+	CreateAggregateFunctionInfo makeline_agg_func_info(move(makeline_agg));
+	catalog.CreateFunction(*con.context, &makeline_agg_func_info);
+
+	auto centroid_agg = GetCentroidAggregateFunction(geo_type);
+	CreateAggregateFunctionInfo centroid_agg_func_info(move(centroid_agg));
+	catalog.CreateFunction(*con.context, &centroid_agg_func_info);
+
+	CreateTableFunctionInfo read_geojson_info(ReadGeoJSONFunction::GetFunction());
+	catalog.CreateTableFunction(*con.context, &read_geojson_info);
+
 	con.Commit();
 }
 
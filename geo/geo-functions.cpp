@@ -1,50 +1,60 @@
 #include "geo-functions.hpp"
 
+#include "duckdb/common/operator/comparison_operators.hpp"
 #include "duckdb/common/types/vector.hpp"
 #include "duckdb/common/vector_operations/generic_executor.hpp"
+#include "duckdb/execution/expression_executor_state.hpp"
+#include "duckdb/main/client_context.hpp"
 #include "geometry.hpp"
-
-#include <unistd.h>
+#include "postgis/geography_measurement_trees.hpp"
+#include "postgis/lwgeom_geos_prepared.hpp"
 
 namespace duckdb {
-int loopindex = 1;
-std::vector<int> queue {};
+
+bool GeoFunctions::ArenaEnabled(ClientContext &context) {
+	Value enabled;
+	return context.TryGetCurrentSetting("geo_arena_allocator", enabled) && !enabled.IsNull() &&
+	       BooleanValue::Get(enabled.DefaultCastAs(LogicalType::BOOLEAN));
+}
+
+bool GeoFunctions::WKBHeaderEnabled(ClientContext &context) {
+	Value enabled;
+	return context.TryGetCurrentSetting("geo_wkb_header", enabled) && !enabled.IsNull() &&
+	       BooleanValue::Get(enabled.DefaultCastAs(LogicalType::BOOLEAN));
+}
+
+scalar_function_t GeoFunctions::WithSettings(scalar_function_t function) {
+	return [function](DataChunk &args, ExpressionState &state, Vector &result) {
+		auto &context = state.GetContext();
+		LWArenaScope arena(ArenaEnabled(context));
+		WKBHeaderScope wkb_header(WKBHeaderEnabled(context));
+		function(args, state, result);
+	};
+}
 
 bool GeoFunctions::CastVarcharToGEO(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
-	int currindex = loopindex;
-	queue.push_back(currindex);
-	loopindex++;
-	while (queue.size() > 0 && queue[0] != currindex) {
-		usleep(30);
-	}
-	bool success = true;
-	try {
-		UnaryExecutor::ExecuteWithNulls<string_t, string_t>(
-		    source, result, count, [&](string_t input, ValidityMask &mask, idx_t idx) {
-			    if (input.GetSize() == 0) {
-				    return string_t();
-			    }
-			    auto gser = Geometry::ToGserialized(input);
-			    if (!gser) {
-				    throw ConversionException("Failure in geometry cast: could not cast geometry from varchar");
-				    success = false;
-				    return string_t();
-			    }
-			    idx_t size = Geometry::GetGeometrySize(gser);
-			    auto base = Geometry::GetBase(gser);
-			    Geometry::DestroyGeometry(gser);
-			    return string_t((const char *)base, size);
-		    });
-	} catch (const std::exception &e) {
-		queue.erase(queue.begin());
-		throw Exception(e.what());
-		return false;
-	}
-	queue.erase(queue.begin());
-	return success;
+	// The WKT parser keeps its state per thread, so chunks can be cast concurrently
+	LWArenaScope arena(GeoCastData::Arena(parameters));
+	WKBHeaderScope wkb_header(GeoCastData::WKBHeader(parameters));
+	UnaryExecutor::ExecuteWithNulls<string_t, string_t>(
+	    source, result, count, [&](string_t input, ValidityMask &mask, idx_t idx) {
+		    if (input.GetSize() == 0) {
+			    return string_t();
+		    }
+		    // Written straight to WKB, no GSERIALIZED in between
+		    auto lwgeom = Geometry::ToLWGeom(input);
+		    if (!lwgeom) {
+			    throw ConversionException("Failure in geometry cast: could not cast geometry from varchar");
+		    }
+		    auto result_str = Geometry::ToWKB(result, lwgeom);
+		    Geometry::DestroyLWGeom(lwgeom);
+		    return result_str;
+	    });
+	return true;
 }
 
 bool GeoFunctions::CastGeoToVarchar(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
+	LWArenaScope arena(GeoCastData::Arena(parameters));
 	GenericExecutor::ExecuteUnary<PrimitiveType<string_t>, PrimitiveType<string_t>>(
 	    source, result, count, [&](PrimitiveType<string_t> input) {
 		    // auto text = Geometry::GetString(input.val, DataFormatType::FORMAT_VALUE_TYPE_GEOJSON);
@@ -54,37 +64,357 @@ bool GeoFunctions::CastGeoToVarchar(Vector &source, Vector &result, idx_t count,
 	return true;
 }
 
-struct MakePointBinaryOperator {
-	template <class TA, class TB, class TR>
-	static inline TR Operation(TA point_x, TB point_y) {
-		auto gser = Geometry::MakePoint(point_x, point_y);
-		idx_t rv_size = Geometry::GetGeometrySize(gser);
-		auto base = Geometry::GetBase(gser);
-		Geometry::DestroyGeometry(gser);
-		return string_t((const char *)base, rv_size);
+//! Reads the points of a POINT_2D or POINT_3D vector straight from the DOUBLE vectors of its coordinates
+class PointReader {
+public:
+	PointReader(Vector &points, idx_t count) : points(points) {
+		points.Flatten(count);
+		auto &coords = StructVector::GetEntries(points);
+		coords[0]->ToUnifiedFormat(count, x_data);
+		coords[1]->ToUnifiedFormat(count, y_data);
+		has_z = coords.size() > 2;
+		if (has_z) {
+			coords[2]->ToUnifiedFormat(count, z_data);
+		}
+	}
+
+	bool HasZ() const {
+		return has_z;
+	}
+
+	//! The point of a row, false if the point or one of its coordinates is NULL
+	bool Get(idx_t row, POINT4D &pt) const {
+		if (!FlatVector::Validity(points).RowIsValid(row) || !GetCoord(x_data, row, pt.x) ||
+		    !GetCoord(y_data, row, pt.y)) {
+			return false;
+		}
+		pt.z = 0;
+		pt.m = 0;
+		return !has_z || GetCoord(z_data, row, pt.z);
+	}
+
+	bool Get(idx_t row, POINT2D &pt) const {
+		return FlatVector::Validity(points).RowIsValid(row) && GetCoord(x_data, row, pt.x) &&
+		       GetCoord(y_data, row, pt.y);
+	}
+
+private:
+	static bool GetCoord(const UnifiedVectorFormat &data, idx_t row, double &coord) {
+		auto idx = data.sel->get_index(row);
+		if (!data.validity.RowIsValid(idx)) {
+			return false;
+		}
+		coord = ((const double *)data.data)[idx];
+		return true;
 	}
+
+	Vector &points;
+	UnifiedVectorFormat x_data;
+	UnifiedVectorFormat y_data;
+	UnifiedVectorFormat z_data;
+	bool has_z;
 };
 
-struct MakePointTernaryOperator {
-	template <class TA, class TB, class TC, class TR>
-	static inline TR Operation(TA point_x, TB point_y, TC point_z) {
-		auto gser = Geometry::MakePoint(point_x, point_y, point_z);
-		idx_t rv_size = Geometry::GetGeometrySize(gser);
-		auto base = Geometry::GetBase(gser);
-		Geometry::DestroyGeometry(gser);
-		return string_t((const char *)base, rv_size);
+//! Value of a row of an argument in unified format, false if it is NULL
+template <class T>
+static bool GetArgument(const UnifiedVectorFormat &data, idx_t row, T &value) {
+	auto idx = data.sel->get_index(row);
+	if (!data.validity.RowIsValid(idx)) {
+		return false;
+	}
+	value = ((const T *)data.data)[idx];
+	return true;
+}
+
+//! Reads the points of LINESTRING_2D and POLYGON_2D vectors in place from the DOUBLE vectors of their coordinates
+class VertexReader {
+public:
+	VertexReader(Vector &points, idx_t count) {
+		points.Flatten(count);
+		auto &coords = StructVector::GetEntries(points);
+		coords[0]->Flatten(count);
+		coords[1]->Flatten(count);
+		x = FlatVector::GetData<double>(*coords[0]);
+		y = FlatVector::GetData<double>(*coords[1]);
+		point_validity = &FlatVector::Validity(points);
+		x_validity = &FlatVector::Validity(*coords[0]);
+		y_validity = &FlatVector::Validity(*coords[1]);
+		all_valid = point_validity->AllValid() && x_validity->AllValid() && y_validity->AllValid();
+	}
+
+	//! False if one of the points of a range or one of their coordinates is NULL
+	bool IsValid(const list_entry_t &points) const {
+		if (all_valid) {
+			return true;
+		}
+		for (idx_t i = points.offset; i < points.offset + points.length; i++) {
+			if (!point_validity->RowIsValid(i) || !x_validity->RowIsValid(i) || !y_validity->RowIsValid(i)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	const double *x;
+	const double *y;
+
+private:
+	const ValidityMask *point_validity;
+	const ValidityMask *x_validity;
+	const ValidityMask *y_validity;
+	bool all_valid;
+};
+
+//! Reads the lines of a LINESTRING_2D vector as ranges of the points of its vertices
+class LineReader {
+public:
+	LineReader(Vector &lines, idx_t count) : vertices(ListVector::GetEntry(lines), ListVector::GetListSize(lines)) {
+		lines.ToUnifiedFormat(count, line_data);
+	}
+
+	//! The points of a row, false if the line or one of its points is NULL
+	bool Get(idx_t row, list_entry_t &line) const {
+		if (!GetArgument(line_data, row, line) || !vertices.IsValid(line)) {
+			return false;
+		}
+		// The WKB parser takes no line of a single point
+		if (line.length == 1) {
+			throw InvalidInputException("A LINESTRING_2D must be empty or have at least two points");
+		}
+		return true;
+	}
+
+	VertexReader vertices;
+
+private:
+	UnifiedVectorFormat line_data;
+};
+
+//! Reads the polygons of a POLYGON_2D vector as the ranges of the points of each of their rings in its vertices
+class PolygonReader {
+public:
+	PolygonReader(Vector &polygons, idx_t count)
+	    : vertices(ListVector::GetEntry(ListVector::GetEntry(polygons)),
+	               ListVector::GetListSize(ListVector::GetEntry(polygons))) {
+		polygons.ToUnifiedFormat(count, polygon_data);
+		ListVector::GetEntry(polygons).ToUnifiedFormat(ListVector::GetListSize(polygons), ring_data);
 	}
+
+	//! The rings of a row, false if the polygon, one of its rings or one of their points is NULL
+	bool Get(idx_t row, vector<list_entry_t> &polygon) const {
+		list_entry_t entry;
+		if (!GetArgument(polygon_data, row, entry)) {
+			return false;
+		}
+		polygon.clear();
+		for (idx_t i = entry.offset; i < entry.offset + entry.length; i++) {
+			list_entry_t ring;
+			if (!GetArgument(ring_data, i, ring) || !vertices.IsValid(ring)) {
+				return false;
+			}
+			if (ring.length < 4 || vertices.x[ring.offset] != vertices.x[ring.offset + ring.length - 1] ||
+			    vertices.y[ring.offset] != vertices.y[ring.offset + ring.length - 1]) {
+				throw InvalidInputException("A ring of a POLYGON_2D must be closed and have at least four points");
+			}
+			polygon.push_back(ring);
+		}
+		return true;
+	}
+
+	VertexReader vertices;
+
+private:
+	UnifiedVectorFormat polygon_data;
+	UnifiedVectorFormat ring_data;
 };
 
+//! Append the points of a point array to the points of a LINESTRING_2D or ring vector, returns their range
+static list_entry_t AppendPoints(Vector &list, const POINTARRAY *pa) {
+	auto offset = ListVector::GetListSize(list);
+	ListVector::Reserve(list, offset + pa->npoints);
+	auto &coords = StructVector::GetEntries(ListVector::GetEntry(list));
+	auto x_data = FlatVector::GetData<double>(*coords[0]);
+	auto y_data = FlatVector::GetData<double>(*coords[1]);
+	for (uint32_t i = 0; i < pa->npoints; i++) {
+		auto pt = getPoint2d_cp(pa, i);
+		x_data[offset + i] = pt->x;
+		y_data[offset + i] = pt->y;
+	}
+	ListVector::SetListSize(list, offset + pa->npoints);
+	return list_entry_t(offset, pa->npoints);
+}
+
+//! Append the rings of a polygon to the rings of a POLYGON_2D vector, returns their range
+static list_entry_t AppendRings(Vector &list, const LWPOLY *poly) {
+	auto offset = ListVector::GetListSize(list);
+	ListVector::Reserve(list, offset + poly->nrings);
+	ListVector::SetListSize(list, offset + poly->nrings);
+	auto &rings = ListVector::GetEntry(list);
+	for (uint32_t i = 0; i < poly->nrings; i++) {
+		auto ring = AppendPoints(rings, poly->rings[i]);
+		FlatVector::GetData<list_entry_t>(rings)[offset + i] = ring;
+	}
+	return list_entry_t(offset, poly->nrings);
+}
+
+bool GeoFunctions::CastPointToGEO(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
+	PointReader points(source, count);
+	auto result_data = FlatVector::GetData<string_t>(result);
+	for (idx_t i = 0; i < count; i++) {
+		POINT4D pt;
+		if (!points.Get(i, pt)) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		result_data[i] = Geometry::ToWKB(result, pt, points.HasZ());
+	}
+	return true;
+}
+
+bool GeoFunctions::CastGEOToPoint(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
+	LWArenaScope arena(GeoCastData::Arena(parameters));
+	auto has_z = StructType::GetChildTypes(result.GetType()).size() > 2;
+	auto &coords = StructVector::GetEntries(result);
+	auto x_data = FlatVector::GetData<double>(*coords[0]);
+	auto y_data = FlatVector::GetData<double>(*coords[1]);
+	auto z_data = has_z ? FlatVector::GetData<double>(*coords[2]) : nullptr;
+
+	UnifiedVectorFormat geom_data;
+	source.ToUnifiedFormat(count, geom_data);
+	auto geoms = (const string_t *)geom_data.data;
+	for (idx_t i = 0; i < count; i++) {
+		auto idx = geom_data.sel->get_index(i);
+		if (!geom_data.validity.RowIsValid(idx) || geoms[idx].GetSize() == 0) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		POINT2D pt2d;
+		int32_t srid;
+		if (!has_z && Geometry::GetPoint(geoms[idx], pt2d, srid)) {
+			x_data[i] = pt2d.x;
+			y_data[i] = pt2d.y;
+			continue;
+		}
+		auto lwgeom = Geometry::GetLWGeom(geoms[idx]);
+		if (!lwgeom) {
+			throw ConversionException("Failure in geometry cast: could not cast geometry to a point");
+		}
+		POINT4D pt;
+		// POINT EMPTY has no coordinates to store
+		if (!Geometry::PointCoords(lwgeom, pt)) {
+			FlatVector::SetNull(result, i, true);
+		} else {
+			x_data[i] = pt.x;
+			y_data[i] = pt.y;
+			if (has_z) {
+				z_data[i] = pt.z;
+			}
+		}
+		Geometry::DestroyLWGeom(lwgeom);
+	}
+	return true;
+}
+
+bool GeoFunctions::CastLineToGEO(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
+	WKBHeaderScope wkb_header(GeoCastData::WKBHeader(parameters));
+	LineReader lines(source, count);
+	auto result_data = FlatVector::GetData<string_t>(result);
+	for (idx_t i = 0; i < count; i++) {
+		list_entry_t line;
+		if (!lines.Get(i, line)) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		result_data[i] = Geometry::ToWKB(result, lines.vertices.x, lines.vertices.y, line);
+	}
+	return true;
+}
+
+bool GeoFunctions::CastPolygonToGEO(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
+	WKBHeaderScope wkb_header(GeoCastData::WKBHeader(parameters));
+	PolygonReader polygons(source, count);
+	auto result_data = FlatVector::GetData<string_t>(result);
+	vector<list_entry_t> rings;
+	for (idx_t i = 0; i < count; i++) {
+		if (!polygons.Get(i, rings)) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		result_data[i] = Geometry::ToWKB(result, polygons.vertices.x, polygons.vertices.y, rings);
+	}
+	return true;
+}
+
+//! Decode the geometries of a GEOGRAPHY vector of one type and write them to a LINESTRING_2D or POLYGON_2D vector
+template <class APPEND>
+static void CastGEOToList(Vector &source, Vector &result, idx_t count, CastParameters &parameters, uint8_t type,
+                          const char *error, APPEND append) {
+	LWArenaScope arena(GeoCastData::Arena(parameters));
+	UnifiedVectorFormat geom_data;
+	source.ToUnifiedFormat(count, geom_data);
+	auto geoms = (const string_t *)geom_data.data;
+	auto result_data = FlatVector::GetData<list_entry_t>(result);
+	for (idx_t i = 0; i < count; i++) {
+		auto idx = geom_data.sel->get_index(i);
+		if (!geom_data.validity.RowIsValid(idx) || geoms[idx].GetSize() == 0) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		auto lwgeom = Geometry::GetLWGeom(geoms[idx]);
+		if (!lwgeom || lwgeom->type != type) {
+			if (lwgeom) {
+				Geometry::DestroyLWGeom(lwgeom);
+			}
+			throw ConversionException(error);
+		}
+		// Z and M are dropped along with the SRID
+		result_data[i] = append(result, lwgeom);
+		Geometry::DestroyLWGeom(lwgeom);
+	}
+}
+
+bool GeoFunctions::CastGEOToLine(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
+	CastGEOToList(source, result, count, parameters, LINETYPE,
+	              "Failure in geometry cast: could not cast geometry to a linestring",
+	              [](Vector &result, LWGEOM *lwgeom) { return AppendPoints(result, ((LWLINE *)lwgeom)->points); });
+	return true;
+}
+
+bool GeoFunctions::CastGEOToPolygon(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
+	CastGEOToList(source, result, count, parameters, POLYGONTYPE,
+	              "Failure in geometry cast: could not cast geometry to a polygon",
+	              [](Vector &result, LWGEOM *lwgeom) { return AppendRings(result, (LWPOLY *)lwgeom); });
+	return true;
+}
+
+template <typename TA, typename TB, typename TR>
+static TR MakePointScalarFunction(Vector &result, TA point_x, TB point_y) {
+	auto gser = Geometry::MakePoint(point_x, point_y);
+	auto result_str = Geometry::ToWKB(result, gser);
+	Geometry::DestroyGeometry(gser);
+	return result_str;
+}
+
+template <typename TA, typename TB, typename TC, typename TR>
+static TR MakePointScalarFunction(Vector &result, TA point_x, TB point_y, TC point_z) {
+	auto gser = Geometry::MakePoint(point_x, point_y, point_z);
+	auto result_str = Geometry::ToWKB(result, gser);
+	Geometry::DestroyGeometry(gser);
+	return result_str;
+}
+
 template <typename TA, typename TB, typename TR>
 static void MakePointBinaryExecutor(Vector &point_x, Vector &point_y, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, MakePointBinaryOperator>(point_x, point_y, result, count);
+	BinaryExecutor::Execute<TA, TB, TR>(point_x, point_y, result, count, [&](TA x, TB y) {
+		return MakePointScalarFunction<TA, TB, TR>(result, x, y);
+	});
 }
 
 template <typename TA, typename TB, typename TC, typename TR>
 static void MakePointTernaryExecutor(Vector &point_x, Vector &point_y, Vector &point_z, Vector &result, idx_t count) {
-	TernaryExecutor::Execute<TA, TB, TC, TR>(point_x, point_y, point_z, result, count,
-	                                         MakePointTernaryOperator::Operation<TA, TB, TC, TR>);
+	TernaryExecutor::Execute<TA, TB, TC, TR>(point_x, point_y, point_z, result, count, [&](TA x, TB y, TC z) {
+		return MakePointScalarFunction<TA, TB, TC, TR>(result, x, y, z);
+	});
 }
 
 void GeoFunctions::MakePointFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -99,42 +429,41 @@ void GeoFunctions::MakePointFunction(DataChunk &args, ExpressionState &state, Ve
 	}
 }
 
-struct MakeLineBinaryOperator {
-	template <class TA, class TB, class TR>
-	static inline TR Operation(TA point1, TB point2) {
-		if (point1.GetSize() == 0 || point2.GetSize() == 0) {
-			return string_t();
-		}
-		auto gser1 = Geometry::GetGserialized(point1);
-		auto gser2 = Geometry::GetGserialized(point2);
-		if (!gser1 || !gser2) {
-			if (gser1) {
-				Geometry::DestroyGeometry(gser1);
-			}
-			if (gser2) {
-				Geometry::DestroyGeometry(gser2);
-			}
-			throw ConversionException("Failure in geometry get make line: could not getting make line from geom");
-			return string_t();
-		}
-		auto gser = Geometry::MakeLine(gser1, gser2);
-		if (!gser) {
+template <typename TA, typename TB, typename TR>
+static TR MakeLineScalarFunction(Vector &result, TA point1, TB point2) {
+	if (point1.GetSize() == 0 || point2.GetSize() == 0) {
+		return string_t();
+	}
+	auto gser1 = Geometry::GetGserialized(point1);
+	auto gser2 = Geometry::GetGserialized(point2);
+	if (!gser1 || !gser2) {
+		if (gser1) {
 			Geometry::DestroyGeometry(gser1);
+		}
+		if (gser2) {
 			Geometry::DestroyGeometry(gser2);
-			return string_t();
 		}
-		idx_t rv_size = Geometry::GetGeometrySize(gser);
-		auto base = Geometry::GetBase(gser);
+		throw ConversionException("Failure in geometry get make line: could not getting make line from geom");
+		return string_t();
+	}
+	auto gser = Geometry::MakeLine(gser1, gser2);
+	if (!gser) {
 		Geometry::DestroyGeometry(gser1);
 		Geometry::DestroyGeometry(gser2);
-		Geometry::DestroyGeometry(gser);
-		return string_t((const char *)base, rv_size);
+		return string_t();
 	}
-};
+	auto result_str = Geometry::ToWKB(result, gser);
+	Geometry::DestroyGeometry(gser1);
+	Geometry::DestroyGeometry(gser2);
+	Geometry::DestroyGeometry(gser);
+	return result_str;
+}
 
 template <typename TA, typename TB, typename TR>
 static void MakeLineBinaryExecutor(Vector &point1, Vector &point2, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, MakeLineBinaryOperator>(point1, point2, result, count);
+	BinaryExecutor::Execute<TA, TB, TR>(point1, point2, result, count, [&](TA geom1, TB geom2) {
+		return MakeLineScalarFunction<TA, TB, TR>(result, geom1, geom2);
+	});
 }
 
 void GeoFunctions::MakeLineFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -196,19 +525,17 @@ void GeoFunctions::MakeLineArrayFunction(DataChunk &args, ExpressionState &state
 			gserArray[child_idx] = gser;
 		}
 		auto gserline = Geometry::MakeLineGArray(&gserArray[0], list_entry.length);
-		idx_t rv_size = Geometry::GetGeometrySize(gserline);
-		auto base = Geometry::GetBase(gserline);
+		result_entries[i] = Geometry::ToWKB(result, gserline);
 		for (idx_t child_idx = 0; child_idx < list_entry.length; child_idx++) {
 			Geometry::DestroyGeometry(gserArray[child_idx]);
 		}
 		Geometry::DestroyGeometry(gserline);
-		result_entries[i] = string_t((const char *)base, rv_size);
 	}
 }
 
 struct MakePolygonUnaryOperator {
 	template <class TA, class TR>
-	static inline TR Operation(TA geom) {
+	static inline TR Operation(TA geom, Vector &result) {
 		if (geom.GetSize() == 0) {
 			// throw ConversionException(
 			//     "Failure in geometry get X: could not get coordinate X from geometry");
@@ -216,17 +543,16 @@ struct MakePolygonUnaryOperator {
 		}
 		auto gser = Geometry::GetGserialized(geom);
 		auto gserpoly = Geometry::MakePolygon(gser);
-		idx_t rv_size = Geometry::GetGeometrySize(gserpoly);
-		auto base = Geometry::GetBase(gserpoly);
+		auto result_str = Geometry::ToWKB(result, gserpoly);
 		Geometry::DestroyGeometry(gser);
 		Geometry::DestroyGeometry(gserpoly);
-		return string_t((const char *)base, rv_size);
+		return result_str;
 	}
 };
 
 template <typename TA, typename TR>
 static void MakePolygonUnaryExecutor(Vector &geom, Vector &result, idx_t count) {
-	UnaryExecutor::Execute<TA, TR, MakePolygonUnaryOperator>(geom, result, count);
+	UnaryExecutor::ExecuteString<TA, TR, MakePolygonUnaryOperator>(geom, result, count);
 }
 
 void GeoFunctions::MakePolygonFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -298,14 +624,12 @@ void GeoFunctions::MakePolygonFunction(DataChunk &args, ExpressionState &state,
 				result_entries[i] = string_t();
 				continue;
 			}
-			idx_t rv_size = Geometry::GetGeometrySize(gserpoly);
-			auto base = Geometry::GetBase(gserpoly);
+			result_entries[i] = Geometry::ToWKB(result, gserpoly);
 			for (idx_t child_idx = 0; child_idx < list_entry.length; child_idx++) {
 				Geometry::DestroyGeometry(gserArray[child_idx]);
 			}
 			Geometry::DestroyGeometry(gserpoly);
 			Geometry::DestroyGeometry(gser);
-			result_entries[i] = string_t((const char *)base, rv_size);
 		}
 		// MakePolygonBinaryExecutor<string_t, string_t>(point1_arg, result, args.size());
 	} else {
@@ -433,22 +757,23 @@ struct AsGeojsonUnaryOperator {
 	}
 };
 
-struct AsGeojsonBinaryOperator {
-	template <class TA, class TB, class TR>
-	static inline TR Operation(TA geom, TB m_dec_digits) {
-		if (geom.GetSize() == 0) {
-			return string_t();
-		}
-		auto gser = Geometry::GetGserialized(geom);
-		if (!gser) {
-			throw ConversionException("Failure in geometry asgeojson");
-		}
-		auto geojson = Geometry::AsGeoJson(gser, m_dec_digits);
-		std::string geoText = std::string(geojson->data);
-		Geometry::DestroyGeometry(gser);
-		return string_t(geoText.c_str(), geoText.size());
+template <typename TA, typename TB, typename TR>
+static TR AsGeojsonScalarFunction(Vector &result, TA geom, TB m_dec_digits) {
+	if (geom.GetSize() == 0) {
+		return string_t();
 	}
-};
+	auto gser = Geometry::GetGserialized(geom);
+	if (!gser) {
+		throw ConversionException("Failure in geometry asgeojson");
+	}
+	auto geojson = Geometry::AsGeoJson(gser, m_dec_digits);
+	std::string geoText = std::string(geojson->data);
+	auto result_str = StringVector::EmptyString(result, geoText.size());
+	memcpy(result_str.GetDataWriteable(), geoText.c_str(), geoText.size());
+	result_str.Finalize();
+	Geometry::DestroyGeometry(gser);
+	return result_str;
+}
 
 template <typename TA, typename TR>
 static void GeometryAsGeojsonUnaryExecutor(Vector &text, Vector &result, idx_t count) {
@@ -457,7 +782,9 @@ static void GeometryAsGeojsonUnaryExecutor(Vector &text, Vector &result, idx_t c
 
 template <typename TA, typename TB, typename TR>
 static void GeometryAsGeojsonBinaryExecutor(Vector &geom, Vector &m_dec_digits, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, AsGeojsonBinaryOperator>(geom, m_dec_digits, result, count);
+	BinaryExecutor::Execute<TA, TB, TR>(geom, m_dec_digits, result, count, [&](TA geom_val, TB m_dec_digits_val) {
+		return AsGeojsonScalarFunction<TA, TB, TR>(result, geom_val, m_dec_digits_val);
+	});
 }
 
 void GeoFunctions::GeometryAsGeojsonFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -538,6 +865,63 @@ void GeoFunctions::GeometryGeoHashFunction(DataChunk &args, ExpressionState &sta
 	}
 }
 
+//! Box of a geometry to sort it by, false if it is empty
+static bool GetSortBox(const string_t &geom, GBOX &box) {
+	int32_t srid;
+	return Geometry::GetFastBoundingBox(geom, box, srid) || Geometry::GetBoundingBox(geom, box, srid);
+}
+
+static uint64_t HilbertKey(const GBOX &box, const GBOX &extent) {
+	POINT2D center;
+	center.x = (box.xmin + box.xmax) / 2.0;
+	center.y = (box.ymin + box.ymax) / 2.0;
+	return hilbert_point_as_int(&center, &extent);
+}
+
+void GeoFunctions::GeometryHilbertKeyFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &geom_arg = args.data[0];
+	auto count = args.size();
+	if (args.data.size() == 2 && args.data[1].GetVectorType() != VectorType::CONSTANT_VECTOR) {
+		BinaryExecutor::ExecuteWithNulls<string_t, string_t, uint64_t>(
+		    geom_arg, args.data[1], result, count,
+		    [&](string_t geom, string_t bounds, ValidityMask &mask, idx_t idx) {
+			    GBOX box, extent;
+			    if (!GetSortBox(geom, box) || !GetSortBox(bounds, extent)) {
+				    mask.SetInvalid(idx);
+				    return (uint64_t)0;
+			    }
+			    return HilbertKey(box, extent);
+		    });
+		return;
+	}
+
+	// The whole globe unless the extent of the data is given, a constant extent is read once per chunk
+	GBOX extent;
+	gbox_init(&extent);
+	extent.xmin = -180.0;
+	extent.xmax = 180.0;
+	extent.ymin = -90.0;
+	extent.ymax = 90.0;
+	if (args.data.size() == 2) {
+		auto &extent_arg = args.data[1];
+		if (ConstantVector::IsNull(extent_arg) ||
+		    !GetSortBox(ConstantVector::GetData<string_t>(extent_arg)[0], extent)) {
+			result.SetVectorType(VectorType::CONSTANT_VECTOR);
+			ConstantVector::SetNull(result, true);
+			return;
+		}
+	}
+	UnaryExecutor::ExecuteWithNulls<string_t, uint64_t>(
+	    geom_arg, result, count, [&](string_t geom, ValidityMask &mask, idx_t idx) {
+		    GBOX box;
+		    if (!GetSortBox(geom, box)) {
+			    mask.SetInvalid(idx);
+			    return (uint64_t)0;
+		    }
+		    return HilbertKey(box, extent);
+	    });
+}
+
 struct GeogFromUnaryOperator {
 	template <class TA, class TR>
 	static inline TR Operation(TA text, Vector &result) {
@@ -549,11 +933,7 @@ struct GeogFromUnaryOperator {
 			throw ConversionException("Failure in geometry parser!");
 			return string_t();
 		}
-		idx_t size = Geometry::GetGeometrySize(gser);
-		auto base = Geometry::GetBase(gser);
-		auto result_str = StringVector::EmptyString(result, size);
-		memcpy(result_str.GetDataWriteable(), base, size);
-		result_str.Finalize();
+		auto result_str = Geometry::ToWKB(result, gser);
 		Geometry::DestroyGeometry(gser);
 		return result_str;
 	}
@@ -579,11 +959,7 @@ struct GeomFromGeoJsonUnaryOperator {
 		if (!gser) {
 			throw ConversionException("Failure in geometry from Json: could not convert JSON to geometry");
 		}
-		idx_t size = Geometry::GetGeometrySize(gser);
-		auto base = Geometry::GetBase(gser);
-		auto result_str = StringVector::EmptyString(result, size);
-		memcpy(result_str.GetDataWriteable(), base, size);
-		result_str.Finalize();
+		auto result_str = Geometry::ToWKB(result, gser);
 		Geometry::DestroyGeometry(gser);
 		return result_str;
 	}
@@ -599,79 +975,107 @@ void GeoFunctions::GeometryGeomFromGeoJsonFunction(DataChunk &args, ExpressionSt
 	GeometryGeomFromGeoJsonUnaryExecutor<string_t, string_t>(text_arg, result, args.size());
 }
 
-struct GeometryDistanceBinaryOperator {
-	template <class TA, class TB, class TR>
-	static inline TR Operation(TA geom1, TB geom2) {
-		double dis = 0.00;
-		if (geom1.GetSize() == 0 || geom2.GetSize() == 0) {
-			return dis;
-		}
-		auto gser1 = Geometry::GetGserialized(geom1);
-		auto gser2 = Geometry::GetGserialized(geom2);
-		if (!gser1 || !gser2) {
-			if (gser1) {
-				Geometry::DestroyGeometry(gser1);
-			}
-			if (gser2) {
-				Geometry::DestroyGeometry(gser2);
-			}
-			throw ConversionException("Failure in geometry get distance: could not getting distance from geom");
-			return dis;
-		}
-		dis = Geometry::Distance(gser1, gser2, false);
-		Geometry::DestroyGeometry(gser1);
-		Geometry::DestroyGeometry(gser2);
-		return dis;
+//! The geometry argument (1 or 2) that is the same for every row of the query, 0 if neither is
+static int GetConstantArg(const BoundFunctionExpression &expr) {
+	if (expr.children[0]->IsFoldable()) {
+		return 1;
 	}
-};
-
-struct GeometryDistanceTernaryOperator {
-	template <class TA, class TB, class TC, class TR>
-	static inline TR Operation(TA geom1, TB geom2, TC use_spheroid) {
-		double dis = 0.00;
-		if (geom1.GetSize() == 0 || geom2.GetSize() == 0) {
-			return dis;
-		}
-		auto gser1 = Geometry::GetGserialized(geom1);
-		auto gser2 = Geometry::GetGserialized(geom2);
-		if (!gser1 || !gser2) {
-			if (gser1) {
-				Geometry::DestroyGeometry(gser1);
-			}
-			if (gser2) {
-				Geometry::DestroyGeometry(gser2);
-			}
-			throw ConversionException("Failure in geometry get distance: could not getting distance from geom");
-			return dis;
-		}
-		dis = Geometry::Distance(gser1, gser2, use_spheroid);
-		Geometry::DestroyGeometry(gser1);
-		Geometry::DestroyGeometry(gser2);
-		return dis;
+	if (expr.children[1]->IsFoldable()) {
+		return 2;
 	}
+	return 0;
+}
+
+//! Per-expression state of the geography distance functions
+struct CircTreeCacheLocalState : public FunctionLocalState {
+	CircTreeGeomCache cache;
 };
 
-template <typename TA, typename TB, typename TR>
-static void GeometryDistanceBinaryExecutor(Vector &geom1, Vector &geom2, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, GeometryDistanceBinaryOperator>(geom1, geom2, result, count);
+unique_ptr<FunctionLocalState> GeoFunctions::InitCircTreeCache(ExpressionState &state,
+                                                               const BoundFunctionExpression &expr,
+                                                               FunctionData *bind_data) {
+	auto result = make_unique<CircTreeCacheLocalState>();
+	result->cache.SetConstantArg(GetConstantArg(expr));
+	return move(result);
 }
 
-template <typename TA, typename TB, typename TC, typename TR>
-static void GeometryDistanceTernaryExecutor(Vector &geom1, Vector &geom2, Vector &use_spheroid, Vector &result,
-                                            idx_t count) {
-	TernaryExecutor::Execute<TA, TB, TC, TR>(geom1, geom2, use_spheroid, result, count,
-	                                         GeometryDistanceTernaryOperator::Operation<TA, TB, TC, TR>);
+static CircTreeGeomCache &GetCircTreeCache(ExpressionState &state) {
+	return ((CircTreeCacheLocalState *)ExecuteFunctionState::GetFunctionState(state))->cache;
 }
 
-void GeoFunctions::GeometryDistanceFunction(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &geom1_arg = args.data[0];
-	auto &geom2_arg = args.data[1];
-	if (args.data.size() == 2) {
-		GeometryDistanceBinaryExecutor<string_t, string_t, double>(geom1_arg, geom2_arg, result, args.size());
-	} else if (args.data.size() == 3) {
-		auto &use_spheroid_arg = args.data[2];
-		GeometryDistanceTernaryExecutor<string_t, string_t, bool, double>(geom1_arg, geom2_arg, use_spheroid_arg,
-		                                                                  result, args.size());
+template <typename TA, typename TB, typename TR>
+static TR GeometryDistanceScalarFunction(CircTreeGeomCache &cache, TA geom1, TB geom2, bool use_spheroid,
+                                         bool max_distance) {
+	double dis = 0.00;
+	if (geom1.GetSize() == 0 || geom2.GetSize() == 0) {
+		return dis;
+	}
+	// Two points are read straight from their WKB and measured without building circle trees
+	POINT2D pt1, pt2;
+	int32_t srid1, srid2;
+	if (!max_distance && Geometry::GetPoint(geom1, pt1, srid1) && Geometry::GetPoint(geom2, pt2, srid2) &&
+	    srid1 == srid2) {
+		return Geometry::Distance(pt1, pt2, srid1, use_spheroid);
+	}
+	// A constant argument is decoded and indexed once, only the other side is read per row
+	auto cached = cache.Lookup((const uint8_t *)geom1.GetDataUnsafe(), geom1.GetSize(),
+	                           (const uint8_t *)geom2.GetDataUnsafe(), geom2.GetSize());
+	auto lwgeom1 = cached == 1 ? cache.lwgeom : Geometry::GetLWGeom(geom1);
+	auto lwgeom2 = cached == 2 ? cache.lwgeom : Geometry::GetLWGeom(geom2);
+	if (!lwgeom1 || !lwgeom2) {
+		if (lwgeom1 && cached != 1) {
+			Geometry::DestroyLWGeom(lwgeom1);
+		}
+		if (lwgeom2 && cached != 2) {
+			Geometry::DestroyLWGeom(lwgeom2);
+		}
+		if (max_distance) {
+			throw ConversionException("Failure in geometry get max distance: could not getting max distance from geom");
+		}
+		throw ConversionException("Failure in geometry get distance: could not getting distance from geom");
+	}
+	if (max_distance) {
+		dis = Geometry::MaxDistance(lwgeom1, lwgeom2, use_spheroid, &cache);
+	} else {
+		dis = Geometry::Distance(lwgeom1, lwgeom2, use_spheroid, &cache);
+	}
+	if (cached != 1) {
+		Geometry::DestroyLWGeom(lwgeom1);
+	}
+	if (cached != 2) {
+		Geometry::DestroyLWGeom(lwgeom2);
+	}
+	return dis;
+}
+
+template <typename TA, typename TB, typename TR>
+static void GeometryDistanceBinaryExecutor(CircTreeGeomCache &cache, Vector &geom1, Vector &geom2, Vector &result,
+                                           idx_t count) {
+	BinaryExecutor::Execute<TA, TB, TR>(geom1, geom2, result, count, [&](TA geom1_val, TB geom2_val) {
+		return GeometryDistanceScalarFunction<TA, TB, TR>(cache, geom1_val, geom2_val, false, false);
+	});
+}
+
+template <typename TA, typename TB, typename TC, typename TR>
+static void GeometryDistanceTernaryExecutor(CircTreeGeomCache &cache, Vector &geom1, Vector &geom2,
+                                            Vector &use_spheroid, Vector &result, idx_t count) {
+	TernaryExecutor::Execute<TA, TB, TC, TR>(geom1, geom2, use_spheroid, result, count,
+	                                         [&](TA geom1_val, TB geom2_val, TC use_spheroid_val) {
+		                                         return GeometryDistanceScalarFunction<TA, TB, TR>(
+		                                             cache, geom1_val, geom2_val, use_spheroid_val, false);
+	                                         });
+}
+
+void GeoFunctions::GeometryDistanceFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &cache = GetCircTreeCache(state);
+	auto &geom1_arg = args.data[0];
+	auto &geom2_arg = args.data[1];
+	if (args.data.size() == 2) {
+		GeometryDistanceBinaryExecutor<string_t, string_t, double>(cache, geom1_arg, geom2_arg, result, args.size());
+	} else if (args.data.size() == 3) {
+		auto &use_spheroid_arg = args.data[2];
+		GeometryDistanceTernaryExecutor<string_t, string_t, bool, double>(cache, geom1_arg, geom2_arg,
+		                                                                  use_spheroid_arg, result, args.size());
 	}
 }
 
@@ -695,11 +1099,7 @@ struct CentroidUnaryOperator {
 			Geometry::DestroyGeometry(gser);
 			return geom;
 		}
-		idx_t rv_size = Geometry::GetGeometrySize(gserCentroid);
-		auto base = Geometry::GetBase(gserCentroid);
-		auto result_str = StringVector::EmptyString(result, rv_size);
-		memcpy(result_str.GetDataWriteable(), base, rv_size);
-		result_str.Finalize();
+		auto result_str = Geometry::ToWKB(result, gserCentroid);
 		Geometry::DestroyGeometry(gser);
 		Geometry::DestroyGeometry(gserCentroid);
 		return result_str;
@@ -747,7 +1147,7 @@ void GeoFunctions::GeometryCentroidFunction(DataChunk &args, ExpressionState &st
 
 struct FromTextUnaryOperator {
 	template <class TA, class TR>
-	static inline TR Operation(TA text) {
+	static inline TR Operation(TA text, Vector &result) {
 		if (text.GetSize() == 0) {
 			return text;
 		}
@@ -756,62 +1156,47 @@ struct FromTextUnaryOperator {
 			throw ConversionException("Failure in geometry from text: could not convert text to geometry");
 			return string_t();
 		}
-		idx_t size = Geometry::GetGeometrySize(gser);
-		auto base = Geometry::GetBase(gser);
+		auto result_str = Geometry::ToWKB(result, gser);
 		Geometry::DestroyGeometry(gser);
-		return string_t((const char *)base, size);
+		return result_str;
 	}
 };
 
-struct FromTextBinaryOperator {
-	template <class TA, class TB, class TR>
-	static inline TR Operation(TA text, TB srid) {
-		if (text.GetSize() == 0) {
-			return text;
-		}
-		auto gser = Geometry::FromText(&text.GetString()[0], srid);
-		if (!gser) {
-			throw ConversionException("Failure in geometry from text: could not convert text to geometry");
-			return string_t();
-		}
-		idx_t size = Geometry::GetGeometrySize(gser);
-		auto base = Geometry::GetBase(gser);
-		Geometry::DestroyGeometry(gser);
-		return string_t((const char *)base, size);
+template <typename TA, typename TB, typename TR>
+static TR FromTextScalarFunction(Vector &result, TA text, TB srid) {
+	if (text.GetSize() == 0) {
+		return text;
 	}
-};
+	auto gser = Geometry::FromText(&text.GetString()[0], srid);
+	if (!gser) {
+		throw ConversionException("Failure in geometry from text: could not convert text to geometry");
+		return string_t();
+	}
+	auto result_str = Geometry::ToWKB(result, gser);
+	Geometry::DestroyGeometry(gser);
+	return result_str;
+}
 
 template <typename TA, typename TR>
 static void GeometryFromTextUnaryExecutor(Vector &text, Vector &result, idx_t count) {
-	UnaryExecutor::Execute<TA, TR, FromTextUnaryOperator>(text, result, count);
+	UnaryExecutor::ExecuteString<TA, TR, FromTextUnaryOperator>(text, result, count);
 }
 
 template <typename TA, typename TB, typename TR>
 static void GeometryFromTextBinaryExecutor(Vector &text, Vector &srid, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, FromTextBinaryOperator>(text, srid, result, count);
+	BinaryExecutor::Execute<TA, TB, TR>(text, srid, result, count, [&](TA text_val, TB srid_val) {
+		return FromTextScalarFunction<TA, TB, TR>(result, text_val, srid_val);
+	});
 }
 
 void GeoFunctions::GeometryFromTextFunction(DataChunk &args, ExpressionState &state, Vector &result) {
-	int currindex = loopindex;
-	queue.push_back(currindex);
-	loopindex++;
-	while (queue.size() > 0 && queue[0] != currindex) {
-		usleep(30);
-	}
-	try {
-		auto &text_arg = args.data[0];
-		if (args.data.size() == 1) {
-			GeometryFromTextUnaryExecutor<string_t, string_t>(text_arg, result, args.size());
-		} else if (args.data.size() == 2) {
-			auto &srid_arg = args.data[1];
-			GeometryFromTextBinaryExecutor<string_t, int32_t, string_t>(text_arg, srid_arg, result, args.size());
-		}
-	} catch (const std::exception &e) {
-		queue.erase(queue.begin());
-		throw Exception(e.what());
-		return;
+	auto &text_arg = args.data[0];
+	if (args.data.size() == 1) {
+		GeometryFromTextUnaryExecutor<string_t, string_t>(text_arg, result, args.size());
+	} else if (args.data.size() == 2) {
+		auto &srid_arg = args.data[1];
+		GeometryFromTextBinaryExecutor<string_t, int32_t, string_t>(text_arg, srid_arg, result, args.size());
 	}
-	queue.erase(queue.begin());
 }
 
 struct FromWKBUnaryOperator {
@@ -824,29 +1209,25 @@ struct FromWKBUnaryOperator {
 		if (!gser) {
 			throw ConversionException("Failure in geometry from WKB: could not convert WKB to geometry");
 		}
-		idx_t size = Geometry::GetGeometrySize(gser);
-		auto base = Geometry::GetBase(gser);
+		auto result_str = Geometry::ToWKB(*(Vector *)dataptr, gser);
 		Geometry::DestroyGeometry(gser);
-		return string_t((const char *)base, size);
+		return result_str;
 	}
 };
 
-struct FromWKBBinaryOperator {
-	template <class TA, class TB, class TR>
-	static inline TR Operation(TA text, TB srid) {
-		if (text.GetSize() == 0) {
-			return text;
-		}
-		auto gser = Geometry::FromWKB(text.GetDataUnsafe(), text.GetSize(), srid);
-		if (!gser) {
-			throw ConversionException("Failure in geometry from WKB: could not convert WKB to geometry");
-		}
-		idx_t size = Geometry::GetGeometrySize(gser);
-		auto base = Geometry::GetBase(gser);
-		Geometry::DestroyGeometry(gser);
-		return string_t((const char *)base, size);
+template <typename TA, typename TB, typename TR>
+static TR FromWKBScalarFunction(Vector &result, TA text, TB srid) {
+	if (text.GetSize() == 0) {
+		return text;
 	}
-};
+	auto gser = Geometry::FromWKB(text.GetDataUnsafe(), text.GetSize(), srid);
+	if (!gser) {
+		throw ConversionException("Failure in geometry from WKB: could not convert WKB to geometry");
+	}
+	auto result_str = Geometry::ToWKB(result, gser);
+	Geometry::DestroyGeometry(gser);
+	return result_str;
+}
 
 template <typename TA, typename TR>
 static void GeometryFromWKBUnaryExecutor(Vector &text, Vector &result, idx_t count) {
@@ -855,7 +1236,9 @@ static void GeometryFromWKBUnaryExecutor(Vector &text, Vector &result, idx_t cou
 
 template <typename TA, typename TB, typename TR>
 static void GeometryFromWKBBinaryExecutor(Vector &text, Vector &srid, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, FromWKBBinaryOperator>(text, srid, result, count);
+	BinaryExecutor::Execute<TA, TB, TR>(text, srid, result, count, [&](TA text_val, TB srid_val) {
+		return FromWKBScalarFunction<TA, TB, TR>(result, text_val, srid_val);
+	});
 }
 
 void GeoFunctions::GeometryFromWKBFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -870,7 +1253,7 @@ void GeoFunctions::GeometryFromWKBFunction(DataChunk &args, ExpressionState &sta
 
 struct FromGeoHashUnaryOperator {
 	template <class TA, class TR>
-	static inline TR Operation(TA text) {
+	static inline TR Operation(TA text, Vector &result) {
 		if (text.GetSize() == 0) {
 			return text;
 		}
@@ -878,38 +1261,36 @@ struct FromGeoHashUnaryOperator {
 		if (!gser) {
 			throw ConversionException("Failure in geometry from geo hash: could not convert geo hash to geometry");
 		}
-		idx_t size = Geometry::GetGeometrySize(gser);
-		auto base = Geometry::GetBase(gser);
+		auto result_str = Geometry::ToWKB(result, gser);
 		Geometry::DestroyGeometry(gser);
-		return string_t((const char *)base, size);
+		return result_str;
 	}
 };
 
-struct FromGeoHashBinaryOperator {
-	template <class TA, class TB, class TR>
-	static inline TR Operation(TA text, TB precision) {
-		if (text.GetSize() == 0) {
-			return text;
-		}
-		auto gser = Geometry::FromGeoHash(text, precision);
-		if (!gser) {
-			throw ConversionException("Failure in geometry from geo hash: could not convert geo hash to geometry");
-		}
-		idx_t size = Geometry::GetGeometrySize(gser);
-		auto base = Geometry::GetBase(gser);
-		Geometry::DestroyGeometry(gser);
-		return string_t((const char *)base, size);
+template <typename TA, typename TB, typename TR>
+static TR FromGeoHashScalarFunction(Vector &result, TA text, TB precision) {
+	if (text.GetSize() == 0) {
+		return text;
 	}
-};
+	auto gser = Geometry::FromGeoHash(text, precision);
+	if (!gser) {
+		throw ConversionException("Failure in geometry from geo hash: could not convert geo hash to geometry");
+	}
+	auto result_str = Geometry::ToWKB(result, gser);
+	Geometry::DestroyGeometry(gser);
+	return result_str;
+}
 
 template <typename TA, typename TR>
 static void GeometryFromGeoHashUnaryExecutor(Vector &text, Vector &result, idx_t count) {
-	UnaryExecutor::Execute<TA, TR, FromGeoHashUnaryOperator>(text, result, count);
+	UnaryExecutor::ExecuteString<TA, TR, FromGeoHashUnaryOperator>(text, result, count);
 }
 
 template <typename TA, typename TB, typename TR>
 static void GeometryFromGeoHashBinaryExecutor(Vector &text, Vector &precision, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, FromGeoHashBinaryOperator>(text, precision, result, count);
+	BinaryExecutor::Execute<TA, TB, TR>(text, precision, result, count, [&](TA text_val, TB precision_val) {
+		return FromGeoHashScalarFunction<TA, TB, TR>(result, text_val, precision_val);
+	});
 }
 
 void GeoFunctions::GeometryFromGeoHashFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -924,7 +1305,7 @@ void GeoFunctions::GeometryFromGeoHashFunction(DataChunk &args, ExpressionState
 
 struct GPointFromGeoHashUnaryOperator {
 	template <class TA, class TR>
-	static inline TR Operation(TA text) {
+	static inline TR Operation(TA text, Vector &result) {
 		if (text.GetSize() == 0) {
 			return text;
 		}
@@ -937,45 +1318,43 @@ struct GPointFromGeoHashUnaryOperator {
 			Geometry::DestroyGeometry(gser);
 			throw ConversionException("Failure in geometry from geo hash: could not convert geo hash to geometry");
 		}
-		idx_t size = Geometry::GetGeometrySize(gserCentroid);
-		auto base = Geometry::GetBase(gserCentroid);
+		auto result_str = Geometry::ToWKB(result, gserCentroid);
 		Geometry::DestroyGeometry(gser);
 		Geometry::DestroyGeometry(gserCentroid);
-		return string_t((const char *)base, size);
+		return result_str;
 	}
 };
 
-struct GPointFromGeoHashBinaryOperator {
-	template <class TA, class TB, class TR>
-	static inline TR Operation(TA text, TB precision) {
-		if (text.GetSize() == 0) {
-			return text;
-		}
-		auto gser = Geometry::FromGeoHash(text, precision);
-		if (!gser) {
-			throw ConversionException("Failure in geometry from geo hash: could not convert geo hash to geometry");
-		}
-		auto gserCentroid = Geometry::Centroid(gser);
-		if (!gserCentroid) {
-			Geometry::DestroyGeometry(gser);
-			throw ConversionException("Failure in geometry from geo hash: could not convert geo hash to geometry");
-		}
-		idx_t size = Geometry::GetGeometrySize(gserCentroid);
-		auto base = Geometry::GetBase(gserCentroid);
+template <typename TA, typename TB, typename TR>
+static TR GPointFromGeoHashScalarFunction(Vector &result, TA text, TB precision) {
+	if (text.GetSize() == 0) {
+		return text;
+	}
+	auto gser = Geometry::FromGeoHash(text, precision);
+	if (!gser) {
+		throw ConversionException("Failure in geometry from geo hash: could not convert geo hash to geometry");
+	}
+	auto gserCentroid = Geometry::Centroid(gser);
+	if (!gserCentroid) {
 		Geometry::DestroyGeometry(gser);
-		Geometry::DestroyGeometry(gserCentroid);
-		return string_t((const char *)base, size);
+		throw ConversionException("Failure in geometry from geo hash: could not convert geo hash to geometry");
 	}
-};
+	auto result_str = Geometry::ToWKB(result, gserCentroid);
+	Geometry::DestroyGeometry(gser);
+	Geometry::DestroyGeometry(gserCentroid);
+	return result_str;
+}
 
 template <typename TA, typename TR>
 static void GeometryGPointFromGeoHashUnaryExecutor(Vector &text, Vector &result, idx_t count) {
-	UnaryExecutor::Execute<TA, TR, GPointFromGeoHashUnaryOperator>(text, result, count);
+	UnaryExecutor::ExecuteString<TA, TR, GPointFromGeoHashUnaryOperator>(text, result, count);
 }
 
 template <typename TA, typename TB, typename TR>
 static void GeometryGPointFromGeoHashBinaryExecutor(Vector &text, Vector &precision, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, GPointFromGeoHashBinaryOperator>(text, precision, result, count);
+	BinaryExecutor::Execute<TA, TB, TR>(text, precision, result, count, [&](TA text_val, TB precision_val) {
+		return GPointFromGeoHashScalarFunction<TA, TB, TR>(result, text_val, precision_val);
+	});
 }
 
 void GeoFunctions::GeometryGPointFromGeoHashFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -991,7 +1370,7 @@ void GeoFunctions::GeometryGPointFromGeoHashFunction(DataChunk &args, Expression
 
 struct BoundaryUnaryOperator {
 	template <class TA, class TR>
-	static inline TR Operation(TA geom) {
+	static inline TR Operation(TA geom, Vector &result) {
 		if (geom.GetSize() == 0) {
 			return geom;
 		}
@@ -1003,17 +1382,16 @@ struct BoundaryUnaryOperator {
 		if (!gserBoundary) {
 			throw ConversionException("Failure in geometry boundary: could not getting boundary from geom");
 		}
-		idx_t size = Geometry::GetGeometrySize(gserBoundary);
-		auto base = Geometry::GetBase(gserBoundary);
+		auto result_str = Geometry::ToWKB(result, gserBoundary);
 		Geometry::DestroyGeometry(gser);
 		Geometry::DestroyGeometry(gserBoundary);
-		return string_t((const char *)base, size);
+		return result_str;
 	}
 };
 
 template <typename TA, typename TR>
 static void GeometryBoundaryUnaryExecutor(Vector &geom, Vector &result, idx_t count) {
-	UnaryExecutor::Execute<TA, TR, BoundaryUnaryOperator>(geom, result, count);
+	UnaryExecutor::ExecuteString<TA, TR, BoundaryUnaryOperator>(geom, result, count);
 }
 
 void GeoFunctions::GeometryBoundaryFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -1027,13 +1405,13 @@ struct DimensionUnaryOperator {
 		if (geom.GetSize() == 0) {
 			return -1;
 		}
-		auto gser = Geometry::GetGserialized(geom);
-		if (!gser) {
+		auto lwgeom = Geometry::GetLWGeom(geom);
+		if (!lwgeom) {
 			throw ConversionException("Failure in geometry dimension: could not getting dimension from geom");
 			return -1;
 		}
-		auto dimension = Geometry::LWGEOM_dimension(gser);
-		Geometry::DestroyGeometry(gser);
+		auto dimension = Geometry::LWGEOM_dimension(lwgeom);
+		Geometry::DestroyLWGeom(lwgeom);
 		return dimension;
 	}
 };
@@ -1064,10 +1442,9 @@ void GeometryDumpOperator(string_t geom, idx_t idx, LogicalType child_type, Vect
 	vector<Value> geom_values;
 	for (idx_t i = 0; i < gserArray.size(); i++) {
 		auto gserChild = gserArray[i];
-		idx_t rv_size = Geometry::GetGeometrySize(gserChild);
-		auto base = Geometry::GetBase(gserChild);
+		auto wkb = Geometry::ToGeometry(gserChild);
 		Geometry::DestroyGeometry(gserChild);
-		auto value = Value::BLOB((const_data_ptr_t)base, rv_size);
+		auto value = Value::BLOB((const_data_ptr_t)wkb.data(), wkb.size());
 		value.GetTypeMutable().CopyAuxInfo(child_type);
 		geom_values.emplace_back(value);
 	}
@@ -1188,11 +1565,10 @@ struct EndPointUnaryOperator {
 			result_mask.SetInvalid(i);
 			return string_t();
 		}
-		idx_t size = Geometry::GetGeometrySize(gserEndpoint);
-		auto base = Geometry::GetBase(gserEndpoint);
+		auto result_str = Geometry::ToWKB(*(Vector *)dataptr, gserEndpoint);
 		Geometry::DestroyGeometry(gser);
 		Geometry::DestroyGeometry(gserEndpoint);
-		return string_t((const char *)base, size);
+		return result_str;
 	}
 };
 
@@ -1212,17 +1588,17 @@ struct TypeUnaryOperator {
 		if (geom.GetSize() == 0) {
 			return string_t();
 		}
-		auto gser = Geometry::GetGserialized(geom);
-		if (!gser) {
+		auto lwgeom = Geometry::GetLWGeom(geom);
+		if (!lwgeom) {
 			throw ConversionException("Failure in geometry dimension: could not getting dimension from geom");
 			return string_t();
 		}
-		auto geometrytype = Geometry::Geometrytype(gser);
+		auto geometrytype = Geometry::Geometrytype(lwgeom);
 		auto rv_size = geometrytype.size();
 		auto result_str = StringVector::EmptyString(result, rv_size);
 		memcpy(result_str.GetDataWriteable(), geometrytype.c_str(), rv_size);
 		result_str.Finalize();
-		Geometry::DestroyGeometry(gser);
+		Geometry::DestroyLWGeom(lwgeom);
 		return result_str;
 	}
 };
@@ -1243,13 +1619,13 @@ struct IsClosedUnaryOperator {
 		if (geom.GetSize() == 0) {
 			return false;
 		}
-		auto gser = Geometry::GetGserialized(geom);
-		if (!gser) {
+		auto lwgeom = Geometry::GetLWGeom(geom);
+		if (!lwgeom) {
 			throw ConversionException("Failure in geometry is closed: could not getting closed from geom");
 			return false;
 		}
-		auto isClosed = Geometry::IsClosed(gser);
-		Geometry::DestroyGeometry(gser);
+		auto isClosed = Geometry::IsClosed(lwgeom);
+		Geometry::DestroyLWGeom(lwgeom);
 		return isClosed;
 	}
 };
@@ -1270,13 +1646,13 @@ struct IsCollectionUnaryOperator {
 		if (geom.GetSize() == 0) {
 			return false;
 		}
-		auto gser = Geometry::GetGserialized(geom);
-		if (!gser) {
+		auto lwgeom = Geometry::GetLWGeom(geom);
+		if (!lwgeom) {
 			throw ConversionException("Failure in geometry is collection: could not getting collection from geom");
 			return false;
 		}
-		auto isCollection = Geometry::IsCollection(gser);
-		Geometry::DestroyGeometry(gser);
+		auto isCollection = Geometry::IsCollection(lwgeom);
+		Geometry::DestroyLWGeom(lwgeom);
 		return isCollection;
 	}
 };
@@ -1297,13 +1673,13 @@ struct IsEmptyUnaryOperator {
 		if (geom.GetSize() == 0) {
 			return true;
 		}
-		auto gser = Geometry::GetGserialized(geom);
-		if (!gser) {
+		auto lwgeom = Geometry::GetLWGeom(geom);
+		if (!lwgeom) {
 			throw ConversionException("Failure in geometry is empty: could not getting empty from geom");
 			return true;
 		}
-		auto isEmpty = Geometry::IsEmpty(gser);
-		Geometry::DestroyGeometry(gser);
+		auto isEmpty = Geometry::IsEmpty(lwgeom);
+		Geometry::DestroyLWGeom(lwgeom);
 		return isEmpty;
 	}
 };
@@ -1324,13 +1700,13 @@ struct IsRingUnaryOperator {
 		if (geom.GetSize() == 0) {
 			return true;
 		}
-		auto gser = Geometry::GetGserialized(geom);
-		if (!gser) {
+		auto lwgeom = Geometry::GetLWGeom(geom);
+		if (!lwgeom) {
 			throw ConversionException("Failure in geometry is ring: could not getting ring from geom");
 			return true;
 		}
-		auto isRing = Geometry::IsRing(gser);
-		Geometry::DestroyGeometry(gser);
+		auto isRing = Geometry::IsRing(lwgeom);
+		Geometry::DestroyLWGeom(lwgeom);
 		return isRing;
 	}
 };
@@ -1351,13 +1727,18 @@ struct NPointsUnaryOperator {
 		if (geom.GetSize() == 0) {
 			return 0;
 		}
-		auto gser = Geometry::GetGserialized(geom);
-		if (!gser) {
+		// The box header counts the points already
+		WKB_HEADER header;
+		if (Geometry::GetHeader(geom, header)) {
+			return header.npoints;
+		}
+		auto lwgeom = Geometry::GetLWGeom(geom);
+		if (!lwgeom) {
 			throw ConversionException("Failure in geometry is ring: could not getting ring from geom");
 			return 0;
 		}
-		auto nPoints = Geometry::NPoints(gser);
-		Geometry::DestroyGeometry(gser);
+		auto nPoints = Geometry::NPoints(lwgeom);
+		Geometry::DestroyLWGeom(lwgeom);
 		return nPoints;
 	}
 };
@@ -1378,13 +1759,13 @@ struct NumGeometriesUnaryOperator {
 		if (geom.GetSize() == 0) {
 			return 0;
 		}
-		auto gser = Geometry::GetGserialized(geom);
-		if (!gser) {
+		auto lwgeom = Geometry::GetLWGeom(geom);
+		if (!lwgeom) {
 			throw ConversionException("Failure in geometry is ring: could not getting ring from geom");
 			return 0;
 		}
-		auto numGeometries = Geometry::NumGeometries(gser);
-		Geometry::DestroyGeometry(gser);
+		auto numGeometries = Geometry::NumGeometries(lwgeom);
+		Geometry::DestroyLWGeom(lwgeom);
 		return numGeometries;
 	}
 };
@@ -1405,13 +1786,13 @@ struct NumPointsUnaryOperator {
 		if (geom.GetSize() == 0) {
 			return 0;
 		}
-		auto gser = Geometry::GetGserialized(geom);
-		if (!gser) {
+		auto lwgeom = Geometry::GetLWGeom(geom);
+		if (!lwgeom) {
 			throw ConversionException("Failure in geometry is ring: could not getting ring from geom");
 			return 0;
 		}
-		auto numPoints = Geometry::NumPoints(gser);
-		Geometry::DestroyGeometry(gser);
+		auto numPoints = Geometry::NumPoints(lwgeom);
+		Geometry::DestroyLWGeom(lwgeom);
 		return numPoints;
 	}
 };
@@ -1441,11 +1822,7 @@ static TR PointNScalarFunction(Vector &result, TA geom, TB index, ValidityMask &
 		mask.SetInvalid(idx);
 		return string_t();
 	}
-	idx_t rv_size = Geometry::GetGeometrySize(gserPointN);
-	auto base = Geometry::GetBase(gserPointN);
-	auto result_str = StringVector::EmptyString(result, rv_size);
-	memcpy(result_str.GetDataWriteable(), base, rv_size);
-	result_str.Finalize();
+	auto result_str = Geometry::ToWKB(result, gserPointN);
 	Geometry::DestroyGeometry(gser);
 	Geometry::DestroyGeometry(gserPointN);
 	return result_str;
@@ -1481,12 +1858,10 @@ struct StartPointUnaryOperator {
 			result_mask.SetInvalid(i);
 			return string_t();
 		}
-		idx_t rv_size = Geometry::GetGeometrySize(gserStartPoint);
-		auto base = Geometry::GetBase(gserStartPoint);
+		auto result_str = Geometry::ToWKB(*(Vector *)dataptr, gserStartPoint);
 		Geometry::DestroyGeometry(gser);
 		Geometry::DestroyGeometry(gserStartPoint);
-		return string_t((const char *)base, rv_size);
-		;
+		return result_str;
 	}
 };
 
@@ -1508,13 +1883,19 @@ struct GetXUnaryOperator {
 			//     "Failure in geometry get X: could not get coordinate X from geometry");
 			return 0.00;
 		}
-		auto gser = Geometry::GetGserialized(geom);
-		if (!gser) {
+		// Points are read with direct loads, inlined into the loop over the chunk
+		POINT2D pt;
+		int32_t srid;
+		if (Geometry::GetPoint(geom, pt, srid)) {
+			return pt.x;
+		}
+		auto lwgeom = Geometry::GetLWGeom(geom);
+		if (!lwgeom) {
 			throw ConversionException("Failure in geometry gets X: could not getting X from geom");
 			return 0.00;
 		}
-		double x_val = Geometry::XPoint(gser);
-		Geometry::DestroyGeometry(gser);
+		double x_val = Geometry::XPoint(lwgeom);
+		Geometry::DestroyLWGeom(lwgeom);
 		return x_val;
 	}
 };
@@ -1537,13 +1918,19 @@ struct GetYUnaryOperator {
 			//     "Failure in geometry get X: could not get coordinate X from geometry");
 			return 0.00;
 		}
-		auto gser = Geometry::GetGserialized(geom);
-		if (!gser) {
+		// Points are read with direct loads, inlined into the loop over the chunk
+		POINT2D pt;
+		int32_t srid;
+		if (Geometry::GetPoint(geom, pt, srid)) {
+			return pt.y;
+		}
+		auto lwgeom = Geometry::GetLWGeom(geom);
+		if (!lwgeom) {
 			throw ConversionException("Failure in geometry gets Y: could not getting Y from geom");
 			return 0.00;
 		}
-		double y_val = Geometry::YPoint(gser);
-		Geometry::DestroyGeometry(gser);
+		double y_val = Geometry::YPoint(lwgeom);
+		Geometry::DestroyLWGeom(lwgeom);
 		return y_val;
 	}
 };
@@ -1558,6 +1945,37 @@ void GeoFunctions::GeometryGetYFunction(DataChunk &args, ExpressionState &state,
 	GeometryGetYUnaryExecutor<string_t, double>(geom_arg, result, args.size());
 }
 
+//! One bound of the planar box, read from the WKB without decoding the geometry, NULL for an empty geometry
+template <double GBOX::*BOUND>
+static void GeometryBoxBoundExecutor(Vector &geom, Vector &result, idx_t count) {
+	UnaryExecutor::ExecuteWithNulls<string_t, double>(
+	    geom, result, count, [&](string_t input, ValidityMask &mask, idx_t idx) {
+		    GBOX box;
+		    int32_t srid;
+		    if (!Geometry::GetBoundingBox(input, box, srid)) {
+			    mask.SetInvalid(idx);
+			    return 0.0;
+		    }
+		    return box.*BOUND;
+	    });
+}
+
+void GeoFunctions::GeometryXMinFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	GeometryBoxBoundExecutor<&GBOX::xmin>(args.data[0], result, args.size());
+}
+
+void GeoFunctions::GeometryXMaxFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	GeometryBoxBoundExecutor<&GBOX::xmax>(args.data[0], result, args.size());
+}
+
+void GeoFunctions::GeometryYMinFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	GeometryBoxBoundExecutor<&GBOX::ymin>(args.data[0], result, args.size());
+}
+
+void GeoFunctions::GeometryYMaxFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	GeometryBoxBoundExecutor<&GBOX::ymax>(args.data[0], result, args.size());
+}
+
 template <typename TA, typename TB, typename TR>
 static TR DifferenceScalarFunction(Vector &result, TA geom1, TB geom2) {
 	if (geom1.GetSize() == 0 && geom2.GetSize() == 0) {
@@ -1581,11 +1999,7 @@ static TR DifferenceScalarFunction(Vector &result, TA geom1, TB geom2) {
 		return string_t();
 	}
 	auto gserDiff = Geometry::Difference(gser1, gser2);
-	idx_t rv_size = Geometry::GetGeometrySize(gserDiff);
-	auto base = Geometry::GetBase(gserDiff);
-	auto result_str = StringVector::EmptyString(result, rv_size);
-	memcpy(result_str.GetDataWriteable(), base, rv_size);
-	result_str.Finalize();
+	auto result_str = Geometry::ToWKB(result, gserDiff);
 	Geometry::DestroyGeometry(gser1);
 	Geometry::DestroyGeometry(gser2);
 	Geometry::DestroyGeometry(gserDiff);
@@ -1623,11 +2037,7 @@ static TR ClosestPointScalarFunction(Vector &result, TA geom1, TB geom2) {
 		return string_t();
 	}
 	auto gserClosestPoint = Geometry::ClosestPoint(gser1, gser2);
-	idx_t rv_size = Geometry::GetGeometrySize(gserClosestPoint);
-	auto base = Geometry::GetBase(gserClosestPoint);
-	auto result_str = StringVector::EmptyString(result, rv_size);
-	memcpy(result_str.GetDataWriteable(), base, rv_size);
-	result_str.Finalize();
+	auto result_str = Geometry::ToWKB(result, gserClosestPoint);
 	Geometry::DestroyGeometry(gser1);
 	Geometry::DestroyGeometry(gser2);
 	Geometry::DestroyGeometry(gserClosestPoint);
@@ -1665,11 +2075,7 @@ static TR UnionScalarFunction(Vector &result, TA geom1, TB geom2) {
 		return string_t();
 	}
 	auto gserUnion = Geometry::GeometryUnion(gser1, gser2);
-	idx_t rv_size = Geometry::GetGeometrySize(gserUnion);
-	auto base = Geometry::GetBase(gserUnion);
-	auto result_str = StringVector::EmptyString(result, rv_size);
-	memcpy(result_str.GetDataWriteable(), base, rv_size);
-	result_str.Finalize();
+	auto result_str = Geometry::ToWKB(result, gserUnion);
 	Geometry::DestroyGeometry(gser1);
 	Geometry::DestroyGeometry(gser2);
 	Geometry::DestroyGeometry(gserUnion);
@@ -1741,15 +2147,13 @@ void GeoFunctions::GeometryUnionArrayFunction(DataChunk &args, ExpressionState &
 		}
 		auto gsergeom = Geometry::GeometryUnionGArray(&gserArray[0], list_entry.length);
 		if (gsergeom) {
-			idx_t rv_size = Geometry::GetGeometrySize(gsergeom);
-			auto base = Geometry::GetBase(gsergeom);
+			result_entries[i] = Geometry::ToWKB(result, gsergeom);
 			if (list_entry.length > 1) {
 				for (idx_t child_idx = 0; child_idx < list_entry.length; child_idx++) {
 					Geometry::DestroyGeometry(gserArray[child_idx]);
 				}
 			}
 			Geometry::DestroyGeometry(gsergeom);
-			result_entries[i] = string_t((const char *)base, rv_size);
 		} else {
 			result_entries[i] = string_t();
 		}
@@ -1774,11 +2178,7 @@ static TR IntersectionScalarFunction(Vector &result, TA geom1, TB geom2) {
 		return string_t();
 	}
 	auto gserIntersection = Geometry::GeometryIntersection(gser1, gser2);
-	idx_t rv_size = Geometry::GetGeometrySize(gserIntersection);
-	auto base = Geometry::GetBase(gserIntersection);
-	auto result_str = StringVector::EmptyString(result, rv_size);
-	memcpy(result_str.GetDataWriteable(), base, rv_size);
-	result_str.Finalize();
+	auto result_str = Geometry::ToWKB(result, gserIntersection);
 	Geometry::DestroyGeometry(gser1);
 	Geometry::DestroyGeometry(gser2);
 	Geometry::DestroyGeometry(gserIntersection);
@@ -1817,11 +2217,7 @@ static TR SimplifyScalarFunction(Vector &result, TA geom, TB dist) {
 		Geometry::DestroyGeometry(gser);
 		return geom;
 	}
-	idx_t rv_size = Geometry::GetGeometrySize(gserSimplify);
-	auto base = Geometry::GetBase(gserSimplify);
-	auto result_str = StringVector::EmptyString(result, rv_size);
-	memcpy(result_str.GetDataWriteable(), base, rv_size);
-	result_str.Finalize();
+	auto result_str = Geometry::ToWKB(result, gserSimplify);
 	Geometry::DestroyGeometry(gser);
 	Geometry::DestroyGeometry(gserSimplify);
 	return result_str;
@@ -1842,7 +2238,7 @@ void GeoFunctions::GeometrySimplifyFunction(DataChunk &args, ExpressionState &st
 
 struct ConvexhullUnaryOperator {
 	template <class TA, class TR>
-	static inline TR Operation(TA geom) {
+	static inline TR Operation(TA geom, Vector &result) {
 		if (geom.GetSize() == 0) {
 			return geom;
 		}
@@ -1858,17 +2254,16 @@ struct ConvexhullUnaryOperator {
 			Geometry::DestroyGeometry(gser);
 			return string_t();
 		}
-		idx_t size = Geometry::GetGeometrySize(gserConvex);
-		auto base = Geometry::GetBase(gserConvex);
+		auto result_str = Geometry::ToWKB(result, gserConvex);
 		Geometry::DestroyGeometry(gser);
 		Geometry::DestroyGeometry(gserConvex);
-		return string_t((const char *)base, size);
+		return result_str;
 	}
 };
 
 template <typename TA, typename TR>
 static void GeometryConvexhullUnaryExecutor(Vector &geom, Vector &result, idx_t count) {
-	UnaryExecutor::Execute<TA, TR, ConvexhullUnaryOperator>(geom, result, count);
+	UnaryExecutor::ExecuteString<TA, TR, ConvexhullUnaryOperator>(geom, result, count);
 }
 
 void GeoFunctions::GeometryConvexhullFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -1895,11 +2290,7 @@ static TR SnapToGridScalarFunction(Vector &result, TA geom, TB size) {
 		Geometry::DestroyGeometry(gser);
 		return geom;
 	}
-	idx_t rv_size = Geometry::GetGeometrySize(gserSnapTogrid);
-	auto base = Geometry::GetBase(gserSnapTogrid);
-	auto result_str = StringVector::EmptyString(result, rv_size);
-	memcpy(result_str.GetDataWriteable(), base, rv_size);
-	result_str.Finalize();
+	auto result_str = Geometry::ToWKB(result, gserSnapTogrid);
 	Geometry::DestroyGeometry(gser);
 	Geometry::DestroyGeometry(gserSnapTogrid);
 	return result_str;
@@ -1937,11 +2328,7 @@ static TR BufferScalarFunction(Vector &result, TA geom, TB radius) {
 		Geometry::DestroyGeometry(gser);
 		return geom;
 	}
-	idx_t rv_size = Geometry::GetGeometrySize(gserBuffer);
-	auto base = Geometry::GetBase(gserBuffer);
-	auto result_str = StringVector::EmptyString(result, rv_size);
-	memcpy(result_str.GetDataWriteable(), base, rv_size);
-	result_str.Finalize();
+	auto result_str = Geometry::ToWKB(result, gserBuffer);
 	Geometry::DestroyGeometry(gser);
 	Geometry::DestroyGeometry(gserBuffer);
 	return result_str;
@@ -1960,38 +2347,38 @@ void GeoFunctions::GeometryBufferFunction(DataChunk &args, ExpressionState &stat
 	GeometryBufferBinaryExecutor<string_t, double, string_t>(geom_arg, radius_arg, result, args.size());
 }
 
-struct BufferTextTernaryOperator {
-	template <class TA, class TB, class TC, class TR>
-	static inline TR Operation(TA geom, TB radius, TC styles) {
-		if (geom.GetSize() == 0) {
-			return string_t();
-		}
-		auto gser = Geometry::GetGserialized(geom);
-		if (!gser) {
-			throw ConversionException("Failure in geometry get buffer: could not getting buffer from geom");
-			return string_t();
-		}
-		auto gserBuffer = Geometry::GeometryBufferText(gser, radius, styles.GetString());
-		if (!gserBuffer) {
-			Geometry::DestroyGeometry(gser);
-			return string_t();
-		}
-		if (gser == gserBuffer) {
-			Geometry::DestroyGeometry(gser);
-			return geom;
-		}
-		idx_t rv_size = Geometry::GetGeometrySize(gserBuffer);
-		auto base = Geometry::GetBase(gserBuffer);
+template <typename TA, typename TB, typename TC, typename TR>
+static TR BufferTextScalarFunction(Vector &result, TA geom, TB radius, TC styles) {
+	if (geom.GetSize() == 0) {
+		return string_t();
+	}
+	auto gser = Geometry::GetGserialized(geom);
+	if (!gser) {
+		throw ConversionException("Failure in geometry get buffer: could not getting buffer from geom");
+		return string_t();
+	}
+	auto gserBuffer = Geometry::GeometryBufferText(gser, radius, styles.GetString());
+	if (!gserBuffer) {
 		Geometry::DestroyGeometry(gser);
-		Geometry::DestroyGeometry(gserBuffer);
-		return string_t((const char *)base, rv_size);
+		return string_t();
 	}
-};
+	if (gser == gserBuffer) {
+		Geometry::DestroyGeometry(gser);
+		return geom;
+	}
+	auto result_str = Geometry::ToWKB(result, gserBuffer);
+	Geometry::DestroyGeometry(gser);
+	Geometry::DestroyGeometry(gserBuffer);
+	return result_str;
+}
 
 template <typename TA, typename TB, typename TC, typename TR>
 static void BufferTextTernaryExecutor(Vector &geom, Vector &radius, Vector &styles, Vector &result, idx_t count) {
 	TernaryExecutor::Execute<TA, TB, TC, TR>(geom, radius, styles, result, count,
-	                                         BufferTextTernaryOperator::Operation<TA, TB, TC, TR>);
+	                                         [&](TA geom_val, TB radius_val, TC styles_val) {
+		                                         return BufferTextScalarFunction<TA, TB, TC, TR>(result, geom_val,
+		                                                                                         radius_val, styles_val);
+	                                         });
 }
 
 void GeoFunctions::GeometryBufferTextFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -2011,21 +2398,25 @@ struct EqualsBinaryOperator {
 		if (geom1.GetSize() == 0 || geom2.GetSize() == 0) {
 			return false;
 		}
-		auto gser1 = Geometry::GetGserialized(geom1);
-		auto gser2 = Geometry::GetGserialized(geom2);
-		if (!gser1 || !gser2) {
-			if (gser1) {
-				Geometry::DestroyGeometry(gser1);
+		// binary-equivalent geometries are equal, no need to decode them
+		if (Equals::Operation(geom1, geom2)) {
+			return true;
+		}
+		auto lwgeom1 = Geometry::GetLWGeom(geom1);
+		auto lwgeom2 = Geometry::GetLWGeom(geom2);
+		if (!lwgeom1 || !lwgeom2) {
+			if (lwgeom1) {
+				Geometry::DestroyLWGeom(lwgeom1);
 			}
-			if (gser2) {
-				Geometry::DestroyGeometry(gser2);
+			if (lwgeom2) {
+				Geometry::DestroyLWGeom(lwgeom2);
 			}
 			throw ConversionException("Failure in geometry get equals: could not getting equals from geom");
 			return false;
 		}
-		auto equalsRv = Geometry::GeometryEquals(gser1, gser2);
-		Geometry::DestroyGeometry(gser1);
-		Geometry::DestroyGeometry(gser2);
+		auto equalsRv = Geometry::GeometryEquals(lwgeom1, lwgeom2);
+		Geometry::DestroyLWGeom(lwgeom1);
+		Geometry::DestroyLWGeom(lwgeom2);
 		return equalsRv;
 	}
 };
@@ -2041,277 +2432,175 @@ void GeoFunctions::GeometryEqualsFunction(DataChunk &args, ExpressionState &stat
 	GeometryEqualsBinaryExecutor<string_t, string_t, bool>(geom1_arg, geom2_arg, result, args.size());
 }
 
-struct ContainsBinaryOperator {
-	template <class TA, class TB, class TR>
-	static inline TR Operation(TA geom1, TB geom2) {
-		if (geom1.GetSize() == 0 && geom2.GetSize() == 0) {
-			return true;
-		}
-		if (geom1.GetSize() == 0 || geom2.GetSize() == 0) {
-			return false;
-		}
-		auto gser1 = Geometry::GetGserialized(geom1);
-		auto gser2 = Geometry::GetGserialized(geom2);
-		if (!gser1 || !gser2) {
-			if (gser1) {
-				Geometry::DestroyGeometry(gser1);
-			}
-			if (gser2) {
-				Geometry::DestroyGeometry(gser2);
-			}
-			throw ConversionException("Failure in geometry get equals: could not getting equals from geom");
-			return false;
-		}
-		auto equalsRv = Geometry::GeometryContains(gser1, gser2);
-		Geometry::DestroyGeometry(gser1);
-		Geometry::DestroyGeometry(gser2);
-		return equalsRv;
-	}
+//! Per-expression state of the spatial predicates
+struct PrepGeomCacheLocalState : public FunctionLocalState {
+	PrepGeomCache cache;
 };
 
-template <typename TA, typename TB, typename TR>
-static void GeometryContainsBinaryExecutor(Vector &geom1, Vector &geom2, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, ContainsBinaryOperator>(geom1, geom2, result, count);
+unique_ptr<FunctionLocalState> GeoFunctions::InitPrepGeomCache(ExpressionState &state,
+                                                               const BoundFunctionExpression &expr,
+                                                               FunctionData *bind_data) {
+	auto result = make_unique<PrepGeomCacheLocalState>();
+	result->cache.SetConstantArg(GetConstantArg(expr));
+	return move(result);
 }
 
-void GeoFunctions::GeometryContainsFunction(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &geom1_arg = args.data[0];
-	auto &geom2_arg = args.data[1];
-	GeometryContainsBinaryExecutor<string_t, string_t, bool>(geom1_arg, geom2_arg, result, args.size());
+static PrepGeomCache &GetPrepGeomCache(ExpressionState &state) {
+	return ((PrepGeomCacheLocalState *)ExecuteFunctionState::GetFunctionState(state))->cache;
 }
 
-struct TouchesBinaryOperator {
-	template <class TA, class TB, class TR>
-	static inline TR Operation(TA geom1, TB geom2) {
-		if (geom1.GetSize() == 0 && geom2.GetSize() == 0) {
-			return true;
-		}
-		if (geom1.GetSize() == 0 || geom2.GetSize() == 0) {
-			return false;
-		}
-		auto gser1 = Geometry::GetGserialized(geom1);
-		auto gser2 = Geometry::GetGserialized(geom2);
-		if (!gser1 || !gser2) {
-			if (gser1) {
-				Geometry::DestroyGeometry(gser1);
-			}
-			if (gser2) {
-				Geometry::DestroyGeometry(gser2);
-			}
-			throw ConversionException("Failure in geometry get touches: could not getting touches from geom");
-			return false;
-		}
-		auto touchesRv = Geometry::GeometryTouches(gser1, gser2);
-		Geometry::DestroyGeometry(gser1);
-		Geometry::DestroyGeometry(gser2);
-		return touchesRv;
-	}
-};
+typedef bool (*GeometryPredicate)(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache);
+//! Decides a predicate from the boxes of its arguments alone, returns false when they don't settle it
+typedef bool (*BoxPredicate)(const GBOX &box1, const GBOX &box2, bool &result);
 
-template <typename TA, typename TB, typename TR>
-static void GeometryTouchesBinaryExecutor(Vector &geom1, Vector &geom2, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, TouchesBinaryOperator>(geom1, geom2, result, count);
+static bool BoxIntersects(const GBOX &box1, const GBOX &box2, bool &result) {
+	result = false;
+	return !gbox_overlaps_2d(&box1, &box2);
 }
 
-void GeoFunctions::GeometryTouchesFunction(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &geom1_arg = args.data[0];
-	auto &geom2_arg = args.data[1];
-	GeometryTouchesBinaryExecutor<string_t, string_t, bool>(geom1_arg, geom2_arg, result, args.size());
+static bool BoxDisjoint(const GBOX &box1, const GBOX &box2, bool &result) {
+	result = true;
+	return !gbox_overlaps_2d(&box1, &box2);
 }
 
-struct WithInBinaryOperator {
-	template <class TA, class TB, class TR>
-	static inline TR Operation(TA geom1, TB geom2) {
-		if (geom1.GetSize() == 0 && geom2.GetSize() == 0) {
-			return true;
-		}
-		if (geom1.GetSize() == 0 || geom2.GetSize() == 0) {
-			return false;
-		}
-		auto gser1 = Geometry::GetGserialized(geom1);
-		auto gser2 = Geometry::GetGserialized(geom2);
-		if (!gser1 || !gser2) {
-			if (gser1) {
-				Geometry::DestroyGeometry(gser1);
-			}
-			if (gser2) {
-				Geometry::DestroyGeometry(gser2);
-			}
-			throw ConversionException("Failure in geometry get within: could not getting within from geom");
-			return false;
-		}
-		auto withinRv = Geometry::GeometryWithin(gser1, gser2);
-		Geometry::DestroyGeometry(gser1);
-		Geometry::DestroyGeometry(gser2);
-		return withinRv;
-	}
-};
+static bool BoxContains(const GBOX &box1, const GBOX &box2, bool &result) {
+	result = false;
+	return !gbox_contains_2d(&box1, &box2);
+}
 
-template <typename TA, typename TB, typename TR>
-static void GeometryWithinBinaryExecutor(Vector &geom1, Vector &geom2, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, WithInBinaryOperator>(geom1, geom2, result, count);
+static bool BoxWithin(const GBOX &box1, const GBOX &box2, bool &result) {
+	result = false;
+	return !gbox_contains_2d(&box2, &box1);
 }
 
-void GeoFunctions::GeometryWithinFunction(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &geom1_arg = args.data[0];
-	auto &geom2_arg = args.data[1];
-	GeometryWithinBinaryExecutor<string_t, string_t, bool>(geom1_arg, geom2_arg, result, args.size());
+//! Settles a predicate on the boxes of the box headers (or points) when both arguments have one, without decoding
+//! them. The float boxes are rounded outwards, so they only ever rule out what the exact boxes rule out.
+static bool GeometryBoxShortCircuit(BoxPredicate box_predicate, const string_t &geom1, const string_t &geom2,
+                                    bool &result) {
+	GBOX box1, box2;
+	int32_t srid1, srid2;
+	if (!Geometry::GetFastBoundingBox(geom1, box1, srid1) || !Geometry::GetFastBoundingBox(geom2, box2, srid2)) {
+		return false;
+	}
+	// Leave the error on mixed SRIDs to the predicate
+	return srid1 == srid2 && box_predicate(box1, box2, result);
 }
 
-struct IntersectsBinaryOperator {
-	template <class TA, class TB, class TR>
-	static inline TR Operation(TA geom1, TB geom2) {
-		if (geom1.GetSize() == 0 && geom2.GetSize() == 0) {
-			return true;
-		}
-		if (geom1.GetSize() == 0 || geom2.GetSize() == 0) {
-			return false;
+template <typename TA, typename TB, typename TR>
+static TR GeometryPredicateScalarFunction(PrepGeomCache &cache, GeometryPredicate predicate,
+                                          BoxPredicate box_predicate, const char *error, TA geom1, TB geom2) {
+	if (geom1.GetSize() == 0 && geom2.GetSize() == 0) {
+		return true;
+	}
+	if (geom1.GetSize() == 0 || geom2.GetSize() == 0) {
+		return false;
+	}
+	bool box_result;
+	if (GeometryBoxShortCircuit(box_predicate, geom1, geom2, box_result)) {
+		return box_result;
+	}
+	// A constant argument is decoded and prepared once, only the other side is read per row
+	auto cached = cache.Lookup((const uint8_t *)geom1.GetDataUnsafe(), geom1.GetSize(),
+	                           (const uint8_t *)geom2.GetDataUnsafe(), geom2.GetSize());
+	auto lwgeom1 = cached == 1 ? cache.lwgeom : Geometry::GetLWGeom(geom1);
+	auto lwgeom2 = cached == 2 ? cache.lwgeom : Geometry::GetLWGeom(geom2);
+	if (!lwgeom1 || !lwgeom2) {
+		if (lwgeom1 && cached != 1) {
+			Geometry::DestroyLWGeom(lwgeom1);
 		}
-		auto gser1 = Geometry::GetGserialized(geom1);
-		auto gser2 = Geometry::GetGserialized(geom2);
-		if (!gser1 || !gser2) {
-			if (gser1) {
-				Geometry::DestroyGeometry(gser1);
-			}
-			if (gser2) {
-				Geometry::DestroyGeometry(gser2);
-			}
-			throw ConversionException("Failure in geometry get intersects: could not getting intersects from geom");
-			return false;
+		if (lwgeom2 && cached != 2) {
+			Geometry::DestroyLWGeom(lwgeom2);
 		}
-		auto intersectsRv = Geometry::GeometryIntersects(gser1, gser2);
-		Geometry::DestroyGeometry(gser1);
-		Geometry::DestroyGeometry(gser2);
-		return intersectsRv;
+		throw ConversionException(error);
 	}
-};
+	auto rv = predicate(lwgeom1, lwgeom2, &cache);
+	if (cached != 1) {
+		Geometry::DestroyLWGeom(lwgeom1);
+	}
+	if (cached != 2) {
+		Geometry::DestroyLWGeom(lwgeom2);
+	}
+	return rv;
+}
 
 template <typename TA, typename TB, typename TR>
-static void GeometryIntersectsBinaryExecutor(Vector &geom1, Vector &geom2, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, IntersectsBinaryOperator>(geom1, geom2, result, count);
+static void GeometryPredicateBinaryExecutor(PrepGeomCache &cache, GeometryPredicate predicate,
+                                            BoxPredicate box_predicate, const char *error, Vector &geom1,
+                                            Vector &geom2, Vector &result, idx_t count) {
+	BinaryExecutor::Execute<TA, TB, TR>(geom1, geom2, result, count, [&](TA geom1_val, TB geom2_val) {
+		return GeometryPredicateScalarFunction<TA, TB, TR>(cache, predicate, box_predicate, error, geom1_val,
+		                                                   geom2_val);
+	});
 }
 
-void GeoFunctions::GeometryIntersectsFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+void GeoFunctions::GeometryContainsFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &cache = GetPrepGeomCache(state);
 	auto &geom1_arg = args.data[0];
 	auto &geom2_arg = args.data[1];
-	GeometryIntersectsBinaryExecutor<string_t, string_t, bool>(geom1_arg, geom2_arg, result, args.size());
+	GeometryPredicateBinaryExecutor<string_t, string_t, bool>(
+	    cache, Geometry::GeometryContains, BoxContains,
+	    "Failure in geometry get contains: could not getting contains from geom", geom1_arg, geom2_arg, result,
+	    args.size());
 }
 
-struct CoversBinaryOperator {
-	template <class TA, class TB, class TR>
-	static inline TR Operation(TA geom1, TB geom2) {
-		if (geom1.GetSize() == 0 && geom2.GetSize() == 0) {
-			return true;
-		}
-		if (geom1.GetSize() == 0 || geom2.GetSize() == 0) {
-			return false;
-		}
-		auto gser1 = Geometry::GetGserialized(geom1);
-		auto gser2 = Geometry::GetGserialized(geom2);
-		if (!gser1 || !gser2) {
-			if (gser1) {
-				Geometry::DestroyGeometry(gser1);
-			}
-			if (gser2) {
-				Geometry::DestroyGeometry(gser2);
-			}
-			throw ConversionException("Failure in geometry get covers: could not getting covers from geom");
-			return false;
-		}
-		auto coversRv = Geometry::GeometryCovers(gser1, gser2);
-		Geometry::DestroyGeometry(gser1);
-		Geometry::DestroyGeometry(gser2);
-		return coversRv;
-	}
-};
-
-template <typename TA, typename TB, typename TR>
-static void GeometryCoversBinaryExecutor(Vector &geom1, Vector &geom2, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, CoversBinaryOperator>(geom1, geom2, result, count);
+void GeoFunctions::GeometryTouchesFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &cache = GetPrepGeomCache(state);
+	auto &geom1_arg = args.data[0];
+	auto &geom2_arg = args.data[1];
+	GeometryPredicateBinaryExecutor<string_t, string_t, bool>(
+	    cache, Geometry::GeometryTouches, BoxIntersects,
+	    "Failure in geometry get touches: could not getting touches from geom", geom1_arg, geom2_arg, result,
+	    args.size());
 }
 
-void GeoFunctions::GeometryCoversFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+void GeoFunctions::GeometryWithinFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &cache = GetPrepGeomCache(state);
 	auto &geom1_arg = args.data[0];
 	auto &geom2_arg = args.data[1];
-	GeometryCoversBinaryExecutor<string_t, string_t, bool>(geom1_arg, geom2_arg, result, args.size());
+	GeometryPredicateBinaryExecutor<string_t, string_t, bool>(
+	    cache, Geometry::GeometryWithin, BoxWithin,
+	    "Failure in geometry get within: could not getting within from geom", geom1_arg, geom2_arg, result,
+	    args.size());
 }
 
-struct CoveredByBinaryOperator {
-	template <class TA, class TB, class TR>
-	static inline TR Operation(TA geom1, TB geom2) {
-		if (geom1.GetSize() == 0 && geom2.GetSize() == 0) {
-			return true;
-		}
-		if (geom1.GetSize() == 0 || geom2.GetSize() == 0) {
-			return false;
-		}
-		auto gser1 = Geometry::GetGserialized(geom1);
-		auto gser2 = Geometry::GetGserialized(geom2);
-		if (!gser1 || !gser2) {
-			if (gser1) {
-				Geometry::DestroyGeometry(gser1);
-			}
-			if (gser2) {
-				Geometry::DestroyGeometry(gser2);
-			}
-			throw ConversionException("Failure in geometry get covered by: could not getting covered by from geom");
-			return false;
-		}
-		auto coveredbyRv = Geometry::GeometryCoveredby(gser1, gser2);
-		Geometry::DestroyGeometry(gser1);
-		Geometry::DestroyGeometry(gser2);
-		return coveredbyRv;
-	}
-};
-
-template <typename TA, typename TB, typename TR>
-static void GeometryCoveredByBinaryExecutor(Vector &geom1, Vector &geom2, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, CoveredByBinaryOperator>(geom1, geom2, result, count);
+void GeoFunctions::GeometryIntersectsFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &cache = GetPrepGeomCache(state);
+	auto &geom1_arg = args.data[0];
+	auto &geom2_arg = args.data[1];
+	GeometryPredicateBinaryExecutor<string_t, string_t, bool>(
+	    cache, Geometry::GeometryIntersects, BoxIntersects,
+	    "Failure in geometry get intersects: could not getting intersects from geom", geom1_arg, geom2_arg,
+	    result, args.size());
 }
 
-void GeoFunctions::GeometryCoveredByFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+void GeoFunctions::GeometryCoversFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &cache = GetPrepGeomCache(state);
 	auto &geom1_arg = args.data[0];
 	auto &geom2_arg = args.data[1];
-	GeometryCoveredByBinaryExecutor<string_t, string_t, bool>(geom1_arg, geom2_arg, result, args.size());
+	GeometryPredicateBinaryExecutor<string_t, string_t, bool>(
+	    cache, Geometry::GeometryCovers, BoxContains,
+	    "Failure in geometry get covers: could not getting covers from geom", geom1_arg, geom2_arg, result,
+	    args.size());
 }
 
-struct DisjointBinaryOperator {
-	template <class TA, class TB, class TR>
-	static inline TR Operation(TA geom1, TB geom2) {
-		if (geom1.GetSize() == 0 && geom2.GetSize() == 0) {
-			return true;
-		}
-		if (geom1.GetSize() == 0 || geom2.GetSize() == 0) {
-			return false;
-		}
-		auto gser1 = Geometry::GetGserialized(geom1);
-		auto gser2 = Geometry::GetGserialized(geom2);
-		if (!gser1 || !gser2) {
-			if (gser1) {
-				Geometry::DestroyGeometry(gser1);
-			}
-			if (gser2) {
-				Geometry::DestroyGeometry(gser2);
-			}
-			throw ConversionException("Failure in geometry get disjoint: could not getting disjoint from geom");
-			return false;
-		}
-		auto disjointRv = Geometry::GeometryDisjoint(gser1, gser2);
-		Geometry::DestroyGeometry(gser1);
-		Geometry::DestroyGeometry(gser2);
-		return disjointRv;
-	}
-};
-
-template <typename TA, typename TB, typename TR>
-static void GeometryDisjointBinaryExecutor(Vector &geom1, Vector &geom2, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, DisjointBinaryOperator>(geom1, geom2, result, count);
+void GeoFunctions::GeometryCoveredByFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &cache = GetPrepGeomCache(state);
+	auto &geom1_arg = args.data[0];
+	auto &geom2_arg = args.data[1];
+	GeometryPredicateBinaryExecutor<string_t, string_t, bool>(
+	    cache, Geometry::GeometryCoveredby, BoxWithin,
+	    "Failure in geometry get covered by: could not getting covered by from geom", geom1_arg, geom2_arg,
+	    result, args.size());
 }
 
 void GeoFunctions::GeometryDisjointFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &cache = GetPrepGeomCache(state);
 	auto &geom1_arg = args.data[0];
 	auto &geom2_arg = args.data[1];
-	GeometryDisjointBinaryExecutor<string_t, string_t, bool>(geom1_arg, geom2_arg, result, args.size());
+	GeometryPredicateBinaryExecutor<string_t, string_t, bool>(
+	    cache, Geometry::GeometryDisjoint, BoxDisjoint,
+	    "Failure in geometry get disjoint: could not getting disjoint from geom", geom1_arg, geom2_arg, result,
+	    args.size());
 }
 
 struct DWithinTernaryOperator {
@@ -2323,21 +2612,34 @@ struct DWithinTernaryOperator {
 		if (geom1.GetSize() == 0 || geom2.GetSize() == 0) {
 			return false;
 		}
-		auto gser1 = Geometry::GetGserialized(geom1);
-		auto gser2 = Geometry::GetGserialized(geom2);
-		if (!gser1 || !gser2) {
-			if (gser1) {
-				Geometry::DestroyGeometry(gser1);
+		GBOX box1, box2;
+		int32_t srid1, srid2;
+		if (distance >= 0 && Geometry::GetFastBoundingBox(geom1, box1, srid1) &&
+		    Geometry::GetFastBoundingBox(geom2, box2, srid2) && srid1 == srid2) {
+			// The boxes of a pair within the distance are at most that far apart
+			box1.xmin -= distance;
+			box1.ymin -= distance;
+			box1.xmax += distance;
+			box1.ymax += distance;
+			if (!gbox_overlaps_2d(&box1, &box2)) {
+				return false;
 			}
-			if (gser2) {
-				Geometry::DestroyGeometry(gser2);
+		}
+		auto lwgeom1 = Geometry::GetLWGeom(geom1);
+		auto lwgeom2 = Geometry::GetLWGeom(geom2);
+		if (!lwgeom1 || !lwgeom2) {
+			if (lwgeom1) {
+				Geometry::DestroyLWGeom(lwgeom1);
+			}
+			if (lwgeom2) {
+				Geometry::DestroyLWGeom(lwgeom2);
 			}
 			throw ConversionException("Failure in geometry get dwithin: could not getting dwithin from geom");
 			return false;
 		}
-		auto dWithinRv = Geometry::GeometryDWithin(gser1, gser2, distance);
-		Geometry::DestroyGeometry(gser1);
-		Geometry::DestroyGeometry(gser2);
+		auto dWithinRv = Geometry::GeometryDWithin(lwgeom1, lwgeom2, distance);
+		Geometry::DestroyLWGeom(lwgeom1);
+		Geometry::DestroyLWGeom(lwgeom2);
 		return dWithinRv;
 	}
 };
@@ -2349,12 +2651,95 @@ static void GeometryDWithinTernaryExecutor(Vector &geom1, Vector &geom2, Vector
 	                                         DWithinTernaryOperator::Operation<TA, TB, TC, TR>);
 }
 
+static bool GeographyDWithinScalarFunction(CircTreeGeomCache &cache, string_t geom1, string_t geom2, double distance,
+                                           bool use_spheroid) {
+	if (geom1.GetSize() == 0 || geom2.GetSize() == 0) {
+		return false;
+	}
+	auto cached = cache.Lookup((const uint8_t *)geom1.GetDataUnsafe(), geom1.GetSize(),
+	                           (const uint8_t *)geom2.GetDataUnsafe(), geom2.GetSize());
+	auto lwgeom1 = cached == 1 ? cache.lwgeom : Geometry::GetLWGeom(geom1);
+	auto lwgeom2 = cached == 2 ? cache.lwgeom : Geometry::GetLWGeom(geom2);
+	if (!lwgeom1 || !lwgeom2) {
+		if (lwgeom1 && cached != 1) {
+			Geometry::DestroyLWGeom(lwgeom1);
+		}
+		if (lwgeom2 && cached != 2) {
+			Geometry::DestroyLWGeom(lwgeom2);
+		}
+		throw ConversionException("Failure in geometry get dwithin: could not getting dwithin from geom");
+	}
+	auto dwithin = Geometry::GeometryDWithin(lwgeom1, lwgeom2, distance, use_spheroid, &cache);
+	if (cached != 1) {
+		Geometry::DestroyLWGeom(lwgeom1);
+	}
+	if (cached != 2) {
+		Geometry::DestroyLWGeom(lwgeom2);
+	}
+	return dwithin;
+}
+
+static void GeographyDWithinQuaternaryExecutor(CircTreeGeomCache &cache, Vector &geom1, Vector &geom2,
+                                               Vector &distance, Vector &use_spheroid, Vector &result, idx_t count) {
+	if (geom1.GetVectorType() == VectorType::CONSTANT_VECTOR && geom2.GetVectorType() == VectorType::CONSTANT_VECTOR &&
+	    distance.GetVectorType() == VectorType::CONSTANT_VECTOR &&
+	    use_spheroid.GetVectorType() == VectorType::CONSTANT_VECTOR) {
+		// Evaluated once for the whole chunk
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+		if (ConstantVector::IsNull(geom1) || ConstantVector::IsNull(geom2) || ConstantVector::IsNull(distance) ||
+		    ConstantVector::IsNull(use_spheroid)) {
+			ConstantVector::SetNull(result, true);
+			return;
+		}
+		*ConstantVector::GetData<bool>(result) = GeographyDWithinScalarFunction(
+		    cache, *ConstantVector::GetData<string_t>(geom1), *ConstantVector::GetData<string_t>(geom2),
+		    *ConstantVector::GetData<double>(distance), *ConstantVector::GetData<bool>(use_spheroid));
+		return;
+	}
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<bool>(result);
+	auto &result_validity = FlatVector::Validity(result);
+
+	UnifiedVectorFormat geom1_data, geom2_data, distance_data, use_spheroid_data;
+	geom1.ToUnifiedFormat(count, geom1_data);
+	geom2.ToUnifiedFormat(count, geom2_data);
+	distance.ToUnifiedFormat(count, distance_data);
+	use_spheroid.ToUnifiedFormat(count, use_spheroid_data);
+	auto geom1_values = (string_t *)geom1_data.data;
+	auto geom2_values = (string_t *)geom2_data.data;
+	auto distance_values = (double *)distance_data.data;
+	auto use_spheroid_values = (bool *)use_spheroid_data.data;
+
+	for (idx_t i = 0; i < count; i++) {
+		auto geom1_idx = geom1_data.sel->get_index(i);
+		auto geom2_idx = geom2_data.sel->get_index(i);
+		auto distance_idx = distance_data.sel->get_index(i);
+		auto use_spheroid_idx = use_spheroid_data.sel->get_index(i);
+		if (!geom1_data.validity.RowIsValid(geom1_idx) || !geom2_data.validity.RowIsValid(geom2_idx) ||
+		    !distance_data.validity.RowIsValid(distance_idx) ||
+		    !use_spheroid_data.validity.RowIsValid(use_spheroid_idx)) {
+			result_validity.SetInvalid(i);
+			continue;
+		}
+		result_data[i] = GeographyDWithinScalarFunction(cache, geom1_values[geom1_idx], geom2_values[geom2_idx],
+		                                                distance_values[distance_idx],
+		                                                use_spheroid_values[use_spheroid_idx]);
+	}
+}
+
 void GeoFunctions::GeometryDWithinFunction(DataChunk &args, ExpressionState &state, Vector &result) {
 	auto &geom1_arg = args.data[0];
 	auto &geom2_arg = args.data[1];
 	auto &distance_arg = args.data[2];
-	GeometryDWithinTernaryExecutor<string_t, string_t, double, bool>(geom1_arg, geom2_arg, distance_arg, result,
-	                                                                 args.size());
+	if (args.data.size() == 3) {
+		GeometryDWithinTernaryExecutor<string_t, string_t, double, bool>(geom1_arg, geom2_arg, distance_arg, result,
+		                                                                 args.size());
+	} else if (args.data.size() == 4) {
+		auto &cache = GetCircTreeCache(state);
+		auto &use_spheroid_arg = args.data[3];
+		GeographyDWithinQuaternaryExecutor(cache, geom1_arg, geom2_arg, distance_arg, use_spheroid_arg, result,
+		                                   args.size());
+	}
 }
 
 struct AreaOperator {
@@ -2363,12 +2748,12 @@ struct AreaOperator {
 		if (geom.GetSize() == 0) {
 			return 0;
 		}
-		auto gser = Geometry::GetGserialized(geom);
-		if (!gser) {
+		auto lwgeom = Geometry::GetLWGeom(geom);
+		if (!lwgeom) {
 			return 0;
 		}
-		auto area = Geometry::GeometryArea(gser, false);
-		Geometry::DestroyGeometry(gser);
+		auto area = Geometry::GeometryArea(lwgeom, false);
+		Geometry::DestroyLWGeom(lwgeom);
 		return area;
 	}
 };
@@ -2379,13 +2764,13 @@ struct AreaBinaryOperator {
 		if (geom.GetSize() == 0) {
 			return 0;
 		}
-		auto gser = Geometry::GetGserialized(geom);
-		if (!gser) {
+		auto lwgeom = Geometry::GetLWGeom(geom);
+		if (!lwgeom) {
 			throw ConversionException("Failure in geometry get area: could not getting area from geom");
 			return false;
 		}
-		auto area = Geometry::GeometryArea(gser, use_spheroid);
-		Geometry::DestroyGeometry(gser);
+		auto area = Geometry::GeometryArea(lwgeom, use_spheroid);
+		Geometry::DestroyLWGeom(lwgeom);
 		return area;
 	}
 };
@@ -2547,13 +2932,13 @@ struct PerimeterUnaryOperator {
 		if (geom.GetSize() == 0) {
 			return 0.0;
 		}
-		auto gser = Geometry::GetGserialized(geom);
-		if (!gser) {
+		auto lwgeom = Geometry::GetLWGeom(geom);
+		if (!lwgeom) {
 			throw ConversionException("Failure in geometry get perimeter: could not getting perimeter from geom");
 			return 0.0;
 		}
-		auto perimeter = Geometry::GeometryPerimeter(gser, false);
-		Geometry::DestroyGeometry(gser);
+		auto perimeter = Geometry::GeometryPerimeter(lwgeom, false);
+		Geometry::DestroyLWGeom(lwgeom);
 		return perimeter;
 	}
 };
@@ -2564,13 +2949,13 @@ struct PerimeterBinaryOperator {
 		if (geom.GetSize() == 0) {
 			return 0;
 		}
-		auto gser = Geometry::GetGserialized(geom);
-		if (!gser) {
+		auto lwgeom = Geometry::GetLWGeom(geom);
+		if (!lwgeom) {
 			throw ConversionException("Failure in geometry get perimeter: could not getting perimeter from geom");
 			return 0;
 		}
-		auto perimeter = Geometry::GeometryPerimeter(gser, use_spheroid);
-		Geometry::DestroyGeometry(gser);
+		auto perimeter = Geometry::GeometryPerimeter(lwgeom, use_spheroid);
+		Geometry::DestroyLWGeom(lwgeom);
 		return perimeter;
 	}
 };
@@ -2603,25 +2988,25 @@ static TR AzimuthScalarFunction(Vector &result, TA geom1, TB geom2, ValidityMask
 	if (geom1.GetSize() == 0 || geom2.GetSize() == 0) {
 		return 0.0;
 	}
-	auto gser1 = Geometry::GetGserialized(geom1);
-	auto gser2 = Geometry::GetGserialized(geom2);
-	if (!gser1 || !gser2) {
-		if (gser1) {
-			Geometry::DestroyGeometry(gser1);
+	auto lwgeom1 = Geometry::GetLWGeom(geom1);
+	auto lwgeom2 = Geometry::GetLWGeom(geom2);
+	if (!lwgeom1 || !lwgeom2) {
+		if (lwgeom1) {
+			Geometry::DestroyLWGeom(lwgeom1);
 		}
-		if (gser2) {
-			Geometry::DestroyGeometry(gser2);
+		if (lwgeom2) {
+			Geometry::DestroyLWGeom(lwgeom2);
 		}
 		throw ConversionException("Failure in geometry get azimuth: could not getting azimuth from geom");
 		return 0.0;
 	}
-	auto azimuthRv = Geometry::GeometryAzimuth(gser1, gser2);
+	auto azimuthRv = Geometry::GeometryAzimuth(lwgeom1, lwgeom2);
 	if (isnan(azimuthRv)) {
 		mask.SetInvalid(idx);
 		return 0.0;
 	}
-	Geometry::DestroyGeometry(gser1);
-	Geometry::DestroyGeometry(gser2);
+	Geometry::DestroyLWGeom(lwgeom1);
+	Geometry::DestroyLWGeom(lwgeom2);
 	return azimuthRv;
 };
 
@@ -2645,12 +3030,12 @@ struct LengthUnaryOperator {
 		if (geom.GetSize() == 0) {
 			return 0.0;
 		}
-		auto gser = Geometry::GetGserialized(geom);
-		if (!gser) {
+		auto lwgeom = Geometry::GetLWGeom(geom);
+		if (!lwgeom) {
 			return 0.0;
 		}
-		auto length = Geometry::GeometryLength(gser, false);
-		Geometry::DestroyGeometry(gser);
+		auto length = Geometry::GeometryLength(lwgeom, false);
+		Geometry::DestroyLWGeom(lwgeom);
 		return length;
 	}
 };
@@ -2661,13 +3046,13 @@ struct LengthBinaryOperator {
 		if (geom.GetSize() == 0) {
 			return 0;
 		}
-		auto gser = Geometry::GetGserialized(geom);
-		if (!gser) {
+		auto lwgeom = Geometry::GetLWGeom(geom);
+		if (!lwgeom) {
 			throw ConversionException("Failure in geometry get length: could not getting length from geom");
 			return false;
 		}
-		auto length = Geometry::GeometryLength(gser, use_spheroid);
-		Geometry::DestroyGeometry(gser);
+		auto length = Geometry::GeometryLength(lwgeom, use_spheroid);
+		Geometry::DestroyLWGeom(lwgeom);
 		return length;
 	}
 };
@@ -2713,11 +3098,7 @@ struct BoundingBoxUnaryOperator {
 			Geometry::DestroyGeometry(gser);
 			return geom;
 		}
-		idx_t rv_size = Geometry::GetGeometrySize(gserBoundingBox);
-		auto base = Geometry::GetBase(gserBoundingBox);
-		auto result_str = StringVector::EmptyString(result, rv_size);
-		memcpy(result_str.GetDataWriteable(), base, rv_size);
-		result_str.Finalize();
+		auto result_str = Geometry::ToWKB(result, gserBoundingBox);
 		Geometry::DestroyGeometry(gser);
 		Geometry::DestroyGeometry(gserBoundingBox);
 		return result_str;
@@ -2734,41 +3115,19 @@ void GeoFunctions::GeometryBoundingBoxFunction(DataChunk &args, ExpressionState
 	GeometryBoundingBoxUnaryExecutor<string_t, string_t>(geom_arg, result, args.size());
 }
 
-struct GeometryMaxDistanceBinaryOperator {
-	template <class TA, class TB, class TR>
-	static inline TR Operation(TA geom1, TB geom2) {
-		double dis = 0.00;
-		if (geom1.GetSize() == 0 || geom2.GetSize() == 0) {
-			return dis;
-		}
-		auto gser1 = Geometry::GetGserialized(geom1);
-		auto gser2 = Geometry::GetGserialized(geom2);
-		if (!gser1 || !gser2) {
-			if (gser1) {
-				Geometry::DestroyGeometry(gser1);
-			}
-			if (gser2) {
-				Geometry::DestroyGeometry(gser2);
-			}
-			throw ConversionException("Failure in geometry get max distance: could not getting max distance from geom");
-			return dis;
-		}
-		dis = Geometry::MaxDistance(gser1, gser2);
-		Geometry::DestroyGeometry(gser1);
-		Geometry::DestroyGeometry(gser2);
-		return dis;
-	}
-};
-
 template <typename TA, typename TB, typename TR>
-static void GeometryMaxDistanceBinaryExecutor(Vector &geom1, Vector &geom2, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, GeometryMaxDistanceBinaryOperator>(geom1, geom2, result, count);
+static void GeometryMaxDistanceBinaryExecutor(CircTreeGeomCache &cache, Vector &geom1, Vector &geom2, Vector &result,
+                                              idx_t count) {
+	BinaryExecutor::Execute<TA, TB, TR>(geom1, geom2, result, count, [&](TA geom1_val, TB geom2_val) {
+		return GeometryDistanceScalarFunction<TA, TB, TR>(cache, geom1_val, geom2_val, true, true);
+	});
 }
 
 void GeoFunctions::GeometryMaxDistanceFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &cache = GetCircTreeCache(state);
 	auto &geom1_arg = args.data[0];
 	auto &geom2_arg = args.data[1];
-	GeometryMaxDistanceBinaryExecutor<string_t, string_t, double>(geom1_arg, geom2_arg, result, args.size());
+	GeometryMaxDistanceBinaryExecutor<string_t, string_t, double>(cache, geom1_arg, geom2_arg, result, args.size());
 }
 
 void GeoFunctions::GeometryExtentFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -2829,14 +3188,296 @@ void GeoFunctions::GeometryExtentFunction(DataChunk &args, ExpressionState &stat
 			result_entries[i] = string_t();
 			continue;
 		}
-		idx_t rv_size = Geometry::GetGeometrySize(gserExtent);
-		auto base = Geometry::GetBase(gserExtent);
+		result_entries[i] = Geometry::ToWKB(result, gserExtent);
 		for (idx_t child_idx = 0; child_idx < list_entry.length; child_idx++) {
 			Geometry::DestroyGeometry(gserArray[child_idx]);
 		}
 		Geometry::DestroyGeometry(gserExtent);
-		result_entries[i] = string_t((const char *)base, rv_size);
 	}
 }
 
+void GeoFunctions::PointDistanceFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto count = args.size();
+	PointReader points1(args.data[0], count);
+	PointReader points2(args.data[1], count);
+	UnifiedVectorFormat spheroid_data;
+	auto has_spheroid = args.data.size() == 3;
+	if (has_spheroid) {
+		args.data[2].ToUnifiedFormat(count, spheroid_data);
+	}
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<double>(result);
+	auto &result_validity = FlatVector::Validity(result);
+	for (idx_t i = 0; i < count; i++) {
+		POINT2D pt1, pt2;
+		bool use_spheroid = false;
+		if (!points1.Get(i, pt1) || !points2.Get(i, pt2) ||
+		    (has_spheroid && !GetArgument(spheroid_data, i, use_spheroid))) {
+			result_validity.SetInvalid(i);
+			continue;
+		}
+		result_data[i] = Geometry::Distance(pt1, pt2, SRID_UNKNOWN, use_spheroid);
+	}
+}
+
+void GeoFunctions::PointDWithinFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto count = args.size();
+	PointReader points1(args.data[0], count);
+	PointReader points2(args.data[1], count);
+	UnifiedVectorFormat distance_data, spheroid_data;
+	args.data[2].ToUnifiedFormat(count, distance_data);
+	// Without the spheroid argument the distance is planar, like ST_DWITHIN on GEOGRAPHY
+	auto geodetic = args.data.size() == 4;
+	if (geodetic) {
+		args.data[3].ToUnifiedFormat(count, spheroid_data);
+	}
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<bool>(result);
+	auto &result_validity = FlatVector::Validity(result);
+	for (idx_t i = 0; i < count; i++) {
+		POINT2D pt1, pt2;
+		double distance;
+		bool use_spheroid = false;
+		if (!points1.Get(i, pt1) || !points2.Get(i, pt2) || !GetArgument(distance_data, i, distance) ||
+		    (geodetic && !GetArgument(spheroid_data, i, use_spheroid))) {
+			result_validity.SetInvalid(i);
+			continue;
+		}
+		if (geodetic) {
+			result_data[i] = Geometry::GeometryDWithin(pt1, pt2, SRID_UNKNOWN, distance, use_spheroid);
+			continue;
+		}
+		if (distance < 0) {
+			throw InvalidInputException("Tolerance cannot be less than zero");
+		}
+		double dx = pt2.x - pt1.x;
+		double dy = pt2.y - pt1.y;
+		result_data[i] = distance >= sqrt(dx * dx + dy * dy);
+	}
+}
+
+void GeoFunctions::PointAzimuthFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto count = args.size();
+	PointReader points1(args.data[0], count);
+	PointReader points2(args.data[1], count);
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<double>(result);
+	auto &result_validity = FlatVector::Validity(result);
+	for (idx_t i = 0; i < count; i++) {
+		POINT2D pt1, pt2;
+		if (!points1.Get(i, pt1) || !points2.Get(i, pt2)) {
+			result_validity.SetInvalid(i);
+			continue;
+		}
+		// The azimuth of a point to itself is unknown
+		auto azimuth = Geometry::GeometryAzimuth(pt1, pt2, SRID_UNKNOWN);
+		if (isnan(azimuth)) {
+			result_validity.SetInvalid(i);
+			continue;
+		}
+		result_data[i] = azimuth;
+	}
+}
+
+void GeoFunctions::PointGeoHashFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto count = args.size();
+	PointReader points(args.data[0], count);
+	UnifiedVectorFormat chars_data;
+	auto has_chars = args.data.size() == 2;
+	if (has_chars) {
+		args.data[1].ToUnifiedFormat(count, chars_data);
+	}
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<string_t>(result);
+	auto &result_validity = FlatVector::Validity(result);
+	for (idx_t i = 0; i < count; i++) {
+		POINT2D pt;
+		int32_t m_chars = 0;
+		if (!points.Get(i, pt) || (has_chars && !GetArgument(chars_data, i, m_chars))) {
+			result_validity.SetInvalid(i);
+			continue;
+		}
+		result_data[i] = StringVector::AddString(result, Geometry::GeoHash(pt, m_chars));
+	}
+}
+
+void GeoFunctions::LineLengthFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto count = args.size();
+	LineReader lines(args.data[0], count);
+	UnifiedVectorFormat spheroid_data;
+	auto has_spheroid = args.data.size() == 2;
+	if (has_spheroid) {
+		args.data[1].ToUnifiedFormat(count, spheroid_data);
+	}
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<double>(result);
+	auto &result_validity = FlatVector::Validity(result);
+	for (idx_t i = 0; i < count; i++) {
+		list_entry_t line;
+		bool use_spheroid = false;
+		if (!lines.Get(i, line) || (has_spheroid && !GetArgument(spheroid_data, i, use_spheroid))) {
+			result_validity.SetInvalid(i);
+			continue;
+		}
+		result_data[i] = Geometry::GeometryLength(lines.vertices.x, lines.vertices.y, line, use_spheroid);
+	}
+}
+
+void GeoFunctions::LineEnvelopeFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto count = args.size();
+	LineReader lines(args.data[0], count);
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<string_t>(result);
+	auto &result_validity = FlatVector::Validity(result);
+	for (idx_t i = 0; i < count; i++) {
+		list_entry_t line;
+		if (!lines.Get(i, line)) {
+			result_validity.SetInvalid(i);
+			continue;
+		}
+		GBOX box;
+		// Like ST_ENVELOPE, an empty line is its own envelope
+		if (!Geometry::GetBoundingBox(lines.vertices.x, lines.vertices.y, line, box)) {
+			result_data[i] = Geometry::ToWKB(result, lines.vertices.x, lines.vertices.y, line);
+			continue;
+		}
+		auto envelope = Geometry::GeometryEnvelope(box, SRID_UNKNOWN);
+		result_data[i] = Geometry::ToWKB(result, envelope);
+		Geometry::DestroyLWGeom(envelope);
+	}
+}
+
+void GeoFunctions::LineSimplifyFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto count = args.size();
+	LineReader lines(args.data[0], count);
+	UnifiedVectorFormat dist_data;
+	args.data[1].ToUnifiedFormat(count, dist_data);
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto &result_validity = FlatVector::Validity(result);
+	for (idx_t i = 0; i < count; i++) {
+		list_entry_t line;
+		double dist;
+		if (!lines.Get(i, line) || !GetArgument(dist_data, i, dist)) {
+			result_validity.SetInvalid(i);
+			continue;
+		}
+		auto lwgeom = Geometry::MakeLine(lines.vertices.x, lines.vertices.y, line);
+		Geometry::GeometrySimplify(lwgeom, dist);
+		// A collapsed line is left without points
+		auto entry = AppendPoints(result, ((LWLINE *)lwgeom)->points);
+		FlatVector::GetData<list_entry_t>(result)[i] = entry;
+		Geometry::DestroyLWGeom(lwgeom);
+	}
+}
+
+void GeoFunctions::PolygonAreaFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto count = args.size();
+	PolygonReader polygons(args.data[0], count);
+	UnifiedVectorFormat spheroid_data;
+	auto has_spheroid = args.data.size() == 2;
+	if (has_spheroid) {
+		args.data[1].ToUnifiedFormat(count, spheroid_data);
+	}
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<double>(result);
+	auto &result_validity = FlatVector::Validity(result);
+	vector<list_entry_t> rings;
+	for (idx_t i = 0; i < count; i++) {
+		bool use_spheroid = false;
+		if (!polygons.Get(i, rings) || (has_spheroid && !GetArgument(spheroid_data, i, use_spheroid))) {
+			result_validity.SetInvalid(i);
+			continue;
+		}
+		// The geodetic area works on point arrays, which are filled straight from the coordinates
+		auto lwgeom = Geometry::MakePolygon(polygons.vertices.x, polygons.vertices.y, rings);
+		result_data[i] = Geometry::GeometryArea(lwgeom, use_spheroid);
+		Geometry::DestroyLWGeom(lwgeom);
+	}
+}
+
+void GeoFunctions::PolygonEnvelopeFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto count = args.size();
+	PolygonReader polygons(args.data[0], count);
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<string_t>(result);
+	auto &result_validity = FlatVector::Validity(result);
+	vector<list_entry_t> rings;
+	for (idx_t i = 0; i < count; i++) {
+		if (!polygons.Get(i, rings)) {
+			result_validity.SetInvalid(i);
+			continue;
+		}
+		// The holes are inside the shell, and an empty polygon is its own envelope
+		GBOX box;
+		if (rings.empty() || !Geometry::GetBoundingBox(polygons.vertices.x, polygons.vertices.y, rings[0], box)) {
+			result_data[i] = Geometry::ToWKB(result, polygons.vertices.x, polygons.vertices.y, rings);
+			continue;
+		}
+		auto envelope = Geometry::GeometryEnvelope(box, SRID_UNKNOWN);
+		result_data[i] = Geometry::ToWKB(result, envelope);
+		Geometry::DestroyLWGeom(envelope);
+	}
+}
+
+void GeoFunctions::PolygonSimplifyFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto count = args.size();
+	PolygonReader polygons(args.data[0], count);
+	UnifiedVectorFormat dist_data;
+	args.data[1].ToUnifiedFormat(count, dist_data);
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto &result_validity = FlatVector::Validity(result);
+	vector<list_entry_t> rings;
+	for (idx_t i = 0; i < count; i++) {
+		double dist;
+		if (!polygons.Get(i, rings) || !GetArgument(dist_data, i, dist)) {
+			result_validity.SetInvalid(i);
+			continue;
+		}
+		auto lwgeom = Geometry::MakePolygon(polygons.vertices.x, polygons.vertices.y, rings);
+		Geometry::GeometrySimplify(lwgeom, dist);
+		// The collapsed holes are dropped, and all rings with a collapsed shell
+		auto entry = AppendRings(result, (LWPOLY *)lwgeom);
+		FlatVector::GetData<list_entry_t>(result)[i] = entry;
+		Geometry::DestroyLWGeom(lwgeom);
+	}
+}
+
+//! ST_CONTAINS of a POLYGON_2D and a POINT_2D: the point is in the interior of the polygon, not on its boundary
+static void PolygonContainsExecutor(Vector &polygon_vec, Vector &point_vec, Vector &result, idx_t count) {
+	PolygonReader polygons(polygon_vec, count);
+	PointReader points(point_vec, count);
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<bool>(result);
+	auto &result_validity = FlatVector::Validity(result);
+	vector<list_entry_t> rings;
+	for (idx_t i = 0; i < count; i++) {
+		POINT2D pt;
+		if (!polygons.Get(i, rings) || !points.Get(i, pt)) {
+			result_validity.SetInvalid(i);
+			continue;
+		}
+		result_data[i] =
+		    Geometry::PointInPolygon(polygons.vertices.x, polygons.vertices.y, rings, pt) == LW_INSIDE;
+	}
+}
+
+void GeoFunctions::PolygonContainsFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	PolygonContainsExecutor(args.data[0], args.data[1], result, args.size());
+}
+
+void GeoFunctions::PointWithinFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	PolygonContainsExecutor(args.data[1], args.data[0], result, args.size());
+}
+
 } // namespace duckdb
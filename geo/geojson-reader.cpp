@@ -0,0 +1,698 @@
+#include "geojson-reader.hpp"
+
+#include "duckdb/common/case_insensitive_map.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include "geo-functions.hpp"
+#include "geometry.hpp"
+#include "liblwgeom/lwin_geojson.hpp"
+
+#include <cerrno>
+
+namespace duckdb {
+
+//! The line-delimited files larger than this are read in chunks of this size, each by the thread that takes it, unless
+//! the chunk_size parameter says otherwise
+static constexpr idx_t GEOJSON_CHUNK_SIZE = 32 * 1024 * 1024;
+//! The buffer grows beyond this for the records that don't fit in it
+static constexpr idx_t GEOJSON_BUFFER_SIZE = 1024 * 1024;
+//! The number of features the types of the properties are guessed from
+static constexpr idx_t GEOJSON_SAMPLE_SIZE = 20480;
+
+//! Cuts a GeoJSON file, or the byte range [start, end) of a line-delimited one, into records: the features of a
+//! FeatureCollection, or the Features and geometries of a sequence. Each record is NUL-terminated in the buffer until
+//! the next one is read, so the parser runs on it in place.
+class GeoJSONReader {
+public:
+	GeoJSONReader(FileSystem &fs, const string &path, idx_t start, idx_t end)
+	    : path(path), end(end), handle(fs.OpenFile(path, FileFlags::FILE_FLAGS_READ)),
+	      buffer(unique_ptr<char[]>(new char[GEOJSON_BUFFER_SIZE])), capacity(GEOJSON_BUFFER_SIZE) {
+		file_size = handle->GetFileSize();
+		if (start > 0) {
+			// Only the line-delimited sequences are read in chunks
+			line_delimited = true;
+			// The range starts with the first line that starts in it, the line before belongs to the previous range
+			buffer_offset = start - 1;
+			handle->Seek(buffer_offset);
+			idx_t i = 0;
+			while (Ensure(i) && At(i) != '\n') {
+				i++;
+			}
+			pos = Ensure(i) ? i + 1 : i;
+		}
+	}
+
+	const string &path;
+	idx_t file_size;
+	//! No line of the range starts at or after this offset
+	idx_t end;
+	//! The record cut by Next and its offset in the file
+	const char *record = nullptr;
+	idx_t record_offset = 0;
+	//! Every record of the sequence is a single line, Next checks it
+	bool line_delimited = false;
+
+public:
+	//! Reads the start of the file: moves to the first feature of a FeatureCollection, or else leaves the first
+	//! record of the sequence to Next. True when the sequence is line-delimited, so that it can be read in chunks.
+	bool Open() {
+		auto i = SkipBlank(0);
+		if (!Ensure(i)) {
+			return false;
+		}
+		if (At(i) != '{') {
+			Error(i, "GeoJSON object expected");
+		}
+		// Walk the members of the first object up to its "features", only a FeatureCollection has them
+		auto j = SkipBlank(i + 1);
+		while (Ensure(j) && At(j) == '"') {
+			auto key_end = ScanValue(j);
+			bool features = key_end - j == 10 && StringUtil::CIEquals(string(&At(j + 1), 8), "features");
+			j = SkipBlank(key_end);
+			if (!Ensure(j) || At(j) != ':') {
+				Error(j, "object property name separator ':' expected");
+			}
+			j = SkipBlank(j + 1);
+			if (features && Ensure(j) && At(j) == '[') {
+				in_collection = true;
+				pos += j + 1;
+				return false;
+			}
+			j = SkipBlank(ScanValue(j));
+			if (!Ensure(j) || At(j) != ',') {
+				break;
+			}
+			j = SkipBlank(j + 1);
+		}
+		// A sequence, line-delimited when its first record is a single line followed by a newline
+		auto record_end = ScanValue(i);
+		if (memchr(&At(i), '\n', record_end - i)) {
+			return false;
+		}
+		while (Ensure(record_end) && (At(record_end) == ' ' || At(record_end) == '\t' || At(record_end) == '\r')) {
+			record_end++;
+		}
+		line_delimited = !Ensure(record_end) || At(record_end) == '\n';
+		return line_delimited;
+	}
+
+	//! Cuts the next record, false at the end of the file or of the range
+	bool Next() {
+		if (cut) {
+			buffer[pos] = cut_byte;
+			cut = false;
+		}
+		if (done) {
+			return false;
+		}
+		auto i = SkipBlank(0);
+		if (in_collection) {
+			if (!Ensure(i)) {
+				Error(i, "unexpected end of data");
+			}
+			if (At(i) == ']') {
+				done = true;
+				return false;
+			}
+			if (!first_feature) {
+				if (At(i) != ',') {
+					Error(i, "array value separator ',' expected");
+				}
+				i = SkipBlank(i + 1);
+			}
+			first_feature = false;
+		} else {
+			// A record belongs to the range its line starts in, whatever blanks come before it on the line
+			auto line_start = i;
+			while (line_start > 0 && At(line_start - 1) != '\n') {
+				line_start--;
+			}
+			if (!Ensure(i) || buffer_offset + pos + line_start >= end) {
+				done = true;
+				return false;
+			}
+		}
+		auto record_end = ScanValue(i);
+		// A chunk of the file starts on the line after its start, which has to be the start of a record
+		if (line_delimited && memchr(&At(i), '\n', record_end - i)) {
+			Error(i, "record spanning several lines in a line-delimited sequence");
+		}
+		record = &At(i);
+		record_offset = buffer_offset + pos + i;
+		pos += record_end;
+		cut_byte = buffer[pos];
+		buffer[pos] = '\0';
+		cut = true;
+		return true;
+	}
+
+private:
+	unique_ptr<FileHandle> handle;
+	unique_ptr<char[]> buffer;
+	idx_t capacity;
+	//! The offset in the file of the first byte of the buffer
+	idx_t buffer_offset = 0;
+	//! The bytes that are left to read are buffer[pos, len)
+	idx_t pos = 0;
+	idx_t len = 0;
+	bool eof = false;
+	//! Reading the features array of a FeatureCollection, instead of a sequence
+	bool in_collection = false;
+	bool first_feature = true;
+	bool done = false;
+	//! The byte behind the record is replaced with the NUL
+	bool cut = false;
+	char cut_byte;
+
+	static bool IsBlank(char c) {
+		// RFC 8142 puts an RS in front of each record of a sequence
+		return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\x1e';
+	}
+
+	//! The i-th byte that is left to read
+	char &At(idx_t i) {
+		return buffer[pos + i];
+	}
+
+	//! Reads the file up to the i-th byte that is left to read, false when it is shorter
+	bool Ensure(idx_t i) {
+		while (pos + i >= len) {
+			if (!Fill()) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	//! Moves the bytes that are left to read to the front of the buffer, or grows it when they fill it, and reads
+	//! more of the file behind them. The offsets from pos stay valid.
+	bool Fill() {
+		if (eof) {
+			return false;
+		}
+		if (pos > 0) {
+			memmove(buffer.get(), buffer.get() + pos, len - pos);
+			buffer_offset += pos;
+			len -= pos;
+			pos = 0;
+		}
+		if (len + 1 >= capacity) {
+			auto grown = unique_ptr<char[]>(new char[capacity * 2]);
+			memcpy(grown.get(), buffer.get(), len);
+			buffer = move(grown);
+			capacity *= 2;
+		}
+		// The last byte is kept for the NUL behind a record that ends the file
+		auto read = handle->Read(buffer.get() + len, capacity - len - 1);
+		if (read <= 0) {
+			eof = true;
+			return false;
+		}
+		len += read;
+		return true;
+	}
+
+	idx_t SkipBlank(idx_t i) {
+		while (Ensure(i) && IsBlank(At(i))) {
+			i++;
+		}
+		return i;
+	}
+
+	//! The offset behind the JSON value that starts at i. Only the strings and the nesting are followed, the parser
+	//! checks the rest.
+	idx_t ScanValue(idx_t i) {
+		idx_t depth = 0;
+		do {
+			if (!Ensure(i)) {
+				Error(i, "unexpected end of data");
+			}
+			char c = At(i++);
+			if (c == '"') {
+				for (;;) {
+					if (!Ensure(i)) {
+						Error(i, "unterminated string");
+					}
+					c = At(i++);
+					if (c == '\\') {
+						i++;
+					} else if (c == '"') {
+						break;
+					}
+				}
+			} else if (c == '{' || c == '[') {
+				depth++;
+			} else if (c == '}' || c == ']') {
+				if (depth == 0) {
+					Error(i - 1, "unexpected character");
+				}
+				depth--;
+			} else if (depth == 0) {
+				// A number or a literal, up to the next delimiter
+				while (Ensure(i) && !IsBlank(At(i)) && At(i) != ',' && At(i) != ']' && At(i) != '}') {
+					i++;
+				}
+			}
+		} while (depth > 0);
+		return i;
+	}
+
+	void Error(idx_t i, const string &message) {
+		throw InvalidInputException("read_geojson: %s at byte %llu of \"%s\"", message, buffer_offset + pos + i,
+		                            path);
+	}
+};
+
+struct ReadGeoJSONBindData : public TableFunctionData {
+	vector<string> files;
+	//! The properties, in the order of their columns after the geometry, and their types
+	vector<string> properties;
+	vector<LogicalType> types;
+	unordered_map<string, idx_t> property_index;
+	idx_t chunk_size = GEOJSON_CHUNK_SIZE;
+};
+
+//! Walks the record at the cursor, a Feature or a geometry, and hands the geometry and the properties of a Feature
+//! to the handler as their values are met. A geometry is handed over whole once the record is read.
+template <class HANDLER>
+static void ReadFeature(geojson_parser &p, HANDLER &handler) {
+	bool has_type = false;
+	bool is_feature = false;
+	bool has_members = false;
+	geojson_expect(&p, '{', "GeoJSON object expected");
+	geojson_enter(&p);
+	if (!geojson_accept(&p, '}')) {
+		do {
+			geojson_parse_key(&p);
+			if (StringUtil::CIEquals(p.str, "type")) {
+				geojson_skip_ws(&p);
+				if (*p.cur != '"') {
+					geojson_syntax_error(&p, "type string expected");
+				}
+				geojson_parse_string(&p);
+				has_type = true;
+				is_feature = StringUtil::CIEquals(p.str, "Feature");
+			} else if (StringUtil::CIEquals(p.str, "geometry")) {
+				has_members = true;
+				handler.Geometry(p);
+			} else if (StringUtil::CIEquals(p.str, "properties")) {
+				has_members = true;
+				geojson_skip_ws(&p);
+				if (*p.cur != '{') {
+					// null
+					geojson_skip_value(&p);
+					continue;
+				}
+				geojson_enter(&p);
+				p.cur++;
+				if (!geojson_accept(&p, '}')) {
+					do {
+						geojson_parse_key(&p);
+						handler.Property(p);
+					} while (geojson_accept(&p, ','));
+					geojson_expect(&p, '}', "object value separator ',' expected");
+				}
+				p.depth--;
+			} else {
+				geojson_skip_value(&p);
+			}
+		} while (geojson_accept(&p, ','));
+		geojson_expect(&p, '}', "object value separator ',' expected");
+	}
+	p.depth--;
+	geojson_skip_ws(&p);
+	if (*p.cur != '\0') {
+		geojson_syntax_error(&p, "unexpected character");
+	}
+	if (!is_feature && (has_type || !has_members)) {
+		geojson_parser_init(&p, p.start);
+		handler.BareGeometry(p);
+	}
+}
+
+//! Hands the record the reader just cut to the handler, with the file and the offset in the parse errors
+template <class HANDLER>
+static void ReadRecord(GeoJSONReader &reader, HANDLER &handler) {
+	geojson_parser p;
+	geojson_parser_init(&p, reader.record);
+	try {
+		ReadFeature(p, handler);
+	} catch (Exception &) {
+		throw;
+	} catch (std::exception &ex) {
+		throw InvalidInputException("read_geojson: %s in the feature at byte %llu of \"%s\"", ex.what(),
+		                            reader.record_offset, reader.path);
+	}
+}
+
+static bool IsNumberStart(char c) {
+	return c == '-' || (c >= '0' && c <= '9');
+}
+
+//! Reads the number at the cursor, true when it is an integer that fits a BIGINT
+static bool ReadNumber(geojson_parser &p, double &value, int64_t &integer) {
+	geojson_skip_ws(&p);
+	auto start = p.cur;
+	value = geojson_parse_number(&p);
+	for (auto c = start; c < p.cur; c++) {
+		if (*c == '.' || *c == 'e' || *c == 'E') {
+			return false;
+		}
+	}
+	errno = 0;
+	integer = strtoll(start, nullptr, 10);
+	return errno != ERANGE;
+}
+
+//! The type of the property value at the cursor, SQLNULL for null
+static LogicalTypeId ReadPropertyType(geojson_parser &p) {
+	geojson_skip_ws(&p);
+	switch (*p.cur) {
+	case 'n':
+		geojson_skip_value(&p);
+		return LogicalTypeId::SQLNULL;
+	case 't':
+	case 'f':
+		geojson_skip_value(&p);
+		return LogicalTypeId::BOOLEAN;
+	case '"':
+	case '{':
+	case '[':
+		// The objects and arrays are kept as their JSON text
+		geojson_skip_value(&p);
+		return LogicalTypeId::VARCHAR;
+	default:
+		double value;
+		int64_t integer;
+		return ReadNumber(p, value, integer) ? LogicalTypeId::BIGINT : LogicalTypeId::DOUBLE;
+	}
+}
+
+//! The narrowest type holding the values of both types
+static LogicalTypeId MergePropertyTypes(LogicalTypeId left, LogicalTypeId right) {
+	if (left == right || right == LogicalTypeId::SQLNULL) {
+		return left;
+	}
+	if (left == LogicalTypeId::SQLNULL) {
+		return right;
+	}
+	if ((left == LogicalTypeId::BIGINT && right == LogicalTypeId::DOUBLE) ||
+	    (left == LogicalTypeId::DOUBLE && right == LogicalTypeId::BIGINT)) {
+		return LogicalTypeId::DOUBLE;
+	}
+	return LogicalTypeId::VARCHAR;
+}
+
+//! Collects the properties of the sampled features in the order they are first met, with the types of their values
+struct GeoJSONPropertySampler {
+	ReadGeoJSONBindData &bind_data;
+	vector<LogicalTypeId> types;
+
+	void Geometry(geojson_parser &p) {
+		geojson_skip_value(&p);
+	}
+	void BareGeometry(geojson_parser &p) {
+	}
+	void Property(geojson_parser &p) {
+		auto entry = bind_data.property_index.find(p.str);
+		idx_t index;
+		if (entry == bind_data.property_index.end()) {
+			index = bind_data.properties.size();
+			bind_data.property_index[p.str] = index;
+			bind_data.properties.push_back(p.str);
+			types.push_back(LogicalTypeId::SQLNULL);
+		} else {
+			index = entry->second;
+		}
+		types[index] = MergePropertyTypes(types[index], ReadPropertyType(p));
+	}
+};
+
+struct ReadGeoJSONGlobalState : public GlobalTableFunctionState {
+	mutex lock;
+	idx_t next_file = 0;
+	//! The ranges of the large line-delimited files that are left, the first one at the back
+	struct Chunk {
+		idx_t file;
+		idx_t start;
+		idx_t end;
+	};
+	vector<Chunk> chunks;
+	idx_t max_threads;
+	//! The output column of the geometry and of each property, DConstants::INVALID_INDEX when it is not selected
+	idx_t geometry_column = DConstants::INVALID_INDEX;
+	vector<idx_t> property_columns;
+	//! The output columns set to NULL at every row before the record fills them
+	vector<idx_t> value_columns;
+	vector<idx_t> row_id_columns;
+
+	idx_t MaxThreads() const override {
+		return max_threads;
+	}
+};
+
+struct ReadGeoJSONLocalState : public LocalTableFunctionState {
+	unique_ptr<GeoJSONReader> reader;
+};
+
+//! Writes the geometry and the selected properties of a record to a row of the output, skipping the rest unparsed
+struct GeoJSONFeatureLoader {
+	const ReadGeoJSONBindData &bind_data;
+	const ReadGeoJSONGlobalState &gstate;
+	GeoJSONReader &reader;
+	DataChunk &output;
+	idx_t row;
+
+	void Geometry(geojson_parser &p) {
+		geojson_skip_ws(&p);
+		if (gstate.geometry_column == DConstants::INVALID_INDEX || strncmp(p.cur, "null", 4) == 0) {
+			geojson_skip_value(&p);
+			return;
+		}
+		ReadGeometry(p);
+	}
+	void BareGeometry(geojson_parser &p) {
+		if (gstate.geometry_column != DConstants::INVALID_INDEX) {
+			ReadGeometry(p);
+		}
+	}
+	void ReadGeometry(geojson_parser &p) {
+		auto lwgeom = geojson_parse_geometry(&p, nullptr);
+		lwgeom_set_srid(lwgeom, WGS84_SRID);
+		auto &result = output.data[gstate.geometry_column];
+		FlatVector::GetData<string_t>(result)[row] = Geometry::ToWKB(result, lwgeom);
+		FlatVector::SetNull(result, row, false);
+		lwgeom_free(lwgeom);
+	}
+
+	void Property(geojson_parser &p) {
+		auto entry = bind_data.property_index.find(p.str);
+		if (entry == bind_data.property_index.end() ||
+		    gstate.property_columns[entry->second] == DConstants::INVALID_INDEX) {
+			geojson_skip_value(&p);
+			return;
+		}
+		auto &result = output.data[gstate.property_columns[entry->second]];
+		geojson_skip_ws(&p);
+		auto start = p.cur;
+		if (*start == 'n') {
+			geojson_skip_value(&p);
+			return;
+		}
+		double value;
+		int64_t integer;
+		switch (result.GetType().id()) {
+		case LogicalTypeId::BOOLEAN:
+			if (*start != 't' && *start != 'f') {
+				TypeMismatch(entry->second);
+			}
+			geojson_skip_value(&p);
+			FlatVector::GetData<bool>(result)[row] = *start == 't';
+			break;
+		case LogicalTypeId::BIGINT:
+			if (!IsNumberStart(*start) || !ReadNumber(p, value, integer)) {
+				TypeMismatch(entry->second);
+			}
+			FlatVector::GetData<int64_t>(result)[row] = integer;
+			break;
+		case LogicalTypeId::DOUBLE:
+			if (!IsNumberStart(*start)) {
+				TypeMismatch(entry->second);
+			}
+			FlatVector::GetData<double>(result)[row] = geojson_parse_number(&p);
+			break;
+		default:
+			if (*start == '"') {
+				geojson_parse_string(&p);
+				FlatVector::GetData<string_t>(result)[row] = StringVector::AddString(result, p.str);
+			} else {
+				geojson_skip_value(&p);
+				FlatVector::GetData<string_t>(result)[row] = StringVector::AddString(result, start, p.cur - start);
+			}
+			break;
+		}
+		FlatVector::SetNull(result, row, false);
+	}
+
+	void TypeMismatch(idx_t property) {
+		throw InvalidInputException("read_geojson: the property \"%s\" of the feature at byte %llu of \"%s\" is not a "
+		                            "%s like in the first features",
+		                            bind_data.properties[property], reader.record_offset, reader.path,
+		                            bind_data.types[property].ToString());
+	}
+};
+
+static unique_ptr<FunctionData> ReadGeoJSONBind(ClientContext &context, TableFunctionBindInput &input,
+                                                vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_unique<ReadGeoJSONBindData>();
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto file_pattern = StringValue::Get(input.inputs[0]);
+	result->files = fs.Glob(file_pattern, context);
+	if (result->files.empty()) {
+		throw IOException("No files found that match the pattern \"%s\"", file_pattern);
+	}
+	for (auto &kv : input.named_parameters) {
+		if (kv.first == "chunk_size") {
+			if (kv.second.IsNull() || BigIntValue::Get(kv.second) <= 0) {
+				throw InvalidInputException("read_geojson: chunk_size must be positive");
+			}
+			result->chunk_size = BigIntValue::Get(kv.second);
+		}
+	}
+
+	GeoJSONPropertySampler sampler {*result};
+	idx_t sampled = 0;
+	for (idx_t i = 0; i < result->files.size() && sampled < GEOJSON_SAMPLE_SIZE; i++) {
+		GeoJSONReader reader(fs, result->files[i], 0, DConstants::INVALID_INDEX);
+		reader.Open();
+		for (; sampled < GEOJSON_SAMPLE_SIZE && reader.Next(); sampled++) {
+			ReadRecord(reader, sampler);
+		}
+	}
+
+	names.push_back("geometry");
+	return_types.push_back(GeoTypes::Geography());
+	case_insensitive_set_t column_names {"geometry"};
+	for (idx_t i = 0; i < result->properties.size(); i++) {
+		// The properties that were only ever null are read as text
+		auto type = sampler.types[i] == LogicalTypeId::SQLNULL ? LogicalType::VARCHAR : LogicalType(sampler.types[i]);
+		result->types.push_back(type);
+		// The column names are case-insensitive, the property names are not
+		auto name = result->properties[i];
+		for (idx_t suffix = 1; column_names.find(name) != column_names.end(); suffix++) {
+			name = result->properties[i] + "_" + to_string(suffix);
+		}
+		column_names.insert(name);
+		names.push_back(name);
+		return_types.push_back(type);
+	}
+	return move(result);
+}
+
+static unique_ptr<GlobalTableFunctionState> ReadGeoJSONInitGlobal(ClientContext &context,
+                                                                  TableFunctionInitInput &input) {
+	auto &bind_data = (const ReadGeoJSONBindData &)*input.bind_data;
+	auto result = make_unique<ReadGeoJSONGlobalState>();
+	// A thread reads a file, or a chunk of a large one: only the sizes of the first files are needed to know whether
+	// there is work for all of them
+	idx_t threads = TaskScheduler::GetScheduler(context).NumberOfThreads();
+	auto &fs = FileSystem::GetFileSystem(context);
+	idx_t ranges = 0;
+	for (idx_t i = 0; i < bind_data.files.size() && ranges < threads; i++) {
+		auto handle = fs.OpenFile(bind_data.files[i], FileFlags::FILE_FLAGS_READ);
+		ranges += MaxValue<idx_t>(1, (handle->GetFileSize() + bind_data.chunk_size - 1) / bind_data.chunk_size);
+	}
+	result->max_threads = MinValue<idx_t>(ranges, threads);
+	result->property_columns.resize(bind_data.properties.size(), DConstants::INVALID_INDEX);
+	for (idx_t i = 0; i < input.column_ids.size(); i++) {
+		auto column_id = input.column_ids[i];
+		if (column_id == COLUMN_IDENTIFIER_ROW_ID) {
+			result->row_id_columns.push_back(i);
+			continue;
+		}
+		if (column_id == 0) {
+			result->geometry_column = i;
+		} else {
+			result->property_columns[column_id - 1] = i;
+		}
+		result->value_columns.push_back(i);
+	}
+	return move(result);
+}
+
+static unique_ptr<LocalTableFunctionState> ReadGeoJSONInitLocal(ExecutionContext &context,
+                                                                TableFunctionInitInput &input,
+                                                                GlobalTableFunctionState *global_state) {
+	return make_unique<ReadGeoJSONLocalState>();
+}
+
+//! Opens the next file or chunk for the thread, false when all of them are taken. The thread that opens a large
+//! line-delimited file keeps its first chunk and leaves the others to the next threads.
+static bool NextReader(ClientContext &context, const ReadGeoJSONBindData &bind_data, ReadGeoJSONGlobalState &gstate,
+                       ReadGeoJSONLocalState &lstate) {
+	ReadGeoJSONGlobalState::Chunk chunk;
+	{
+		lock_guard<mutex> guard(gstate.lock);
+		if (!gstate.chunks.empty()) {
+			chunk = gstate.chunks.back();
+			gstate.chunks.pop_back();
+		} else if (gstate.next_file < bind_data.files.size()) {
+			chunk = {gstate.next_file++, 0, DConstants::INVALID_INDEX};
+		} else {
+			return false;
+		}
+	}
+	auto &fs = FileSystem::GetFileSystem(context);
+	lstate.reader = make_unique<GeoJSONReader>(fs, bind_data.files[chunk.file], chunk.start, chunk.end);
+	auto &reader = *lstate.reader;
+	auto chunk_size = bind_data.chunk_size;
+	if (chunk.start == 0 && reader.Open() && reader.file_size > chunk_size) {
+		reader.end = chunk_size;
+		lock_guard<mutex> guard(gstate.lock);
+		for (idx_t start = (reader.file_size - 1) / chunk_size * chunk_size; start > 0; start -= chunk_size) {
+			gstate.chunks.push_back({chunk.file, start, start + chunk_size});
+		}
+	}
+	return true;
+}
+
+static void ReadGeoJSONScan(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &bind_data = (const ReadGeoJSONBindData &)*data_p.bind_data;
+	auto &gstate = (ReadGeoJSONGlobalState &)*data_p.global_state;
+	auto &lstate = (ReadGeoJSONLocalState &)*data_p.local_state;
+
+	LWArenaScope arena(GeoFunctions::ArenaEnabled(context));
+	WKBHeaderScope wkb_header(GeoFunctions::WKBHeaderEnabled(context));
+	idx_t count = 0;
+	while (count < STANDARD_VECTOR_SIZE) {
+		if (!lstate.reader || !lstate.reader->Next()) {
+			if (!NextReader(context, bind_data, gstate, lstate)) {
+				break;
+			}
+			continue;
+		}
+		for (auto column : gstate.value_columns) {
+			FlatVector::SetNull(output.data[column], count, true);
+		}
+		GeoJSONFeatureLoader loader {bind_data, gstate, *lstate.reader, output, count};
+		ReadRecord(*lstate.reader, loader);
+		count++;
+	}
+	for (auto column : gstate.row_id_columns) {
+		output.data[column].SetVectorType(VectorType::CONSTANT_VECTOR);
+		ConstantVector::SetNull(output.data[column], true);
+	}
+	output.SetCardinality(count);
+}
+
+TableFunction ReadGeoJSONFunction::GetFunction() {
+	TableFunction read_geojson("read_geojson", {LogicalType::VARCHAR}, ReadGeoJSONScan, ReadGeoJSONBind,
+	                           ReadGeoJSONInitGlobal, ReadGeoJSONInitLocal);
+	read_geojson.named_parameters["chunk_size"] = LogicalType::BIGINT;
+	read_geojson.projection_pushdown = true;
+	return read_geojson;
+}
+
+} // namespace duckdb
@@ -48,18 +48,86 @@ string Geometry::ToString(string_t geometry, DataFormatType ftype) {
 	return string(buffer.get(), str_len);
 }
 
-void Geometry::ToGeometry(GSERIALIZED *gser, data_ptr_t output) {
+string_t Geometry::ToWKB(Vector &result, GSERIALIZED *gser) {
 	Postgis postgis;
-	data_ptr_t base = (data_ptr_t)postgis.LWGEOM_base(gser);
-	auto geometry_len = Geometry::GetGeometrySize(gser);
-	memcpy(output, base, geometry_len);
+	auto lwgeom = postgis.LWGEOM_deserialize(gser);
+	auto result_str = Geometry::ToWKB(result, lwgeom);
+	postgis.LWGEOM_freeLWGeom(lwgeom);
+	return result_str;
+}
+
+string_t Geometry::ToWKB(Vector &result, const LWGEOM *lwgeom) {
+	Postgis postgis;
+	auto size = postgis.LWGEOM_wkbSize(lwgeom);
+	auto result_str = StringVector::EmptyString(result, size);
+	postgis.LWGEOM_wkbWrite(lwgeom, (data_ptr_t)result_str.GetDataWriteable(), size);
+	result_str.Finalize();
+	return result_str;
+}
+
+string_t Geometry::ToWKB(Vector &result, const POINT4D &pt, bool has_z) {
+	auto result_str = StringVector::EmptyString(result, lwgeom_wkb_point_size(has_z));
+	lwgeom_wkb_point_write(&pt, has_z, (uint8_t *)result_str.GetDataWriteable());
+	result_str.Finalize();
+	return result_str;
+}
+
+string_t Geometry::ToWKB(Vector &result, const double *x, const double *y, const list_entry_t &line) {
+	auto wkb_size = 1 + 2 * sizeof(uint32_t) + line.length * 2 * sizeof(double);
+	// Like lwgeom_wkb_header_size, an empty line gets no header
+	auto header_size = line.length && lwgeom_wkb_header_enabled() ? WKB_HEADER_SIZE : 0;
+	auto result_str = StringVector::EmptyString(result, header_size + wkb_size);
+	auto buf = (uint8_t *)result_str.GetDataWriteable();
+
+	GBOX box;
+	box.xmin = box.ymin = INFINITY;
+	box.xmax = box.ymax = -INFINITY;
+	auto wkb = lwgeom_wkb_type_write(WKB_LINESTRING_TYPE, buf + header_size);
+	lwgeom_wkb_coords_write(x + line.offset, y + line.offset, line.length, &box, wkb);
+	if (header_size) {
+		lwgeom_wkb_header_write_gbox(LINETYPE, 0, line.length, &box, buf);
+	}
+	result_str.Finalize();
+	return result_str;
+}
+
+string_t Geometry::ToWKB(Vector &result, const double *x, const double *y, const vector<list_entry_t> &rings) {
+	idx_t wkb_size = 1 + 2 * sizeof(uint32_t);
+	idx_t npoints = 0;
+	for (auto &ring : rings) {
+		wkb_size += sizeof(uint32_t) + ring.length * 2 * sizeof(double);
+		npoints += ring.length;
+	}
+	auto header_size = !rings.empty() && lwgeom_wkb_header_enabled() ? WKB_HEADER_SIZE : 0;
+	auto result_str = StringVector::EmptyString(result, header_size + wkb_size);
+	auto buf = (uint8_t *)result_str.GetDataWriteable();
+
+	// The box of a polygon is the one of its shell
+	GBOX box;
+	box.xmin = box.ymin = INFINITY;
+	box.xmax = box.ymax = -INFINITY;
+	auto wkb = lwgeom_wkb_type_write(WKB_POLYGON_TYPE, buf + header_size);
+	uint32_t nrings = rings.size();
+	memcpy(wkb, &nrings, sizeof(uint32_t));
+	wkb += sizeof(uint32_t);
+	for (idx_t i = 0; i < rings.size(); i++) {
+		wkb = lwgeom_wkb_coords_write(x + rings[i].offset, y + rings[i].offset, rings[i].length,
+		                              i == 0 ? &box : nullptr, wkb);
+	}
+	if (header_size) {
+		lwgeom_wkb_header_write_gbox(POLYGONTYPE, 0, npoints, &box, buf);
+	}
+	result_str.Finalize();
+	return result_str;
 }
 
 string Geometry::ToGeometry(GSERIALIZED *gser) {
-	auto geometry_len = Geometry::GetGeometrySize(gser);
-	auto buffer = std::unique_ptr<char[]>(new char[geometry_len]);
-	Geometry::ToGeometry(gser, (data_ptr_t)buffer.get());
-	return string(buffer.get(), geometry_len);
+	Postgis postgis;
+	auto lwgeom = postgis.LWGEOM_deserialize(gser);
+	string str(postgis.LWGEOM_wkbSize(lwgeom), '\0');
+	postgis.LWGEOM_wkbWrite(lwgeom, (data_ptr_t)&str[0], str.size());
+	postgis.LWGEOM_freeLWGeom(lwgeom);
+	return str;
 }
 
 string Geometry::ToGeometry(string_t text) {
@@ -76,16 +144,59 @@ GSERIALIZED *Geometry::GetGserialized(string_t geom) {
 	return postgis.LWGEOM_getGserialized(data, size);
 }
 
+LWGEOM *Geometry::GetLWGeom(const string_t &geom) {
+	Postgis postgis;
+	auto data = (const_data_ptr_t)geom.GetDataUnsafe();
+	auto size = geom.GetSize();
+	return postgis.LWGEOM_getLWGeom(data, size);
+}
+
+bool Geometry::GetBoundingBox(const string_t &geom, GBOX &box, int32_t &srid) {
+	Postgis postgis;
+	auto data = (const_data_ptr_t)geom.GetDataUnsafe();
+	auto size = geom.GetSize();
+	return postgis.LWGEOM_getGBox(data, size, &box, &srid);
+}
+
+bool Geometry::GetBoundingBox(const double *x, const double *y, const list_entry_t &points, GBOX &box) {
+	if (points.length == 0) {
+		return false;
+	}
+	gbox_init(&box);
+	box.xmin = box.xmax = x[points.offset];
+	box.ymin = box.ymax = y[points.offset];
+	for (idx_t i = points.offset + 1; i < points.offset + points.length; i++) {
+		box.xmin = MinValue(box.xmin, x[i]);
+		box.xmax = MaxValue(box.xmax, x[i]);
+		box.ymin = MinValue(box.ymin, y[i]);
+		box.ymax = MaxValue(box.ymax, y[i]);
+	}
+	return true;
+}
+
+bool Geometry::GetFastBoundingBox(const string_t &geom, GBOX &box, int32_t &srid) {
+	Postgis postgis;
+	auto data = (const_data_ptr_t)geom.GetDataUnsafe();
+	auto size = geom.GetSize();
+	return postgis.LWGEOM_getFastGBox(data, size, &box, &srid);
+}
+
+bool Geometry::GetHeader(const string_t &geom, WKB_HEADER &header) {
+	Postgis postgis;
+	auto data = (const_data_ptr_t)geom.GetDataUnsafe();
+	auto size = geom.GetSize();
+	return postgis.LWGEOM_getHeader(data, size, &header);
+}
+
 GSERIALIZED *Geometry::ToGserialized(string_t str) {
 	Postgis postgis;
 	auto ger = postgis.LWGEOM_in(&str.GetString()[0]);
 	return ger;
 }
 
-idx_t Geometry::GetGeometrySize(GSERIALIZED *gser) {
+LWGEOM *Geometry::ToLWGeom(string_t str) {
 	Postgis postgis;
-	auto gsize = postgis.LWGEOM_size(gser);
-	return gsize;
+	return postgis.LWGEOM_parse(&str.GetString()[0]);
 }
 
 void Geometry::DestroyGeometry(GSERIALIZED *gser) {
@@ -93,10 +204,9 @@ void Geometry::DestroyGeometry(GSERIALIZED *gser) {
 	postgis.LWGEOM_free(gser);
 }
 
-data_ptr_t Geometry::GetBase(GSERIALIZED *gser) {
+void Geometry::DestroyLWGeom(LWGEOM *lwgeom) {
 	Postgis postgis;
-	data_ptr_t base = (data_ptr_t)postgis.LWGEOM_base(gser);
-	return base;
+	postgis.LWGEOM_freeLWGeom(lwgeom);
 }
 
 GSERIALIZED *Geometry::MakePoint(double x, double y) {
@@ -124,6 +234,19 @@ GSERIALIZED *Geometry::MakePolygon(GSERIALIZED *geom, GSERIALIZED *gserArray[],
 	return postgis.LWGEOM_makepoly(geom, gserArray, nelems);
 }
 
+LWGEOM *Geometry::MakeLine(const double *x, const double *y, const list_entry_t &line) {
+	auto points = ptarray_construct_coords(x + line.offset, y + line.offset, line.length);
+	return lwline_as_lwgeom(lwline_construct(SRID_UNKNOWN, NULL, points));
+}
+
+LWGEOM *Geometry::MakePolygon(const double *x, const double *y, const vector<list_entry_t> &rings) {
+	auto poly = lwpoly_construct_empty(SRID_UNKNOWN, 0, 0);
+	for (auto &ring : rings) {
+		lwpoly_add_ring(poly, ptarray_construct_coords(x + ring.offset, y + ring.offset, ring.length));
+	}
+	return lwpoly_as_lwgeom(poly);
+}
+
 lwvarlena_t *Geometry::AsBinary(GSERIALIZED *geom, string text) {
 	Postgis postgis;
 	return postgis.LWGEOM_asBinary(geom, text);
@@ -144,6 +267,11 @@ lwvarlena_t *Geometry::GeoHash(GSERIALIZED *geom, size_t m_chars) {
 	return postgis.ST_GeoHash(geom, m_chars);
 }
 
+std::string Geometry::GeoHash(const POINT2D &pt, int m_chars) {
+	Postgis postgis;
+	return postgis.ST_GeoHashPoint(pt.x, pt.y, m_chars);
+}
+
 GSERIALIZED *Geometry::GeomFromGeoJson(string_t json) {
 	Postgis postgis;
 	auto ger = postgis.geom_from_geojson(&json.GetString()[0]);
@@ -210,6 +338,11 @@ GSERIALIZED *Geometry::GeometrySimplify(GSERIALIZED *geom, double dist) {
 	return postgis.LWGEOM_simplify2d(geom, dist);
 }
 
+void Geometry::GeometrySimplify(LWGEOM *geom, double dist) {
+	Postgis postgis;
+	postgis.LWGEOM_simplify2d(geom, dist);
+}
+
 GSERIALIZED *Geometry::GeometrySnapToGrid(GSERIALIZED *geom, double size) {
 	Postgis postgis;
 	return postgis.LWGEOM_snaptogrid(geom, size);
@@ -225,57 +358,89 @@ GSERIALIZED *Geometry::GeometryBufferText(GSERIALIZED *geom, double radius, stri
 	return postgis.buffer(geom, radius, styles_text);
 }
 
-bool Geometry::GeometryEquals(GSERIALIZED *geom1, GSERIALIZED *geom2) {
+bool Geometry::GeometryEquals(LWGEOM *geom1, LWGEOM *geom2) {
 	Postgis postgis;
 	return postgis.ST_Equals(geom1, geom2);
 }
 
-bool Geometry::GeometryContains(GSERIALIZED *geom1, GSERIALIZED *geom2) {
+bool Geometry::GeometryContains(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache) {
 	Postgis postgis;
-	return postgis.contains(geom1, geom2);
+	return postgis.contains(geom1, geom2, cache);
 }
 
-bool Geometry::GeometryTouches(GSERIALIZED *geom1, GSERIALIZED *geom2) {
+int Geometry::PointInPolygon(const double *x, const double *y, const vector<list_entry_t> &rings,
+                             const POINT2D &pt) {
+	if (rings.empty()) {
+		return LW_OUTSIDE;
+	}
+	auto &shell = rings[0];
+	auto location = coords_contains_point(x + shell.offset, y + shell.offset, shell.length, &pt);
+	if (location != LW_INSIDE) {
+		return location;
+	}
+	// Inside a hole is outside the polygon, on its boundary is on the one of the polygon
+	for (idx_t i = 1; i < rings.size(); i++) {
+		location = coords_contains_point(x + rings[i].offset, y + rings[i].offset, rings[i].length, &pt);
+		if (location != LW_OUTSIDE) {
+			return location == LW_INSIDE ? LW_OUTSIDE : LW_BOUNDARY;
+		}
+	}
+	return LW_INSIDE;
+}
+
+bool Geometry::GeometryTouches(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache) {
 	Postgis postgis;
-	return postgis.touches(geom1, geom2);
+	return postgis.touches(geom1, geom2, cache);
 }
 
-bool Geometry::GeometryWithin(GSERIALIZED *geom1, GSERIALIZED *geom2) {
+bool Geometry::GeometryWithin(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache) {
 	Postgis postgis;
-	return postgis.within(geom1, geom2);
+	return postgis.within(geom1, geom2, cache);
 }
 
-bool Geometry::GeometryIntersects(GSERIALIZED *geom1, GSERIALIZED *geom2) {
+bool Geometry::GeometryIntersects(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache) {
 	Postgis postgis;
-	return postgis.ST_Intersects(geom1, geom2);
+	return postgis.ST_Intersects(geom1, geom2, cache);
 }
 
-bool Geometry::GeometryCovers(GSERIALIZED *geom1, GSERIALIZED *geom2) {
+bool Geometry::GeometryCovers(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache) {
 	Postgis postgis;
-	return postgis.covers(geom1, geom2);
+	return postgis.covers(geom1, geom2, cache);
 }
 
-bool Geometry::GeometryCoveredby(GSERIALIZED *geom1, GSERIALIZED *geom2) {
+bool Geometry::GeometryCoveredby(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache) {
 	Postgis postgis;
-	return postgis.coveredby(geom1, geom2);
+	return postgis.coveredby(geom1, geom2, cache);
 }
 
-bool Geometry::GeometryDisjoint(GSERIALIZED *geom1, GSERIALIZED *geom2) {
+bool Geometry::GeometryDisjoint(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache) {
 	Postgis postgis;
-	return postgis.disjoint(geom1, geom2);
+	return postgis.disjoint(geom1, geom2, cache);
 }
 
-bool Geometry::GeometryDWithin(GSERIALIZED *geom1, GSERIALIZED *geom2, double distance) {
+bool Geometry::GeometryDWithin(LWGEOM *geom1, LWGEOM *geom2, double distance) {
 	Postgis postgis;
 	return postgis.LWGEOM_dwithin(geom1, geom2, distance);
 }
 
-double Geometry::GeometryArea(GSERIALIZED *geom) {
+bool Geometry::GeometryDWithin(LWGEOM *geom1, LWGEOM *geom2, double distance, bool use_spheroid,
+                               const CircTreeGeomCache *cache) {
+	Postgis postgis;
+	return postgis.geography_dwithin(geom1, geom2, distance, use_spheroid, cache);
+}
+
+bool Geometry::GeometryDWithin(const POINT2D &p1, const POINT2D &p2, int32_t srid, double distance,
+                               bool use_spheroid) {
+	Postgis postgis;
+	return postgis.geography_point_dwithin(&p1, &p2, srid, distance, use_spheroid);
+}
+
+double Geometry::GeometryArea(LWGEOM *geom) {
 	Postgis postgis;
 	return postgis.ST_Area(geom);
 }
 
-double Geometry::GeometryArea(GSERIALIZED *geom, bool use_spheroid) {
+double Geometry::GeometryArea(LWGEOM *geom, bool use_spheroid) {
 	Postgis postgis;
 	return postgis.geography_area(geom, use_spheroid);
 }
@@ -290,17 +455,17 @@ double Geometry::GeometryAngle(std::vector<GSERIALIZED *> geom_vec) {
 	return postgis.LWGEOM_angle(geom_vec);
 }
 
-double Geometry::GeometryPerimeter(GSERIALIZED *geom) {
+double Geometry::GeometryPerimeter(LWGEOM *geom) {
 	Postgis postgis;
 	return postgis.LWGEOM_perimeter2d_poly(geom);
 }
 
-double Geometry::GeometryPerimeter(GSERIALIZED *geom, bool use_spheroid) {
+double Geometry::GeometryPerimeter(LWGEOM *geom, bool use_spheroid) {
 	Postgis postgis;
 	return postgis.geography_perimeter(geom, use_spheroid);
 }
 
-double Geometry::GeometryAzimuth(GSERIALIZED *geom1, GSERIALIZED *geom2) {
+double Geometry::GeometryAzimuth(LWGEOM *geom1, LWGEOM *geom2) {
 	Postgis postgis;
 	// For geometry
 	// return postgis.LWGEOM_azimuth(geom1, geom2);
@@ -308,27 +473,38 @@ double Geometry::GeometryAzimuth(GSERIALIZED *geom1, GSERIALIZED *geom2) {
 	return postgis.geography_azimuth(geom1, geom2);
 }
 
-double Geometry::GeometryLength(GSERIALIZED *geom) {
+double Geometry::GeometryAzimuth(const POINT2D &p1, const POINT2D &p2, int32_t srid) {
+	Postgis postgis;
+	return postgis.geography_point_azimuth(&p1, &p2, srid);
+}
+
+double Geometry::GeometryLength(LWGEOM *geom) {
 	Postgis postgis;
 	return postgis.LWGEOM_length2d_linestring(geom);
 }
 
-double Geometry::GeometryLength(GSERIALIZED *geom, bool use_spheroid) {
+double Geometry::GeometryLength(LWGEOM *geom, bool use_spheroid) {
 	Postgis postgis;
 	return postgis.geography_length(geom, use_spheroid);
 }
 
+double Geometry::GeometryLength(const double *x, const double *y, const list_entry_t &line, bool use_spheroid) {
+	Postgis postgis;
+	return postgis.geography_coords_length(x + line.offset, y + line.offset, line.length, SRID_UNKNOWN,
+	                                       use_spheroid);
+}
+
 GSERIALIZED *Geometry::GeometryBoundingBox(GSERIALIZED *geom) {
 	Postgis postgis;
 	return postgis.LWGEOM_envelope(geom);
 }
 
-double Geometry::MaxDistance(GSERIALIZED *g1, GSERIALIZED *g2, bool use_spheroid) {
+double Geometry::MaxDistance(LWGEOM *g1, LWGEOM *g2, bool use_spheroid, const CircTreeGeomCache *cache) {
 	Postgis postgis;
 	// For geometry
 	// return postgis.LWGEOM_maxdistance2d_linestring(g1, g2);
 	// For Geography
-	return postgis.geography_maxdistance(g1, g2, use_spheroid);
+	return postgis.geography_maxdistance(g1, g2, use_spheroid, cache);
 }
 
 GSERIALIZED *Geometry::GeometryExtent(GSERIALIZED *gserArray[], int nelems) {
@@ -336,13 +512,29 @@ GSERIALIZED *Geometry::GeometryExtent(GSERIALIZED *gserArray[], int nelems) {
 	return postgis.LWGEOM_envelope_garray(gserArray, nelems);
 }
 
+LWGEOM *Geometry::GeometryEnvelope(const GBOX &box, int32_t srid) {
+	Postgis postgis;
+	return postgis.LWGEOM_envelope_gbox(&box, srid);
+}
+
 std::vector<int> Geometry::GeometryClusterDBScan(GSERIALIZED *gserArray[], int nelems, double tolerance,
-                                                 int minpoints) {
+                                                 int minpoints, idx_t max_threads) {
+	Postgis postgis;
+	return postgis.ST_ClusterDBSCAN(gserArray, nelems, tolerance, minpoints, max_threads);
+}
+
+std::vector<int> Geometry::GeometryClusterDBScan(LWGEOM *geoms[], int nelems, double tolerance, int minpoints,
+                                                 idx_t max_threads) {
 	Postgis postgis;
-	return postgis.ST_ClusterDBSCAN(gserArray, nelems, tolerance, minpoints);
+	return postgis.ST_ClusterDBSCAN(geoms, nelems, tolerance, minpoints, max_threads);
 }
 
-int Geometry::LWGEOM_dimension(GSERIALIZED *geom) {
+std::vector<int> Geometry::GeometryClusterKMeans(LWGEOM *geoms[], int nelems, int k) {
+	Postgis postgis;
+	return postgis.ST_ClusterKMeans(geoms, nelems, k);
+}
+
+int Geometry::LWGEOM_dimension(LWGEOM *geom) {
 	Postgis postgis;
 	return postgis.LWGEOM_dimension(geom);
 }
@@ -357,42 +549,42 @@ GSERIALIZED *Geometry::LWGEOM_endpoint_linestring(GSERIALIZED *geom) {
 	return postgis.LWGEOM_endpoint_linestring(geom);
 }
 
-std::string Geometry::Geometrytype(GSERIALIZED *geom) {
+std::string Geometry::Geometrytype(LWGEOM *geom) {
 	Postgis postgis;
 	return postgis.geometry_geometrytype(geom);
 }
 
-bool Geometry::IsClosed(GSERIALIZED *geom) {
+bool Geometry::IsClosed(LWGEOM *geom) {
 	Postgis postgis;
 	return postgis.LWGEOM_isclosed(geom);
 }
 
-bool Geometry::IsCollection(GSERIALIZED *geom) {
+bool Geometry::IsCollection(LWGEOM *geom) {
 	Postgis postgis;
 	return postgis.ST_IsCollection(geom);
 }
 
-bool Geometry::IsEmpty(GSERIALIZED *geom) {
+bool Geometry::IsEmpty(LWGEOM *geom) {
 	Postgis postgis;
 	return postgis.LWGEOM_isempty(geom);
 }
 
-bool Geometry::IsRing(GSERIALIZED *geom) {
+bool Geometry::IsRing(LWGEOM *geom) {
 	Postgis postgis;
 	return postgis.LWGEOM_isring(geom);
 }
 
-int Geometry::NPoints(GSERIALIZED *geom) {
+int Geometry::NPoints(LWGEOM *geom) {
 	Postgis postgis;
 	return postgis.LWGEOM_npoints(geom);
 }
 
-int Geometry::NumGeometries(GSERIALIZED *geom) {
+int Geometry::NumGeometries(LWGEOM *geom) {
 	Postgis postgis;
 	return postgis.LWGEOM_numgeometries_collection(geom);
 }
 
-int Geometry::NumPoints(GSERIALIZED *geom) {
+int Geometry::NumPoints(LWGEOM *geom) {
 	Postgis postgis;
 	return postgis.LWGEOM_numpoints_linestring(geom);
 }
@@ -407,26 +599,36 @@ GSERIALIZED *Geometry::StartPoint(GSERIALIZED *geom) {
 	return postgis.LWGEOM_startpoint_linestring(geom);
 }
 
-double Geometry::Distance(GSERIALIZED *g1, GSERIALIZED *g2) {
+double Geometry::Distance(LWGEOM *g1, LWGEOM *g2) {
 	Postgis postgis;
 	return postgis.ST_distance(g1, g2);
 }
 
-double Geometry::Distance(GSERIALIZED *g1, GSERIALIZED *g2, bool use_spheroid) {
+double Geometry::Distance(LWGEOM *g1, LWGEOM *g2, bool use_spheroid, const CircTreeGeomCache *cache) {
+	Postgis postgis;
+	return postgis.geography_distance(g1, g2, use_spheroid, cache);
+}
+
+double Geometry::Distance(const POINT2D &p1, const POINT2D &p2, int32_t srid, bool use_spheroid) {
 	Postgis postgis;
-	return postgis.geography_distance(g1, g2, use_spheroid);
+	return postgis.geography_point_distance(&p1, &p2, srid, use_spheroid);
 }
 
-double Geometry::XPoint(GSERIALIZED *geom) {
+double Geometry::XPoint(LWGEOM *geom) {
 	Postgis postgis;
 	return postgis.LWGEOM_x_point(geom);
 }
 
-double Geometry::YPoint(GSERIALIZED *geom) {
+double Geometry::YPoint(LWGEOM *geom) {
 	Postgis postgis;
 	return postgis.LWGEOM_y_point(geom);
 }
 
+bool Geometry::PointCoords(LWGEOM *geom, POINT4D &pt) {
+	Postgis postgis;
+	return postgis.LWGEOM_point(geom, &pt);
+}
+
 GSERIALIZED *Geometry::Centroid(GSERIALIZED *g) {
 	Postgis postgis;
 	return postgis.centroid(g);
@@ -0,0 +1,24 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// bbox-pruning.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/optimizer/optimizer_extension.hpp"
+
+namespace duckdb {
+
+//! Skips the row groups of a table scan that can't match a spatial predicate against a constant geometry, set
+//! geo_bbox_pruning=false to disable. The box of a geography column g is read from the DOUBLE columns g_xmin, g_ymin,
+//! g_xmax and g_ymax of the same table, each declared with a CHECK constraint like CHECK (g_xmin = ST_XMIN(g)) so it
+//! can't go stale. The overlap test with the query box is added to the table filters of the scan, so the min/max
+//! statistics of those columns rule out whole row groups; rows without a box are kept and the predicate still runs.
+struct BoxPruningOptimizer {
+	static void Optimize(ClientContext &context, OptimizerExtensionInfo *info, unique_ptr<LogicalOperator> &plan);
+};
+
+} // namespace duckdb
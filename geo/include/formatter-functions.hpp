@@ -41,8 +41,19 @@ static const std::vector<ScalarFunctionSet> GetFormatterScalarFunctions(LogicalT
 	geohash.AddFunction(ScalarFunction({geo_type}, LogicalType::VARCHAR, GeoFunctions::GeometryGeoHashFunction));
 	geohash.AddFunction(
 	    ScalarFunction({geo_type, LogicalType::INTEGER}, LogicalType::VARCHAR, GeoFunctions::GeometryGeoHashFunction));
+	geohash.AddFunction(
+	    ScalarFunction({GeoTypes::Point2D()}, LogicalType::VARCHAR, GeoFunctions::PointGeoHashFunction));
+	geohash.AddFunction(ScalarFunction({GeoTypes::Point2D(), LogicalType::INTEGER}, LogicalType::VARCHAR,
+	                                   GeoFunctions::PointGeoHashFunction));
 	func_set.push_back(geohash);
 
+	// ST_HILBERTKEY
+	ScalarFunctionSet hilbert_key("st_hilbertkey");
+	hilbert_key.AddFunction(ScalarFunction({geo_type}, LogicalType::UBIGINT, GeoFunctions::GeometryHilbertKeyFunction));
+	hilbert_key.AddFunction(
+	    ScalarFunction({geo_type, geo_type}, LogicalType::UBIGINT, GeoFunctions::GeometryHilbertKeyFunction));
+	func_set.push_back(hilbert_key);
+
 	return func_set;
 }
 
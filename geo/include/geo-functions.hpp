@@ -8,15 +8,101 @@
 
 #pragma once
 
+#include "duckdb/common/string_util.hpp"
 #include "duckdb/function/cast/cast_function_set.hpp"
 #include "duckdb/function/function_set.hpp"
 #include "duckdb/function/scalar_function.hpp"
+#include "duckdb/main/config.hpp"
 
 namespace duckdb {
 
+//! The columnar point types, STRUCTs of DOUBLE coordinates that DuckDB keeps in one vector per coordinate, and the
+//! lines and polygons made of lists of them
+struct GeoTypes {
+	//! WKB in a BLOB
+	static LogicalType Geography() {
+		auto type = LogicalType(LogicalTypeId::BLOB);
+		type.SetAlias("GEOGRAPHY");
+		return type;
+	}
+	//! Whether a bound argument is WKB. The alias is compared without case, the type is registered as Geography
+	static bool IsGeography(const LogicalType &type) {
+		return type.id() == LogicalTypeId::BLOB && StringUtil::CIEquals(type.GetAlias(), "GEOGRAPHY");
+	}
+	static LogicalType Point2D() {
+		child_list_t<LogicalType> coords {{"x", LogicalType::DOUBLE}, {"y", LogicalType::DOUBLE}};
+		auto type = LogicalType::STRUCT(move(coords));
+		type.SetAlias("POINT_2D");
+		return type;
+	}
+	static LogicalType Point3D() {
+		child_list_t<LogicalType> coords {
+		    {"x", LogicalType::DOUBLE}, {"y", LogicalType::DOUBLE}, {"z", LogicalType::DOUBLE}};
+		auto type = LogicalType::STRUCT(move(coords));
+		type.SetAlias("POINT_3D");
+		return type;
+	}
+	static LogicalType LineString2D() {
+		auto type = LogicalType::LIST(Point2D());
+		type.SetAlias("LINESTRING_2D");
+		return type;
+	}
+	//! A list of rings, the first one is the shell
+	static LogicalType Polygon2D() {
+		auto type = LogicalType::LIST(LogicalType::LIST(Point2D()));
+		type.SetAlias("POLYGON_2D");
+		return type;
+	}
+};
+
+//! Cast data of the casts that decode or build geometries: the geo_arena_allocator and geo_wkb_header settings of the
+//! binding connection
+struct GeoCastData : public BoundCastData {
+	GeoCastData(bool arena, bool wkb_header) : arena(arena), wkb_header(wkb_header) {
+	}
+
+	bool arena;
+	bool wkb_header;
+
+	unique_ptr<BoundCastData> Copy() const override {
+		return make_unique<GeoCastData>(arena, wkb_header);
+	}
+
+	static bool Arena(CastParameters &parameters) {
+		return parameters.cast_data && ((GeoCastData &)*parameters.cast_data).arena;
+	}
+	static bool WKBHeader(CastParameters &parameters) {
+		return parameters.cast_data && ((GeoCastData &)*parameters.cast_data).wkb_header;
+	}
+};
+
 struct GeoFunctions {
+	//! Whether the geo_arena_allocator setting of a connection is on, which it is not by default
+	static bool ArenaEnabled(ClientContext &context);
+	//! Whether the geo_wkb_header setting of a connection is on, which it is not by default
+	static bool WKBHeaderEnabled(ClientContext &context);
+	//! Bind a cast to carry the geo_arena_allocator and geo_wkb_header settings of the binding connection to FUNCTION
+	template <cast_function_t FUNCTION>
+	static BoundCastInfo BindWithSettings(BindCastInput &input, const LogicalType &source, const LogicalType &target);
+	//! Wrap a scalar function so each chunk runs under the geo_arena_allocator and geo_wkb_header settings of the
+	//! connection
+	static scalar_function_t WithSettings(scalar_function_t function);
+	//! Local state of the geography distance functions, caching the circle tree of a repeated argument
+	static unique_ptr<FunctionLocalState> InitCircTreeCache(ExpressionState &state, const BoundFunctionExpression &expr,
+	                                                        FunctionData *bind_data);
+	static unique_ptr<FunctionLocalState> InitPrepGeomCache(ExpressionState &state, const BoundFunctionExpression &expr,
+	                                                        FunctionData *bind_data);
+
 	static bool CastVarcharToGEO(Vector &source, Vector &result, idx_t count, CastParameters &parameters);
 	static bool CastGeoToVarchar(Vector &source, Vector &result, idx_t count, CastParameters &parameters);
+	//! POINT_2D and POINT_3D to GEOGRAPHY and back, the WKB of a point is written and read without an LWGEOM
+	static bool CastPointToGEO(Vector &source, Vector &result, idx_t count, CastParameters &parameters);
+	static bool CastGEOToPoint(Vector &source, Vector &result, idx_t count, CastParameters &parameters);
+	//! LINESTRING_2D and POLYGON_2D to GEOGRAPHY and back, the WKB is written in one pass over the coordinates
+	static bool CastLineToGEO(Vector &source, Vector &result, idx_t count, CastParameters &parameters);
+	static bool CastPolygonToGEO(Vector &source, Vector &result, idx_t count, CastParameters &parameters);
+	static bool CastGEOToLine(Vector &source, Vector &result, idx_t count, CastParameters &parameters);
+	static bool CastGEOToPolygon(Vector &source, Vector &result, idx_t count, CastParameters &parameters);
 	static void MakePointFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void MakeLineFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void MakeLineArrayFunction(DataChunk &args, ExpressionState &state, Vector &result);
@@ -25,6 +111,7 @@ struct GeoFunctions {
 	static void GeometryAsTextFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void GeometryAsGeojsonFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void GeometryGeoHashFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void GeometryHilbertKeyFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void GeometryGeogFromFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void GeometryGeomFromGeoJsonFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void GeometryFromTextFunction(DataChunk &args, ExpressionState &state, Vector &result);
@@ -32,7 +119,7 @@ struct GeoFunctions {
 	static void GeometryFromGeoHashFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void GeometryGPointFromGeoHashFunction(DataChunk &args, ExpressionState &state, Vector &result);
 
-	// **Accessors (15)**
+	// **Accessors (19)**
 	static void GeometryDimensionFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void GeometryDumpFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void GeometryEndPointFunction(DataChunk &args, ExpressionState &state, Vector &result);
@@ -48,6 +135,10 @@ struct GeoFunctions {
 	static void GeometryStartPointFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void GeometryGetXFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void GeometryGetYFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void GeometryXMinFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void GeometryXMaxFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void GeometryYMinFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void GeometryYMaxFunction(DataChunk &args, ExpressionState &state, Vector &result);
 
 	// **Transformations (10)**:
 	static void GeometryBoundaryFunction(DataChunk &args, ExpressionState &state, Vector &result);
@@ -84,6 +175,31 @@ struct GeoFunctions {
 	static void GeometryBoundingBoxFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void GeometryMaxDistanceFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void GeometryExtentFunction(DataChunk &args, ExpressionState &state, Vector &result);
+
+	// **Points (4)**: the overloads on POINT_2D, reading the coordinate vectors directly
+	static void PointDistanceFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void PointDWithinFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void PointAzimuthFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void PointGeoHashFunction(DataChunk &args, ExpressionState &state, Vector &result);
+
+	// **Lines and polygons (8)**: the overloads on LINESTRING_2D and POLYGON_2D, reading the coordinate vectors directly
+	static void LineLengthFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void LineEnvelopeFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void LineSimplifyFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void PolygonAreaFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void PolygonEnvelopeFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void PolygonSimplifyFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void PolygonContainsFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void PointWithinFunction(DataChunk &args, ExpressionState &state, Vector &result);
 };
 
+template <cast_function_t FUNCTION>
+BoundCastInfo GeoFunctions::BindWithSettings(BindCastInput &input, const LogicalType &source,
+                                             const LogicalType &target) {
+	// Casts bound outside of a connection keep the defaults
+	auto arena = input.context && ArenaEnabled(*input.context);
+	auto wkb_header = input.context && WKBHeaderEnabled(*input.context);
+	return BoundCastInfo(FUNCTION, make_unique<GeoCastData>(arena, wkb_header));
+}
+
 } // namespace duckdb
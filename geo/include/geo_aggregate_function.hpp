@@ -8,12 +8,15 @@
 
 #pragma once
 
+#include "duckdb/parallel/task_scheduler.hpp"
 #include "geometry.hpp"
+#include "postgis/geography_centroid.hpp"
+#include "postgis/lwgeom_accum.hpp"
+#include "postgis/lwgeom_geos.hpp"
 
-namespace duckdb {
+#include <deque>
 
-// convert epsilon from km to radians
-double MS_PER_RADIAN = 6371.0088 * 1000;
+namespace duckdb {
 
 struct ClusterDBScanIncluded {
 	inline explicit ClusterDBScanIncluded(const ValidityMask &fmask_p, const ValidityMask &gmask_p,
@@ -32,6 +35,21 @@ struct ClusterDBScanIncluded {
 	const idx_t bias;
 };
 
+struct ClusterKMeansIncluded {
+	inline explicit ClusterKMeansIncluded(const ValidityMask &fmask_p, const ValidityMask &gmask_p,
+	                                      const ValidityMask &kmask_p, idx_t bias_p)
+	    : fmask(fmask_p), gmask(gmask_p), kmask(kmask_p), bias(bias_p) {
+	}
+
+	inline bool operator()(const idx_t &idx) const {
+		return fmask.RowIsValid(idx) && gmask.RowIsValid(idx - bias) && kmask.RowIsValid(idx - bias);
+	}
+	const ValidityMask &fmask;
+	const ValidityMask &gmask;
+	const ValidityMask &kmask;
+	const idx_t bias;
+};
+
 class GeoAggregateExecutor {
 private:
 	template <class STATE_TYPE, class A_TYPE, class B_TYPE, class C_TYPE, class OP>
@@ -143,59 +161,199 @@ public:
 		                                                                cvalid, aggr_input_data, (STATE *)state, frame,
 		                                                                prev, result, rid, bias);
 	}
+
+	template <class STATE, class A_TYPE, class B_TYPE, class RESULT_TYPE, class OP>
+	static void BinaryWindow(Vector &a, Vector &b, const ValidityMask &ifilter, AggregateInputData &aggr_input_data,
+	                         data_ptr_t state, const FrameBounds &frame, const FrameBounds &prev, Vector &result,
+	                         idx_t rid, idx_t bias) {
+
+		auto adata = FlatVector::GetData<const A_TYPE>(a) - bias;
+		const auto &avalid = FlatVector::Validity(a);
+		auto bdata = FlatVector::GetData<const B_TYPE>(b) - bias;
+		const auto &bvalid = FlatVector::Validity(b);
+		OP::template Window<STATE, A_TYPE, B_TYPE, RESULT_TYPE>(adata, bdata, ifilter, avalid, bvalid,
+		                                                        aggr_input_data, (STATE *)state, frame, prev, result,
+		                                                        rid, bias);
+	}
 };
 
-struct ClusterDBScanState {
-	bool isset;
-	double epsilon;
-	int minpoints;
+//! The geometries of the rows of a window partition, decoded once however many frames they are part of. Frames only
+//! slide forward, so the rows before the current frame are released as it moves
+struct ClusterWindowCache {
+	~ClusterWindowCache() {
+		Reset(0);
+	}
+
+	//! The decoded geometry of a row of the partition, nullptr if it is empty
+	LWGEOM *GetGeometry(idx_t row, const string_t &wkb) {
+		D_ASSERT(row >= base);
+		while (base + geoms.size() <= row) {
+			geoms.push_back(nullptr);
+			decoded.push_back(false);
+		}
+		auto offset = row - base;
+		if (!decoded[offset]) {
+			auto lwgeom = Geometry::GetLWGeom(wkb);
+			if (lwgeom && Geometry::IsEmpty(lwgeom)) {
+				Geometry::DestroyLWGeom(lwgeom);
+				lwgeom = nullptr;
+			}
+			geoms[offset] = lwgeom;
+			decoded[offset] = true;
+		}
+		return geoms[offset];
+	}
+
+	//! Release the geometries of the rows before the frame
+	void Evict(idx_t first) {
+		if (first < base) {
+			Reset(first);
+			return;
+		}
+		while (base < first && !geoms.empty()) {
+			if (geoms.front()) {
+				Geometry::DestroyLWGeom(geoms.front());
+			}
+			geoms.pop_front();
+			decoded.pop_front();
+			base++;
+		}
+		base = first;
+	}
+
+	void Reset(idx_t first) {
+		for (auto lwgeom : geoms) {
+			if (lwgeom) {
+				Geometry::DestroyLWGeom(lwgeom);
+			}
+		}
+		geoms.clear();
+		decoded.clear();
+		base = first;
+	}
+
+	//! The offset in its frame of the next row of the partition, false if the row is not in its frame
+	bool NextRow(const FrameBounds &other, idx_t &offset) {
+		auto current = row++;
+		if (current < other.first || current >= other.second) {
+			return false;
+		}
+		offset = current - other.first;
+		return true;
+	}
+
+	//! Whether the clusters are the ones of this frame
+	bool IsCurrent(const FrameBounds &other) const {
+		return isset && frame.first == other.first && frame.second == other.second;
+	}
+
+	//! Cluster the non-empty geometries of the included rows of the frame, cluster(geoms) returns their clusters
+	template <class A_TYPE, class INCLUDED, class CLUSTER>
+	void Update(const A_TYPE *adata, const INCLUDED &include, const FrameBounds &other, CLUSTER cluster) {
+		Evict(other.first);
+		size_t asize = other.second - other.first;
+		std::vector<LWGEOM *> frame_geoms;
+		std::vector<int> indexVec(asize, -1);
+
+		for (size_t i = other.first; i < other.second; i++) {
+			if (include(i)) {
+				auto lwgeom = GetGeometry(i, adata[i]);
+				if (lwgeom) {
+					indexVec[i - other.first] = frame_geoms.size();
+					frame_geoms.push_back(lwgeom);
+				}
+			}
+		}
+
+		std::vector<int> frame_clusters;
+		if (!frame_geoms.empty()) {
+			frame_clusters = cluster(frame_geoms);
+		}
+		clusters.assign(asize, -1);
+		for (idx_t i = 0; i < asize; i++) {
+			if (indexVec[i] != -1) {
+				clusters[i] = frame_clusters[indexVec[i]];
+			}
+		}
+		isset = true;
+		frame = other;
+	}
+
+	//! Write the cluster of the row at offset in the frame, NULL outside of any cluster
+	template <class RESULT_TYPE>
+	void Lookup(idx_t offset, Vector &result, idx_t ridx) const {
+		auto cluster = clusters[offset];
+		if (cluster == -1) {
+			FlatVector::Validity(result).SetInvalid(ridx);
+		} else {
+			FlatVector::GetData<RESULT_TYPE>(result)[ridx] = cluster;
+		}
+	}
+
+	//! the partition row of geoms[0]
+	idx_t base = 0;
+	std::deque<LWGEOM *> geoms;
+	std::deque<bool> decoded;
+
+	//! the partition row the next call evaluates, rows are evaluated in order
+	idx_t row = 0;
+	//! the clusters of the rows of the last frame, -1 for the rows outside of any cluster
+	bool isset = false;
+	FrameBounds frame;
 	std::vector<int> clusters;
+};
+
+//! The threads setting of the connection, which DBSCAN on points may use all of. The extra threads are started by
+//! the clustering itself rather than by the task scheduler, so they come on top of the workers
+struct ClusterDBScanBindData : public FunctionData {
+	explicit ClusterDBScanBindData(idx_t threads) : threads(threads) {
+	}
+
+	idx_t threads;
+
+	unique_ptr<FunctionData> Copy() const override {
+		return make_unique<ClusterDBScanBindData>(threads);
+	}
 
-	void Initialize() {
-		this->isset = false;
-		this->epsilon = 0;
-		this->minpoints = 0;
-		this->clusters = {};
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = (const ClusterDBScanBindData &)other_p;
+		return threads == other.threads;
 	}
 
-	void Combine(const ClusterDBScanState &other) {
-		this->isset = other.isset || this->isset;
-		this->epsilon = other.epsilon;
-		this->minpoints = other.minpoints;
-		this->clusters.insert(this->clusters.end(), other.clusters.begin(), other.clusters.end());
+	static unique_ptr<FunctionData> Bind(ClientContext &context) {
+		return make_unique<ClusterDBScanBindData>(TaskScheduler::GetScheduler(context).NumberOfThreads());
 	}
 };
 
+struct ClusterDBScanState {
+	ClusterWindowCache *cache;
+	double epsilon;
+	int minpoints;
+};
+
+//! ST_CLUSTERDBSCAN as a window function. DBSCAN runs once per distinct frame, so a frame spanning the whole partition
+//! clusters it once and every row of the partition looks its cluster up
 struct ClusterDBScanOperation {
 	template <class STATE>
 	static void Initialize(STATE *state) {
-		state->clusters = {};
+		state->cache = nullptr;
 		state->epsilon = 0;
 		state->minpoints = 0;
 	}
 
 	template <class STATE, class OP>
 	static void Combine(const STATE &source, STATE *target, AggregateInputData &aggr_input_data) {
-		target->Combine(source);
 	}
 
 	template <class A_TYPE, class B_TYPE, class C_TYPE, class STATE, class OP>
 	static void Operation(STATE *state, AggregateInputData &, A_TYPE *x_data, B_TYPE *y_data, C_TYPE *z_data,
 	                      ValidityMask &amask, ValidityMask &bmask, ValidityMask &cmask, idx_t xidx, idx_t yidx,
 	                      idx_t zidx) {
-		// state->isset = true;
-		// state->epsilon = y_data[yidx];
-		// state->minpoints = z_data[zidx];
 	}
 
 	template <class A_TYPE, class B_TYPE, class C_TYPE, class STATE, class OP>
 	static void ConstantOperation(STATE *state, AggregateInputData &, A_TYPE *x_data, B_TYPE *y_data, C_TYPE *z_data,
 	                              ValidityMask &mask, idx_t count) {
-		// state->isset = true;
-		// for (size_t i = 0; i < count; i++) {
-		// 	state->epsilon = y_data[i];
-		// 	state->minpoints = z_data[i];
-		// }
 	}
 
 	static bool IgnoreNull() {
@@ -204,10 +362,8 @@ struct ClusterDBScanOperation {
 
 	template <class T, class STATE>
 	static void Finalize(Vector &result, AggregateInputData &, STATE *state, T *target, ValidityMask &mask, idx_t idx) {
-		// if (!state->isset) {
-		// 	mask.SetInvalid(idx);
-		// } else {
-		// }
+		throw InvalidInputException(
+		    "st_clusterdbscan: only supported as a window function, use st_clusterdbscan_agg to cluster a group");
 	}
 
 	template <class STATE, class A_TYPE, class B_TYPE, class C_TYPE, class RESULT_TYPE>
@@ -217,66 +373,34 @@ struct ClusterDBScanOperation {
 	                   const FrameBounds &prev, Vector &result, idx_t ridx, idx_t bias) {
 		ClusterDBScanIncluded include(fmask, amask, bmask, cmask, bias);
 
-		auto rdata = FlatVector::GetData<RESULT_TYPE>(result);
-		auto &rmask = FlatVector::Validity(result);
-		double epsilon = bdata[ridx] / MS_PER_RADIAN;
-		int minpoints = cdata[ridx];
-		if (!state->isset || frame.first != prev.first || frame.second != prev.second || state->epsilon != epsilon ||
-		    state->minpoints != minpoints) {
-			state->isset = true;
+		if (!state->cache) {
+			state->cache = new ClusterWindowCache();
+		}
+		auto &cache = *state->cache;
+		// ridx is the row of the result vector, the cache counts the rows of the partition
+		idx_t offset;
+		if (!cache.NextRow(frame, offset)) {
+			FlatVector::Validity(result).SetInvalid(ridx);
+			return;
+		}
+
+		// the parameters are constant over the partition, only the rows of the frame are readable
+		double epsilon = bdata[frame.first];
+		int minpoints = cdata[frame.first];
+		if (!cache.IsCurrent(frame) || state->epsilon != epsilon || state->minpoints != minpoints) {
 			state->epsilon = epsilon;
 			state->minpoints = minpoints;
-			size_t asize = frame.second - frame.first;
-			std::vector<GSERIALIZED *> gserArray {};
-			std::vector<int> indexVec(asize, -1);
-			int idx = 0;
-
-			for (size_t i = frame.first; i < frame.second; i++) {
-				if (include(i)) {
-					auto gser = Geometry::GetGserialized(adata[i]);
-					if (!Geometry::IsEmpty(gser)) {
-						gserArray.push_back(gser);
-						indexVec[i - frame.first] = idx++;
-					} else {
-						Geometry::DestroyGeometry(gser);
-					}
-				}
-			}
-
-			// Doing cluster db scan
-			auto clusters = Geometry::GeometryClusterDBScan(&gserArray[0], gserArray.size(), epsilon, minpoints);
-
-			state->clusters = {};
-
-			for (idx_t i = 0; i < asize; i++) {
-				if (indexVec[i] == -1) {
-					state->clusters.push_back(-1);
-				} else {
-					state->clusters.push_back(clusters[indexVec[i]]);
-				}
-			}
-
-			// Free memory
-			for (idx_t child_idx = 0; child_idx < gserArray.size(); child_idx++) {
-				Geometry::DestroyGeometry(gserArray[child_idx]);
-			}
-
-			if (state->clusters[ridx - frame.first] == -1) {
-				rmask.SetInvalid(ridx);
-			} else {
-				rdata[ridx] = state->clusters[ridx - frame.first];
-			}
-		} else {
-			if (state->clusters[ridx - frame.first] == -1) {
-				rmask.SetInvalid(ridx);
-			} else {
-				rdata[ridx] = state->clusters[ridx - frame.first];
-			}
+			auto threads = ((ClusterDBScanBindData &)*aggr_input_data.bind_data).threads;
+			cache.Update(adata, include, frame, [&](std::vector<LWGEOM *> &geoms) {
+				return Geometry::GeometryClusterDBScan(&geoms[0], geoms.size(), epsilon, minpoints, threads);
+			});
 		}
+		cache.Lookup<RESULT_TYPE>(offset, result, ridx);
 	}
 
 	template <class STATE>
 	static void Destroy(STATE *state) {
+		delete state->cache;
 	}
 };
 
@@ -305,6 +429,15 @@ static void TernaryWindow(Vector inputs[], const ValidityMask &filter_mask, Aggr
 	    inputs[0], inputs[1], inputs[2], filter_mask, aggr_input_data, state, frame, prev, result, rid, bias);
 }
 
+template <class STATE, class A_TYPE, class B_TYPE, class RESULT_TYPE, class OP>
+static void BinaryWindow(Vector inputs[], const ValidityMask &filter_mask, AggregateInputData &aggr_input_data,
+                         idx_t input_count, data_ptr_t state, const FrameBounds &frame, const FrameBounds &prev,
+                         Vector &result, idx_t rid, idx_t bias) {
+	D_ASSERT(input_count == 2);
+	GeoAggregateExecutor::BinaryWindow<STATE, A_TYPE, B_TYPE, RESULT_TYPE, OP>(
+	    inputs[0], inputs[1], filter_mask, aggr_input_data, state, frame, prev, result, rid, bias);
+}
+
 unique_ptr<FunctionData> BindGeometryClusterDBScan(ClientContext &context, AggregateFunction &function,
                                                    vector<unique_ptr<Expression>> &arguments) {
 	auto geo_type = arguments[0]->return_type;
@@ -314,14 +447,14 @@ unique_ptr<FunctionData> BindGeometryClusterDBScan(ClientContext &context, Aggre
 	                      AggregateFunction::StateInitialize<ClusterDBScanState, ClusterDBScanOperation>,
 	                      TernaryScatterUpdate<ClusterDBScanState, string_t, double, int, ClusterDBScanOperation>,
 	                      AggregateFunction::StateCombine<ClusterDBScanState, ClusterDBScanOperation>,
-	                      AggregateFunction::StateFinalize<ClusterDBScanState, double, ClusterDBScanOperation>,
+	                      AggregateFunction::StateFinalize<ClusterDBScanState, int32_t, ClusterDBScanOperation>,
 	                      FunctionNullHandling::DEFAULT_NULL_HANDLING,
 	                      TernaryUpdate<ClusterDBScanState, string_t, double, int, ClusterDBScanOperation>, nullptr,
 	                      AggregateFunction::StateDestroy<ClusterDBScanState, ClusterDBScanOperation>, nullptr,
 	                      TernaryWindow<ClusterDBScanState, string_t, double, int, int, ClusterDBScanOperation>);
 	function.name = "st_clusterdbscan";
 	function.arguments[0] = geo_type;
-	return nullptr;
+	return ClusterDBScanBindData::Bind(context);
 }
 
 static const AggregateFunctionSet GetClusterDBScanAggregateFunction(LogicalType geo_type) {
@@ -334,4 +467,723 @@ static const AggregateFunctionSet GetClusterDBScanAggregateFunction(LogicalType
 	return cluster_dbscan;
 }
 
+//! The geometries of a group in input order for the list forms of the cluster functions, a NULL or empty geometry
+//! keeps its place and is in no cluster
+struct ClusterListInput {
+	std::vector<string> geoms;
+	std::vector<bool> valid;
+
+	void Add(const string_t &geom, bool is_valid) {
+		geoms.push_back(is_valid ? geom.GetString() : string());
+		valid.push_back(is_valid);
+	}
+
+	void Append(const ClusterListInput &other) {
+		geoms.insert(geoms.end(), other.geoms.begin(), other.geoms.end());
+		valid.insert(valid.end(), other.valid.begin(), other.valid.end());
+	}
+
+	//! Write the clusters of the group as a list, cluster(geoms) returns the clusters of the non-empty geometries
+	template <class CLUSTER>
+	void Finalize(Vector &result, list_entry_t *target, idx_t idx, CLUSTER cluster) {
+		auto count = geoms.size();
+
+		std::vector<LWGEOM *> lwgeoms;
+		std::vector<int> indexVec(count, -1);
+		std::vector<int> clusters;
+		try {
+			for (idx_t i = 0; i < count; i++) {
+				if (!valid[i]) {
+					continue;
+				}
+				auto lwgeom = Geometry::GetLWGeom(string_t(geoms[i]));
+				if (!lwgeom) {
+					continue;
+				}
+				if (Geometry::IsEmpty(lwgeom)) {
+					Geometry::DestroyLWGeom(lwgeom);
+					continue;
+				}
+				indexVec[i] = lwgeoms.size();
+				lwgeoms.push_back(lwgeom);
+			}
+			if (!lwgeoms.empty()) {
+				clusters = cluster(lwgeoms);
+			}
+		} catch (...) {
+			for (auto lwgeom : lwgeoms) {
+				Geometry::DestroyLWGeom(lwgeom);
+			}
+			throw;
+		}
+		for (auto lwgeom : lwgeoms) {
+			Geometry::DestroyLWGeom(lwgeom);
+		}
+
+		auto offset = ListVector::GetListSize(result);
+		ListVector::Reserve(result, offset + count);
+		auto &child_vector = ListVector::GetEntry(result);
+		auto child_data = FlatVector::GetData<int32_t>(child_vector);
+		auto &child_mask = FlatVector::Validity(child_vector);
+		for (idx_t i = 0; i < count; i++) {
+			auto cluster_id = indexVec[i] == -1 ? -1 : clusters[indexVec[i]];
+			if (cluster_id == -1) {
+				child_mask.SetInvalid(offset + i);
+			} else {
+				child_data[offset + i] = cluster_id;
+			}
+		}
+		target[idx].offset = offset;
+		target[idx].length = count;
+		ListVector::SetListSize(result, offset + count);
+	}
+};
+
+//! The input of ST_CLUSTERDBSCAN_AGG, with the parameters of the group
+struct ClusterDBScanInput : public ClusterListInput {
+	bool isset = false;
+	double epsilon = 0;
+	int minpoints = 0;
+
+	void SetParameters(double other_epsilon, int other_minpoints) {
+		if (!isset) {
+			isset = true;
+			epsilon = other_epsilon;
+			minpoints = other_minpoints;
+		} else if (epsilon != other_epsilon || minpoints != other_minpoints) {
+			throw InvalidInputException("st_clusterdbscan_agg: eps and minpoints must be constant within a group");
+		}
+	}
+};
+
+struct ClusterDBScanAggState {
+	ClusterDBScanInput *input;
+};
+
+//! ST_CLUSTERDBSCAN over a group, the cluster ids of the rows as a list in the order of list() over the same group
+struct ClusterDBScanAggOperation {
+	template <class STATE>
+	static void Initialize(STATE *state) {
+		state->input = nullptr;
+	}
+
+	template <class STATE, class OP>
+	static void Combine(const STATE &source, STATE *target, AggregateInputData &aggr_input_data) {
+		if (!source.input) {
+			return;
+		}
+		if (!target->input) {
+			target->input = new ClusterDBScanInput();
+		}
+		if (source.input->isset) {
+			target->input->SetParameters(source.input->epsilon, source.input->minpoints);
+		}
+		target->input->Append(*source.input);
+	}
+
+	template <class A_TYPE, class B_TYPE, class C_TYPE, class STATE, class OP>
+	static void Operation(STATE *state, AggregateInputData &, A_TYPE *x_data, B_TYPE *y_data, C_TYPE *z_data,
+	                      ValidityMask &amask, ValidityMask &bmask, ValidityMask &cmask, idx_t xidx, idx_t yidx,
+	                      idx_t zidx) {
+		if (!state->input) {
+			state->input = new ClusterDBScanInput();
+		}
+		auto valid = amask.RowIsValid(xidx) && bmask.RowIsValid(yidx) && cmask.RowIsValid(zidx);
+		if (valid) {
+			state->input->SetParameters(y_data[yidx], z_data[zidx]);
+		}
+		state->input->Add(x_data[xidx], valid);
+	}
+
+	static bool IgnoreNull() {
+		return false;
+	}
+
+	template <class T, class STATE>
+	static void Finalize(Vector &result, AggregateInputData &aggr_input_data, STATE *state, T *target,
+	                     ValidityMask &mask, idx_t idx) {
+		if (!state->input) {
+			mask.SetInvalid(idx);
+			return;
+		}
+		auto &input = *state->input;
+		auto threads = ((ClusterDBScanBindData &)*aggr_input_data.bind_data).threads;
+		input.Finalize(result, target, idx, [&](std::vector<LWGEOM *> &geoms) {
+			return Geometry::GeometryClusterDBScan(&geoms[0], geoms.size(), input.epsilon, input.minpoints,
+			                                       threads);
+		});
+	}
+
+	template <class STATE>
+	static void Destroy(STATE *state) {
+		delete state->input;
+	}
+};
+
+unique_ptr<FunctionData> BindGeometryClusterDBScanAgg(ClientContext &context, AggregateFunction &function,
+                                                      vector<unique_ptr<Expression>> &arguments) {
+	return ClusterDBScanBindData::Bind(context);
+}
+
+static const AggregateFunctionSet GetClusterDBScanListAggregateFunction(LogicalType geo_type) {
+	// ST_CLUSTERDBSCAN_AGG
+	AggregateFunctionSet cluster_dbscan_agg("st_clusterdbscan_agg");
+	cluster_dbscan_agg.AddFunction(AggregateFunction(
+	    {geo_type, LogicalType::DOUBLE, LogicalType::INTEGER}, LogicalType::LIST(LogicalType::INTEGER),
+	    AggregateFunction::StateSize<ClusterDBScanAggState>,
+	    AggregateFunction::StateInitialize<ClusterDBScanAggState, ClusterDBScanAggOperation>,
+	    TernaryScatterUpdate<ClusterDBScanAggState, string_t, double, int, ClusterDBScanAggOperation>,
+	    AggregateFunction::StateCombine<ClusterDBScanAggState, ClusterDBScanAggOperation>,
+	    AggregateFunction::StateFinalize<ClusterDBScanAggState, list_entry_t, ClusterDBScanAggOperation>,
+	    FunctionNullHandling::SPECIAL_HANDLING,
+	    TernaryUpdate<ClusterDBScanAggState, string_t, double, int, ClusterDBScanAggOperation>,
+	    BindGeometryClusterDBScanAgg,
+	    AggregateFunction::StateDestroy<ClusterDBScanAggState, ClusterDBScanAggOperation>));
+
+	return cluster_dbscan_agg;
+}
+
+struct ClusterKMeansState {
+	ClusterWindowCache *cache;
+	int k;
+};
+
+//! ST_CLUSTERKMEANS as a window function, k-means on the unit sphere runs once per distinct frame like DBSCAN
+struct ClusterKMeansOperation {
+	template <class STATE>
+	static void Initialize(STATE *state) {
+		state->cache = nullptr;
+		state->k = 0;
+	}
+
+	template <class STATE, class OP>
+	static void Combine(const STATE &source, STATE *target, AggregateInputData &aggr_input_data) {
+	}
+
+	template <class A_TYPE, class B_TYPE, class STATE, class OP>
+	static void Operation(STATE *state, AggregateInputData &, A_TYPE *x_data, B_TYPE *y_data, ValidityMask &amask,
+	                      ValidityMask &bmask, idx_t xidx, idx_t yidx) {
+	}
+
+	static bool IgnoreNull() {
+		return true;
+	}
+
+	template <class T, class STATE>
+	static void Finalize(Vector &result, AggregateInputData &, STATE *state, T *target, ValidityMask &mask, idx_t idx) {
+		throw InvalidInputException(
+		    "st_clusterkmeans: only supported as a window function, use st_clusterkmeans_agg to cluster a group");
+	}
+
+	template <class STATE, class A_TYPE, class B_TYPE, class RESULT_TYPE>
+	static void Window(const A_TYPE *adata, const B_TYPE *bdata, const ValidityMask &fmask, const ValidityMask &amask,
+	                   const ValidityMask &bmask, AggregateInputData &aggr_input_data, STATE *state,
+	                   const FrameBounds &frame, const FrameBounds &prev, Vector &result, idx_t ridx, idx_t bias) {
+		ClusterKMeansIncluded include(fmask, amask, bmask, bias);
+
+		if (!state->cache) {
+			state->cache = new ClusterWindowCache();
+		}
+		auto &cache = *state->cache;
+		idx_t offset;
+		if (!cache.NextRow(frame, offset)) {
+			FlatVector::Validity(result).SetInvalid(ridx);
+			return;
+		}
+
+		int k = bdata[frame.first];
+		if (!cache.IsCurrent(frame) || state->k != k) {
+			state->k = k;
+			cache.Update(adata, include, frame, [&](std::vector<LWGEOM *> &geoms) {
+				return Geometry::GeometryClusterKMeans(&geoms[0], geoms.size(), k);
+			});
+		}
+		cache.Lookup<RESULT_TYPE>(offset, result, ridx);
+	}
+
+	template <class STATE>
+	static void Destroy(STATE *state) {
+		delete state->cache;
+	}
+};
+
+static const AggregateFunctionSet GetClusterKMeansAggregateFunction(LogicalType geo_type) {
+	// ST_CLUSTERKMEANS
+	AggregateFunctionSet cluster_kmeans("st_clusterkmeans");
+	cluster_kmeans.AddFunction(AggregateFunction(
+	    {geo_type, LogicalType::INTEGER}, LogicalType::INTEGER, AggregateFunction::StateSize<ClusterKMeansState>,
+	    AggregateFunction::StateInitialize<ClusterKMeansState, ClusterKMeansOperation>,
+	    AggregateFunction::BinaryScatterUpdate<ClusterKMeansState, string_t, int, ClusterKMeansOperation>,
+	    AggregateFunction::StateCombine<ClusterKMeansState, ClusterKMeansOperation>,
+	    AggregateFunction::StateFinalize<ClusterKMeansState, int32_t, ClusterKMeansOperation>,
+	    FunctionNullHandling::DEFAULT_NULL_HANDLING,
+	    AggregateFunction::BinaryUpdate<ClusterKMeansState, string_t, int, ClusterKMeansOperation>, nullptr,
+	    AggregateFunction::StateDestroy<ClusterKMeansState, ClusterKMeansOperation>, nullptr,
+	    BinaryWindow<ClusterKMeansState, string_t, int, int, ClusterKMeansOperation>));
+
+	return cluster_kmeans;
+}
+
+//! The input of ST_CLUSTERKMEANS_AGG, with the number of clusters of the group
+struct ClusterKMeansInput : public ClusterListInput {
+	bool isset = false;
+	int k = 0;
+
+	void SetParameters(int other_k) {
+		if (!isset) {
+			isset = true;
+			k = other_k;
+		} else if (k != other_k) {
+			throw InvalidInputException("st_clusterkmeans_agg: number of clusters must be constant within a group");
+		}
+	}
+};
+
+struct ClusterKMeansAggState {
+	ClusterKMeansInput *input;
+};
+
+//! ST_CLUSTERKMEANS over a group, the cluster ids of the rows as a list in the order of list() over the same group
+struct ClusterKMeansAggOperation {
+	template <class STATE>
+	static void Initialize(STATE *state) {
+		state->input = nullptr;
+	}
+
+	template <class STATE, class OP>
+	static void Combine(const STATE &source, STATE *target, AggregateInputData &aggr_input_data) {
+		if (!source.input) {
+			return;
+		}
+		if (!target->input) {
+			target->input = new ClusterKMeansInput();
+		}
+		if (source.input->isset) {
+			target->input->SetParameters(source.input->k);
+		}
+		target->input->Append(*source.input);
+	}
+
+	template <class A_TYPE, class B_TYPE, class STATE, class OP>
+	static void Operation(STATE *state, AggregateInputData &, A_TYPE *x_data, B_TYPE *y_data, ValidityMask &amask,
+	                      ValidityMask &bmask, idx_t xidx, idx_t yidx) {
+		if (!state->input) {
+			state->input = new ClusterKMeansInput();
+		}
+		auto valid = amask.RowIsValid(xidx) && bmask.RowIsValid(yidx);
+		if (valid) {
+			state->input->SetParameters(y_data[yidx]);
+		}
+		state->input->Add(x_data[xidx], valid);
+	}
+
+	static bool IgnoreNull() {
+		return false;
+	}
+
+	template <class T, class STATE>
+	static void Finalize(Vector &result, AggregateInputData &, STATE *state, T *target, ValidityMask &mask, idx_t idx) {
+		if (!state->input) {
+			mask.SetInvalid(idx);
+			return;
+		}
+		auto &input = *state->input;
+		input.Finalize(result, target, idx, [&](std::vector<LWGEOM *> &geoms) {
+			return Geometry::GeometryClusterKMeans(&geoms[0], geoms.size(), input.k);
+		});
+	}
+
+	template <class STATE>
+	static void Destroy(STATE *state) {
+		delete state->input;
+	}
+};
+
+static const AggregateFunctionSet GetClusterKMeansListAggregateFunction(LogicalType geo_type) {
+	// ST_CLUSTERKMEANS_AGG
+	AggregateFunctionSet cluster_kmeans_agg("st_clusterkmeans_agg");
+	cluster_kmeans_agg.AddFunction(AggregateFunction(
+	    {geo_type, LogicalType::INTEGER}, LogicalType::LIST(LogicalType::INTEGER),
+	    AggregateFunction::StateSize<ClusterKMeansAggState>,
+	    AggregateFunction::StateInitialize<ClusterKMeansAggState, ClusterKMeansAggOperation>,
+	    AggregateFunction::BinaryScatterUpdate<ClusterKMeansAggState, string_t, int, ClusterKMeansAggOperation>,
+	    AggregateFunction::StateCombine<ClusterKMeansAggState, ClusterKMeansAggOperation>,
+	    AggregateFunction::StateFinalize<ClusterKMeansAggState, list_entry_t, ClusterKMeansAggOperation>,
+	    FunctionNullHandling::SPECIAL_HANDLING,
+	    AggregateFunction::BinaryUpdate<ClusterKMeansAggState, string_t, int, ClusterKMeansAggOperation>, nullptr,
+	    AggregateFunction::StateDestroy<ClusterKMeansAggState, ClusterKMeansAggOperation>));
+
+	return cluster_kmeans_agg;
+}
+
+struct ExtentState {
+	bool isset;
+	int32_t srid;
+	GBOX box;
+
+	void Merge(const GBOX &other, int32_t other_srid) {
+		if (!this->isset) {
+			this->isset = true;
+			this->srid = other_srid;
+			this->box = other;
+			return;
+		}
+		if (this->srid != other_srid) {
+			throw InvalidInputException("st_extent_agg: Operation on mixed SRID geometries (%d != %d)", this->srid,
+			                            other_srid);
+		}
+		gbox_merge(&other, &this->box);
+	}
+};
+
+//! ST_EXTENT over a column, the state is only the box so the input is never decoded nor kept
+struct ExtentOperation {
+	template <class STATE>
+	static void Initialize(STATE *state) {
+		state->isset = false;
+		state->srid = SRID_UNKNOWN;
+		gbox_init(&state->box);
+	}
+
+	template <class STATE, class OP>
+	static void Combine(const STATE &source, STATE *target, AggregateInputData &aggr_input_data) {
+		if (source.isset) {
+			target->Merge(source.box, source.srid);
+		}
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void Operation(STATE *state, AggregateInputData &, INPUT_TYPE *input, ValidityMask &mask, idx_t idx) {
+		GBOX box;
+		int32_t srid;
+		if (Geometry::GetBoundingBox(input[idx], box, srid)) {
+			state->Merge(box, srid);
+		}
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void ConstantOperation(STATE *state, AggregateInputData &aggr_input_data, INPUT_TYPE *input,
+	                              ValidityMask &mask, idx_t count) {
+		// the box of a repeated geometry is the box of one of them
+		Operation<INPUT_TYPE, STATE, OP>(state, aggr_input_data, input, mask, 0);
+	}
+
+	static bool IgnoreNull() {
+		return true;
+	}
+
+	template <class T, class STATE>
+	static void Finalize(Vector &result, AggregateInputData &, STATE *state, T *target, ValidityMask &mask, idx_t idx) {
+		if (!state->isset) {
+			mask.SetInvalid(idx);
+			return;
+		}
+		auto envelope = Geometry::GeometryEnvelope(state->box, state->srid);
+		target[idx] = Geometry::ToWKB(result, envelope);
+		Geometry::DestroyLWGeom(envelope);
+	}
+};
+
+static const AggregateFunctionSet GetExtentAggregateFunction(LogicalType geo_type) {
+	// ST_EXTENT_AGG
+	AggregateFunctionSet extent_agg("st_extent_agg");
+	extent_agg.AddFunction(
+	    AggregateFunction::UnaryAggregate<ExtentState, string_t, string_t, ExtentOperation>(geo_type, geo_type));
+
+	return extent_agg;
+}
+
+struct UnionState {
+	CascadedUnion *geom_union;
+};
+
+//! ST_UNION over a column, each state unions its input a batch at a time and Combine merges the partial unions
+struct UnionOperation {
+	template <class STATE>
+	static void Initialize(STATE *state) {
+		state->geom_union = nullptr;
+	}
+
+	template <class STATE, class OP>
+	static void Combine(const STATE &source, STATE *target, AggregateInputData &aggr_input_data) {
+		if (!source.geom_union) {
+			return;
+		}
+		if (!target->geom_union) {
+			target->geom_union = new CascadedUnion();
+		}
+		target->geom_union->Merge(*source.geom_union);
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void Operation(STATE *state, AggregateInputData &, INPUT_TYPE *input, ValidityMask &mask, idx_t idx) {
+		auto lwgeom = Geometry::GetLWGeom(input[idx]);
+		if (!lwgeom) {
+			return;
+		}
+		if (!state->geom_union) {
+			state->geom_union = new CascadedUnion();
+		}
+		try {
+			state->geom_union->Add(lwgeom);
+		} catch (...) {
+			Geometry::DestroyLWGeom(lwgeom);
+			throw;
+		}
+		Geometry::DestroyLWGeom(lwgeom);
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void ConstantOperation(STATE *state, AggregateInputData &aggr_input_data, INPUT_TYPE *input,
+	                              ValidityMask &mask, idx_t count) {
+		// the union of a repeated geometry is the union of one of them
+		Operation<INPUT_TYPE, STATE, OP>(state, aggr_input_data, input, mask, 0);
+	}
+
+	static bool IgnoreNull() {
+		return true;
+	}
+
+	template <class T, class STATE>
+	static void Finalize(Vector &result, AggregateInputData &, STATE *state, T *target, ValidityMask &mask, idx_t idx) {
+		auto lwgeom = state->geom_union ? state->geom_union->Finish() : nullptr;
+		if (!lwgeom) {
+			mask.SetInvalid(idx);
+			return;
+		}
+		target[idx] = Geometry::ToWKB(result, lwgeom);
+		Geometry::DestroyLWGeom(lwgeom);
+	}
+
+	template <class STATE>
+	static void Destroy(STATE *state) {
+		delete state->geom_union;
+	}
+};
+
+static const AggregateFunctionSet GetUnionAggregateFunction(LogicalType geo_type) {
+	// ST_UNION_AGG
+	AggregateFunctionSet union_agg("st_union_agg");
+	auto function =
+	    AggregateFunction::UnaryAggregateDestructor<UnionState, string_t, string_t, UnionOperation>(geo_type, geo_type);
+	union_agg.AddFunction(function);
+
+	return union_agg;
+}
+
+struct CollectState {
+	CollectAccumulator *collect;
+};
+
+//! ST_COLLECT over a column, the decoded inputs are appended to the collection of the state as they come
+struct CollectOperation {
+	template <class STATE>
+	static void Initialize(STATE *state) {
+		state->collect = nullptr;
+	}
+
+	template <class STATE, class OP>
+	static void Combine(const STATE &source, STATE *target, AggregateInputData &aggr_input_data) {
+		if (!source.collect) {
+			return;
+		}
+		if (!target->collect) {
+			target->collect = new CollectAccumulator();
+		}
+		target->collect->Merge(*source.collect);
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void Operation(STATE *state, AggregateInputData &, INPUT_TYPE *input, ValidityMask &mask, idx_t idx) {
+		auto lwgeom = Geometry::GetLWGeom(input[idx]);
+		if (!lwgeom) {
+			return;
+		}
+		if (!state->collect) {
+			state->collect = new CollectAccumulator();
+		}
+		state->collect->Add(lwgeom);
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void ConstantOperation(STATE *state, AggregateInputData &aggr_input_data, INPUT_TYPE *input,
+	                              ValidityMask &mask, idx_t count) {
+		for (idx_t i = 0; i < count; i++) {
+			Operation<INPUT_TYPE, STATE, OP>(state, aggr_input_data, input, mask, 0);
+		}
+	}
+
+	static bool IgnoreNull() {
+		return true;
+	}
+
+	template <class T, class STATE>
+	static void Finalize(Vector &result, AggregateInputData &, STATE *state, T *target, ValidityMask &mask, idx_t idx) {
+		auto lwgeom = state->collect ? state->collect->Finish() : nullptr;
+		if (!lwgeom) {
+			mask.SetInvalid(idx);
+			return;
+		}
+		target[idx] = Geometry::ToWKB(result, lwgeom);
+	}
+
+	template <class STATE>
+	static void Destroy(STATE *state) {
+		delete state->collect;
+	}
+};
+
+static const AggregateFunctionSet GetCollectAggregateFunction(LogicalType geo_type) {
+	// ST_COLLECT_AGG
+	AggregateFunctionSet collect_agg("st_collect_agg");
+	auto function = AggregateFunction::UnaryAggregateDestructor<CollectState, string_t, string_t, CollectOperation>(
+	    geo_type, geo_type);
+	collect_agg.AddFunction(function);
+
+	return collect_agg;
+}
+
+struct MakeLineState {
+	MakeLineAccumulator *makeline;
+};
+
+//! ST_MAKELINE over a column, the coordinates of the inputs are appended to the line of the state as they come
+struct MakeLineOperation {
+	template <class STATE>
+	static void Initialize(STATE *state) {
+		state->makeline = nullptr;
+	}
+
+	template <class STATE, class OP>
+	static void Combine(const STATE &source, STATE *target, AggregateInputData &aggr_input_data) {
+		if (!source.makeline) {
+			return;
+		}
+		if (!target->makeline) {
+			target->makeline = new MakeLineAccumulator();
+		}
+		target->makeline->Merge(*source.makeline);
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void Operation(STATE *state, AggregateInputData &, INPUT_TYPE *input, ValidityMask &mask, idx_t idx) {
+		auto lwgeom = Geometry::GetLWGeom(input[idx]);
+		if (!lwgeom) {
+			return;
+		}
+		if (!state->makeline) {
+			state->makeline = new MakeLineAccumulator();
+		}
+		try {
+			state->makeline->Add(lwgeom);
+		} catch (...) {
+			Geometry::DestroyLWGeom(lwgeom);
+			throw;
+		}
+		Geometry::DestroyLWGeom(lwgeom);
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void ConstantOperation(STATE *state, AggregateInputData &aggr_input_data, INPUT_TYPE *input,
+	                              ValidityMask &mask, idx_t count) {
+		for (idx_t i = 0; i < count; i++) {
+			Operation<INPUT_TYPE, STATE, OP>(state, aggr_input_data, input, mask, 0);
+		}
+	}
+
+	static bool IgnoreNull() {
+		return true;
+	}
+
+	template <class T, class STATE>
+	static void Finalize(Vector &result, AggregateInputData &, STATE *state, T *target, ValidityMask &mask, idx_t idx) {
+		auto lwgeom = state->makeline ? state->makeline->Finish() : nullptr;
+		if (!lwgeom) {
+			mask.SetInvalid(idx);
+			return;
+		}
+		target[idx] = Geometry::ToWKB(result, lwgeom);
+	}
+
+	template <class STATE>
+	static void Destroy(STATE *state) {
+		delete state->makeline;
+	}
+};
+
+static const AggregateFunctionSet GetMakeLineAggregateFunction(LogicalType geo_type) {
+	// ST_MAKELINE_AGG
+	AggregateFunctionSet makeline_agg("st_makeline_agg");
+	auto function = AggregateFunction::UnaryAggregateDestructor<MakeLineState, string_t, string_t, MakeLineOperation>(
+	    geo_type, geo_type);
+	makeline_agg.AddFunction(function);
+
+	return makeline_agg;
+}
+
+struct CentroidState {
+	GeographyCentroidSum centroid;
+};
+
+//! ST_CENTROID over a column, the state is only the weighted sums so partial states merge by adding them up
+struct CentroidOperation {
+	template <class STATE>
+	static void Initialize(STATE *state) {
+		state->centroid.Initialize();
+	}
+
+	template <class STATE, class OP>
+	static void Combine(const STATE &source, STATE *target, AggregateInputData &aggr_input_data) {
+		target->centroid.Merge(source.centroid);
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void Operation(STATE *state, AggregateInputData &, INPUT_TYPE *input, ValidityMask &mask, idx_t idx) {
+		auto lwgeom = Geometry::GetLWGeom(input[idx]);
+		if (!lwgeom) {
+			return;
+		}
+		try {
+			state->centroid.Add(lwgeom);
+		} catch (...) {
+			Geometry::DestroyLWGeom(lwgeom);
+			throw;
+		}
+		Geometry::DestroyLWGeom(lwgeom);
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void ConstantOperation(STATE *state, AggregateInputData &aggr_input_data, INPUT_TYPE *input,
+	                              ValidityMask &mask, idx_t count) {
+		// a repeated geometry weighs as much as its repetitions against the other inputs
+		for (idx_t i = 0; i < count; i++) {
+			Operation<INPUT_TYPE, STATE, OP>(state, aggr_input_data, input, mask, 0);
+		}
+	}
+
+	static bool IgnoreNull() {
+		return true;
+	}
+
+	template <class T, class STATE>
+	static void Finalize(Vector &result, AggregateInputData &, STATE *state, T *target, ValidityMask &mask, idx_t idx) {
+		auto lwgeom = state->centroid.Finish();
+		if (!lwgeom) {
+			mask.SetInvalid(idx);
+			return;
+		}
+		target[idx] = Geometry::ToWKB(result, lwgeom);
+		Geometry::DestroyLWGeom(lwgeom);
+	}
+};
+
+static const AggregateFunctionSet GetCentroidAggregateFunction(LogicalType geo_type) {
+	// ST_CENTROID_AGG
+	AggregateFunctionSet centroid_agg("st_centroid_agg");
+	centroid_agg.AddFunction(
+	    AggregateFunction::UnaryAggregate<CentroidState, string_t, string_t, CentroidOperation>(geo_type, geo_type));
+
+	return centroid_agg;
+}
+
 } // namespace duckdb
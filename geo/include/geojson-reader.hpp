@@ -0,0 +1,23 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// geojson-reader.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+//! read_geojson(pattern) scans the GeoJSON files matching a glob pattern: FeatureCollections, and sequences of
+//! Features or geometries (one per line, optionally behind an RS). The geometry of each feature becomes a GEOGRAPHY
+//! column and its properties typed columns, their types guessed from the first features. The files are read in
+//! parallel, the large line-delimited ones in chunks, and the properties that are not selected are skipped unparsed.
+struct ReadGeoJSONFunction {
+	static TableFunction GetFunction();
+};
+
+} // namespace duckdb
@@ -11,9 +11,37 @@
 #include "duckdb/common/common.hpp"
 #include "duckdb/common/types.hpp"
 #include "liblwgeom/liblwgeom_internal.hpp"
+#include "liblwgeom/lwinline.hpp"
 
 namespace duckdb {
 
+class Vector;
+class CircTreeGeomCache;
+class PrepGeomCache;
+
+//! Serves the liblwgeom allocations of one chunk from the per-thread arena, if enabled, and releases them on exit
+struct LWArenaScope {
+	explicit LWArenaScope(bool enabled) {
+		lwarena_begin(enabled);
+	}
+	~LWArenaScope() {
+		lwarena_end();
+	}
+};
+
+//! Writes the geographies of one chunk with the box header in front of their WKB, if enabled, and restores the
+//! previous state of the thread on exit
+struct WKBHeaderScope {
+	explicit WKBHeaderScope(bool enabled) : previous(lwgeom_wkb_header_enable(enabled)) {
+	}
+	~WKBHeaderScope() {
+		lwgeom_wkb_header_enable(previous);
+	}
+
+private:
+	int previous;
+};
+
 enum class DataFormatType : uint8_t { FORMAT_VALUE_TYPE_WKB, FORMAT_VALUE_TYPE_WKT, FORMAT_VALUE_TYPE_GEOJSON };
 
 //! The Geometry class is a static class that holds helper functions for the Geometry type.
@@ -26,32 +54,57 @@ public:
 	static string ToString(string_t geometry, DataFormatType ftype = DataFormatType::FORMAT_VALUE_TYPE_WKB);
 
 	static GSERIALIZED *GetGserialized(string_t geom);
-
-	//! Convert a string to a geometry. This function should ONLY be called after calling GetGeometrySize, since it does
-	//! NOT perform data validation.
-	static void ToGeometry(GSERIALIZED *gser, data_ptr_t output);
+	//! Decode a geometry into an LWGEOM, with its own copy of the coordinates
+	static LWGEOM *GetLWGeom(const string_t &geom);
+	//! Read the planar 2D box and the SRID of a geometry straight from the blob, false if it is empty
+	static bool GetBoundingBox(const string_t &geom, GBOX &box, int32_t &srid);
+	//! The planar 2D box of a range of the coordinates of a line or a ring, false if it is empty
+	static bool GetBoundingBox(const double *x, const double *y, const list_entry_t &points, GBOX &box);
+	//! Read the box of a geometry only when it is known without walking the coordinates: from the box header of the
+	//! blob, rounded outwards to floats, or from a point. False otherwise or if it is empty
+	static bool GetFastBoundingBox(const string_t &geom, GBOX &box, int32_t &srid);
+	//! Read the box header in front of the WKB of a blob, false if it has none
+	static bool GetHeader(const string_t &geom, WKB_HEADER &header);
+	//! Read a point straight from its little-endian WKB, inlined into the loops over a chunk. False when the blob
+	//! isn't a lone non-empty point in that layout and has to go through the parser
+	static bool GetPoint(const string_t &geom, POINT2D &pt, int32_t &srid) {
+		return lwgeom_wkb_point2d((const uint8_t *)geom.GetDataUnsafe(), geom.GetSize(), &pt, &srid) == LW_SUCCESS;
+	}
+
+	//! Serialize a geometry as WKB straight into the string heap of the result vector
+	static string_t ToWKB(Vector &result, GSERIALIZED *gser);
+	static string_t ToWKB(Vector &result, const LWGEOM *lwgeom);
+	//! Write a 2D or 3D point as WKB without building an LWGEOM
+	static string_t ToWKB(Vector &result, const POINT4D &pt, bool has_z);
+	//! Write a 2D line or polygon as WKB, box header included, in one pass over the coordinates of its points. x and
+	//! y hold the coordinates, the entries are the ranges of the line or of each ring in them
+	static string_t ToWKB(Vector &result, const double *x, const double *y, const list_entry_t &line);
+	static string_t ToWKB(Vector &result, const double *x, const double *y, const vector<list_entry_t> &rings);
 	//! Convert a string object to a geometry
 	static string ToGeometry(GSERIALIZED *gser);
 	static string ToGeometry(string_t text);
 
 	static GSERIALIZED *ToGserialized(string_t str);
-
-	static idx_t GetGeometrySize(GSERIALIZED *gser);
+	//! Parse a WKT, hex WKB or GeoJSON string into an LWGEOM, NULL if it can't be parsed
+	static LWGEOM *ToLWGeom(string_t str);
 
 	static void DestroyGeometry(GSERIALIZED *gser);
-
-	static data_ptr_t GetBase(GSERIALIZED *gser);
+	static void DestroyLWGeom(LWGEOM *lwgeom);
 
 	static GSERIALIZED *MakePoint(double x, double y);
 	static GSERIALIZED *MakePoint(double x, double y, double z);
 	static GSERIALIZED *MakeLine(GSERIALIZED *g1, GSERIALIZED *g2);
 	static GSERIALIZED *MakeLineGArray(GSERIALIZED *gserArray[], int nelems);
 	static GSERIALIZED *MakePolygon(GSERIALIZED *geom, GSERIALIZED *gserArray[] = {}, int nelems = 0);
+	//! Build a 2D line or polygon straight from the coordinates of its points, without going through WKB
+	static LWGEOM *MakeLine(const double *x, const double *y, const list_entry_t &line);
+	static LWGEOM *MakePolygon(const double *x, const double *y, const vector<list_entry_t> &rings);
 
 	static lwvarlena_t *AsBinary(GSERIALIZED *gser, string text = "");
 	static std::string AsText(GSERIALIZED *gser, int max_digits = OUT_DEFAULT_DECIMAL_DIGITS);
 	static lwvarlena_t *AsGeoJson(GSERIALIZED *gser, size_t m_dec_digits = OUT_DEFAULT_DECIMAL_DIGITS);
 	static lwvarlena_t *GeoHash(GSERIALIZED *gser, size_t m_chars = 0);
+	static std::string GeoHash(const POINT2D &pt, int m_chars = 0);
 
 	static GSERIALIZED *GeomFromGeoJson(string_t json);
 	static GSERIALIZED *FromText(char *text);
@@ -67,6 +120,8 @@ public:
 	static GSERIALIZED *GeometryUnionGArray(GSERIALIZED *gserArray[], int nelems);
 	static GSERIALIZED *GeometryIntersection(GSERIALIZED *geom1, GSERIALIZED *geom2);
 	static GSERIALIZED *GeometrySimplify(GSERIALIZED *geom, double dist);
+	//! Simplify a line or polygon in place, a collapsed one is left empty
+	static void GeometrySimplify(LWGEOM *geom, double dist);
 	static GSERIALIZED *Centroid(GSERIALIZED *g);
 	static GSERIALIZED *Centroid(GSERIALIZED *g, bool use_spheroid);
 	static GSERIALIZED *Convexhull(GSERIALIZED *g);
@@ -74,48 +129,74 @@ public:
 	static GSERIALIZED *GeometryBuffer(GSERIALIZED *geom, double radius);
 	static GSERIALIZED *GeometryBufferText(GSERIALIZED *geom, double radius, string styles_text);
 
-	static bool GeometryEquals(GSERIALIZED *geom1, GSERIALIZED *geom2);
-	static bool GeometryContains(GSERIALIZED *geom1, GSERIALIZED *geom2);
-	static bool GeometryTouches(GSERIALIZED *geom1, GSERIALIZED *geom2);
-	static bool GeometryWithin(GSERIALIZED *geom1, GSERIALIZED *geom2);
-	static bool GeometryIntersects(GSERIALIZED *geom1, GSERIALIZED *geom2);
-	static bool GeometryCovers(GSERIALIZED *geom1, GSERIALIZED *geom2);
-	static bool GeometryCoveredby(GSERIALIZED *geom1, GSERIALIZED *geom2);
-	static bool GeometryDisjoint(GSERIALIZED *geom1, GSERIALIZED *geom2);
-	static bool GeometryDWithin(GSERIALIZED *geom1, GSERIALIZED *geom2, double distance);
-
-	static double GeometryArea(GSERIALIZED *geom);
-	static double GeometryArea(GSERIALIZED *geom, bool use_spheroid);
+	static bool GeometryEquals(LWGEOM *geom1, LWGEOM *geom2);
+	static bool GeometryContains(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache = nullptr);
+	static bool GeometryTouches(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache = nullptr);
+	static bool GeometryWithin(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache = nullptr);
+	static bool GeometryIntersects(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache = nullptr);
+	static bool GeometryCovers(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache = nullptr);
+	static bool GeometryCoveredby(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache = nullptr);
+	static bool GeometryDisjoint(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache = nullptr);
+	//! Locate a point against a 2D polygon given by the coordinates of its rings, reading them in place: LW_INSIDE,
+	//! LW_BOUNDARY or LW_OUTSIDE
+	static int PointInPolygon(const double *x, const double *y, const vector<list_entry_t> &rings,
+	                          const POINT2D &pt);
+	static bool GeometryDWithin(LWGEOM *geom1, LWGEOM *geom2, double distance);
+	//! Geography ST_DWITHIN in meters, cache holds the circle tree of a repeated argument if given
+	static bool GeometryDWithin(LWGEOM *geom1, LWGEOM *geom2, double distance, bool use_spheroid,
+	                            const CircTreeGeomCache *cache = nullptr);
+	//! Geography ST_DWITHIN of two points of the same SRID, without decoding them
+	static bool GeometryDWithin(const POINT2D &p1, const POINT2D &p2, int32_t srid, double distance,
+	                            bool use_spheroid);
+
+	static double GeometryArea(LWGEOM *geom);
+	static double GeometryArea(LWGEOM *geom, bool use_spheroid);
 	static double GeometryAngle(GSERIALIZED *geom1, GSERIALIZED *geom2);
 	static double GeometryAngle(std::vector<GSERIALIZED *> geom_vec);
-	static double GeometryPerimeter(GSERIALIZED *geom);
-	static double GeometryPerimeter(GSERIALIZED *geom, bool use_spheroid);
-	static double GeometryAzimuth(GSERIALIZED *geom1, GSERIALIZED *geom2);
-	static double GeometryLength(GSERIALIZED *geom);
-	static double GeometryLength(GSERIALIZED *geom, bool use_spheroid);
+	static double GeometryPerimeter(LWGEOM *geom);
+	static double GeometryPerimeter(LWGEOM *geom, bool use_spheroid);
+	static double GeometryAzimuth(LWGEOM *geom1, LWGEOM *geom2);
+	static double GeometryAzimuth(const POINT2D &p1, const POINT2D &p2, int32_t srid);
+	static double GeometryLength(LWGEOM *geom);
+	static double GeometryLength(LWGEOM *geom, bool use_spheroid);
+	//! Geography length of a 2D line given by the coordinates of its points, without building it
+	static double GeometryLength(const double *x, const double *y, const list_entry_t &line, bool use_spheroid);
 	static GSERIALIZED *GeometryBoundingBox(GSERIALIZED *geom);
-	static double Distance(GSERIALIZED *g1, GSERIALIZED *g2);
-	static double Distance(GSERIALIZED *g1, GSERIALIZED *g2, bool use_spheroid);
-	static double MaxDistance(GSERIALIZED *g1, GSERIALIZED *g2, bool use_spheroid = true);
+	static double Distance(LWGEOM *g1, LWGEOM *g2);
+	//! Geography distance, cache holds the circle tree of a repeated argument if given
+	static double Distance(LWGEOM *g1, LWGEOM *g2, bool use_spheroid, const CircTreeGeomCache *cache = nullptr);
+	//! Geography distance of two non-empty points of the same SRID, without decoding them
+	static double Distance(const POINT2D &p1, const POINT2D &p2, int32_t srid, bool use_spheroid);
+	static double MaxDistance(LWGEOM *g1, LWGEOM *g2, bool use_spheroid = true,
+	                          const CircTreeGeomCache *cache = nullptr);
 	static GSERIALIZED *GeometryExtent(GSERIALIZED *gserArray[], int nelems);
+	//! The point, line or polygon covering a 2D box, as ST_Envelope returns it
+	static LWGEOM *GeometryEnvelope(const GBOX &box, int32_t srid);
 
 	static std::vector<int> GeometryClusterDBScan(GSERIALIZED *gserArray[], int nelems, double tolerance,
-	                                              int minpoints);
-
-	static int LWGEOM_dimension(GSERIALIZED *geom);
+	                                              int minpoints, idx_t max_threads);
+	//! DBSCAN over geometries owned by the caller on up to max_threads threads, -1 marks noise
+	static std::vector<int> GeometryClusterDBScan(LWGEOM *geoms[], int nelems, double tolerance, int minpoints,
+	                                              idx_t max_threads);
+	//! k-means on the sphere over geometries owned by the caller, -1 marks an empty geometry
+	static std::vector<int> GeometryClusterKMeans(LWGEOM *geoms[], int nelems, int k);
+
+	static int LWGEOM_dimension(LWGEOM *geom);
 	static std::vector<GSERIALIZED *> LWGEOM_dump(GSERIALIZED *geom);
 	static GSERIALIZED *LWGEOM_endpoint_linestring(GSERIALIZED *geom);
-	static std::string Geometrytype(GSERIALIZED *geom);
-	static bool IsClosed(GSERIALIZED *geom);
-	static bool IsCollection(GSERIALIZED *geom);
-	static bool IsEmpty(GSERIALIZED *geom);
-	static bool IsRing(GSERIALIZED *geom);
-	static int NPoints(GSERIALIZED *geom);
-	static int NumGeometries(GSERIALIZED *geom);
-	static int NumPoints(GSERIALIZED *geom);
+	static std::string Geometrytype(LWGEOM *geom);
+	static bool IsClosed(LWGEOM *geom);
+	static bool IsCollection(LWGEOM *geom);
+	static bool IsEmpty(LWGEOM *geom);
+	static bool IsRing(LWGEOM *geom);
+	static int NPoints(LWGEOM *geom);
+	static int NumGeometries(LWGEOM *geom);
+	static int NumPoints(LWGEOM *geom);
 	static GSERIALIZED *PointN(GSERIALIZED *geom, int index);
 	static GSERIALIZED *StartPoint(GSERIALIZED *geom);
-	static double XPoint(GSERIALIZED *geom);
-	static double YPoint(GSERIALIZED *geom);
+	static double XPoint(LWGEOM *geom);
+	static double YPoint(LWGEOM *geom);
+	//! The coordinates of a point, false if it is empty. Throws for anything but a point
+	static bool PointCoords(LWGEOM *geom, POINT4D &pt);
 };
 } // namespace duckdb
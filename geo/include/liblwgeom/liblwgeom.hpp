@@ -551,6 +551,12 @@ extern POINTARRAY *ptarray_construct_copy_data(char hasz, char hasm, uint32_t np
  */
 extern POINTARRAY *ptarray_construct_reference_data(char hasz, char hasm, uint32_t npoints, uint8_t *ptlist);
 
+/**
+ * Construct a new 2D #POINTARRAY, <em>copying</em> in the coordinates from
+ * separate x and y arrays
+ */
+extern POINTARRAY *ptarray_construct_coords(const double *x, const double *y, uint32_t npoints);
+
 /**
  * Create a new #POINTARRAY with no points. Allocate enough storage
  * to hold maxpoints vertices before having to reallocate the storage
@@ -858,6 +864,7 @@ extern double lwpoint_get_x(const LWPOINT *point);
 extern double lwpoint_get_y(const LWPOINT *point);
 
 unsigned int geohash_point_as_int(POINT2D *pt);
+uint64_t hilbert_point_as_int(const POINT2D *pt, const GBOX *bounds);
 
 /**
  * Create an LWGEOM object from a GeoJSON representation
@@ -883,6 +890,13 @@ extern void spheroid_init(SPHEROID *s, double a, double b);
 extern double lwgeom_distance_spheroid(const LWGEOM *lwgeom1, const LWGEOM *lwgeom2, const SPHEROID *spheroid,
                                        double tolerance);
 
+/**
+ * Partition the geometries in at most k clusters with k-means on the unit
+ * sphere. Returns the cluster of each geometry, numbered in the order of
+ * their first geometry, and -1 for empty geometries.
+ */
+extern int *lwgeom_cluster_kmeans_sphere(const LWGEOM **geoms, uint32_t n, uint32_t k);
+
 /**
  * Calculate the bearing between two points on a spheroid.
  */
@@ -915,6 +929,38 @@ typedef void (*lwfreeor)(void *mem);
 typedef void (*lwreporter)(const char *fmt, va_list ap) __attribute__((format(printf, 1, 0)));
 typedef void (*lwdebuglogger)(int level, const char *fmt, va_list ap) __attribute__((format(printf, 2, 0)));
 
+/**
+ * Install the memory handlers used by lwalloc/lwrealloc/lwfree.
+ * Passing NULL for a handler restores the malloc based default.
+ * Must be called before any geometry is allocated, since memory has
+ * to be released by the handler that allocated it.
+ */
+extern void lwgeom_set_allocators(lwallocator allocator, lwreallocator reallocator, lwfreeor freeor);
+
+/**
+ * Per-thread arena allocator, to be installed with lwgeom_set_allocators.
+ *
+ * While a thread is between lwarena_begin() and lwarena_end(), small
+ * allocations are bumped out of thread-local blocks, lwfree() of them is a
+ * no-op and lwarena_end() releases them all at once. Nothing allocated in
+ * the scope may be used after it ends, but it may be freed from any thread.
+ * Scopes nest; only the outermost one decides whether the arena is used and
+ * resets it. Outside of a scope, or when disabled, allocations go to malloc.
+ */
+extern void *lwarena_alloc(size_t size);
+extern void *lwarena_realloc(void *mem, size_t size);
+extern void lwarena_free(void *mem);
+extern void lwarena_begin(int enabled);
+extern void lwarena_end(void);
+
+/**
+ * Route the allocations of the calling thread to malloc until
+ * lwarena_resume(), for data that has to outlive the current scope
+ * (caches kept across chunks). Returns the state to hand to lwarena_resume.
+ */
+extern int lwarena_pause(void);
+extern void lwarena_resume(int state);
+
 /**
  * Macro for reading the size from the GSERIALIZED size attribute.
  * Cribbed from PgSQL, top 30 bits are size. Use VARSIZE() when working
@@ -988,6 +1034,31 @@ typedef struct struct_lwgeom_parser_result {
 #define WKB_NO_NPOINTS 0x40 /* Internal use only */
 #define WKB_NO_SRID    0x80 /* Internal use only */
 
+/*
+** Optional box header in front of the extended WKB of a stored geography
+*/
+#define WKB_HEADER_MAGIC 0x47 /* Never a WKB byte order mark (0 or 1) */
+#define WKB_HEADER_SIZE  24
+
+/**
+ * The header a stored geography may carry in front of its WKB: the planar
+ * box rounded outwards to floats (like the box of GSERIALIZED v2), the type,
+ * the Z/M flags and the number of points, so a box test or a point count
+ * doesn't have to walk the coordinates. Written in native byte order, its
+ * size keeps the doubles of the WKB after it as aligned as they were.
+ */
+typedef struct {
+	uint8_t magic;
+	uint8_t type;
+	uint8_t flags;
+	uint8_t padding;
+	uint32_t npoints;
+	float xmin;
+	float xmax;
+	float ymin;
+	float ymax;
+} WKB_HEADER;
+
 #define WKT_ISO      0x01
 #define WKT_SFSQL    0x02
 #define WKT_EXTENDED 0x04
@@ -1208,6 +1279,33 @@ extern int ptarray_calculate_gbox_cartesian(const POINTARRAY *pa, GBOX *gbox);
  */
 extern LWGEOM *lwgeom_from_wkb(const uint8_t *wkb, const size_t wkb_size, const char check);
 
+/**
+ * @param wkb_size length of WKB byte buffer
+ * @param wkb WKB byte buffer
+ * @param gbox receives the planar 2D box, read without building the geometry
+ * @param srid receives the SRID of the geometry, may be NULL
+ * @return LW_FAILURE for an empty geometry
+ */
+extern int lwgeom_calculate_gbox_wkb(const uint8_t *wkb, const size_t wkb_size, GBOX *gbox, int32_t *srid);
+
+/**
+ * @param wkb_size length of WKB byte buffer
+ * @param wkb WKB byte buffer, with or without box header
+ * @param header receives the box header
+ * @return LW_FAILURE when the WKB has no box header
+ */
+extern int lwgeom_wkb_header_read(const uint8_t *wkb, const size_t wkb_size, WKB_HEADER *header);
+
+/**
+ * @param wkb_size length of WKB byte buffer
+ * @param wkb WKB byte buffer
+ * @param gbox receives the planar 2D box of the box header, or of a point
+ * @param srid receives the SRID of the geometry, may be NULL
+ * @return LW_FAILURE when the box can't be had without walking the coordinates,
+ *         or for an empty geometry
+ */
+extern int lwgeom_fast_gbox_wkb(const uint8_t *wkb, const size_t wkb_size, GBOX *gbox, int32_t *srid);
+
 /**
  * Create a new gbox with the dimensionality indicated by the flags. Caller
  * is responsible for freeing.
@@ -1326,6 +1424,45 @@ extern uint32_t lwtype_get_collectiontype(uint8_t type);
  */
 extern uint8_t *lwgeom_to_wkb_buffer(const LWGEOM *geom, uint8_t variant);
 extern size_t lwgeom_to_wkb_size(const LWGEOM *geom, uint8_t variant);
+/**
+ * @param geom geometry to convert to WKB
+ * @param variant output format to use
+ * @param buffer output buffer of at least lwgeom_to_wkb_size() bytes
+ * @return number of bytes written
+ */
+extern ptrdiff_t lwgeom_to_wkb_write_buf(const LWGEOM *geom, uint8_t variant, uint8_t *buffer);
+
+/**
+ * Turn the box header of the geographies written by the calling thread on or off. It is off until turned on.
+ * @param enabled whether lwgeom_wkb_header_size() gives the geometries a header
+ * @return the previous state
+ */
+extern int lwgeom_wkb_header_enable(int enabled);
+/**
+ * @return whether the calling thread writes the box header
+ */
+extern int lwgeom_wkb_header_enabled(void);
+/**
+ * @param geom geometry to write the box header of
+ * @return size of its box header, 0 when it gets none or the thread writes no headers
+ */
+extern size_t lwgeom_wkb_header_size(const LWGEOM *geom);
+/**
+ * @param geom geometry to write the box header of
+ * @param buffer output buffer of at least lwgeom_wkb_header_size() bytes
+ * @return the position after the header
+ */
+extern uint8_t *lwgeom_wkb_header_write(const LWGEOM *geom, uint8_t *buffer);
+/**
+ * @param type geometry type of the WKB after the header
+ * @param flags its Z and M flags
+ * @param npoints its number of points
+ * @param box its planar box
+ * @param buffer output buffer of at least WKB_HEADER_SIZE bytes
+ * @return the position after the header
+ */
+extern uint8_t *lwgeom_wkb_header_write_gbox(uint8_t type, uint8_t flags, uint32_t npoints, const GBOX *box,
+                                             uint8_t *buffer);
 
 /* Memory management */
 extern void *lwalloc(size_t size);
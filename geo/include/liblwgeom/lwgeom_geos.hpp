@@ -44,5 +44,8 @@ GEOSGeometry *make_geos_segment(double x1, double y1, double x2, double y2);
 
 int union_dbscan(LWGEOM **geoms, uint32_t num_geoms, UNIONFIND *uf, double eps, uint32_t min_points,
                  char **is_in_cluster_ret);
+/* DBSCAN on the sphere, eps in meters. Only points are clustered in parallel, on up to max_threads threads. */
+int union_dbscan_geodetic(LWGEOM **geoms, uint32_t num_geoms, UNIONFIND *uf, double eps, uint32_t min_points,
+                          uint32_t max_threads, char **is_in_cluster_ret);
 
 } // namespace duckdb
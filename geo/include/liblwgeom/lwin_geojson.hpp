@@ -0,0 +1,97 @@
+/**********************************************************************
+ *
+ * PostGIS - Spatial Types for PostgreSQL
+ * http://postgis.net
+ *
+ * PostGIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * PostGIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PostGIS.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ *
+ * Copyright 2019 Darafei Praliaskouski <me@komzpa.net>
+ * Copyright 2013 Sandro Santilli <strk@kbt.io>
+ * Copyright 2011 Kashif Rasul <kashif.rasul@gmail.com>
+ *
+ **********************************************************************/
+
+#pragma once
+#include "liblwgeom/liblwgeom_internal.hpp"
+
+#include <string>
+
+namespace duckdb {
+
+/*
+ * The GeoJSON is read in a single pass, without building a JSON object tree:
+ * the members of the geometry objects are matched as they are met and the
+ * positions are appended straight to the point arrays of the geometry. The
+ * cursor is shared with read_geojson, which walks the features around the
+ * geometries with it.
+ */
+
+/* The nesting limit of the json-c tokener this parser replaces */
+#define GEOJSON_MAX_DEPTH 32
+
+/* A cursor over NUL-terminated JSON text */
+typedef struct {
+	const char *start; /* Start of the input, for the error offsets */
+	const char *cur;   /* Next character */
+	int depth;         /* Nesting of the objects and arrays around the cursor */
+	int hasz;          /* A position had a third ordinate */
+	std::string str;   /* Last string read */
+} geojson_parser;
+
+void geojson_parser_init(geojson_parser *p, const char *json);
+
+/* Fail with the offset of the cursor */
+void geojson_syntax_error(geojson_parser *p, const char *msg);
+
+static inline void geojson_skip_ws(geojson_parser *p) {
+	while (*p->cur == ' ' || *p->cur == '\n' || *p->cur == '\r' || *p->cur == '\t')
+		p->cur++;
+}
+
+/* Consume the next non-blank character if it is c */
+static inline int geojson_accept(geojson_parser *p, char c) {
+	geojson_skip_ws(p);
+	if (*p->cur != c)
+		return LW_FALSE;
+	p->cur++;
+	return LW_TRUE;
+}
+
+static inline void geojson_expect(geojson_parser *p, char c, const char *msg) {
+	if (!geojson_accept(p, c))
+		geojson_syntax_error(p, msg);
+}
+
+static inline void geojson_enter(geojson_parser *p) {
+	if (++p->depth > GEOJSON_MAX_DEPTH)
+		geojson_syntax_error(p, "nesting too deep");
+}
+
+/* Read the string at the cursor into p->str, decoding its escapes */
+void geojson_parse_string(geojson_parser *p);
+
+/* Read an object key and its ':' into p->str, the keys are matched case-insensitively like the json-c lookup did */
+void geojson_parse_key(geojson_parser *p);
+
+double geojson_parse_number(geojson_parser *p);
+
+/* Skip the value at the cursor, checking it is well-formed */
+void geojson_skip_value(geojson_parser *p);
+
+/* Read the geometry object at the cursor, 2D unless one of its positions has a Z, with its bbox */
+LWGEOM *geojson_parse_geometry(geojson_parser *p, char **srs);
+
+} // namespace duckdb
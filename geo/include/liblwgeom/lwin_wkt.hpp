@@ -42,17 +42,22 @@ typedef struct {
 } POINT;
 
 /*
- * Global that holds the final output geometry for the WKT parser.
+ * State of a single WKT parse. It lives on the stack of lwgeom_parse_wkt()
+ * and is handed to the scanner, the grammar actions and the builders below,
+ * so concurrent parses share nothing.
  */
-extern LWGEOM_PARSER_RESULT global_parser_result;
+typedef struct {
+	LWGEOM_PARSER_RESULT *result; /* Output geometry and error information */
+	int last_column;              /* Column just past the last scanned token */
+} WKT_PARSER_STATE;
+
 extern const char *parser_error_messages[];
 
 /*
  * Prototypes for the lexer
  */
-extern void wkt_lexer_init(char *str);
-extern void wkt_lexer_close(void);
-extern int wkt_yylex_destroy(void);
+extern void *wkt_lexer_init(WKT_PARSER_STATE *state, char *str);
+extern void wkt_lexer_close(void *scanner);
 
 /*
  * Functions called from within the bison parser to construct geometries.
@@ -61,23 +66,23 @@ int32_t wkt_lexer_read_srid(char *str);
 POINT wkt_parser_coord_2(double c1, double c2);
 POINT wkt_parser_coord_3(double c1, double c2, double c3);
 POINT wkt_parser_coord_4(double c1, double c2, double c3, double c4);
-POINTARRAY *wkt_parser_ptarray_add_coord(POINTARRAY *pa, POINT p);
-POINTARRAY *wkt_parser_ptarray_new(POINT p);
-LWGEOM *wkt_parser_point_new(POINTARRAY *pa, char *dimensionality);
-LWGEOM *wkt_parser_linestring_new(POINTARRAY *pa, char *dimensionality);
-LWGEOM *wkt_parser_circularstring_new(POINTARRAY *pa, char *dimensionality);
-LWGEOM *wkt_parser_triangle_new(POINTARRAY *pa, char *dimensionality);
-LWGEOM *wkt_parser_polygon_new(POINTARRAY *pa, char dimcheck);
-LWGEOM *wkt_parser_polygon_add_ring(LWGEOM *poly, POINTARRAY *pa, char dimcheck);
-LWGEOM *wkt_parser_polygon_finalize(LWGEOM *poly, char *dimensionality);
-LWGEOM *wkt_parser_curvepolygon_new(LWGEOM *ring);
-LWGEOM *wkt_parser_curvepolygon_add_ring(LWGEOM *poly, LWGEOM *ring);
-LWGEOM *wkt_parser_curvepolygon_finalize(LWGEOM *poly, char *dimensionality);
-LWGEOM *wkt_parser_compound_new(LWGEOM *element);
-LWGEOM *wkt_parser_compound_add_geom(LWGEOM *col, LWGEOM *geom);
-LWGEOM *wkt_parser_collection_new(LWGEOM *geom);
-LWGEOM *wkt_parser_collection_add_geom(LWGEOM *col, LWGEOM *geom);
-LWGEOM *wkt_parser_collection_finalize(int lwtype, LWGEOM *col, char *dimensionality);
-void wkt_parser_geometry_new(LWGEOM *geom, int32_t srid);
+POINTARRAY *wkt_parser_ptarray_add_coord(WKT_PARSER_STATE *state, POINTARRAY *pa, POINT p);
+POINTARRAY *wkt_parser_ptarray_new(WKT_PARSER_STATE *state, POINT p);
+LWGEOM *wkt_parser_point_new(WKT_PARSER_STATE *state, POINTARRAY *pa, char *dimensionality);
+LWGEOM *wkt_parser_linestring_new(WKT_PARSER_STATE *state, POINTARRAY *pa, char *dimensionality);
+LWGEOM *wkt_parser_circularstring_new(WKT_PARSER_STATE *state, POINTARRAY *pa, char *dimensionality);
+LWGEOM *wkt_parser_triangle_new(WKT_PARSER_STATE *state, POINTARRAY *pa, char *dimensionality);
+LWGEOM *wkt_parser_polygon_new(WKT_PARSER_STATE *state, POINTARRAY *pa, char dimcheck);
+LWGEOM *wkt_parser_polygon_add_ring(WKT_PARSER_STATE *state, LWGEOM *poly, POINTARRAY *pa, char dimcheck);
+LWGEOM *wkt_parser_polygon_finalize(WKT_PARSER_STATE *state, LWGEOM *poly, char *dimensionality);
+LWGEOM *wkt_parser_curvepolygon_new(WKT_PARSER_STATE *state, LWGEOM *ring);
+LWGEOM *wkt_parser_curvepolygon_add_ring(WKT_PARSER_STATE *state, LWGEOM *poly, LWGEOM *ring);
+LWGEOM *wkt_parser_curvepolygon_finalize(WKT_PARSER_STATE *state, LWGEOM *poly, char *dimensionality);
+LWGEOM *wkt_parser_compound_new(WKT_PARSER_STATE *state, LWGEOM *element);
+LWGEOM *wkt_parser_compound_add_geom(WKT_PARSER_STATE *state, LWGEOM *col, LWGEOM *geom);
+LWGEOM *wkt_parser_collection_new(WKT_PARSER_STATE *state, LWGEOM *geom);
+LWGEOM *wkt_parser_collection_add_geom(WKT_PARSER_STATE *state, LWGEOM *col, LWGEOM *geom);
+LWGEOM *wkt_parser_collection_finalize(WKT_PARSER_STATE *state, int lwtype, LWGEOM *col, char *dimensionality);
+void wkt_parser_geometry_new(WKT_PARSER_STATE *state, LWGEOM *geom, int32_t srid);
 
 } // namespace duckdb
@@ -31,6 +31,9 @@
 #include "duckdb.hpp"
 #include "liblwgeom/liblwgeom.hpp"
 
+#include <cmath>
+#include <cstring>
+
 namespace duckdb {
 
 inline static double distance2d_sqr_pt_pt(const POINT2D *p1, const POINT2D *p2) {
@@ -188,4 +191,115 @@ static inline uint32_t lwgeom_get_type(const LWGEOM *geom) {
 	return geom->type;
 }
 
+/**
+ * X and Y of a point in native little-endian WKB or EWKB, read with direct
+ * loads instead of through the WKB parser. Only a lone point of exactly the
+ * size of its dimensions (21 bytes in 2D, 29 in 3D, 37 in 4D, 4 more with an
+ * SRID) is taken, the SRID is returned through srid when given.
+ * Returns LW_FAILURE for anything else and for an empty point, which are left
+ * to lwgeom_from_wkb.
+ */
+static inline int lwgeom_wkb_point2d(const uint8_t *wkb, size_t wkb_size, POINT2D *pt, int32_t *srid) {
+	uint32_t wkb_type;
+	int32_t wkb_srid = SRID_UNKNOWN;
+	size_t offset = 1 + sizeof(uint32_t);
+	size_t ndims;
+
+	if (IS_BIG_ENDIAN || !wkb || wkb_size < offset + 2 * sizeof(double) || wkb[0] != 1)
+		return LW_FAILURE;
+
+	memcpy(&wkb_type, wkb + 1, sizeof(uint32_t));
+	switch (wkb_type & ~WKBSRIDFLAG) {
+	case 1:
+		ndims = 2;
+		break;
+	case 1 | WKBZOFFSET:
+	case 1 | WKBMOFFSET:
+	case 1001:
+	case 2001:
+		ndims = 3;
+		break;
+	case 1 | WKBZOFFSET | WKBMOFFSET:
+	case 3001:
+		ndims = 4;
+		break;
+	default:
+		return LW_FAILURE;
+	}
+
+	if (wkb_type & WKBSRIDFLAG) {
+		memcpy(&wkb_srid, wkb + offset, sizeof(int32_t));
+		offset += sizeof(int32_t);
+	}
+	if (wkb_size != offset + ndims * sizeof(double))
+		return LW_FAILURE;
+
+	memcpy(&pt->x, wkb + offset, sizeof(double));
+	memcpy(&pt->y, wkb + offset + sizeof(double), sizeof(double));
+	/* POINT(NaN NaN) is POINT EMPTY */
+	if (std::isnan(pt->x) && std::isnan(pt->y))
+		return LW_FAILURE;
+	if (srid)
+		*srid = wkb_type & WKBSRIDFLAG ? clamp_srid(wkb_srid) : SRID_UNKNOWN;
+	return LW_SUCCESS;
+}
+
+/**
+ * Size of the WKB of a 2D or 3D point written by lwgeom_wkb_point_write.
+ */
+static inline size_t lwgeom_wkb_point_size(int hasz) {
+	return 1 + sizeof(uint32_t) + (hasz ? 3 : 2) * sizeof(double);
+}
+
+/**
+ * Write the native byte order mark and the type of an extended WKB geometry
+ * without SRID, return the position after them.
+ */
+static inline uint8_t *lwgeom_wkb_type_write(uint32_t wkb_type, uint8_t *buf) {
+	buf[0] = IS_BIG_ENDIAN ? 0 : 1;
+	memcpy(buf + 1, &wkb_type, sizeof(uint32_t));
+	return buf + 1 + sizeof(uint32_t);
+}
+
+/**
+ * Write a 2D or 3D point without SRID as the native-endian extended WKB
+ * that lwgeom_to_wkb_buf gives an LWPOINT, without building one.
+ */
+static inline void lwgeom_wkb_point_write(const POINT4D *pt, int hasz, uint8_t *buf) {
+	buf = lwgeom_wkb_type_write(hasz ? (1 | WKBZOFFSET) : 1, buf);
+	memcpy(buf, &pt->x, sizeof(double));
+	memcpy(buf + sizeof(double), &pt->y, sizeof(double));
+	if (hasz)
+		memcpy(buf + 2 * sizeof(double), &pt->z, sizeof(double));
+}
+
+/**
+ * Write the count and the interleaved coordinates of a 2D point array given
+ * as separate x and y arrays, the way lwgeom_to_wkb_buf writes a POINTARRAY,
+ * growing box by them when given. Return the position after the last one.
+ */
+static inline uint8_t *lwgeom_wkb_coords_write(const double *x, const double *y, uint32_t npoints, GBOX *box,
+                                               uint8_t *buf) {
+	uint32_t i;
+
+	memcpy(buf, &npoints, sizeof(uint32_t));
+	buf += sizeof(uint32_t);
+	for (i = 0; i < npoints; i++) {
+		memcpy(buf, x + i, sizeof(double));
+		memcpy(buf + sizeof(double), y + i, sizeof(double));
+		buf += 2 * sizeof(double);
+		if (!box)
+			continue;
+		if (x[i] < box->xmin)
+			box->xmin = x[i];
+		if (x[i] > box->xmax)
+			box->xmax = x[i];
+		if (y[i] < box->ymin)
+			box->ymin = y[i];
+		if (y[i] > box->ymax)
+			box->ymax = y[i];
+	}
+	return buf;
+}
+
 } // namespace duckdb
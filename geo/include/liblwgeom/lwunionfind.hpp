@@ -58,6 +58,17 @@ uint32_t *UF_ordered_by_cluster(UNIONFIND *uf);
  * */
 uint32_t *UF_get_collapsed_cluster_ids(UNIONFIND *uf, const char *is_in_cluster);
 
+/* Identify the cluster id of a component id while other threads merge clusters */
+uint32_t UF_find_concurrent(UNIONFIND *uf, uint32_t i);
+
+/* Merge the clusters of two component ids while other threads merge clusters.
+ * A cluster is always linked below the one with the smaller id, so the result
+ * does not depend on the order of the merges. */
+void UF_union_concurrent(UNIONFIND *uf, uint32_t i, uint32_t j);
+
+/* Restore the cluster sizes and count once all concurrent merges are done */
+void UF_finish_concurrent(UNIONFIND *uf);
+
 #endif /* !defined _LWUNIONFIND  */
 
 } // namespace duckdb
@@ -0,0 +1,66 @@
+/**********************************************************************
+ *
+ * PostGIS - Spatial Types for PostgreSQL
+ *
+ * Copyright (C) 2012 Sandro Santilli <strk@kbt.io>
+ * Copyright (C) 2010 Paul Ramsey <pramsey@cleverelephant.ca>
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU General Public Licence. See the COPYING file.
+ *
+ **********************************************************************/
+
+#pragma once
+#include "duckdb.hpp"
+#include "liblwgeom/liblwgeom.hpp"
+
+namespace duckdb {
+
+/*
+ * Generic cache for an argument that repeats from one call to the next,
+ * after the GeomCache of PostGIS. The first time the same WKB is seen twice
+ * in a row in one argument position it is decoded and handed to BuildIndex(),
+ * and both are kept until a different value shows up. A constant argument is
+ * therefore decoded and indexed once per expression, and only the varying
+ * side is read per row. When the caller knows from the plan that an argument
+ * is constant it can say so with SetConstantArg(), and that argument is then
+ * indexed on the first call without comparing any bytes afterwards.
+ *
+ * Derived classes must call Clear() from their destructor, as FreeIndex()
+ * cannot be reached from the base destructor.
+ */
+class GeomCache {
+public:
+	GeomCache();
+	virtual ~GeomCache();
+
+	//! Look up the pair of arguments, returns the argument (1 or 2) served from the cache or 0
+	int Lookup(const uint8_t *wkb1, size_t size1, const uint8_t *wkb2, size_t size2);
+	//! Declare argument 1 or 2 to be the same value for every call
+	void SetConstantArg(int arg) {
+		constant_arg = arg;
+	}
+
+	//! The argument the cached geometry belongs to, 0 when nothing is cached
+	int argnum;
+	LWGEOM *lwgeom;
+
+protected:
+	//! Index lwgeom, returns false when there is nothing worth keeping
+	virtual bool BuildIndex() = 0;
+	//! Release whatever BuildIndex() left behind, also after a partial build
+	virtual void FreeIndex() = 0;
+
+	void Clear();
+
+private:
+	void Build(int arg, const std::string &wkb);
+
+	int constant_arg;
+	bool constant_built;
+	//! Bytes of the previous arguments, to detect a repeated value
+	std::string arg1;
+	std::string arg2;
+};
+
+} // namespace duckdb
@@ -40,4 +40,9 @@ void gserialized_error_if_srid_mismatch(const GSERIALIZED *g1, const GSERIALIZED
  */
 void gserialized_error_if_srid_mismatch_reference(const GSERIALIZED *g1, const int32_t srid, const char *funcname);
 
+/**
+ * Compare SRIDs of two LWGEOMs and print informative error message if they differ.
+ */
+void lwgeom_error_if_srid_mismatch(const LWGEOM *g1, const LWGEOM *g2, const char *funcname);
+
 } // namespace duckdb
@@ -29,12 +29,17 @@ static const std::vector<ScalarFunctionSet> GetMeasureScalarFunctions(LogicalTyp
 	area.AddFunction(ScalarFunction({geo_type}, LogicalType::DOUBLE, GeoFunctions::GeometryAreaFunction));
 	area.AddFunction(
 	    ScalarFunction({geo_type, LogicalType::BOOLEAN}, LogicalType::DOUBLE, GeoFunctions::GeometryAreaFunction));
+	area.AddFunction(ScalarFunction({GeoTypes::Polygon2D()}, LogicalType::DOUBLE, GeoFunctions::PolygonAreaFunction));
+	area.AddFunction(ScalarFunction({GeoTypes::Polygon2D(), LogicalType::BOOLEAN}, LogicalType::DOUBLE,
+	                                GeoFunctions::PolygonAreaFunction));
 	func_set.push_back(area);
 
 	// ST_AZIMUTH
 	ScalarFunctionSet azimuth("st_azimuth");
 	azimuth.AddFunction(
 	    ScalarFunction({geo_type, geo_type}, LogicalType::DOUBLE, GeoFunctions::GeometryAzimuthFunction));
+	azimuth.AddFunction(ScalarFunction({GeoTypes::Point2D(), GeoTypes::Point2D()}, LogicalType::DOUBLE,
+	                                   GeoFunctions::PointAzimuthFunction));
 	func_set.push_back(azimuth);
 
 	// ST_BOUNDINGBOX (ALIAS: ST_ENVELOPE)
@@ -42,8 +47,16 @@ static const std::vector<ScalarFunctionSet> GetMeasureScalarFunctions(LogicalTyp
 	ScalarFunctionSet envelope("st_envelope");
 	auto boundingboxUnaryFunc = ScalarFunction({geo_type}, geo_type, GeoFunctions::GeometryBoundingBoxFunction);
 
+	auto lineBoundingboxFunc = ScalarFunction({GeoTypes::LineString2D()}, geo_type, GeoFunctions::LineEnvelopeFunction);
+	auto polygonBoundingboxFunc =
+	    ScalarFunction({GeoTypes::Polygon2D()}, geo_type, GeoFunctions::PolygonEnvelopeFunction);
+
 	boundingbox.AddFunction(boundingboxUnaryFunc);
+	boundingbox.AddFunction(lineBoundingboxFunc);
+	boundingbox.AddFunction(polygonBoundingboxFunc);
 	envelope.AddFunction(boundingboxUnaryFunc);
+	envelope.AddFunction(lineBoundingboxFunc);
+	envelope.AddFunction(polygonBoundingboxFunc);
 	func_set.push_back(boundingbox);
 	func_set.push_back(envelope);
 
@@ -54,10 +67,16 @@ static const std::vector<ScalarFunctionSet> GetMeasureScalarFunctions(LogicalTyp
 
 	// ST_DISTANCE
 	ScalarFunctionSet distance("st_distance");
-	distance.AddFunction(
-	    ScalarFunction({geo_type, geo_type}, LogicalType::DOUBLE, GeoFunctions::GeometryDistanceFunction));
+	distance.AddFunction(ScalarFunction({geo_type, geo_type}, LogicalType::DOUBLE,
+	                                    GeoFunctions::GeometryDistanceFunction, nullptr, nullptr, nullptr,
+	                                    GeoFunctions::InitCircTreeCache));
 	distance.AddFunction(ScalarFunction({geo_type, geo_type, LogicalType::BOOLEAN}, LogicalType::DOUBLE,
-	                                    GeoFunctions::GeometryDistanceFunction));
+	                                    GeoFunctions::GeometryDistanceFunction, nullptr, nullptr, nullptr,
+	                                    GeoFunctions::InitCircTreeCache));
+	distance.AddFunction(ScalarFunction({GeoTypes::Point2D(), GeoTypes::Point2D()}, LogicalType::DOUBLE,
+	                                    GeoFunctions::PointDistanceFunction));
+	distance.AddFunction(ScalarFunction({GeoTypes::Point2D(), GeoTypes::Point2D(), LogicalType::BOOLEAN},
+	                                    LogicalType::DOUBLE, GeoFunctions::PointDistanceFunction));
 	func_set.push_back(distance);
 
 	// ST_LENGTH
@@ -65,14 +84,20 @@ static const std::vector<ScalarFunctionSet> GetMeasureScalarFunctions(LogicalTyp
 	length.AddFunction(ScalarFunction({geo_type}, LogicalType::DOUBLE, GeoFunctions::GeometryLengthFunction));
 	length.AddFunction(
 	    ScalarFunction({geo_type, LogicalType::BOOLEAN}, LogicalType::DOUBLE, GeoFunctions::GeometryLengthFunction));
+	length.AddFunction(
+	    ScalarFunction({GeoTypes::LineString2D()}, LogicalType::DOUBLE, GeoFunctions::LineLengthFunction));
+	length.AddFunction(ScalarFunction({GeoTypes::LineString2D(), LogicalType::BOOLEAN}, LogicalType::DOUBLE,
+	                                  GeoFunctions::LineLengthFunction));
 	func_set.push_back(length);
 
 	// ST_MAXDISTANCE
 	ScalarFunctionSet maxdistance("st_maxdistance");
-	maxdistance.AddFunction(
-	    ScalarFunction({geo_type, geo_type}, LogicalType::DOUBLE, GeoFunctions::GeometryMaxDistanceFunction));
+	maxdistance.AddFunction(ScalarFunction({geo_type, geo_type}, LogicalType::DOUBLE,
+	                                       GeoFunctions::GeometryMaxDistanceFunction, nullptr, nullptr, nullptr,
+	                                       GeoFunctions::InitCircTreeCache));
 	maxdistance.AddFunction(ScalarFunction({geo_type, geo_type, LogicalType::BOOLEAN}, LogicalType::DOUBLE,
-	                                       GeoFunctions::GeometryMaxDistanceFunction));
+	                                       GeoFunctions::GeometryMaxDistanceFunction, nullptr, nullptr, nullptr,
+	                                       GeoFunctions::InitCircTreeCache));
 	func_set.push_back(maxdistance);
 
 	// ST_PERIMETER
@@ -9,6 +9,9 @@
 
 namespace duckdb {
 
+class CircTreeGeomCache;
+class PrepGeomCache;
+
 class Postgis {
 public:
 	Postgis();
@@ -16,16 +19,24 @@ public:
 
 public:
 	GSERIALIZED *LWGEOM_in(char *input);
+	LWGEOM *LWGEOM_parse(char *input);
 	GSERIALIZED *LWGEOM_getGserialized(const void *base, size_t size);
-	idx_t LWGEOM_size(GSERIALIZED *gser);
-	char *LWGEOM_base(GSERIALIZED *gser);
+	LWGEOM *LWGEOM_getLWGeom(const void *base, size_t size);
+	bool LWGEOM_getGBox(const void *base, size_t size, GBOX *box, int32_t *srid);
+	bool LWGEOM_getFastGBox(const void *base, size_t size, GBOX *box, int32_t *srid);
+	bool LWGEOM_getHeader(const void *base, size_t size, WKB_HEADER *header);
+	LWGEOM *LWGEOM_deserialize(GSERIALIZED *gser);
+	idx_t LWGEOM_wkbSize(const LWGEOM *lwgeom);
+	void LWGEOM_wkbWrite(const LWGEOM *lwgeom, data_ptr_t buffer, idx_t size);
 	string LWGEOM_asBinary(const void *data, size_t size);
 	lwvarlena_t *LWGEOM_asBinary(GSERIALIZED *gser, string text = "");
 	string LWGEOM_asText(GSERIALIZED *gser, size_t max_digits = OUT_DEFAULT_DECIMAL_DIGITS);
 	lwvarlena_t *LWGEOM_asGeoJson(GSERIALIZED *gser, size_t m_dec_digits = OUT_DEFAULT_DECIMAL_DIGITS);
 	string LWGEOM_asGeoJson(const void *data, size_t size);
 	lwvarlena_t *ST_GeoHash(GSERIALIZED *gser, size_t m_chars = 0);
+	std::string ST_GeoHashPoint(double x, double y, int m_chars = 0);
 	void LWGEOM_free(GSERIALIZED *gser);
+	void LWGEOM_freeLWGeom(LWGEOM *lwgeom);
 
 	GSERIALIZED *LWGEOM_makepoint(double x, double y);
 	GSERIALIZED *LWGEOM_makepoint(double x, double y, double z);
@@ -44,55 +55,72 @@ public:
 	GSERIALIZED *pgis_union_geometry_array(GSERIALIZED *gserArray[], int nelems);
 	GSERIALIZED *ST_Intersection(GSERIALIZED *geom1, GSERIALIZED *geom2);
 	GSERIALIZED *LWGEOM_simplify2d(GSERIALIZED *geom, double dist);
+	void LWGEOM_simplify2d(LWGEOM *geom, double dist);
 	GSERIALIZED *convexhull(GSERIALIZED *geom);
 	GSERIALIZED *LWGEOM_snaptogrid(GSERIALIZED *geom, double size);
 	GSERIALIZED *buffer(GSERIALIZED *geom, double radius, string styles_text = "");
 
-	bool ST_Equals(GSERIALIZED *geom1, GSERIALIZED *geom2);
-	bool contains(GSERIALIZED *geom1, GSERIALIZED *geom2);
-	bool touches(GSERIALIZED *geom1, GSERIALIZED *geom2);
-	bool within(GSERIALIZED *geom1, GSERIALIZED *geom2);
-	bool ST_Intersects(GSERIALIZED *geom1, GSERIALIZED *geom2);
-	bool covers(GSERIALIZED *geom1, GSERIALIZED *geom2);
-	bool coveredby(GSERIALIZED *geom1, GSERIALIZED *geom2);
-	bool disjoint(GSERIALIZED *geom1, GSERIALIZED *geom2);
-	bool LWGEOM_dwithin(GSERIALIZED *geom1, GSERIALIZED *geom2, double distance);
+	bool ST_Equals(LWGEOM *geom1, LWGEOM *geom2);
+	bool contains(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache = nullptr);
+	bool touches(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache = nullptr);
+	bool within(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache = nullptr);
+	bool ST_Intersects(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache = nullptr);
+	bool covers(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache = nullptr);
+	bool coveredby(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache = nullptr);
+	bool disjoint(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache = nullptr);
+	bool LWGEOM_dwithin(LWGEOM *geom1, LWGEOM *geom2, double distance);
+	bool geography_dwithin(LWGEOM *geom1, LWGEOM *geom2, double distance, bool use_spheroid,
+	                       const CircTreeGeomCache *cache = nullptr);
 
-	double ST_Area(GSERIALIZED *geom);
-	double geography_area(GSERIALIZED *geom, bool use_spheroid);
+	double ST_Area(LWGEOM *geom);
+	double geography_area(LWGEOM *geom, bool use_spheroid);
 	double LWGEOM_angle(GSERIALIZED *geom1, GSERIALIZED *geom2);
 	double LWGEOM_angle(std::vector<GSERIALIZED *> geom_vec);
-	double LWGEOM_perimeter2d_poly(GSERIALIZED *geom);
-	double geography_perimeter(GSERIALIZED *geom, bool use_spheroid);
-	double LWGEOM_azimuth(GSERIALIZED *geom1, GSERIALIZED *geom2);
-	double geography_azimuth(GSERIALIZED *geom1, GSERIALIZED *geom2);
-	double LWGEOM_length2d_linestring(GSERIALIZED *geom);
-	double geography_length(GSERIALIZED *geom, bool use_spheroid);
+	double LWGEOM_perimeter2d_poly(LWGEOM *geom);
+	double geography_perimeter(LWGEOM *geom, bool use_spheroid);
+	double LWGEOM_azimuth(LWGEOM *geom1, LWGEOM *geom2);
+	double geography_azimuth(LWGEOM *geom1, LWGEOM *geom2);
+	double LWGEOM_length2d_linestring(LWGEOM *geom);
+	double geography_length(LWGEOM *geom, bool use_spheroid);
 	GSERIALIZED *LWGEOM_envelope(GSERIALIZED *geom);
-	double LWGEOM_maxdistance2d_linestring(GSERIALIZED *geom1, GSERIALIZED *geom2);
-	double geography_maxdistance(GSERIALIZED *geom1, GSERIALIZED *geom2, bool use_spheroid);
+	LWGEOM *LWGEOM_envelope_gbox(const GBOX *gbox, int32_t srid);
+	double LWGEOM_maxdistance2d_linestring(LWGEOM *geom1, LWGEOM *geom2);
+	double geography_maxdistance(LWGEOM *geom1, LWGEOM *geom2, bool use_spheroid,
+	                             const CircTreeGeomCache *cache = nullptr);
 	GSERIALIZED *LWGEOM_envelope_garray(GSERIALIZED *gserArray[], int nelems);
 
-	std::vector<int> ST_ClusterDBSCAN(GSERIALIZED *gserArray[], int nelems, double tolerance, int minpoints);
+	std::vector<int> ST_ClusterDBSCAN(GSERIALIZED *gserArray[], int nelems, double tolerance, int minpoints,
+	                                  uint32_t max_threads);
+	std::vector<int> ST_ClusterDBSCAN(LWGEOM *geoms[], int nelems, double tolerance, int minpoints,
+	                                  uint32_t max_threads);
+	std::vector<int> ST_ClusterKMeans(LWGEOM *geoms[], int nelems, int k);
 
-	int LWGEOM_dimension(GSERIALIZED *geom);
+	int LWGEOM_dimension(LWGEOM *geom);
 	std::vector<GSERIALIZED *> LWGEOM_dump(GSERIALIZED *geom);
 	GSERIALIZED *LWGEOM_endpoint_linestring(GSERIALIZED *geom);
-	std::string geometry_geometrytype(GSERIALIZED *geom);
-	bool LWGEOM_isclosed(GSERIALIZED *geom);
-	bool ST_IsCollection(GSERIALIZED *geom);
-	bool LWGEOM_isempty(GSERIALIZED *geom);
-	bool LWGEOM_isring(GSERIALIZED *geom);
-	int LWGEOM_npoints(GSERIALIZED *geom);
-	int LWGEOM_numgeometries_collection(GSERIALIZED *geom);
-	int LWGEOM_numpoints_linestring(GSERIALIZED *geom);
+	std::string geometry_geometrytype(LWGEOM *geom);
+	bool LWGEOM_isclosed(LWGEOM *geom);
+	bool ST_IsCollection(LWGEOM *geom);
+	bool LWGEOM_isempty(LWGEOM *geom);
+	bool LWGEOM_isring(LWGEOM *geom);
+	int LWGEOM_npoints(LWGEOM *geom);
+	int LWGEOM_numgeometries_collection(LWGEOM *geom);
+	int LWGEOM_numpoints_linestring(LWGEOM *geom);
 	GSERIALIZED *LWGEOM_pointn_linestring(GSERIALIZED *geom, int index);
 	GSERIALIZED *LWGEOM_startpoint_linestring(GSERIALIZED *geom);
-	double LWGEOM_x_point(GSERIALIZED *geom);
-	double LWGEOM_y_point(GSERIALIZED *geom);
+	double LWGEOM_x_point(LWGEOM *geom);
+	double LWGEOM_y_point(LWGEOM *geom);
+	bool LWGEOM_point(LWGEOM *geom, POINT4D *pt);
 
-	double ST_distance(GSERIALIZED *geom1, GSERIALIZED *geom2);
-	double geography_distance(GSERIALIZED *geom1, GSERIALIZED *geom2, bool use_spheroid);
+	double ST_distance(LWGEOM *geom1, LWGEOM *geom2);
+	double geography_distance(LWGEOM *geom1, LWGEOM *geom2, bool use_spheroid,
+	                          const CircTreeGeomCache *cache = nullptr);
+	double geography_point_distance(const POINT2D *pt1, const POINT2D *pt2, int32_t srid, bool use_spheroid);
+	bool geography_point_dwithin(const POINT2D *pt1, const POINT2D *pt2, int32_t srid, double tolerance,
+	                             bool use_spheroid);
+	double geography_point_azimuth(const POINT2D *pt1, const POINT2D *pt2, int32_t srid);
+	double geography_coords_length(const double *x, const double *y, uint32_t npoints, int32_t srid,
+	                               bool use_spheroid);
 	GSERIALIZED *centroid(GSERIALIZED *geom);
 	GSERIALIZED *geography_centroid(GSERIALIZED *geom, bool use_spheroid);
 };
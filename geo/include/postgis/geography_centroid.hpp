@@ -30,4 +30,33 @@ namespace duckdb {
 
 GSERIALIZED *geography_centroid(GSERIALIZED *geom, bool use_spheroid);
 
+/**
+ * Running centroid on the sphere of a stream of geographies, for the
+ * centroid aggregate. Like geography_centroid, points weigh one, lines the
+ * length of their segments and polygons the area of their triangles, and
+ * only the inputs of the highest dimension make the centroid. Each dimension
+ * keeps the weighted x-y-z sums and the total weight, with Kahan compensation
+ * so that billions of small terms don't drift. The state is plain data, two
+ * of them merge by adding up their sums.
+ */
+struct GeographyCentroidSum {
+	//! The sums of the points, the lines and the polygons
+	double sums[3][4];
+	//! The running compensation of each sum
+	double compensations[3][4];
+	bool has_input;
+	int32_t srid;
+
+	void Initialize();
+	void Add(const LWGEOM *geom);
+	void Merge(const GeographyCentroidSum &other);
+	//! The centroid, an empty collection if no input had a weight, NULL if there was no input
+	LWGEOM *Finish() const;
+
+private:
+	void AddParts(const LWGEOM *geom, SPHEROID *s);
+	void AddWeighted(int dimension, double lon, double lat, double weight);
+	void AddTerm(int dimension, int coordinate, double value);
+};
+
 } // namespace duckdb
@@ -32,12 +32,24 @@ namespace duckdb {
 #ifndef _LIBGEOGRAPHY_MEASUREMENT_H
 #define _LIBGEOGRAPHY_MEASUREMENT_H 1
 
-double geography_distance(GSERIALIZED *geom1, GSERIALIZED *geom2, bool use_spheroid);
-double geography_maxdistance(GSERIALIZED *geom1, GSERIALIZED *geom2, bool use_spheroid);
-double geography_area(GSERIALIZED *g, bool use_spheroid);
-double geography_perimeter(GSERIALIZED *g, bool use_spheroid);
-double geography_azimuth(GSERIALIZED *g1, GSERIALIZED *g2);
-double geography_length(GSERIALIZED *g, bool use_spheroid);
+class CircTreeGeomCache;
+
+double geography_distance(LWGEOM *lwgeom1, LWGEOM *lwgeom2, bool use_spheroid,
+                          const CircTreeGeomCache *cache = NULL);
+double geography_point_distance(const POINT2D *pt1, const POINT2D *pt2, int32_t srid, bool use_spheroid);
+bool geography_point_dwithin(const POINT2D *pt1, const POINT2D *pt2, int32_t srid, double tolerance,
+                             bool use_spheroid);
+double geography_point_azimuth(const POINT2D *pt1, const POINT2D *pt2, int32_t srid);
+double geography_maxdistance(LWGEOM *lwgeom1, LWGEOM *lwgeom2, bool use_spheroid,
+                             const CircTreeGeomCache *cache = NULL);
+bool geography_dwithin(LWGEOM *lwgeom1, LWGEOM *lwgeom2, double tolerance, bool use_spheroid,
+                       const CircTreeGeomCache *cache = NULL);
+double geography_area(LWGEOM *lwgeom, bool use_spheroid);
+double geography_perimeter(LWGEOM *lwgeom, bool use_spheroid);
+double geography_azimuth(LWGEOM *lwgeom1, LWGEOM *lwgeom2);
+double geography_length(LWGEOM *lwgeom, bool use_spheroid);
+double geography_coords_length(const double *x, const double *y, uint32_t npoints, int32_t srid,
+                               bool use_spheroid);
 
 #endif /* !defined _LIBGEOGRAPHY_MEASUREMENT_H  */
 
@@ -24,19 +24,38 @@
 
 #pragma once
 #include "duckdb.hpp"
+#include "libpgcommon/lwgeom_cache.hpp"
 #include "liblwgeom/liblwgeom.hpp"
 #include "liblwgeom/liblwgeom_internal.hpp"
+#include "liblwgeom/lwgeodetic_tree.hpp"
 
 namespace duckdb {
 
 #ifndef _LIBGEOGRAPHY_MEASUREMENT_TREES_H
 #define _LIBGEOGRAPHY_MEASUREMENT_TREES_H 1
 
-int geography_tree_distance(const GSERIALIZED *g1, const GSERIALIZED *g2, const SPHEROID *s, double tolerance,
-                            double *distance);
+/*
+ * Keeps the circle tree of an argument that repeats from one call to the
+ * next, as geography_distance_cache does in PostGIS.
+ */
+class CircTreeGeomCache : public GeomCache {
+public:
+	CircTreeGeomCache();
+	~CircTreeGeomCache() override;
 
-int geography_tree_maxdistance(const GSERIALIZED *g1, const GSERIALIZED *g2, const SPHEROID *s, double tolerance,
-                               double *distance);
+	CIRC_NODE *index;
+	GBOX gbox;
+
+protected:
+	bool BuildIndex() override;
+	void FreeIndex() override;
+};
+
+int geography_tree_distance(const LWGEOM *lwgeom1, const LWGEOM *lwgeom2, const SPHEROID *s, double tolerance,
+                            double *distance, const CircTreeGeomCache *cache = NULL);
+
+int geography_tree_maxdistance(const LWGEOM *lwgeom1, const LWGEOM *lwgeom2, const SPHEROID *s, double tolerance,
+                               double *distance, const CircTreeGeomCache *cache = NULL);
 
 #endif /* !defined _LIBGEOGRAPHY_MEASUREMENT_TREES_H  */
 
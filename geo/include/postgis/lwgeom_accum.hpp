@@ -0,0 +1,82 @@
+/**********************************************************************
+ *
+ * PostGIS - Spatial Types for PostgreSQL
+ * http://postgis.net
+ *
+ * PostGIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * PostGIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PostGIS.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ *
+ * Copyright 2009 Paul Ramsey <pramsey@opengeo.org>
+ *
+ **********************************************************************/
+
+#pragma once
+#include "duckdb.hpp"
+#include "liblwgeom/liblwgeom.hpp"
+
+namespace duckdb {
+
+/**
+ * Running ST_Collect of a stream of geometries, for the collect aggregate.
+ * The inputs are appended to a growing collection, which is a MULTI of
+ * their type when they all have the same one and a GEOMETRYCOLLECTION
+ * otherwise.
+ */
+class CollectAccumulator {
+public:
+	CollectAccumulator();
+	~CollectAccumulator();
+
+	//! Take ownership of a geometry and append it
+	void Add(LWGEOM *geom);
+	//! Append copies of the geometries of another collection after these ones
+	void Merge(const CollectAccumulator &other);
+	//! The collection of everything added, owned by the accumulator, NULL if there was no input
+	const LWGEOM *Finish();
+
+private:
+	LWCOLLECTION *collection;
+	//! The type of all the inputs, COLLECTIONTYPE once they differ
+	uint8_t common_type;
+};
+
+/**
+ * Running ST_MakeLine of a stream of points, multipoints and lines, for the
+ * makeline aggregate. The coordinates are appended to the point array of the
+ * line as they come, the same way lwline_from_lwgeom_array joins an array.
+ */
+class MakeLineAccumulator {
+public:
+	MakeLineAccumulator();
+	~MakeLineAccumulator();
+
+	//! Append the coordinates of a geometry, anything but a point, multipoint or line is skipped
+	void Add(const LWGEOM *geom);
+	//! Append the points of the line of another accumulator after this one
+	void Merge(const MakeLineAccumulator &other);
+	//! The line of everything added, owned by the accumulator, NULL if there was no input
+	const LWGEOM *Finish();
+
+private:
+	void Start(const LWGEOM *geom);
+	void ForceDims(int hasz, int hasm);
+	void Append(POINTARRAY *points, bool skip_repeated_start);
+
+	LWLINE *line;
+	//! Whether the first input was a line, its start is dropped when it repeats the end of a preceding line
+	bool starts_with_line;
+};
+
+} // namespace duckdb
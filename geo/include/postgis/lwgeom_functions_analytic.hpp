@@ -29,6 +29,7 @@
 namespace duckdb {
 
 GSERIALIZED *LWGEOM_simplify2d(GSERIALIZED *geom, double dist);
+void LWGEOM_simplify2d(LWGEOM *geom, double dist);
 GSERIALIZED *LWGEOM_snaptogrid(GSERIALIZED *geom, double ipx, double ipy, double xsize, double ysize);
 
 int point_in_polygon(LWPOLY *polygon, LWPOINT *point);
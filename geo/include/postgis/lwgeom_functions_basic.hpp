@@ -34,21 +34,23 @@ GSERIALIZED *LWGEOM_makepoint(double x, double y, double z);
 GSERIALIZED *LWGEOM_makeline(GSERIALIZED *geom1, GSERIALIZED *geom2);
 GSERIALIZED *LWGEOM_makeline_garray(GSERIALIZED *gserArray[], int nelems);
 GSERIALIZED *LWGEOM_makepoly(GSERIALIZED *geom, GSERIALIZED *gserArray[] = {}, int nelems = 0);
-double ST_distance(GSERIALIZED *geom1, GSERIALIZED *geom2);
+double ST_distance(LWGEOM *lwgeom1, LWGEOM *lwgeom2);
 lwvarlena_t *ST_GeoHash(GSERIALIZED *gser, size_t m_chars = 0);
-bool ST_IsCollection(GSERIALIZED *geom);
-bool LWGEOM_isempty(GSERIALIZED *geom);
-int LWGEOM_npoints(GSERIALIZED *geom);
+std::string ST_GeoHashPoint(double x, double y, int m_chars = 0);
+bool ST_IsCollection(LWGEOM *lwgeom);
+bool LWGEOM_isempty(LWGEOM *lwgeom);
+int LWGEOM_npoints(LWGEOM *lwgeom);
 GSERIALIZED *LWGEOM_closestpoint(GSERIALIZED *geom1, GSERIALIZED *geom2);
-bool LWGEOM_dwithin(GSERIALIZED *geom1, GSERIALIZED *geom2, double tolerance);
-double ST_Area(GSERIALIZED *geom);
+bool LWGEOM_dwithin(LWGEOM *lwgeom1, LWGEOM *lwgeom2, double tolerance);
+double ST_Area(LWGEOM *lwgeom);
 double LWGEOM_angle(GSERIALIZED *geom1, GSERIALIZED *geom2);
 double LWGEOM_angle(std::vector<GSERIALIZED *> geom_vec);
-double LWGEOM_perimeter2d_poly(GSERIALIZED *geom);
-double LWGEOM_azimuth(GSERIALIZED *geom1, GSERIALIZED *geom2);
-double LWGEOM_length2d_linestring(GSERIALIZED *geom);
+double LWGEOM_perimeter2d_poly(LWGEOM *lwgeom);
+double LWGEOM_azimuth(LWGEOM *lwgeom1, LWGEOM *lwgeom2);
+double LWGEOM_length2d_linestring(LWGEOM *lwgeom);
 GSERIALIZED *LWGEOM_envelope(GSERIALIZED *geom);
-double LWGEOM_maxdistance2d_linestring(GSERIALIZED *geom1, GSERIALIZED *geom2);
+LWGEOM *LWGEOM_envelope_gbox(const GBOX *gbox, int32_t srid);
+double LWGEOM_maxdistance2d_linestring(LWGEOM *lwgeom1, LWGEOM *lwgeom2);
 GSERIALIZED *LWGEOM_envelope_garray(GSERIALIZED *gserArray[], int nelems);
 
 } // namespace duckdb
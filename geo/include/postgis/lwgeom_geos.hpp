@@ -29,25 +29,59 @@
 
 namespace duckdb {
 
+class PrepGeomCache;
+
 GSERIALIZED *GEOS2POSTGIS(GEOSGeom geom, char want3d);
 GEOSGeometry *POSTGIS2GEOS(const GSERIALIZED *g);
 
 extern void lwgeom_geos_error(const char *fmt, ...);
 
 GSERIALIZED *centroid(GSERIALIZED *geom);
-bool LWGEOM_isring(GSERIALIZED *geom);
+bool LWGEOM_isring(LWGEOM *geom);
 GSERIALIZED *ST_Difference(GSERIALIZED *geom1, GSERIALIZED *geom2);
 GSERIALIZED *ST_Union(GSERIALIZED *geom1, GSERIALIZED *geom2);
 GSERIALIZED *pgis_union_geometry_array(GSERIALIZED *gserArray[], int nelems);
+
+/**
+ * Running union of a stream of geometries, for the union aggregate.
+ * Inputs are buffered as GEOS geometries and unioned one batch at a time.
+ * The batch results are merged pairwise like the digits of a binary
+ * counter, so the unions stay cascaded and only a logarithmic number of
+ * partial results is kept.
+ */
+class CascadedUnion {
+public:
+	CascadedUnion();
+	~CascadedUnion();
+
+	void Add(const LWGEOM *geom);
+	//! Add copies of the inputs and the partial unions of another union, which is left as it is
+	void Merge(const CascadedUnion &other);
+	//! The union of everything added, NULL if there was no input
+	LWGEOM *Finish();
+
+private:
+	void Flush();
+	void Carry(GEOSGeometry *geom, size_t level);
+
+	std::vector<GEOSGeometry *> buffer;
+	//! The union of 2^i batches at index i, or NULL
+	std::vector<GEOSGeometry *> partials;
+	bool has_input;
+	int32_t srid;
+	char is3d;
+	//! The largest type of the empty inputs, returned if all of them are empty
+	uint8_t empty_type;
+};
 GSERIALIZED *ST_Intersection(GSERIALIZED *geom1, GSERIALIZED *geom2);
 GSERIALIZED *convexhull(GSERIALIZED *geom);
 GSERIALIZED *buffer(GSERIALIZED *geom1, double size, string styles_text = "");
-bool ST_Equals(GSERIALIZED *geom1, GSERIALIZED *geom2);
-bool contains(GSERIALIZED *geom1, GSERIALIZED *geom2);
-bool touches(GSERIALIZED *geom1, GSERIALIZED *geom2);
-bool ST_Intersects(GSERIALIZED *geom1, GSERIALIZED *geom2);
-bool covers(GSERIALIZED *geom1, GSERIALIZED *geom2);
-bool coveredby(GSERIALIZED *geom1, GSERIALIZED *geom2);
-bool disjoint(GSERIALIZED *geom1, GSERIALIZED *geom2);
+bool ST_Equals(LWGEOM *geom1, LWGEOM *geom2);
+bool contains(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache = NULL);
+bool touches(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache = NULL);
+bool ST_Intersects(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache = NULL);
+bool covers(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache = NULL);
+bool coveredby(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache = NULL);
+bool disjoint(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache = NULL);
 
 } // namespace duckdb
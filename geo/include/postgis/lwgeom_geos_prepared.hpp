@@ -0,0 +1,86 @@
+/**********************************************************************
+ *
+ * PostGIS - Spatial Types for PostgreSQL
+ * http://postgis.net
+ *
+ * PostGIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * PostGIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PostGIS.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ *
+ * Copyright (C) 2012 Sandro Santilli <strk@kbt.io>
+ * Copyright (C) 2008 Paul Ramsey <pramsey@cleverelephant.ca>
+ * Copyright (C) 2007 Refractions Research Inc.
+ *
+ **********************************************************************/
+
+#pragma once
+#include "duckdb.hpp"
+#include "geos_c.hpp"
+#include "libpgcommon/lwgeom_cache.hpp"
+
+namespace duckdb {
+
+/*
+ * Keeps a GEOS prepared geometry for an argument that repeats from one call
+ * to the next, as PrepGeomCache does in PostGIS. The spatial predicates use
+ * it when one of their arguments is the cached LWGEOM, so the constant side
+ * is converted to GEOS and indexed once instead of once per row.
+ */
+class PrepGeomCache : public GeomCache {
+public:
+	PrepGeomCache();
+	~PrepGeomCache() override;
+
+	//! The prepared geometry when `geom` belongs to the cache, otherwise NULL
+	const GEOSPreparedGeometry *Prepared(const LWGEOM *geom) const {
+		return geom == lwgeom ? prepared_geom : NULL;
+	}
+
+	GEOSGeometry *geom;
+	const GEOSPreparedGeometry *prepared_geom;
+
+protected:
+	bool BuildIndex() override;
+	void FreeIndex() override;
+};
+
+/*
+ * Converts a geometry to GEOS with the envelope of every component computed
+ * up front. GEOS fills them in lazily otherwise, so this is the form to use
+ * for a geometry that several threads read at once.
+ */
+GEOSGeometry *LWGEOM2GEOS_shared(const LWGEOM *geom);
+
+//! The predicates a prepared geometry is tested with, the prepared geometry being the first argument
+enum class PreparedRelation : uint8_t { INTERSECTS, CONTAINS, WITHIN, COVERS, COVEREDBY, TOUCHES };
+
+/*
+ * Prepared forms of a numbered set of shared GEOS geometries, such as the
+ * rows of the indexed side of a spatial join. A prepared geometry builds
+ * its indexes while it is used, so it can't be shared between threads:
+ * each thread keeps its own set and prepares a geometry the first time it
+ * is tested against it.
+ */
+class PreparedGeomSet {
+public:
+	~PreparedGeomSet();
+
+	//! Whether relation holds between the shared geometry number idx and geom
+	bool Relate(PreparedRelation relation, idx_t idx, const GEOSGeometry *shared, const GEOSGeometry *geom);
+
+private:
+	std::unordered_map<idx_t, const GEOSPreparedGeometry *> prepared;
+};
+
+} // namespace duckdb
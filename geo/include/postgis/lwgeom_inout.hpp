@@ -38,15 +38,50 @@ namespace duckdb {
  *  returns a GSERIALIZED object
  */
 GSERIALIZED *LWGEOM_in(char *input);
+/*
+ * LWGEOM_parse(cstring)
+ *  parses the same formats as LWGEOM_in into an LWGEOM, without serializing it.
+ *  Returns NULL when the input can't be parsed, release it with LWGEOM_freeLWGeom.
+ */
+LWGEOM *LWGEOM_parse(char *input);
 GSERIALIZED *LWGEOM_getGserialized(const void *base, size_t size);
+/*
+ * LWGEOM_getLWGeom(wkb)
+ *  decodes the WKB straight into an LWGEOM without going through GSERIALIZED.
+ *  Release it with LWGEOM_freeLWGeom.
+ */
+LWGEOM *LWGEOM_getLWGeom(const void *base, size_t size);
+/*
+ * LWGEOM_getGBox(wkb)
+ *  reads the planar 2D box and the SRID of the WKB without decoding it,
+ *  returns false for an empty geometry.
+ */
+bool LWGEOM_getGBox(const void *base, size_t size, GBOX *box, int32_t *srid);
+/*
+ * LWGEOM_getFastGBox(wkb)
+ *  reads the float box of the box header, or the box of a point, returns
+ *  false when there is neither or the geometry is empty.
+ * LWGEOM_getHeader(wkb)
+ *  reads the box header, returns false when the WKB has none.
+ */
+bool LWGEOM_getFastGBox(const void *base, size_t size, GBOX *box, int32_t *srid);
+bool LWGEOM_getHeader(const void *base, size_t size, WKB_HEADER *header);
 
 GSERIALIZED *geom_from_geojson(char *json);
-size_t LWGEOM_size(GSERIALIZED *gser);
-char *LWGEOM_base(GSERIALIZED *gser);
+LWGEOM *LWGEOM_deserialize(GSERIALIZED *gser);
+/*
+ * LWGEOM_wkbSize(lwgeom), LWGEOM_wkbWrite(lwgeom, buffer, size)
+ *  size and write the extended WKB of a geometry, behind its box header, into
+ *  a buffer owned by the caller, so results can be serialized in place without
+ *  an intermediate copy.
+ */
+size_t LWGEOM_wkbSize(const LWGEOM *lwgeom);
+void LWGEOM_wkbWrite(const LWGEOM *lwgeom, uint8_t *buffer, size_t size);
 lwvarlena_t *LWGEOM_asBinary(GSERIALIZED *gser, string text = "");
 std::string LWGEOM_asBinary(const void *base, size_t size);
 std::string LWGEOM_asText(GSERIALIZED *gser, size_t max_digits = OUT_DEFAULT_DECIMAL_DIGITS);
 std::string LWGEOM_asGeoJson(const void *base, size_t size);
 void LWGEOM_free(GSERIALIZED *gser);
+void LWGEOM_freeLWGeom(LWGEOM *lwgeom);
 
 } // namespace duckdb
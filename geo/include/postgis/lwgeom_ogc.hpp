@@ -31,15 +31,16 @@ namespace duckdb {
 GSERIALIZED *LWGEOM_from_text(char *text, int srid = SRID_UNKNOWN);
 GSERIALIZED *LWGEOM_from_WKB(const char *bytea_wkb, size_t byte_size, int srid = SRID_UNKNOWN);
 GSERIALIZED *LWGEOM_boundary(GSERIALIZED *geom);
-int LWGEOM_dimension(GSERIALIZED *geom);
+int LWGEOM_dimension(LWGEOM *lwgeom);
 GSERIALIZED *LWGEOM_endpoint_linestring(GSERIALIZED *geom);
-std::string geometry_geometrytype(GSERIALIZED *geom);
-bool LWGEOM_isclosed(GSERIALIZED *geom);
-int LWGEOM_numgeometries_collection(GSERIALIZED *geom);
-int LWGEOM_numpoints_linestring(GSERIALIZED *geom);
+std::string geometry_geometrytype(LWGEOM *lwgeom);
+bool LWGEOM_isclosed(LWGEOM *lwgeom);
+int LWGEOM_numgeometries_collection(LWGEOM *lwgeom);
+int LWGEOM_numpoints_linestring(LWGEOM *lwgeom);
 GSERIALIZED *LWGEOM_pointn_linestring(GSERIALIZED *geom, int where);
 GSERIALIZED *LWGEOM_startpoint_linestring(GSERIALIZED *geom);
-double LWGEOM_x_point(GSERIALIZED *geom);
-double LWGEOM_y_point(GSERIALIZED *geom);
+double LWGEOM_x_point(LWGEOM *lwgeom);
+double LWGEOM_y_point(LWGEOM *lwgeom);
+bool LWGEOM_point(LWGEOM *lwgeom, POINT4D *pt);
 
 } // namespace duckdb
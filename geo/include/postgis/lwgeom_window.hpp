@@ -29,6 +29,12 @@
 
 namespace duckdb {
 
-std::vector<int> ST_ClusterDBSCAN(GSERIALIZED *gserArray[], int nelems, double tolerance, int minpoints);
+/* DBSCAN on the sphere, tolerance in meters, on up to max_threads threads */
+std::vector<int> ST_ClusterDBSCAN(GSERIALIZED *gserArray[], int nelems, double tolerance, int minpoints,
+                                  uint32_t max_threads);
+/* Same as above over geometries the caller owns, -1 marks a noise geometry */
+std::vector<int> ST_ClusterDBSCAN(LWGEOM *geoms[], int nelems, double tolerance, int minpoints, uint32_t max_threads);
+/* k-means on the sphere, -1 marks an empty geometry */
+std::vector<int> ST_ClusterKMeans(LWGEOM *geoms[], int nelems, int k);
 
 } // namespace duckdb
@@ -17,32 +17,46 @@ static const std::vector<ScalarFunctionSet> GetPredicateScalarFunctions(LogicalT
 
 	// ST_CONTAINS
 	ScalarFunctionSet contains("st_contains");
-	contains.AddFunction(
-	    ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN, GeoFunctions::GeometryContainsFunction));
+	contains.AddFunction(ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN,
+	                                    GeoFunctions::GeometryContainsFunction, nullptr, nullptr, nullptr,
+	                                    GeoFunctions::InitPrepGeomCache));
+	contains.AddFunction(ScalarFunction({GeoTypes::Polygon2D(), GeoTypes::Point2D()}, LogicalType::BOOLEAN,
+	                                    GeoFunctions::PolygonContainsFunction));
 	func_set.push_back(contains);
 
 	// ST_COVEREDBY
 	ScalarFunctionSet coveredby("st_coveredby");
-	coveredby.AddFunction(
-	    ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN, GeoFunctions::GeometryCoveredByFunction));
+	coveredby.AddFunction(ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN,
+	                                     GeoFunctions::GeometryCoveredByFunction, nullptr, nullptr, nullptr,
+	                                     GeoFunctions::InitPrepGeomCache));
 	func_set.push_back(coveredby);
 
 	// ST_COVERS
 	ScalarFunctionSet covers("st_covers");
-	covers.AddFunction(
-	    ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN, GeoFunctions::GeometryCoversFunction));
+	covers.AddFunction(ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN,
+	                                  GeoFunctions::GeometryCoversFunction, nullptr, nullptr, nullptr,
+	                                  GeoFunctions::InitPrepGeomCache));
 	func_set.push_back(covers);
 
 	// ST_DISJOINT
 	ScalarFunctionSet disjoint("st_disjoint");
-	disjoint.AddFunction(
-	    ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN, GeoFunctions::GeometryDisjointFunction));
+	disjoint.AddFunction(ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN,
+	                                    GeoFunctions::GeometryDisjointFunction, nullptr, nullptr, nullptr,
+	                                    GeoFunctions::InitPrepGeomCache));
 	func_set.push_back(disjoint);
 
 	// ST_DWITHIN
 	ScalarFunctionSet dwithin("st_dwithin");
 	dwithin.AddFunction(ScalarFunction({geo_type, geo_type, LogicalType::DOUBLE}, LogicalType::BOOLEAN,
 	                                   GeoFunctions::GeometryDWithinFunction));
+	dwithin.AddFunction(ScalarFunction({geo_type, geo_type, LogicalType::DOUBLE, LogicalType::BOOLEAN},
+	                                   LogicalType::BOOLEAN, GeoFunctions::GeometryDWithinFunction, nullptr, nullptr,
+	                                   nullptr, GeoFunctions::InitCircTreeCache));
+	dwithin.AddFunction(ScalarFunction({GeoTypes::Point2D(), GeoTypes::Point2D(), LogicalType::DOUBLE},
+	                                   LogicalType::BOOLEAN, GeoFunctions::PointDWithinFunction));
+	dwithin.AddFunction(
+	    ScalarFunction({GeoTypes::Point2D(), GeoTypes::Point2D(), LogicalType::DOUBLE, LogicalType::BOOLEAN},
+	                   LogicalType::BOOLEAN, GeoFunctions::PointDWithinFunction));
 	func_set.push_back(dwithin);
 
 	// ST_EQUALS
@@ -53,20 +67,25 @@ static const std::vector<ScalarFunctionSet> GetPredicateScalarFunctions(LogicalT
 
 	// ST_INTERSECTS
 	ScalarFunctionSet intersects("st_intersects");
-	intersects.AddFunction(
-	    ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN, GeoFunctions::GeometryIntersectsFunction));
+	intersects.AddFunction(ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN,
+	                                      GeoFunctions::GeometryIntersectsFunction, nullptr, nullptr, nullptr,
+	                                      GeoFunctions::InitPrepGeomCache));
 	func_set.push_back(intersects);
 
 	// ST_TOUCHES
 	ScalarFunctionSet touches("st_touches");
-	touches.AddFunction(
-	    ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN, GeoFunctions::GeometryTouchesFunction));
+	touches.AddFunction(ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN,
+	                                   GeoFunctions::GeometryTouchesFunction, nullptr, nullptr, nullptr,
+	                                   GeoFunctions::InitPrepGeomCache));
 	func_set.push_back(touches);
 
 	// ST_WITHIN
 	ScalarFunctionSet within("st_within");
-	within.AddFunction(
-	    ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN, GeoFunctions::GeometryWithinFunction));
+	within.AddFunction(ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN,
+	                                  GeoFunctions::GeometryWithinFunction, nullptr, nullptr, nullptr,
+	                                  GeoFunctions::InitPrepGeomCache));
+	within.AddFunction(ScalarFunction({GeoTypes::Point2D(), GeoTypes::Polygon2D()}, LogicalType::BOOLEAN,
+	                                  GeoFunctions::PointWithinFunction));
 	func_set.push_back(within);
 
 	return func_set;
@@ -0,0 +1,119 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// spatial-join.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/execution/operator/join/physical_join.hpp"
+#include "duckdb/optimizer/optimizer_extension.hpp"
+#include "duckdb/planner/operator/logical_extension_operator.hpp"
+#include "geometry.hpp"
+#include "postgis/lwgeom_geos_prepared.hpp"
+
+namespace duckdb {
+
+//! The spatial predicates a join can be planned on, each one implies that the bounding boxes of a matching pair
+//! (grown by the distance for ST_DWITHIN) intersect
+enum class SpatialPredicate : uint8_t {
+	INTERSECTS,
+	CONTAINS,
+	WITHIN,
+	COVERS,
+	COVEREDBY,
+	TOUCHES,
+	DWITHIN,
+	//! ST_DWITHIN with use_spheroid, the distance is in meters
+	GEOGRAPHY_DWITHIN
+};
+
+struct SpatialJoinCondition {
+	SpatialPredicate predicate;
+	//! The geometry column in the output of the left and of the right child
+	idx_t left_column;
+	idx_t right_column;
+	//! Whether the left geometry is the first argument of the predicate
+	bool left_is_first;
+	//! The constant tolerance of ST_DWITHIN
+	double distance;
+	//! The constant use_spheroid of the geography ST_DWITHIN
+	bool use_spheroid;
+
+	bool Evaluate(LWGEOM *left, LWGEOM *right) const;
+	//! Whether the predicate is evaluated on the prepared GEOS form of the right geometry instead
+	bool IsPrepared() const;
+	//! The relation of the prepared right geometry to the left one that the predicate amounts to
+	PreparedRelation GetPreparedRelation() const;
+	//! The box of a geometry in the index, or the box to probe the index with
+	void GetBoundingBox(const LWGEOM *geom, bool probe, GBOX &box) const;
+	string ToString() const;
+};
+
+//! Rewrites inner joins on a spatial predicate into a LogicalSpatialJoin, set geo_spatial_join=false to disable
+struct SpatialJoinOptimizer {
+	static void Optimize(ClientContext &context, OptimizerExtensionInfo *info, unique_ptr<LogicalOperator> &plan);
+};
+
+class LogicalSpatialJoin : public LogicalExtensionOperator {
+public:
+	explicit LogicalSpatialJoin(SpatialJoinCondition condition);
+
+	SpatialJoinCondition condition;
+
+public:
+	vector<ColumnBinding> GetColumnBindings() override;
+	unique_ptr<PhysicalOperator> CreatePlan(ClientContext &context, PhysicalPlanGenerator &generator) override;
+	void Serialize(FieldWriter &writer) const override;
+	string GetName() const override;
+	string ParamsToString() const override;
+
+protected:
+	void ResolveTypes() override;
+};
+
+//! Bulk loads the geometries of the right side into an STRtree of their bounding boxes, then probes it with every
+//! row of the left side and only evaluates the predicate on the candidate pairs
+class PhysicalSpatialJoin : public PhysicalJoin {
+public:
+	PhysicalSpatialJoin(LogicalOperator &op, unique_ptr<PhysicalOperator> left, unique_ptr<PhysicalOperator> right,
+	                    SpatialJoinCondition condition, idx_t estimated_cardinality);
+
+	SpatialJoinCondition condition;
+
+public:
+	// Operator Interface
+	unique_ptr<OperatorState> GetOperatorState(ExecutionContext &context) const override;
+
+	bool ParallelOperator() const override {
+		return true;
+	}
+
+protected:
+	OperatorResultType ExecuteInternal(ExecutionContext &context, DataChunk &input, DataChunk &chunk,
+	                                   GlobalOperatorState &gstate, OperatorState &state) const override;
+
+public:
+	// Sink Interface
+	unique_ptr<GlobalSinkState> GetGlobalSinkState(ClientContext &context) const override;
+	unique_ptr<LocalSinkState> GetLocalSinkState(ExecutionContext &context) const override;
+	SinkResultType Sink(ExecutionContext &context, GlobalSinkState &gstate, LocalSinkState &lstate,
+	                    DataChunk &input) const override;
+	void Combine(ExecutionContext &context, GlobalSinkState &gstate, LocalSinkState &lstate) const override;
+	SinkFinalizeType Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
+	                          GlobalSinkState &gstate) const override;
+
+	bool IsSink() const override {
+		return true;
+	}
+	bool ParallelSink() const override {
+		return true;
+	}
+
+	string GetName() const override;
+	string ParamsToString() const override;
+};
+
+} // namespace duckdb
@@ -69,6 +69,10 @@ static const std::vector<ScalarFunctionSet> GetTransformationScalarFunctions(Log
 	ScalarFunctionSet simplify("st_simplify");
 	simplify.AddFunction(
 	    ScalarFunction({geo_type, LogicalType::DOUBLE}, geo_type, GeoFunctions::GeometrySimplifyFunction));
+	simplify.AddFunction(ScalarFunction({GeoTypes::LineString2D(), LogicalType::DOUBLE}, GeoTypes::LineString2D(),
+	                                    GeoFunctions::LineSimplifyFunction));
+	simplify.AddFunction(ScalarFunction({GeoTypes::Polygon2D(), LogicalType::DOUBLE}, GeoTypes::Polygon2D(),
+	                                    GeoFunctions::PolygonSimplifyFunction));
 	func_set.push_back(simplify);
 
 	// ST_SNAPTOGRID
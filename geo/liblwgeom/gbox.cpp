@@ -300,29 +300,24 @@ int ptarray_calculate_gbox_cartesian(const POINTARRAY *pa, GBOX *gbox) {
 		ptarray_calculate_gbox_cartesian_2d(pa, gbox);
 		break;
 	}
-		// case 3:
-		// {
-		// 	if (has_z)
-		// 	{
-		// 		ptarray_calculate_gbox_cartesian_3d(pa, gbox);
-		// 	}
-		// 	else
-		// 	{
-		// 		double zmin = gbox->zmin;
-		// 		double zmax = gbox->zmax;
-		// 		ptarray_calculate_gbox_cartesian_3d(pa, gbox);
-		// 		gbox->mmin = gbox->zmin;
-		// 		gbox->mmax = gbox->zmax;
-		// 		gbox->zmin = zmin;
-		// 		gbox->zmax = zmax;
-		// 	}
-		// 	break;
-		// }
-		// default:
-		// {
-		// 	ptarray_calculate_gbox_cartesian_4d(pa, gbox);
-		// 	break;
-		// }
+	default: {
+		POINT4D p;
+		ptarray_calculate_gbox_cartesian_2d(pa, gbox);
+		gbox->zmin = gbox->mmin = FLT_MAX;
+		gbox->zmax = gbox->mmax = -1 * FLT_MAX;
+		for (uint32_t i = 0; i < pa->npoints; i++) {
+			getPoint4d_p(pa, i, &p);
+			if (has_z) {
+				gbox->zmin = FP_MIN(gbox->zmin, p.z);
+				gbox->zmax = FP_MAX(gbox->zmax, p.z);
+			}
+			if (has_m) {
+				gbox->mmin = FP_MIN(gbox->mmin, p.m);
+				gbox->mmax = FP_MAX(gbox->mmax, p.m);
+			}
+		}
+		break;
+	}
 	}
 	return LW_SUCCESS;
 }
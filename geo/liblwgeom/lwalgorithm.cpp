@@ -215,6 +215,49 @@ unsigned int geohash_point_as_int(POINT2D *pt) {
 	return ch;
 }
 
+/* Cell of a coordinate on a 2^32 grid over [min, max], clamped to the grid */
+static uint32_t hilbert_cell(double value, double min, double max) {
+	double cell;
+
+	if (!(max > min))
+		return 0;
+	cell = (value - min) / (max - min) * 4294967295.0;
+	if (!(cell > 0))
+		return 0;
+	if (cell >= 4294967295.0)
+		return 0xFFFFFFFFu;
+	return (uint32_t)cell;
+}
+
+/*
+** Distance of a point along a Hilbert curve of order 32 laid over the
+** bounds, so points close on the curve are close in space. Points outside
+** the bounds are moved to their edge.
+*/
+uint64_t hilbert_point_as_int(const POINT2D *pt, const GBOX *bounds) {
+	uint32_t x = hilbert_cell(pt->x, bounds->xmin, bounds->xmax);
+	uint32_t y = hilbert_cell(pt->y, bounds->ymin, bounds->ymax);
+	uint64_t d = 0;
+
+	for (uint32_t s = 0x80000000u; s > 0; s >>= 1) {
+		uint32_t rx = (x & s) ? 1 : 0;
+		uint32_t ry = (y & s) ? 1 : 0;
+		d += (uint64_t)s * s * ((3 * rx) ^ ry);
+
+		/* Rotate the quadrant, only the bits below s matter from here on */
+		if (ry == 0) {
+			if (rx == 1) {
+				x = ~x;
+				y = ~y;
+			}
+			uint32_t t = x;
+			x = y;
+			y = t;
+		}
+	}
+	return d;
+}
+
 static char const *base32 = "0123456789bcdefghjkmnpqrstuvwxyz";
 
 /*
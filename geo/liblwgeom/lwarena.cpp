@@ -0,0 +1,268 @@
+/**********************************************************************
+ *
+ * PostGIS - Spatial Types for PostgreSQL
+ * http://postgis.net
+ *
+ * PostGIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * PostGIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PostGIS.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************/
+
+#include "liblwgeom/liblwgeom.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+
+namespace duckdb {
+
+/*
+ * Per-thread bump allocator.
+ *
+ * Between lwarena_begin() and lwarena_end() every small lwalloc() on the
+ * calling thread is carved out of thread-local blocks and lwfree() of such
+ * memory is a no-op. lwarena_end() rewinds the blocks in one go, so a whole
+ * DataChunk worth of LWGEOM headers, point arrays and boxes costs a handful
+ * of pointer bumps instead of malloc/free pairs.
+ *
+ * Outside of a scope, or for allocations larger than LWARENA_MAX_ALLOC,
+ * the allocator falls through to malloc/realloc/free.
+ *
+ * Memory of an arena may be handed to lwfree() on any thread (GEOS and the
+ * clustering workers free what the calling thread allocated), so whether a
+ * pointer belongs to an arena is looked up in a process-wide table of the
+ * live blocks rather than in the blocks of the calling thread.
+ */
+
+#define LWARENA_BLOCK_SIZE (256 * 1024)
+#define LWARENA_MAX_ALLOC  (64 * 1024)
+#define LWARENA_ALIGN      16
+/* Every allocation is preceded by its size, padded to keep the alignment */
+#define LWARENA_HEADER LWARENA_ALIGN
+/* Slots of the table of live blocks, a power of two */
+#define LWARENA_REGISTRY_SIZE 4096
+#define LWARENA_REGISTRY_FREE ((uintptr_t)0)
+#define LWARENA_REGISTRY_DEAD ((uintptr_t)1)
+
+/*
+ * Open addressing table of the start of every live block. The blocks are
+ * aligned to their size, so the block of any pointer is found by masking
+ * its low bits. Lookups take no lock; blocks come and go rarely, so adding
+ * and removing them is serialized.
+ *
+ * A removed block leaves a tombstone behind, which keeps the probe
+ * sequences of concurrent lookups intact and is reused by inserts. When
+ * the slot after a run of tombstones is free, no probe sequence continues
+ * past the run, so it is freed again: otherwise every tombstone ever left
+ * would lengthen the lookup of each pointer that is not in an arena.
+ */
+static std::atomic<uintptr_t> arena_registry[LWARENA_REGISTRY_SIZE];
+static std::mutex arena_registry_lock;
+
+static inline size_t lwarena_slot(uintptr_t block) {
+	return (size_t)((block / LWARENA_BLOCK_SIZE) * 0x9E3779B97F4A7C15ULL >> 40) & (LWARENA_REGISTRY_SIZE - 1);
+}
+
+static inline size_t lwarena_next_slot(size_t slot) {
+	return (slot + 1) & (LWARENA_REGISTRY_SIZE - 1);
+}
+
+static inline size_t lwarena_prev_slot(size_t slot) {
+	return (slot - 1) & (LWARENA_REGISTRY_SIZE - 1);
+}
+
+static bool lwarena_register(uintptr_t block) {
+	std::lock_guard<std::mutex> guard(arena_registry_lock);
+	auto slot = lwarena_slot(block);
+	for (size_t i = 0; i < LWARENA_REGISTRY_SIZE; i++, slot = lwarena_next_slot(slot)) {
+		auto entry = arena_registry[slot].load(std::memory_order_relaxed);
+		if (entry == LWARENA_REGISTRY_FREE || entry == LWARENA_REGISTRY_DEAD) {
+			arena_registry[slot].store(block, std::memory_order_release);
+			return true;
+		}
+	}
+	return false;
+}
+
+static void lwarena_unregister(uintptr_t block) {
+	std::lock_guard<std::mutex> guard(arena_registry_lock);
+	auto slot = lwarena_slot(block);
+	size_t i = 0;
+	for (; i < LWARENA_REGISTRY_SIZE; i++, slot = lwarena_next_slot(slot)) {
+		auto entry = arena_registry[slot].load(std::memory_order_relaxed);
+		if (entry == block) {
+			break;
+		}
+		if (entry == LWARENA_REGISTRY_FREE) {
+			return;
+		}
+	}
+	if (i == LWARENA_REGISTRY_SIZE) {
+		return;
+	}
+	if (arena_registry[lwarena_next_slot(slot)].load(std::memory_order_relaxed) != LWARENA_REGISTRY_FREE) {
+		arena_registry[slot].store(LWARENA_REGISTRY_DEAD, std::memory_order_release);
+		return;
+	}
+	/* Last of its run: free the slot and the tombstones right before it */
+	arena_registry[slot].store(LWARENA_REGISTRY_FREE, std::memory_order_release);
+	for (size_t i = 1; i < LWARENA_REGISTRY_SIZE; i++) {
+		slot = lwarena_prev_slot(slot);
+		if (arena_registry[slot].load(std::memory_order_relaxed) != LWARENA_REGISTRY_DEAD) {
+			break;
+		}
+		arena_registry[slot].store(LWARENA_REGISTRY_FREE, std::memory_order_release);
+	}
+}
+
+static uint8_t *lwarena_new_block(void) {
+	void *data = nullptr;
+	if (posix_memalign(&data, LWARENA_BLOCK_SIZE, LWARENA_BLOCK_SIZE) != 0) {
+		return nullptr;
+	}
+	if (!lwarena_register((uintptr_t)data)) {
+		free(data);
+		return nullptr;
+	}
+	return (uint8_t *)data;
+}
+
+static void lwarena_free_block(uint8_t *data) {
+	lwarena_unregister((uintptr_t)data);
+	free(data);
+}
+
+struct LWArenaBlock {
+	uint8_t *data;
+	size_t used;
+};
+
+struct LWArena {
+	std::vector<LWArenaBlock> blocks;
+	size_t current = 0;
+	int depth = 0;
+	bool active = false;
+
+	~LWArena() {
+		for (auto &block : blocks) {
+			lwarena_free_block(block.data);
+		}
+	}
+};
+
+static thread_local LWArena arena;
+
+static inline bool lwarena_owns(const void *mem) {
+	auto block = (uintptr_t)mem & ~(uintptr_t)(LWARENA_BLOCK_SIZE - 1);
+	auto slot = lwarena_slot(block);
+	for (size_t i = 0; i < LWARENA_REGISTRY_SIZE; i++, slot = lwarena_next_slot(slot)) {
+		auto entry = arena_registry[slot].load(std::memory_order_acquire);
+		if (entry == block) {
+			return true;
+		}
+		if (entry == LWARENA_REGISTRY_FREE) {
+			return false;
+		}
+	}
+	return false;
+}
+
+static inline size_t lwarena_size(const void *mem) {
+	return *(const size_t *)(static_cast<const uint8_t *>(mem) - LWARENA_HEADER);
+}
+
+void *lwarena_alloc(size_t size) {
+	if (!arena.active || size > LWARENA_MAX_ALLOC) {
+		return malloc(size);
+	}
+
+	size_t needed = LWARENA_HEADER + ((size + LWARENA_ALIGN - 1) & ~(size_t)(LWARENA_ALIGN - 1));
+	while (arena.current < arena.blocks.size() && arena.blocks[arena.current].used + needed > LWARENA_BLOCK_SIZE) {
+		arena.current++;
+	}
+	if (arena.current == arena.blocks.size()) {
+		auto data = lwarena_new_block();
+		if (!data) {
+			/* Out of memory or out of registry slots, this one goes to malloc */
+			return malloc(size);
+		}
+		arena.blocks.push_back(LWArenaBlock {data, 0});
+	}
+
+	auto &block = arena.blocks[arena.current];
+	auto mem = block.data + block.used;
+	*(size_t *)mem = size;
+	block.used += needed;
+	return mem + LWARENA_HEADER;
+}
+
+void *lwarena_realloc(void *mem, size_t size) {
+	if (!mem) {
+		return lwarena_alloc(size);
+	}
+	if (!lwarena_owns(mem)) {
+		return realloc(mem, size);
+	}
+
+	size_t old_size = lwarena_size(mem);
+	if (size <= old_size) {
+		return mem;
+	}
+	void *ret = lwarena_alloc(size);
+	if (ret) {
+		memcpy(ret, mem, old_size);
+	}
+	return ret;
+}
+
+void lwarena_free(void *mem) {
+	if (!mem || lwarena_owns(mem)) {
+		return;
+	}
+	free(mem);
+}
+
+void lwarena_begin(int enabled) {
+	if (arena.depth++ == 0) {
+		arena.active = enabled != 0;
+	}
+}
+
+void lwarena_end(void) {
+	if (--arena.depth > 0 || !arena.active) {
+		return;
+	}
+	/* Keep one block around for the next chunk, hand the rest back */
+	for (size_t i = 1; i < arena.blocks.size(); i++) {
+		lwarena_free_block(arena.blocks[i].data);
+	}
+	if (!arena.blocks.empty()) {
+		arena.blocks.resize(1);
+		arena.blocks[0].used = 0;
+	}
+	arena.current = 0;
+	arena.active = false;
+}
+
+int lwarena_pause(void) {
+	int state = arena.active;
+	arena.active = false;
+	return state;
+}
+
+void lwarena_resume(int state) {
+	arena.active = state != 0;
+}
+
+} // namespace duckdb
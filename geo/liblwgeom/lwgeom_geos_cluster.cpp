@@ -24,11 +24,15 @@
 
 #include "liblwgeom/liblwgeom.hpp"
 #include "liblwgeom/liblwgeom_internal.hpp"
+#include "liblwgeom/lwgeodetic.hpp"
 #include "liblwgeom/lwgeom_geos.hpp"
 #include "liblwgeom/lwinline.hpp"
 #include "liblwgeom/lwunionfind.hpp"
 
+#include <algorithm>
 #include <string.h>
+#include <thread>
+#include <vector>
 
 namespace duckdb {
 
@@ -49,18 +53,27 @@ struct STRTree {
 	uint32_t num_geoms;
 };
 
-static struct STRTree make_strtree(void **geoms, uint32_t num_geoms, char is_lwgeom);
+static struct STRTree make_strtree(void **geoms, uint32_t num_geoms, char is_lwgeom, const SPHEROID *sphere);
 static void destroy_strtree(struct STRTree *tree);
 
 /* Make a minimal GEOSGeometry* whose Envelope covers the same 2D extent as
  * the supplied GBOX.  This is faster and uses less memory than building a
  * five-point polygon with GBOX2GEOS.
+ * With a sphere the envelope is the x/y extent of the geocentric box, which
+ * keeps every pair that is close on the sphere.
  */
-static GEOSGeometry *geos_envelope_surrogate(const LWGEOM *g) {
+static GEOSGeometry *geos_envelope_surrogate(const LWGEOM *g, const SPHEROID *sphere) {
 	if (lwgeom_is_empty(g))
 		return GEOSGeom_createEmptyPolygon();
 
-	if (lwgeom_get_type(g) == POINTTYPE) {
+	if (sphere) {
+		GBOX box;
+		gbox_init(&box);
+		if (lwgeom_calculate_gbox_geodetic(g, &box) == LW_FAILURE)
+			return NULL;
+
+		return make_geos_segment(box.xmin, box.ymin, box.xmax, box.ymax);
+	} else if (lwgeom_get_type(g) == POINTTYPE) {
 		const POINT2D *pt = getPoint2d_cp(lwgeom_as_lwpoint(g)->point, 0);
 		return make_geos_point(pt->x, pt->y);
 	} else {
@@ -74,7 +87,7 @@ static GEOSGeometry *geos_envelope_surrogate(const LWGEOM *g) {
 
 /** Make a GEOSSTRtree that stores a pointer to a variable containing
  *  the array index of the input geoms */
-static struct STRTree make_strtree(void **geoms, uint32_t num_geoms, char is_lwgeom) {
+static struct STRTree make_strtree(void **geoms, uint32_t num_geoms, char is_lwgeom, const SPHEROID *sphere) {
 	struct STRTree tree;
 	tree.envelopes = 0;
 	tree.num_geoms = 0;
@@ -92,7 +105,7 @@ static struct STRTree make_strtree(void **geoms, uint32_t num_geoms, char is_lwg
 		tree.envelopes = (GEOSGeometry **)lwalloc(num_geoms * sizeof(GEOSGeometry *));
 		for (i = 0; i < num_geoms; i++) {
 			tree.geom_ids[i] = i;
-			tree.envelopes[i] = geos_envelope_surrogate((LWGEOM *)geoms[i]);
+			tree.envelopes[i] = geos_envelope_surrogate((LWGEOM *)geoms[i], sphere);
 			GEOSSTRtree_insert(tree.tree, tree.envelopes[i], &(tree.geom_ids[i]));
 		}
 	} else {
@@ -135,11 +148,22 @@ static void query_accumulate(void *item, void *userdata) {
 	cxt->items_found[cxt->num_items_found++] = item;
 }
 
-static int dbscan_update_context(GEOSSTRtree *tree, struct QueryContext *cxt, LWGEOM **geoms, uint32_t p, double eps) {
+static int dbscan_update_context(GEOSSTRtree *tree, struct QueryContext *cxt, LWGEOM **geoms, uint32_t p, double eps,
+                                 const SPHEROID *sphere) {
 	cxt->num_items_found = 0;
 
 	GEOSGeometry *query_envelope;
-	if (geoms[p]->type == POINTTYPE) {
+	if (sphere) {
+		/* A chord is never longer than its arc, so growing the geocentric box
+		 * by the angle of eps keeps every geometry within eps */
+		GBOX box;
+		double angle = eps / sphere->radius;
+		gbox_init(&box);
+		if (lwgeom_calculate_gbox_geodetic(geoms[p], &box) == LW_FAILURE)
+			return LW_FAILURE;
+		query_envelope =
+		    make_geos_segment(box.xmin - angle, box.ymin - angle, box.xmax + angle, box.ymax + angle);
+	} else if (geoms[p]->type == POINTTYPE) {
 		const POINT2D *pt = getPoint2d_cp(lwgeom_as_lwpoint(geoms[p])->point, 0);
 		query_envelope = make_geos_segment(pt->x - eps, pt->y - eps, pt->x + eps, pt->y + eps);
 	} else {
@@ -157,6 +181,16 @@ static int dbscan_update_context(GEOSSTRtree *tree, struct QueryContext *cxt, LW
 	return LW_SUCCESS;
 }
 
+/* The distance of two geometries, in meters on the sphere if one is given,
+ * FLT_MAX if it cannot be computed */
+static double dbscan_distance(const LWGEOM *a, const LWGEOM *b, double eps, const SPHEROID *sphere) {
+	if (!sphere)
+		return lwgeom_mindistance2d_tolerance(a, b, eps);
+
+	double distance = lwgeom_distance_spheroid(a, b, sphere, eps);
+	return distance < 0 ? FLT_MAX : distance;
+}
+
 /* Union p's cluster with q's cluster, if q is not a border point of another cluster.
  * Applicable to DBSCAN with minpoints > 1.
  */
@@ -181,7 +215,7 @@ static void union_if_available(UNIONFIND *uf, uint32_t p, uint32_t q, char *is_i
  * to avoid some distance computations altogether.
  */
 static int union_dbscan_minpoints_1(LWGEOM **geoms, uint32_t num_geoms, UNIONFIND *uf, double eps,
-                                    char **in_a_cluster_ret) {
+                                    char **in_a_cluster_ret, const SPHEROID *sphere) {
 	uint32_t p, i;
 	struct STRTree tree;
 	struct QueryContext cxt = {.items_found = NULL, .num_items_found = 0, .items_found_size = 0};
@@ -197,7 +231,7 @@ static int union_dbscan_minpoints_1(LWGEOM **geoms, uint32_t num_geoms, UNIONFIN
 	if (num_geoms <= 1)
 		return LW_SUCCESS;
 
-	tree = make_strtree((void **)geoms, num_geoms, LW_TRUE);
+	tree = make_strtree((void **)geoms, num_geoms, LW_TRUE, sphere);
 	if (tree.tree == NULL) {
 		destroy_strtree(&tree);
 		return LW_FAILURE;
@@ -207,12 +241,15 @@ static int union_dbscan_minpoints_1(LWGEOM **geoms, uint32_t num_geoms, UNIONFIN
 		if (lwgeom_is_empty(geoms[p]))
 			continue;
 
-		dbscan_update_context(tree.tree, &cxt, geoms, p, eps);
+		if (dbscan_update_context(tree.tree, &cxt, geoms, p, eps, sphere) == LW_FAILURE) {
+			success = LW_FAILURE;
+			break;
+		}
 		for (i = 0; i < cxt.num_items_found; i++) {
 			uint32_t q = *((uint32_t *)cxt.items_found[i]);
 
 			if (UF_find(uf, p) != UF_find(uf, q)) {
-				double mindist = lwgeom_mindistance2d_tolerance(geoms[p], geoms[q], eps);
+				double mindist = dbscan_distance(geoms[p], geoms[q], eps, sphere);
 				if (mindist == FLT_MAX) {
 					success = LW_FAILURE;
 					break;
@@ -233,7 +270,7 @@ static int union_dbscan_minpoints_1(LWGEOM **geoms, uint32_t num_geoms, UNIONFIN
 }
 
 static int union_dbscan_general(LWGEOM **geoms, uint32_t num_geoms, UNIONFIND *uf, double eps, uint32_t min_points,
-                                char **in_a_cluster_ret) {
+                                char **in_a_cluster_ret, const SPHEROID *sphere) {
 	uint32_t p, i;
 	struct STRTree tree;
 	struct QueryContext cxt = {.items_found = NULL, .num_items_found = 0, .items_found_size = 0};
@@ -255,7 +292,7 @@ static int union_dbscan_general(LWGEOM **geoms, uint32_t num_geoms, UNIONFIND *u
 		return LW_SUCCESS;
 	}
 
-	tree = make_strtree((void **)geoms, num_geoms, LW_TRUE);
+	tree = make_strtree((void **)geoms, num_geoms, LW_TRUE, sphere);
 	if (tree.tree == NULL) {
 		destroy_strtree(&tree);
 		return LW_FAILURE;
@@ -271,7 +308,10 @@ static int union_dbscan_general(LWGEOM **geoms, uint32_t num_geoms, UNIONFIND *u
 		if (lwgeom_is_empty(geoms[p]))
 			continue;
 
-		dbscan_update_context(tree.tree, &cxt, geoms, p, eps);
+		if (dbscan_update_context(tree.tree, &cxt, geoms, p, eps, sphere) == LW_FAILURE) {
+			success = LW_FAILURE;
+			break;
+		}
 
 		/* We didn't find enough points to do anything, even if they are all within eps. */
 		if (cxt.num_items_found < min_points)
@@ -295,7 +335,7 @@ static int union_dbscan_general(LWGEOM **geoms, uint32_t num_geoms, UNIONFIND *u
 					continue;
 			}
 
-			double mindist = lwgeom_mindistance2d_tolerance(geoms[p], geoms[q], eps);
+			double mindist = dbscan_distance(geoms[p], geoms[q], eps, sphere);
 			if (mindist == FLT_MAX) {
 				success = LW_FAILURE;
 				break;
@@ -350,9 +390,227 @@ static int union_dbscan_general(LWGEOM **geoms, uint32_t num_geoms, UNIONFIND *u
 int union_dbscan(LWGEOM **geoms, uint32_t num_geoms, UNIONFIND *uf, double eps, uint32_t min_points,
                  char **in_a_cluster_ret) {
 	if (min_points <= 1)
-		return union_dbscan_minpoints_1(geoms, num_geoms, uf, eps, in_a_cluster_ret);
+		return union_dbscan_minpoints_1(geoms, num_geoms, uf, eps, in_a_cluster_ret, NULL);
+	else
+		return union_dbscan_general(geoms, num_geoms, uf, eps, min_points, in_a_cluster_ret, NULL);
+}
+
+/* Inputs of fewer points than this per thread are clustered on fewer threads */
+static const uint32_t DBSCAN_POINTS_PER_THREAD = 16384;
+
+/* The smallest grid cell, so cell coordinates on the unit sphere fit in 32 bits */
+static const double DBSCAN_MIN_CELL_SIZE = 1e-9;
+
+/* A point on the unit sphere and the grid cell holding it */
+struct DBSCANPoint {
+	int32_t cell[3];
+	uint32_t id;
+	POINT3D p;
+};
+
+static inline bool dbscan_cell_less(const int32_t *a, const int32_t *b) {
+	if (a[0] != b[0])
+		return a[0] < b[0];
+	if (a[1] != b[1])
+		return a[1] < b[1];
+	return a[2] < b[2];
+}
+
+static inline bool dbscan_point_less(const DBSCANPoint &a, const DBSCANPoint &b) {
+	return dbscan_cell_less(a.cell, b.cell);
+}
+
+/* Call fn(begin, end) on contiguous ranges of [0, n), one range per thread.
+ * The calling thread takes the first range and the others get threads of
+ * their own, outside of the DuckDB task scheduler: every clustering adds up
+ * to num_threads - 1 threads next to the workers, and window partitions
+ * clustered at the same time each do. */
+template <class FUNC>
+static void dbscan_parallel_for(uint32_t n, uint32_t num_threads, FUNC fn) {
+	uint32_t step = (n + num_threads - 1) / num_threads;
+	std::vector<std::thread> threads;
+	for (uint32_t begin = step; begin < n; begin += step)
+		threads.emplace_back(fn, begin, std::min(n, begin + step));
+	fn(0, std::min(n, step));
+	for (auto &thread : threads)
+		thread.join();
+}
+
+/* Sort the ranges of each thread, then merge pairs of ranges in parallel */
+static void dbscan_parallel_sort(std::vector<DBSCANPoint> &points, uint32_t num_threads) {
+	uint32_t n = points.size();
+	uint32_t step = (n + num_threads - 1) / num_threads;
+	dbscan_parallel_for(n, num_threads, [&points](uint32_t begin, uint32_t end) {
+		std::sort(points.begin() + begin, points.begin() + end, dbscan_point_less);
+	});
+	for (uint32_t width = step; width < n; width *= 2) {
+		std::vector<std::thread> threads;
+		for (uint32_t begin = 0; begin < n - width; begin += 2 * width) {
+			uint32_t middle = begin + width;
+			uint32_t end = std::min(n, middle + width);
+			threads.emplace_back([&points, begin, middle, end]() {
+				std::inplace_merge(points.begin() + begin, points.begin() + middle, points.begin() + end,
+				                   dbscan_point_less);
+			});
+		}
+		for (auto &thread : threads)
+			thread.join();
+	}
+}
+
+/* Call fn(q) on every point q within the chord of points[s], s itself included,
+ * until it returns false. Such points are in the 27 cells around the cell of s,
+ * the sorted points of each column of 3 cells are found with a binary search. */
+template <class FUNC>
+static void dbscan_for_each_neighbor(const std::vector<DBSCANPoint> &points, uint32_t s, double chord2, FUNC fn) {
+	const DBSCANPoint &point = points[s];
+	for (int32_t dx = -1; dx <= 1; dx++) {
+		for (int32_t dy = -1; dy <= 1; dy++) {
+			int32_t first[3] = {point.cell[0] + dx, point.cell[1] + dy, point.cell[2] - 1};
+			int32_t last[3] = {point.cell[0] + dx, point.cell[1] + dy, point.cell[2] + 1};
+			auto it = std::lower_bound(
+			    points.begin(), points.end(), first,
+			    [](const DBSCANPoint &a, const int32_t *cell) { return dbscan_cell_less(a.cell, cell); });
+			for (; it != points.end() && !dbscan_cell_less(last, it->cell); ++it) {
+				double dx2 = it->p.x - point.p.x;
+				double dy2 = it->p.y - point.p.y;
+				double dz2 = it->p.z - point.p.z;
+				if (dx2 * dx2 + dy2 * dy2 + dz2 * dz2 <= chord2 && !fn(*it))
+					return;
+			}
+		}
+	}
+}
+
+/* DBSCAN of points on the sphere, eps in meters. The points are bucketed in a
+ * grid of cells the size of the chord of eps on the unit sphere, sorted by cell
+ * so the candidates of a point are a few contiguous runs, and each phase runs
+ * on several threads that merge clusters through a concurrent union-find.
+ * A border point joins the cluster of its core neighbor with the smallest id,
+ * so the clusters do not depend on the scheduling of the threads. */
+static int union_dbscan_sphere_points(LWGEOM **geoms, uint32_t num_geoms, UNIONFIND *uf, double eps,
+                                      uint32_t min_points, uint32_t max_threads, const SPHEROID *sphere,
+                                      char **in_a_cluster_ret) {
+	uint32_t num_threads = std::max(1u, std::min(max_threads, num_geoms / DBSCAN_POINTS_PER_THREAD));
+	double angle = std::min(eps / sphere->radius, M_PI);
+	double chord = 2.0 * sin(angle / 2.0);
+	double chord2 = chord * chord;
+	double cell_size = std::max(chord, DBSCAN_MIN_CELL_SIZE);
+
+	char *in_a_cluster = (char *)lwalloc(num_geoms * sizeof(char));
+	memset(in_a_cluster, min_points <= 1 ? LW_TRUE : LW_FALSE, num_geoms * sizeof(char));
+	if (in_a_cluster_ret)
+		*in_a_cluster_ret = in_a_cluster;
+
+	std::vector<DBSCANPoint> points(num_geoms);
+	dbscan_parallel_for(num_geoms, num_threads, [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; i++) {
+			const POINT2D *pt = getPoint2d_cp(lwgeom_as_lwpoint(geoms[i])->point, 0);
+			GEOGRAPHIC_POINT g;
+			DBSCANPoint &point = points[i];
+			geographic_point_init(pt->x, pt->y, &g);
+			geog2cart(&g, &point.p);
+			point.id = i;
+			point.cell[0] = (int32_t)floor(point.p.x / cell_size);
+			point.cell[1] = (int32_t)floor(point.p.y / cell_size);
+			point.cell[2] = (int32_t)floor(point.p.z / cell_size);
+		}
+	});
+	dbscan_parallel_sort(points, num_threads);
+
+	if (min_points <= 1) {
+		dbscan_parallel_for(num_geoms, num_threads, [&](uint32_t begin, uint32_t end) {
+			for (uint32_t s = begin; s < end; s++) {
+				uint32_t p = points[s].id;
+				dbscan_for_each_neighbor(points, s, chord2, [&](const DBSCANPoint &q) {
+					if (q.id > p)
+						UF_union_concurrent(uf, p, q.id);
+					return true;
+				});
+			}
+		});
+	} else {
+		/* Core points have min_points neighbors, themselves included */
+		std::vector<char> is_in_core(num_geoms, LW_FALSE);
+		dbscan_parallel_for(num_geoms, num_threads, [&](uint32_t begin, uint32_t end) {
+			for (uint32_t s = begin; s < end; s++) {
+				uint32_t num_neighbors = 0;
+				dbscan_for_each_neighbor(points, s, chord2, [&](const DBSCANPoint &q) {
+					return ++num_neighbors < min_points;
+				});
+				if (num_neighbors >= min_points) {
+					is_in_core[points[s].id] = LW_TRUE;
+					in_a_cluster[points[s].id] = LW_TRUE;
+				}
+			}
+		});
+
+		/* Neighboring core points share their cluster */
+		dbscan_parallel_for(num_geoms, num_threads, [&](uint32_t begin, uint32_t end) {
+			for (uint32_t s = begin; s < end; s++) {
+				uint32_t p = points[s].id;
+				if (!is_in_core[p])
+					continue;
+				dbscan_for_each_neighbor(points, s, chord2, [&](const DBSCANPoint &q) {
+					if (q.id > p && is_in_core[q.id])
+						UF_union_concurrent(uf, p, q.id);
+					return true;
+				});
+			}
+		});
+
+		/* Border points join a single cluster */
+		dbscan_parallel_for(num_geoms, num_threads, [&](uint32_t begin, uint32_t end) {
+			for (uint32_t s = begin; s < end; s++) {
+				uint32_t p = points[s].id;
+				if (is_in_core[p])
+					continue;
+				uint32_t core = num_geoms;
+				dbscan_for_each_neighbor(points, s, chord2, [&](const DBSCANPoint &q) {
+					if (is_in_core[q.id] && q.id < core)
+						core = q.id;
+					return true;
+				});
+				if (core < num_geoms) {
+					UF_union_concurrent(uf, p, core);
+					in_a_cluster[p] = LW_TRUE;
+				}
+			}
+		});
+	}
+
+	UF_finish_concurrent(uf);
+
+	if (!in_a_cluster_ret)
+		lwfree(in_a_cluster);
+
+	return LW_SUCCESS;
+}
+
+int union_dbscan_geodetic(LWGEOM **geoms, uint32_t num_geoms, UNIONFIND *uf, double eps, uint32_t min_points,
+                          uint32_t max_threads, char **in_a_cluster_ret) {
+	SPHEROID sphere;
+	uint32_t i;
+	char all_points = LW_TRUE;
+
+	spheroid_init(&sphere, WGS84_RADIUS, WGS84_RADIUS);
+
+	for (i = 0; i < num_geoms; i++) {
+		if (lwgeom_get_type(geoms[i]) != POINTTYPE || lwgeom_is_empty(geoms[i]))
+			all_points = LW_FALSE;
+
+		/* The spheroid distance takes the boxes it finds as geocentric */
+		if (geoms[i]->bbox && !FLAGS_GET_GEODETIC(geoms[i]->flags))
+			lwgeom_drop_bbox(geoms[i]);
+	}
+
+	if (all_points && num_geoms > 0)
+		return union_dbscan_sphere_points(geoms, num_geoms, uf, eps, min_points, max_threads, &sphere,
+		                                  in_a_cluster_ret);
+	else if (min_points <= 1)
+		return union_dbscan_minpoints_1(geoms, num_geoms, uf, eps, in_a_cluster_ret, &sphere);
 	else
-		return union_dbscan_general(geoms, num_geoms, uf, eps, min_points, in_a_cluster_ret);
+		return union_dbscan_general(geoms, num_geoms, uf, eps, min_points, in_a_cluster_ret, &sphere);
 }
 
 } // namespace duckdb
@@ -24,366 +24,666 @@
  *
  **********************************************************************/
 
-#include "json.hpp"
-#include "liblwgeom/liblwgeom_internal.hpp"
+#include "liblwgeom/lwin_geojson.hpp"
 #include "liblwgeom/lwinline.hpp"
 
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 
-using namespace json;
-
 namespace duckdb {
 
-/* Prototype */
-static LWGEOM *parse_geojson(json_object *geojson, int *hasz);
-
-static inline json_object *findMemberByName(json_object *poObj, const char *pszName) {
-	json_object *poTmp;
-	json_object_iter it;
+/* Powers of ten exact in a double */
+static const double geojson_pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                       1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
 
-	poTmp = poObj;
+void geojson_parser_init(geojson_parser *p, const char *json) {
+	p->start = json;
+	p->cur = json;
+	p->depth = 0;
+	p->hasz = LW_FALSE;
+}
 
-	if (!pszName || !poObj)
-		return NULL;
+void geojson_syntax_error(geojson_parser *p, const char *msg) {
+	char err[256];
+	snprintf(err, 256, "%s (at offset %d)", *p->cur ? msg : "unexpected end of data", (int)(p->cur - p->start));
+	lwerror(err);
+}
 
-	it.key = NULL;
-	it.val = NULL;
-	it.entry = NULL;
+static inline int geojson_hex(geojson_parser *p) {
+	int value = 0;
+	for (int i = 0; i < 4; i++, p->cur++) {
+		char c = *p->cur;
+		value <<= 4;
+		if (c >= '0' && c <= '9')
+			value |= c - '0';
+		else if (c >= 'a' && c <= 'f')
+			value |= c - 'a' + 10;
+		else if (c >= 'A' && c <= 'F')
+			value |= c - 'A' + 10;
+		else
+			geojson_syntax_error(p, "invalid unicode escape");
+	}
+	return value;
+}
 
-	if (json_object_get_object(poTmp)) {
-		if (!json_object_get_object(poTmp)->head) {
-			lwerror("invalid GeoJSON representation");
-			return NULL;
+void geojson_parse_string(geojson_parser *p) {
+	p->str.clear();
+	p->cur++;
+	for (;;) {
+		const char *run = p->cur;
+		while (*p->cur != '"' && *p->cur != '\\' && *p->cur != '\0')
+			p->cur++;
+		p->str.append(run, p->cur - run);
+		if (*p->cur == '"')
+			break;
+		if (*p->cur == '\0')
+			geojson_syntax_error(p, "unterminated string");
+		p->cur++;
+		switch (*p->cur++) {
+		case '"':
+			p->str += '"';
+			break;
+		case '\\':
+			p->str += '\\';
+			break;
+		case '/':
+			p->str += '/';
+			break;
+		case 'b':
+			p->str += '\b';
+			break;
+		case 'f':
+			p->str += '\f';
+			break;
+		case 'n':
+			p->str += '\n';
+			break;
+		case 'r':
+			p->str += '\r';
+			break;
+		case 't':
+			p->str += '\t';
+			break;
+		case 'u': {
+			uint32_t cp = geojson_hex(p);
+			if (cp >= 0xD800 && cp < 0xDC00 && p->cur[0] == '\\' && p->cur[1] == 'u') {
+				p->cur += 2;
+				uint32_t low = geojson_hex(p);
+				cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+			}
+			if (cp < 0x80) {
+				p->str += (char)cp;
+			} else if (cp < 0x800) {
+				p->str += (char)(0xC0 | (cp >> 6));
+				p->str += (char)(0x80 | (cp & 0x3F));
+			} else if (cp < 0x10000) {
+				p->str += (char)(0xE0 | (cp >> 12));
+				p->str += (char)(0x80 | ((cp >> 6) & 0x3F));
+				p->str += (char)(0x80 | (cp & 0x3F));
+			} else {
+				p->str += (char)(0xF0 | (cp >> 18));
+				p->str += (char)(0x80 | ((cp >> 12) & 0x3F));
+				p->str += (char)(0x80 | ((cp >> 6) & 0x3F));
+				p->str += (char)(0x80 | (cp & 0x3F));
+			}
+			break;
 		}
-
-		for (it.entry = json_object_get_object(poTmp)->head;
-		     (it.entry ? (it.key = (char *)it.entry->k, it.val = (json_object *)it.entry->v, it.entry) : 0);
-		     it.entry = it.entry->next) {
-			if (strcasecmp((char *)it.key, pszName) == 0)
-				return it.val;
+		default:
+			p->cur--;
+			geojson_syntax_error(p, "invalid string escape");
 		}
 	}
-
-	return NULL;
+	p->cur++;
 }
 
-static inline json_object *parse_coordinates(json_object *geojson) {
-	json_object *coordinates = findMemberByName(geojson, "coordinates");
-	if (!coordinates) {
-		lwerror("Unable to find 'coordinates' in GeoJSON string");
-		return NULL;
+static void geojson_skip_string(geojson_parser *p) {
+	p->cur++;
+	while (*p->cur != '"') {
+		if (*p->cur == '\0')
+			geojson_syntax_error(p, "unterminated string");
+		if (*p->cur == '\\' && p->cur[1] != '\0')
+			p->cur++;
+		p->cur++;
 	}
+	p->cur++;
+}
 
-	if (json_type_array != json_object_get_type(coordinates)) {
-		lwerror("The 'coordinates' in GeoJSON are not an array");
-		return NULL;
-	}
-	return coordinates;
+void geojson_parse_key(geojson_parser *p) {
+	geojson_skip_ws(p);
+	if (*p->cur != '"')
+		geojson_syntax_error(p, "quoted object property name expected");
+	geojson_parse_string(p);
+	geojson_expect(p, ':', "object property name separator ':' expected");
 }
 
-static inline int parse_geojson_coord(json_object *poObj, int *hasz, POINTARRAY *pa) {
-	POINT4D pt = {0, 0, 0, 0};
+static inline int geojson_is_digit(char c) {
+	return c >= '0' && c <= '9';
+}
 
-	if (json_object_get_type(poObj) == json_type_array) {
-		json_object *poObjCoord = NULL;
-		const int nSize = json_object_array_length(poObj);
-		if (nSize < 2) {
-			lwerror("Too few ordinates in GeoJSON");
-			return LW_FAILURE;
+/*
+ * Numbers of up to 15 significant digits and a decimal exponent within 22 are
+ * exact in a double along with the power of ten, so a single multiplication or
+ * division rounds them correctly. The longer ones go to strtod.
+ */
+double geojson_parse_number(geojson_parser *p) {
+	geojson_skip_ws(p);
+	const char *start = p->cur;
+	int negative = *p->cur == '-';
+	if (negative)
+		p->cur++;
+	if (!geojson_is_digit(*p->cur))
+		geojson_syntax_error(p, "invalid number");
+
+	uint64_t mantissa = 0;
+	int digits = 0;
+	int exponent = 0;
+	int integer = LW_TRUE;
+	if (*p->cur == '0') {
+		p->cur++;
+	} else {
+		for (; geojson_is_digit(*p->cur); p->cur++, digits++)
+			mantissa = mantissa * 10 + (*p->cur - '0');
+	}
+	if (*p->cur == '.') {
+		integer = LW_FALSE;
+		p->cur++;
+		if (!geojson_is_digit(*p->cur))
+			geojson_syntax_error(p, "invalid number");
+		for (; geojson_is_digit(*p->cur); p->cur++, exponent--) {
+			/* The zeros in front of the first significant digit are not counted */
+			if (mantissa || *p->cur != '0') {
+				mantissa = mantissa * 10 + (*p->cur - '0');
+				digits++;
+			}
 		}
-
-		/* Read X coordinate */
-		poObjCoord = json_object_array_get_idx(poObj, 0);
-		pt.x = json_object_get_double(poObjCoord);
-
-		/* Read Y coordinate */
-		poObjCoord = json_object_array_get_idx(poObj, 1);
-		pt.y = json_object_get_double(poObjCoord);
-
-		if (nSize > 2) /* should this be >= 3 ? */
-		{
-			/* Read Z coordinate */
-			poObjCoord = json_object_array_get_idx(poObj, 2);
-			pt.z = json_object_get_double(poObjCoord);
-			*hasz = LW_TRUE;
+	}
+	if (*p->cur == 'e' || *p->cur == 'E') {
+		integer = LW_FALSE;
+		p->cur++;
+		int exponent_negative = *p->cur == '-';
+		if (*p->cur == '-' || *p->cur == '+')
+			p->cur++;
+		if (!geojson_is_digit(*p->cur))
+			geojson_syntax_error(p, "invalid number");
+		int value = 0;
+		for (; geojson_is_digit(*p->cur); p->cur++) {
+			if (value < 100000)
+				value = value * 10 + (*p->cur - '0');
 		}
-	} else {
-		/* If it's not an array, just don't handle it */
-		lwerror("The 'coordinates' in GeoJSON are not sufficiently nested");
-		return LW_FAILURE;
+		exponent += exponent_negative ? -value : value;
 	}
 
-	return ptarray_append_point(pa, &pt, LW_TRUE);
+	/* Integers are read as such, without a negative zero. Only 0 has no digits, a mantissa of 0 may have wrapped */
+	if (integer && !digits)
+		return 0;
+	if (digits > 15 || exponent < -22 || exponent > 22)
+		return strtod(start, NULL);
+	double result = (double)mantissa;
+	result = exponent < 0 ? result / geojson_pow10[-exponent] : result * geojson_pow10[exponent];
+	return negative ? -result : result;
 }
 
-static inline LWGEOM *parse_geojson_point(json_object *geojson, int *hasz) {
-	json_object *coords = parse_coordinates(geojson);
-	if (!coords)
-		return NULL;
-	POINTARRAY *pa = ptarray_construct_empty(1, 0, 1);
-	parse_geojson_coord(coords, hasz, pa);
-	return (LWGEOM *)lwpoint_construct(0, NULL, pa);
+void geojson_skip_value(geojson_parser *p) {
+	geojson_skip_ws(p);
+	switch (*p->cur) {
+	case '"':
+		geojson_skip_string(p);
+		break;
+	case '{':
+		geojson_enter(p);
+		p->cur++;
+		if (!geojson_accept(p, '}')) {
+			do {
+				geojson_parse_key(p);
+				geojson_skip_value(p);
+			} while (geojson_accept(p, ','));
+			geojson_expect(p, '}', "object value separator ',' expected");
+		}
+		p->depth--;
+		break;
+	case '[':
+		geojson_enter(p);
+		p->cur++;
+		if (!geojson_accept(p, ']')) {
+			do {
+				geojson_skip_value(p);
+			} while (geojson_accept(p, ','));
+			geojson_expect(p, ']', "array value separator ',' expected");
+		}
+		p->depth--;
+		break;
+	case 't':
+		if (strncmp(p->cur, "true", 4) != 0)
+			geojson_syntax_error(p, "unexpected character");
+		p->cur += 4;
+		break;
+	case 'f':
+		if (strncmp(p->cur, "false", 5) != 0)
+			geojson_syntax_error(p, "unexpected character");
+		p->cur += 5;
+		break;
+	case 'n':
+		if (strncmp(p->cur, "null", 4) != 0)
+			geojson_syntax_error(p, "unexpected character");
+		p->cur += 4;
+		break;
+	default:
+		geojson_parse_number(p);
+	}
 }
 
-static inline LWGEOM *parse_geojson_linestring(json_object *geojson, int *hasz) {
-	json_object *points = parse_coordinates(geojson);
-	if (!points)
-		return NULL;
-	POINTARRAY *pa = ptarray_construct_empty(1, 0, 1);
-	const int nPoints = json_object_array_length(points);
-	for (int i = 0; i < nPoints; i++) {
-		json_object *coords = json_object_array_get_idx(points, i);
-		parse_geojson_coord(coords, hasz, pa);
-	}
-	return (LWGEOM *)lwline_construct(0, NULL, pa);
+/* json-c read a quoted ordinate with strtod, as 0 when it isn't wholly a number or is out of range */
+static double geojson_parse_ordinate(geojson_parser *p) {
+	geojson_skip_ws(p);
+	if (*p->cur != '"')
+		return geojson_parse_number(p);
+	geojson_parse_string(p);
+	const char *str = p->str.c_str();
+	char *end;
+	errno = 0;
+	double value = strtod(str, &end);
+	if (end == str || *end != '\0' || (errno == ERANGE && std::isinf(value)))
+		return 0;
+	return value;
 }
 
-static inline LWPOLY *parse_geojson_poly_rings(json_object *rings, int *hasz) {
-	if (!rings || json_object_get_type(rings) != json_type_array)
-		return NULL;
-
-	int nRings = json_object_array_length(rings);
-
-	/* No rings => POLYGON EMPTY */
-	if (!nRings)
-		return lwpoly_construct_empty(0, 1, 0);
+/*
+ * lwerror throws, so a geometry under construction belongs to one of these
+ * until it is handed to its parent. Without the arena it would leak otherwise.
+ */
+struct geojson_ptarray_owner {
+	POINTARRAY *pa;
+	explicit geojson_ptarray_owner(POINTARRAY *pa) : pa(pa) {
+	}
+	~geojson_ptarray_owner() {
+		if (pa)
+			ptarray_free(pa);
+	}
+	POINTARRAY *release() {
+		POINTARRAY *result = pa;
+		pa = NULL;
+		return result;
+	}
+};
 
-	/* Expecting up to nRings otherwise */
-	POINTARRAY **ppa = (POINTARRAY **)lwalloc(sizeof(POINTARRAY *) * nRings);
-	int o = 0;
+struct geojson_geom_owner {
+	LWGEOM *geom;
+	explicit geojson_geom_owner(LWGEOM *geom) : geom(geom) {
+	}
+	~geojson_geom_owner() {
+		if (geom)
+			lwgeom_free(geom);
+	}
+	LWGEOM *release() {
+		LWGEOM *result = geom;
+		geom = NULL;
+		return result;
+	}
+};
 
-	for (int i = 0; i < nRings; i++) {
-		json_object *points = json_object_array_get_idx(rings, i);
-		if (!points || json_object_get_type(points) != json_type_array) {
-			for (int k = 0; k < o; k++)
-				ptarray_free(ppa[k]);
-			lwfree(ppa);
-			lwerror("The 'coordinates' in GeoJSON ring are not an array");
-			return NULL;
-		}
-		int nPoints = json_object_array_length(points);
+static inline void geojson_parse_position(geojson_parser *p, POINTARRAY *pa) {
+	POINT4D pt = {0, 0, 0, 0};
+	int nordinates = 0;
 
-		/* Skip empty rings */
-		if (!nPoints) {
-			/* Empty outer? Don't promote first hole to outer, holes don't matter. */
-			if (!i)
-				break;
+	if (!geojson_accept(p, '['))
+		lwerror("The 'coordinates' in GeoJSON are not sufficiently nested");
+	if (!geojson_accept(p, ']')) {
+		do {
+			if (nordinates == 0)
+				pt.x = geojson_parse_ordinate(p);
+			else if (nordinates == 1)
+				pt.y = geojson_parse_ordinate(p);
+			else if (nordinates == 2)
+				pt.z = geojson_parse_ordinate(p);
 			else
-				continue;
-		}
-
-		ppa[o] = ptarray_construct_empty(1, 0, 1);
-		for (int j = 0; j < nPoints; j++) {
-			json_object *coords = NULL;
-			coords = json_object_array_get_idx(points, j);
-			if (LW_FAILURE == parse_geojson_coord(coords, hasz, ppa[o])) {
-				for (int k = 0; k <= o; k++)
-					ptarray_free(ppa[k]);
-				lwfree(ppa);
-				lwerror("The 'coordinates' in GeoJSON are not sufficiently nested");
-				return NULL;
-			}
-		}
-		o++;
-	}
-
-	/* All the rings were empty! */
-	if (!o) {
-		lwfree(ppa);
-		return lwpoly_construct_empty(0, 1, 0);
+				geojson_skip_value(p);
+			nordinates++;
+		} while (geojson_accept(p, ','));
+		geojson_expect(p, ']', "array value separator ',' expected");
 	}
 
-	return lwpoly_construct(0, NULL, o, ppa);
+	if (nordinates < 2)
+		lwerror("Too few ordinates in GeoJSON");
+	if (nordinates > 2)
+		p->hasz = LW_TRUE;
+	ptarray_append_point(pa, &pt, LW_TRUE);
 }
 
-static inline LWGEOM *parse_geojson_polygon(json_object *geojson, int *hasz) {
-	return (LWGEOM *)parse_geojson_poly_rings(parse_coordinates(geojson), hasz);
-}
-
-static inline LWGEOM *parse_geojson_multipoint(json_object *geojson, int *hasz) {
-	json_object *points = parse_coordinates(geojson);
-	if (!points)
-		return NULL;
-	LWMPOINT *geom = (LWMPOINT *)lwcollection_construct_empty(MULTIPOINTTYPE, 0, 1, 0);
-
-	const int nPoints = json_object_array_length(points);
-	for (int i = 0; i < nPoints; ++i) {
-		POINTARRAY *pa = ptarray_construct_empty(1, 0, 1);
-		json_object *coord = json_object_array_get_idx(points, i);
-		if (parse_geojson_coord(coord, hasz, pa))
-			geom = lwmpoint_add_lwpoint(geom, lwpoint_construct(0, NULL, pa));
-		else {
-			lwmpoint_free(geom);
-			ptarray_free(pa);
-			return NULL;
-		}
+static POINTARRAY *geojson_parse_positions(geojson_parser *p) {
+	if (!geojson_accept(p, '['))
+		lwerror("The 'coordinates' in GeoJSON are not an array");
+	geojson_ptarray_owner pa(ptarray_construct_empty(1, 0, 1));
+	if (!geojson_accept(p, ']')) {
+		do {
+			geojson_parse_position(p, pa.pa);
+		} while (geojson_accept(p, ','));
+		geojson_expect(p, ']', "array value separator ',' expected");
 	}
-
-	return (LWGEOM *)geom;
+	return pa.release();
 }
 
-static inline LWGEOM *parse_geojson_multilinestring(json_object *geojson, int *hasz) {
-	json_object *mls = parse_coordinates(geojson);
-	if (!mls)
-		return NULL;
-	LWMLINE *geom = (LWMLINE *)lwcollection_construct_empty(MULTILINETYPE, 0, 1, 0);
-	const int nLines = json_object_array_length(mls);
-	for (int i = 0; i < nLines; ++i) {
-		POINTARRAY *pa = ptarray_construct_empty(1, 0, 1);
-		json_object *coords = json_object_array_get_idx(mls, i);
-
-		if (json_type_array == json_object_get_type(coords)) {
-			const int nPoints = json_object_array_length(coords);
-			for (int j = 0; j < nPoints; ++j) {
-				json_object *coord = json_object_array_get_idx(coords, j);
-				if (!parse_geojson_coord(coord, hasz, pa)) {
-					lwmline_free(geom);
-					ptarray_free(pa);
-					return NULL;
-				}
+static LWPOLY *geojson_parse_rings(geojson_parser *p) {
+	if (!geojson_accept(p, '['))
+		lwerror("The 'coordinates' in GeoJSON ring are not an array");
+	LWPOLY *poly = lwpoly_construct_empty(0, 1, 0);
+	geojson_geom_owner owner((LWGEOM *)poly);
+	int empty_shell = LW_FALSE;
+	if (!geojson_accept(p, ']')) {
+		do {
+			/* Skip empty rings, and all of them after an empty shell: holes don't matter then */
+			if (empty_shell) {
+				geojson_skip_value(p);
+				continue;
 			}
-			geom = lwmline_add_lwline(geom, lwline_construct(0, NULL, pa));
-		} else {
-			lwmline_free(geom);
-			ptarray_free(pa);
-			return NULL;
-		}
+			POINTARRAY *pa = geojson_parse_positions(p);
+			if (!pa->npoints) {
+				empty_shell = !poly->nrings;
+				ptarray_free(pa);
+				continue;
+			}
+			lwpoly_add_ring(poly, pa);
+		} while (geojson_accept(p, ','));
+		geojson_expect(p, ']', "array value separator ',' expected");
 	}
-	return (LWGEOM *)geom;
+	return (LWPOLY *)owner.release();
 }
 
-static inline LWGEOM *parse_geojson_multipolygon(json_object *geojson, int *hasz) {
-	json_object *polys = parse_coordinates(geojson);
-	if (!polys)
-		return NULL;
-	LWGEOM *geom = (LWGEOM *)lwcollection_construct_empty(MULTIPOLYGONTYPE, 0, 1, 0);
-	int nPolys = json_object_array_length(polys);
+static LWGEOM *geojson_parse_coordinates(geojson_parser *p, uint8_t type) {
+	geojson_skip_ws(p);
+	if (*p->cur != '[')
+		lwerror("The 'coordinates' in GeoJSON are not an array");
 
-	for (int i = 0; i < nPolys; ++i) {
-		json_object *rings = json_object_array_get_idx(polys, i);
-		LWPOLY *poly = parse_geojson_poly_rings(rings, hasz);
-		if (poly)
-			geom = (LWGEOM *)lwmpoly_add_lwpoly((LWMPOLY *)geom, poly);
+	switch (type) {
+	case POINTTYPE: {
+		geojson_ptarray_owner pa(ptarray_construct_empty(1, 0, 1));
+		geojson_parse_position(p, pa.pa);
+		return (LWGEOM *)lwpoint_construct(0, NULL, pa.release());
 	}
-
-	return geom;
-}
-
-static inline LWGEOM *parse_geojson_geometrycollection(json_object *geojson, int *hasz) {
-	json_object *poObjGeoms = findMemberByName(geojson, "geometries");
-	if (!poObjGeoms) {
-		lwerror("Unable to find 'geometries' in GeoJSON string");
-		return NULL;
-	}
-	LWGEOM *geom = (LWGEOM *)lwcollection_construct_empty(COLLECTIONTYPE, 0, 1, 0);
-
-	if (json_type_array == json_object_get_type(poObjGeoms)) {
-		const int nGeoms = json_object_array_length(poObjGeoms);
-		for (int i = 0; i < nGeoms; ++i) {
-			json_object *poObjGeom = json_object_array_get_idx(poObjGeoms, i);
-			LWGEOM *t = parse_geojson(poObjGeom, hasz);
-			if (t)
-				geom = (LWGEOM *)lwcollection_add_lwgeom((LWCOLLECTION *)geom, t);
-			else {
-				lwgeom_free(geom);
-				return NULL;
-			}
+	case LINETYPE:
+		return (LWGEOM *)lwline_construct(0, NULL, geojson_parse_positions(p));
+	case POLYGONTYPE:
+		return (LWGEOM *)geojson_parse_rings(p);
+	case MULTIPOINTTYPE: {
+		geojson_geom_owner geom((LWGEOM *)lwcollection_construct_empty(MULTIPOINTTYPE, 0, 1, 0));
+		p->cur++;
+		if (!geojson_accept(p, ']')) {
+			do {
+				geojson_ptarray_owner pa(ptarray_construct_empty(1, 0, 1));
+				geojson_parse_position(p, pa.pa);
+				geom.geom = (LWGEOM *)lwmpoint_add_lwpoint((LWMPOINT *)geom.geom,
+				                                           lwpoint_construct(0, NULL, pa.release()));
+			} while (geojson_accept(p, ','));
+			geojson_expect(p, ']', "array value separator ',' expected");
 		}
+		return geom.release();
+	}
+	case MULTILINETYPE: {
+		geojson_geom_owner geom((LWGEOM *)lwcollection_construct_empty(MULTILINETYPE, 0, 1, 0));
+		p->cur++;
+		if (!geojson_accept(p, ']')) {
+			do {
+				geom.geom = (LWGEOM *)lwmline_add_lwline((LWMLINE *)geom.geom,
+				                                         lwline_construct(0, NULL, geojson_parse_positions(p)));
+			} while (geojson_accept(p, ','));
+			geojson_expect(p, ']', "array value separator ',' expected");
+		}
+		return geom.release();
+	}
+	default: {
+		geojson_geom_owner geom((LWGEOM *)lwcollection_construct_empty(MULTIPOLYGONTYPE, 0, 1, 0));
+		p->cur++;
+		if (!geojson_accept(p, ']')) {
+			do {
+				/* A member that is not an array of rings is left out */
+				geojson_skip_ws(p);
+				if (*p->cur != '[') {
+					geojson_skip_value(p);
+					continue;
+				}
+				geom.geom = (LWGEOM *)lwmpoly_add_lwpoly((LWMPOLY *)geom.geom, geojson_parse_rings(p));
+			} while (geojson_accept(p, ','));
+			geojson_expect(p, ']', "array value separator ',' expected");
+		}
+		return geom.release();
+	}
 	}
-
-	return geom;
 }
 
-static inline LWGEOM *parse_geojson(json_object *geojson, int *hasz) {
-	json_object *type = NULL;
-	const char *name;
+static LWGEOM *geojson_parse_object(geojson_parser *p, char **srs);
 
-	if (!geojson) {
-		lwerror("invalid GeoJSON representation");
-		return NULL;
+static LWGEOM *geojson_parse_geometries(geojson_parser *p) {
+	geojson_geom_owner geom((LWGEOM *)lwcollection_construct_empty(COLLECTIONTYPE, 0, 1, 0));
+	/* Anything else than an array is an empty collection */
+	geojson_skip_ws(p);
+	if (*p->cur != '[') {
+		geojson_skip_value(p);
+		return geom.release();
+	}
+	geojson_enter(p);
+	p->cur++;
+	if (!geojson_accept(p, ']')) {
+		do {
+			geom.geom = (LWGEOM *)lwcollection_add_lwgeom((LWCOLLECTION *)geom.geom, geojson_parse_object(p, NULL));
+		} while (geojson_accept(p, ','));
+		geojson_expect(p, ']', "array value separator ',' expected");
 	}
+	p->depth--;
+	return geom.release();
+}
 
-	type = findMemberByName(geojson, "type");
-	if (!type) {
-		lwerror("unknown GeoJSON type");
-		return NULL;
+/* Keep the name of a {"type": ..., "properties": {"name": ...}} crs */
+static void geojson_parse_crs(geojson_parser *p, char **srs) {
+	geojson_skip_ws(p);
+	if (*p->cur != '{') {
+		geojson_skip_value(p);
+		return;
+	}
+	int has_type = LW_FALSE;
+	int has_name = LW_FALSE;
+	std::string name;
+
+	geojson_enter(p);
+	p->cur++;
+	if (!geojson_accept(p, '}')) {
+		do {
+			geojson_parse_key(p);
+			geojson_skip_ws(p);
+			if (strcasecmp(p->str.c_str(), "type") == 0) {
+				has_type = LW_TRUE;
+				geojson_skip_value(p);
+			} else if (strcasecmp(p->str.c_str(), "properties") == 0 && *p->cur == '{' && !has_name) {
+				geojson_enter(p);
+				p->cur++;
+				if (!geojson_accept(p, '}')) {
+					do {
+						geojson_parse_key(p);
+						geojson_skip_ws(p);
+						if (strcasecmp(p->str.c_str(), "name") == 0 && *p->cur == '"' && !has_name) {
+							geojson_parse_string(p);
+							name = p->str;
+							has_name = LW_TRUE;
+						} else {
+							geojson_skip_value(p);
+						}
+					} while (geojson_accept(p, ','));
+					geojson_expect(p, '}', "object value separator ',' expected");
+				}
+				p->depth--;
+			} else {
+				geojson_skip_value(p);
+			}
+		} while (geojson_accept(p, ','));
+		geojson_expect(p, '}', "object value separator ',' expected");
 	}
+	p->depth--;
 
-	name = json_object_get_string(type);
+	if (has_type && has_name) {
+		*srs = (char *)lwalloc(name.size() + 1);
+		memcpy(*srs, name.c_str(), name.size() + 1);
+	}
+}
 
+static uint8_t geojson_type(const char *name) {
 	if (strcasecmp(name, "Point") == 0)
-		return parse_geojson_point(geojson, hasz);
-
+		return POINTTYPE;
 	if (strcasecmp(name, "LineString") == 0)
-		return parse_geojson_linestring(geojson, hasz);
-
+		return LINETYPE;
 	if (strcasecmp(name, "Polygon") == 0)
-		return parse_geojson_polygon(geojson, hasz);
-
+		return POLYGONTYPE;
 	if (strcasecmp(name, "MultiPoint") == 0)
-		return parse_geojson_multipoint(geojson, hasz);
-
+		return MULTIPOINTTYPE;
 	if (strcasecmp(name, "MultiLineString") == 0)
-		return parse_geojson_multilinestring(geojson, hasz);
-
+		return MULTILINETYPE;
 	if (strcasecmp(name, "MultiPolygon") == 0)
-		return parse_geojson_multipolygon(geojson, hasz);
-
+		return MULTIPOLYGONTYPE;
 	if (strcasecmp(name, "GeometryCollection") == 0)
-		return parse_geojson_geometrycollection(geojson, hasz);
-
-	// Need to do with postgis
-
-	lwerror("invalid GeoJson representation");
-	return NULL; /* Never reach */
+		return COLLECTIONTYPE;
+	return 0;
 }
 
-LWGEOM *lwgeom_from_geojson(const char *geojson, char **srs) {
-	/* Begin to Parse json */
-	json_tokener *jstok = json_tokener_new();
-	json_object *poObj = json_tokener_parse_ex(jstok, geojson, -1);
-	if (jstok->err != json_tokener_success) {
-		char err[256];
-		snprintf(err, 256, "%s (at offset %d)", json_tokener_error_desc(jstok->err), jstok->char_offset);
-		json_tokener_free(jstok);
-		json_object_put(poObj);
-		lwerror(err);
-		return NULL;
-	}
-	json_tokener_free(jstok);
-
-	*srs = NULL;
-	json_object *poObjSrs = findMemberByName(poObj, "crs");
-	if (poObjSrs != NULL) {
-		json_object *poObjSrsType = findMemberByName(poObjSrs, "type");
-		if (poObjSrsType != NULL) {
-			json_object *poObjSrsProps = findMemberByName(poObjSrs, "properties");
-			if (poObjSrsProps) {
-				json_object *poNameURL = findMemberByName(poObjSrsProps, "name");
-				if (poNameURL) {
-					const char *pszName = json_object_get_string(poNameURL);
-					if (pszName) {
-						*srs = (char *)lwalloc(strlen(pszName) + 1);
-						strcpy(*srs, pszName);
-					}
+/*
+ * The coordinates (or geometries) are read as soon as the type is known. When
+ * they come first they are skipped, and read from their position at the end.
+ */
+static LWGEOM *geojson_parse_object(geojson_parser *p, char **srs) {
+	int has_type = LW_FALSE;
+	uint8_t type = 0;
+	const char *coordinates = NULL;
+	const char *geometries = NULL;
+	geojson_geom_owner geom(NULL);
+
+	if (!geojson_accept(p, '{'))
+		lwerror("invalid GeoJSON representation");
+	geojson_enter(p);
+	if (!geojson_accept(p, '}')) {
+		do {
+			geojson_parse_key(p);
+			geojson_skip_ws(p);
+			const char *key = p->str.c_str();
+			if (!has_type && strcasecmp(key, "type") == 0) {
+				has_type = LW_TRUE;
+				if (*p->cur == '"') {
+					geojson_parse_string(p);
+					type = geojson_type(p->str.c_str());
+				} else {
+					geojson_skip_value(p);
 				}
+			} else if (!coordinates && strcasecmp(key, "coordinates") == 0) {
+				coordinates = p->cur;
+				if (type && type != COLLECTIONTYPE)
+					geom.geom = geojson_parse_coordinates(p, type);
+				else
+					geojson_skip_value(p);
+			} else if (!geometries && strcasecmp(key, "geometries") == 0) {
+				geometries = p->cur;
+				if (type == COLLECTIONTYPE)
+					geom.geom = geojson_parse_geometries(p);
+				else
+					geojson_skip_value(p);
+			} else if (srs && !*srs && strcasecmp(key, "crs") == 0) {
+				geojson_parse_crs(p, srs);
+			} else {
+				geojson_skip_value(p);
 			}
+		} while (geojson_accept(p, ','));
+		geojson_expect(p, '}', "object value separator ',' expected");
+	}
+
+	if (!has_type)
+		lwerror("unknown GeoJSON type");
+	if (!type)
+		lwerror("invalid GeoJson representation");
+	if (!geom.geom) {
+		const char *end = p->cur;
+		if (type == COLLECTIONTYPE) {
+			if (!geometries)
+				lwerror("Unable to find 'geometries' in GeoJSON string");
+			p->cur = geometries;
+			geom.geom = geojson_parse_geometries(p);
+		} else {
+			if (!coordinates)
+				lwerror("Unable to find 'coordinates' in GeoJSON string");
+			p->cur = coordinates;
+			geom.geom = geojson_parse_coordinates(p, type);
 		}
+		p->cur = end;
 	}
+	p->depth--;
+	return geom.release();
+}
 
-	int hasz = LW_FALSE;
-	LWGEOM *lwgeom = parse_geojson(poObj, &hasz);
-	json_object_put(poObj);
-	if (!lwgeom)
-		return NULL;
+/* The positions are read as 3D, the Z is dropped in place when none of them had one */
+static void ptarray_drop_z_in_place(POINTARRAY *pa) {
+	double *ordinates = (double *)pa->serialized_pointlist;
+	for (uint32_t i = 0; i < pa->npoints; i++) {
+		ordinates[2 * i] = ordinates[3 * i];
+		ordinates[2 * i + 1] = ordinates[3 * i + 1];
+	}
+	FLAGS_SET_Z(pa->flags, 0);
+}
 
-	if (!hasz) {
-		LWGEOM *tmp = lwgeom_force_2d(lwgeom);
-		lwgeom_free(lwgeom);
-		lwgeom = tmp;
+static void lwgeom_drop_z_in_place(LWGEOM *geom) {
+	FLAGS_SET_Z(geom->flags, 0);
+	switch (geom->type) {
+	case POINTTYPE:
+		ptarray_drop_z_in_place(((LWPOINT *)geom)->point);
+		break;
+	case LINETYPE:
+		ptarray_drop_z_in_place(((LWLINE *)geom)->points);
+		break;
+	case POLYGONTYPE: {
+		LWPOLY *poly = (LWPOLY *)geom;
+		for (uint32_t i = 0; i < poly->nrings; i++)
+			ptarray_drop_z_in_place(poly->rings[i]);
+		break;
+	}
+	default: {
+		/* A collection of empties is an empty collection in 2D, like lwgeom_force_2d makes it */
+		LWCOLLECTION *col = (LWCOLLECTION *)geom;
+		if (lwcollection_is_empty(col)) {
+			for (uint32_t i = 0; i < col->ngeoms; i++)
+				lwgeom_free(col->geoms[i]);
+			col->ngeoms = 0;
+		}
+		for (uint32_t i = 0; i < col->ngeoms; i++)
+			lwgeom_drop_z_in_place(col->geoms[i]);
 	}
+	}
+}
+
+LWGEOM *geojson_parse_geometry(geojson_parser *p, char **srs) {
+	p->hasz = LW_FALSE;
+	LWGEOM *lwgeom = geojson_parse_object(p, srs);
+	if (!p->hasz)
+		lwgeom_drop_z_in_place(lwgeom);
 	lwgeom_add_bbox(lwgeom);
 	return lwgeom;
 }
 
+LWGEOM *lwgeom_from_geojson(const char *geojson, char **srs) {
+	geojson_parser p;
+	geojson_parser_init(&p, geojson);
+
+	*srs = NULL;
+	try {
+		geojson_skip_ws(&p);
+		if (*p.cur != '{')
+			geojson_syntax_error(&p, "unexpected character");
+		geojson_geom_owner lwgeom(geojson_parse_geometry(&p, srs));
+		geojson_skip_ws(&p);
+		if (*p.cur != '\0')
+			geojson_syntax_error(&p, "unexpected character");
+		return lwgeom.release();
+	} catch (...) {
+		/* The crs may have been read before the error */
+		if (*srs)
+			lwfree(*srs);
+		*srs = NULL;
+		throw;
+	}
+}
+
 } // namespace duckdb
@@ -91,6 +91,17 @@ static inline void wkb_parse_state_check(wkb_parse_state *s, size_t next) {
 	}
 }
 
+/**
+ * Step over the box header of a stored geography, if there is one, so the
+ * readers take values written with and without it.
+ */
+static inline void wkb_skip_header(const uint8_t **wkb, size_t *wkb_size) {
+	if (*wkb && *wkb_size >= WKB_HEADER_SIZE && (*wkb)[0] == WKB_HEADER_MAGIC) {
+		*wkb += WKB_HEADER_SIZE;
+		*wkb_size -= WKB_HEADER_SIZE;
+	}
+}
+
 /**
  * Take in an unknown kind of wkb type number and ensure it comes out
  * as an extended WKB type number (with Z/M/SRID flags masked onto the
@@ -257,9 +268,11 @@ uint8_t *bytes_from_hexbytes(const char *hexbuf, size_t hexsize) {
  * Check is a bitmask of: LW_PARSER_CHECK_MINPOINTS, LW_PARSER_CHECK_ODD,
  * LW_PARSER_CHECK_CLOSURE, LW_PARSER_CHECK_NONE, LW_PARSER_CHECK_ALL
  */
-LWGEOM *lwgeom_from_wkb(const uint8_t *wkb, const size_t wkb_size, const char check) {
+LWGEOM *lwgeom_from_wkb(const uint8_t *wkb, size_t wkb_size, const char check) {
 	wkb_parse_state s;
 
+	wkb_skip_header(&wkb, &wkb_size);
+
 	/* Initialize the state appropriately */
 	s.wkb = wkb;
 	s.wkb_size = wkb_size;
@@ -757,4 +770,282 @@ LWGEOM *lwgeom_from_wkb_state(wkb_parse_state *s) {
 	return NULL;
 }
 
+/**
+ * Grow the 2D box by one coordinate, the first one initializes it.
+ */
+static inline void gbox_merge_xy_wkb(GBOX *gbox, int *found, double x, double y) {
+	if (!*found) {
+		gbox->xmin = gbox->xmax = x;
+		gbox->ymin = gbox->ymax = y;
+		*found = LW_TRUE;
+		return;
+	}
+	gbox->xmin = FP_MIN(gbox->xmin, x);
+	gbox->xmax = FP_MAX(gbox->xmax, x);
+	gbox->ymin = FP_MIN(gbox->ymin, y);
+	gbox->ymax = FP_MAX(gbox->ymax, y);
+}
+
+/**
+ * Read the count and the coordinates of a point array, merging every
+ * point into the box, or only stepping over them when merge is false.
+ */
+static void ptarray_gbox_from_wkb_state(wkb_parse_state *s, GBOX *gbox, int *found, int merge) {
+	uint32_t ndims = 2 + (s->has_z ? 1 : 0) + (s->has_m ? 1 : 0);
+	uint32_t npoints = integer_from_wkb_state(s);
+	uint32_t i;
+	if (s->error)
+		return;
+	if (npoints > UINT_MAX / WKB_DOUBLE_SIZE / 4) {
+		lwerror("WKB structure does not match expected size!");
+		s->error = LW_TRUE;
+		return;
+	}
+
+	wkb_parse_state_check(s, (size_t)npoints * ndims * WKB_DOUBLE_SIZE);
+	if (s->error)
+		return;
+	if (!merge) {
+		s->pos += (size_t)npoints * ndims * WKB_DOUBLE_SIZE;
+		return;
+	}
+	for (i = 0; i < npoints; i++) {
+		double x = double_from_wkb_state(s);
+		double y = double_from_wkb_state(s);
+		s->pos += (ndims - 2) * WKB_DOUBLE_SIZE;
+		gbox_merge_xy_wkb(gbox, found, x, y);
+	}
+}
+
+/**
+ * Merge the planar box of the geometry at the current parse position,
+ * reading the coordinates in place instead of building the geometry.
+ * Like lwgeom_calculate_gbox_cartesian only the shell of a polygon
+ * counts. Curved types are built, as their arcs may bulge past the
+ * control points.
+ */
+static void gbox_from_wkb_state(wkb_parse_state *s, GBOX *gbox, int *found) {
+	const uint8_t *start = s->pos;
+	char wkb_little_endian;
+	uint32_t wkb_type, i, n;
+
+	wkb_little_endian = byte_from_wkb_state(s);
+	if (s->error)
+		return;
+	if (wkb_little_endian != 1 && wkb_little_endian != 0) {
+		lwerror("Invalid endian flag value encountered.");
+		s->error = LW_TRUE;
+		return;
+	}
+	s->swap_bytes = (IS_BIG_ENDIAN && wkb_little_endian) || (!IS_BIG_ENDIAN && !wkb_little_endian);
+
+	wkb_type = integer_from_wkb_state(s);
+	if (s->error)
+		return;
+	lwtype_from_wkb_state(s, wkb_type);
+	if (s->has_srid) {
+		int32_t srid = clamp_srid(integer_from_wkb_state(s));
+		if (s->error)
+			return;
+		/* Collections carry the SRID of their outermost header */
+		if (s->depth == 1)
+			s->srid = srid;
+	}
+
+	switch (s->lwtype) {
+	case POINTTYPE: {
+		uint32_t ndims = 2 + (s->has_z ? 1 : 0) + (s->has_m ? 1 : 0);
+		double x, y;
+		wkb_parse_state_check(s, ndims * WKB_DOUBLE_SIZE);
+		if (s->error)
+			return;
+		x = double_from_wkb_state(s);
+		y = double_from_wkb_state(s);
+		s->pos += (ndims - 2) * WKB_DOUBLE_SIZE;
+		/* POINT(NaN NaN) is POINT EMPTY */
+		if (!(std::isnan(x) && std::isnan(y)))
+			gbox_merge_xy_wkb(gbox, found, x, y);
+		return;
+	}
+	case LINETYPE:
+		ptarray_gbox_from_wkb_state(s, gbox, found, LW_TRUE);
+		return;
+	case POLYGONTYPE:
+	case TRIANGLETYPE:
+		n = integer_from_wkb_state(s);
+		for (i = 0; i < n && !s->error; i++)
+			ptarray_gbox_from_wkb_state(s, gbox, found, i == 0);
+		return;
+	case MULTIPOINTTYPE:
+	case MULTILINETYPE:
+	case MULTIPOLYGONTYPE:
+	case POLYHEDRALSURFACETYPE:
+	case TINTYPE:
+	case COLLECTIONTYPE:
+		n = integer_from_wkb_state(s);
+		s->depth++;
+		if (s->depth >= LW_PARSER_MAX_DEPTH) {
+			lwerror("Geometry has too many chained collections");
+			s->error = LW_TRUE;
+			return;
+		}
+		for (i = 0; i < n && !s->error; i++)
+			gbox_from_wkb_state(s, gbox, found);
+		s->depth--;
+		return;
+	case CIRCSTRINGTYPE:
+	case COMPOUNDTYPE:
+	case CURVEPOLYTYPE:
+	case MULTICURVETYPE:
+	case MULTISURFACETYPE: {
+		GBOX subbox = {0};
+		int32_t srid = s->srid;
+		LWGEOM *geom;
+		s->pos = start;
+		geom = lwgeom_from_wkb_state(s);
+		s->srid = srid;
+		if (!geom) {
+			s->error = LW_TRUE;
+			return;
+		}
+		subbox.flags = geom->flags;
+		if (lwgeom_calculate_gbox_cartesian(geom, &subbox) == LW_SUCCESS) {
+			gbox_merge_xy_wkb(gbox, found, subbox.xmin, subbox.ymin);
+			gbox_merge_xy_wkb(gbox, found, subbox.xmax, subbox.ymax);
+		}
+		lwgeom_free(geom);
+		return;
+	}
+	default:
+		lwerror("%s: Unsupported geometry type: %s", __func__, lwtype_name(s->lwtype));
+		s->error = LW_TRUE;
+		return;
+	}
+}
+
+/**
+ * Planar 2D box of a WKB geometry, computed straight from the buffer
+ * without building an LWGEOM. The SRID of the geometry is returned
+ * through srid when given.
+ * Returns LW_FAILURE for an empty geometry.
+ */
+int lwgeom_calculate_gbox_wkb(const uint8_t *wkb, size_t wkb_size, GBOX *gbox, int32_t *srid) {
+	wkb_parse_state s;
+	POINT2D pt;
+	int found = LW_FALSE;
+
+	/* The box of the header is rounded to floats, this one is exact */
+	wkb_skip_header(&wkb, &wkb_size);
+
+	if (lwgeom_wkb_point2d(wkb, wkb_size, &pt, srid) == LW_SUCCESS) {
+		gbox_init(gbox);
+		gbox->xmin = gbox->xmax = pt.x;
+		gbox->ymin = gbox->ymax = pt.y;
+		return LW_SUCCESS;
+	}
+
+	/* Initialize the state appropriately */
+	s.wkb = wkb;
+	s.wkb_size = wkb_size;
+	s.swap_bytes = LW_FALSE;
+	s.check = LW_PARSER_CHECK_NONE;
+	s.lwtype = 0;
+	s.srid = SRID_UNKNOWN;
+	s.has_z = LW_FALSE;
+	s.has_m = LW_FALSE;
+	s.has_srid = LW_FALSE;
+	s.error = LW_FALSE;
+	s.pos = wkb;
+	s.depth = 1;
+
+	gbox_init(gbox);
+	if (!wkb || !wkb_size)
+		return LW_FAILURE;
+
+	gbox_from_wkb_state(&s, gbox, &found);
+	if (srid)
+		*srid = s.srid;
+	if (s.error || !found)
+		return LW_FAILURE;
+	return LW_SUCCESS;
+}
+
+int lwgeom_wkb_header_read(const uint8_t *wkb, const size_t wkb_size, WKB_HEADER *header) {
+	if (!wkb || wkb_size < WKB_HEADER_SIZE || wkb[0] != WKB_HEADER_MAGIC)
+		return LW_FAILURE;
+	memcpy(header, wkb, WKB_HEADER_SIZE);
+	return LW_SUCCESS;
+}
+
+/**
+ * Planar 2D box of a WKB geometry when it can be had without walking the
+ * coordinates: from the box header of a stored geography, rounded outwards
+ * to floats, or from a lone point. The SRID is read from the WKB itself.
+ * Returns LW_FAILURE for anything else and for an empty geometry.
+ */
+int lwgeom_fast_gbox_wkb(const uint8_t *wkb, size_t wkb_size, GBOX *gbox, int32_t *srid) {
+	wkb_parse_state s;
+	WKB_HEADER header;
+	POINT2D pt;
+	char wkb_little_endian;
+	int has_header = lwgeom_wkb_header_read(wkb, wkb_size, &header);
+
+	wkb_skip_header(&wkb, &wkb_size);
+
+	gbox_init(gbox);
+	if (lwgeom_wkb_point2d(wkb, wkb_size, &pt, srid) == LW_SUCCESS) {
+		gbox->xmin = gbox->xmax = pt.x;
+		gbox->ymin = gbox->ymax = pt.y;
+		return LW_SUCCESS;
+	}
+
+	/* Initialize the state appropriately */
+	s.wkb = wkb;
+	s.wkb_size = wkb_size;
+	s.swap_bytes = LW_FALSE;
+	s.check = LW_PARSER_CHECK_NONE;
+	s.lwtype = 0;
+	s.srid = SRID_UNKNOWN;
+	s.has_z = LW_FALSE;
+	s.has_m = LW_FALSE;
+	s.has_srid = LW_FALSE;
+	s.error = LW_FALSE;
+	s.pos = wkb;
+	s.depth = 1;
+
+	/* Byte order and type, the reads below would raise an error on a short buffer */
+	if (!wkb || wkb_size < 1 + WKB_INT_SIZE)
+		return LW_FAILURE;
+	wkb_little_endian = byte_from_wkb_state(&s);
+	if (wkb_little_endian != 1 && wkb_little_endian != 0)
+		return LW_FAILURE;
+	s.swap_bytes = (IS_BIG_ENDIAN && wkb_little_endian) || (!IS_BIG_ENDIAN && !wkb_little_endian);
+	lwtype_from_wkb_state(&s, integer_from_wkb_state(&s));
+
+	if (s.has_srid) {
+		if (wkb_size < 1 + 2 * WKB_INT_SIZE)
+			return LW_FAILURE;
+		s.srid = clamp_srid(integer_from_wkb_state(&s));
+	}
+	if (srid)
+		*srid = s.srid;
+
+	if (has_header) {
+		gbox->xmin = header.xmin;
+		gbox->xmax = header.xmax;
+		gbox->ymin = header.ymin;
+		gbox->ymax = header.ymax;
+		return LW_SUCCESS;
+	}
+
+	if (s.lwtype != POINTTYPE || (size_t)(s.pos - wkb) + 2 * WKB_DOUBLE_SIZE > wkb_size)
+		return LW_FAILURE;
+	gbox->xmin = gbox->xmax = double_from_wkb_state(&s);
+	gbox->ymin = gbox->ymax = double_from_wkb_state(&s);
+	/* POINT(NaN NaN) is POINT EMPTY */
+	if (std::isnan(gbox->xmin) && std::isnan(gbox->ymin))
+		return LW_FAILURE;
+	return LW_SUCCESS;
+}
+
 } // namespace duckdb
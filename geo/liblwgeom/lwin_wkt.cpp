@@ -47,10 +47,10 @@ const char *parser_error_messages[] = {"",
                                        "parse error - invalid geometry"};
 
 #define SET_PARSER_ERROR(errno)                                                                                        \
-	{                                                                                                                  \
-		global_parser_result.message = parser_error_messages[(errno)];                                                 \
-		global_parser_result.errcode = (errno);                                                                        \
-		global_parser_result.errlocation = wkt_yylloc.last_column;                                                     \
+	{                                                                                                                     \
+		state->result->message = parser_error_messages[(errno)];                                                             \
+		state->result->errcode = (errno);                                                                                    \
+		state->result->errlocation = state->last_column;                                                                     \
 	}
 
 void lwgeom_parser_result_init(LWGEOM_PARSER_RESULT *parser_result) {
@@ -249,7 +249,7 @@ static int wkt_pointarray_dimensionality(POINTARRAY *pa, lwflags_t flags) {
 	return LW_TRUE;
 }
 
-POINTARRAY *wkt_parser_ptarray_add_coord(POINTARRAY *pa, POINT p) {
+POINTARRAY *wkt_parser_ptarray_add_coord(WKT_PARSER_STATE *state, POINTARRAY *pa, POINT p) {
 	POINT4D pt;
 
 	/* Error on trouble */
@@ -283,21 +283,21 @@ POINTARRAY *wkt_parser_ptarray_add_coord(POINTARRAY *pa, POINT p) {
 /**
  * Start a point array from the first coordinate.
  */
-POINTARRAY *wkt_parser_ptarray_new(POINT p) {
+POINTARRAY *wkt_parser_ptarray_new(WKT_PARSER_STATE *state, POINT p) {
 	int ndims = FLAGS_NDIMS(p.flags);
 	POINTARRAY *pa = ptarray_construct_empty((ndims > 2), (ndims > 3), 4);
 	if (!pa) {
 		SET_PARSER_ERROR(PARSER_ERROR_OTHER);
 		return NULL;
 	}
-	return wkt_parser_ptarray_add_coord(pa, p);
+	return wkt_parser_ptarray_add_coord(state, pa, p);
 }
 
 /**
  * Create a new point. Null point array implies empty. Null dimensionality
  * implies no specified dimensionality in the WKT.
  */
-LWGEOM *wkt_parser_point_new(POINTARRAY *pa, char *dimensionality) {
+LWGEOM *wkt_parser_point_new(WKT_PARSER_STATE *state, POINTARRAY *pa, char *dimensionality) {
 	lwflags_t flags = wkt_dimensionality(dimensionality);
 
 	/* No pointarray means it is empty */
@@ -326,7 +326,7 @@ LWGEOM *wkt_parser_point_new(POINTARRAY *pa, char *dimensionality) {
  * implies no specified dimensionality in the WKT. Check for numpoints >= 2 if
  * requested.
  */
-LWGEOM *wkt_parser_linestring_new(POINTARRAY *pa, char *dimensionality) {
+LWGEOM *wkt_parser_linestring_new(WKT_PARSER_STATE *state, POINTARRAY *pa, char *dimensionality) {
 	// Need to do with postgis
 
 	lwflags_t flags = wkt_dimensionality(dimensionality);
@@ -343,7 +343,7 @@ LWGEOM *wkt_parser_linestring_new(POINTARRAY *pa, char *dimensionality) {
 	}
 
 	/* Apply check for not enough points, if requested. */
-	if ((global_parser_result.parser_check_flags & LW_PARSER_CHECK_MINPOINTS) && (pa->npoints < 2)) {
+	if ((state->result->parser_check_flags & LW_PARSER_CHECK_MINPOINTS) && (pa->npoints < 2)) {
 		ptarray_free(pa);
 		SET_PARSER_ERROR(PARSER_ERROR_MOREPOINTS);
 		return NULL;
@@ -358,7 +358,7 @@ LWGEOM *wkt_parser_linestring_new(POINTARRAY *pa, char *dimensionality) {
  * Circular strings are just like linestrings, except with slighty different
  * validity rules (minpoint == 3, numpoints % 2 == 1).
  */
-LWGEOM *wkt_parser_circularstring_new(POINTARRAY *pa, char *dimensionality) {
+LWGEOM *wkt_parser_circularstring_new(WKT_PARSER_STATE *state, POINTARRAY *pa, char *dimensionality) {
 	lwflags_t flags = wkt_dimensionality(dimensionality);
 
 	/* No pointarray means it is empty */
@@ -374,14 +374,14 @@ LWGEOM *wkt_parser_circularstring_new(POINTARRAY *pa, char *dimensionality) {
 	}
 
 	/* Apply check for not enough points, if requested. */
-	if ((global_parser_result.parser_check_flags & LW_PARSER_CHECK_MINPOINTS) && (pa->npoints < 3)) {
+	if ((state->result->parser_check_flags & LW_PARSER_CHECK_MINPOINTS) && (pa->npoints < 3)) {
 		ptarray_free(pa);
 		SET_PARSER_ERROR(PARSER_ERROR_MOREPOINTS);
 		return NULL;
 	}
 
 	/* Apply check for odd number of points, if requested. */
-	if ((global_parser_result.parser_check_flags & LW_PARSER_CHECK_ODD) && ((pa->npoints % 2) == 0)) {
+	if ((state->result->parser_check_flags & LW_PARSER_CHECK_ODD) && ((pa->npoints % 2) == 0)) {
 		ptarray_free(pa);
 		SET_PARSER_ERROR(PARSER_ERROR_ODDPOINTS);
 		return NULL;
@@ -390,7 +390,7 @@ LWGEOM *wkt_parser_circularstring_new(POINTARRAY *pa, char *dimensionality) {
 	return lwcircstring_as_lwgeom(lwcircstring_construct(SRID_UNKNOWN, NULL, pa));
 }
 
-LWGEOM *wkt_parser_triangle_new(POINTARRAY *pa, char *dimensionality) {
+LWGEOM *wkt_parser_triangle_new(WKT_PARSER_STATE *state, POINTARRAY *pa, char *dimensionality) {
 	lwflags_t flags = wkt_dimensionality(dimensionality);
 
 	/* No pointarray means it is empty */
@@ -421,7 +421,7 @@ LWGEOM *wkt_parser_triangle_new(POINTARRAY *pa, char *dimensionality) {
 	return lwtriangle_as_lwgeom(lwtriangle_construct(SRID_UNKNOWN, NULL, pa));
 }
 
-LWGEOM *wkt_parser_polygon_new(POINTARRAY *pa, char dimcheck) {
+LWGEOM *wkt_parser_polygon_new(WKT_PARSER_STATE *state, POINTARRAY *pa, char dimcheck) {
 	LWPOLY *poly = NULL;
 
 	/* No pointarray is a problem */
@@ -438,11 +438,11 @@ LWGEOM *wkt_parser_polygon_new(POINTARRAY *pa, char dimcheck) {
 		return NULL;
 	}
 
-	wkt_parser_polygon_add_ring(lwpoly_as_lwgeom(poly), pa, dimcheck);
+	wkt_parser_polygon_add_ring(state, lwpoly_as_lwgeom(poly), pa, dimcheck);
 	return lwpoly_as_lwgeom(poly);
 }
 
-LWGEOM *wkt_parser_polygon_add_ring(LWGEOM *poly, POINTARRAY *pa, char dimcheck) {
+LWGEOM *wkt_parser_polygon_add_ring(WKT_PARSER_STATE *state, LWGEOM *poly, POINTARRAY *pa, char dimcheck) {
 	/* Bad inputs are a problem */
 	if (!(pa && poly)) {
 		SET_PARSER_ERROR(PARSER_ERROR_OTHER);
@@ -458,7 +458,7 @@ LWGEOM *wkt_parser_polygon_add_ring(LWGEOM *poly, POINTARRAY *pa, char dimcheck)
 	}
 
 	/* Apply check for minimum number of points, if requested. */
-	if ((global_parser_result.parser_check_flags & LW_PARSER_CHECK_MINPOINTS) && (pa->npoints < 4)) {
+	if ((state->result->parser_check_flags & LW_PARSER_CHECK_MINPOINTS) && (pa->npoints < 4)) {
 		ptarray_free(pa);
 		lwgeom_free(poly);
 		SET_PARSER_ERROR(PARSER_ERROR_MOREPOINTS);
@@ -466,7 +466,7 @@ LWGEOM *wkt_parser_polygon_add_ring(LWGEOM *poly, POINTARRAY *pa, char dimcheck)
 	}
 
 	/* Apply check for not closed rings, if requested. */
-	if ((global_parser_result.parser_check_flags & LW_PARSER_CHECK_CLOSURE) &&
+	if ((state->result->parser_check_flags & LW_PARSER_CHECK_CLOSURE) &&
 	    !(dimcheck == 'Z' ? ptarray_is_closed_z(pa) : ptarray_is_closed_2d(pa))) {
 		ptarray_free(pa);
 		lwgeom_free(poly);
@@ -484,7 +484,7 @@ LWGEOM *wkt_parser_polygon_add_ring(LWGEOM *poly, POINTARRAY *pa, char dimcheck)
 	return poly;
 }
 
-LWGEOM *wkt_parser_polygon_finalize(LWGEOM *poly, char *dimensionality) {
+LWGEOM *wkt_parser_polygon_finalize(WKT_PARSER_STATE *state, LWGEOM *poly, char *dimensionality) {
 	lwflags_t flags = wkt_dimensionality(dimensionality);
 	int flagdims = FLAGS_NDIMS(flags);
 
@@ -511,7 +511,7 @@ LWGEOM *wkt_parser_polygon_finalize(LWGEOM *poly, char *dimensionality) {
 	return poly;
 }
 
-LWGEOM *wkt_parser_curvepolygon_new(LWGEOM *ring) {
+LWGEOM *wkt_parser_curvepolygon_new(WKT_PARSER_STATE *state, LWGEOM *ring) {
 	LWGEOM *poly;
 
 	/* Toss error on null geometry input */
@@ -524,11 +524,11 @@ LWGEOM *wkt_parser_curvepolygon_new(LWGEOM *ring) {
 	poly = lwcurvepoly_as_lwgeom(
 	    lwcurvepoly_construct_empty(SRID_UNKNOWN, FLAGS_GET_Z(ring->flags), FLAGS_GET_M(ring->flags)));
 	/* Return the result. */
-	return wkt_parser_curvepolygon_add_ring(poly, ring);
+	return wkt_parser_curvepolygon_add_ring(state, poly, ring);
 	return ring;
 }
 
-LWGEOM *wkt_parser_curvepolygon_add_ring(LWGEOM *poly, LWGEOM *ring) {
+LWGEOM *wkt_parser_curvepolygon_add_ring(WKT_PARSER_STATE *state, LWGEOM *poly, LWGEOM *ring) {
 	/* Toss error on null input */
 	if (!(ring && poly)) {
 		SET_PARSER_ERROR(PARSER_ERROR_OTHER);
@@ -544,7 +544,7 @@ LWGEOM *wkt_parser_curvepolygon_add_ring(LWGEOM *poly, LWGEOM *ring) {
 	}
 
 	/* Apply check for minimum number of points, if requested. */
-	if ((global_parser_result.parser_check_flags & LW_PARSER_CHECK_MINPOINTS)) {
+	if ((state->result->parser_check_flags & LW_PARSER_CHECK_MINPOINTS)) {
 		uint32_t vertices_needed = 3;
 
 		if (ring->type == LINETYPE)
@@ -559,7 +559,7 @@ LWGEOM *wkt_parser_curvepolygon_add_ring(LWGEOM *poly, LWGEOM *ring) {
 	}
 
 	/* Apply check for not closed rings, if requested. */
-	if ((global_parser_result.parser_check_flags & LW_PARSER_CHECK_CLOSURE)) {
+	if ((state->result->parser_check_flags & LW_PARSER_CHECK_CLOSURE)) {
 		int is_closed = 1;
 		switch (ring->type) {
 		case LINETYPE:
@@ -592,7 +592,7 @@ LWGEOM *wkt_parser_curvepolygon_add_ring(LWGEOM *poly, LWGEOM *ring) {
 	return poly;
 }
 
-LWGEOM *wkt_parser_curvepolygon_finalize(LWGEOM *poly, char *dimensionality) {
+LWGEOM *wkt_parser_curvepolygon_finalize(WKT_PARSER_STATE *state, LWGEOM *poly, char *dimensionality) {
 	lwflags_t flags = wkt_dimensionality(dimensionality);
 	int flagdims = FLAGS_NDIMS(flags);
 
@@ -619,7 +619,7 @@ LWGEOM *wkt_parser_curvepolygon_finalize(LWGEOM *poly, char *dimensionality) {
 	return poly;
 }
 
-LWGEOM *wkt_parser_compound_new(LWGEOM *geom) {
+LWGEOM *wkt_parser_compound_new(WKT_PARSER_STATE *state, LWGEOM *geom) {
 	LWCOLLECTION *col;
 	LWGEOM **geoms;
 	static int ngeoms = 1;
@@ -650,7 +650,7 @@ LWGEOM *wkt_parser_compound_new(LWGEOM *geom) {
 	return NULL;
 }
 
-LWGEOM *wkt_parser_compound_add_geom(LWGEOM *col, LWGEOM *geom) {
+LWGEOM *wkt_parser_compound_add_geom(WKT_PARSER_STATE *state, LWGEOM *col, LWGEOM *geom) {
 	/* Toss error on null geometry input */
 	if (!(geom && col)) {
 		SET_PARSER_ERROR(PARSER_ERROR_OTHER);
@@ -675,7 +675,7 @@ LWGEOM *wkt_parser_compound_add_geom(LWGEOM *col, LWGEOM *geom) {
 	return col;
 }
 
-LWGEOM *wkt_parser_collection_new(LWGEOM *geom) {
+LWGEOM *wkt_parser_collection_new(WKT_PARSER_STATE *state, LWGEOM *geom) {
 	LWCOLLECTION *col;
 	LWGEOM **geoms;
 	static int ngeoms = 1;
@@ -697,7 +697,7 @@ LWGEOM *wkt_parser_collection_new(LWGEOM *geom) {
 	return lwcollection_as_lwgeom(col);
 }
 
-LWGEOM *wkt_parser_collection_add_geom(LWGEOM *col, LWGEOM *geom) {
+LWGEOM *wkt_parser_collection_add_geom(WKT_PARSER_STATE *state, LWGEOM *col, LWGEOM *geom) {
 	/* Toss error on null geometry input */
 	if (!(geom && col)) {
 		SET_PARSER_ERROR(PARSER_ERROR_OTHER);
@@ -707,7 +707,7 @@ LWGEOM *wkt_parser_collection_add_geom(LWGEOM *col, LWGEOM *geom) {
 	return lwcollection_as_lwgeom(lwcollection_add_lwgeom(lwgeom_as_lwcollection(col), geom));
 }
 
-LWGEOM *wkt_parser_collection_finalize(int lwtype, LWGEOM *geom, char *dimensionality) {
+LWGEOM *wkt_parser_collection_finalize(WKT_PARSER_STATE *state, int lwtype, LWGEOM *geom, char *dimensionality) {
 	// Need to do with postgis
 
 	lwflags_t flags = wkt_dimensionality(dimensionality);
@@ -756,7 +756,7 @@ LWGEOM *wkt_parser_collection_finalize(int lwtype, LWGEOM *geom, char *dimension
 	return geom;
 }
 
-void wkt_parser_geometry_new(LWGEOM *geom, int32_t srid) {
+void wkt_parser_geometry_new(WKT_PARSER_STATE *state, LWGEOM *geom, int32_t srid) {
 
 	if (geom == NULL) {
 		lwerror("Parsed geometry is null!");
@@ -768,7 +768,7 @@ void wkt_parser_geometry_new(LWGEOM *geom, int32_t srid) {
 	else
 		lwgeom_set_srid(geom, SRID_UNKNOWN);
 
-	global_parser_result.geom = geom;
+	state->result->geom = geom;
 }
 
 } // namespace duckdb
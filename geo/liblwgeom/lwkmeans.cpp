@@ -0,0 +1,217 @@
+/**********************************************************************
+ *
+ * PostGIS - Spatial Types for PostgreSQL
+ * http://postgis.net
+ *
+ * PostGIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * PostGIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PostGIS.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************/
+
+#include "liblwgeom/liblwgeom.hpp"
+#include "liblwgeom/liblwgeom_internal.hpp"
+#include "liblwgeom/lwgeodetic.hpp"
+#include "liblwgeom/lwinline.hpp"
+
+#include <random>
+#include <vector>
+
+namespace duckdb {
+
+/* Same limit as the planar k-means of PostGIS */
+static const uint32_t KMEANS_MAX_ITERATIONS = 1000;
+
+/* A fixed seed, so the same input always gives the same clusters */
+static const uint32_t KMEANS_SEED = 5489u;
+
+/* The point on the unit sphere standing for a geometry: the point itself, or
+ * the center of the geocentric box of anything else. Returns LW_FAILURE for
+ * an empty geometry. */
+static int kmeans_sphere_point(const LWGEOM *geom, POINT3D *p) {
+	GEOGRAPHIC_POINT g;
+	POINT4D pt;
+
+	if (lwgeom_is_empty(geom))
+		return LW_FAILURE;
+
+	if (geom->type != POINTTYPE) {
+		GBOX box;
+		gbox_init(&box);
+		if (lwgeom_calculate_gbox_geodetic(geom, &box) == LW_SUCCESS) {
+			p->x = (box.xmin + box.xmax) / 2.0;
+			p->y = (box.ymin + box.ymax) / 2.0;
+			p->z = (box.zmin + box.zmax) / 2.0;
+			if (!FP_IS_ZERO(p->x * p->x + p->y * p->y + p->z * p->z)) {
+				normalize(p);
+				return LW_SUCCESS;
+			}
+		}
+		/* A box centered on the center of the earth says nothing, fall back to the first vertex */
+	}
+
+	if (lwgeom_startpoint(geom, &pt) == LW_FAILURE)
+		return LW_FAILURE;
+	geographic_point_init(pt.x, pt.y, &g);
+	geog2cart(&g, p);
+	return LW_SUCCESS;
+}
+
+/* The cluster of each point: the centroid with the largest dot product, which
+ * is the nearest centroid on the sphere. The loop over the points for one
+ * centroid at a time only reads flat arrays, so it vectorizes. Returns whether
+ * any point changed cluster. */
+static int kmeans_sphere_assign(const std::vector<double> &x, const std::vector<double> &y,
+                                const std::vector<double> &z, const std::vector<POINT3D> &centroids,
+                                std::vector<double> &best, std::vector<uint32_t> &clusters) {
+	uint32_t n = x.size();
+	std::vector<uint32_t> previous(clusters);
+
+	for (uint32_t i = 0; i < n; i++)
+		best[i] = -2.0;
+
+	for (uint32_t c = 0; c < centroids.size(); c++) {
+		const double cx = centroids[c].x;
+		const double cy = centroids[c].y;
+		const double cz = centroids[c].z;
+		for (uint32_t i = 0; i < n; i++) {
+			double dot = x[i] * cx + y[i] * cy + z[i] * cz;
+			bool closer = dot > best[i];
+			best[i] = closer ? dot : best[i];
+			clusters[i] = closer ? c : clusters[i];
+		}
+	}
+
+	return previous != clusters;
+}
+
+/* k-means++ seeding: the first centroid is a random point, each next one a
+ * point picked with a probability growing with its squared chord to the
+ * nearest centroid so far. */
+static void kmeans_sphere_seed(const std::vector<double> &x, const std::vector<double> &y,
+                               const std::vector<double> &z, uint32_t k, std::vector<POINT3D> &centroids) {
+	uint32_t n = x.size();
+	std::mt19937 rng(KMEANS_SEED);
+	std::vector<double> distances(n);
+
+	uint32_t first = rng() % n;
+	centroids.push_back({x[first], y[first], z[first]});
+	for (uint32_t i = 0; i < n; i++)
+		distances[i] = 2.0 - 2.0 * (x[i] * x[first] + y[i] * y[first] + z[i] * z[first]);
+
+	while (centroids.size() < k) {
+		double total = 0;
+		for (uint32_t i = 0; i < n; i++)
+			total += distances[i];
+
+		/* Every point is on a centroid already */
+		if (!(total > 0)) {
+			centroids.push_back(centroids.back());
+			continue;
+		}
+
+		double target = (rng() / 4294967296.0) * total;
+		uint32_t next = n - 1;
+		for (uint32_t i = 0; i < n; i++) {
+			target -= distances[i];
+			if (target < 0 && distances[i] > 0) {
+				next = i;
+				break;
+			}
+		}
+
+		centroids.push_back({x[next], y[next], z[next]});
+		for (uint32_t i = 0; i < n; i++) {
+			double d = 2.0 - 2.0 * (x[i] * x[next] + y[i] * y[next] + z[i] * z[next]);
+			if (d < distances[i])
+				distances[i] = d;
+		}
+	}
+}
+
+int *lwgeom_cluster_kmeans_sphere(const LWGEOM **geoms, uint32_t n, uint32_t k) {
+	std::vector<double> x, y, z;
+	std::vector<uint32_t> index;
+	uint32_t i;
+
+	if (k == 0) {
+		lwerror("lwgeom_cluster_kmeans_sphere: number of clusters must be greater than zero");
+		return NULL;
+	}
+
+	x.reserve(n);
+	y.reserve(n);
+	z.reserve(n);
+	for (i = 0; i < n; i++) {
+		POINT3D p;
+		if (kmeans_sphere_point(geoms[i], &p) == LW_SUCCESS) {
+			x.push_back(p.x);
+			y.push_back(p.y);
+			z.push_back(p.z);
+			index.push_back(i);
+		}
+	}
+
+	int *result = (int *)lwalloc(n * sizeof(int));
+	for (i = 0; i < n; i++)
+		result[i] = -1;
+
+	uint32_t num_points = index.size();
+	if (num_points == 0)
+		return result;
+
+	/* Fewer points than clusters leaves some clusters empty */
+	if (k > num_points)
+		k = num_points;
+
+	std::vector<POINT3D> centroids;
+	kmeans_sphere_seed(x, y, z, k, centroids);
+
+	std::vector<double> best(num_points);
+	std::vector<uint32_t> clusters(num_points, 0);
+	std::vector<POINT3D> sums(k);
+	kmeans_sphere_assign(x, y, z, centroids, best, clusters);
+	for (uint32_t iteration = 0; iteration < KMEANS_MAX_ITERATIONS; iteration++) {
+		/* Move each centroid to the mean of its points, projected back on the sphere */
+		for (uint32_t c = 0; c < k; c++)
+			sums[c] = {0, 0, 0};
+		for (i = 0; i < num_points; i++) {
+			sums[clusters[i]].x += x[i];
+			sums[clusters[i]].y += y[i];
+			sums[clusters[i]].z += z[i];
+		}
+		for (uint32_t c = 0; c < k; c++) {
+			POINT3D &sum = sums[c];
+			/* An empty cluster, or points all around the sphere, keep their centroid */
+			if (!FP_IS_ZERO(sum.x * sum.x + sum.y * sum.y + sum.z * sum.z)) {
+				normalize(&sum);
+				centroids[c] = sum;
+			}
+		}
+
+		if (!kmeans_sphere_assign(x, y, z, centroids, best, clusters))
+			break;
+	}
+
+	/* Number the clusters in the order of their first geometry */
+	std::vector<int> ids(k, -1);
+	int next_id = 0;
+	for (i = 0; i < num_points; i++) {
+		if (ids[clusters[i]] < 0)
+			ids[clusters[i]] = next_id++;
+		result[index[i]] = ids[clusters[i]];
+	}
+
+	return result;
+}
+
+} // namespace duckdb
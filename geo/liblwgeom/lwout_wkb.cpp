@@ -259,17 +259,15 @@ static uint8_t *double_to_wkb_buf(const double d, uint8_t *buf, uint8_t variant)
 }
 
 /**
- * Convert LWGEOM to a char* in WKB format. Caller is responsible for freeing
- * the returned array.
+ * Write LWGEOM in WKB format into a caller-owned buffer, which must hold at
+ * least lwgeom_to_wkb_size() bytes. Returns the number of bytes written.
  *
  * @param variant. Unsigned bitmask value. Accepts one of: WKB_ISO, WKB_EXTENDED, WKB_SFSQL.
  * Accepts any of: WKB_NDR, WKB_HEX. For example: Variant = ( WKB_ISO | WKB_NDR ) would
  * return the little-endian ISO form of WKB. For Example: Variant = ( WKB_EXTENDED | WKB_HEX )
  * would return the big-endian extended form of WKB, as hex-encoded ASCII (the "canonical form").
- * @param size_out If supplied, will return the size of the returned memory segment,
- * including the null terminator in the case of ASCII.
  */
-static ptrdiff_t lwgeom_to_wkb_write_buf(const LWGEOM *geom, uint8_t variant, uint8_t *buffer) {
+ptrdiff_t lwgeom_to_wkb_write_buf(const LWGEOM *geom, uint8_t variant, uint8_t *buffer) {
 	/* If neither or both variants are specified, choose the native order */
 	if (!(variant & WKB_NDR || variant & WKB_XDR) || (variant & WKB_NDR && variant & WKB_XDR)) {
 		if (IS_BIG_ENDIAN)
@@ -734,6 +732,63 @@ static uint8_t *lwgeom_to_wkb_buf(const LWGEOM *geom, uint8_t *buf, uint8_t vari
 	return nullptr;
 }
 
+/* Plain WKB unless the caller asks for the header */
+static thread_local int wkb_header_enabled = 0;
+
+int lwgeom_wkb_header_enable(int enabled) {
+	int previous = wkb_header_enabled;
+	wkb_header_enabled = enabled;
+	return previous;
+}
+
+int lwgeom_wkb_header_enabled(void) {
+	return wkb_header_enabled;
+}
+
+/**
+ * Size of the box header of a stored geography. An empty geometry has no
+ * box to put in it, and the WKB of a point is as quick to read as a header.
+ */
+size_t lwgeom_wkb_header_size(const LWGEOM *geom) {
+	if (!wkb_header_enabled || geom->type == POINTTYPE || lwgeom_is_empty(geom))
+		return 0;
+	return WKB_HEADER_SIZE;
+}
+
+uint8_t *lwgeom_wkb_header_write(const LWGEOM *geom, uint8_t *buf) {
+	GBOX box;
+
+	if (!lwgeom_wkb_header_size(geom))
+		return buf;
+
+	/* The cached box of a geography may be geocentric, the header is planar */
+	gbox_init(&box);
+	box.flags = lwflags(FLAGS_GET_Z(geom->flags), FLAGS_GET_M(geom->flags), 0);
+	if (lwgeom_calculate_gbox_cartesian(geom, &box) == LW_FAILURE)
+		lwerror("lwgeom_wkb_header_write: could not compute the box of a non-empty geometry");
+
+	return lwgeom_wkb_header_write_gbox(geom->type, geom->flags & (LWFLAG_Z | LWFLAG_M),
+	                                    lwgeom_count_vertices(geom), &box, buf);
+}
+
+uint8_t *lwgeom_wkb_header_write_gbox(uint8_t type, uint8_t flags, uint32_t npoints, const GBOX *box, uint8_t *buf) {
+	WKB_HEADER header;
+
+	memset(&header, 0, sizeof(header));
+	header.magic = WKB_HEADER_MAGIC;
+	header.type = type;
+	header.flags = flags;
+	header.npoints = npoints;
+	/* Rounded outwards, so the float box still holds every coordinate */
+	header.xmin = next_float_down(box->xmin);
+	header.xmax = next_float_up(box->xmax);
+	header.ymin = next_float_down(box->ymin);
+	header.ymax = next_float_up(box->ymax);
+
+	memcpy(buf, &header, WKB_HEADER_SIZE);
+	return buf + WKB_HEADER_SIZE;
+}
+
 lwvarlena_t *lwgeom_to_wkb_varlena(const LWGEOM *geom, uint8_t variant) {
 	size_t b_size = lwgeom_to_wkb_size(geom, variant);
 	/* Hex string takes twice as much space as binary, but No NULL ending in varlena */
@@ -26,6 +26,7 @@
 
 #include "liblwgeom/liblwgeom.hpp"
 
+#include <atomic>
 #include <stdlib.h>
 #include <string.h>
 
@@ -151,6 +152,61 @@ uint32_t *UF_get_collapsed_cluster_ids(UNIONFIND *uf, const char *is_in_cluster)
 	return new_ids;
 }
 
+static inline std::atomic<uint32_t> &UF_cluster_atomic(UNIONFIND *uf, uint32_t i) {
+	static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "cluster ids must be updated in place");
+	return reinterpret_cast<std::atomic<uint32_t> &>(uf->clusters[i]);
+}
+
+uint32_t UF_find_concurrent(UNIONFIND *uf, uint32_t i) {
+	while (true) {
+		uint32_t parent = UF_cluster_atomic(uf, i).load();
+		if (parent == i) {
+			return i;
+		}
+		uint32_t grandparent = UF_cluster_atomic(uf, parent).load();
+		/* Path halving, losing the race to another thread only costs a step */
+		if (grandparent != parent) {
+			UF_cluster_atomic(uf, i).compare_exchange_weak(parent, grandparent);
+		}
+		i = grandparent;
+	}
+}
+
+void UF_union_concurrent(UNIONFIND *uf, uint32_t i, uint32_t j) {
+	while (true) {
+		uint32_t a = UF_find_concurrent(uf, i);
+		uint32_t b = UF_find_concurrent(uf, j);
+
+		if (a == b) {
+			return;
+		}
+
+		uint32_t root = a < b ? a : b;
+		uint32_t child = a < b ? b : a;
+		/* Only link child if it is still a root, otherwise find the roots again */
+		if (UF_cluster_atomic(uf, child).compare_exchange_strong(child, root)) {
+			return;
+		}
+	}
+}
+
+void UF_finish_concurrent(UNIONFIND *uf) {
+	uint32_t i;
+
+	for (i = 0; i < uf->N; i++) {
+		uf->cluster_sizes[i] = 0;
+	}
+
+	uf->num_clusters = 0;
+	for (i = 0; i < uf->N; i++) {
+		uint32_t root = UF_find(uf, i);
+		if (root == i) {
+			uf->num_clusters++;
+		}
+		uf->cluster_sizes[root]++;
+	}
+}
+
 static int cmp_int(const void *a, const void *b) {
 	if (*((uint32_t *)a) > *((uint32_t *)b)) {
 		return 1;
@@ -59,6 +59,19 @@ void lwfree(void *mem) {
 	lwfree_var(mem);
 }
 
+void lwgeom_set_allocators(lwallocator allocator, lwreallocator reallocator, lwfreeor freeor) {
+	if (!allocator)
+		allocator = default_allocator;
+	if (!reallocator)
+		reallocator = default_reallocator;
+	if (!freeor)
+		freeor = default_freeor;
+
+	lwalloc_var = allocator;
+	lwrealloc_var = reallocator;
+	lwfree_var = freeor;
+}
+
 /*
  * Default allocators
  *
@@ -106,6 +106,18 @@ POINTARRAY *ptarray_construct_copy_data(char hasz, char hasm, uint32_t npoints,
 	return pa;
 }
 
+POINTARRAY *ptarray_construct_coords(const double *x, const double *y, uint32_t npoints) {
+	POINTARRAY *pa = ptarray_construct(0, 0, npoints);
+	POINT2D *pt = (POINT2D *)pa->serialized_pointlist;
+	uint32_t i;
+
+	for (i = 0; i < npoints; i++) {
+		pt[i].x = x[i];
+		pt[i].y = y[i];
+	}
+	return pa;
+}
+
 /**
  * Build a new #POINTARRAY, but on top of someone else's ordinate array.
  * Flag as read-only, so that ptarray_free() does not free the serialized_ptlist
@@ -386,6 +398,48 @@ int ptarray_contains_point_partial(const POINTARRAY *pa, const POINT2D *pt, int
 	return LW_INSIDE;
 }
 
+/**
+ * ptarray_contains_point on a closed ring given as separate x and y arrays,
+ * read in place instead of copied into a #POINTARRAY.
+ * Return LW_INSIDE, LW_OUTSIDE or LW_BOUNDARY.
+ */
+int coords_contains_point(const double *x, const double *y, uint32_t npoints, const POINT2D *pt) {
+	int wn = 0;
+	uint32_t i;
+	double side;
+	POINT2D seg1, seg2;
+
+	if (npoints == 0)
+		return LW_OUTSIDE;
+
+	seg1.x = x[0];
+	seg1.y = y[0];
+	for (i = 1; i < npoints; i++) {
+		seg2.x = x[i];
+		seg2.y = y[i];
+
+		/* Zero length segments are ignored, and so are the ones out of our vertical range */
+		if ((seg1.x == seg2.x && seg1.y == seg2.y) || pt->y > FP_MAX(seg1.y, seg2.y) ||
+		    pt->y < FP_MIN(seg1.y, seg2.y)) {
+			seg1 = seg2;
+			continue;
+		}
+
+		side = lw_segment_side(&seg1, &seg2, pt);
+		if ((side == 0) && lw_pt_in_seg(pt, &seg1, &seg2))
+			return LW_BOUNDARY;
+
+		if ((side < 0) && (seg1.y <= pt->y) && (pt->y < seg2.y))
+			wn++;
+		else if ((side > 0) && (seg2.y <= pt->y) && (pt->y < seg1.y))
+			wn--;
+
+		seg1 = seg2;
+	}
+
+	return wn == 0 ? LW_OUTSIDE : LW_INSIDE;
+}
+
 /**
  * For POINTARRAYs representing CIRCULARSTRINGS. That is, linked triples
  * with each triple being control points of a circular arc. Such
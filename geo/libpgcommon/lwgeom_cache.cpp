@@ -0,0 +1,106 @@
+/**********************************************************************
+ *
+ * PostGIS - Spatial Types for PostgreSQL
+ *
+ * Copyright (C) 2012 Sandro Santilli <strk@kbt.io>
+ * Copyright (C) 2010 Paul Ramsey <pramsey@cleverelephant.ca>
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU General Public Licence. See the COPYING file.
+ *
+ **********************************************************************/
+
+#include "libpgcommon/lwgeom_cache.hpp"
+
+#include "liblwgeom/lwinline.hpp"
+
+namespace duckdb {
+
+GeomCache::GeomCache() : argnum(0), lwgeom(NULL), constant_arg(0), constant_built(false) {
+}
+
+GeomCache::~GeomCache() {
+	if (lwgeom) {
+		lwgeom_free(lwgeom);
+	}
+}
+
+void GeomCache::Clear() {
+	FreeIndex();
+	if (lwgeom) {
+		lwgeom_free(lwgeom);
+		lwgeom = NULL;
+	}
+	argnum = 0;
+}
+
+void GeomCache::Build(int arg, const std::string &wkb) {
+	Clear();
+	bool indexed = false;
+	/* The cache outlives the chunk, keep it out of the per-thread arena */
+	int arena_state = lwarena_pause();
+	try {
+		lwgeom = lwgeom_from_wkb((const uint8_t *)wkb.data(), wkb.size(), LW_PARSER_CHECK_NONE);
+		if (lwgeom && !lwgeom_is_empty(lwgeom)) {
+			/* Keep the box too, the predicates would recompute it on every call */
+			lwgeom_add_bbox(lwgeom);
+			indexed = BuildIndex();
+		}
+	} catch (...) {
+		lwarena_resume(arena_state);
+		Clear();
+		throw;
+	}
+	lwarena_resume(arena_state);
+	if (indexed) {
+		argnum = arg;
+	} else {
+		Clear();
+	}
+}
+
+static inline bool GeomCacheMatch(const std::string &cached, const uint8_t *wkb, size_t size) {
+	return cached.size() == size && memcmp(cached.data(), wkb, size) == 0;
+}
+
+int GeomCache::Lookup(const uint8_t *wkb1, size_t size1, const uint8_t *wkb2, size_t size2) {
+	/* A constant argument never changes, index it once and skip the comparisons */
+	if (constant_arg) {
+		if (!constant_built) {
+			constant_built = true;
+			if (constant_arg == 1) {
+				Build(1, std::string((const char *)wkb1, size1));
+			} else {
+				Build(2, std::string((const char *)wkb2, size2));
+			}
+		}
+		return argnum;
+	}
+
+	bool same1 = GeomCacheMatch(arg1, wkb1, size1);
+	bool same2 = GeomCacheMatch(arg2, wkb2, size2);
+
+	/* Still the geometry we have an index for */
+	if ((argnum == 1 && same1) || (argnum == 2 && same2)) {
+		return argnum;
+	}
+
+	/* Second time in a row for one of the arguments, index it */
+	if (same1) {
+		Build(1, arg1);
+	} else if (same2) {
+		Build(2, arg2);
+	} else {
+		Clear();
+	}
+
+	if (!same1) {
+		arg1.assign((const char *)wkb1, size1);
+	}
+	if (!same2) {
+		arg2.assign((const char *)wkb2, size2);
+	}
+	return argnum;
+}
+
+} // namespace duckdb
@@ -48,4 +48,10 @@ GSERIALIZED *geography_serialize(LWGEOM *lwgeom) {
 	return g;
 }
 
+void lwgeom_error_if_srid_mismatch(const LWGEOM *g1, const LWGEOM *g2, const char *funcname) {
+	if (g1->srid != g2->srid)
+		lwerror("%s: Operation on mixed SRID geometries (%s, %d) != (%s, %d)", funcname, lwtype_name(g1->type),
+		        g1->srid, lwtype_name(g2->type), g2->srid);
+}
+
 } // namespace duckdb
@@ -1,14 +1,14 @@
-/* A Bison parser, made by GNU Bison 2.3.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* Skeleton implementation for Bison's Yacc-like parsers in C
+/* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-   This program is free software; you can redistribute it and/or modify
+   This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
-   the Free Software Foundation; either version 2, or (at your option)
-   any later version.
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
 
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
@@ -16,9 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program; if not, write to the Free Software
-   Foundation, Inc., 51 Franklin Street, Fifth Floor,
-   Boston, MA 02110-1301, USA.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -36,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -43,91 +45,35 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.3"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
+
+/* Push parsers.  */
+#define YYPUSH 0
 
-/* Using locations.  */
-#define YYLSP_NEEDED 1
+/* Pull parsers.  */
+#define YYPULL 1
 
+/* Substitute the type names.  */
+#define YYSTYPE         WKT_YYSTYPE
+#define YYLTYPE         WKT_YYLTYPE
 /* Substitute the variable and function names.  */
-#define yyparse  wkt_yyparse
-#define yylex    wkt_yylex
-#define yyerror  wkt_yyerror
-#define yylval   wkt_yylval
-#define yychar   wkt_yychar
-#define yydebug  wkt_yydebug
-#define yynerrs  wkt_yynerrs
-#define yylloc  wkt_yylloc
-
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     POINT_TOK = 258,
-     LINESTRING_TOK = 259,
-     POLYGON_TOK = 260,
-     MPOINT_TOK = 261,
-     MLINESTRING_TOK = 262,
-     MPOLYGON_TOK = 263,
-     MSURFACE_TOK = 264,
-     MCURVE_TOK = 265,
-     CURVEPOLYGON_TOK = 266,
-     COMPOUNDCURVE_TOK = 267,
-     CIRCULARSTRING_TOK = 268,
-     COLLECTION_TOK = 269,
-     RBRACKET_TOK = 270,
-     LBRACKET_TOK = 271,
-     COMMA_TOK = 272,
-     EMPTY_TOK = 273,
-     SEMICOLON_TOK = 274,
-     TRIANGLE_TOK = 275,
-     TIN_TOK = 276,
-     POLYHEDRALSURFACE_TOK = 277,
-     DOUBLE_TOK = 278,
-     DIMENSIONALITY_TOK = 279,
-     SRID_TOK = 280
-   };
-#endif
-/* Tokens.  */
-#define POINT_TOK 258
-#define LINESTRING_TOK 259
-#define POLYGON_TOK 260
-#define MPOINT_TOK 261
-#define MLINESTRING_TOK 262
-#define MPOLYGON_TOK 263
-#define MSURFACE_TOK 264
-#define MCURVE_TOK 265
-#define CURVEPOLYGON_TOK 266
-#define COMPOUNDCURVE_TOK 267
-#define CIRCULARSTRING_TOK 268
-#define COLLECTION_TOK 269
-#define RBRACKET_TOK 270
-#define LBRACKET_TOK 271
-#define COMMA_TOK 272
-#define EMPTY_TOK 273
-#define SEMICOLON_TOK 274
-#define TRIANGLE_TOK 275
-#define TIN_TOK 276
-#define POLYHEDRALSURFACE_TOK 277
-#define DOUBLE_TOK 278
-#define DIMENSIONALITY_TOK 279
-#define SRID_TOK 280
-
-
-
-
-/* Copy the first part of user declarations.  */
+#define yyparse         wkt_yyparse
+#define yylex           wkt_yylex
+#define yyerror         wkt_yyerror
+#define yydebug         wkt_yydebug
+#define yynerrs         wkt_yynerrs
+
+/* First part of user prologue.  */
 #line 1 "extension/geo/parser/lwin_wkt_parse.y"
 
 
@@ -140,17 +86,116 @@
 
 namespace duckdb {
 
-/* Prototypes to quiet the compiler */
-int wkt_yyparse(void);
-void wkt_yyerror(const char *str);
-int wkt_yylex(void);
+/* Turn on/off verbose parsing (turn off for production) */
+int wkt_yydebug = 0;
 
 
-/* Declare the global parser variable */
-LWGEOM_PARSER_RESULT global_parser_result;
+#line 94 "extension/geo/parser/lwin_wkt_parse.cpp"
 
-/* Turn on/off verbose parsing (turn off for production) */
-int wkt_yydebug = 0;
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "parser/lwin_wkt_parse.hpp"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_POINT_TOK = 3,                  /* POINT_TOK  */
+  YYSYMBOL_LINESTRING_TOK = 4,             /* LINESTRING_TOK  */
+  YYSYMBOL_POLYGON_TOK = 5,                /* POLYGON_TOK  */
+  YYSYMBOL_MPOINT_TOK = 6,                 /* MPOINT_TOK  */
+  YYSYMBOL_MLINESTRING_TOK = 7,            /* MLINESTRING_TOK  */
+  YYSYMBOL_MPOLYGON_TOK = 8,               /* MPOLYGON_TOK  */
+  YYSYMBOL_MSURFACE_TOK = 9,               /* MSURFACE_TOK  */
+  YYSYMBOL_MCURVE_TOK = 10,                /* MCURVE_TOK  */
+  YYSYMBOL_CURVEPOLYGON_TOK = 11,          /* CURVEPOLYGON_TOK  */
+  YYSYMBOL_COMPOUNDCURVE_TOK = 12,         /* COMPOUNDCURVE_TOK  */
+  YYSYMBOL_CIRCULARSTRING_TOK = 13,        /* CIRCULARSTRING_TOK  */
+  YYSYMBOL_COLLECTION_TOK = 14,            /* COLLECTION_TOK  */
+  YYSYMBOL_RBRACKET_TOK = 15,              /* RBRACKET_TOK  */
+  YYSYMBOL_LBRACKET_TOK = 16,              /* LBRACKET_TOK  */
+  YYSYMBOL_COMMA_TOK = 17,                 /* COMMA_TOK  */
+  YYSYMBOL_EMPTY_TOK = 18,                 /* EMPTY_TOK  */
+  YYSYMBOL_SEMICOLON_TOK = 19,             /* SEMICOLON_TOK  */
+  YYSYMBOL_TRIANGLE_TOK = 20,              /* TRIANGLE_TOK  */
+  YYSYMBOL_TIN_TOK = 21,                   /* TIN_TOK  */
+  YYSYMBOL_POLYHEDRALSURFACE_TOK = 22,     /* POLYHEDRALSURFACE_TOK  */
+  YYSYMBOL_DOUBLE_TOK = 23,                /* DOUBLE_TOK  */
+  YYSYMBOL_DIMENSIONALITY_TOK = 24,        /* DIMENSIONALITY_TOK  */
+  YYSYMBOL_SRID_TOK = 25,                  /* SRID_TOK  */
+  YYSYMBOL_YYACCEPT = 26,                  /* $accept  */
+  YYSYMBOL_geometry = 27,                  /* geometry  */
+  YYSYMBOL_geometry_no_srid = 28,          /* geometry_no_srid  */
+  YYSYMBOL_geometrycollection = 29,        /* geometrycollection  */
+  YYSYMBOL_geometry_list = 30,             /* geometry_list  */
+  YYSYMBOL_multisurface = 31,              /* multisurface  */
+  YYSYMBOL_surface_list = 32,              /* surface_list  */
+  YYSYMBOL_tin = 33,                       /* tin  */
+  YYSYMBOL_polyhedralsurface = 34,         /* polyhedralsurface  */
+  YYSYMBOL_multipolygon = 35,              /* multipolygon  */
+  YYSYMBOL_polygon_list = 36,              /* polygon_list  */
+  YYSYMBOL_patch_list = 37,                /* patch_list  */
+  YYSYMBOL_polygon = 38,                   /* polygon  */
+  YYSYMBOL_polygon_untagged = 39,          /* polygon_untagged  */
+  YYSYMBOL_patch = 40,                     /* patch  */
+  YYSYMBOL_curvepolygon = 41,              /* curvepolygon  */
+  YYSYMBOL_curvering_list = 42,            /* curvering_list  */
+  YYSYMBOL_curvering = 43,                 /* curvering  */
+  YYSYMBOL_patchring_list = 44,            /* patchring_list  */
+  YYSYMBOL_ring_list = 45,                 /* ring_list  */
+  YYSYMBOL_patchring = 46,                 /* patchring  */
+  YYSYMBOL_ring = 47,                      /* ring  */
+  YYSYMBOL_compoundcurve = 48,             /* compoundcurve  */
+  YYSYMBOL_compound_list = 49,             /* compound_list  */
+  YYSYMBOL_multicurve = 50,                /* multicurve  */
+  YYSYMBOL_curve_list = 51,                /* curve_list  */
+  YYSYMBOL_multilinestring = 52,           /* multilinestring  */
+  YYSYMBOL_linestring_list = 53,           /* linestring_list  */
+  YYSYMBOL_circularstring = 54,            /* circularstring  */
+  YYSYMBOL_linestring = 55,                /* linestring  */
+  YYSYMBOL_linestring_untagged = 56,       /* linestring_untagged  */
+  YYSYMBOL_triangle_list = 57,             /* triangle_list  */
+  YYSYMBOL_triangle = 58,                  /* triangle  */
+  YYSYMBOL_triangle_untagged = 59,         /* triangle_untagged  */
+  YYSYMBOL_multipoint = 60,                /* multipoint  */
+  YYSYMBOL_point_list = 61,                /* point_list  */
+  YYSYMBOL_point_untagged = 62,            /* point_untagged  */
+  YYSYMBOL_point = 63,                     /* point  */
+  YYSYMBOL_ptarray = 64,                   /* ptarray  */
+  YYSYMBOL_coordinate = 65                 /* coordinate  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+/* Unqualified %code blocks.  */
+#line 17 "extension/geo/parser/lwin_wkt_parse.y"
+
+
+/* Prototypes to quiet the compiler */
+int wkt_yylex(WKT_YYSTYPE *lvalp, WKT_YYLTYPE *llocp, void *scanner);
+void wkt_yyerror(WKT_YYLTYPE *llocp, void *scanner, WKT_PARSER_STATE *state, const char *str);
 
 /*
 * Error handler called by the bison parser. Mostly we will be
@@ -158,164 +203,166 @@ int wkt_yydebug = 0;
 * from WKT_ERROR in the grammar, but we keep this one
 * around just in case.
 */
-void wkt_yyerror(__attribute__((__unused__)) const char *str)
+void wkt_yyerror(WKT_YYLTYPE *llocp, __attribute__((__unused__)) void *scanner, WKT_PARSER_STATE *state,
+                 __attribute__((__unused__)) const char *str)
 {
 	/* If we haven't already set a message and location, let's set one now. */
-	if ( ! global_parser_result.message )
+	if ( ! state->result->message )
 	{
-		global_parser_result.message = parser_error_messages[PARSER_ERROR_OTHER];
-		global_parser_result.errcode = PARSER_ERROR_OTHER;
-		global_parser_result.errlocation = wkt_yylloc.last_column;
+		state->result->message = parser_error_messages[PARSER_ERROR_OTHER];
+		state->result->errcode = PARSER_ERROR_OTHER;
+		state->result->errlocation = llocp->last_column;
 	}
 }
 
+/*
+* Owns the scanner for one parse. lwerror throws, so the scanner is
+* released on the way out even when the parse does not return.
+*/
+struct WKTLexerGuard
+{
+	void *scanner;
+	WKTLexerGuard(WKT_PARSER_STATE *state, char *src) : scanner(wkt_lexer_init(state, src)) {}
+	~WKTLexerGuard() { wkt_lexer_close(scanner); }
+};
+
 /**
-* Parse a WKT geometry string into an LWGEOM structure. Note that this
-* process uses globals and is not re-entrant, so don't call it within itself
-* (eg, from within other functions in lwin_wkt.c) or from a threaded program.
+* Parse a WKT geometry string into an LWGEOM structure. All of the parse
+* state lives in a WKT_PARSER_STATE on this stack frame and in a scanner
+* owned by this call, so the parser is re-entrant and may be called from
+* several threads at once.
 * Note that parser_result.wkinput picks up a reference to wktstr.
 */
 int lwgeom_parse_wkt(LWGEOM_PARSER_RESULT *parser_result, char *wktstr, int parser_check_flags)
 {
 	int parse_rv = 0;
+	WKT_PARSER_STATE state;
 
-	/* Clean up our global parser result. */
-	lwgeom_parser_result_init(&global_parser_result);
-	/* Work-around possible bug in GNU Bison 3.0.2 resulting in wkt_yylloc
-	 * members not being initialized on yyparse() as documented here:
-	 * https://www.gnu.org/software/bison/manual/html_node/Location-Type.html
-	 * See discussion here:
-	 * http://lists.osgeo.org/pipermail/postgis-devel/2014-September/024506.html
-	 */
-	wkt_yylloc.last_column = wkt_yylloc.last_line = \
-		wkt_yylloc.first_column = wkt_yylloc.first_line = 1;
+	/* Clean up the parser result, the builders write straight into it. */
+	lwgeom_parser_result_init(parser_result);
 
 	/* Set the input text string, and parse checks. */
-	global_parser_result.wkinput = wktstr;
-	global_parser_result.parser_check_flags = parser_check_flags;
+	parser_result->wkinput = wktstr;
+	parser_result->parser_check_flags = parser_check_flags;
+	state.result = parser_result;
+	state.last_column = 1;
 
-	wkt_lexer_init(wktstr); /* Lexer ready */
-	parse_rv = wkt_yyparse(); /* Run the parse */
-	wkt_lexer_close(); /* Clean up lexer */
+	{
+		WKTLexerGuard lexer(&state, wktstr); /* Lexer ready, closed when the block exits */
+		parse_rv = wkt_yyparse(lexer.scanner, &state); /* Run the parse */
+	}
 
 	/* A non-zero parser return is an error. */
-	if ( parse_rv || global_parser_result.errcode )
+	if ( parse_rv || parser_result->errcode )
 	{
-		if( ! global_parser_result.errcode )
+		if( ! parser_result->errcode )
 		{
-			global_parser_result.errcode = PARSER_ERROR_OTHER;
-			global_parser_result.message = parser_error_messages[PARSER_ERROR_OTHER];
-			global_parser_result.errlocation = wkt_yylloc.last_column;
+			parser_result->errcode = PARSER_ERROR_OTHER;
+			parser_result->message = parser_error_messages[PARSER_ERROR_OTHER];
+			parser_result->errlocation = state.last_column;
 		}
-		else if (global_parser_result.geom)
+		else if (parser_result->geom)
 		{
-			lwgeom_free(global_parser_result.geom);
-			global_parser_result.geom = NULL;
+			lwgeom_free(parser_result->geom);
+			parser_result->geom = NULL;
 		}
 
-		/* Copy the global values into the return pointer */
-		*parser_result = global_parser_result;
-		wkt_yylex_destroy();
 		return LW_FAILURE;
 	}
 
-	/* Copy the global value into the return pointer */
-	*parser_result = global_parser_result;
-	wkt_yylex_destroy();
 	return LW_SUCCESS;
 }
 
-#define WKT_ERROR() { if ( global_parser_result.errcode != 0 ) { YYERROR; } }
-
+#define WKT_ERROR() { if ( state->result->errcode != 0 ) { YYERROR; } }
 
 
+#line 280 "extension/geo/parser/lwin_wkt_parse.cpp"
 
-/* Enabling traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
+#ifdef short
+# undef short
 #endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 1
-#endif
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
 
-/* Enabling the token table.  */
-#ifndef YYTOKEN_TABLE
-# define YYTOKEN_TABLE 0
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
-#line 105 "extension/geo/parser/lwin_wkt_parse.y"
-{
-	int integervalue;
-	double doublevalue;
-	char *stringvalue;
-	LWGEOM *geometryvalue;
-	POINT coordinatevalue;
-	POINTARRAY *ptarrayvalue;
-}
-/* Line 193 of yacc.c.  */
-#line 264 "extension/geo/parser/lwin_wkt_parse.cpp"
-	YYSTYPE;
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
-# define YYSTYPE_IS_TRIVIAL 1
-#endif
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
 
-#if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE
-{
-  int first_line;
-  int first_column;
-  int last_line;
-  int last_column;
-} YYLTYPE;
-# define yyltype YYLTYPE /* obsolescent; will be withdrawn */
-# define YYLTYPE_IS_DECLARED 1
-# define YYLTYPE_IS_TRIVIAL 1
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
 #endif
 
-
-/* Copy the second part of user declarations.  */
-
-
-/* Line 216 of yacc.c.  */
-#line 289 "extension/geo/parser/lwin_wkt_parse.cpp"
-
-#ifdef short
-# undef short
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-typedef signed char yytype_int8;
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef short int yytype_int8;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef unsigned short int yytype_uint16;
+typedef int yytype_uint16;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
-#else
-typedef short int yytype_int16;
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -323,55 +370,106 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int16 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
 #  if ENABLE_NLS
 #   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
-#   define YY_(msgid) dgettext ("bison-runtime", msgid)
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
 #  endif
 # endif
 # ifndef YY_
-#  define YY_(msgid) msgid
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(e) ((void) (e))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(e) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-# define YYID(n) (n)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int
-YYID (int i)
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
 #else
-static int
-YYID (i)
-    int i;
+# define YY_INITIAL_VALUE(Value) Value
 #endif
-{
-  return i;
-}
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if 1
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -388,11 +486,11 @@ YYID (i)
 #    define alloca _alloca
 #   else
 #    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
 #     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#     ifndef _STDLIB_H
-#      define _STDLIB_H 1
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
 #     endif
 #    endif
 #   endif
@@ -400,8 +498,8 @@ YYID (i)
 # endif
 
 # ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
@@ -415,90 +513,92 @@ YYID (i)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
 #   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
 #  endif
-#  if (defined __cplusplus && ! defined _STDLIB_H \
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
        && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
+             && (defined YYFREE || defined free)))
 #   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#   ifndef _STDLIB_H
-#    define _STDLIB_H 1
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
 #   endif
 #  endif
 #  ifndef YYMALLOC
 #   define YYMALLOC malloc
-#   if ! defined malloc && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined malloc && ! defined EXIT_SUCCESS
 void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 #  ifndef YYFREE
 #   define YYFREE free
-#   if ! defined free && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined free && ! defined EXIT_SUCCESS
 void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* 1 */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-	 || (defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL \
-	     && defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined WKT_YYLTYPE_IS_TRIVIAL && WKT_YYLTYPE_IS_TRIVIAL \
+             && defined WKT_YYSTYPE_IS_TRIVIAL && WKT_YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss;
-  YYSTYPE yyvs;
-    YYLTYPE yyls;
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+  YYLTYPE yyls_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE) + sizeof (YYLTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE) \
+             + YYSIZEOF (YYLTYPE)) \
       + 2 * YYSTACK_GAP_MAXIMUM)
 
-/* Copy COUNT objects from FROM to TO.  The source and destination do
-   not overlap.  */
-# ifndef YYCOPY
-#  if defined __GNUC__ && 1 < __GNUC__
-#   define YYCOPY(To, From, Count) \
-      __builtin_memcpy (To, From, (Count) * sizeof (*(From)))
-#  else
-#   define YYCOPY(To, From, Count)		\
-      do					\
-	{					\
-	  YYSIZE_T yyi;				\
-	  for (yyi = 0; yyi < (Count); yyi++)	\
-	    (To)[yyi] = (From)[yyi];		\
-	}					\
-      while (YYID (0))
-#  endif
-# endif
+# define YYCOPY_NEEDED 1
 
 /* Relocate STACK from its old location to the new one.  The
    local variables YYSIZE and YYSTACKSIZE give the old and new number of
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-# define YYSTACK_RELOCATE(Stack)					\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack, Stack, yysize);				\
-	Stack = &yyptr->Stack;						\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
 
 #endif
 
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  80
 /* YYLAST -- Last index in YYTABLE.  */
@@ -510,18 +610,23 @@ union yyalloc
 #define YYNNTS  40
 /* YYNRULES -- Number of rules.  */
 #define YYNRULES  136
-/* YYNRULES -- Number of states.  */
+/* YYNSTATES -- Number of states.  */
 #define YYNSTATES  264
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   280
 
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
 
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] =
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -554,221 +659,77 @@ static const yytype_uint8 yytranslate[] =
       25
 };
 
-#if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint16 yyprhs[] =
+#if WKT_YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,     0,     3,     5,     9,    11,    13,    15,    17,    19,
-      21,    23,    25,    27,    29,    31,    33,    35,    37,    39,
-      44,    50,    54,    57,    61,    63,    68,    74,    78,    81,
-      85,    89,    93,    95,    97,    99,   104,   110,   114,   117,
-     122,   128,   132,   135,   140,   146,   150,   153,   157,   159,
-     163,   165,   170,   176,   180,   183,   187,   189,   193,   198,
-     204,   208,   211,   215,   217,   219,   221,   223,   225,   229,
-     231,   235,   237,   241,   245,   250,   256,   260,   263,   267,
-     271,   275,   277,   279,   281,   286,   292,   296,   299,   303,
-     307,   311,   315,   317,   319,   321,   323,   328,   334,   338,
-     341,   345,   347,   352,   358,   362,   365,   370,   376,   380,
-     383,   387,   389,   393,   395,   402,   410,   414,   417,   423,
-     428,   434,   438,   441,   445,   447,   449,   453,   455,   460,
-     466,   470,   473,   477,   479,   482,   486
+       0,   222,   222,   224,   228,   229,   230,   231,   232,   233,
+     234,   235,   236,   237,   238,   239,   240,   241,   242,   245,
+     247,   249,   251,   255,   257,   261,   263,   265,   267,   271,
+     273,   275,   277,   279,   281,   285,   287,   289,   291,   295,
+     297,   299,   301,   305,   307,   309,   311,   315,   317,   321,
+     323,   327,   329,   331,   333,   337,   339,   343,   346,   348,
+     350,   352,   356,   358,   362,   363,   364,   365,   368,   370,
+     374,   376,   380,   383,   386,   388,   390,   392,   396,   398,
+     400,   402,   404,   406,   410,   412,   414,   416,   420,   422,
+     424,   426,   428,   430,   432,   434,   438,   440,   442,   444,
+     448,   450,   454,   456,   458,   460,   464,   466,   468,   470,
+     474,   476,   480,   482,   486,   488,   490,   492,   496,   500,
+     502,   504,   506,   510,   512,   516,   518,   520,   524,   526,
+     528,   530,   534,   536,   540,   542,   544
 };
+#endif
 
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int8 yyrhs[] =
-{
-      27,     0,    -1,    28,    -1,    25,    19,    28,    -1,    63,
-      -1,    55,    -1,    54,    -1,    48,    -1,    38,    -1,    41,
-      -1,    60,    -1,    52,    -1,    35,    -1,    31,    -1,    50,
-      -1,    33,    -1,    34,    -1,    58,    -1,    29,    -1,    14,
-      16,    30,    15,    -1,    14,    24,    16,    30,    15,    -1,
-      14,    24,    18,    -1,    14,    18,    -1,    30,    17,    28,
-      -1,    28,    -1,     9,    16,    32,    15,    -1,     9,    24,
-      16,    32,    15,    -1,     9,    24,    18,    -1,     9,    18,
-      -1,    32,    17,    38,    -1,    32,    17,    41,    -1,    32,
-      17,    39,    -1,    38,    -1,    41,    -1,    39,    -1,    21,
-      16,    57,    15,    -1,    21,    24,    16,    57,    15,    -1,
-      21,    24,    18,    -1,    21,    18,    -1,    22,    16,    37,
-      15,    -1,    22,    24,    16,    37,    15,    -1,    22,    24,
-      18,    -1,    22,    18,    -1,     8,    16,    36,    15,    -1,
-       8,    24,    16,    36,    15,    -1,     8,    24,    18,    -1,
-       8,    18,    -1,    36,    17,    39,    -1,    39,    -1,    37,
-      17,    40,    -1,    40,    -1,     5,    16,    45,    15,    -1,
-       5,    24,    16,    45,    15,    -1,     5,    24,    18,    -1,
-       5,    18,    -1,    16,    45,    15,    -1,    18,    -1,    16,
-      44,    15,    -1,    11,    16,    42,    15,    -1,    11,    24,
-      16,    42,    15,    -1,    11,    24,    18,    -1,    11,    18,
-      -1,    42,    17,    43,    -1,    43,    -1,    56,    -1,    55,
-      -1,    48,    -1,    54,    -1,    44,    17,    46,    -1,    46,
-      -1,    45,    17,    47,    -1,    47,    -1,    16,    64,    15,
-      -1,    16,    64,    15,    -1,    12,    16,    49,    15,    -1,
-      12,    24,    16,    49,    15,    -1,    12,    24,    18,    -1,
-      12,    18,    -1,    49,    17,    54,    -1,    49,    17,    55,
-      -1,    49,    17,    56,    -1,    54,    -1,    55,    -1,    56,
-      -1,    10,    16,    51,    15,    -1,    10,    24,    16,    51,
-      15,    -1,    10,    24,    18,    -1,    10,    18,    -1,    51,
-      17,    54,    -1,    51,    17,    48,    -1,    51,    17,    55,
-      -1,    51,    17,    56,    -1,    54,    -1,    48,    -1,    55,
-      -1,    56,    -1,     7,    16,    53,    15,    -1,     7,    24,
-      16,    53,    15,    -1,     7,    24,    18,    -1,     7,    18,
-      -1,    53,    17,    56,    -1,    56,    -1,    13,    16,    64,
-      15,    -1,    13,    24,    16,    64,    15,    -1,    13,    24,
-      18,    -1,    13,    18,    -1,     4,    16,    64,    15,    -1,
-       4,    24,    16,    64,    15,    -1,     4,    24,    18,    -1,
-       4,    18,    -1,    16,    64,    15,    -1,    18,    -1,    57,
-      17,    59,    -1,    59,    -1,    20,    16,    16,    64,    15,
-      15,    -1,    20,    24,    16,    16,    64,    15,    15,    -1,
-      20,    24,    18,    -1,    20,    18,    -1,    16,    16,    64,
-      15,    15,    -1,     6,    16,    61,    15,    -1,     6,    24,
-      16,    61,    15,    -1,     6,    24,    18,    -1,     6,    18,
-      -1,    61,    17,    62,    -1,    62,    -1,    65,    -1,    16,
-      65,    15,    -1,    18,    -1,     3,    16,    64,    15,    -1,
-       3,    24,    16,    64,    15,    -1,     3,    24,    18,    -1,
-       3,    18,    -1,    64,    17,    65,    -1,    65,    -1,    23,
-      23,    -1,    23,    23,    23,    -1,    23,    23,    23,    23,
-      -1
-};
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
 
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
-{
-       0,   210,   210,   212,   216,   217,   218,   219,   220,   221,
-     222,   223,   224,   225,   226,   227,   228,   229,   230,   233,
-     235,   237,   239,   243,   245,   249,   251,   253,   255,   259,
-     261,   263,   265,   267,   269,   273,   275,   277,   279,   283,
-     285,   287,   289,   293,   295,   297,   299,   303,   305,   309,
-     311,   315,   317,   319,   321,   325,   327,   331,   334,   336,
-     338,   340,   344,   346,   350,   351,   352,   353,   356,   358,
-     362,   364,   368,   371,   374,   376,   378,   380,   384,   386,
-     388,   390,   392,   394,   398,   400,   402,   404,   408,   410,
-     412,   414,   416,   418,   420,   422,   426,   428,   430,   432,
-     436,   438,   442,   444,   446,   448,   452,   454,   456,   458,
-     462,   464,   468,   470,   474,   476,   478,   480,   484,   488,
-     490,   492,   494,   498,   500,   504,   506,   508,   512,   514,
-     516,   518,   522,   524,   528,   530,   532
-};
-#endif
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
 
-#if YYDEBUG || YYERROR_VERBOSE || YYTOKEN_TABLE
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "POINT_TOK", "LINESTRING_TOK",
-  "POLYGON_TOK", "MPOINT_TOK", "MLINESTRING_TOK", "MPOLYGON_TOK",
-  "MSURFACE_TOK", "MCURVE_TOK", "CURVEPOLYGON_TOK", "COMPOUNDCURVE_TOK",
-  "CIRCULARSTRING_TOK", "COLLECTION_TOK", "RBRACKET_TOK", "LBRACKET_TOK",
-  "COMMA_TOK", "EMPTY_TOK", "SEMICOLON_TOK", "TRIANGLE_TOK", "TIN_TOK",
-  "POLYHEDRALSURFACE_TOK", "DOUBLE_TOK", "DIMENSIONALITY_TOK", "SRID_TOK",
-  "$accept", "geometry", "geometry_no_srid", "geometrycollection",
-  "geometry_list", "multisurface", "surface_list", "tin",
-  "polyhedralsurface", "multipolygon", "polygon_list", "patch_list",
-  "polygon", "polygon_untagged", "patch", "curvepolygon", "curvering_list",
+  "\"end of file\"", "error", "\"invalid token\"", "POINT_TOK",
+  "LINESTRING_TOK", "POLYGON_TOK", "MPOINT_TOK", "MLINESTRING_TOK",
+  "MPOLYGON_TOK", "MSURFACE_TOK", "MCURVE_TOK", "CURVEPOLYGON_TOK",
+  "COMPOUNDCURVE_TOK", "CIRCULARSTRING_TOK", "COLLECTION_TOK",
+  "RBRACKET_TOK", "LBRACKET_TOK", "COMMA_TOK", "EMPTY_TOK",
+  "SEMICOLON_TOK", "TRIANGLE_TOK", "TIN_TOK", "POLYHEDRALSURFACE_TOK",
+  "DOUBLE_TOK", "DIMENSIONALITY_TOK", "SRID_TOK", "$accept", "geometry",
+  "geometry_no_srid", "geometrycollection", "geometry_list",
+  "multisurface", "surface_list", "tin", "polyhedralsurface",
+  "multipolygon", "polygon_list", "patch_list", "polygon",
+  "polygon_untagged", "patch", "curvepolygon", "curvering_list",
   "curvering", "patchring_list", "ring_list", "patchring", "ring",
   "compoundcurve", "compound_list", "multicurve", "curve_list",
   "multilinestring", "linestring_list", "circularstring", "linestring",
   "linestring_untagged", "triangle_list", "triangle", "triangle_untagged",
   "multipoint", "point_list", "point_untagged", "point", "ptarray",
-  "coordinate", 0
+  "coordinate", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
-{
-       0,    26,    27,    27,    28,    28,    28,    28,    28,    28,
-      28,    28,    28,    28,    28,    28,    28,    28,    28,    29,
-      29,    29,    29,    30,    30,    31,    31,    31,    31,    32,
-      32,    32,    32,    32,    32,    33,    33,    33,    33,    34,
-      34,    34,    34,    35,    35,    35,    35,    36,    36,    37,
-      37,    38,    38,    38,    38,    39,    39,    40,    41,    41,
-      41,    41,    42,    42,    43,    43,    43,    43,    44,    44,
-      45,    45,    46,    47,    48,    48,    48,    48,    49,    49,
-      49,    49,    49,    49,    50,    50,    50,    50,    51,    51,
-      51,    51,    51,    51,    51,    51,    52,    52,    52,    52,
-      53,    53,    54,    54,    54,    54,    55,    55,    55,    55,
-      56,    56,    57,    57,    58,    58,    58,    58,    59,    60,
-      60,    60,    60,    61,    61,    62,    62,    62,    63,    63,
-      63,    63,    64,    64,    65,    65,    65
-};
+#define YYPACT_NINF (-90)
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
-{
-       0,     2,     1,     3,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     1,     4,
-       5,     3,     2,     3,     1,     4,     5,     3,     2,     3,
-       3,     3,     1,     1,     1,     4,     5,     3,     2,     4,
-       5,     3,     2,     4,     5,     3,     2,     3,     1,     3,
-       1,     4,     5,     3,     2,     3,     1,     3,     4,     5,
-       3,     2,     3,     1,     1,     1,     1,     1,     3,     1,
-       3,     1,     3,     3,     4,     5,     3,     2,     3,     3,
-       3,     1,     1,     1,     4,     5,     3,     2,     3,     3,
-       3,     3,     1,     1,     1,     1,     4,     5,     3,     2,
-       3,     1,     4,     5,     3,     2,     4,     5,     3,     2,
-       3,     1,     3,     1,     6,     7,     3,     2,     5,     4,
-       5,     3,     2,     3,     1,     1,     3,     1,     4,     5,
-       3,     2,     3,     1,     2,     3,     4
-};
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-/* YYDEFACT[STATE-NAME] -- Default rule to reduce with in state
-   STATE-NUM when YYTABLE doesn't specify something else to do.  Zero
-   means the default is an error.  */
-static const yytype_uint8 yydefact[] =
-{
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     2,    18,
-      13,    15,    16,    12,     8,     9,     7,    14,    11,     6,
-       5,    17,    10,     4,     0,   131,     0,     0,   109,     0,
-       0,    54,     0,     0,   122,     0,     0,    99,     0,     0,
-      46,     0,     0,    28,     0,     0,    87,     0,     0,    61,
-       0,     0,    77,     0,     0,   105,     0,     0,    22,     0,
-       0,   117,     0,     0,    38,     0,     0,    42,     0,     0,
-       1,     0,     0,   133,     0,   130,     0,     0,   108,     0,
-       0,    71,     0,    53,     0,   127,     0,   124,   125,     0,
-     121,     0,   111,     0,   101,     0,    98,     0,    56,     0,
-      48,     0,    45,     0,    32,    34,    33,     0,    27,    93,
-       0,    92,    94,    95,     0,    86,     0,    63,    66,    67,
-      65,    64,     0,    60,     0,    81,    82,    83,     0,    76,
-       0,     0,   104,    24,     0,     0,    21,     0,     0,   116,
-       0,     0,   113,     0,    37,     0,     0,    50,     0,    41,
-       3,   134,   128,     0,     0,   106,     0,     0,    51,     0,
-       0,     0,   119,     0,     0,     0,    96,     0,     0,     0,
-      43,     0,     0,    25,     0,     0,    84,     0,     0,    58,
-       0,     0,    74,     0,     0,   102,     0,    19,     0,     0,
-       0,     0,     0,    35,     0,     0,     0,     0,    69,    39,
-       0,     0,   135,   132,   129,   107,    73,    70,    52,   126,
-     123,   120,   110,   100,    97,    55,    47,    44,    29,    31,
-      30,    26,    89,    88,    90,    91,    85,    62,    59,    78,
-      79,    80,    75,   103,    23,    20,     0,     0,     0,   112,
-      36,     0,    57,     0,    49,    40,   136,   114,     0,     0,
-      72,    68,   115,   118
-};
+#define YYTABLE_NINF (-1)
 
-/* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int16 yydefgoto[] =
-{
-      -1,    17,   143,    19,   144,    20,   113,    21,    22,    23,
-     109,   156,    24,   110,   157,    25,   126,   127,   207,    90,
-     208,    91,    26,   134,    27,   120,    28,   103,    29,    30,
-     131,   151,    31,   152,    32,    96,    97,    33,    82,    83
-};
+#define yytable_value_is_error(Yyn) \
+  0
 
 /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
    STATE-NUM.  */
-#define YYPACT_NINF -90
 static const yytype_int16 yypact[] =
 {
      109,    -2,    16,    23,    26,    36,    39,    40,    52,    53,
@@ -800,6 +761,40 @@ static const yytype_int16 yypact[] =
      -90,   -90,   -90,   -90
 };
 
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_uint8 yydefact[] =
+{
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     2,    18,
+      13,    15,    16,    12,     8,     9,     7,    14,    11,     6,
+       5,    17,    10,     4,     0,   131,     0,     0,   109,     0,
+       0,    54,     0,     0,   122,     0,     0,    99,     0,     0,
+      46,     0,     0,    28,     0,     0,    87,     0,     0,    61,
+       0,     0,    77,     0,     0,   105,     0,     0,    22,     0,
+       0,   117,     0,     0,    38,     0,     0,    42,     0,     0,
+       1,     0,     0,   133,     0,   130,     0,     0,   108,     0,
+       0,    71,     0,    53,     0,   127,     0,   124,   125,     0,
+     121,     0,   111,     0,   101,     0,    98,     0,    56,     0,
+      48,     0,    45,     0,    32,    34,    33,     0,    27,    93,
+       0,    92,    94,    95,     0,    86,     0,    63,    66,    67,
+      65,    64,     0,    60,     0,    81,    82,    83,     0,    76,
+       0,     0,   104,    24,     0,     0,    21,     0,     0,   116,
+       0,     0,   113,     0,    37,     0,     0,    50,     0,    41,
+       3,   134,   128,     0,     0,   106,     0,     0,    51,     0,
+       0,     0,   119,     0,     0,     0,    96,     0,     0,     0,
+      43,     0,     0,    25,     0,     0,    84,     0,     0,    58,
+       0,     0,    74,     0,     0,   102,     0,    19,     0,     0,
+       0,     0,     0,    35,     0,     0,     0,     0,    69,    39,
+       0,     0,   135,   132,   129,   107,    73,    70,    52,   126,
+     123,   120,   110,   100,    97,    55,    47,    44,    29,    31,
+      30,    26,    89,    88,    90,    91,    85,    62,    59,    78,
+      79,    80,    75,   103,    23,    20,     0,     0,     0,   112,
+      36,     0,    57,     0,    49,    40,   136,   114,     0,     0,
+      72,    68,   115,   118
+};
+
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
@@ -809,12 +804,19 @@ static const yytype_int16 yypgoto[] =
      -44,   138,   -90,    89,   -90,   193,   121,   -90,   -36,    -6
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
-   number is the opposite.  If zero, do what YYDEFACT says.
-   If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -1
-static const yytype_uint16 yytable[] =
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
+{
+       0,    17,   143,    19,   144,    20,   113,    21,    22,    23,
+     109,   156,    24,   110,   157,    25,   126,   127,   207,    90,
+     208,    91,    26,   134,    27,   120,    28,   103,    29,    30,
+     131,   151,    31,   152,    32,    96,    97,    33,    82,    83
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
 {
       18,    86,   104,   170,   121,   119,   122,   129,   128,   130,
      135,   123,   136,   114,    34,     2,    35,   137,   179,   115,
@@ -882,9 +884,9 @@ static const yytype_uint8 yycheck[] =
      105,   153,    99,   204,   173
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,     3,     4,     5,     6,     7,     8,     9,    10,    11,
       12,    13,    14,    20,    21,    22,    25,    27,    28,    29,
@@ -915,183 +917,228 @@ static const yytype_uint8 yystos[] =
       15,    46,    15,    15
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
-
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    26,    27,    27,    28,    28,    28,    28,    28,    28,
+      28,    28,    28,    28,    28,    28,    28,    28,    28,    29,
+      29,    29,    29,    30,    30,    31,    31,    31,    31,    32,
+      32,    32,    32,    32,    32,    33,    33,    33,    33,    34,
+      34,    34,    34,    35,    35,    35,    35,    36,    36,    37,
+      37,    38,    38,    38,    38,    39,    39,    40,    41,    41,
+      41,    41,    42,    42,    43,    43,    43,    43,    44,    44,
+      45,    45,    46,    47,    48,    48,    48,    48,    49,    49,
+      49,    49,    49,    49,    50,    50,    50,    50,    51,    51,
+      51,    51,    51,    51,    51,    51,    52,    52,    52,    52,
+      53,    53,    54,    54,    54,    54,    55,    55,    55,    55,
+      56,    56,    57,    57,    58,    58,    58,    58,    59,    60,
+      60,    60,    60,    61,    61,    62,    62,    62,    63,    63,
+      63,    63,    64,    64,    65,    65,    65
+};
 
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     3,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     4,
+       5,     3,     2,     3,     1,     4,     5,     3,     2,     3,
+       3,     3,     1,     1,     1,     4,     5,     3,     2,     4,
+       5,     3,     2,     4,     5,     3,     2,     3,     1,     3,
+       1,     4,     5,     3,     2,     3,     1,     3,     4,     5,
+       3,     2,     3,     1,     1,     1,     1,     1,     3,     1,
+       3,     1,     3,     3,     4,     5,     3,     2,     3,     3,
+       3,     1,     1,     1,     4,     5,     3,     2,     3,     3,
+       3,     3,     1,     1,     1,     1,     4,     5,     3,     2,
+       3,     1,     4,     5,     3,     2,     4,     5,     3,     2,
+       3,     1,     3,     1,     6,     7,     3,     2,     5,     4,
+       5,     3,     2,     3,     1,     1,     3,     1,     4,     5,
+       3,     2,     3,     1,     2,     3,     4
+};
 
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  */
 
-#define YYFAIL		goto yyerrlab
+enum { YYENOMEM = -2 };
 
-#define YYRECOVERING()  (!!yyerrstatus)
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = WKT_YYEMPTY)
 
-#define YYBACKUP(Token, Value)					\
-do								\
-  if (yychar == YYEMPTY && yylen == 1)				\
-    {								\
-      yychar = (Token);						\
-      yylval = (Value);						\
-      yytoken = YYTRANSLATE (yychar);				\
-      YYPOPSTACK (1);						\
-      goto yybackup;						\
-    }								\
-  else								\
-    {								\
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
-#define YYTERROR	1
-#define YYERRCODE	256
+#define YYRECOVERING()  (!!yyerrstatus)
 
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == WKT_YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (&yylloc, scanner, state, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use WKT_YYerror or WKT_YYUNDEF. */
+#define YYERRCODE WKT_YYUNDEF
 
 /* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
    If N is 0, then set CURRENT to the empty location which ends
    the previous symbol: RHS[0] (always defined).  */
 
-#define YYRHSLOC(Rhs, K) ((Rhs)[K])
 #ifndef YYLLOC_DEFAULT
-# define YYLLOC_DEFAULT(Current, Rhs, N)				\
-    do									\
-      if (YYID (N))                                                    \
-	{								\
-	  (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;	\
-	  (Current).first_column = YYRHSLOC (Rhs, 1).first_column;	\
-	  (Current).last_line    = YYRHSLOC (Rhs, N).last_line;		\
-	  (Current).last_column  = YYRHSLOC (Rhs, N).last_column;	\
-	}								\
-      else								\
-	{								\
-	  (Current).first_line   = (Current).last_line   =		\
-	    YYRHSLOC (Rhs, 0).last_line;				\
-	  (Current).first_column = (Current).last_column =		\
-	    YYRHSLOC (Rhs, 0).last_column;				\
-	}								\
-    while (YYID (0))
+# define YYLLOC_DEFAULT(Current, Rhs, N)                                \
+    do                                                                  \
+      if (N)                                                            \
+        {                                                               \
+          (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;        \
+          (Current).first_column = YYRHSLOC (Rhs, 1).first_column;      \
+          (Current).last_line    = YYRHSLOC (Rhs, N).last_line;         \
+          (Current).last_column  = YYRHSLOC (Rhs, N).last_column;       \
+        }                                                               \
+      else                                                              \
+        {                                                               \
+          (Current).first_line   = (Current).last_line   =              \
+            YYRHSLOC (Rhs, 0).last_line;                                \
+          (Current).first_column = (Current).last_column =              \
+            YYRHSLOC (Rhs, 0).last_column;                              \
+        }                                                               \
+    while (0)
 #endif
 
+#define YYRHSLOC(Rhs, K) ((Rhs)[K])
+
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
+/* Enable debugging if requested.  */
+#if WKT_YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+/* YYLOCATION_PRINT -- Print the location on the stream.
    This macro was not mandated originally: define only if we know
    we won't break user code: when these are the locations we know.  */
 
-#ifndef YY_LOCATION_PRINT
-# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
-#  define YY_LOCATION_PRINT(File, Loc)			\
-     fprintf (File, "%d.%d-%d.%d",			\
-	      (Loc).first_line, (Loc).first_column,	\
-	      (Loc).last_line,  (Loc).last_column)
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
+# ifndef YYLOCATION_PRINT
 
+#  if defined YY_LOCATION_PRINT
 
-/* YYLEX -- calling `yylex' with the right arguments.  */
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
 
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (YYLEX_PARAM)
-#else
-# define YYLEX yylex ()
-#endif
+#  elif defined WKT_YYLTYPE_IS_TRIVIAL && WKT_YYLTYPE_IS_TRIVIAL
 
-/* Enable debugging if requested.  */
-#if YYDEBUG
+/* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
 
-# ifndef YYFPRINTF
-#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
-#  define YYFPRINTF fprintf
-# endif
+YY_ATTRIBUTE_UNUSED
+static int
+yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
+{
+  int res = 0;
+  int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
+  if (0 <= yylocp->first_line)
+    {
+      res += YYFPRINTF (yyo, "%d", yylocp->first_line);
+      if (0 <= yylocp->first_column)
+        res += YYFPRINTF (yyo, ".%d", yylocp->first_column);
+    }
+  if (0 <= yylocp->last_line)
+    {
+      if (yylocp->first_line < yylocp->last_line)
+        {
+          res += YYFPRINTF (yyo, "-%d", yylocp->last_line);
+          if (0 <= end_col)
+            res += YYFPRINTF (yyo, ".%d", end_col);
+        }
+      else if (0 <= end_col && yylocp->first_column < end_col)
+        res += YYFPRINTF (yyo, "-%d", end_col);
+    }
+  return res;
+}
+
+#   define YYLOCATION_PRINT  yy_location_print_
+
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
+
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, Location, scanner, state); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
 
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value, Location); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
-#else
 static void
-yy_symbol_value_print (yyoutput, yytype, yyvaluep, yylocationp)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-    YYLTYPE const * const yylocationp;
-#endif
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, void *scanner, WKT_PARSER_STATE *state)
 {
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  YY_USE (scanner);
+  YY_USE (state);
   if (!yyvaluep)
     return;
-  YYUSE (yylocationp);
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# else
-  YYUSE (yyoutput);
-# endif
-  switch (yytype)
-    {
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
-#else
-static void
-yy_symbol_print (yyoutput, yytype, yyvaluep, yylocationp)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-    YYLTYPE const * const yylocationp;
-#endif
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, void *scanner, WKT_PARSER_STATE *state)
 {
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  YY_LOCATION_PRINT (yyoutput, *yylocationp);
-  YYFPRINTF (yyoutput, ": ");
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep, yylocationp);
-  YYFPRINTF (yyoutput, ")");
+  YYLOCATION_PRINT (yyo, yylocationp);
+  YYFPRINTF (yyo, ": ");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp, scanner, state);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -1099,81 +1146,69 @@ yy_symbol_print (yyoutput, yytype, yyvaluep, yylocationp)
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_stack_print (yytype_int16 *bottom, yytype_int16 *top)
-#else
 static void
-yy_stack_print (bottom, top)
-    yytype_int16 *bottom;
-    yytype_int16 *top;
-#endif
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
-  for (; bottom <= top; ++bottom)
-    YYFPRINTF (stderr, " %d", *bottom);
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
   YYFPRINTF (stderr, "\n");
 }
 
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
 
 
 /*------------------------------------------------.
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_reduce_print (YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule)
-#else
-static void
-yy_reduce_print (yyvsp, yylsp, yyrule)
-    YYSTYPE *yyvsp;
-    YYLTYPE *yylsp;
-    int yyrule;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule, void *scanner, WKT_PARSER_STATE *state)
 {
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-	     yyrule - 1, yylno);
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
-      fprintf (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr, yyrhs[yyprhs[yyrule] + yyi],
-		       &(yyvsp[(yyi + 1) - (yynrhs)])
-		       , &(yylsp[(yyi + 1) - (yynrhs)])		       );
-      fprintf (stderr, "\n");
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]), scanner, state);
+      YYFPRINTF (stderr, "\n");
     }
 }
 
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, yylsp, Rule); \
-} while (YYID (0))
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, yylsp, Rule, scanner, state); \
+} while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
-#else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+#else /* !WKT_YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
-#endif /* !YYDEBUG */
+#endif /* !WKT_YYDEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
+#ifndef YYINITDEPTH
 # define YYINITDEPTH 200
 #endif
 
@@ -1188,49 +1223,82 @@ int yydebug;
 # define YYMAXDEPTH 10000
 #endif
 
-
 
-#if YYERROR_VERBOSE
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+  YYLTYPE *yylloc;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
+
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
 /* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T
+static YYPTRDIFF_T
 yystrlen (const char *yystr)
-#else
-static YYSIZE_T
-yystrlen (yystr)
-    const char *yystr;
-#endif
 {
-  YYSIZE_T yylen;
+  YYPTRDIFF_T yylen;
   for (yylen = 0; yystr[yylen]; yylen++)
     continue;
   return yylen;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
 /* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
    YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static char *
 yystpcpy (char *yydest, const char *yysrc)
-#else
-static char *
-yystpcpy (yydest, yysrc)
-    char *yydest;
-    const char *yysrc;
-#endif
 {
   char *yyd = yydest;
   const char *yys = yysrc;
@@ -1240,10 +1308,10 @@ yystpcpy (yydest, yysrc)
 
   return yyd - 1;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yytnamerr
+#ifndef yytnamerr
 /* Copy to YYRES the contents of YYSTR after stripping away unnecessary
    quotes and backslashes, so that it's suitable for yyerror.  The
    heuristic is that double-quoting is unnecessary unless the string
@@ -1251,403 +1319,432 @@ yystpcpy (yydest, yysrc)
    backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
    null, do not copy; instead, return the length of what the result
    would have been.  */
-static YYSIZE_T
+static YYPTRDIFF_T
 yytnamerr (char *yyres, const char *yystr)
 {
   if (*yystr == '"')
     {
-      YYSIZE_T yyn = 0;
+      YYPTRDIFF_T yyn = 0;
       char const *yyp = yystr;
-
       for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
+        switch (*++yyp)
+          {
+          case '\'':
+          case ',':
+            goto do_not_strip_quotes;
+
+          case '\\':
+            if (*++yyp != '\\')
+              goto do_not_strip_quotes;
+            else
+              goto append;
+
+          append:
+          default:
+            if (yyres)
+              yyres[yyn] = *yyp;
+            yyn++;
+            break;
+
+          case '"':
+            if (yyres)
+              yyres[yyn] = '\0';
+            return yyn;
+          }
     do_not_strip_quotes: ;
     }
 
-  if (! yyres)
+  if (yyres)
+    return yystpcpy (yyres, yystr) - yyres;
+  else
     return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
 }
-# endif
+#endif
 
-/* Copy into YYRESULT an error message about the unexpected token
-   YYCHAR while in state YYSTATE.  Return the number of bytes copied,
-   including the terminating null byte.  If YYRESULT is null, do not
-   copy anything; just return the number of bytes that would be
-   copied.  As a special case, return 0 if an ordinary "syntax error"
-   message will do.  Return YYSIZE_MAXIMUM if overflow occurs during
-   size calculation.  */
-static YYSIZE_T
-yysyntax_error (char *yyresult, int yystate, int yychar)
-{
-  int yyn = yypact[yystate];
 
-  if (! (YYPACT_NINF < yyn && yyn <= YYLAST))
-    return 0;
-  else
+static int
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  /* There are many possibilities here to consider:
+     - If this state is a consistent state with a default action, then
+       the only way this function was invoked is if the default action
+       is an error action.  In that case, don't check for expected
+       tokens because there are none.
+     - The only way there can be no lookahead present (in yychar) is if
+       this state is a consistent state with a default action.  Thus,
+       detecting the absence of a lookahead is sufficient to determine
+       that there is no unexpected or expected token to report.  In that
+       case, just report a simple "syntax error".
+     - Don't assume there isn't a lookahead just because this state is a
+       consistent state with a default action.  There might have been a
+       previous inconsistent state, consistent state with a non-default
+       action, or user semantic action that manipulated yychar.
+     - Of course, the expected token list depends on states to have
+       correct lookahead information, and it depends on the parser not
+       to perform extra reductions after fetching a lookahead from the
+       scanner and before detecting a syntax error.  Thus, state merging
+       (from LALR or IELR) and default reductions corrupt the expected
+       token list.  However, the list is correct for canonical LR with
+       one exception: it will still contain any token that will not be
+       accepted due to an error action in a later state.
+  */
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
     {
-      int yytype = YYTRANSLATE (yychar);
-      YYSIZE_T yysize0 = yytnamerr (0, yytname[yytype]);
-      YYSIZE_T yysize = yysize0;
-      YYSIZE_T yysize1;
-      int yysize_overflow = 0;
-      enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-      char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-      int yyx;
-
-# if 0
-      /* This is so xgettext sees the translatable formats that are
-	 constructed on the fly.  */
-      YY_("syntax error, unexpected %s");
-      YY_("syntax error, unexpected %s, expecting %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s");
-# endif
-      char *yyfmt;
-      char const *yyf;
-      static char const yyunexpected[] = "syntax error, unexpected %s";
-      static char const yyexpecting[] = ", expecting %s";
-      static char const yyor[] = " or %s";
-      char yyformat[sizeof yyunexpected
-		    + sizeof yyexpecting - 1
-		    + ((YYERROR_VERBOSE_ARGS_MAXIMUM - 2)
-		       * (sizeof yyor - 1))];
-      char const *yyprefix = yyexpecting;
-
-      /* Start YYX at -YYN if negative to avoid negative indexes in
-	 YYCHECK.  */
-      int yyxbegin = yyn < 0 ? -yyn : 0;
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
+    }
+  return yycount;
+}
 
-      /* Stay within bounds of both yycheck and yytname.  */
-      int yychecklim = YYLAST - yyn + 1;
-      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-      int yycount = 1;
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
 
-      yyarg[0] = yytname[yytype];
-      yyfmt = yystpcpy (yyformat, yyunexpected);
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
+
+  switch (yycount)
+    {
+#define YYCASE_(N, S)                       \
+      case N:                               \
+        yyformat = S;                       \
+        break
+    default: /* Avoid compiler warnings. */
+      YYCASE_(0, YY_("syntax error"));
+      YYCASE_(1, YY_("syntax error, unexpected %s"));
+      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
+      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
+      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
+      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
+#undef YYCASE_
+    }
 
-      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-	if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR)
-	  {
-	    if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-	      {
-		yycount = 1;
-		yysize = yysize0;
-		yyformat[sizeof yyunexpected - 1] = '\0';
-		break;
-	      }
-	    yyarg[yycount++] = yytname[yyx];
-	    yysize1 = yysize + yytnamerr (0, yytname[yyx]);
-	    yysize_overflow |= (yysize1 < yysize);
-	    yysize = yysize1;
-	    yyfmt = yystpcpy (yyfmt, yyprefix);
-	    yyprefix = yyor;
-	  }
-
-      yyf = YY_(yyformat);
-      yysize1 = yysize + yystrlen (yyf);
-      yysize_overflow |= (yysize1 < yysize);
-      yysize = yysize1;
-
-      if (yysize_overflow)
-	return YYSIZE_MAXIMUM;
-
-      if (yyresult)
-	{
-	  /* Avoid sprintf, as that infringes on the user's name space.
-	     Don't have undefined behavior even if the translation
-	     produced a string with the wrong number of "%s"s.  */
-	  char *yyp = yyresult;
-	  int yyi = 0;
-	  while ((*yyp = *yyf) != '\0')
-	    {
-	      if (*yyp == '%' && yyf[1] == 's' && yyi < yycount)
-		{
-		  yyp += yytnamerr (yyp, yyarg[yyi++]);
-		  yyf += 2;
-		}
-	      else
-		{
-		  yyp++;
-		  yyf++;
-		}
-	    }
-	}
-      return yysize;
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
+  {
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
+  }
+
+  if (*yymsg_alloc < yysize)
+    {
+      *yymsg_alloc = 2 * yysize;
+      if (! (yysize <= *yymsg_alloc
+             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
+        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
+      return -1;
     }
+
+  /* Avoid sprintf, as that infringes on the user's name space.
+     Don't have undefined behavior even if the translation
+     produced a string with the wrong number of "%s"s.  */
+  {
+    char *yyp = *yymsg;
+    int yyi = 0;
+    while ((*yyp = *yyformat) != '\0')
+      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
+        {
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
+          yyformat += 2;
+        }
+      else
+        {
+          ++yyp;
+          ++yyformat;
+        }
+  }
+  return 0;
 }
-#endif /* YYERROR_VERBOSE */
-
+
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocationp)
-#else
 static void
-yydestruct (yymsg, yytype, yyvaluep, yylocationp)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-    YYLTYPE *yylocationp;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, void *scanner, WKT_PARSER_STATE *state)
 {
-  YYUSE (yyvaluep);
-  YYUSE (yylocationp);
-
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
+  YY_USE (scanner);
+  YY_USE (state);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
-  switch (yytype)
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  switch (yykind)
     {
-      case 28: /* "geometry_no_srid" */
-#line 187 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1435 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 29: /* "geometrycollection" */
-#line 188 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1440 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 30: /* "geometry_list" */
-#line 189 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1445 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 31: /* "multisurface" */
-#line 196 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1450 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 32: /* "surface_list" */
-#line 174 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1455 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 33: /* "tin" */
-#line 203 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1460 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 34: /* "polyhedralsurface" */
-#line 202 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1465 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 35: /* "multipolygon" */
-#line 195 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1470 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 36: /* "polygon_list" */
-#line 175 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1475 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 37: /* "patch_list" */
-#line 176 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1480 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 38: /* "polygon" */
+    case YYSYMBOL_geometry_no_srid: /* geometry_no_srid  */
 #line 199 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1485 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 39: /* "polygon_untagged" */
-#line 201 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1490 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 40: /* "patch" */
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1522 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_geometrycollection: /* geometrycollection  */
 #line 200 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1495 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 41: /* "curvepolygon" */
-#line 185 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1500 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 42: /* "curvering_list" */
-#line 172 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1505 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 43: /* "curvering" */
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1528 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_geometry_list: /* geometry_list  */
+#line 201 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1534 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_multisurface: /* multisurface  */
+#line 208 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1540 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_surface_list: /* surface_list  */
 #line 186 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1510 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 44: /* "patchring_list" */
-#line 182 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1515 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 45: /* "ring_list" */
-#line 181 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1520 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 46: /* "patchring" */
-#line 171 "extension/geo/parser/lwin_wkt_parse.y"
-	{ ptarray_free((yyvaluep->ptarrayvalue)); };
-#line 1525 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 47: /* "ring" */
-#line 170 "extension/geo/parser/lwin_wkt_parse.y"
-	{ ptarray_free((yyvaluep->ptarrayvalue)); };
-#line 1530 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 48: /* "compoundcurve" */
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1546 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_tin: /* tin  */
+#line 215 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1552 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_polyhedralsurface: /* polyhedralsurface  */
+#line 214 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1558 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_multipolygon: /* multipolygon  */
+#line 207 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1564 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_polygon_list: /* polygon_list  */
+#line 187 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1570 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_patch_list: /* patch_list  */
+#line 188 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1576 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_polygon: /* polygon  */
+#line 211 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1582 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_polygon_untagged: /* polygon_untagged  */
+#line 213 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1588 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_patch: /* patch  */
+#line 212 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1594 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_curvepolygon: /* curvepolygon  */
+#line 197 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1600 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_curvering_list: /* curvering_list  */
 #line 184 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1535 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 49: /* "compound_list" */
-#line 180 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1540 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 50: /* "multicurve" */
-#line 192 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1545 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 51: /* "curve_list" */
-#line 179 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1550 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 52: /* "multilinestring" */
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1606 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_curvering: /* curvering  */
+#line 198 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1612 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_patchring_list: /* patchring_list  */
+#line 194 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1618 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_ring_list: /* ring_list  */
 #line 193 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1555 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 53: /* "linestring_list" */
-#line 178 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1560 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 54: /* "circularstring" */
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1624 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_patchring: /* patchring  */
 #line 183 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1565 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 55: /* "linestring" */
-#line 190 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1570 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 56: /* "linestring_untagged" */
-#line 191 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1575 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 57: /* "triangle_list" */
-#line 173 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1580 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 58: /* "triangle" */
+            { ptarray_free(((*yyvaluep).ptarrayvalue)); }
+#line 1630 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_ring: /* ring  */
+#line 182 "extension/geo/parser/lwin_wkt_parse.y"
+            { ptarray_free(((*yyvaluep).ptarrayvalue)); }
+#line 1636 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_compoundcurve: /* compoundcurve  */
+#line 196 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1642 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_compound_list: /* compound_list  */
+#line 192 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1648 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_multicurve: /* multicurve  */
 #line 204 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1585 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 59: /* "triangle_untagged" */
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1654 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_curve_list: /* curve_list  */
+#line 191 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1660 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_multilinestring: /* multilinestring  */
 #line 205 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1590 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 60: /* "multipoint" */
-#line 194 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1595 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 61: /* "point_list" */
-#line 177 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1600 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 62: /* "point_untagged" */
-#line 198 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1605 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 63: /* "point" */
-#line 197 "extension/geo/parser/lwin_wkt_parse.y"
-	{ lwgeom_free((yyvaluep->geometryvalue)); };
-#line 1610 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
-      case 64: /* "ptarray" */
-#line 169 "extension/geo/parser/lwin_wkt_parse.y"
-	{ ptarray_free((yyvaluep->ptarrayvalue)); };
-#line 1615 "extension/geo/parser/lwin_wkt_parse.cpp"
-	break;
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1666 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
 
-      default:
-	break;
-    }
-}
-
+    case YYSYMBOL_linestring_list: /* linestring_list  */
+#line 190 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1672 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
 
-/* Prevent warnings from -Wmissing-prototypes.  */
+    case YYSYMBOL_circularstring: /* circularstring  */
+#line 195 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1678 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
 
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
-#else
-int yyparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
+    case YYSYMBOL_linestring: /* linestring  */
+#line 202 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1684 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_linestring_untagged: /* linestring_untagged  */
+#line 203 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1690 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
 
+    case YYSYMBOL_triangle_list: /* triangle_list  */
+#line 185 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1696 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
 
+    case YYSYMBOL_triangle: /* triangle  */
+#line 216 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1702 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_triangle_untagged: /* triangle_untagged  */
+#line 217 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1708 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_multipoint: /* multipoint  */
+#line 206 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1714 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_point_list: /* point_list  */
+#line 189 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1720 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_point_untagged: /* point_untagged  */
+#line 210 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1726 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_point: /* point  */
+#line 209 "extension/geo/parser/lwin_wkt_parse.y"
+            { lwgeom_free(((*yyvaluep).geometryvalue)); }
+#line 1732 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+    case YYSYMBOL_ptarray: /* ptarray  */
+#line 181 "extension/geo/parser/lwin_wkt_parse.y"
+            { ptarray_free(((*yyvaluep).ptarrayvalue)); }
+#line 1738 "extension/geo/parser/lwin_wkt_parse.cpp"
+        break;
+
+      default:
+        break;
+    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
 
-/* The look-ahead symbol.  */
-int yychar;
 
-/* The semantic value of the look-ahead symbol.  */
-YYSTYPE yylval;
 
-/* Number of syntax errors so far.  */
-int yynerrs;
-/* Location data for the look-ahead symbol.  */
-YYLTYPE yylloc;
 
 
 
@@ -1655,211 +1752,229 @@ YYLTYPE yylloc;
 | yyparse.  |
 `----------*/
 
-#ifdef YYPARSE_PARAM
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void *YYPARSE_PARAM)
-#else
-int
-yyparse (YYPARSE_PARAM)
-    void *YYPARSE_PARAM;
-#endif
-#else /* ! YYPARSE_PARAM */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void)
-#else
 int
-yyparse ()
-
-#endif
-#endif
+yyparse (void *scanner, WKT_PARSER_STATE *state)
 {
-  
-  int yystate;
-  int yyn;
-  int yyresult;
-  /* Number of tokens to shift before error messages enabled.  */
-  int yyerrstatus;
-  /* Look-ahead token as an internal (translated) token number.  */
-  int yytoken = 0;
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+/* Lookahead token kind.  */
+int yychar;
 
-  /* Three stacks and their tools:
-     `yyss': related to states,
-     `yyvs': related to semantic values,
-     `yyls': related to locations.
 
-     Refer to the stacks thru separate pointers, to allow yyoverflow
-     to reallocate them elsewhere.  */
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
 
-  /* The state stack.  */
-  yytype_int16 yyssa[YYINITDEPTH];
-  yytype_int16 *yyss = yyssa;
-  yytype_int16 *yyssp;
+/* Location data for the lookahead symbol.  */
+static YYLTYPE yyloc_default
+# if defined WKT_YYLTYPE_IS_TRIVIAL && WKT_YYLTYPE_IS_TRIVIAL
+  = { 1, 1, 1, 1 }
+# endif
+;
+YYLTYPE yylloc = yyloc_default;
 
-  /* The semantic value stack.  */
-  YYSTYPE yyvsa[YYINITDEPTH];
-  YYSTYPE *yyvs = yyvsa;
-  YYSTYPE *yyvsp;
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
 
-  /* The location stack.  */
-  YYLTYPE yylsa[YYINITDEPTH];
-  YYLTYPE *yyls = yylsa;
-  YYLTYPE *yylsp;
-  /* The locations where the error started and ended.  */
-  YYLTYPE yyerror_range[2];
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
 
-#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
-  YYSIZE_T yystacksize = YYINITDEPTH;
+    /* The location stack: array, bottom, top.  */
+    YYLTYPE yylsa[YYINITDEPTH];
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
 
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
   YYLTYPE yyloc;
 
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
+  /* Buffer for error messages, and its allocated size.  */
+  char yymsgbuf[128];
+  char *yymsg = yymsgbuf;
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
+
   /* The number of symbols on the RHS of the reduced rule.
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
-  yychar = YYEMPTY;		/* Cause a token to be read.  */
-
-  /* Initialize stack pointers.
-     Waste one element of value and location stack
-     so that they stay on the same level as the state stack.
-     The wasted elements are never initialized.  */
-
-  yyssp = yyss;
-  yyvsp = yyvs;
-  yylsp = yyls;
-#if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
-  /* Initialize the default location before parsing starts.  */
-  yylloc.first_line   = yylloc.last_line   = 1;
-  yylloc.first_column = yylloc.last_column = 0;
-#endif
+  yychar = WKT_YYEMPTY; /* Cause a token to be read.  */
+
+
+/* User initialization code.  */
+#line 113 "extension/geo/parser/lwin_wkt_parse.y"
+{
+	yylloc.first_column = yylloc.last_column = 1;
+}
+
+#line 1840 "extension/geo/parser/lwin_wkt_parse.cpp"
 
+  yylsp[0] = yylloc;
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
-	/* Give user a chance to reallocate the stack.  Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	yytype_int16 *yyss1 = yyss;
-	YYLTYPE *yyls1 = yyls;
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-		    &yyls1, yysize * sizeof (*yylsp),
-		    &yystacksize);
-	yyls = yyls1;
-	yyss = yyss1;
-	yyvs = yyvs1;
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+        YYLTYPE *yyls1 = yyls;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yyls1, yysize * YYSIZEOF (*yylsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+        yyls = yyls1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
+        yystacksize = YYMAXDEPTH;
 
       {
-	yytype_int16 *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss);
-	YYSTACK_RELOCATE (yyvs);
-	YYSTACK_RELOCATE (yyls);
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        YYSTACK_RELOCATE (yyls_alloc, yyls);
 #  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
       yylsp = yyls + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
-     look-ahead token if we need one and don't already have one.  */
+     lookahead token if we need one and don't already have one.  */
 
-  /* First try to decide what to do without reference to look-ahead token.  */
+  /* First try to decide what to do without reference to lookahead token.  */
   yyn = yypact[yystate];
-  if (yyn == YYPACT_NINF)
+  if (yypact_value_is_default (yyn))
     goto yydefault;
 
-  /* Not known => get a look-ahead token if don't already have one.  */
+  /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid look-ahead symbol.  */
-  if (yychar == YYEMPTY)
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == WKT_YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, &yylloc, scanner);
     }
 
-  if (yychar <= YYEOF)
+  if (yychar <= WKT_YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = WKT_YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == WKT_YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = WKT_YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1874,30 +1989,27 @@ yybackup:
   yyn = yytable[yyn];
   if (yyn <= 0)
     {
-      if (yyn == 0 || yyn == YYTABLE_NINF)
-	goto yyerrlab;
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
       yyn = -yyn;
       goto yyreduce;
     }
 
-  if (yyn == YYFINAL)
-    YYACCEPT;
-
   /* Count tokens shifted since error; after three, turn off error
      status.  */
   if (yyerrstatus)
     yyerrstatus--;
 
-  /* Shift the look-ahead token.  */
+  /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token unless it is eof.  */
-  if (yychar != YYEOF)
-    yychar = YYEMPTY;
-
   yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
   *++yylsp = yylloc;
+
+  /* Discard the shifted token.  */
+  yychar = WKT_YYEMPTY;
   goto yynewstate;
 
 
@@ -1912,14 +2024,14 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
   yylen = yyr2[yyn];
 
   /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
+     '$$ = $1'.
 
      Otherwise, the following line sets YYVAL to garbage.
      This behavior is undocumented and Bison
@@ -1928,782 +2040,925 @@ yyreduce:
      GCC warning that YYVAL may be used uninitialized.  */
   yyval = yyvsp[1-yylen];
 
-  /* Default location.  */
+  /* Default location. */
   YYLLOC_DEFAULT (yyloc, (yylsp - yylen), yylen);
+  yyerror_range[1] = yyloc;
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-#line 211 "extension/geo/parser/lwin_wkt_parse.y"
-    { wkt_parser_geometry_new((yyvsp[(1) - (1)].geometryvalue), SRID_UNKNOWN); WKT_ERROR(); ;}
-    break;
-
-  case 3:
-#line 213 "extension/geo/parser/lwin_wkt_parse.y"
-    { wkt_parser_geometry_new((yyvsp[(3) - (3)].geometryvalue), (yyvsp[(1) - (3)].integervalue)); WKT_ERROR(); ;}
-    break;
-
-  case 4:
-#line 216 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = (yyvsp[(1) - (1)].geometryvalue); ;}
-    break;
-
-  case 5:
-#line 217 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = (yyvsp[(1) - (1)].geometryvalue); ;}
-    break;
-
-  case 6:
-#line 218 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = (yyvsp[(1) - (1)].geometryvalue); ;}
+  case 2: /* geometry: geometry_no_srid  */
+#line 223 "extension/geo/parser/lwin_wkt_parse.y"
+                { wkt_parser_geometry_new(state, (yyvsp[0].geometryvalue), SRID_UNKNOWN); WKT_ERROR(); }
+#line 2053 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 7:
-#line 219 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = (yyvsp[(1) - (1)].geometryvalue); ;}
+  case 3: /* geometry: SRID_TOK SEMICOLON_TOK geometry_no_srid  */
+#line 225 "extension/geo/parser/lwin_wkt_parse.y"
+                { wkt_parser_geometry_new(state, (yyvsp[0].geometryvalue), (yyvsp[-2].integervalue)); WKT_ERROR(); }
+#line 2059 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 8:
-#line 220 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = (yyvsp[(1) - (1)].geometryvalue); ;}
+  case 4: /* geometry_no_srid: point  */
+#line 228 "extension/geo/parser/lwin_wkt_parse.y"
+              { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
+#line 2065 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 9:
-#line 221 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = (yyvsp[(1) - (1)].geometryvalue); ;}
+  case 5: /* geometry_no_srid: linestring  */
+#line 229 "extension/geo/parser/lwin_wkt_parse.y"
+                   { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
+#line 2071 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 10:
-#line 222 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = (yyvsp[(1) - (1)].geometryvalue); ;}
+  case 6: /* geometry_no_srid: circularstring  */
+#line 230 "extension/geo/parser/lwin_wkt_parse.y"
+                       { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
+#line 2077 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 11:
-#line 223 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = (yyvsp[(1) - (1)].geometryvalue); ;}
+  case 7: /* geometry_no_srid: compoundcurve  */
+#line 231 "extension/geo/parser/lwin_wkt_parse.y"
+                      { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
+#line 2083 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 12:
-#line 224 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = (yyvsp[(1) - (1)].geometryvalue); ;}
+  case 8: /* geometry_no_srid: polygon  */
+#line 232 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
+#line 2089 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 13:
-#line 225 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = (yyvsp[(1) - (1)].geometryvalue); ;}
+  case 9: /* geometry_no_srid: curvepolygon  */
+#line 233 "extension/geo/parser/lwin_wkt_parse.y"
+                     { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
+#line 2095 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 14:
-#line 226 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = (yyvsp[(1) - (1)].geometryvalue); ;}
+  case 10: /* geometry_no_srid: multipoint  */
+#line 234 "extension/geo/parser/lwin_wkt_parse.y"
+                   { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
+#line 2101 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 15:
-#line 227 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = (yyvsp[(1) - (1)].geometryvalue); ;}
+  case 11: /* geometry_no_srid: multilinestring  */
+#line 235 "extension/geo/parser/lwin_wkt_parse.y"
+                        { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
+#line 2107 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 16:
-#line 228 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = (yyvsp[(1) - (1)].geometryvalue); ;}
+  case 12: /* geometry_no_srid: multipolygon  */
+#line 236 "extension/geo/parser/lwin_wkt_parse.y"
+                     { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
+#line 2113 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 17:
-#line 229 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = (yyvsp[(1) - (1)].geometryvalue); ;}
+  case 13: /* geometry_no_srid: multisurface  */
+#line 237 "extension/geo/parser/lwin_wkt_parse.y"
+                     { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
+#line 2119 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 18:
-#line 230 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = (yyvsp[(1) - (1)].geometryvalue); ;}
+  case 14: /* geometry_no_srid: multicurve  */
+#line 238 "extension/geo/parser/lwin_wkt_parse.y"
+                   { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
+#line 2125 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 19:
-#line 234 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(COLLECTIONTYPE, (yyvsp[(3) - (4)].geometryvalue), NULL); WKT_ERROR(); ;}
+  case 15: /* geometry_no_srid: tin  */
+#line 239 "extension/geo/parser/lwin_wkt_parse.y"
+            { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
+#line 2131 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 20:
-#line 236 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(COLLECTIONTYPE, (yyvsp[(4) - (5)].geometryvalue), (yyvsp[(2) - (5)].stringvalue)); WKT_ERROR(); ;}
+  case 16: /* geometry_no_srid: polyhedralsurface  */
+#line 240 "extension/geo/parser/lwin_wkt_parse.y"
+                          { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
+#line 2137 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 21:
-#line 238 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(COLLECTIONTYPE, NULL, (yyvsp[(2) - (3)].stringvalue)); WKT_ERROR(); ;}
+  case 17: /* geometry_no_srid: triangle  */
+#line 241 "extension/geo/parser/lwin_wkt_parse.y"
+                 { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
+#line 2143 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 22:
-#line 240 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(COLLECTIONTYPE, NULL, NULL); WKT_ERROR(); ;}
+  case 18: /* geometry_no_srid: geometrycollection  */
+#line 242 "extension/geo/parser/lwin_wkt_parse.y"
+                           { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
+#line 2149 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 23:
-#line 244 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[(1) - (3)].geometryvalue),(yyvsp[(3) - (3)].geometryvalue)); WKT_ERROR(); ;}
+  case 19: /* geometrycollection: COLLECTION_TOK LBRACKET_TOK geometry_list RBRACKET_TOK  */
+#line 246 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, COLLECTIONTYPE, (yyvsp[-1].geometryvalue), NULL); WKT_ERROR(); }
+#line 2155 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 24:
-#line 246 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[(1) - (1)].geometryvalue)); WKT_ERROR(); ;}
+  case 20: /* geometrycollection: COLLECTION_TOK DIMENSIONALITY_TOK LBRACKET_TOK geometry_list RBRACKET_TOK  */
+#line 248 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, COLLECTIONTYPE, (yyvsp[-1].geometryvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
+#line 2161 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 25:
+  case 21: /* geometrycollection: COLLECTION_TOK DIMENSIONALITY_TOK EMPTY_TOK  */
 #line 250 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTISURFACETYPE, (yyvsp[(3) - (4)].geometryvalue), NULL); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, COLLECTIONTYPE, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
+#line 2167 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 26:
+  case 22: /* geometrycollection: COLLECTION_TOK EMPTY_TOK  */
 #line 252 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTISURFACETYPE, (yyvsp[(4) - (5)].geometryvalue), (yyvsp[(2) - (5)].stringvalue)); WKT_ERROR(); ;}
-    break;
-
-  case 27:
-#line 254 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTISURFACETYPE, NULL, (yyvsp[(2) - (3)].stringvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, COLLECTIONTYPE, NULL, NULL); WKT_ERROR(); }
+#line 2173 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 28:
+  case 23: /* geometry_list: geometry_list COMMA_TOK geometry_no_srid  */
 #line 256 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTISURFACETYPE, NULL, NULL); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_add_geom(state, (yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2179 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 29:
-#line 260 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[(1) - (3)].geometryvalue),(yyvsp[(3) - (3)].geometryvalue)); WKT_ERROR(); ;}
+  case 24: /* geometry_list: geometry_no_srid  */
+#line 258 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_collection_new(state, (yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2185 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 30:
+  case 25: /* multisurface: MSURFACE_TOK LBRACKET_TOK surface_list RBRACKET_TOK  */
 #line 262 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[(1) - (3)].geometryvalue),(yyvsp[(3) - (3)].geometryvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, MULTISURFACETYPE, (yyvsp[-1].geometryvalue), NULL); WKT_ERROR(); }
+#line 2191 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 31:
+  case 26: /* multisurface: MSURFACE_TOK DIMENSIONALITY_TOK LBRACKET_TOK surface_list RBRACKET_TOK  */
 #line 264 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[(1) - (3)].geometryvalue),(yyvsp[(3) - (3)].geometryvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, MULTISURFACETYPE, (yyvsp[-1].geometryvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
+#line 2197 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 32:
+  case 27: /* multisurface: MSURFACE_TOK DIMENSIONALITY_TOK EMPTY_TOK  */
 #line 266 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[(1) - (1)].geometryvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, MULTISURFACETYPE, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
+#line 2203 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 33:
+  case 28: /* multisurface: MSURFACE_TOK EMPTY_TOK  */
 #line 268 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[(1) - (1)].geometryvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, MULTISURFACETYPE, NULL, NULL); WKT_ERROR(); }
+#line 2209 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 34:
-#line 270 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[(1) - (1)].geometryvalue)); WKT_ERROR(); ;}
+  case 29: /* surface_list: surface_list COMMA_TOK polygon  */
+#line 272 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_collection_add_geom(state, (yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2215 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 35:
+  case 30: /* surface_list: surface_list COMMA_TOK curvepolygon  */
 #line 274 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(TINTYPE, (yyvsp[(3) - (4)].geometryvalue), NULL); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_add_geom(state, (yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2221 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 36:
+  case 31: /* surface_list: surface_list COMMA_TOK polygon_untagged  */
 #line 276 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(TINTYPE, (yyvsp[(4) - (5)].geometryvalue), (yyvsp[(2) - (5)].stringvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_add_geom(state, (yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2227 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 37:
+  case 32: /* surface_list: polygon  */
 #line 278 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(TINTYPE, NULL, (yyvsp[(2) - (3)].stringvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_new(state, (yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2233 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 38:
+  case 33: /* surface_list: curvepolygon  */
 #line 280 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(TINTYPE, NULL, NULL); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_new(state, (yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2239 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 39:
-#line 284 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(POLYHEDRALSURFACETYPE, (yyvsp[(3) - (4)].geometryvalue), NULL); WKT_ERROR(); ;}
+  case 34: /* surface_list: polygon_untagged  */
+#line 282 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_collection_new(state, (yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2245 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 40:
+  case 35: /* tin: TIN_TOK LBRACKET_TOK triangle_list RBRACKET_TOK  */
 #line 286 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(POLYHEDRALSURFACETYPE, (yyvsp[(4) - (5)].geometryvalue), (yyvsp[(2) - (5)].stringvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, TINTYPE, (yyvsp[-1].geometryvalue), NULL); WKT_ERROR(); }
+#line 2251 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 41:
+  case 36: /* tin: TIN_TOK DIMENSIONALITY_TOK LBRACKET_TOK triangle_list RBRACKET_TOK  */
 #line 288 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(POLYHEDRALSURFACETYPE, NULL, (yyvsp[(2) - (3)].stringvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, TINTYPE, (yyvsp[-1].geometryvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
+#line 2257 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 42:
+  case 37: /* tin: TIN_TOK DIMENSIONALITY_TOK EMPTY_TOK  */
 #line 290 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(POLYHEDRALSURFACETYPE, NULL, NULL); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, TINTYPE, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
+#line 2263 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 43:
-#line 294 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTIPOLYGONTYPE, (yyvsp[(3) - (4)].geometryvalue), NULL); WKT_ERROR(); ;}
+  case 38: /* tin: TIN_TOK EMPTY_TOK  */
+#line 292 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, TINTYPE, NULL, NULL); WKT_ERROR(); }
+#line 2269 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 44:
+  case 39: /* polyhedralsurface: POLYHEDRALSURFACE_TOK LBRACKET_TOK patch_list RBRACKET_TOK  */
 #line 296 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTIPOLYGONTYPE, (yyvsp[(4) - (5)].geometryvalue), (yyvsp[(2) - (5)].stringvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, POLYHEDRALSURFACETYPE, (yyvsp[-1].geometryvalue), NULL); WKT_ERROR(); }
+#line 2275 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 45:
+  case 40: /* polyhedralsurface: POLYHEDRALSURFACE_TOK DIMENSIONALITY_TOK LBRACKET_TOK patch_list RBRACKET_TOK  */
 #line 298 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTIPOLYGONTYPE, NULL, (yyvsp[(2) - (3)].stringvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, POLYHEDRALSURFACETYPE, (yyvsp[-1].geometryvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
+#line 2281 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 46:
+  case 41: /* polyhedralsurface: POLYHEDRALSURFACE_TOK DIMENSIONALITY_TOK EMPTY_TOK  */
 #line 300 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTIPOLYGONTYPE, NULL, NULL); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, POLYHEDRALSURFACETYPE, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
+#line 2287 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 47:
-#line 304 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[(1) - (3)].geometryvalue),(yyvsp[(3) - (3)].geometryvalue)); WKT_ERROR(); ;}
+  case 42: /* polyhedralsurface: POLYHEDRALSURFACE_TOK EMPTY_TOK  */
+#line 302 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, POLYHEDRALSURFACETYPE, NULL, NULL); WKT_ERROR(); }
+#line 2293 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 48:
+  case 43: /* multipolygon: MPOLYGON_TOK LBRACKET_TOK polygon_list RBRACKET_TOK  */
 #line 306 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[(1) - (1)].geometryvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, MULTIPOLYGONTYPE, (yyvsp[-1].geometryvalue), NULL); WKT_ERROR(); }
+#line 2299 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 49:
+  case 44: /* multipolygon: MPOLYGON_TOK DIMENSIONALITY_TOK LBRACKET_TOK polygon_list RBRACKET_TOK  */
+#line 308 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, MULTIPOLYGONTYPE, (yyvsp[-1].geometryvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
+#line 2305 "extension/geo/parser/lwin_wkt_parse.cpp"
+    break;
+
+  case 45: /* multipolygon: MPOLYGON_TOK DIMENSIONALITY_TOK EMPTY_TOK  */
 #line 310 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[(1) - (3)].geometryvalue),(yyvsp[(3) - (3)].geometryvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, MULTIPOLYGONTYPE, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
+#line 2311 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 50:
+  case 46: /* multipolygon: MPOLYGON_TOK EMPTY_TOK  */
 #line 312 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[(1) - (1)].geometryvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, MULTIPOLYGONTYPE, NULL, NULL); WKT_ERROR(); }
+#line 2317 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 51:
+  case 47: /* polygon_list: polygon_list COMMA_TOK polygon_untagged  */
 #line 316 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_polygon_finalize((yyvsp[(3) - (4)].geometryvalue), NULL); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_add_geom(state, (yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2323 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 52:
+  case 48: /* polygon_list: polygon_untagged  */
 #line 318 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_polygon_finalize((yyvsp[(4) - (5)].geometryvalue), (yyvsp[(2) - (5)].stringvalue)); WKT_ERROR(); ;}
-    break;
-
-  case 53:
-#line 320 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_polygon_finalize(NULL, (yyvsp[(2) - (3)].stringvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_new(state, (yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2329 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 54:
+  case 49: /* patch_list: patch_list COMMA_TOK patch  */
 #line 322 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_polygon_finalize(NULL, NULL); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_add_geom(state, (yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2335 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 55:
-#line 326 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = (yyvsp[(2) - (3)].geometryvalue); ;}
+  case 50: /* patch_list: patch  */
+#line 324 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_collection_new(state, (yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2341 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 56:
+  case 51: /* polygon: POLYGON_TOK LBRACKET_TOK ring_list RBRACKET_TOK  */
 #line 328 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_polygon_finalize(NULL, NULL); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_polygon_finalize(state, (yyvsp[-1].geometryvalue), NULL); WKT_ERROR(); }
+#line 2347 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 57:
-#line 331 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = (yyvsp[(2) - (3)].geometryvalue); ;}
+  case 52: /* polygon: POLYGON_TOK DIMENSIONALITY_TOK LBRACKET_TOK ring_list RBRACKET_TOK  */
+#line 330 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_polygon_finalize(state, (yyvsp[-1].geometryvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
+#line 2353 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 58:
-#line 335 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_curvepolygon_finalize((yyvsp[(3) - (4)].geometryvalue), NULL); WKT_ERROR(); ;}
+  case 53: /* polygon: POLYGON_TOK DIMENSIONALITY_TOK EMPTY_TOK  */
+#line 332 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_polygon_finalize(state, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
+#line 2359 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 59:
-#line 337 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_curvepolygon_finalize((yyvsp[(4) - (5)].geometryvalue), (yyvsp[(2) - (5)].stringvalue)); WKT_ERROR(); ;}
+  case 54: /* polygon: POLYGON_TOK EMPTY_TOK  */
+#line 334 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_polygon_finalize(state, NULL, NULL); WKT_ERROR(); }
+#line 2365 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 60:
-#line 339 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_curvepolygon_finalize(NULL, (yyvsp[(2) - (3)].stringvalue)); WKT_ERROR(); ;}
+  case 55: /* polygon_untagged: LBRACKET_TOK ring_list RBRACKET_TOK  */
+#line 338 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = (yyvsp[-1].geometryvalue); }
+#line 2371 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 61:
-#line 341 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_curvepolygon_finalize(NULL, NULL); WKT_ERROR(); ;}
+  case 56: /* polygon_untagged: EMPTY_TOK  */
+#line 340 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_polygon_finalize(state, NULL, NULL); WKT_ERROR(); }
+#line 2377 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 62:
-#line 345 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_curvepolygon_add_ring((yyvsp[(1) - (3)].geometryvalue),(yyvsp[(3) - (3)].geometryvalue)); WKT_ERROR(); ;}
+  case 57: /* patch: LBRACKET_TOK patchring_list RBRACKET_TOK  */
+#line 343 "extension/geo/parser/lwin_wkt_parse.y"
+                                                 { (yyval.geometryvalue) = (yyvsp[-1].geometryvalue); }
+#line 2383 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 63:
+  case 58: /* curvepolygon: CURVEPOLYGON_TOK LBRACKET_TOK curvering_list RBRACKET_TOK  */
 #line 347 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_curvepolygon_new((yyvsp[(1) - (1)].geometryvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_curvepolygon_finalize(state, (yyvsp[-1].geometryvalue), NULL); WKT_ERROR(); }
+#line 2389 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 64:
-#line 350 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = (yyvsp[(1) - (1)].geometryvalue); ;}
+  case 59: /* curvepolygon: CURVEPOLYGON_TOK DIMENSIONALITY_TOK LBRACKET_TOK curvering_list RBRACKET_TOK  */
+#line 349 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_curvepolygon_finalize(state, (yyvsp[-1].geometryvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
+#line 2395 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 65:
+  case 60: /* curvepolygon: CURVEPOLYGON_TOK DIMENSIONALITY_TOK EMPTY_TOK  */
 #line 351 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = (yyvsp[(1) - (1)].geometryvalue); ;}
+                { (yyval.geometryvalue) = wkt_parser_curvepolygon_finalize(state, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
+#line 2401 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 66:
-#line 352 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = (yyvsp[(1) - (1)].geometryvalue); ;}
-    break;
-
-  case 67:
+  case 61: /* curvepolygon: CURVEPOLYGON_TOK EMPTY_TOK  */
 #line 353 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = (yyvsp[(1) - (1)].geometryvalue); ;}
+                { (yyval.geometryvalue) = wkt_parser_curvepolygon_finalize(state, NULL, NULL); WKT_ERROR(); }
+#line 2407 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 68:
+  case 62: /* curvering_list: curvering_list COMMA_TOK curvering  */
 #line 357 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_polygon_add_ring((yyvsp[(1) - (3)].geometryvalue),(yyvsp[(3) - (3)].ptarrayvalue),'Z'); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_curvepolygon_add_ring(state, (yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2413 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 69:
+  case 63: /* curvering_list: curvering  */
 #line 359 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_polygon_new((yyvsp[(1) - (1)].ptarrayvalue),'Z'); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_curvepolygon_new(state, (yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2419 "extension/geo/parser/lwin_wkt_parse.cpp"
+    break;
+
+  case 64: /* curvering: linestring_untagged  */
+#line 362 "extension/geo/parser/lwin_wkt_parse.y"
+                            { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
+#line 2425 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 70:
+  case 65: /* curvering: linestring  */
 #line 363 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_polygon_add_ring((yyvsp[(1) - (3)].geometryvalue),(yyvsp[(3) - (3)].ptarrayvalue),'2'); WKT_ERROR(); ;}
+                   { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
+#line 2431 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 71:
+  case 66: /* curvering: compoundcurve  */
+#line 364 "extension/geo/parser/lwin_wkt_parse.y"
+                      { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
+#line 2437 "extension/geo/parser/lwin_wkt_parse.cpp"
+    break;
+
+  case 67: /* curvering: circularstring  */
 #line 365 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_polygon_new((yyvsp[(1) - (1)].ptarrayvalue),'2'); WKT_ERROR(); ;}
+                       { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
+#line 2443 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 72:
-#line 368 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.ptarrayvalue) = (yyvsp[(2) - (3)].ptarrayvalue); ;}
+  case 68: /* patchring_list: patchring_list COMMA_TOK patchring  */
+#line 369 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_polygon_add_ring(state, (yyvsp[-2].geometryvalue),(yyvsp[0].ptarrayvalue),'Z'); WKT_ERROR(); }
+#line 2449 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 73:
+  case 69: /* patchring_list: patchring  */
 #line 371 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.ptarrayvalue) = (yyvsp[(2) - (3)].ptarrayvalue); ;}
+                { (yyval.geometryvalue) = wkt_parser_polygon_new(state, (yyvsp[0].ptarrayvalue),'Z'); WKT_ERROR(); }
+#line 2455 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 74:
+  case 70: /* ring_list: ring_list COMMA_TOK ring  */
 #line 375 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(COMPOUNDTYPE, (yyvsp[(3) - (4)].geometryvalue), NULL); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_polygon_add_ring(state, (yyvsp[-2].geometryvalue),(yyvsp[0].ptarrayvalue),'2'); WKT_ERROR(); }
+#line 2461 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 75:
+  case 71: /* ring_list: ring  */
 #line 377 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(COMPOUNDTYPE, (yyvsp[(4) - (5)].geometryvalue), (yyvsp[(2) - (5)].stringvalue)); WKT_ERROR(); ;}
-    break;
-
-  case 76:
-#line 379 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(COMPOUNDTYPE, NULL, (yyvsp[(2) - (3)].stringvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_polygon_new(state, (yyvsp[0].ptarrayvalue),'2'); WKT_ERROR(); }
+#line 2467 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 77:
-#line 381 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(COMPOUNDTYPE, NULL, NULL); WKT_ERROR(); ;}
+  case 72: /* patchring: LBRACKET_TOK ptarray RBRACKET_TOK  */
+#line 380 "extension/geo/parser/lwin_wkt_parse.y"
+                                          { (yyval.ptarrayvalue) = (yyvsp[-1].ptarrayvalue); }
+#line 2473 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 78:
-#line 385 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_compound_add_geom((yyvsp[(1) - (3)].geometryvalue),(yyvsp[(3) - (3)].geometryvalue)); WKT_ERROR(); ;}
+  case 73: /* ring: LBRACKET_TOK ptarray RBRACKET_TOK  */
+#line 383 "extension/geo/parser/lwin_wkt_parse.y"
+                                          { (yyval.ptarrayvalue) = (yyvsp[-1].ptarrayvalue); }
+#line 2479 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 79:
+  case 74: /* compoundcurve: COMPOUNDCURVE_TOK LBRACKET_TOK compound_list RBRACKET_TOK  */
 #line 387 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_compound_add_geom((yyvsp[(1) - (3)].geometryvalue),(yyvsp[(3) - (3)].geometryvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, COMPOUNDTYPE, (yyvsp[-1].geometryvalue), NULL); WKT_ERROR(); }
+#line 2485 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 80:
+  case 75: /* compoundcurve: COMPOUNDCURVE_TOK DIMENSIONALITY_TOK LBRACKET_TOK compound_list RBRACKET_TOK  */
 #line 389 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_compound_add_geom((yyvsp[(1) - (3)].geometryvalue),(yyvsp[(3) - (3)].geometryvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, COMPOUNDTYPE, (yyvsp[-1].geometryvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
+#line 2491 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 81:
+  case 76: /* compoundcurve: COMPOUNDCURVE_TOK DIMENSIONALITY_TOK EMPTY_TOK  */
 #line 391 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_compound_new((yyvsp[(1) - (1)].geometryvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, COMPOUNDTYPE, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
+#line 2497 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 82:
+  case 77: /* compoundcurve: COMPOUNDCURVE_TOK EMPTY_TOK  */
 #line 393 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_compound_new((yyvsp[(1) - (1)].geometryvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, COMPOUNDTYPE, NULL, NULL); WKT_ERROR(); }
+#line 2503 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 83:
-#line 395 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_compound_new((yyvsp[(1) - (1)].geometryvalue)); WKT_ERROR(); ;}
+  case 78: /* compound_list: compound_list COMMA_TOK circularstring  */
+#line 397 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_compound_add_geom(state, (yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2509 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 84:
+  case 79: /* compound_list: compound_list COMMA_TOK linestring  */
 #line 399 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTICURVETYPE, (yyvsp[(3) - (4)].geometryvalue), NULL); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_compound_add_geom(state, (yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2515 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 85:
+  case 80: /* compound_list: compound_list COMMA_TOK linestring_untagged  */
 #line 401 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTICURVETYPE, (yyvsp[(4) - (5)].geometryvalue), (yyvsp[(2) - (5)].stringvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_compound_add_geom(state, (yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2521 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 86:
+  case 81: /* compound_list: circularstring  */
 #line 403 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTICURVETYPE, NULL, (yyvsp[(2) - (3)].stringvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_compound_new(state, (yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2527 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 87:
+  case 82: /* compound_list: linestring  */
 #line 405 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTICURVETYPE, NULL, NULL); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_compound_new(state, (yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2533 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 88:
-#line 409 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[(1) - (3)].geometryvalue),(yyvsp[(3) - (3)].geometryvalue)); WKT_ERROR(); ;}
+  case 83: /* compound_list: linestring_untagged  */
+#line 407 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_compound_new(state, (yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2539 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 89:
+  case 84: /* multicurve: MCURVE_TOK LBRACKET_TOK curve_list RBRACKET_TOK  */
 #line 411 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[(1) - (3)].geometryvalue),(yyvsp[(3) - (3)].geometryvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, MULTICURVETYPE, (yyvsp[-1].geometryvalue), NULL); WKT_ERROR(); }
+#line 2545 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 90:
+  case 85: /* multicurve: MCURVE_TOK DIMENSIONALITY_TOK LBRACKET_TOK curve_list RBRACKET_TOK  */
 #line 413 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[(1) - (3)].geometryvalue),(yyvsp[(3) - (3)].geometryvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, MULTICURVETYPE, (yyvsp[-1].geometryvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
+#line 2551 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 91:
+  case 86: /* multicurve: MCURVE_TOK DIMENSIONALITY_TOK EMPTY_TOK  */
 #line 415 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[(1) - (3)].geometryvalue),(yyvsp[(3) - (3)].geometryvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, MULTICURVETYPE, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
+#line 2557 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 92:
+  case 87: /* multicurve: MCURVE_TOK EMPTY_TOK  */
 #line 417 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[(1) - (1)].geometryvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, MULTICURVETYPE, NULL, NULL); WKT_ERROR(); }
+#line 2563 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 93:
-#line 419 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[(1) - (1)].geometryvalue)); WKT_ERROR(); ;}
-    break;
-
-  case 94:
+  case 88: /* curve_list: curve_list COMMA_TOK circularstring  */
 #line 421 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[(1) - (1)].geometryvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_add_geom(state, (yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2569 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 95:
+  case 89: /* curve_list: curve_list COMMA_TOK compoundcurve  */
 #line 423 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[(1) - (1)].geometryvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_add_geom(state, (yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2575 "extension/geo/parser/lwin_wkt_parse.cpp"
+    break;
+
+  case 90: /* curve_list: curve_list COMMA_TOK linestring  */
+#line 425 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_collection_add_geom(state, (yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2581 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 96:
+  case 91: /* curve_list: curve_list COMMA_TOK linestring_untagged  */
 #line 427 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTILINETYPE, (yyvsp[(3) - (4)].geometryvalue), NULL); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_add_geom(state, (yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2587 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 97:
+  case 92: /* curve_list: circularstring  */
 #line 429 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTILINETYPE, (yyvsp[(4) - (5)].geometryvalue), (yyvsp[(2) - (5)].stringvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_new(state, (yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2593 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 98:
+  case 93: /* curve_list: compoundcurve  */
 #line 431 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTILINETYPE, NULL, (yyvsp[(2) - (3)].stringvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_new(state, (yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2599 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 99:
+  case 94: /* curve_list: linestring  */
 #line 433 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTILINETYPE, NULL, NULL); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_new(state, (yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2605 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 100:
-#line 437 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[(1) - (3)].geometryvalue),(yyvsp[(3) - (3)].geometryvalue)); WKT_ERROR(); ;}
+  case 95: /* curve_list: linestring_untagged  */
+#line 435 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_collection_new(state, (yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2611 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 101:
+  case 96: /* multilinestring: MLINESTRING_TOK LBRACKET_TOK linestring_list RBRACKET_TOK  */
 #line 439 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[(1) - (1)].geometryvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, MULTILINETYPE, (yyvsp[-1].geometryvalue), NULL); WKT_ERROR(); }
+#line 2617 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 102:
-#line 443 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_circularstring_new((yyvsp[(3) - (4)].ptarrayvalue), NULL); WKT_ERROR(); ;}
+  case 97: /* multilinestring: MLINESTRING_TOK DIMENSIONALITY_TOK LBRACKET_TOK linestring_list RBRACKET_TOK  */
+#line 441 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, MULTILINETYPE, (yyvsp[-1].geometryvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
+#line 2623 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 103:
-#line 445 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_circularstring_new((yyvsp[(4) - (5)].ptarrayvalue), (yyvsp[(2) - (5)].stringvalue)); WKT_ERROR(); ;}
+  case 98: /* multilinestring: MLINESTRING_TOK DIMENSIONALITY_TOK EMPTY_TOK  */
+#line 443 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, MULTILINETYPE, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
+#line 2629 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 104:
-#line 447 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_circularstring_new(NULL, (yyvsp[(2) - (3)].stringvalue)); WKT_ERROR(); ;}
+  case 99: /* multilinestring: MLINESTRING_TOK EMPTY_TOK  */
+#line 445 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, MULTILINETYPE, NULL, NULL); WKT_ERROR(); }
+#line 2635 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 105:
+  case 100: /* linestring_list: linestring_list COMMA_TOK linestring_untagged  */
 #line 449 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_circularstring_new(NULL, NULL); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_add_geom(state, (yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2641 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 106:
-#line 453 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_linestring_new((yyvsp[(3) - (4)].ptarrayvalue), NULL); WKT_ERROR(); ;}
+  case 101: /* linestring_list: linestring_untagged  */
+#line 451 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_collection_new(state, (yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2647 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 107:
+  case 102: /* circularstring: CIRCULARSTRING_TOK LBRACKET_TOK ptarray RBRACKET_TOK  */
 #line 455 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_linestring_new((yyvsp[(4) - (5)].ptarrayvalue), (yyvsp[(2) - (5)].stringvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_circularstring_new(state, (yyvsp[-1].ptarrayvalue), NULL); WKT_ERROR(); }
+#line 2653 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 108:
+  case 103: /* circularstring: CIRCULARSTRING_TOK DIMENSIONALITY_TOK LBRACKET_TOK ptarray RBRACKET_TOK  */
 #line 457 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_linestring_new(NULL, (yyvsp[(2) - (3)].stringvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_circularstring_new(state, (yyvsp[-1].ptarrayvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
+#line 2659 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 109:
+  case 104: /* circularstring: CIRCULARSTRING_TOK DIMENSIONALITY_TOK EMPTY_TOK  */
 #line 459 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_linestring_new(NULL, NULL); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_circularstring_new(state, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
+#line 2665 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 110:
-#line 463 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_linestring_new((yyvsp[(2) - (3)].ptarrayvalue), NULL); WKT_ERROR(); ;}
+  case 105: /* circularstring: CIRCULARSTRING_TOK EMPTY_TOK  */
+#line 461 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_circularstring_new(state, NULL, NULL); WKT_ERROR(); }
+#line 2671 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 111:
+  case 106: /* linestring: LINESTRING_TOK LBRACKET_TOK ptarray RBRACKET_TOK  */
 #line 465 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_linestring_new(NULL, NULL); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_linestring_new(state, (yyvsp[-1].ptarrayvalue), NULL); WKT_ERROR(); }
+#line 2677 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 112:
+  case 107: /* linestring: LINESTRING_TOK DIMENSIONALITY_TOK LBRACKET_TOK ptarray RBRACKET_TOK  */
+#line 467 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_linestring_new(state, (yyvsp[-1].ptarrayvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
+#line 2683 "extension/geo/parser/lwin_wkt_parse.cpp"
+    break;
+
+  case 108: /* linestring: LINESTRING_TOK DIMENSIONALITY_TOK EMPTY_TOK  */
 #line 469 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[(1) - (3)].geometryvalue),(yyvsp[(3) - (3)].geometryvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_linestring_new(state, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
+#line 2689 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 113:
+  case 109: /* linestring: LINESTRING_TOK EMPTY_TOK  */
 #line 471 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[(1) - (1)].geometryvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_linestring_new(state, NULL, NULL); WKT_ERROR(); }
+#line 2695 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 114:
+  case 110: /* linestring_untagged: LBRACKET_TOK ptarray RBRACKET_TOK  */
 #line 475 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_triangle_new((yyvsp[(4) - (6)].ptarrayvalue), NULL); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_linestring_new(state, (yyvsp[-1].ptarrayvalue), NULL); WKT_ERROR(); }
+#line 2701 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 115:
+  case 111: /* linestring_untagged: EMPTY_TOK  */
 #line 477 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_triangle_new((yyvsp[(5) - (7)].ptarrayvalue), (yyvsp[(2) - (7)].stringvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_linestring_new(state, NULL, NULL); WKT_ERROR(); }
+#line 2707 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 116:
-#line 479 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_triangle_new(NULL, (yyvsp[(2) - (3)].stringvalue)); WKT_ERROR(); ;}
+  case 112: /* triangle_list: triangle_list COMMA_TOK triangle_untagged  */
+#line 481 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_collection_add_geom(state, (yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2713 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 117:
-#line 481 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_triangle_new(NULL, NULL); WKT_ERROR(); ;}
+  case 113: /* triangle_list: triangle_untagged  */
+#line 483 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_collection_new(state, (yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2719 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 118:
-#line 485 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_triangle_new((yyvsp[(3) - (5)].ptarrayvalue), NULL); WKT_ERROR(); ;}
+  case 114: /* triangle: TRIANGLE_TOK LBRACKET_TOK LBRACKET_TOK ptarray RBRACKET_TOK RBRACKET_TOK  */
+#line 487 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_triangle_new(state, (yyvsp[-2].ptarrayvalue), NULL); WKT_ERROR(); }
+#line 2725 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 119:
+  case 115: /* triangle: TRIANGLE_TOK DIMENSIONALITY_TOK LBRACKET_TOK LBRACKET_TOK ptarray RBRACKET_TOK RBRACKET_TOK  */
 #line 489 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTIPOINTTYPE, (yyvsp[(3) - (4)].geometryvalue), NULL); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_triangle_new(state, (yyvsp[-2].ptarrayvalue), (yyvsp[-5].stringvalue)); WKT_ERROR(); }
+#line 2731 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 120:
+  case 116: /* triangle: TRIANGLE_TOK DIMENSIONALITY_TOK EMPTY_TOK  */
 #line 491 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTIPOINTTYPE, (yyvsp[(4) - (5)].geometryvalue), (yyvsp[(2) - (5)].stringvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_triangle_new(state, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
+#line 2737 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 121:
+  case 117: /* triangle: TRIANGLE_TOK EMPTY_TOK  */
 #line 493 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTIPOINTTYPE, NULL, (yyvsp[(2) - (3)].stringvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_triangle_new(state, NULL, NULL); WKT_ERROR(); }
+#line 2743 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 122:
-#line 495 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTIPOINTTYPE, NULL, NULL); WKT_ERROR(); ;}
+  case 118: /* triangle_untagged: LBRACKET_TOK LBRACKET_TOK ptarray RBRACKET_TOK RBRACKET_TOK  */
+#line 497 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_triangle_new(state, (yyvsp[-2].ptarrayvalue), NULL); WKT_ERROR(); }
+#line 2749 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 123:
-#line 499 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[(1) - (3)].geometryvalue),(yyvsp[(3) - (3)].geometryvalue)); WKT_ERROR(); ;}
+  case 119: /* multipoint: MPOINT_TOK LBRACKET_TOK point_list RBRACKET_TOK  */
+#line 501 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, MULTIPOINTTYPE, (yyvsp[-1].geometryvalue), NULL); WKT_ERROR(); }
+#line 2755 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 124:
-#line 501 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[(1) - (1)].geometryvalue)); WKT_ERROR(); ;}
+  case 120: /* multipoint: MPOINT_TOK DIMENSIONALITY_TOK LBRACKET_TOK point_list RBRACKET_TOK  */
+#line 503 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, MULTIPOINTTYPE, (yyvsp[-1].geometryvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
+#line 2761 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 125:
+  case 121: /* multipoint: MPOINT_TOK DIMENSIONALITY_TOK EMPTY_TOK  */
 #line 505 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_point_new(wkt_parser_ptarray_new((yyvsp[(1) - (1)].coordinatevalue)),NULL); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, MULTIPOINTTYPE, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
+#line 2767 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 126:
+  case 122: /* multipoint: MPOINT_TOK EMPTY_TOK  */
 #line 507 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_point_new(wkt_parser_ptarray_new((yyvsp[(2) - (3)].coordinatevalue)),NULL); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_finalize(state, MULTIPOINTTYPE, NULL, NULL); WKT_ERROR(); }
+#line 2773 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 127:
-#line 509 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_point_new(NULL, NULL); WKT_ERROR(); ;}
+  case 123: /* point_list: point_list COMMA_TOK point_untagged  */
+#line 511 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_collection_add_geom(state, (yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2779 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 128:
+  case 124: /* point_list: point_untagged  */
 #line 513 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_point_new((yyvsp[(3) - (4)].ptarrayvalue), NULL); WKT_ERROR(); ;}
-    break;
-
-  case 129:
-#line 515 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_point_new((yyvsp[(4) - (5)].ptarrayvalue), (yyvsp[(2) - (5)].stringvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_collection_new(state, (yyvsp[0].geometryvalue)); WKT_ERROR(); }
+#line 2785 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 130:
+  case 125: /* point_untagged: coordinate  */
 #line 517 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_point_new(NULL, (yyvsp[(2) - (3)].stringvalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_point_new(state, wkt_parser_ptarray_new(state, (yyvsp[0].coordinatevalue)),NULL); WKT_ERROR(); }
+#line 2791 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 131:
+  case 126: /* point_untagged: LBRACKET_TOK coordinate RBRACKET_TOK  */
 #line 519 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.geometryvalue) = wkt_parser_point_new(NULL,NULL); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_point_new(state, wkt_parser_ptarray_new(state, (yyvsp[-1].coordinatevalue)),NULL); WKT_ERROR(); }
+#line 2797 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 132:
-#line 523 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.ptarrayvalue) = wkt_parser_ptarray_add_coord((yyvsp[(1) - (3)].ptarrayvalue), (yyvsp[(3) - (3)].coordinatevalue)); WKT_ERROR(); ;}
+  case 127: /* point_untagged: EMPTY_TOK  */
+#line 521 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_point_new(state, NULL, NULL); WKT_ERROR(); }
+#line 2803 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 133:
+  case 128: /* point: POINT_TOK LBRACKET_TOK ptarray RBRACKET_TOK  */
 #line 525 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.ptarrayvalue) = wkt_parser_ptarray_new((yyvsp[(1) - (1)].coordinatevalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_point_new(state, (yyvsp[-1].ptarrayvalue), NULL); WKT_ERROR(); }
+#line 2809 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 134:
+  case 129: /* point: POINT_TOK DIMENSIONALITY_TOK LBRACKET_TOK ptarray RBRACKET_TOK  */
+#line 527 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.geometryvalue) = wkt_parser_point_new(state, (yyvsp[-1].ptarrayvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
+#line 2815 "extension/geo/parser/lwin_wkt_parse.cpp"
+    break;
+
+  case 130: /* point: POINT_TOK DIMENSIONALITY_TOK EMPTY_TOK  */
 #line 529 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.coordinatevalue) = wkt_parser_coord_2((yyvsp[(1) - (2)].doublevalue), (yyvsp[(2) - (2)].doublevalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_point_new(state, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
+#line 2821 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 135:
+  case 131: /* point: POINT_TOK EMPTY_TOK  */
 #line 531 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.coordinatevalue) = wkt_parser_coord_3((yyvsp[(1) - (3)].doublevalue), (yyvsp[(2) - (3)].doublevalue), (yyvsp[(3) - (3)].doublevalue)); WKT_ERROR(); ;}
+                { (yyval.geometryvalue) = wkt_parser_point_new(state, NULL,NULL); WKT_ERROR(); }
+#line 2827 "extension/geo/parser/lwin_wkt_parse.cpp"
+    break;
+
+  case 132: /* ptarray: ptarray COMMA_TOK coordinate  */
+#line 535 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.ptarrayvalue) = wkt_parser_ptarray_add_coord(state, (yyvsp[-2].ptarrayvalue), (yyvsp[0].coordinatevalue)); WKT_ERROR(); }
+#line 2833 "extension/geo/parser/lwin_wkt_parse.cpp"
+    break;
+
+  case 133: /* ptarray: coordinate  */
+#line 537 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.ptarrayvalue) = wkt_parser_ptarray_new(state, (yyvsp[0].coordinatevalue)); WKT_ERROR(); }
+#line 2839 "extension/geo/parser/lwin_wkt_parse.cpp"
+    break;
+
+  case 134: /* coordinate: DOUBLE_TOK DOUBLE_TOK  */
+#line 541 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.coordinatevalue) = wkt_parser_coord_2((yyvsp[-1].doublevalue), (yyvsp[0].doublevalue)); WKT_ERROR(); }
+#line 2845 "extension/geo/parser/lwin_wkt_parse.cpp"
+    break;
+
+  case 135: /* coordinate: DOUBLE_TOK DOUBLE_TOK DOUBLE_TOK  */
+#line 543 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.coordinatevalue) = wkt_parser_coord_3((yyvsp[-2].doublevalue), (yyvsp[-1].doublevalue), (yyvsp[0].doublevalue)); WKT_ERROR(); }
+#line 2851 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
-  case 136:
-#line 533 "extension/geo/parser/lwin_wkt_parse.y"
-    { (yyval.coordinatevalue) = wkt_parser_coord_4((yyvsp[(1) - (4)].doublevalue), (yyvsp[(2) - (4)].doublevalue), (yyvsp[(3) - (4)].doublevalue), (yyvsp[(4) - (4)].doublevalue)); WKT_ERROR(); ;}
+  case 136: /* coordinate: DOUBLE_TOK DOUBLE_TOK DOUBLE_TOK DOUBLE_TOK  */
+#line 545 "extension/geo/parser/lwin_wkt_parse.y"
+                { (yyval.coordinatevalue) = wkt_parser_coord_4((yyvsp[-3].doublevalue), (yyvsp[-2].doublevalue), (yyvsp[-1].doublevalue), (yyvsp[0].doublevalue)); WKT_ERROR(); }
+#line 2857 "extension/geo/parser/lwin_wkt_parse.cpp"
     break;
 
 
-/* Line 1267 of yacc.c.  */
-#line 2614 "extension/geo/parser/lwin_wkt_parse.cpp"
+#line 2861 "extension/geo/parser/lwin_wkt_parse.cpp"
+
       default: break;
     }
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
   *++yylsp = yyloc;
 
-  /* Now `shift' the result of the reduction.  Determine what state
+  /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
 
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
 yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == WKT_YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
       {
-	YYSIZE_T yysize = yysyntax_error (0, yystate, yychar);
-	if (yymsg_alloc < yysize && yymsg_alloc < YYSTACK_ALLOC_MAXIMUM)
-	  {
-	    YYSIZE_T yyalloc = 2 * yysize;
-	    if (! (yysize <= yyalloc && yyalloc <= YYSTACK_ALLOC_MAXIMUM))
-	      yyalloc = YYSTACK_ALLOC_MAXIMUM;
-	    if (yymsg != yymsgbuf)
-	      YYSTACK_FREE (yymsg);
-	    yymsg = (char *) YYSTACK_ALLOC (yyalloc);
-	    if (yymsg)
-	      yymsg_alloc = yyalloc;
-	    else
-	      {
-		yymsg = yymsgbuf;
-		yymsg_alloc = sizeof yymsgbuf;
-	      }
-	  }
-
-	if (0 < yysize && yysize <= yymsg_alloc)
-	  {
-	    (void) yysyntax_error (yymsg, yystate, yychar);
-	    yyerror (yymsg);
-	  }
-	else
-	  {
-	    yyerror (YY_("syntax error"));
-	    if (yysize != 0)
-	      goto yyexhaustedlab;
-	  }
+        yypcontext_t yyctx
+          = {yyssp, yytoken, &yylloc};
+        char const *yymsgp = YY_("syntax error");
+        int yysyntax_error_status;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+        if (yysyntax_error_status == 0)
+          yymsgp = yymsg;
+        else if (yysyntax_error_status == -1)
+          {
+            if (yymsg != yymsgbuf)
+              YYSTACK_FREE (yymsg);
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
+              {
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
+              }
+            else
+              {
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
+              }
+          }
+        yyerror (&yylloc, scanner, state, yymsgp);
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
       }
-#endif
     }
 
-  yyerror_range[0] = yylloc;
-
+  yyerror_range[1] = yylloc;
   if (yyerrstatus == 3)
     {
-      /* If just tried and failed to reuse look-ahead token after an
-	 error, discard it.  */
-
-      if (yychar <= YYEOF)
-	{
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
-	}
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= WKT_YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == WKT_YYEOF)
+            YYABORT;
+        }
       else
-	{
-	  yydestruct ("Error: discarding",
-		      yytoken, &yylval, &yylloc);
-	  yychar = YYEMPTY;
-	}
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, &yylloc, scanner, state);
+          yychar = WKT_YYEMPTY;
+        }
     }
 
-  /* Else will try to reuse look-ahead token after shifting the error
+  /* Else will try to reuse lookahead token after shifting the error
      token.  */
   goto yyerrlab1;
 
@@ -2712,15 +2967,13 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  yyerror_range[0] = yylsp[1-yylen];
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
   yylen = 0;
@@ -2733,47 +2986,45 @@ yyerrorlab:
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
 yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
-      if (yyn != YYPACT_NINF)
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
 
       /* Pop the current state because it cannot handle the error token.  */
       if (yyssp == yyss)
-	YYABORT;
+        YYABORT;
 
-      yyerror_range[0] = *yylsp;
+      yyerror_range[1] = *yylsp;
       yydestruct ("Error: popping",
-		  yystos[yystate], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp, scanner, state);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
     }
 
-  if (yyn == YYFINAL)
-    YYACCEPT;
-
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
-  yyerror_range[1] = yylloc;
-  /* Using YYLLOC is tempting, but would change the location of
-     the look-ahead.  YYLOC is available though.  */
-  YYLLOC_DEFAULT (yyloc, (yyerror_range - 1), 2);
-  *++yylsp = yyloc;
+  yyerror_range[2] = yylloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2784,55 +3035,57 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#ifndef yyoverflow
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (&yylloc, scanner, state, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
-yyreturn:
-  if (yychar != YYEOF && yychar != YYEMPTY)
-     yydestruct ("Cleanup: discarding lookahead",
-		 yytoken, &yylval, &yylloc);
-  /* Do not reclaim the symbols of the rule which action triggered
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != WKT_YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, &yylloc, scanner, state);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
   YYPOPSTACK (yylen);
   YY_STACK_PRINT (yyss, yyssp);
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp, scanner, state);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
   if (yymsg != yymsgbuf)
     YYSTACK_FREE (yymsg);
-#endif
-  /* Make sure YYID is used.  */
-  return YYID (yyresult);
+  return yyresult;
 }
 
-
-#line 535 "extension/geo/parser/lwin_wkt_parse.y"
-
-
-
+#line 547 "extension/geo/parser/lwin_wkt_parse.y"
 
 } // namespace duckdb
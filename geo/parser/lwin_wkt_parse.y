@@ -9,17 +9,16 @@
 
 /*namespace duckdb {*/
 
-/* Prototypes to quiet the compiler */
-int wkt_yyparse(void);
-void wkt_yyerror(const char *str);
-int wkt_yylex(void);
+/* Turn on/off verbose parsing (turn off for production) */
+int wkt_yydebug = 0;
 
+%}
 
-/* Declare the global parser variable */
-LWGEOM_PARSER_RESULT global_parser_result;
+%code {
 
-/* Turn on/off verbose parsing (turn off for production) */
-int wkt_yydebug = 0;
+/* Prototypes to quiet the compiler */
+int wkt_yylex(WKT_YYSTYPE *lvalp, WKT_YYLTYPE *llocp, void *scanner);
+void wkt_yyerror(WKT_YYLTYPE *llocp, void *scanner, WKT_PARSER_STATE *state, const char *str);
 
 /*
 * Error handler called by the bison parser. Mostly we will be
@@ -27,80 +26,93 @@ int wkt_yydebug = 0;
 * from WKT_ERROR in the grammar, but we keep this one
 * around just in case.
 */
-void wkt_yyerror(__attribute__((__unused__)) const char *str)
+void wkt_yyerror(WKT_YYLTYPE *llocp, __attribute__((__unused__)) void *scanner, WKT_PARSER_STATE *state,
+                 __attribute__((__unused__)) const char *str)
 {
 	/* If we haven't already set a message and location, let's set one now. */
-	if ( ! global_parser_result.message )
+	if ( ! state->result->message )
 	{
-		global_parser_result.message = parser_error_messages[PARSER_ERROR_OTHER];
-		global_parser_result.errcode = PARSER_ERROR_OTHER;
-		global_parser_result.errlocation = wkt_yylloc.last_column;
+		state->result->message = parser_error_messages[PARSER_ERROR_OTHER];
+		state->result->errcode = PARSER_ERROR_OTHER;
+		state->result->errlocation = llocp->last_column;
 	}
 }
 
+/*
+* Owns the scanner for one parse. lwerror throws, so the scanner is
+* released on the way out even when the parse does not return.
+*/
+struct WKTLexerGuard
+{
+	void *scanner;
+	WKTLexerGuard(WKT_PARSER_STATE *state, char *src) : scanner(wkt_lexer_init(state, src)) {}
+	~WKTLexerGuard() { wkt_lexer_close(scanner); }
+};
+
 /**
-* Parse a WKT geometry string into an LWGEOM structure. Note that this
-* process uses globals and is not re-entrant, so don't call it within itself
-* (eg, from within other functions in lwin_wkt.c) or from a threaded program.
+* Parse a WKT geometry string into an LWGEOM structure. All of the parse
+* state lives in a WKT_PARSER_STATE on this stack frame and in a scanner
+* owned by this call, so the parser is re-entrant and may be called from
+* several threads at once.
 * Note that parser_result.wkinput picks up a reference to wktstr.
 */
 int lwgeom_parse_wkt(LWGEOM_PARSER_RESULT *parser_result, char *wktstr, int parser_check_flags)
 {
 	int parse_rv = 0;
+	WKT_PARSER_STATE state;
 
-	/* Clean up our global parser result. */
-	lwgeom_parser_result_init(&global_parser_result);
-	/* Work-around possible bug in GNU Bison 3.0.2 resulting in wkt_yylloc
-	 * members not being initialized on yyparse() as documented here:
-	 * https://www.gnu.org/software/bison/manual/html_node/Location-Type.html
-	 * See discussion here:
-	 * http://lists.osgeo.org/pipermail/postgis-devel/2014-September/024506.html
-	 */
-	wkt_yylloc.last_column = wkt_yylloc.last_line = \
-		wkt_yylloc.first_column = wkt_yylloc.first_line = 1;
+	/* Clean up the parser result, the builders write straight into it. */
+	lwgeom_parser_result_init(parser_result);
 
 	/* Set the input text string, and parse checks. */
-	global_parser_result.wkinput = wktstr;
-	global_parser_result.parser_check_flags = parser_check_flags;
+	parser_result->wkinput = wktstr;
+	parser_result->parser_check_flags = parser_check_flags;
+	state.result = parser_result;
+	state.last_column = 1;
 
-	wkt_lexer_init(wktstr); /* Lexer ready */
-	parse_rv = wkt_yyparse(); /* Run the parse */
-	wkt_lexer_close(); /* Clean up lexer */
+	{
+		WKTLexerGuard lexer(&state, wktstr); /* Lexer ready, closed when the block exits */
+		parse_rv = wkt_yyparse(lexer.scanner, &state); /* Run the parse */
+	}
 
 	/* A non-zero parser return is an error. */
-	if ( parse_rv || global_parser_result.errcode )
+	if ( parse_rv || parser_result->errcode )
 	{
-		if( ! global_parser_result.errcode )
+		if( ! parser_result->errcode )
 		{
-			global_parser_result.errcode = PARSER_ERROR_OTHER;
-			global_parser_result.message = parser_error_messages[PARSER_ERROR_OTHER];
-			global_parser_result.errlocation = wkt_yylloc.last_column;
+			parser_result->errcode = PARSER_ERROR_OTHER;
+			parser_result->message = parser_error_messages[PARSER_ERROR_OTHER];
+			parser_result->errlocation = state.last_column;
 		}
-		else if (global_parser_result.geom)
+		else if (parser_result->geom)
 		{
-			lwgeom_free(global_parser_result.geom);
-			global_parser_result.geom = NULL;
+			lwgeom_free(parser_result->geom);
+			parser_result->geom = NULL;
 		}
 
-		/* Copy the global values into the return pointer */
-		*parser_result = global_parser_result;
-		wkt_yylex_destroy();
 		return LW_FAILURE;
 	}
 
-	/* Copy the global value into the return pointer */
-	*parser_result = global_parser_result;
-	wkt_yylex_destroy();
 	return LW_SUCCESS;
 }
 
-#define WKT_ERROR() { if ( global_parser_result.errcode != 0 ) { YYERROR; } }
-
+#define WKT_ERROR() { if ( state->result->errcode != 0 ) { YYERROR; } }
 
-%}
+}
 
+%define api.pure full
+%define api.prefix {wkt_yy}
+%define api.header.include {"parser/lwin_wkt_parse.hpp"}
+%define parse.error verbose
 %locations
-%error-verbose
+%lex-param {void *scanner}
+%parse-param {void *scanner} {WKT_PARSER_STATE *state}
+
+/* Error locations are one-based columns into the WKT input, as they were with the global scanner. */
+%initial-action
+{
+	@$.first_column = @$.last_column = 1;
+};
 
 %union {
 	int integervalue;
@@ -208,9 +220,9 @@ int lwgeom_parse_wkt(LWGEOM_PARSER_RESULT *parser_result, char *wktstr, int pars
 
 geometry:
 	geometry_no_srid
-		{ wkt_parser_geometry_new($1, SRID_UNKNOWN); WKT_ERROR(); } |
+		{ wkt_parser_geometry_new(state, $1, SRID_UNKNOWN); WKT_ERROR(); } |
 	SRID_TOK SEMICOLON_TOK geometry_no_srid
-		{ wkt_parser_geometry_new($3, $1); WKT_ERROR(); } ;
+		{ wkt_parser_geometry_new(state, $3, $1); WKT_ERROR(); } ;
 
 geometry_no_srid :
 	point { $$ = $1; } |
@@ -231,120 +243,120 @@ geometry_no_srid :
 
 geometrycollection :
 	COLLECTION_TOK LBRACKET_TOK geometry_list RBRACKET_TOK
-		{ $$ = wkt_parser_collection_finalize(COLLECTIONTYPE, $3, NULL); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, COLLECTIONTYPE, $3, NULL); WKT_ERROR(); } |
 	COLLECTION_TOK DIMENSIONALITY_TOK LBRACKET_TOK geometry_list RBRACKET_TOK
-		{ $$ = wkt_parser_collection_finalize(COLLECTIONTYPE, $4, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, COLLECTIONTYPE, $4, $2); WKT_ERROR(); } |
 	COLLECTION_TOK DIMENSIONALITY_TOK EMPTY_TOK
-		{ $$ = wkt_parser_collection_finalize(COLLECTIONTYPE, NULL, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, COLLECTIONTYPE, NULL, $2); WKT_ERROR(); } |
 	COLLECTION_TOK EMPTY_TOK
-		{ $$ = wkt_parser_collection_finalize(COLLECTIONTYPE, NULL, NULL); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_collection_finalize(state, COLLECTIONTYPE, NULL, NULL); WKT_ERROR(); } ;
 
 geometry_list :
 	geometry_list COMMA_TOK geometry_no_srid
-		{ $$ = wkt_parser_collection_add_geom($1,$3); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_add_geom(state, $1,$3); WKT_ERROR(); } |
 	geometry_no_srid
-		{ $$ = wkt_parser_collection_new($1); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_collection_new(state, $1); WKT_ERROR(); } ;
 
 multisurface :
 	MSURFACE_TOK LBRACKET_TOK surface_list RBRACKET_TOK
-		{ $$ = wkt_parser_collection_finalize(MULTISURFACETYPE, $3, NULL); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, MULTISURFACETYPE, $3, NULL); WKT_ERROR(); } |
 	MSURFACE_TOK DIMENSIONALITY_TOK LBRACKET_TOK surface_list RBRACKET_TOK
-		{ $$ = wkt_parser_collection_finalize(MULTISURFACETYPE, $4, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, MULTISURFACETYPE, $4, $2); WKT_ERROR(); } |
 	MSURFACE_TOK DIMENSIONALITY_TOK EMPTY_TOK
-		{ $$ = wkt_parser_collection_finalize(MULTISURFACETYPE, NULL, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, MULTISURFACETYPE, NULL, $2); WKT_ERROR(); } |
 	MSURFACE_TOK EMPTY_TOK
-		{ $$ = wkt_parser_collection_finalize(MULTISURFACETYPE, NULL, NULL); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_collection_finalize(state, MULTISURFACETYPE, NULL, NULL); WKT_ERROR(); } ;
 
 surface_list :
 	surface_list COMMA_TOK polygon
-		{ $$ = wkt_parser_collection_add_geom($1,$3); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_add_geom(state, $1,$3); WKT_ERROR(); } |
 	surface_list COMMA_TOK curvepolygon
-		{ $$ = wkt_parser_collection_add_geom($1,$3); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_add_geom(state, $1,$3); WKT_ERROR(); } |
 	surface_list COMMA_TOK polygon_untagged
-		{ $$ = wkt_parser_collection_add_geom($1,$3); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_add_geom(state, $1,$3); WKT_ERROR(); } |
 	polygon
-		{ $$ = wkt_parser_collection_new($1); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_new(state, $1); WKT_ERROR(); } |
 	curvepolygon
-		{ $$ = wkt_parser_collection_new($1); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_new(state, $1); WKT_ERROR(); } |
 	polygon_untagged
-		{ $$ = wkt_parser_collection_new($1); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_collection_new(state, $1); WKT_ERROR(); } ;
 
 tin :
 	TIN_TOK LBRACKET_TOK triangle_list RBRACKET_TOK
-		{ $$ = wkt_parser_collection_finalize(TINTYPE, $3, NULL); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, TINTYPE, $3, NULL); WKT_ERROR(); } |
 	TIN_TOK DIMENSIONALITY_TOK LBRACKET_TOK triangle_list RBRACKET_TOK
-		{ $$ = wkt_parser_collection_finalize(TINTYPE, $4, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, TINTYPE, $4, $2); WKT_ERROR(); } |
 	TIN_TOK DIMENSIONALITY_TOK EMPTY_TOK
-		{ $$ = wkt_parser_collection_finalize(TINTYPE, NULL, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, TINTYPE, NULL, $2); WKT_ERROR(); } |
 	TIN_TOK EMPTY_TOK
-		{ $$ = wkt_parser_collection_finalize(TINTYPE, NULL, NULL); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_collection_finalize(state, TINTYPE, NULL, NULL); WKT_ERROR(); } ;
 
 polyhedralsurface :
 	POLYHEDRALSURFACE_TOK LBRACKET_TOK patch_list RBRACKET_TOK
-		{ $$ = wkt_parser_collection_finalize(POLYHEDRALSURFACETYPE, $3, NULL); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, POLYHEDRALSURFACETYPE, $3, NULL); WKT_ERROR(); } |
 	POLYHEDRALSURFACE_TOK DIMENSIONALITY_TOK LBRACKET_TOK patch_list RBRACKET_TOK
-		{ $$ = wkt_parser_collection_finalize(POLYHEDRALSURFACETYPE, $4, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, POLYHEDRALSURFACETYPE, $4, $2); WKT_ERROR(); } |
 	POLYHEDRALSURFACE_TOK DIMENSIONALITY_TOK EMPTY_TOK
-		{ $$ = wkt_parser_collection_finalize(POLYHEDRALSURFACETYPE, NULL, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, POLYHEDRALSURFACETYPE, NULL, $2); WKT_ERROR(); } |
 	POLYHEDRALSURFACE_TOK EMPTY_TOK
-		{ $$ = wkt_parser_collection_finalize(POLYHEDRALSURFACETYPE, NULL, NULL); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_collection_finalize(state, POLYHEDRALSURFACETYPE, NULL, NULL); WKT_ERROR(); } ;
 
 multipolygon :
 	MPOLYGON_TOK LBRACKET_TOK polygon_list RBRACKET_TOK
-		{ $$ = wkt_parser_collection_finalize(MULTIPOLYGONTYPE, $3, NULL); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, MULTIPOLYGONTYPE, $3, NULL); WKT_ERROR(); } |
 	MPOLYGON_TOK DIMENSIONALITY_TOK LBRACKET_TOK polygon_list RBRACKET_TOK
-		{ $$ = wkt_parser_collection_finalize(MULTIPOLYGONTYPE, $4, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, MULTIPOLYGONTYPE, $4, $2); WKT_ERROR(); } |
 	MPOLYGON_TOK DIMENSIONALITY_TOK EMPTY_TOK
-		{ $$ = wkt_parser_collection_finalize(MULTIPOLYGONTYPE, NULL, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, MULTIPOLYGONTYPE, NULL, $2); WKT_ERROR(); } |
 	MPOLYGON_TOK EMPTY_TOK
-		{ $$ = wkt_parser_collection_finalize(MULTIPOLYGONTYPE, NULL, NULL); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_collection_finalize(state, MULTIPOLYGONTYPE, NULL, NULL); WKT_ERROR(); } ;
 
 polygon_list :
 	polygon_list COMMA_TOK polygon_untagged
-		{ $$ = wkt_parser_collection_add_geom($1,$3); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_add_geom(state, $1,$3); WKT_ERROR(); } |
 	polygon_untagged
-		{ $$ = wkt_parser_collection_new($1); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_collection_new(state, $1); WKT_ERROR(); } ;
 
 patch_list :
 	patch_list COMMA_TOK patch
-		{ $$ = wkt_parser_collection_add_geom($1,$3); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_add_geom(state, $1,$3); WKT_ERROR(); } |
 	patch
-		{ $$ = wkt_parser_collection_new($1); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_collection_new(state, $1); WKT_ERROR(); } ;
 
 polygon :
 	POLYGON_TOK LBRACKET_TOK ring_list RBRACKET_TOK
-		{ $$ = wkt_parser_polygon_finalize($3, NULL); WKT_ERROR(); } |
+		{ $$ = wkt_parser_polygon_finalize(state, $3, NULL); WKT_ERROR(); } |
 	POLYGON_TOK DIMENSIONALITY_TOK LBRACKET_TOK ring_list RBRACKET_TOK
-		{ $$ = wkt_parser_polygon_finalize($4, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_polygon_finalize(state, $4, $2); WKT_ERROR(); } |
 	POLYGON_TOK DIMENSIONALITY_TOK EMPTY_TOK
-		{ $$ = wkt_parser_polygon_finalize(NULL, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_polygon_finalize(state, NULL, $2); WKT_ERROR(); } |
 	POLYGON_TOK EMPTY_TOK
-		{ $$ = wkt_parser_polygon_finalize(NULL, NULL); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_polygon_finalize(state, NULL, NULL); WKT_ERROR(); } ;
 
 polygon_untagged :
 	LBRACKET_TOK ring_list RBRACKET_TOK
 		{ $$ = $2; } |
 	EMPTY_TOK
-		{ $$ = wkt_parser_polygon_finalize(NULL, NULL); WKT_ERROR(); };
+		{ $$ = wkt_parser_polygon_finalize(state, NULL, NULL); WKT_ERROR(); };
 
 patch :
 	LBRACKET_TOK patchring_list RBRACKET_TOK { $$ = $2; } ;
 
 curvepolygon :
 	CURVEPOLYGON_TOK LBRACKET_TOK curvering_list RBRACKET_TOK
-		{ $$ = wkt_parser_curvepolygon_finalize($3, NULL); WKT_ERROR(); } |
+		{ $$ = wkt_parser_curvepolygon_finalize(state, $3, NULL); WKT_ERROR(); } |
 	CURVEPOLYGON_TOK DIMENSIONALITY_TOK LBRACKET_TOK curvering_list RBRACKET_TOK
-		{ $$ = wkt_parser_curvepolygon_finalize($4, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_curvepolygon_finalize(state, $4, $2); WKT_ERROR(); } |
 	CURVEPOLYGON_TOK DIMENSIONALITY_TOK EMPTY_TOK
-		{ $$ = wkt_parser_curvepolygon_finalize(NULL, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_curvepolygon_finalize(state, NULL, $2); WKT_ERROR(); } |
 	CURVEPOLYGON_TOK EMPTY_TOK
-		{ $$ = wkt_parser_curvepolygon_finalize(NULL, NULL); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_curvepolygon_finalize(state, NULL, NULL); WKT_ERROR(); } ;
 
 curvering_list :
 	curvering_list COMMA_TOK curvering
-		{ $$ = wkt_parser_curvepolygon_add_ring($1,$3); WKT_ERROR(); } |
+		{ $$ = wkt_parser_curvepolygon_add_ring(state, $1,$3); WKT_ERROR(); } |
 	curvering
-		{ $$ = wkt_parser_curvepolygon_new($1); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_curvepolygon_new(state, $1); WKT_ERROR(); } ;
 
 curvering :
 	linestring_untagged { $$ = $1; } |
@@ -354,15 +366,15 @@ curvering :
 
 patchring_list :
 	patchring_list COMMA_TOK patchring
-		{ $$ = wkt_parser_polygon_add_ring($1,$3,'Z'); WKT_ERROR(); } |
+		{ $$ = wkt_parser_polygon_add_ring(state, $1,$3,'Z'); WKT_ERROR(); } |
 	patchring
-		{ $$ = wkt_parser_polygon_new($1,'Z'); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_polygon_new(state, $1,'Z'); WKT_ERROR(); } ;
 
 ring_list :
 	ring_list COMMA_TOK ring
-		{ $$ = wkt_parser_polygon_add_ring($1,$3,'2'); WKT_ERROR(); } |
+		{ $$ = wkt_parser_polygon_add_ring(state, $1,$3,'2'); WKT_ERROR(); } |
 	ring
-		{ $$ = wkt_parser_polygon_new($1,'2'); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_polygon_new(state, $1,'2'); WKT_ERROR(); } ;
 
 patchring :
 	LBRACKET_TOK ptarray RBRACKET_TOK { $$ = $2; } ;
@@ -372,157 +384,157 @@ ring :
 
 compoundcurve :
 	COMPOUNDCURVE_TOK LBRACKET_TOK compound_list RBRACKET_TOK
-		{ $$ = wkt_parser_collection_finalize(COMPOUNDTYPE, $3, NULL); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, COMPOUNDTYPE, $3, NULL); WKT_ERROR(); } |
 	COMPOUNDCURVE_TOK DIMENSIONALITY_TOK LBRACKET_TOK compound_list RBRACKET_TOK
-		{ $$ = wkt_parser_collection_finalize(COMPOUNDTYPE, $4, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, COMPOUNDTYPE, $4, $2); WKT_ERROR(); } |
 	COMPOUNDCURVE_TOK DIMENSIONALITY_TOK EMPTY_TOK
-		{ $$ = wkt_parser_collection_finalize(COMPOUNDTYPE, NULL, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, COMPOUNDTYPE, NULL, $2); WKT_ERROR(); } |
 	COMPOUNDCURVE_TOK EMPTY_TOK
-		{ $$ = wkt_parser_collection_finalize(COMPOUNDTYPE, NULL, NULL); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_collection_finalize(state, COMPOUNDTYPE, NULL, NULL); WKT_ERROR(); } ;
 
 compound_list :
 	compound_list COMMA_TOK circularstring
-		{ $$ = wkt_parser_compound_add_geom($1,$3); WKT_ERROR(); } |
+		{ $$ = wkt_parser_compound_add_geom(state, $1,$3); WKT_ERROR(); } |
 	compound_list COMMA_TOK linestring
-		{ $$ = wkt_parser_compound_add_geom($1,$3); WKT_ERROR(); } |
+		{ $$ = wkt_parser_compound_add_geom(state, $1,$3); WKT_ERROR(); } |
 	compound_list COMMA_TOK linestring_untagged
-		{ $$ = wkt_parser_compound_add_geom($1,$3); WKT_ERROR(); } |
+		{ $$ = wkt_parser_compound_add_geom(state, $1,$3); WKT_ERROR(); } |
 	circularstring
-		{ $$ = wkt_parser_compound_new($1); WKT_ERROR(); } |
+		{ $$ = wkt_parser_compound_new(state, $1); WKT_ERROR(); } |
 	linestring
-		{ $$ = wkt_parser_compound_new($1); WKT_ERROR(); } |
+		{ $$ = wkt_parser_compound_new(state, $1); WKT_ERROR(); } |
 	linestring_untagged
-		{ $$ = wkt_parser_compound_new($1); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_compound_new(state, $1); WKT_ERROR(); } ;
 
 multicurve :
 	MCURVE_TOK LBRACKET_TOK curve_list RBRACKET_TOK
-		{ $$ = wkt_parser_collection_finalize(MULTICURVETYPE, $3, NULL); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, MULTICURVETYPE, $3, NULL); WKT_ERROR(); } |
 	MCURVE_TOK DIMENSIONALITY_TOK LBRACKET_TOK curve_list RBRACKET_TOK
-		{ $$ = wkt_parser_collection_finalize(MULTICURVETYPE, $4, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, MULTICURVETYPE, $4, $2); WKT_ERROR(); } |
 	MCURVE_TOK DIMENSIONALITY_TOK EMPTY_TOK
-		{ $$ = wkt_parser_collection_finalize(MULTICURVETYPE, NULL, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, MULTICURVETYPE, NULL, $2); WKT_ERROR(); } |
 	MCURVE_TOK EMPTY_TOK
-		{ $$ = wkt_parser_collection_finalize(MULTICURVETYPE, NULL, NULL); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_collection_finalize(state, MULTICURVETYPE, NULL, NULL); WKT_ERROR(); } ;
 
 curve_list :
 	curve_list COMMA_TOK circularstring
-		{ $$ = wkt_parser_collection_add_geom($1,$3); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_add_geom(state, $1,$3); WKT_ERROR(); } |
 	curve_list COMMA_TOK compoundcurve
-		{ $$ = wkt_parser_collection_add_geom($1,$3); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_add_geom(state, $1,$3); WKT_ERROR(); } |
 	curve_list COMMA_TOK linestring
-		{ $$ = wkt_parser_collection_add_geom($1,$3); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_add_geom(state, $1,$3); WKT_ERROR(); } |
 	curve_list COMMA_TOK linestring_untagged
-		{ $$ = wkt_parser_collection_add_geom($1,$3); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_add_geom(state, $1,$3); WKT_ERROR(); } |
 	circularstring
-		{ $$ = wkt_parser_collection_new($1); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_new(state, $1); WKT_ERROR(); } |
 	compoundcurve
-		{ $$ = wkt_parser_collection_new($1); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_new(state, $1); WKT_ERROR(); } |
 	linestring
-		{ $$ = wkt_parser_collection_new($1); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_new(state, $1); WKT_ERROR(); } |
 	linestring_untagged
-		{ $$ = wkt_parser_collection_new($1); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_collection_new(state, $1); WKT_ERROR(); } ;
 
 multilinestring :
 	MLINESTRING_TOK LBRACKET_TOK linestring_list RBRACKET_TOK
-		{ $$ = wkt_parser_collection_finalize(MULTILINETYPE, $3, NULL); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, MULTILINETYPE, $3, NULL); WKT_ERROR(); } |
 	MLINESTRING_TOK DIMENSIONALITY_TOK LBRACKET_TOK linestring_list RBRACKET_TOK
-		{ $$ = wkt_parser_collection_finalize(MULTILINETYPE, $4, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, MULTILINETYPE, $4, $2); WKT_ERROR(); } |
 	MLINESTRING_TOK DIMENSIONALITY_TOK EMPTY_TOK
-		{ $$ = wkt_parser_collection_finalize(MULTILINETYPE, NULL, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, MULTILINETYPE, NULL, $2); WKT_ERROR(); } |
 	MLINESTRING_TOK EMPTY_TOK
-		{ $$ = wkt_parser_collection_finalize(MULTILINETYPE, NULL, NULL); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_collection_finalize(state, MULTILINETYPE, NULL, NULL); WKT_ERROR(); } ;
 
 linestring_list :
 	linestring_list COMMA_TOK linestring_untagged
-		{ $$ = wkt_parser_collection_add_geom($1,$3); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_add_geom(state, $1,$3); WKT_ERROR(); } |
 	linestring_untagged
-		{ $$ = wkt_parser_collection_new($1); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_collection_new(state, $1); WKT_ERROR(); } ;
 
 circularstring :
 	CIRCULARSTRING_TOK LBRACKET_TOK ptarray RBRACKET_TOK
-		{ $$ = wkt_parser_circularstring_new($3, NULL); WKT_ERROR(); } |
+		{ $$ = wkt_parser_circularstring_new(state, $3, NULL); WKT_ERROR(); } |
 	CIRCULARSTRING_TOK DIMENSIONALITY_TOK LBRACKET_TOK ptarray RBRACKET_TOK
-		{ $$ = wkt_parser_circularstring_new($4, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_circularstring_new(state, $4, $2); WKT_ERROR(); } |
 	CIRCULARSTRING_TOK DIMENSIONALITY_TOK EMPTY_TOK
-		{ $$ = wkt_parser_circularstring_new(NULL, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_circularstring_new(state, NULL, $2); WKT_ERROR(); } |
 	CIRCULARSTRING_TOK EMPTY_TOK
-		{ $$ = wkt_parser_circularstring_new(NULL, NULL); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_circularstring_new(state, NULL, NULL); WKT_ERROR(); } ;
 
 linestring :
 	LINESTRING_TOK LBRACKET_TOK ptarray RBRACKET_TOK
-		{ $$ = wkt_parser_linestring_new($3, NULL); WKT_ERROR(); } |
+		{ $$ = wkt_parser_linestring_new(state, $3, NULL); WKT_ERROR(); } |
 	LINESTRING_TOK DIMENSIONALITY_TOK LBRACKET_TOK ptarray RBRACKET_TOK
-		{ $$ = wkt_parser_linestring_new($4, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_linestring_new(state, $4, $2); WKT_ERROR(); } |
 	LINESTRING_TOK DIMENSIONALITY_TOK EMPTY_TOK
-		{ $$ = wkt_parser_linestring_new(NULL, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_linestring_new(state, NULL, $2); WKT_ERROR(); } |
 	LINESTRING_TOK EMPTY_TOK
-		{ $$ = wkt_parser_linestring_new(NULL, NULL); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_linestring_new(state, NULL, NULL); WKT_ERROR(); } ;
 
 linestring_untagged :
 	LBRACKET_TOK ptarray RBRACKET_TOK
-		{ $$ = wkt_parser_linestring_new($2, NULL); WKT_ERROR(); } |
+		{ $$ = wkt_parser_linestring_new(state, $2, NULL); WKT_ERROR(); } |
 	EMPTY_TOK
-		{ $$ = wkt_parser_linestring_new(NULL, NULL); WKT_ERROR(); };
+		{ $$ = wkt_parser_linestring_new(state, NULL, NULL); WKT_ERROR(); };
 
 triangle_list :
 	triangle_list COMMA_TOK triangle_untagged
-		{ $$ = wkt_parser_collection_add_geom($1,$3); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_add_geom(state, $1,$3); WKT_ERROR(); } |
 	triangle_untagged
-		{ $$ = wkt_parser_collection_new($1); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_collection_new(state, $1); WKT_ERROR(); } ;
 
 triangle :
 	TRIANGLE_TOK LBRACKET_TOK LBRACKET_TOK ptarray RBRACKET_TOK RBRACKET_TOK
-		{ $$ = wkt_parser_triangle_new($4, NULL); WKT_ERROR(); } |
+		{ $$ = wkt_parser_triangle_new(state, $4, NULL); WKT_ERROR(); } |
 	TRIANGLE_TOK DIMENSIONALITY_TOK LBRACKET_TOK LBRACKET_TOK ptarray RBRACKET_TOK RBRACKET_TOK
-		{ $$ = wkt_parser_triangle_new($5, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_triangle_new(state, $5, $2); WKT_ERROR(); } |
 	TRIANGLE_TOK DIMENSIONALITY_TOK EMPTY_TOK
-		{ $$ = wkt_parser_triangle_new(NULL, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_triangle_new(state, NULL, $2); WKT_ERROR(); } |
 	TRIANGLE_TOK EMPTY_TOK
-		{ $$ = wkt_parser_triangle_new(NULL, NULL); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_triangle_new(state, NULL, NULL); WKT_ERROR(); } ;
 
 triangle_untagged :
 	LBRACKET_TOK LBRACKET_TOK ptarray RBRACKET_TOK RBRACKET_TOK
-		{ $$ = wkt_parser_triangle_new($3, NULL); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_triangle_new(state, $3, NULL); WKT_ERROR(); } ;
 
 multipoint :
 	MPOINT_TOK LBRACKET_TOK point_list RBRACKET_TOK
-		{ $$ = wkt_parser_collection_finalize(MULTIPOINTTYPE, $3, NULL); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, MULTIPOINTTYPE, $3, NULL); WKT_ERROR(); } |
 	MPOINT_TOK DIMENSIONALITY_TOK LBRACKET_TOK point_list RBRACKET_TOK
-		{ $$ = wkt_parser_collection_finalize(MULTIPOINTTYPE, $4, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, MULTIPOINTTYPE, $4, $2); WKT_ERROR(); } |
 	MPOINT_TOK DIMENSIONALITY_TOK EMPTY_TOK
-		{ $$ = wkt_parser_collection_finalize(MULTIPOINTTYPE, NULL, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_finalize(state, MULTIPOINTTYPE, NULL, $2); WKT_ERROR(); } |
 	MPOINT_TOK EMPTY_TOK
-		{ $$ = wkt_parser_collection_finalize(MULTIPOINTTYPE, NULL, NULL); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_collection_finalize(state, MULTIPOINTTYPE, NULL, NULL); WKT_ERROR(); } ;
 
 point_list :
 	point_list COMMA_TOK point_untagged
-		{ $$ = wkt_parser_collection_add_geom($1,$3); WKT_ERROR(); } |
+		{ $$ = wkt_parser_collection_add_geom(state, $1,$3); WKT_ERROR(); } |
 	point_untagged
-		{ $$ = wkt_parser_collection_new($1); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_collection_new(state, $1); WKT_ERROR(); } ;
 
 point_untagged :
 	coordinate
-		{ $$ = wkt_parser_point_new(wkt_parser_ptarray_new($1),NULL); WKT_ERROR(); } |
+		{ $$ = wkt_parser_point_new(state, wkt_parser_ptarray_new(state, $1),NULL); WKT_ERROR(); } |
 	LBRACKET_TOK coordinate RBRACKET_TOK
-		{ $$ = wkt_parser_point_new(wkt_parser_ptarray_new($2),NULL); WKT_ERROR(); } |
+		{ $$ = wkt_parser_point_new(state, wkt_parser_ptarray_new(state, $2),NULL); WKT_ERROR(); } |
 	EMPTY_TOK
-		{ $$ = wkt_parser_point_new(NULL, NULL); WKT_ERROR(); };
+		{ $$ = wkt_parser_point_new(state, NULL, NULL); WKT_ERROR(); };
 
 point :
 	POINT_TOK LBRACKET_TOK ptarray RBRACKET_TOK
-		{ $$ = wkt_parser_point_new($3, NULL); WKT_ERROR(); } |
+		{ $$ = wkt_parser_point_new(state, $3, NULL); WKT_ERROR(); } |
 	POINT_TOK DIMENSIONALITY_TOK LBRACKET_TOK ptarray RBRACKET_TOK
-		{ $$ = wkt_parser_point_new($4, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_point_new(state, $4, $2); WKT_ERROR(); } |
 	POINT_TOK DIMENSIONALITY_TOK EMPTY_TOK
-		{ $$ = wkt_parser_point_new(NULL, $2); WKT_ERROR(); } |
+		{ $$ = wkt_parser_point_new(state, NULL, $2); WKT_ERROR(); } |
 	POINT_TOK EMPTY_TOK
-		{ $$ = wkt_parser_point_new(NULL,NULL); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_point_new(state, NULL,NULL); WKT_ERROR(); } ;
 
 ptarray :
 	ptarray COMMA_TOK coordinate
-		{ $$ = wkt_parser_ptarray_add_coord($1, $3); WKT_ERROR(); } |
+		{ $$ = wkt_parser_ptarray_add_coord(state, $1, $3); WKT_ERROR(); } |
 	coordinate
-		{ $$ = wkt_parser_ptarray_new($1); WKT_ERROR(); } ;
+		{ $$ = wkt_parser_ptarray_new(state, $1); WKT_ERROR(); } ;
 
 coordinate :
 	DOUBLE_TOK DOUBLE_TOK
@@ -23,12 +23,40 @@ GSERIALIZED *Postgis::LWGEOM_in(char *input) {
 	return duckdb::LWGEOM_in(input);
 }
 
+LWGEOM *Postgis::LWGEOM_parse(char *input) {
+	return duckdb::LWGEOM_parse(input);
+}
+
 GSERIALIZED *Postgis::LWGEOM_getGserialized(const void *base, size_t size) {
 	return duckdb::LWGEOM_getGserialized(base, size);
 }
 
-char *Postgis::LWGEOM_base(GSERIALIZED *gser) {
-	return duckdb::LWGEOM_base(gser);
+LWGEOM *Postgis::LWGEOM_getLWGeom(const void *base, size_t size) {
+	return duckdb::LWGEOM_getLWGeom(base, size);
+}
+
+bool Postgis::LWGEOM_getGBox(const void *base, size_t size, GBOX *box, int32_t *srid) {
+	return duckdb::LWGEOM_getGBox(base, size, box, srid);
+}
+
+bool Postgis::LWGEOM_getFastGBox(const void *base, size_t size, GBOX *box, int32_t *srid) {
+	return duckdb::LWGEOM_getFastGBox(base, size, box, srid);
+}
+
+bool Postgis::LWGEOM_getHeader(const void *base, size_t size, WKB_HEADER *header) {
+	return duckdb::LWGEOM_getHeader(base, size, header);
+}
+
+LWGEOM *Postgis::LWGEOM_deserialize(GSERIALIZED *gser) {
+	return duckdb::LWGEOM_deserialize(gser);
+}
+
+idx_t Postgis::LWGEOM_wkbSize(const LWGEOM *lwgeom) {
+	return duckdb::LWGEOM_wkbSize(lwgeom);
+}
+
+void Postgis::LWGEOM_wkbWrite(const LWGEOM *lwgeom, data_ptr_t buffer, idx_t size) {
+	duckdb::LWGEOM_wkbWrite(lwgeom, buffer, size);
 }
 
 string Postgis::LWGEOM_asBinary(const void *data, size_t size) {
@@ -55,14 +83,18 @@ lwvarlena_t *Postgis::ST_GeoHash(GSERIALIZED *gser, size_t m_chars) {
 	return duckdb::ST_GeoHash(gser, m_chars);
 }
 
-idx_t Postgis::LWGEOM_size(GSERIALIZED *gser) {
-	return duckdb::LWGEOM_size(gser);
+std::string Postgis::ST_GeoHashPoint(double x, double y, int m_chars) {
+	return duckdb::ST_GeoHashPoint(x, y, m_chars);
 }
 
 void Postgis::LWGEOM_free(GSERIALIZED *gser) {
 	duckdb::LWGEOM_free(gser);
 }
 
+void Postgis::LWGEOM_freeLWGeom(LWGEOM *lwgeom) {
+	duckdb::LWGEOM_freeLWGeom(lwgeom);
+}
+
 GSERIALIZED *Postgis::LWGEOM_makepoint(double x, double y) {
 	return duckdb::LWGEOM_makepoint(x, y);
 }
@@ -127,6 +159,10 @@ GSERIALIZED *Postgis::LWGEOM_simplify2d(GSERIALIZED *geom, double dist) {
 	return duckdb::LWGEOM_simplify2d(geom, dist);
 }
 
+void Postgis::LWGEOM_simplify2d(LWGEOM *geom, double dist) {
+	duckdb::LWGEOM_simplify2d(geom, dist);
+}
+
 GSERIALIZED *Postgis::convexhull(GSERIALIZED *geom) {
 	return duckdb::convexhull(geom);
 }
@@ -139,47 +175,52 @@ GSERIALIZED *Postgis::buffer(GSERIALIZED *geom, double radius, string styles_tex
 	return duckdb::buffer(geom, radius, styles_text);
 }
 
-bool Postgis::ST_Equals(GSERIALIZED *geom1, GSERIALIZED *geom2) {
+bool Postgis::ST_Equals(LWGEOM *geom1, LWGEOM *geom2) {
 	return duckdb::ST_Equals(geom1, geom2);
 }
 
-bool Postgis::contains(GSERIALIZED *geom1, GSERIALIZED *geom2) {
-	return duckdb::contains(geom1, geom2);
+bool Postgis::contains(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache) {
+	return duckdb::contains(geom1, geom2, cache);
 }
 
-bool Postgis::touches(GSERIALIZED *geom1, GSERIALIZED *geom2) {
-	return duckdb::touches(geom1, geom2);
+bool Postgis::touches(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache) {
+	return duckdb::touches(geom1, geom2, cache);
 }
 
-bool Postgis::within(GSERIALIZED *geom1, GSERIALIZED *geom2) {
-	return duckdb::contains(geom2, geom1);
+bool Postgis::within(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache) {
+	return duckdb::contains(geom2, geom1, cache);
 }
 
-bool Postgis::ST_Intersects(GSERIALIZED *geom1, GSERIALIZED *geom2) {
-	return duckdb::ST_Intersects(geom1, geom2);
+bool Postgis::ST_Intersects(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache) {
+	return duckdb::ST_Intersects(geom1, geom2, cache);
 }
 
-bool Postgis::covers(GSERIALIZED *geom1, GSERIALIZED *geom2) {
-	return duckdb::covers(geom1, geom2);
+bool Postgis::covers(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache) {
+	return duckdb::covers(geom1, geom2, cache);
 }
 
-bool Postgis::coveredby(GSERIALIZED *geom1, GSERIALIZED *geom2) {
-	return duckdb::coveredby(geom1, geom2);
+bool Postgis::coveredby(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache) {
+	return duckdb::coveredby(geom1, geom2, cache);
 }
 
-bool Postgis::disjoint(GSERIALIZED *geom1, GSERIALIZED *geom2) {
-	return duckdb::disjoint(geom1, geom2);
+bool Postgis::disjoint(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache) {
+	return duckdb::disjoint(geom1, geom2, cache);
 }
 
-bool Postgis::LWGEOM_dwithin(GSERIALIZED *geom1, GSERIALIZED *geom2, double distance) {
+bool Postgis::LWGEOM_dwithin(LWGEOM *geom1, LWGEOM *geom2, double distance) {
 	return duckdb::LWGEOM_dwithin(geom1, geom2, distance);
 }
 
-double Postgis::ST_Area(GSERIALIZED *geom) {
+bool Postgis::geography_dwithin(LWGEOM *geom1, LWGEOM *geom2, double distance, bool use_spheroid,
+                                const CircTreeGeomCache *cache) {
+	return duckdb::geography_dwithin(geom1, geom2, distance, use_spheroid, cache);
+}
+
+double Postgis::ST_Area(LWGEOM *geom) {
 	return duckdb::ST_Area(geom);
 }
 
-double Postgis::geography_area(GSERIALIZED *geom, bool use_spheroid) {
+double Postgis::geography_area(LWGEOM *geom, bool use_spheroid) {
 	return duckdb::geography_area(geom, use_spheroid);
 }
 
@@ -191,27 +232,27 @@ double Postgis::LWGEOM_angle(std::vector<GSERIALIZED *> geom_vec) {
 	return duckdb::LWGEOM_angle(geom_vec);
 }
 
-double Postgis::LWGEOM_perimeter2d_poly(GSERIALIZED *geom) {
+double Postgis::LWGEOM_perimeter2d_poly(LWGEOM *geom) {
 	return duckdb::LWGEOM_perimeter2d_poly(geom);
 }
 
-double Postgis::geography_perimeter(GSERIALIZED *geom, bool use_spheroid) {
+double Postgis::geography_perimeter(LWGEOM *geom, bool use_spheroid) {
 	return duckdb::geography_perimeter(geom, use_spheroid);
 }
 
-double Postgis::LWGEOM_azimuth(GSERIALIZED *geom1, GSERIALIZED *geom2) {
+double Postgis::LWGEOM_azimuth(LWGEOM *geom1, LWGEOM *geom2) {
 	return duckdb::LWGEOM_azimuth(geom1, geom2);
 }
 
-double Postgis::geography_azimuth(GSERIALIZED *geom1, GSERIALIZED *geom2) {
+double Postgis::geography_azimuth(LWGEOM *geom1, LWGEOM *geom2) {
 	return duckdb::geography_azimuth(geom1, geom2);
 }
 
-double Postgis::LWGEOM_length2d_linestring(GSERIALIZED *geom) {
+double Postgis::LWGEOM_length2d_linestring(LWGEOM *geom) {
 	return duckdb::LWGEOM_length2d_linestring(geom);
 }
 
-double Postgis::geography_length(GSERIALIZED *geom, bool use_spheroid) {
+double Postgis::geography_length(LWGEOM *geom, bool use_spheroid) {
 	return duckdb::geography_length(geom, use_spheroid);
 }
 
@@ -219,23 +260,38 @@ GSERIALIZED *Postgis::LWGEOM_envelope(GSERIALIZED *geom) {
 	return duckdb::LWGEOM_envelope(geom);
 }
 
-double Postgis::LWGEOM_maxdistance2d_linestring(GSERIALIZED *geom1, GSERIALIZED *geom2) {
+double Postgis::LWGEOM_maxdistance2d_linestring(LWGEOM *geom1, LWGEOM *geom2) {
 	return duckdb::LWGEOM_maxdistance2d_linestring(geom1, geom2);
 }
 
-double Postgis::geography_maxdistance(GSERIALIZED *geom1, GSERIALIZED *geom2, bool use_spheroid) {
-	return duckdb::geography_maxdistance(geom1, geom2, use_spheroid);
+double Postgis::geography_maxdistance(LWGEOM *geom1, LWGEOM *geom2, bool use_spheroid,
+                                      const CircTreeGeomCache *cache) {
+	return duckdb::geography_maxdistance(geom1, geom2, use_spheroid, cache);
+}
+
+LWGEOM *Postgis::LWGEOM_envelope_gbox(const GBOX *gbox, int32_t srid) {
+	return duckdb::LWGEOM_envelope_gbox(gbox, srid);
 }
 
 GSERIALIZED *Postgis::LWGEOM_envelope_garray(GSERIALIZED *gserArray[], int nelems) {
 	return duckdb::LWGEOM_envelope_garray(gserArray, nelems);
 }
 
-std::vector<int> Postgis::ST_ClusterDBSCAN(GSERIALIZED *gserArray[], int nelems, double tolerance, int minpoints) {
-	return duckdb::ST_ClusterDBSCAN(gserArray, nelems, tolerance, minpoints);
+std::vector<int> Postgis::ST_ClusterDBSCAN(GSERIALIZED *gserArray[], int nelems, double tolerance, int minpoints,
+                                           uint32_t max_threads) {
+	return duckdb::ST_ClusterDBSCAN(gserArray, nelems, tolerance, minpoints, max_threads);
 }
 
-int Postgis::LWGEOM_dimension(GSERIALIZED *geom) {
+std::vector<int> Postgis::ST_ClusterDBSCAN(LWGEOM *geoms[], int nelems, double tolerance, int minpoints,
+                                           uint32_t max_threads) {
+	return duckdb::ST_ClusterDBSCAN(geoms, nelems, tolerance, minpoints, max_threads);
+}
+
+std::vector<int> Postgis::ST_ClusterKMeans(LWGEOM *geoms[], int nelems, int k) {
+	return duckdb::ST_ClusterKMeans(geoms, nelems, k);
+}
+
+int Postgis::LWGEOM_dimension(LWGEOM *geom) {
 	return duckdb::LWGEOM_dimension(geom);
 }
 
@@ -247,35 +303,35 @@ GSERIALIZED *Postgis::LWGEOM_endpoint_linestring(GSERIALIZED *geom) {
 	return duckdb::LWGEOM_endpoint_linestring(geom);
 }
 
-std::string Postgis::geometry_geometrytype(GSERIALIZED *geom) {
+std::string Postgis::geometry_geometrytype(LWGEOM *geom) {
 	return duckdb::geometry_geometrytype(geom);
 }
 
-bool Postgis::LWGEOM_isclosed(GSERIALIZED *geom) {
+bool Postgis::LWGEOM_isclosed(LWGEOM *geom) {
 	return duckdb::LWGEOM_isclosed(geom);
 }
 
-bool Postgis::ST_IsCollection(GSERIALIZED *geom) {
+bool Postgis::ST_IsCollection(LWGEOM *geom) {
 	return duckdb::ST_IsCollection(geom);
 }
 
-bool Postgis::LWGEOM_isempty(GSERIALIZED *geom) {
+bool Postgis::LWGEOM_isempty(LWGEOM *geom) {
 	return duckdb::LWGEOM_isempty(geom);
 }
 
-bool Postgis::LWGEOM_isring(GSERIALIZED *geom) {
+bool Postgis::LWGEOM_isring(LWGEOM *geom) {
 	return duckdb::LWGEOM_isring(geom);
 }
 
-int Postgis::LWGEOM_npoints(GSERIALIZED *geom) {
+int Postgis::LWGEOM_npoints(LWGEOM *geom) {
 	return duckdb::LWGEOM_npoints(geom);
 }
 
-int Postgis::LWGEOM_numgeometries_collection(GSERIALIZED *geom) {
+int Postgis::LWGEOM_numgeometries_collection(LWGEOM *geom) {
 	return duckdb::LWGEOM_numgeometries_collection(geom);
 }
 
-int Postgis::LWGEOM_numpoints_linestring(GSERIALIZED *geom) {
+int Postgis::LWGEOM_numpoints_linestring(LWGEOM *geom) {
 	return duckdb::LWGEOM_numpoints_linestring(geom);
 }
 
@@ -287,20 +343,43 @@ GSERIALIZED *Postgis::LWGEOM_startpoint_linestring(GSERIALIZED *geom) {
 	return duckdb::LWGEOM_startpoint_linestring(geom);
 }
 
-double Postgis::LWGEOM_x_point(GSERIALIZED *geom) {
+double Postgis::LWGEOM_x_point(LWGEOM *geom) {
 	return duckdb::LWGEOM_x_point(geom);
 }
 
-double Postgis::LWGEOM_y_point(GSERIALIZED *geom) {
+double Postgis::LWGEOM_y_point(LWGEOM *geom) {
 	return duckdb::LWGEOM_y_point(geom);
 }
 
-double Postgis::ST_distance(GSERIALIZED *geom1, GSERIALIZED *geom2) {
+bool Postgis::LWGEOM_point(LWGEOM *geom, POINT4D *pt) {
+	return duckdb::LWGEOM_point(geom, pt);
+}
+
+double Postgis::ST_distance(LWGEOM *geom1, LWGEOM *geom2) {
 	return duckdb::ST_distance(geom1, geom2);
 }
 
-double Postgis::geography_distance(GSERIALIZED *geom1, GSERIALIZED *geom2, bool use_spheroid) {
-	return duckdb::geography_distance(geom1, geom2, use_spheroid);
+double Postgis::geography_distance(LWGEOM *geom1, LWGEOM *geom2, bool use_spheroid,
+                                   const CircTreeGeomCache *cache) {
+	return duckdb::geography_distance(geom1, geom2, use_spheroid, cache);
+}
+
+double Postgis::geography_point_distance(const POINT2D *pt1, const POINT2D *pt2, int32_t srid, bool use_spheroid) {
+	return duckdb::geography_point_distance(pt1, pt2, srid, use_spheroid);
+}
+
+bool Postgis::geography_point_dwithin(const POINT2D *pt1, const POINT2D *pt2, int32_t srid, double tolerance,
+                                      bool use_spheroid) {
+	return duckdb::geography_point_dwithin(pt1, pt2, srid, tolerance, use_spheroid);
+}
+
+double Postgis::geography_point_azimuth(const POINT2D *pt1, const POINT2D *pt2, int32_t srid) {
+	return duckdb::geography_point_azimuth(pt1, pt2, srid);
+}
+
+double Postgis::geography_coords_length(const double *x, const double *y, uint32_t npoints, int32_t srid,
+                                        bool use_spheroid) {
+	return duckdb::geography_coords_length(x, y, npoints, srid, use_spheroid);
 }
 
 GSERIALIZED *Postgis::centroid(GSERIALIZED *geom) {
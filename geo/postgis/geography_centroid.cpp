@@ -36,6 +36,10 @@ namespace duckdb {
 LWPOINT *geography_centroid_from_wpoints(const int32_t srid, const POINT3DM *points, const uint32_t size);
 LWPOINT *geography_centroid_from_mline(const LWMLINE *mline, SPHEROID *s);
 LWPOINT *geography_centroid_from_mpoly(const LWMPOLY *mpoly, bool use_spheroid, SPHEROID *s);
+POINT3DM *geography_wpoints_from_lines(LWLINE *const *lines, const uint32_t nlines, const int32_t srid, SPHEROID *s,
+                                       uint32_t *size);
+POINT3DM *geography_wpoints_from_polys(LWPOLY *const *polys, const uint32_t npolys, const int32_t srid,
+                                       bool use_spheroid, SPHEROID *s, uint32_t *size);
 LWPOINT *cart_to_lwpoint(const double_t x_sum, const double_t y_sum, const double_t z_sum, const double_t weight_sum,
                          const int32_t srid);
 POINT3D *lonlat_to_cart(const double_t raw_lon, const double_t raw_lat);
@@ -180,21 +184,35 @@ LWPOINT *geography_centroid_from_wpoints(const int32_t srid, const POINT3DM *poi
  * point.
  */
 LWPOINT *geography_centroid_from_mline(const LWMLINE *mline, SPHEROID *s) {
+	uint32_t size;
+	POINT3DM *points;
+	LWPOINT *result;
+
+	points = geography_wpoints_from_lines(mline->geoms, mline->ngeoms, mline->srid, s, &size);
+	result = geography_centroid_from_wpoints(mline->srid, points, size);
+	free(points);
+	return result;
+}
+
+/**
+ * Both points of each line segment, weighted with the segment length.
+ */
+POINT3DM *geography_wpoints_from_lines(LWLINE *const *lines, const uint32_t nlines, const int32_t srid, SPHEROID *s,
+                                       uint32_t *size) {
 	double_t tolerance = 0.0;
-	uint32_t size = 0;
 	uint32_t i, k, j = 0;
 	POINT3DM *points;
-	LWPOINT *result;
 
 	/* get total number of points */
-	for (i = 0; i < mline->ngeoms; i++) {
-		size += (mline->geoms[i]->points->npoints - 1) * 2;
+	*size = 0;
+	for (i = 0; i < nlines; i++) {
+		*size += (lines[i]->points->npoints - 1) * 2;
 	}
 
-	points = (POINT3DM *)malloc(size * sizeof(POINT3DM));
+	points = (POINT3DM *)malloc(*size * sizeof(POINT3DM));
 
-	for (i = 0; i < mline->ngeoms; i++) {
-		LWLINE *line = mline->geoms[i];
+	for (i = 0; i < nlines; i++) {
+		LWLINE *line = lines[i];
 
 		/* add both points of line segment as weighted point */
 		for (k = 0; k < line->points->npoints - 1; k++) {
@@ -203,8 +221,8 @@ LWPOINT *geography_centroid_from_mline(const LWMLINE *mline, SPHEROID *s) {
 			double_t weight;
 
 			/* use line-segment length as weight */
-			LWPOINT *lwp1 = lwpoint_make2d(mline->srid, p1->x, p1->y);
-			LWPOINT *lwp2 = lwpoint_make2d(mline->srid, p2->x, p2->y);
+			LWPOINT *lwp1 = lwpoint_make2d(srid, p1->x, p1->y);
+			LWPOINT *lwp2 = lwpoint_make2d(srid, p2->x, p2->y);
 			LWGEOM *lwgeom1 = lwpoint_as_lwgeom(lwp1);
 			LWGEOM *lwgeom2 = lwpoint_as_lwgeom(lwp2);
 			lwgeom_set_geodetic(lwgeom1, LW_TRUE);
@@ -228,9 +246,7 @@ LWPOINT *geography_centroid_from_mline(const LWMLINE *mline, SPHEROID *s) {
 		}
 	}
 
-	result = geography_centroid_from_wpoints(mline->srid, points, size);
-	free(points);
-	return result;
+	return points;
 }
 
 /**
@@ -238,25 +254,40 @@ LWPOINT *geography_centroid_from_mline(const LWMLINE *mline, SPHEROID *s) {
  * triangle area as weight to calculate the centroid of a (multi)polygon.
  */
 LWPOINT *geography_centroid_from_mpoly(const LWMPOLY *mpoly, bool use_spheroid, SPHEROID *s) {
-	uint32_t size = 0;
+	uint32_t size;
+	POINT3DM *points;
+	LWPOINT *result = NULL;
+
+	points = geography_wpoints_from_polys(mpoly->geoms, mpoly->ngeoms, mpoly->srid, use_spheroid, s, &size);
+	result = geography_centroid_from_wpoints(mpoly->srid, points, size);
+	free(points);
+	return result;
+}
+
+/**
+ * The centroid of each triangle between a ring segment and the first point of
+ * the first polygon, weighted with the triangle area.
+ */
+POINT3DM *geography_wpoints_from_polys(LWPOLY *const *polys, const uint32_t npolys, const int32_t srid,
+                                       bool use_spheroid, SPHEROID *s, uint32_t *size) {
 	uint32_t i, ir, ip, j = 0;
 	POINT3DM *points;
 	POINT4D *reference_point = NULL;
-	LWPOINT *result = NULL;
 
-	for (ip = 0; ip < mpoly->ngeoms; ip++) {
-		for (ir = 0; ir < mpoly->geoms[ip]->nrings; ir++) {
-			size += mpoly->geoms[ip]->rings[ir]->npoints - 1;
+	*size = 0;
+	for (ip = 0; ip < npolys; ip++) {
+		for (ir = 0; ir < polys[ip]->nrings; ir++) {
+			*size += polys[ip]->rings[ir]->npoints - 1;
 		}
 	}
 
-	points = (POINT3DM *)malloc(size * sizeof(POINT3DM));
+	points = (POINT3DM *)malloc(*size * sizeof(POINT3DM));
 
 	/* use first point as reference to create triangles */
-	reference_point = (POINT4D *)getPoint2d_cp(mpoly->geoms[0]->rings[0], 0);
+	reference_point = (POINT4D *)getPoint2d_cp(polys[0]->rings[0], 0);
 
-	for (ip = 0; ip < mpoly->ngeoms; ip++) {
-		LWPOLY *poly = mpoly->geoms[ip];
+	for (ip = 0; ip < npolys; ip++) {
+		LWPOLY *poly = polys[ip];
 
 		for (ir = 0; ir < poly->nrings; ir++) {
 			POINTARRAY *ring = poly->rings[ir];
@@ -277,7 +308,7 @@ LWPOINT *geography_centroid_from_mpoly(const LWMPOLY *mpoly, bool use_spheroid,
 				ptarray_insert_point(pa, reference_point, 2);
 				ptarray_insert_point(pa, p1, 3);
 
-				poly_tri = lwpoly_construct_empty(mpoly->srid, 0, 0);
+				poly_tri = lwpoly_construct_empty(srid, 0, 0);
 				lwpoly_add_ring(poly_tri, pa);
 
 				geom_tri = lwpoly_as_lwgeom(poly_tri);
@@ -305,7 +336,7 @@ LWPOINT *geography_centroid_from_mpoly(const LWMPOLY *mpoly, bool use_spheroid,
 				triangle[2].m = 1;
 
 				/* get center of triangle */
-				tri_centroid = geography_centroid_from_wpoints(mpoly->srid, triangle, 3);
+				tri_centroid = geography_centroid_from_wpoints(srid, triangle, 3);
 
 				points[j].x = lwpoint_get_x(tri_centroid);
 				points[j].y = lwpoint_get_y(tri_centroid);
@@ -317,9 +348,7 @@ LWPOINT *geography_centroid_from_mpoly(const LWMPOLY *mpoly, bool use_spheroid,
 			}
 		}
 	}
-	result = geography_centroid_from_wpoints(mpoly->srid, points, size);
-	free(points);
-	return result;
+	return points;
 }
 
 LWPOINT *cart_to_lwpoint(const double_t x_sum, const double_t y_sum, const double_t z_sum, const double_t weight_sum,
@@ -360,4 +389,139 @@ POINT3D *lonlat_to_cart(const double_t raw_lon, const double_t raw_lat) {
 	return point;
 }
 
+/* The index of the total weight among the sums of a dimension */
+#define CENTROID_SUM_WEIGHT 3
+
+void GeographyCentroidSum::Initialize() {
+	memset(sums, 0, sizeof(sums));
+	memset(compensations, 0, sizeof(compensations));
+	has_input = false;
+	srid = SRID_UNKNOWN;
+}
+
+void GeographyCentroidSum::AddTerm(int dimension, int coordinate, double value) {
+	/* Neumaier's variant of the Kahan summation, which still holds when the term is larger than the sum */
+	double &sum = sums[dimension][coordinate];
+	double t = sum + value;
+	if (fabs(sum) >= fabs(value))
+		compensations[dimension][coordinate] += (sum - t) + value;
+	else
+		compensations[dimension][coordinate] += (value - t) + sum;
+	sum = t;
+}
+
+void GeographyCentroidSum::AddWeighted(int dimension, double lon, double lat, double weight) {
+	/* as lonlat_to_cart, but in double precision: the long double functions cost most of the time of a point */
+	double colat = (lat + 90) / 180 * M_PI;
+	double sin_colat = sin(colat);
+	lon = lon / 180 * M_PI;
+
+	AddTerm(dimension, 0, sin_colat * cos(lon) * weight);
+	AddTerm(dimension, 1, sin_colat * sin(lon) * weight);
+	AddTerm(dimension, 2, cos(colat) * weight);
+	AddTerm(dimension, CENTROID_SUM_WEIGHT, weight);
+}
+
+void GeographyCentroidSum::AddParts(const LWGEOM *geom, SPHEROID *s) {
+	POINT3DM *points;
+	uint32_t i, size;
+	int dimension;
+
+	if (lwgeom_is_empty(geom))
+		return;
+
+	switch (geom->type) {
+	case POINTTYPE: {
+		/* no need for the weighted points of a single point */
+		const POINT2D *p = getPoint2d_cp(((const LWPOINT *)geom)->point, 0);
+		AddWeighted(0, p->x, p->y, 1);
+		return;
+	}
+	case LINETYPE: {
+		LWLINE *line = (LWLINE *)geom;
+		points = geography_wpoints_from_lines(&line, 1, srid, s, &size);
+		dimension = 1;
+		break;
+	}
+	case POLYGONTYPE: {
+		LWPOLY *poly = (LWPOLY *)geom;
+		points = geography_wpoints_from_polys(&poly, 1, srid, false, s, &size);
+		dimension = 2;
+		break;
+	}
+	case MULTIPOINTTYPE:
+	case MULTILINETYPE:
+	case MULTIPOLYGONTYPE:
+	case COLLECTIONTYPE: {
+		const LWCOLLECTION *col = (const LWCOLLECTION *)geom;
+		for (i = 0; i < col->ngeoms; i++)
+			AddParts(col->geoms[i], s);
+		return;
+	}
+	default:
+		lwerror("ST_Centroid(geography) unhandled geography type");
+		return;
+	}
+
+	for (i = 0; i < size; i++)
+		AddWeighted(dimension, points[i].x, points[i].y, points[i].m);
+	free(points);
+}
+
+void GeographyCentroidSum::Add(const LWGEOM *geom) {
+	SPHEROID s;
+
+	if (!has_input) {
+		srid = geom->srid;
+		has_input = true;
+	} else if (geom->srid != srid) {
+		lwerror("ST_Centroid: Operation on mixed SRID geometries");
+	}
+
+	/* the same sphere as geography_centroid without use_spheroid, points don't need it */
+	if (geom->type != POINTTYPE) {
+		spheroid_init_from_srid(srid, &s);
+		s.a = s.b = s.radius;
+	}
+	AddParts(geom, &s);
+}
+
+void GeographyCentroidSum::Merge(const GeographyCentroidSum &other) {
+	if (!other.has_input)
+		return;
+	if (!has_input) {
+		srid = other.srid;
+		has_input = true;
+	} else if (other.srid != srid) {
+		lwerror("ST_Centroid: Operation on mixed SRID geometries");
+	}
+
+	for (int dimension = 0; dimension < 3; dimension++) {
+		for (int coordinate = 0; coordinate < 4; coordinate++) {
+			AddTerm(dimension, coordinate, other.sums[dimension][coordinate]);
+			compensations[dimension][coordinate] += other.compensations[dimension][coordinate];
+		}
+	}
+}
+
+LWGEOM *GeographyCentroidSum::Finish() const {
+	if (!has_input)
+		return NULL;
+
+	/* the centroid of the highest dimension that has a weight */
+	for (int dimension = 2; dimension >= 0; dimension--) {
+		const double *sum = sums[dimension];
+		const double *compensation = compensations[dimension];
+		double weight = sum[CENTROID_SUM_WEIGHT] + compensation[CENTROID_SUM_WEIGHT];
+		if (weight == 0)
+			continue;
+		LWPOINT *centroid = cart_to_lwpoint(sum[0] + compensation[0], sum[1] + compensation[1],
+		                                    sum[2] + compensation[2], weight, srid);
+		return lwpoint_as_lwgeom(centroid);
+	}
+
+	/* on empty input, return empty output */
+	return lwcollection_as_lwgeom(lwcollection_construct_empty(COLLECTIONTYPE, srid, 0, 0));
+}
+
 } // namespace duckdb
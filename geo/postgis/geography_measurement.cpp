@@ -44,24 +44,25 @@ namespace duckdb {
 #endif
 
 /*
- ** geography_distance(GSERIALIZED *g1, GSERIALIZED *g2, double tolerance, boolean use_spheroid)
+ ** geography_distance(LWGEOM *lwgeom1, LWGEOM *lwgeom2, boolean use_spheroid)
  ** returns double distance in meters
+ ** cache, when given, holds the circle tree of whichever argument repeats
  */
-double geography_distance(GSERIALIZED *g1, GSERIALIZED *g2, bool use_spheroid) {
+double geography_distance(LWGEOM *lwgeom1, LWGEOM *lwgeom2, bool use_spheroid, const CircTreeGeomCache *cache) {
 	double distance;
 	SPHEROID s;
 
-	gserialized_error_if_srid_mismatch(g1, g2, __func__);
+	lwgeom_error_if_srid_mismatch(lwgeom1, lwgeom2, __func__);
 
 	/* Initialize spheroid */
-	spheroid_init_from_srid(gserialized_get_srid(g1), &s);
+	spheroid_init_from_srid(lwgeom1->srid, &s);
 
 	/* Set to sphere if requested */
 	if (!use_spheroid)
 		s.a = s.b = s.radius;
 
 	/* Return NULL on empty arguments. */
-	if (gserialized_is_empty(g1) || gserialized_is_empty(g2)) {
+	if (lwgeom_is_empty(lwgeom1) || lwgeom_is_empty(lwgeom2)) {
 		PG_ERROR_NULL();
 	}
 
@@ -70,7 +71,7 @@ double geography_distance(GSERIALIZED *g1, GSERIALIZED *g2, bool use_spheroid) {
 	// {
 	/* default to using tree-based distance calculation at all times */
 	/* in standard distance call. */
-	geography_tree_distance(g1, g2, &s, FP_TOLERANCE, &distance);
+	geography_tree_distance(lwgeom1, lwgeom2, &s, FP_TOLERANCE, &distance, cache);
 	/*
 	LWGEOM* lwgeom1 = lwgeom_from_gserialized(g1);
 	LWGEOM* lwgeom2 = lwgeom_from_gserialized(g2);
@@ -92,24 +93,118 @@ double geography_distance(GSERIALIZED *g1, GSERIALIZED *g2, bool use_spheroid) {
 }
 
 /*
- ** geography_maxdistance(GSERIALIZED *g1, GSERIALIZED *g2, double tolerance, boolean use_spheroid)
+ ** The distance in meters between two points, unrounded, computed the way
+ ** circ_tree_distance_tree does for two point leaves.
+ */
+static double point_distance(const POINT2D *pt1, const POINT2D *pt2, int32_t srid, bool use_spheroid) {
+	GEOGRAPHIC_POINT g1, g2;
+	SPHEROID s;
+
+	/* Initialize spheroid */
+	spheroid_init_from_srid(srid, &s);
+
+	/* Set to sphere if requested */
+	if (!use_spheroid)
+		s.a = s.b = s.radius;
+
+	geographic_point_init(pt1->x, pt1->y, &g1);
+	geographic_point_init(pt2->x, pt2->y, &g2);
+	if (s.a == s.b)
+		return s.radius * sphere_distance(&g1, &g2);
+	return spheroid_distance(&g1, &g2, &s);
+}
+
+/*
+ ** geography_point_distance(POINT2D *pt1, POINT2D *pt2, int32_t srid, boolean use_spheroid)
+ ** returns double distance in meters between two non-empty points of one srid,
+ ** the same as geography_distance without building their circle trees
+ */
+double geography_point_distance(const POINT2D *pt1, const POINT2D *pt2, int32_t srid, bool use_spheroid) {
+	double distance = point_distance(pt1, pt2, srid, use_spheroid);
+
+	/* Knock off any funny business at the nanometer level, ticket #2168 */
+	distance = round(distance * INVMINDIST) / INVMINDIST;
+
+	/* Something went wrong, negative return... should already be eloged, return NULL */
+	if (distance < 0.0) {
+		PG_ERROR_NULL();
+	}
+
+	return distance;
+}
+
+/*
+ ** geography_point_dwithin(POINT2D *pt1, POINT2D *pt2, int32_t srid, double tolerance, boolean use_spheroid)
+ ** returns true if two non-empty points of one srid are within tolerance meters,
+ ** the same as geography_dwithin without building their circle trees
+ */
+bool geography_point_dwithin(const POINT2D *pt1, const POINT2D *pt2, int32_t srid, double tolerance,
+                             bool use_spheroid) {
+	if (tolerance < 0) {
+		lwerror("Tolerance cannot be less than zero");
+		return false;
+	}
+
+	return point_distance(pt1, pt2, srid, use_spheroid) <= tolerance + FP_TOLERANCE;
+}
+
+/*
+ ** geography_coords_length(double *x, double *y, uint32_t npoints, int32_t srid, boolean use_spheroid)
+ ** returns double length in meters of a line given by separate x and y arrays,
+ ** the same as geography_length without building the line
+ */
+double geography_coords_length(const double *x, const double *y, uint32_t npoints, int32_t srid,
+                               bool use_spheroid) {
+	GEOGRAPHIC_POINT a, b;
+	SPHEROID s;
+	double length = 0.0;
+	uint32_t i;
+
+	/* EMPTY things have no length */
+	if (npoints < 2)
+		return 0.0;
+
+	/* Initialize spheroid */
+	spheroid_init_from_srid(srid, &s);
+
+	/* User requests spherical calculation, turn our spheroid into a sphere */
+	if (!use_spheroid)
+		s.a = s.b = s.radius;
+
+	/* Sum the segments like ptarray_length_spheroid */
+	geographic_point_init(x[0], y[0], &a);
+	for (i = 1; i < npoints; i++) {
+		geographic_point_init(x[i], y[i], &b);
+		if (s.a == s.b)
+			length += s.radius * sphere_distance(&a, &b);
+		else
+			length += spheroid_distance(&a, &b, &s);
+		a = b;
+	}
+
+	return length;
+}
+
+/*
+ ** geography_maxdistance(LWGEOM *lwgeom1, LWGEOM *lwgeom2, boolean use_spheroid)
  ** returns double distance in meters
+ ** cache, when given, holds the circle tree of whichever argument repeats
  */
-double geography_maxdistance(GSERIALIZED *g1, GSERIALIZED *g2, bool use_spheroid) {
+double geography_maxdistance(LWGEOM *lwgeom1, LWGEOM *lwgeom2, bool use_spheroid, const CircTreeGeomCache *cache) {
 	double maxdistance;
 	SPHEROID s;
 
-	gserialized_error_if_srid_mismatch(g1, g2, __func__);
+	lwgeom_error_if_srid_mismatch(lwgeom1, lwgeom2, __func__);
 
 	/* Initialize spheroid */
-	spheroid_init_from_srid(gserialized_get_srid(g1), &s);
+	spheroid_init_from_srid(lwgeom1->srid, &s);
 
 	/* Set to sphere if requested */
 	if (!use_spheroid)
 		s.a = s.b = s.radius;
 
 	/* Return NULL on empty arguments. */
-	if (gserialized_is_empty(g1) || gserialized_is_empty(g2)) {
+	if (lwgeom_is_empty(lwgeom1) || lwgeom_is_empty(lwgeom2)) {
 		PG_ERROR_NULL();
 	}
 
@@ -118,7 +213,7 @@ double geography_maxdistance(GSERIALIZED *g1, GSERIALIZED *g2, bool use_spheroid
 	// {
 	/* default to using tree-based distance calculation at all times */
 	/* in standard distance call. */
-	geography_tree_maxdistance(g1, g2, &s, FP_TOLERANCE, &maxdistance);
+	geography_tree_maxdistance(lwgeom1, lwgeom2, &s, FP_TOLERANCE, &maxdistance, cache);
 	/*
 	LWGEOM* lwgeom1 = lwgeom_from_gserialized(g1);
 	LWGEOM* lwgeom2 = lwgeom_from_gserialized(g2);
@@ -140,23 +235,57 @@ double geography_maxdistance(GSERIALIZED *g1, GSERIALIZED *g2, bool use_spheroid
 }
 
 /*
-** geography_area(GSERIALIZED *g)
+ ** geography_dwithin(LWGEOM *lwgeom1, LWGEOM *lwgeom2, double tolerance, boolean use_spheroid)
+ ** returns true if the geographies are within tolerance meters of each other
+ ** cache, when given, holds the circle tree of whichever argument repeats
+ */
+bool geography_dwithin(LWGEOM *lwgeom1, LWGEOM *lwgeom2, double tolerance, bool use_spheroid,
+                       const CircTreeGeomCache *cache) {
+	double distance;
+	SPHEROID s;
+
+	if (tolerance < 0) {
+		lwerror("Tolerance cannot be less than zero");
+		return false;
+	}
+
+	lwgeom_error_if_srid_mismatch(lwgeom1, lwgeom2, __func__);
+
+	/* Initialize spheroid */
+	spheroid_init_from_srid(lwgeom1->srid, &s);
+
+	/* Set to sphere if requested */
+	if (!use_spheroid)
+		s.a = s.b = s.radius;
+
+	/* Return FALSE on empty arguments. */
+	if (lwgeom_is_empty(lwgeom1) || lwgeom_is_empty(lwgeom2)) {
+		return false;
+	}
+
+	/* The tree walk stops as soon as it finds a pair of edges within the tolerance */
+	if (LW_FAILURE == geography_tree_distance(lwgeom1, lwgeom2, &s, tolerance, &distance, cache)) {
+		lwerror("geography_dwithin failed!");
+		return false;
+	}
+
+	return distance <= tolerance + FP_TOLERANCE;
+}
+
+/*
+** geography_area(LWGEOM *lwgeom)
 ** returns double area in meters square
 */
-double geography_area(GSERIALIZED *g, bool use_spheroid) {
-	LWGEOM *lwgeom = NULL;
+double geography_area(LWGEOM *lwgeom, bool use_spheroid) {
 	GBOX gbox;
 	double area;
 	SPHEROID s;
 
 	/* Initialize spheroid */
-	spheroid_init_from_srid(gserialized_get_srid(g), &s);
-
-	lwgeom = lwgeom_from_gserialized(g);
+	spheroid_init_from_srid(lwgeom->srid, &s);
 
 	/* EMPTY things have no area */
 	if (lwgeom_is_empty(lwgeom)) {
-		lwgeom_free(lwgeom);
 		return 0.0;
 	}
 
@@ -175,9 +304,6 @@ double geography_area(GSERIALIZED *g, bool use_spheroid) {
 	else
 		area = lwgeom_area_sphere(lwgeom, &s);
 
-	/* Clean up */
-	lwgeom_free(lwgeom);
-
 	/* Something went wrong... */
 	if (area < 0.0) {
 		throw "lwgeom_area_spher(oid) returned area < 0.0";
@@ -188,31 +314,27 @@ double geography_area(GSERIALIZED *g, bool use_spheroid) {
 }
 
 /*
-** geography_perimeter(GSERIALIZED *g)
+** geography_perimeter(LWGEOM *lwgeom)
 ** returns double perimeter in meters for area features
 */
-double geography_perimeter(GSERIALIZED *g, bool use_spheroid) {
-	LWGEOM *lwgeom = NULL;
+double geography_perimeter(LWGEOM *lwgeom, bool use_spheroid) {
 	double length;
 	SPHEROID s;
 	int type;
 
 	/* Only return for area features. */
-	type = gserialized_get_type(g);
+	type = lwgeom->type;
 	if (!(type == POLYGONTYPE || type == MULTIPOLYGONTYPE || type == COLLECTIONTYPE)) {
 		return 0.0;
 	}
 
-	lwgeom = lwgeom_from_gserialized(g);
-
 	/* EMPTY things have no perimeter */
 	if (lwgeom_is_empty(lwgeom)) {
-		lwgeom_free(lwgeom);
 		return 0.0;
 	}
 
 	/* Initialize spheroid */
-	spheroid_init_from_srid(gserialized_get_srid(g), &s);
+	spheroid_init_from_srid(lwgeom->srid, &s);
 
 	/* User requests spherical calculation, turn our spheroid into a sphere */
 	if (!use_spheroid)
@@ -227,53 +349,39 @@ double geography_perimeter(GSERIALIZED *g, bool use_spheroid) {
 		return 0.0;
 	}
 
-	/* Clean up, but not all the way to the point arrays */
-	lwgeom_free(lwgeom);
-
 	return length;
 }
 
 /*
-** geography_azimuth(GSERIALIZED *g1, GSERIALIZED *g2)
+** geography_azimuth(LWGEOM *lwgeom1, LWGEOM *lwgeom2)
 ** returns direction between points (north = 0)
 ** azimuth (bearing) and distance
 */
-double geography_azimuth(GSERIALIZED *g1, GSERIALIZED *g2) {
-	LWGEOM *lwgeom1 = NULL;
-	LWGEOM *lwgeom2 = NULL;
+double geography_azimuth(LWGEOM *lwgeom1, LWGEOM *lwgeom2) {
 	double azimuth;
 	SPHEROID s;
 	uint32_t type1, type2;
 
 	/* Only return for points. */
-	type1 = gserialized_get_type(g1);
-	type2 = gserialized_get_type(g2);
+	type1 = lwgeom1->type;
+	type2 = lwgeom2->type;
 	if (type1 != POINTTYPE || type2 != POINTTYPE) {
 		// throw "ST_Azimuth(geography, geography) is only valid for point inputs";
 		return std::numeric_limits<double>::quiet_NaN();
 	}
 
-	lwgeom1 = lwgeom_from_gserialized(g1);
-	lwgeom2 = lwgeom_from_gserialized(g2);
-
 	/* EMPTY things cannot be used */
 	if (lwgeom_is_empty(lwgeom1) || lwgeom_is_empty(lwgeom2)) {
-		lwgeom_free(lwgeom1);
-		lwgeom_free(lwgeom2);
 		// throw "ST_Azimuth(geography, geography) cannot work with empty points";
 		return std::numeric_limits<double>::quiet_NaN();
 	}
 
 	/* Initialize spheroid */
-	spheroid_init_from_srid(gserialized_get_srid(g1), &s);
+	spheroid_init_from_srid(lwgeom1->srid, &s);
 
 	/* Calculate the direction */
 	azimuth = lwgeom_azumith_spheroid(lwgeom_as_lwpoint(lwgeom1), lwgeom_as_lwpoint(lwgeom2), &s);
 
-	/* Clean up */
-	lwgeom_free(lwgeom1);
-	lwgeom_free(lwgeom2);
-
 	/* Return NULL for unknown (same point) azimuth */
 	if (isnan(azimuth)) {
 		return std::numeric_limits<double>::quiet_NaN();
@@ -283,25 +391,45 @@ double geography_azimuth(GSERIALIZED *g1, GSERIALIZED *g2) {
 }
 
 /*
-** geography_length(GSERIALIZED *g)
+** geography_point_azimuth(POINT2D *pt1, POINT2D *pt2, int32_t srid)
+** returns the azimuth in radians between two non-empty points of one srid,
+** NaN for the same point, the same as geography_azimuth
+*/
+double geography_point_azimuth(const POINT2D *pt1, const POINT2D *pt2, int32_t srid) {
+	GEOGRAPHIC_POINT g1, g2;
+	double azimuth;
+	SPHEROID s;
+
+	/* Initialize spheroid */
+	spheroid_init_from_srid(srid, &s);
+
+	/* Same point, return NaN */
+	if (FP_EQUALS(pt1->x, pt2->x) && FP_EQUALS(pt1->y, pt2->y)) {
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+
+	/* Calculate the direction, as lwgeom_azumith_spheroid does */
+	geographic_point_init(pt1->x, pt1->y, &g1);
+	geographic_point_init(pt2->x, pt2->y, &g2);
+	azimuth = spheroid_direction(&g1, &g2, &s);
+	return azimuth > 0 ? azimuth : M_PI - azimuth;
+}
+
+/*
+** geography_length(LWGEOM *lwgeom)
 ** returns double length in meters
 */
-double geography_length(GSERIALIZED *g, bool use_spheroid) {
-	LWGEOM *lwgeom = NULL;
+double geography_length(LWGEOM *lwgeom, bool use_spheroid) {
 	double length;
 	SPHEROID s;
 
-	/* Get our geometry object loaded into memory. */
-	lwgeom = lwgeom_from_gserialized(g);
-
 	/* EMPTY things have no length */
 	if (lwgeom_is_empty(lwgeom) || lwgeom->type == POLYGONTYPE || lwgeom->type == MULTIPOLYGONTYPE) {
-		lwgeom_free(lwgeom);
 		return 0.0;
 	}
 
 	/* Initialize spheroid */
-	spheroid_init_from_srid(gserialized_get_srid(g), &s);
+	spheroid_init_from_srid(lwgeom->srid, &s);
 
 	/* User requests spherical calculation, turn our spheroid into a sphere */
 	if (!use_spheroid)
@@ -316,9 +444,6 @@ double geography_length(GSERIALIZED *g, bool use_spheroid) {
 		return 0.0;
 	}
 
-	/* Clean up */
-	lwgeom_free(lwgeom);
-
 	return length;
 }
 
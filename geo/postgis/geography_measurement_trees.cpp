@@ -26,11 +26,35 @@
 
 #include "liblwgeom/gserialized.hpp"
 #include "liblwgeom/lwgeodetic_tree.hpp"
+#include "liblwgeom/lwinline.hpp"
 
 namespace duckdb {
 
-static int CircTreePIP(const CIRC_NODE *tree1, const GSERIALIZED *g1, const POINT4D *in_point) {
-	int tree1_type = gserialized_get_type(g1);
+CircTreeGeomCache::CircTreeGeomCache() : index(NULL) {
+}
+
+CircTreeGeomCache::~CircTreeGeomCache() {
+	Clear();
+}
+
+bool CircTreeGeomCache::BuildIndex() {
+	index = lwgeom_calculate_circ_tree(lwgeom);
+	if (index && (lwgeom->type == POLYGONTYPE || lwgeom->type == MULTIPOLYGONTYPE)) {
+		lwgeom_calculate_gbox_geodetic(lwgeom, &gbox);
+	}
+	return index != NULL;
+}
+
+void CircTreeGeomCache::FreeIndex() {
+	if (index) {
+		circ_tree_free(index);
+		index = NULL;
+	}
+}
+
+static int CircTreePIP(const CIRC_NODE *tree1, const LWGEOM *lwgeom1, const GBOX *cached_gbox,
+                       const POINT4D *in_point) {
+	int tree1_type = lwgeom1->type;
 	GBOX gbox1;
 	GEOGRAPHIC_POINT in_gpoint;
 	POINT3D in_point3d;
@@ -38,12 +62,11 @@ static int CircTreePIP(const CIRC_NODE *tree1, const GSERIALIZED *g1, const POIN
 	/* If the tree'ed argument is a polygon, do the P-i-P using the tree-based P-i-P */
 	if (tree1_type == POLYGONTYPE || tree1_type == MULTIPOLYGONTYPE) {
 		/* Need a gbox to calculate an outside point */
-		if (LW_FAILURE == gserialized_get_gbox_p(g1, &gbox1)) {
-			LWGEOM *lwgeom1 = lwgeom_from_gserialized(g1);
+		if (cached_gbox) {
+			gbox1 = *cached_gbox;
+		} else {
 			lwgeom_calculate_gbox_geodetic(lwgeom1, &gbox1);
-			lwgeom_free(lwgeom1);
 		}
-
 		/* Flip the candidate point into geographics */
 		geographic_point_init(in_point->x, in_point->y, &in_gpoint);
 		geog2cart(&in_gpoint, &in_point3d);
@@ -70,57 +93,49 @@ static int CircTreePIP(const CIRC_NODE *tree1, const GSERIALIZED *g1, const POIN
 	}
 }
 
-int geography_tree_distance(const GSERIALIZED *g1, const GSERIALIZED *g2, const SPHEROID *s, double tolerance,
-                            double *distance) {
-	CIRC_NODE *circ_tree1 = NULL;
-	CIRC_NODE *circ_tree2 = NULL;
-	LWGEOM *lwgeom1 = NULL;
-	LWGEOM *lwgeom2 = NULL;
+int geography_tree_distance(const LWGEOM *lwgeom1, const LWGEOM *lwgeom2, const SPHEROID *s, double tolerance,
+                            double *distance, const CircTreeGeomCache *cache) {
+	int cached = cache ? cache->argnum : 0;
+	const GBOX *gbox1 = cached == 1 ? &cache->gbox : NULL;
+	const GBOX *gbox2 = cached == 2 ? &cache->gbox : NULL;
+	CIRC_NODE *circ_tree1 = cached == 1 ? cache->index : lwgeom_calculate_circ_tree(lwgeom1);
+	CIRC_NODE *circ_tree2 = cached == 2 ? cache->index : lwgeom_calculate_circ_tree(lwgeom2);
 	POINT4D pt1, pt2;
 
-	lwgeom1 = lwgeom_from_gserialized(g1);
-	lwgeom2 = lwgeom_from_gserialized(g2);
-	circ_tree1 = lwgeom_calculate_circ_tree(lwgeom1);
-	circ_tree2 = lwgeom_calculate_circ_tree(lwgeom2);
 	lwgeom_startpoint(lwgeom1, &pt1);
 	lwgeom_startpoint(lwgeom2, &pt2);
 
-	if (CircTreePIP(circ_tree1, g1, &pt2) || CircTreePIP(circ_tree2, g2, &pt1)) {
+	if (CircTreePIP(circ_tree1, lwgeom1, gbox1, &pt2) || CircTreePIP(circ_tree2, lwgeom2, gbox2, &pt1)) {
 		*distance = 0.0;
 	} else {
 		/* Calculate tree/tree distance */
 		*distance = circ_tree_distance_tree(circ_tree1, circ_tree2, s, tolerance);
 	}
 
-	circ_tree_free(circ_tree1);
-	circ_tree_free(circ_tree2);
-	lwgeom_free(lwgeom1);
-	lwgeom_free(lwgeom2);
+	if (cached != 1) {
+		circ_tree_free(circ_tree1);
+	}
+	if (cached != 2) {
+		circ_tree_free(circ_tree2);
+	}
 	return LW_SUCCESS;
 }
 
-int geography_tree_maxdistance(const GSERIALIZED *g1, const GSERIALIZED *g2, const SPHEROID *s, double tolerance,
-                               double *maxdistance) {
-	CIRC_NODE *circ_tree1 = NULL;
-	CIRC_NODE *circ_tree2 = NULL;
-	LWGEOM *lwgeom1 = NULL;
-	LWGEOM *lwgeom2 = NULL;
-	POINT4D pt1, pt2;
-
-	lwgeom1 = lwgeom_from_gserialized(g1);
-	lwgeom2 = lwgeom_from_gserialized(g2);
-	circ_tree1 = lwgeom_calculate_circ_tree(lwgeom1);
-	circ_tree2 = lwgeom_calculate_circ_tree(lwgeom2);
-	lwgeom_startpoint(lwgeom1, &pt1);
-	lwgeom_startpoint(lwgeom2, &pt2);
+int geography_tree_maxdistance(const LWGEOM *lwgeom1, const LWGEOM *lwgeom2, const SPHEROID *s, double tolerance,
+                               double *maxdistance, const CircTreeGeomCache *cache) {
+	int cached = cache ? cache->argnum : 0;
+	CIRC_NODE *circ_tree1 = cached == 1 ? cache->index : lwgeom_calculate_circ_tree(lwgeom1);
+	CIRC_NODE *circ_tree2 = cached == 2 ? cache->index : lwgeom_calculate_circ_tree(lwgeom2);
 
 	/* Calculate tree/tree maxdistance */
 	*maxdistance = circ_tree_maxdistance_tree(circ_tree1, circ_tree2, s, tolerance);
 
-	circ_tree_free(circ_tree1);
-	circ_tree_free(circ_tree2);
-	lwgeom_free(lwgeom1);
-	lwgeom_free(lwgeom2);
+	if (cached != 1) {
+		circ_tree_free(circ_tree1);
+	}
+	if (cached != 2) {
+		circ_tree_free(circ_tree2);
+	}
 	return LW_SUCCESS;
 }
 
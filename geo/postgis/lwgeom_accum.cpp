@@ -0,0 +1,179 @@
+/**********************************************************************
+ *
+ * PostGIS - Spatial Types for PostgreSQL
+ * http://postgis.net
+ *
+ * PostGIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * PostGIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PostGIS.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ *
+ * Copyright 2009 Paul Ramsey <pramsey@opengeo.org>
+ *
+ **********************************************************************/
+
+#include "postgis/lwgeom_accum.hpp"
+
+#include "liblwgeom/liblwgeom_internal.hpp"
+#include "liblwgeom/lwinline.hpp"
+
+namespace duckdb {
+
+CollectAccumulator::CollectAccumulator() : collection(NULL), common_type(0) {
+}
+
+CollectAccumulator::~CollectAccumulator() {
+	if (collection)
+		lwcollection_free(collection);
+}
+
+void CollectAccumulator::Add(LWGEOM *geom) {
+	if (!collection) {
+		collection = lwcollection_construct_empty(COLLECTIONTYPE, geom->srid, FLAGS_GET_Z(geom->flags),
+		                                          FLAGS_GET_M(geom->flags));
+		common_type = geom->type;
+	} else if (geom->srid != collection->srid) {
+		lwgeom_free(geom);
+		lwerror("ST_Collect: Operation on mixed SRID geometries");
+	} else if (geom->type != common_type) {
+		common_type = COLLECTIONTYPE;
+	}
+
+	/* The type of the collection is only settled by Finish, so don't check the subtype */
+	lwcollection_reserve(collection, collection->ngeoms + 1);
+	collection->geoms[collection->ngeoms++] = geom;
+}
+
+void CollectAccumulator::Merge(const CollectAccumulator &other) {
+	if (!other.collection)
+		return;
+	if (!collection) {
+		collection = lwcollection_construct_empty(COLLECTIONTYPE, other.collection->srid,
+		                                          FLAGS_GET_Z(other.collection->flags),
+		                                          FLAGS_GET_M(other.collection->flags));
+		common_type = other.common_type;
+	} else if (other.collection->srid != collection->srid) {
+		lwerror("ST_Collect: Operation on mixed SRID geometries");
+	} else if (other.common_type != common_type) {
+		common_type = COLLECTIONTYPE;
+	}
+
+	/* The other accumulator may be merged again (window segment trees), so its geometries are copied */
+	lwcollection_reserve(collection, collection->ngeoms + other.collection->ngeoms);
+	for (uint32_t i = 0; i < other.collection->ngeoms; i++)
+		collection->geoms[collection->ngeoms++] = lwgeom_clone_deep(other.collection->geoms[i]);
+}
+
+const LWGEOM *CollectAccumulator::Finish() {
+	if (!collection)
+		return NULL;
+
+	/* Homogeneous inputs make a MULTI of their type, like LWGEOM_collect_garray */
+	collection->type = common_type == COLLECTIONTYPE ? COLLECTIONTYPE : lwtype_get_collectiontype(common_type);
+	return (const LWGEOM *)collection;
+}
+
+MakeLineAccumulator::MakeLineAccumulator() : line(NULL), starts_with_line(false) {
+}
+
+MakeLineAccumulator::~MakeLineAccumulator() {
+	if (line)
+		lwline_free(line);
+}
+
+void MakeLineAccumulator::Start(const LWGEOM *geom) {
+	if (!line) {
+		line = lwline_construct_empty(geom->srid, FLAGS_GET_Z(geom->flags), FLAGS_GET_M(geom->flags));
+		return;
+	}
+	if (geom->srid != line->srid)
+		lwerror("ST_MakeLine: Operation on mixed SRID geometries");
+
+	/* The line has every dimension of any of its inputs */
+	ForceDims(FLAGS_GET_Z(line->flags) || FLAGS_GET_Z(geom->flags),
+	          FLAGS_GET_M(line->flags) || FLAGS_GET_M(geom->flags));
+}
+
+void MakeLineAccumulator::ForceDims(int hasz, int hasm) {
+	if (hasz == FLAGS_GET_Z(line->flags) && hasm == FLAGS_GET_M(line->flags))
+		return;
+
+	POINTARRAY *points = ptarray_force_dims(line->points, hasz, hasm, 0, 0);
+	ptarray_free(line->points);
+	line->points = points;
+	FLAGS_SET_Z(line->flags, hasz);
+	FLAGS_SET_M(line->flags, hasm);
+}
+
+void MakeLineAccumulator::Append(POINTARRAY *points, bool skip_repeated_start) {
+	POINTARRAY *pa = points;
+	POINT4D pt;
+
+	if (FLAGS_GET_ZM(pa->flags) != FLAGS_GET_ZM(line->points->flags))
+		pa = ptarray_force_dims(points, FLAGS_GET_Z(line->flags), FLAGS_GET_M(line->flags), 0, 0);
+
+	if (skip_repeated_start) {
+		ptarray_append_ptarray(line->points, pa, -1);
+	} else {
+		for (uint32_t i = 0; i < pa->npoints; i++) {
+			getPoint4d_p(pa, i, &pt);
+			ptarray_append_point(line->points, &pt, LW_TRUE);
+		}
+	}
+
+	if (pa != points)
+		ptarray_free(pa);
+}
+
+void MakeLineAccumulator::Add(const LWGEOM *geom) {
+	POINT4D pt;
+
+	if (geom->type != POINTTYPE && geom->type != LINETYPE && geom->type != MULTIPOINTTYPE)
+		return;
+
+	Start(geom);
+	if (lwgeom_is_empty(geom))
+		return;
+	if (line->points->npoints == 0)
+		starts_with_line = geom->type == LINETYPE;
+
+	if (geom->type == POINTTYPE) {
+		lwpoint_getPoint4d_p((const LWPOINT *)geom, &pt);
+		ptarray_append_point(line->points, &pt, LW_TRUE);
+	} else if (geom->type == LINETYPE) {
+		/* Like lwline_from_lwgeom_array, a line doesn't repeat the point it starts from */
+		Append(((const LWLINE *)geom)->points, true);
+	} else {
+		LWPOINTITERATOR *it = lwpointiterator_create(geom);
+		while (lwpointiterator_next(it, &pt))
+			ptarray_append_point(line->points, &pt, LW_TRUE);
+		lwpointiterator_destroy(it);
+	}
+}
+
+void MakeLineAccumulator::Merge(const MakeLineAccumulator &other) {
+	if (!other.line)
+		return;
+
+	/* The points of the other line are copied, it may be merged again (window segment trees) */
+	Start((const LWGEOM *)other.line);
+	if (line->points->npoints == 0)
+		starts_with_line = other.starts_with_line;
+	Append(other.line->points, other.starts_with_line);
+}
+
+const LWGEOM *MakeLineAccumulator::Finish() {
+	return (const LWGEOM *)line;
+}
+
+} // namespace duckdb
@@ -72,6 +72,14 @@ GSERIALIZED *LWGEOM_simplify2d(GSERIALIZED *geom, double dist) {
 	return result;
 }
 
+/*
+ * The same simplification, in place on a line or polygon already built from
+ * its coordinates. A collapsed line or polygon is left empty.
+ */
+void LWGEOM_simplify2d(LWGEOM *geom, double dist) {
+	lwgeom_simplify_in_place(geom, dist, LW_FALSE);
+}
+
 GSERIALIZED *LWGEOM_snaptogrid(GSERIALIZED *in_geom, double ipx, double ipy, double xsize, double ysize) {
 	LWGEOM *in_lwgeom;
 	GSERIALIZED *out_geom = NULL;
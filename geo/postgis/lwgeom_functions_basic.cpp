@@ -178,17 +178,12 @@ GSERIALIZED *LWGEOM_makepoly(GSERIALIZED *pglwg1, GSERIALIZED *gserArray[], int
 	return result;
 }
 
-double ST_distance(GSERIALIZED *geom1, GSERIALIZED *geom2) {
+double ST_distance(LWGEOM *lwgeom1, LWGEOM *lwgeom2) {
 	double mindist;
-	LWGEOM *lwgeom1 = lwgeom_from_gserialized(geom1);
-	LWGEOM *lwgeom2 = lwgeom_from_gserialized(geom2);
-	gserialized_error_if_srid_mismatch(geom1, geom2, __func__);
+	lwgeom_error_if_srid_mismatch(lwgeom1, lwgeom2, __func__);
 
 	mindist = lwgeom_mindistance2d(lwgeom1, lwgeom2);
 
-	lwgeom_free(lwgeom1);
-	lwgeom_free(lwgeom2);
-
 	/* if called with empty geometries the ingoing mindistance is untouched, and makes us return NULL*/
 	if (mindist < FLT_MAX)
 		return mindist;
@@ -215,24 +210,34 @@ lwvarlena_t *ST_GeoHash(GSERIALIZED *geom, size_t m_chars) {
 	return nullptr;
 }
 
-bool ST_IsCollection(GSERIALIZED *geom) {
-	int type = gserialized_get_type(geom);
-	return lwtype_is_collection(type);
-}
+/**
+ * ST_GeoHash of a lone point given by its coordinates, without building it
+ */
+std::string ST_GeoHashPoint(double x, double y, int m_chars) {
+	/* Return error if we are being fed something outside our working bounds */
+	if (x < -180 || y < -90 || x > 180 || y > 90) {
+		lwerror("Geohash requires inputs in decimal degrees, got (%g %g, %g %g).", x, y, x, y);
+		return std::string();
+	}
 
-bool LWGEOM_isempty(GSERIALIZED *geom) {
-	return gserialized_is_empty(geom);
+	/* The precision lwgeom_geohash_precision gives a point */
+	lwvarlena_t *geohash = geohash_point(x, y, m_chars > 0 ? m_chars : 20);
+	std::string output(geohash->data, LWSIZE_GET(geohash->size) - LWVARHDRSZ);
+	lwfree(geohash);
+	return output;
 }
 
-/** number of points in an object */
-int LWGEOM_npoints(GSERIALIZED *geom) {
-	LWGEOM *lwgeom = lwgeom_from_gserialized(geom);
-	int npoints = 0;
+bool ST_IsCollection(LWGEOM *lwgeom) {
+	return lwtype_is_collection(lwgeom->type);
+}
 
-	npoints = lwgeom_count_vertices(lwgeom);
-	lwgeom_free(lwgeom);
+bool LWGEOM_isempty(LWGEOM *lwgeom) {
+	return lwgeom_is_empty(lwgeom);
+}
 
-	return npoints;
+/** number of points in an object */
+int LWGEOM_npoints(LWGEOM *lwgeom) {
+	return lwgeom_count_vertices(lwgeom);
 }
 
 /**
@@ -263,17 +268,15 @@ Returns boolean describing if
 mininimum 2d distance between objects in
 geom1 and geom2 is shorter than tolerance
 */
-bool LWGEOM_dwithin(GSERIALIZED *geom1, GSERIALIZED *geom2, double tolerance) {
+bool LWGEOM_dwithin(LWGEOM *lwgeom1, LWGEOM *lwgeom2, double tolerance) {
 	double mindist;
-	LWGEOM *lwgeom1 = lwgeom_from_gserialized(geom1);
-	LWGEOM *lwgeom2 = lwgeom_from_gserialized(geom2);
 
 	if (tolerance < 0) {
 		throw "Tolerance cannot be less than zero\n";
 		return false;
 	}
 
-	gserialized_error_if_srid_mismatch(geom1, geom2, __func__);
+	lwgeom_error_if_srid_mismatch(lwgeom1, lwgeom2, __func__);
 
 	mindist = lwgeom_mindistance2d_tolerance(lwgeom1, lwgeom2, tolerance);
 
@@ -288,15 +291,8 @@ bool LWGEOM_dwithin(GSERIALIZED *geom1, GSERIALIZED *geom2, double tolerance) {
  * 		area (line) = 0
  * 		area(polygon) = find its 2d area
  */
-double ST_Area(GSERIALIZED *geom) {
-	LWGEOM *lwgeom = lwgeom_from_gserialized(geom);
-	double area = 0.0;
-
-	area = lwgeom_area(lwgeom);
-
-	lwgeom_free(lwgeom);
-
-	return area;
+double ST_Area(LWGEOM *lwgeom) {
+	return lwgeom_area(lwgeom);
 }
 
 double LWGEOM_angle(GSERIALIZED *geom1, GSERIALIZED *geom2) {
@@ -431,12 +427,8 @@ double LWGEOM_angle(std::vector<GSERIALIZED *> geom_vec) {
  *  	perimeter(polygon) = sum of ring perimeters
  *  	uses euclidian 2d computation even if input is 3d
  */
-double LWGEOM_perimeter2d_poly(GSERIALIZED *geom) {
-	LWGEOM *lwgeom = lwgeom_from_gserialized(geom);
-	double perimeter = 0.0;
-
-	perimeter = lwgeom_perimeter_2d(lwgeom);
-	return perimeter;
+double LWGEOM_perimeter2d_poly(LWGEOM *lwgeom) {
+	return lwgeom_perimeter_2d(lwgeom);
 }
 
 /**
@@ -445,16 +437,14 @@ double LWGEOM_perimeter2d_poly(GSERIALIZED *geom) {
  * @return NULL on exception (same point).
  * 		Return radians otherwise.
  */
-double LWGEOM_azimuth(GSERIALIZED *geom1, GSERIALIZED *geom2) {
-	GSERIALIZED *geom;
+double LWGEOM_azimuth(LWGEOM *lwgeom1, LWGEOM *lwgeom2) {
 	LWPOINT *lwpoint;
 	POINT2D p1, p2;
 	double result;
 	int32_t srid;
 
 	/* Extract first point */
-	geom = geom1;
-	lwpoint = lwgeom_as_lwpoint(lwgeom_from_gserialized(geom));
+	lwpoint = lwgeom_as_lwpoint(lwgeom1);
 	if (!lwpoint) {
 		throw "Argument must be POINT geometries";
 		return 0.0;
@@ -464,11 +454,9 @@ double LWGEOM_azimuth(GSERIALIZED *geom1, GSERIALIZED *geom2) {
 		throw "Error extracting point";
 		throw 0.0;
 	}
-	lwpoint_free(lwpoint);
 
 	/* Extract second point */
-	geom = geom2;
-	lwpoint = lwgeom_as_lwpoint(lwgeom_from_gserialized(geom));
+	lwpoint = lwgeom_as_lwpoint(lwgeom2);
 	if (!lwpoint) {
 		throw "Argument must be POINT geometries";
 		return 0.0;
@@ -481,7 +469,6 @@ double LWGEOM_azimuth(GSERIALIZED *geom1, GSERIALIZED *geom2) {
 		throw "Error extracting point";
 		return 0.0;
 	}
-	lwpoint_free(lwpoint);
 
 	/* Standard return value for equality case */
 	if ((p1.x == p2.x) && (p1.y == p2.y)) {
@@ -503,11 +490,8 @@ double LWGEOM_azimuth(GSERIALIZED *geom1, GSERIALIZED *geom2) {
  *  	length2d(polygon) = 0  -- could make sense to return sum(ring perimeter)
  *  	uses euclidian 2d length (even if input is 3d)
  */
-double LWGEOM_length2d_linestring(GSERIALIZED *geom) {
-	LWGEOM *lwgeom = lwgeom_from_gserialized(geom);
-	double dist = lwgeom_length_2d(lwgeom);
-	lwgeom_free(lwgeom);
-	return dist;
+double LWGEOM_length2d_linestring(LWGEOM *lwgeom) {
+	return lwgeom_length_2d(lwgeom);
 }
 
 /**
@@ -518,9 +502,7 @@ double LWGEOM_length2d_linestring(GSERIALIZED *geom) {
 GSERIALIZED *LWGEOM_envelope(GSERIALIZED *geom) {
 	LWGEOM *lwgeom = lwgeom_from_gserialized(geom);
 	int32_t srid = lwgeom->srid;
-	POINT4D pt;
 	GBOX box;
-	POINTARRAY *pa;
 	GSERIALIZED *result;
 
 	if (lwgeom_is_empty(lwgeom)) {
@@ -533,6 +515,22 @@ GSERIALIZED *LWGEOM_envelope(GSERIALIZED *geom) {
 		return geom;
 	}
 
+	LWGEOM *envelope = LWGEOM_envelope_gbox(&box, srid);
+	result = geometry_serialize(envelope);
+	lwgeom_free(envelope);
+
+	return result;
+}
+
+/**
+ *  the envelope geometry of a 2d box, shared by ST_Envelope and the
+ *  extent aggregate which only keeps the box of its input
+ */
+LWGEOM *LWGEOM_envelope_gbox(const GBOX *gbox, int32_t srid) {
+	GBOX box = *gbox;
+	POINT4D pt;
+	POINTARRAY *pa;
+
 	/*
 	 * Alter envelope type so that a valid geometry is always
 	 * returned depending upon the size of the geometry. The
@@ -545,12 +543,9 @@ GSERIALIZED *LWGEOM_envelope(GSERIALIZED *geom) {
 	 */
 
 	if ((box.xmin == box.xmax) && (box.ymin == box.ymax)) {
-		/* Construct and serialize point */
-		LWPOINT *point = lwpoint_make2d(srid, box.xmin, box.ymin);
-		result = geometry_serialize(lwpoint_as_lwgeom(point));
-		lwpoint_free(point);
+		/* Construct point */
+		return lwpoint_as_lwgeom(lwpoint_make2d(srid, box.xmin, box.ymin));
 	} else if ((box.xmin == box.xmax) || (box.ymin == box.ymax)) {
-		LWLINE *line;
 		/* Construct point array */
 		pa = ptarray_construct_empty(0, 0, 2);
 
@@ -562,12 +557,9 @@ GSERIALIZED *LWGEOM_envelope(GSERIALIZED *geom) {
 		pt.y = box.ymax;
 		ptarray_append_point(pa, &pt, LW_TRUE);
 
-		/* Construct and serialize linestring */
-		line = lwline_construct(srid, NULL, pa);
-		result = geometry_serialize(lwline_as_lwgeom(line));
-		lwline_free(line);
+		/* Construct linestring */
+		return lwline_as_lwgeom(lwline_construct(srid, NULL, pa));
 	} else {
-		LWPOLY *poly;
 		POINTARRAY **ppa = (POINTARRAY **)lwalloc(sizeof(POINTARRAY *));
 		pa = ptarray_construct_empty(0, 0, 5);
 		ppa[0] = pa;
@@ -590,22 +582,16 @@ GSERIALIZED *LWGEOM_envelope(GSERIALIZED *geom) {
 		ptarray_append_point(pa, &pt, LW_TRUE);
 
 		/* Construct polygon  */
-		poly = lwpoly_construct(srid, NULL, 1, ppa);
-		result = geometry_serialize(lwpoly_as_lwgeom(poly));
-		lwpoly_free(poly);
+		return lwpoly_as_lwgeom(lwpoly_construct(srid, NULL, 1, ppa));
 	}
-
-	return result;
 }
 
 /**
  Maximum 2d distance between objects in geom1 and geom2.
  */
-double LWGEOM_maxdistance2d_linestring(GSERIALIZED *geom1, GSERIALIZED *geom2) {
+double LWGEOM_maxdistance2d_linestring(LWGEOM *lwgeom1, LWGEOM *lwgeom2) {
 	double maxdist;
-	LWGEOM *lwgeom1 = lwgeom_from_gserialized(geom1);
-	LWGEOM *lwgeom2 = lwgeom_from_gserialized(geom2);
-	gserialized_error_if_srid_mismatch(geom1, geom2, __func__);
+	lwgeom_error_if_srid_mismatch(lwgeom1, lwgeom2, __func__);
 
 	maxdist = lwgeom_maxdistance2d(lwgeom1, lwgeom2);
 
@@ -32,6 +32,7 @@
 #include "liblwgeom/lwgeom_geos.hpp"
 #include "liblwgeom/lwinline.hpp"
 #include "libpgcommon/lwgeom_pg.hpp"
+#include "postgis/lwgeom_geos_prepared.hpp"
 #include "postgis/lwgeom_functions_analytic.hpp" /* for point_in_polygon */
 
 namespace duckdb {
@@ -86,17 +87,17 @@ GSERIALIZED *centroid(GSERIALIZED *geom) {
 	return result;
 }
 
-bool LWGEOM_isring(GSERIALIZED *geom) {
+bool LWGEOM_isring(LWGEOM *geom) {
 	GEOSGeometry *g1;
 	int result;
 
 	/* Empty things can't close */
-	if (gserialized_is_empty(geom))
+	if (lwgeom_is_empty(geom))
 		return false;
 
 	initGEOS(lwnotice, lwgeom_geos_error);
 
-	g1 = POSTGIS2GEOS(geom);
+	g1 = LWGEOM2GEOS(geom, 0);
 	if (!g1)
 		throw "First argument geometry could not be converted to GEOS";
 
@@ -287,6 +288,153 @@ GSERIALIZED *pgis_union_geometry_array(GSERIALIZED *gserArray[], int nelems) {
 	return gser_out;
 }
 
+/* Inputs unioned at once by CascadedUnion before the result joins the partials */
+#define CASCADED_UNION_BATCH_SIZE 1024
+
+CascadedUnion::CascadedUnion() : has_input(false), srid(SRID_UNKNOWN), is3d(LW_FALSE), empty_type(0) {
+}
+
+CascadedUnion::~CascadedUnion() {
+	for (auto geom : buffer)
+		GEOSGeom_destroy(geom);
+	for (auto geom : partials) {
+		if (geom)
+			GEOSGeom_destroy(geom);
+	}
+}
+
+void CascadedUnion::Add(const LWGEOM *geom) {
+	if (!has_input) {
+		srid = geom->srid;
+		is3d = FLAGS_GET_Z(geom->flags);
+		has_input = true;
+	} else if (geom->srid != srid) {
+		lwerror("ST_Union: Operation on mixed SRID geometries");
+	}
+
+	/* Don't include empties in the union */
+	if (lwgeom_is_empty(geom)) {
+		if (geom->type > empty_type)
+			empty_type = geom->type;
+		return;
+	}
+
+	initGEOS(lwnotice, lwgeom_geos_error);
+	GEOSGeometry *g = LWGEOM2GEOS(geom, 0);
+	if (!g)
+		lwerror("ST_Union: One of the geometries in the set could not be converted to GEOS");
+	buffer.push_back(g);
+	if (buffer.size() >= CASCADED_UNION_BATCH_SIZE)
+		Flush();
+}
+
+void CascadedUnion::Flush() {
+	if (buffer.empty())
+		return;
+
+	initGEOS(lwnotice, lwgeom_geos_error);
+	/* The collection owns the buffered geometries from here on */
+	GEOSGeometry *g = GEOSGeom_createCollection(GEOS_GEOMETRYCOLLECTION, buffer.data(), buffer.size());
+	buffer.clear();
+	if (!g)
+		lwerror("ST_Union: Could not create GEOS COLLECTION from geometry array");
+
+	GEOSGeometry *g_union = GEOSUnaryUnion(g);
+	GEOSGeom_destroy(g);
+	if (!g_union)
+		lwerror("ST_Union: GEOSUnaryUnion failed");
+	Carry(g_union, 0);
+}
+
+void CascadedUnion::Carry(GEOSGeometry *geom, size_t level) {
+	/* Union with the partial of the same order until a free slot is found */
+	for (; level < partials.size() && partials[level]; level++) {
+		GEOSGeometry *g_union = GEOSUnion(partials[level], geom);
+		GEOSGeom_destroy(partials[level]);
+		GEOSGeom_destroy(geom);
+		partials[level] = NULL;
+		if (!g_union)
+			lwerror("ST_Union: GEOSUnion failed");
+		geom = g_union;
+	}
+	/* Merge carries in at the level of the other union, which may be above ours */
+	if (level >= partials.size())
+		partials.resize(level + 1, NULL);
+	partials[level] = geom;
+}
+
+void CascadedUnion::Merge(const CascadedUnion &other) {
+	if (!other.has_input)
+		return;
+	if (!has_input) {
+		srid = other.srid;
+		is3d = other.is3d;
+		has_input = true;
+	} else if (other.srid != srid) {
+		lwerror("ST_Union: Operation on mixed SRID geometries");
+	}
+	if (other.empty_type > empty_type)
+		empty_type = other.empty_type;
+
+	/* The other union may be merged again (the window segment trees combine their nodes into every frame) */
+	initGEOS(lwnotice, lwgeom_geos_error);
+	for (size_t level = 0; level < other.partials.size(); level++) {
+		if (other.partials[level]) {
+			GEOSGeometry *geom = GEOSGeom_clone(other.partials[level]);
+			if (!geom)
+				lwerror("ST_Union: GEOSGeom_clone failed");
+			Carry(geom, level);
+		}
+	}
+	for (auto geom : other.buffer) {
+		GEOSGeometry *g = GEOSGeom_clone(geom);
+		if (!g)
+			lwerror("ST_Union: GEOSGeom_clone failed");
+		buffer.push_back(g);
+		if (buffer.size() >= CASCADED_UNION_BATCH_SIZE)
+			Flush();
+	}
+}
+
+LWGEOM *CascadedUnion::Finish() {
+	if (!has_input)
+		return NULL;
+
+	/* Union what is left of the buffer, then all partials at once */
+	Flush();
+	std::vector<GEOSGeometry *> geoms;
+	for (size_t level = 0; level < partials.size(); level++) {
+		if (partials[level])
+			geoms.push_back(partials[level]);
+		partials[level] = NULL;
+	}
+
+	/* If it was only empties, we'll return the largest type number */
+	if (geoms.empty())
+		return lwgeom_construct_empty(empty_type, srid, is3d, 0);
+
+	GEOSGeometry *g_union;
+	if (geoms.size() == 1) {
+		g_union = geoms[0];
+	} else {
+		initGEOS(lwnotice, lwgeom_geos_error);
+		GEOSGeometry *g = GEOSGeom_createCollection(GEOS_GEOMETRYCOLLECTION, geoms.data(), geoms.size());
+		if (!g)
+			lwerror("ST_Union: Could not create GEOS COLLECTION from geometry array");
+		g_union = GEOSUnaryUnion(g);
+		GEOSGeom_destroy(g);
+		if (!g_union)
+			lwerror("ST_Union: GEOSUnaryUnion failed");
+	}
+
+	LWGEOM *result = GEOS2LWGEOM(g_union, is3d);
+	GEOSGeom_destroy(g_union);
+	if (!result)
+		lwerror("ST_Union: GEOS2LWGEOM returned NULL");
+	lwgeom_set_srid(result, srid);
+	return result;
+}
+
 GSERIALIZED *ST_Intersection(GSERIALIZED *geom1, GSERIALIZED *geom2) {
 	GSERIALIZED *result;
 	LWGEOM *lwgeom1, *lwgeom2, *lwresult;
@@ -510,43 +658,44 @@ GSERIALIZED *buffer(GSERIALIZED *geom1, double size, string styles_text) {
 	return result;
 }
 
-bool ST_Equals(GSERIALIZED *geom1, GSERIALIZED *geom2) {
+/* Bounding box of a geometry, taken from its cached box when it has one */
+static int lwgeom_get_gbox_p(const LWGEOM *lwgeom, GBOX *gbox) {
+	if (lwgeom->bbox) {
+		*gbox = *(lwgeom->bbox);
+		return LW_SUCCESS;
+	}
+	return lwgeom_calculate_gbox(lwgeom, gbox);
+}
+
+bool ST_Equals(LWGEOM *geom1, LWGEOM *geom2) {
 	GEOSGeometry *g1, *g2;
 	char result;
 	GBOX box1, box2;
 
-	gserialized_error_if_srid_mismatch(geom1, geom2, __func__);
+	lwgeom_error_if_srid_mismatch(geom1, geom2, __func__);
 
 	/* Empty == Empty */
-	if (gserialized_is_empty(geom1) && gserialized_is_empty(geom2))
+	if (lwgeom_is_empty(geom1) && lwgeom_is_empty(geom2))
 		return true;
 
 	/*
 	 * short-circuit: If geom1 and geom2 do not have the same bounding box
 	 * we can return FALSE.
 	 */
-	if (gserialized_get_gbox_p(geom1, &box1) && gserialized_get_gbox_p(geom2, &box2)) {
+	if (lwgeom_get_gbox_p(geom1, &box1) && lwgeom_get_gbox_p(geom2, &box2)) {
 		if (gbox_same_2d_float(&box1, &box2) == LW_FALSE) {
 			return false;
 		}
 	}
 
-	/*
-	 * short-circuit: if geom1 and geom2 are binary-equivalent, we can return
-	 * TRUE.  This is much faster than doing the comparison using GEOS.
-	 */
-	if (VARSIZE(geom1) == VARSIZE(geom2) && !memcmp(geom1, geom2, VARSIZE(geom1))) {
-		return true;
-	}
-
 	initGEOS(lwnotice, lwgeom_geos_error);
 
-	g1 = POSTGIS2GEOS(geom1);
+	g1 = LWGEOM2GEOS(geom1, 0);
 
 	if (!g1)
 		throw "First argument geometry could not be converted to GEOS";
 
-	g2 = POSTGIS2GEOS(geom2);
+	g2 = LWGEOM2GEOS(geom2, 0);
 
 	if (!g2) {
 		GEOSGeom_destroy(g1);
@@ -564,69 +713,98 @@ bool ST_Equals(GSERIALIZED *geom1, GSERIALIZED *geom2) {
 	return result;
 }
 
-/* Utility function that checks a LWPOINT and a GSERIALIZED poly against a cache.
- * Serialized poly may be a multipart.
+/* Utility function that checks a LWPOINT against a LWGEOM poly.
+ * The poly may be a multipart.
  */
-static int pip_short_circuit(LWPOINT *point, const GSERIALIZED *gpoly) {
-	int result;
-
-	LWGEOM *poly = lwgeom_from_gserialized(gpoly);
+static int pip_short_circuit(LWPOINT *point, const LWGEOM *poly) {
 	if (lwgeom_get_type(poly) == POLYGONTYPE) {
-		result = point_in_polygon(lwgeom_as_lwpoly(poly), point);
+		return point_in_polygon(lwgeom_as_lwpoly(poly), point);
 	} else {
-		result = point_in_multipolygon(lwgeom_as_lwmpoly(poly), point);
+		return point_in_multipolygon(lwgeom_as_lwmpoly(poly), point);
 	}
-	lwgeom_free(poly);
-
-	return result;
 }
 
-static char is_poly(const GSERIALIZED *g) {
-	int type = gserialized_get_type(g);
+static char is_poly(const LWGEOM *g) {
+	int type = g->type;
 	return type == POLYGONTYPE || type == MULTIPOLYGONTYPE;
 }
 
-static char is_point(const GSERIALIZED *g) {
-	int type = gserialized_get_type(g);
+static char is_point(const LWGEOM *g) {
+	int type = g->type;
 	return type == POINTTYPE || type == MULTIPOINTTYPE;
 }
 
-bool contains(GSERIALIZED *geom1, GSERIALIZED *geom2) {
+typedef char (*PreparedPredicate)(const GEOSPreparedGeometry *, const GEOSGeometry *);
+
+/* Evaluate a predicate of a cached prepared geometry against the other argument */
+static bool prepared_predicate(PreparedPredicate predicate, const char *name, const GEOSPreparedGeometry *prepared,
+                               const LWGEOM *geom) {
+	char result;
+	GEOSGeometry *g;
+
+	initGEOS(lwnotice, lwgeom_geos_error);
+
+	g = LWGEOM2GEOS(geom, 0);
+	if (!g)
+		throw "Geometry could not be converted to GEOS";
+
+	result = predicate(prepared, g);
+	GEOSGeom_destroy(g);
+
+	if (result == 2)
+		throw name;
+
+	return result > 0;
+}
+
+/* The prepared form of the cached argument, when geom is that argument */
+static inline const GEOSPreparedGeometry *get_prepared(const PrepGeomCache *cache, const LWGEOM *geom) {
+	return cache ? cache->Prepared(geom) : NULL;
+}
+
+bool contains(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache) {
 	int result;
 	GEOSGeometry *g1, *g2;
 	GBOX box1, box2;
-	gserialized_error_if_srid_mismatch(geom1, geom2, __func__);
+	const GEOSPreparedGeometry *prepared;
+	lwgeom_error_if_srid_mismatch(geom1, geom2, __func__);
 
 	/* A.Contains(Empty) == FALSE */
-	if (gserialized_is_empty(geom1) || gserialized_is_empty(geom2))
+	if (lwgeom_is_empty(geom1) || lwgeom_is_empty(geom2))
 		return false;
 
 	/*
 	** short-circuit 1: if geom2 bounding box is not completely inside
 	** geom1 bounding box we can return FALSE.
 	*/
-	if (gserialized_get_gbox_p(geom1, &box1) && gserialized_get_gbox_p(geom2, &box2)) {
+	if (lwgeom_get_gbox_p(geom1, &box1) && lwgeom_get_gbox_p(geom2, &box2)) {
 		if (!gbox_contains_2d(&box1, &box2))
 			return false;
 	}
 
+	/*
+	** If geom1 is the constant argument of the query, use its prepared
+	** form, which indexes the polygon for the point-in-polygon tests too.
+	*/
+	prepared = get_prepared(cache, geom1);
+	if (prepared)
+		return prepared_predicate(GEOSPreparedContains, "GEOSPreparedContains", prepared, geom2);
+
 	/*
 	** short-circuit 2: if geom2 is a point and geom1 is a polygon
 	** call the point-in-polygon function.
 	*/
 	if (is_poly(geom1) && is_point(geom2)) {
-		const GSERIALIZED *gpoly = geom1;
-		const GSERIALIZED *gpoint = geom2;
+		const LWGEOM *gpoly = geom1;
+		const LWGEOM *gpoint = geom2;
 		int retval;
 
-		if (gserialized_get_type(gpoint) == POINTTYPE) {
-			LWGEOM *point = lwgeom_from_gserialized(gpoint);
-			int pip_result = pip_short_circuit(lwgeom_as_lwpoint(point), gpoly);
-			lwgeom_free(point);
+		if (gpoint->type == POINTTYPE) {
+			int pip_result = pip_short_circuit(lwgeom_as_lwpoint(gpoint), gpoly);
 
 			retval = (pip_result == 1); /* completely inside */
-		} else if (gserialized_get_type(gpoint) == MULTIPOINTTYPE) {
-			LWMPOINT *mpoint = lwgeom_as_lwmpoint(lwgeom_from_gserialized(gpoint));
+		} else if (gpoint->type == MULTIPOINTTYPE) {
+			LWMPOINT *mpoint = lwgeom_as_lwmpoint(gpoint);
 			uint32_t i;
 			int found_completely_inside = LW_FALSE;
 
@@ -649,7 +827,6 @@ bool contains(GSERIALIZED *geom1, GSERIALIZED *geom2) {
 			}
 
 			retval = retval && found_completely_inside;
-			lwmpoint_free(mpoint);
 		} else {
 			/* Never get here */
 			throw "Type isn't point or multipoint!";
@@ -659,12 +836,17 @@ bool contains(GSERIALIZED *geom1, GSERIALIZED *geom2) {
 		return retval > 0;
 	}
 
+	/* A.Contains(B) is B.Within(A) */
+	prepared = get_prepared(cache, geom2);
+	if (prepared)
+		return prepared_predicate(GEOSPreparedWithin, "GEOSPreparedWithin", prepared, geom1);
+
 	initGEOS(lwnotice, lwgeom_geos_error);
 
-	g1 = POSTGIS2GEOS(geom1);
+	g1 = LWGEOM2GEOS(geom1, 0);
 	if (!g1)
 		throw "First argument geometry could not be converted to GEOS";
-	g2 = POSTGIS2GEOS(geom2);
+	g2 = LWGEOM2GEOS(geom2, 0);
 	if (!g2) {
 		throw "Second argument geometry could not be converted to GEOS";
 		GEOSGeom_destroy(g1);
@@ -679,34 +861,41 @@ bool contains(GSERIALIZED *geom1, GSERIALIZED *geom2) {
 	return result > 0;
 }
 
-bool touches(GSERIALIZED *geom1, GSERIALIZED *geom2) {
+bool touches(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache) {
 	GEOSGeometry *g1, *g2;
 	char result;
 	GBOX box1, box2;
+	const GEOSPreparedGeometry *prepared;
 
-	gserialized_error_if_srid_mismatch(geom1, geom2, __func__);
+	lwgeom_error_if_srid_mismatch(geom1, geom2, __func__);
 
 	/* A.Touches(Empty) == FALSE */
-	if (gserialized_is_empty(geom1) || gserialized_is_empty(geom2))
+	if (lwgeom_is_empty(geom1) || lwgeom_is_empty(geom2))
 		return false;
 
 	/*
 	 * short-circuit 1: if geom2 bounding box does not overlap
 	 * geom1 bounding box we can return FALSE.
 	 */
-	if (gserialized_get_gbox_p(geom1, &box1) && gserialized_get_gbox_p(geom2, &box2)) {
+	if (lwgeom_get_gbox_p(geom1, &box1) && lwgeom_get_gbox_p(geom2, &box2)) {
 		if (gbox_overlaps_2d(&box1, &box2) == LW_FALSE) {
 			return false;
 		}
 	}
 
+	/* Touches is symmetric, either argument may be the prepared one */
+	if ((prepared = get_prepared(cache, geom1)))
+		return prepared_predicate(GEOSPreparedTouches, "GEOSPreparedTouches", prepared, geom2);
+	if ((prepared = get_prepared(cache, geom2)))
+		return prepared_predicate(GEOSPreparedTouches, "GEOSPreparedTouches", prepared, geom1);
+
 	initGEOS(lwnotice, lwgeom_geos_error);
 
-	g1 = POSTGIS2GEOS(geom1);
+	g1 = LWGEOM2GEOS(geom1, 0);
 	if (!g1)
 		throw "First argument geometry could not be converted to GEOS";
 
-	g2 = POSTGIS2GEOS(geom2);
+	g2 = LWGEOM2GEOS(geom2, 0);
 	if (!g2) {
 		GEOSGeom_destroy(g1);
 		throw "Second argument geometry could not be converted to GEOS";
@@ -723,42 +912,47 @@ bool touches(GSERIALIZED *geom1, GSERIALIZED *geom2) {
 	return result;
 }
 
-bool ST_Intersects(GSERIALIZED *geom1, GSERIALIZED *geom2) {
+bool ST_Intersects(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache) {
 	int result;
 	GBOX box1, box2;
+	const GEOSPreparedGeometry *prepared;
 
-	gserialized_error_if_srid_mismatch(geom1, geom2, __func__);
+	lwgeom_error_if_srid_mismatch(geom1, geom2, __func__);
 
 	/* A.Intersects(Empty) == FALSE */
-	if (gserialized_is_empty(geom1) || gserialized_is_empty(geom2))
+	if (lwgeom_is_empty(geom1) || lwgeom_is_empty(geom2))
 		return false;
 
 	/*
 	 * short-circuit 1: if geom2 bounding box does not overlap
 	 * geom1 bounding box we can return FALSE.
 	 */
-	if (gserialized_get_gbox_p(geom1, &box1) && gserialized_get_gbox_p(geom2, &box2)) {
+	if (lwgeom_get_gbox_p(geom1, &box1) && lwgeom_get_gbox_p(geom2, &box2)) {
 		if (gbox_overlaps_2d(&box1, &box2) == LW_FALSE)
 			return false;
 	}
 
+	/* Intersects is symmetric, either argument may be the prepared one */
+	if ((prepared = get_prepared(cache, geom1)))
+		return prepared_predicate(GEOSPreparedIntersects, "GEOSPreparedIntersects", prepared, geom2);
+	if ((prepared = get_prepared(cache, geom2)))
+		return prepared_predicate(GEOSPreparedIntersects, "GEOSPreparedIntersects", prepared, geom1);
+
 	/*
 	 * short-circuit 2: if the geoms are a point and a polygon,
 	 * call the point_outside_polygon function.
 	 */
 	if ((is_point(geom1) && is_poly(geom2)) || (is_poly(geom1) && is_point(geom2))) {
-		const GSERIALIZED *gpoly = is_poly(geom1) ? geom1 : geom2;
-		const GSERIALIZED *gpoint = is_point(geom1) ? geom1 : geom2;
+		const LWGEOM *gpoly = is_poly(geom1) ? geom1 : geom2;
+		const LWGEOM *gpoint = is_point(geom1) ? geom1 : geom2;
 		int retval;
 
-		if (gserialized_get_type(gpoint) == POINTTYPE) {
-			LWGEOM *point = lwgeom_from_gserialized(gpoint);
-			int pip_result = pip_short_circuit(lwgeom_as_lwpoint(point), gpoly);
-			lwgeom_free(point);
+		if (gpoint->type == POINTTYPE) {
+			int pip_result = pip_short_circuit(lwgeom_as_lwpoint(gpoint), gpoly);
 
 			retval = (pip_result != -1); /* not outside */
-		} else if (gserialized_get_type(gpoint) == MULTIPOINTTYPE) {
-			LWMPOINT *mpoint = lwgeom_as_lwmpoint(lwgeom_from_gserialized(gpoint));
+		} else if (gpoint->type == MULTIPOINTTYPE) {
+			LWMPOINT *mpoint = lwgeom_as_lwmpoint(gpoint);
 			uint32_t i;
 
 			retval = LW_FALSE;
@@ -771,7 +965,6 @@ bool ST_Intersects(GSERIALIZED *geom1, GSERIALIZED *geom2) {
 				}
 			}
 
-			lwmpoint_free(mpoint);
 		} else {
 			/* Never get here */
 			throw "Type isn't point or multipoint!";
@@ -785,10 +978,10 @@ bool ST_Intersects(GSERIALIZED *geom1, GSERIALIZED *geom2) {
 
 	GEOSGeometry *g1;
 	GEOSGeometry *g2;
-	g1 = POSTGIS2GEOS(geom1);
+	g1 = LWGEOM2GEOS(geom1, 0);
 	if (!g1)
 		throw "First argument geometry could not be converted to GEOS";
-	g2 = POSTGIS2GEOS(geom2);
+	g2 = LWGEOM2GEOS(geom2, 0);
 	if (!g2) {
 		GEOSGeom_destroy(g1);
 		throw "Second argument geometry could not be converted to GEOS";
@@ -807,42 +1000,46 @@ bool ST_Intersects(GSERIALIZED *geom1, GSERIALIZED *geom2) {
  * Described at
  * http://lin-ear-th-inking.blogspot.com/2007/06/subtleties-of-ogc-covers-spatial.html
  */
-bool covers(GSERIALIZED *geom1, GSERIALIZED *geom2) {
+bool covers(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache) {
 	int result;
 	GBOX box1, box2;
+	const GEOSPreparedGeometry *prepared;
 
 	/* A.Covers(Empty) == FALSE */
-	if (gserialized_is_empty(geom1) || gserialized_is_empty(geom2))
+	if (lwgeom_is_empty(geom1) || lwgeom_is_empty(geom2))
 		return false;
 
-	gserialized_error_if_srid_mismatch(geom1, geom2, __func__);
+	lwgeom_error_if_srid_mismatch(geom1, geom2, __func__);
 
 	/*
 	 * short-circuit 1: if geom2 bounding box is not completely inside
 	 * geom1 bounding box we can return FALSE.
 	 */
-	if (gserialized_get_gbox_p(geom1, &box1) && gserialized_get_gbox_p(geom2, &box2)) {
+	if (lwgeom_get_gbox_p(geom1, &box1) && lwgeom_get_gbox_p(geom2, &box2)) {
 		if (!gbox_contains_2d(&box1, &box2)) {
 			return false;
 		}
 	}
+
+	prepared = get_prepared(cache, geom1);
+	if (prepared)
+		return prepared_predicate(GEOSPreparedCovers, "GEOSPreparedCovers", prepared, geom2);
+
 	/*
 	 * short-circuit 2: if geom2 is a point and geom1 is a polygon
 	 * call the point-in-polygon function.
 	 */
 	if (is_poly(geom1) && is_point(geom2)) {
-		const GSERIALIZED *gpoly = is_poly(geom1) ? geom1 : geom2;
-		const GSERIALIZED *gpoint = is_point(geom1) ? geom1 : geom2;
+		const LWGEOM *gpoly = is_poly(geom1) ? geom1 : geom2;
+		const LWGEOM *gpoint = is_point(geom1) ? geom1 : geom2;
 		int retval;
 
-		if (gserialized_get_type(gpoint) == POINTTYPE) {
-			LWGEOM *point = lwgeom_from_gserialized(gpoint);
-			int pip_result = pip_short_circuit(lwgeom_as_lwpoint(point), gpoly);
-			lwgeom_free(point);
+		if (gpoint->type == POINTTYPE) {
+			int pip_result = pip_short_circuit(lwgeom_as_lwpoint(gpoint), gpoly);
 
 			retval = (pip_result != -1); /* not outside */
-		} else if (gserialized_get_type(gpoint) == MULTIPOINTTYPE) {
-			LWMPOINT *mpoint = lwgeom_as_lwmpoint(lwgeom_from_gserialized(gpoint));
+		} else if (gpoint->type == MULTIPOINTTYPE) {
+			LWMPOINT *mpoint = lwgeom_as_lwmpoint(gpoint);
 			uint32_t i;
 
 			retval = LW_TRUE;
@@ -854,7 +1051,6 @@ bool covers(GSERIALIZED *geom1, GSERIALIZED *geom2) {
 				}
 			}
 
-			lwmpoint_free(mpoint);
 		} else {
 			/* Never get here */
 			throw "Type isn't point or multipoint!";
@@ -864,15 +1060,20 @@ bool covers(GSERIALIZED *geom1, GSERIALIZED *geom2) {
 		return retval;
 	}
 
+	/* A.Covers(B) is B.CoveredBy(A) */
+	prepared = get_prepared(cache, geom2);
+	if (prepared)
+		return prepared_predicate(GEOSPreparedCoveredBy, "GEOSPreparedCoveredBy", prepared, geom1);
+
 	initGEOS(lwnotice, lwgeom_geos_error);
 
 	GEOSGeometry *g1;
 	GEOSGeometry *g2;
 
-	g1 = POSTGIS2GEOS(geom1);
+	g1 = LWGEOM2GEOS(geom1, 0);
 	if (!g1)
 		throw "First argument geometry could not be converted to GEOS";
-	g2 = POSTGIS2GEOS(geom2);
+	g2 = LWGEOM2GEOS(geom2, 0);
 	if (!g2) {
 		GEOSGeom_destroy(g1);
 		throw "Second argument geometry could not be converted to GEOS";
@@ -891,43 +1092,48 @@ bool covers(GSERIALIZED *geom1, GSERIALIZED *geom2) {
  * Described at:
  * http://lin-ear-th-inking.blogspot.com/2007/06/subtleties-of-ogc-covers-spatial.html
  */
-bool coveredby(GSERIALIZED *geom1, GSERIALIZED *geom2) {
+bool coveredby(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache) {
 	GEOSGeometry *g1, *g2;
 	int result;
 	GBOX box1, box2;
+	const GEOSPreparedGeometry *prepared;
 	std::string patt = "**F**F***";
 
-	gserialized_error_if_srid_mismatch(geom1, geom2, __func__);
+	lwgeom_error_if_srid_mismatch(geom1, geom2, __func__);
 
 	/* A.CoveredBy(Empty) == FALSE */
-	if (gserialized_is_empty(geom1) || gserialized_is_empty(geom2))
+	if (lwgeom_is_empty(geom1) || lwgeom_is_empty(geom2))
 		return false;
 	/*
 	 * short-circuit 1: if geom1 bounding box is not completely inside
 	 * geom2 bounding box we can return FALSE.
 	 */
-	if (gserialized_get_gbox_p(geom1, &box1) && gserialized_get_gbox_p(geom2, &box2)) {
+	if (lwgeom_get_gbox_p(geom1, &box1) && lwgeom_get_gbox_p(geom2, &box2)) {
 		if (!gbox_contains_2d(&box2, &box1)) {
 			return false;
 		}
 	}
+
+	/* A.CoveredBy(B) is B.Covers(A) */
+	prepared = get_prepared(cache, geom2);
+	if (prepared)
+		return prepared_predicate(GEOSPreparedCovers, "GEOSPreparedCovers", prepared, geom1);
+
 	/*
 	 * short-circuit 2: if geom1 is a point and geom2 is a polygon
 	 * call the point-in-polygon function.
 	 */
 	if (is_point(geom1) && is_poly(geom2)) {
-		const GSERIALIZED *gpoly = is_poly(geom1) ? geom1 : geom2;
-		const GSERIALIZED *gpoint = is_point(geom1) ? geom1 : geom2;
+		const LWGEOM *gpoly = is_poly(geom1) ? geom1 : geom2;
+		const LWGEOM *gpoint = is_point(geom1) ? geom1 : geom2;
 		int retval;
 
-		if (gserialized_get_type(gpoint) == POINTTYPE) {
-			LWGEOM *point = lwgeom_from_gserialized(gpoint);
-			int pip_result = pip_short_circuit(lwgeom_as_lwpoint(point), gpoly);
-			lwgeom_free(point);
+		if (gpoint->type == POINTTYPE) {
+			int pip_result = pip_short_circuit(lwgeom_as_lwpoint(gpoint), gpoly);
 
 			retval = (pip_result != -1); /* not outside */
-		} else if (gserialized_get_type(gpoint) == MULTIPOINTTYPE) {
-			LWMPOINT *mpoint = lwgeom_as_lwmpoint(lwgeom_from_gserialized(gpoint));
+		} else if (gpoint->type == MULTIPOINTTYPE) {
+			LWMPOINT *mpoint = lwgeom_as_lwmpoint(gpoint);
 			uint32_t i;
 
 			retval = LW_TRUE;
@@ -939,7 +1145,6 @@ bool coveredby(GSERIALIZED *geom1, GSERIALIZED *geom2) {
 				}
 			}
 
-			lwmpoint_free(mpoint);
 		} else {
 			/* Never get here */
 			throw "Type isn't point or multipoint!";
@@ -949,14 +1154,18 @@ bool coveredby(GSERIALIZED *geom1, GSERIALIZED *geom2) {
 		return retval;
 	}
 
+	prepared = get_prepared(cache, geom1);
+	if (prepared)
+		return prepared_predicate(GEOSPreparedCoveredBy, "GEOSPreparedCoveredBy", prepared, geom2);
+
 	initGEOS(lwnotice, lwgeom_geos_error);
 
-	g1 = POSTGIS2GEOS(geom1);
+	g1 = LWGEOM2GEOS(geom1, 0);
 
 	if (!g1)
 		throw "First argument geometry could not be converted to GEOS";
 
-	g2 = POSTGIS2GEOS(geom2);
+	g2 = LWGEOM2GEOS(geom2, 0);
 
 	if (!g2) {
 		GEOSGeom_destroy(g1);
@@ -974,34 +1183,41 @@ bool coveredby(GSERIALIZED *geom1, GSERIALIZED *geom2) {
 	return result;
 }
 
-bool disjoint(GSERIALIZED *geom1, GSERIALIZED *geom2) {
+bool disjoint(LWGEOM *geom1, LWGEOM *geom2, const PrepGeomCache *cache) {
 	GEOSGeometry *g1, *g2;
 	char result;
 	GBOX box1, box2;
+	const GEOSPreparedGeometry *prepared;
 
-	gserialized_error_if_srid_mismatch(geom1, geom2, __func__);
+	lwgeom_error_if_srid_mismatch(geom1, geom2, __func__);
 
 	/* A.Disjoint(Empty) == TRUE */
-	if (gserialized_is_empty(geom1) || gserialized_is_empty(geom2))
+	if (lwgeom_is_empty(geom1) || lwgeom_is_empty(geom2))
 		return true;
 
 	/*
 	 * short-circuit 1: if geom2 bounding box does not overlap
 	 * geom1 bounding box we can return TRUE.
 	 */
-	if (gserialized_get_gbox_p(geom1, &box1) && gserialized_get_gbox_p(geom2, &box2)) {
+	if (lwgeom_get_gbox_p(geom1, &box1) && lwgeom_get_gbox_p(geom2, &box2)) {
 		if (gbox_overlaps_2d(&box1, &box2) == LW_FALSE) {
 			return true;
 		}
 	}
 
+	/* Disjoint is symmetric, either argument may be the prepared one */
+	if ((prepared = get_prepared(cache, geom1)))
+		return prepared_predicate(GEOSPreparedDisjoint, "GEOSPreparedDisjoint", prepared, geom2);
+	if ((prepared = get_prepared(cache, geom2)))
+		return prepared_predicate(GEOSPreparedDisjoint, "GEOSPreparedDisjoint", prepared, geom1);
+
 	initGEOS(lwnotice, lwgeom_geos_error);
 
-	g1 = POSTGIS2GEOS(geom1);
+	g1 = LWGEOM2GEOS(geom1, 0);
 	if (!g1)
 		throw "First argument geometry could not be converted to GEOS";
 
-	g2 = POSTGIS2GEOS(geom2);
+	g2 = LWGEOM2GEOS(geom2, 0);
 	if (!g2) {
 		GEOSGeom_destroy(g1);
 		throw "Second argument geometry could not be converted to GEOS";
@@ -0,0 +1,134 @@
+/**********************************************************************
+ *
+ * PostGIS - Spatial Types for PostgreSQL
+ * http://postgis.net
+ *
+ * PostGIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * PostGIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PostGIS.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ *
+ * Copyright (C) 2012 Sandro Santilli <strk@kbt.io>
+ * Copyright (C) 2008 Paul Ramsey <pramsey@cleverelephant.ca>
+ * Copyright (C) 2007 Refractions Research Inc.
+ *
+ **********************************************************************/
+
+#include "postgis/lwgeom_geos_prepared.hpp"
+
+#include "liblwgeom/lwgeom_geos.hpp"
+#include "postgis/lwgeom_geos.hpp"
+
+#include "geos/geom/Geometry.hpp"
+#include "geos/geom/GeometryComponentFilter.hpp"
+
+namespace duckdb {
+
+PrepGeomCache::PrepGeomCache() : geom(NULL), prepared_geom(NULL) {
+}
+
+PrepGeomCache::~PrepGeomCache() {
+	Clear();
+}
+
+bool PrepGeomCache::BuildIndex() {
+	initGEOS(lwnotice, lwgeom_geos_error);
+
+	geom = LWGEOM2GEOS(lwgeom, 0);
+	if (!geom) {
+		return false;
+	}
+	prepared_geom = GEOSPrepare(geom);
+	return prepared_geom != NULL;
+}
+
+void PrepGeomCache::FreeIndex() {
+	/* The prepared geometry refers to the base geometry, release it first */
+	if (prepared_geom) {
+		GEOSPreparedGeom_destroy(prepared_geom);
+		prepared_geom = NULL;
+	}
+	if (geom) {
+		GEOSGeom_destroy(geom);
+		geom = NULL;
+	}
+}
+
+namespace {
+struct EnvelopeFilter : public geos::geom::GeometryComponentFilter {
+	void filter_ro(const geos::geom::Geometry *geom) override {
+		geom->getEnvelopeInternal();
+	}
+};
+} // namespace
+
+GEOSGeometry *LWGEOM2GEOS_shared(const LWGEOM *geom) {
+	initGEOS(lwnotice, lwgeom_geos_error);
+
+	auto g = LWGEOM2GEOS(geom, 0);
+	if (!g) {
+		lwerror("Geometry could not be converted to GEOS");
+	}
+	EnvelopeFilter filter;
+	reinterpret_cast<const geos::geom::Geometry *>(g)->apply_ro(&filter);
+	return g;
+}
+
+PreparedGeomSet::~PreparedGeomSet() {
+	for (auto &entry : prepared) {
+		GEOSPreparedGeom_destroy(entry.second);
+	}
+}
+
+bool PreparedGeomSet::Relate(PreparedRelation relation, idx_t idx, const GEOSGeometry *shared,
+                             const GEOSGeometry *geom) {
+	auto &entry = prepared[idx];
+	if (!entry) {
+		entry = GEOSPrepare(shared);
+		if (!entry) {
+			prepared.erase(idx);
+			lwerror("Geometry could not be prepared");
+		}
+	}
+
+	char result;
+	switch (relation) {
+	case PreparedRelation::INTERSECTS:
+		result = GEOSPreparedIntersects(entry, geom);
+		break;
+	case PreparedRelation::CONTAINS:
+		result = GEOSPreparedContains(entry, geom);
+		break;
+	case PreparedRelation::WITHIN:
+		result = GEOSPreparedWithin(entry, geom);
+		break;
+	case PreparedRelation::COVERS:
+		result = GEOSPreparedCovers(entry, geom);
+		break;
+	case PreparedRelation::COVEREDBY:
+		result = GEOSPreparedCoveredBy(entry, geom);
+		break;
+	case PreparedRelation::TOUCHES:
+		result = GEOSPreparedTouches(entry, geom);
+		break;
+	default:
+		lwerror("Unsupported prepared relation");
+		return false;
+	}
+	if (result == 2) {
+		lwerror("GEOS prepared predicate failed");
+	}
+	return result == 1;
+}
+
+} // namespace duckdb
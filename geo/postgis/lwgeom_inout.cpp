@@ -33,11 +33,10 @@
 
 namespace duckdb {
 
-GSERIALIZED *LWGEOM_in(char *input) {
+LWGEOM *LWGEOM_parse(char *input) {
 	char *str = input;
 	LWGEOM_PARSER_RESULT lwg_parser_result;
 	LWGEOM *lwgeom;
-	GSERIALIZED *ret;
 	int32_t srid = 0;
 
 	lwgeom_parser_result_init(&lwg_parser_result);
@@ -68,47 +67,41 @@ GSERIALIZED *LWGEOM_in(char *input) {
 		unsigned char *wkb = bytes_from_hexbytes(str, hexsize);
 		/* TODO: 20101206: No parser checks! This is inline with current 1.5 behavior, but needs discussion */
 		lwgeom = lwgeom_from_wkb(wkb, hexsize / 2, LW_PARSER_CHECK_NONE);
+		lwfree(wkb);
 		if (!lwgeom) {
 			return NULL;
 		}
 		/* If we picked up an SRID at the head of the WKB set it manually */
 		if (srid)
 			lwgeom_set_srid(lwgeom, srid);
-		/* Add a bbox if necessary */
-		if (lwgeom_needs_bbox(lwgeom))
-			lwgeom_add_bbox(lwgeom);
-		lwfree(wkb);
-		ret = geometry_serialize(lwgeom);
-		lwgeom_free(lwgeom);
+		return lwgeom;
 	}
 	/* GEOJson */
-	else if (str[0] == '{') {
+	if (str[0] == '{') {
 		char *srs = NULL;
-		lwgeom = lwgeom_from_geojson(str, &srs);
-		if (!lwgeom) {
-			return NULL;
-		} else {
-		}
-		ret = geometry_serialize(lwgeom);
-		lwgeom_free(lwgeom);
+		return lwgeom_from_geojson(str, &srs);
 	}
 	/* WKT then. */
-	else {
-		if (lwgeom_parse_wkt(&lwg_parser_result, str, LW_PARSER_CHECK_ALL) == LW_FAILURE) {
-			// PG_PARSER_ERROR(lwg_parser_result);
-			// PG_RETURN_NULL();
-			return NULL;
-		}
-		lwgeom = lwg_parser_result.geom;
-		if (!lwgeom) {
-			return NULL;
-		}
-		if (lwgeom_needs_bbox(lwgeom))
-			lwgeom_add_bbox(lwgeom);
-		ret = geometry_serialize(lwgeom);
-		lwgeom_parser_result_free(&lwg_parser_result);
+	if (lwgeom_parse_wkt(&lwg_parser_result, str, LW_PARSER_CHECK_ALL) == LW_FAILURE) {
+		// PG_PARSER_ERROR(lwg_parser_result);
+		// PG_RETURN_NULL();
+		return NULL;
 	}
+	/* The geometry is handed over, nothing else is left in the parser result */
+	return lwg_parser_result.geom;
+}
 
+GSERIALIZED *LWGEOM_in(char *input) {
+	LWGEOM *lwgeom = LWGEOM_parse(input);
+	GSERIALIZED *ret;
+	if (!lwgeom) {
+		return NULL;
+	}
+	/* Add a bbox if necessary */
+	if (lwgeom_needs_bbox(lwgeom))
+		lwgeom_add_bbox(lwgeom);
+	ret = geometry_serialize(lwgeom);
+	lwgeom_free(lwgeom);
 	return ret;
 }
 
@@ -120,26 +113,36 @@ GSERIALIZED *LWGEOM_getGserialized(const void *base, size_t size) {
 	return ret;
 }
 
-size_t LWGEOM_size(GSERIALIZED *gser) {
-	LWGEOM *lwgeom = lwgeom_from_gserialized(gser);
-	if (lwgeom == NULL) {
-		return 0;
-	}
+LWGEOM *LWGEOM_getLWGeom(const void *base, size_t size) {
+	return lwgeom_from_wkb(static_cast<const uint8_t *>(base), size, LW_PARSER_CHECK_NONE);
+}
 
-	auto buf_size = lwgeom_to_wkb_size(lwgeom, WKB_EXTENDED);
-	lwgeom_free(lwgeom);
-	return buf_size;
+bool LWGEOM_getGBox(const void *base, size_t size, GBOX *box, int32_t *srid) {
+	return lwgeom_calculate_gbox_wkb(static_cast<const uint8_t *>(base), size, box, srid) == LW_SUCCESS;
 }
 
-char *LWGEOM_base(GSERIALIZED *gser) {
-	LWGEOM *lwgeom = lwgeom_from_gserialized(gser);
-	if (lwgeom == NULL) {
-		return nullptr;
-	}
+LWGEOM *LWGEOM_deserialize(GSERIALIZED *gser) {
+	return lwgeom_from_gserialized(gser);
+}
 
-	auto buffer = lwgeom_to_wkb_buffer(lwgeom, WKB_EXTENDED);
-	lwgeom_free(lwgeom);
-	return (char *)buffer;
+bool LWGEOM_getFastGBox(const void *base, size_t size, GBOX *box, int32_t *srid) {
+	return lwgeom_fast_gbox_wkb(static_cast<const uint8_t *>(base), size, box, srid) == LW_SUCCESS;
+}
+
+bool LWGEOM_getHeader(const void *base, size_t size, WKB_HEADER *header) {
+	return lwgeom_wkb_header_read(static_cast<const uint8_t *>(base), size, header) == LW_SUCCESS;
+}
+
+size_t LWGEOM_wkbSize(const LWGEOM *lwgeom) {
+	return lwgeom_wkb_header_size(lwgeom) + lwgeom_to_wkb_size(lwgeom, WKB_EXTENDED);
+}
+
+void LWGEOM_wkbWrite(const LWGEOM *lwgeom, uint8_t *buffer, size_t size) {
+	auto wkb = lwgeom_wkb_header_write(lwgeom, buffer);
+	auto written_size = (wkb - buffer) + lwgeom_to_wkb_write_buf(lwgeom, WKB_EXTENDED, wkb);
+	if (written_size != (ptrdiff_t)size) {
+		lwerror("Output WKB is not the same size as the allocated buffer");
+	}
 }
 
 // std::string LWGEOM_asText(const void *base, size_t size, size_t max_digits) {
@@ -214,4 +217,10 @@ void LWGEOM_free(GSERIALIZED *gser) {
 	}
 }
 
+void LWGEOM_freeLWGeom(LWGEOM *lwgeom) {
+	if (lwgeom) {
+		lwgeom_free(lwgeom);
+	}
+}
+
 } // namespace duckdb
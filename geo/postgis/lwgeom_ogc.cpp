@@ -154,12 +154,10 @@ GSERIALIZED *LWGEOM_boundary(GSERIALIZED *geom1) {
  * 		returns 0 for points, 1 for lines, 2 for polygons, 3 for volume.
  * 		returns max dimension for a collection.
  */
-int LWGEOM_dimension(GSERIALIZED *geom) {
-	LWGEOM *lwgeom = lwgeom_from_gserialized(geom);
+int LWGEOM_dimension(LWGEOM *lwgeom) {
 	int dimension = -1;
 
 	dimension = lwgeom_dimension(lwgeom);
-	lwgeom_free(lwgeom);
 
 	if (dimension < 0) {
 		// elog(NOTICE, "Could not compute geometry dimensions");
@@ -169,16 +167,16 @@ int LWGEOM_dimension(GSERIALIZED *geom) {
 	return dimension;
 }
 
-double LWGEOM_x_point(GSERIALIZED *geom) {
+double LWGEOM_x_point(LWGEOM *lwgeom) {
 	POINT4D pt;
 
-	if (gserialized_get_type(geom) != POINTTYPE) {
+	if (lwgeom->type != POINTTYPE) {
 		lwerror("Argument to ST_X() must have type POINT");
 		throw Exception("Argument to ST_X() must have type POINT");
 		return LW_FAILURE;
 	}
 
-	if (gserialized_peek_first_point(geom, &pt) == LW_FAILURE) {
+	if (lwgeom_startpoint(lwgeom, &pt) == LW_FAILURE) {
 		return LW_FAILURE;
 	}
 	return pt.x;
@@ -188,22 +186,35 @@ double LWGEOM_x_point(GSERIALIZED *geom) {
  * Y(GEOMETRY) -- return Y value of the point.
  * 	Raise an error if input is not a point.
  */
-double LWGEOM_y_point(GSERIALIZED *geom) {
+double LWGEOM_y_point(LWGEOM *lwgeom) {
 	POINT4D pt;
 
-	if (gserialized_get_type(geom) != POINTTYPE) {
+	if (lwgeom->type != POINTTYPE) {
 		lwerror("Argument to ST_Y() must have type POINT");
 		throw Exception("Argument to ST_Y() must have type POINT");
 		return LW_FAILURE;
 	}
 
-	if (gserialized_peek_first_point(geom, &pt) == LW_FAILURE) {
+	if (lwgeom_startpoint(lwgeom, &pt) == LW_FAILURE) {
 		// PG_RETURN_NULL();
 		return LW_FAILURE;
 	}
 	return pt.y;
 }
 
+/**
+ * The coordinates of a point, for the casts to the point types.
+ * 	Raise an error if input is not a point, false if it is empty.
+ */
+bool LWGEOM_point(LWGEOM *lwgeom, POINT4D *pt) {
+	if (lwgeom->type != POINTTYPE) {
+		lwerror("Only a POINT can be cast to a point type");
+		return false;
+	}
+
+	return lwgeom_startpoint(lwgeom, pt) == LW_SUCCESS;
+}
+
 /** EndPoint(GEOMETRY) -- find the first linestring in GEOMETRY,
  * @return the last point.
  * 	Return NULL if there is no LINESTRING(..) in GEOMETRY
@@ -233,9 +244,9 @@ GSERIALIZED *LWGEOM_endpoint_linestring(GSERIALIZED *geom) {
 }
 
 /* returns a string representation of this geometry's type */
-std::string geometry_geometrytype(GSERIALIZED *gser) {
+std::string geometry_geometrytype(LWGEOM *lwgeom) {
 	/* Build a text type to store things in */
-	return stTypeName[gserialized_get_type(gser)];
+	return stTypeName[lwgeom->type];
 }
 
 /**
@@ -244,26 +255,19 @@ std::string geometry_geometrytype(GSERIALIZED *gser) {
  * 		If it's a collection containing multiple linestrings,
  * @return true only if all the linestrings have startpoint=endpoint.
  */
-bool LWGEOM_isclosed(GSERIALIZED *geom) {
-	LWGEOM *lwgeom = lwgeom_from_gserialized(geom);
-	int closed = lwgeom_is_closed(lwgeom);
-
-	lwgeom_free(lwgeom);
-	return closed;
+bool LWGEOM_isclosed(LWGEOM *lwgeom) {
+	return lwgeom_is_closed(lwgeom);
 }
 
-int LWGEOM_numgeometries_collection(GSERIALIZED *geom) {
-	LWGEOM *lwgeom;
+int LWGEOM_numgeometries_collection(LWGEOM *lwgeom) {
 	uint32_t ret = 1;
 
-	lwgeom = lwgeom_from_gserialized(geom);
 	if (lwgeom_is_empty(lwgeom)) {
 		ret = 0;
 	} else if (lwgeom_is_collection(lwgeom)) {
 		LWCOLLECTION *col = lwgeom_as_lwcollection(lwgeom);
 		ret = col->ngeoms;
 	}
-	lwgeom_free(lwgeom);
 
 	return ret;
 }
@@ -272,16 +276,13 @@ int LWGEOM_numgeometries_collection(GSERIALIZED *geom) {
  * numpoints(LINESTRING) -- return the number of points in the
  * linestring, or NULL if it is not a linestring
  */
-int LWGEOM_numpoints_linestring(GSERIALIZED *geom) {
-	LWGEOM *lwgeom = lwgeom_from_gserialized(geom);
+int LWGEOM_numpoints_linestring(LWGEOM *lwgeom) {
 	int count = -1;
 	int type = lwgeom->type;
 
 	if (type == LINETYPE || type == CIRCSTRINGTYPE || type == COMPOUNDTYPE)
 		count = lwgeom_count_vertices(lwgeom);
 
-	lwgeom_free(lwgeom);
-
 	/* OGC says this functions is only valid on LINESTRING */
 	if (count < 0)
 		return 0;
@@ -31,13 +31,47 @@
 
 namespace duckdb {
 
-std::vector<int> ST_ClusterDBSCAN(GSERIALIZED *gserArray[], int ngeoms, double tolerance, int minpoints) {
+std::vector<int> ST_ClusterDBSCAN(GSERIALIZED *gserArray[], int ngeoms, double tolerance, int minpoints,
+                                  uint32_t max_threads) {
+	if (ngeoms <= 0) {
+		return {};
+	}
+	LWGEOM **geoms = (LWGEOM **)lwalloc(ngeoms * sizeof(LWGEOM *));
+	for (int i = 0; i < ngeoms; i++) {
+		geoms[i] = lwgeom_from_gserialized(gserArray[i]);
+
+		if (!geoms[i]) {
+			/* TODO release memory ? */
+			lwerror("Error reading geometry.");
+			return {};
+		}
+	}
+
+	std::vector<int> clusters;
+	try {
+		clusters = ST_ClusterDBSCAN(geoms, ngeoms, tolerance, minpoints, max_threads);
+	} catch (...) {
+		for (int i = 0; i < ngeoms; i++) {
+			lwgeom_free(geoms[i]);
+		}
+		lwfree(geoms);
+		throw;
+	}
+
+	for (int i = 0; i < ngeoms; i++) {
+		lwgeom_free(geoms[i]);
+	}
+	lwfree(geoms);
+
+	return clusters;
+}
+
+std::vector<int> ST_ClusterDBSCAN(LWGEOM *geoms[], int ngeoms, double tolerance, int minpoints, uint32_t max_threads) {
 	if (ngeoms <= 0) {
 		return {};
 	}
 	uint32_t i;
 	uint32_t *result_ids;
-	LWGEOM **geoms;
 	char *is_in_cluster = NULL;
 	UNIONFIND *uf;
 	std::vector<int> clusters(ngeoms, -1);
@@ -54,26 +88,12 @@ std::vector<int> ST_ClusterDBSCAN(GSERIALIZED *gserArray[], int ngeoms, double t
 	}
 
 	initGEOS(lwnotice, lwgeom_geos_error);
-	geoms = (LWGEOM **)lwalloc(ngeoms * sizeof(LWGEOM *));
 	uf = UF_create(ngeoms);
-	for (i = 0; i < ngeoms; i++) {
-		geoms[i] = lwgeom_from_gserialized(gserArray[i]);
 
-		if (!geoms[i]) {
-			/* TODO release memory ? */
-			lwerror("Error reading geometry.");
-			return {};
-		}
-	}
-
-	if (union_dbscan(geoms, ngeoms, uf, tolerance, minpoints, minpoints > 1 ? &is_in_cluster : NULL) == LW_SUCCESS)
+	if (union_dbscan_geodetic(geoms, ngeoms, uf, tolerance, minpoints, max_threads,
+	                          minpoints > 1 ? &is_in_cluster : NULL) == LW_SUCCESS)
 		is_error = LW_FALSE;
 
-	for (i = 0; i < ngeoms; i++) {
-		lwgeom_free(geoms[i]);
-	}
-	lwfree(geoms);
-
 	if (is_error) {
 		UF_destroy(uf);
 		if (is_in_cluster)
@@ -83,7 +103,7 @@ std::vector<int> ST_ClusterDBSCAN(GSERIALIZED *gserArray[], int ngeoms, double t
 	}
 
 	result_ids = UF_get_collapsed_cluster_ids(uf, is_in_cluster);
-	for (i = 0; i < ngeoms; i++) {
+	for (i = 0; i < (uint32_t)ngeoms; i++) {
 		if (minpoints > 1 && !is_in_cluster[i]) {
 			clusters[i] = -1;
 		} else {
@@ -92,9 +112,31 @@ std::vector<int> ST_ClusterDBSCAN(GSERIALIZED *gserArray[], int ngeoms, double t
 	}
 
 	lwfree(result_ids);
+	if (is_in_cluster)
+		lwfree(is_in_cluster);
 	UF_destroy(uf);
 
 	return clusters;
 }
 
+std::vector<int> ST_ClusterKMeans(LWGEOM *geoms[], int ngeoms, int k) {
+	if (k <= 0) {
+		lwerror("ST_ClusterKMeans: Number of clusters must be greater than zero");
+		return {};
+	}
+	if (ngeoms <= 0) {
+		return {};
+	}
+
+	int *result = lwgeom_cluster_kmeans_sphere((const LWGEOM **)geoms, ngeoms, k);
+	if (!result) {
+		lwerror("ST_ClusterKMeans: Error during clustering");
+		return {};
+	}
+	std::vector<int> clusters(result, result + ngeoms);
+	lwfree(result);
+
+	return clusters;
+}
+
 } // namespace duckdb
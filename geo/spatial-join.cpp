@@ -0,0 +1,647 @@
+#include "spatial-join.hpp"
+
+#include "duckdb/common/field_writer.hpp"
+#include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/execution/physical_plan_generator.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_conjunction_expression.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckdb/planner/operator/logical_any_join.hpp"
+#include "duckdb/planner/operator/logical_filter.hpp"
+#include "geo-functions.hpp"
+#include "geos/index/strtree/TemplateSTRtree.hpp"
+#include "libpgcommon/lwgeom_pg.hpp"
+
+namespace duckdb {
+
+bool SpatialJoinCondition::Evaluate(LWGEOM *left, LWGEOM *right) const {
+	auto geom1 = left_is_first ? left : right;
+	auto geom2 = left_is_first ? right : left;
+	switch (predicate) {
+	case SpatialPredicate::INTERSECTS:
+		return Geometry::GeometryIntersects(geom1, geom2);
+	case SpatialPredicate::CONTAINS:
+		return Geometry::GeometryContains(geom1, geom2);
+	case SpatialPredicate::WITHIN:
+		return Geometry::GeometryWithin(geom1, geom2);
+	case SpatialPredicate::COVERS:
+		return Geometry::GeometryCovers(geom1, geom2);
+	case SpatialPredicate::COVEREDBY:
+		return Geometry::GeometryCoveredby(geom1, geom2);
+	case SpatialPredicate::TOUCHES:
+		return Geometry::GeometryTouches(geom1, geom2);
+	case SpatialPredicate::DWITHIN:
+		return Geometry::GeometryDWithin(geom1, geom2, distance);
+	case SpatialPredicate::GEOGRAPHY_DWITHIN:
+		return Geometry::GeometryDWithin(geom1, geom2, distance, use_spheroid);
+	default:
+		throw InternalException("Unsupported spatial join predicate");
+	}
+}
+
+bool SpatialJoinCondition::IsPrepared() const {
+	return predicate != SpatialPredicate::DWITHIN && predicate != SpatialPredicate::GEOGRAPHY_DWITHIN;
+}
+
+PreparedRelation SpatialJoinCondition::GetPreparedRelation() const {
+	// The right geometry is the prepared one, so the asymmetric predicates flip when it is the second argument
+	switch (predicate) {
+	case SpatialPredicate::INTERSECTS:
+		return PreparedRelation::INTERSECTS;
+	case SpatialPredicate::CONTAINS:
+		return left_is_first ? PreparedRelation::WITHIN : PreparedRelation::CONTAINS;
+	case SpatialPredicate::WITHIN:
+		return left_is_first ? PreparedRelation::CONTAINS : PreparedRelation::WITHIN;
+	case SpatialPredicate::COVERS:
+		return left_is_first ? PreparedRelation::COVEREDBY : PreparedRelation::COVERS;
+	case SpatialPredicate::COVEREDBY:
+		return left_is_first ? PreparedRelation::COVERS : PreparedRelation::COVEREDBY;
+	case SpatialPredicate::TOUCHES:
+		return PreparedRelation::TOUCHES;
+	default:
+		throw InternalException("Spatial join predicate has no prepared form");
+	}
+}
+
+//! The meridional radius of curvature at the equator is the smallest radius of curvature of the WGS84 spheroid, so
+//! two geographies within a distance in meters on the sphere or the spheroid are never further apart on the unit
+//! sphere than the distance over this radius
+static const double GEOGRAPHY_MIN_RADIUS =
+    WGS84_MAJOR_AXIS * (1.0 - (2.0 - 1.0 / WGS84_INVERSE_FLATTENING) / WGS84_INVERSE_FLATTENING);
+
+void SpatialJoinCondition::GetBoundingBox(const LWGEOM *geom, bool probe, GBOX &box) const {
+	double expand = 0;
+	if (predicate == SpatialPredicate::GEOGRAPHY_DWITHIN) {
+		// Boxes on the unit sphere need no special care for the dateline or the poles, and a chord is never
+		// longer than its arc, so growing the box by the angle keeps every pair in range
+		lwgeom_calculate_gbox_geodetic(geom, &box);
+		if (probe) {
+			expand = distance / GEOGRAPHY_MIN_RADIUS + FP_TOLERANCE;
+		}
+		box.zmin -= expand;
+		box.zmax += expand;
+	} else {
+		lwgeom_calculate_gbox_cartesian(geom, &box);
+		if (probe && predicate == SpatialPredicate::DWITHIN) {
+			expand = distance;
+		}
+		box.zmin = box.zmax = 0;
+	}
+	box.xmin -= expand;
+	box.xmax += expand;
+	box.ymin -= expand;
+	box.ymax += expand;
+}
+
+string SpatialJoinCondition::ToString() const {
+	string name;
+	switch (predicate) {
+	case SpatialPredicate::INTERSECTS:
+		name = "st_intersects";
+		break;
+	case SpatialPredicate::CONTAINS:
+		name = "st_contains";
+		break;
+	case SpatialPredicate::WITHIN:
+		name = "st_within";
+		break;
+	case SpatialPredicate::COVERS:
+		name = "st_covers";
+		break;
+	case SpatialPredicate::COVEREDBY:
+		name = "st_coveredby";
+		break;
+	case SpatialPredicate::TOUCHES:
+		name = "st_touches";
+		break;
+	case SpatialPredicate::DWITHIN:
+	case SpatialPredicate::GEOGRAPHY_DWITHIN:
+		name = "st_dwithin";
+		break;
+	}
+	auto left = "#" + to_string(left_column);
+	auto right = "#" + to_string(right_column);
+	auto result = name + "(" + (left_is_first ? left + ", " + right : right + ", " + left);
+	if (predicate == SpatialPredicate::DWITHIN) {
+		result += ", " + to_string(distance);
+	} else if (predicate == SpatialPredicate::GEOGRAPHY_DWITHIN) {
+		result += ", " + to_string(distance) + (use_spheroid ? ", true" : ", false");
+	}
+	return result + ")";
+}
+
+//===--------------------------------------------------------------------===//
+// Optimizer
+//===--------------------------------------------------------------------===//
+static bool GetSpatialPredicate(const string &name, SpatialPredicate &result) {
+	static const std::unordered_map<string, SpatialPredicate> predicates {
+	    {"st_intersects", SpatialPredicate::INTERSECTS}, {"st_contains", SpatialPredicate::CONTAINS},
+	    {"st_within", SpatialPredicate::WITHIN},         {"st_covers", SpatialPredicate::COVERS},
+	    {"st_coveredby", SpatialPredicate::COVEREDBY},   {"st_touches", SpatialPredicate::TOUCHES},
+	    {"st_dwithin", SpatialPredicate::DWITHIN}};
+	auto entry = predicates.find(name);
+	if (entry == predicates.end()) {
+		return false;
+	}
+	result = entry->second;
+	return true;
+}
+
+//! Position of a plain column reference in the output of a join child
+static bool FindColumn(Expression &expr, const vector<ColumnBinding> &bindings, idx_t &result) {
+	if (expr.GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+		return false;
+	}
+	auto &colref = (BoundColumnRefExpression &)expr;
+	if (colref.depth > 0) {
+		return false;
+	}
+	for (idx_t i = 0; i < bindings.size(); i++) {
+		if (bindings[i] == colref.binding) {
+			result = i;
+			return true;
+		}
+	}
+	return false;
+}
+
+//! Matches a predicate between a geometry column of either side, with constant ST_DWITHIN arguments
+static bool MatchSpatialCondition(ClientContext &context, Expression &expr, const vector<ColumnBinding> &left,
+                                  const vector<ColumnBinding> &right, SpatialJoinCondition &result) {
+	if (expr.GetExpressionClass() != ExpressionClass::BOUND_FUNCTION) {
+		return false;
+	}
+	auto &func = (BoundFunctionExpression &)expr;
+	if (!GetSpatialPredicate(func.function.name, result.predicate)) {
+		return false;
+	}
+	if (result.predicate == SpatialPredicate::DWITHIN && func.children.size() == 4) {
+		result.predicate = SpatialPredicate::GEOGRAPHY_DWITHIN;
+	}
+	idx_t arg_count = 2;
+	if (result.predicate == SpatialPredicate::DWITHIN) {
+		arg_count = 3;
+	} else if (result.predicate == SpatialPredicate::GEOGRAPHY_DWITHIN) {
+		arg_count = 4;
+	}
+	if (func.children.size() != arg_count) {
+		return false;
+	}
+	// The overloads on the columnar types read their arguments as STRUCTs and LISTs, not as WKB
+	if (!GeoTypes::IsGeography(func.children[0]->return_type) ||
+	    !GeoTypes::IsGeography(func.children[1]->return_type)) {
+		return false;
+	}
+	if (FindColumn(*func.children[0], left, result.left_column) &&
+	    FindColumn(*func.children[1], right, result.right_column)) {
+		result.left_is_first = true;
+	} else if (FindColumn(*func.children[0], right, result.right_column) &&
+	           FindColumn(*func.children[1], left, result.left_column)) {
+		result.left_is_first = false;
+	} else {
+		return false;
+	}
+	result.distance = 0;
+	result.use_spheroid = false;
+	for (idx_t arg_idx = 2; arg_idx < arg_count; arg_idx++) {
+		if (!func.children[arg_idx]->IsFoldable()) {
+			return false;
+		}
+		auto value = ExpressionExecutor::EvaluateScalar(context, *func.children[arg_idx]);
+		if (value.IsNull()) {
+			return false;
+		}
+		if (arg_idx == 2) {
+			result.distance = DoubleValue::Get(value.DefaultCastAs(LogicalType::DOUBLE));
+		} else {
+			result.use_spheroid = BooleanValue::Get(value.DefaultCastAs(LogicalType::BOOLEAN));
+		}
+	}
+	// Leave the error for a negative tolerance to the function itself
+	return result.distance >= 0;
+}
+
+static unique_ptr<LogicalOperator> TryCreateSpatialJoin(ClientContext &context, LogicalAnyJoin &join) {
+	if (join.join_type != JoinType::INNER || !join.left_projection_map.empty() ||
+	    !join.right_projection_map.empty()) {
+		return nullptr;
+	}
+	auto left_bindings = join.children[0]->GetColumnBindings();
+	auto right_bindings = join.children[1]->GetColumnBindings();
+
+	// The spatial predicate is either the whole join condition or one term of a conjunction
+	vector<Expression *> terms;
+	if (join.condition->GetExpressionType() == ExpressionType::CONJUNCTION_AND) {
+		auto &conjunction = (BoundConjunctionExpression &)*join.condition;
+		for (auto &child : conjunction.children) {
+			terms.push_back(child.get());
+		}
+	} else {
+		terms.push_back(join.condition.get());
+	}
+	SpatialJoinCondition condition;
+	idx_t term_idx;
+	for (term_idx = 0; term_idx < terms.size(); term_idx++) {
+		if (MatchSpatialCondition(context, *terms[term_idx], left_bindings, right_bindings, condition)) {
+			break;
+		}
+	}
+	if (term_idx == terms.size()) {
+		return nullptr;
+	}
+
+	// The index is built over the smaller side
+	if (join.children[0]->EstimateCardinality(context) < join.children[1]->EstimateCardinality(context)) {
+		std::swap(join.children[0], join.children[1]);
+		std::swap(condition.left_column, condition.right_column);
+		condition.left_is_first = !condition.left_is_first;
+	}
+
+	auto spatial_join = make_unique<LogicalSpatialJoin>(condition);
+	spatial_join->children = move(join.children);
+	spatial_join->estimated_cardinality = join.estimated_cardinality;
+	if (terms.size() == 1) {
+		return move(spatial_join);
+	}
+
+	// The other terms are checked on the output of the spatial join
+	auto filter = make_unique<LogicalFilter>();
+	auto &conjunction = (BoundConjunctionExpression &)*join.condition;
+	for (idx_t i = 0; i < conjunction.children.size(); i++) {
+		if (i != term_idx) {
+			filter->expressions.push_back(move(conjunction.children[i]));
+		}
+	}
+	filter->children.push_back(move(spatial_join));
+	return move(filter);
+}
+
+static void OptimizeSpatialJoins(ClientContext &context, unique_ptr<LogicalOperator> &op) {
+	for (auto &child : op->children) {
+		OptimizeSpatialJoins(context, child);
+	}
+	if (op->type != LogicalOperatorType::LOGICAL_ANY_JOIN) {
+		return;
+	}
+	auto spatial_join = TryCreateSpatialJoin(context, (LogicalAnyJoin &)*op);
+	if (spatial_join) {
+		op = move(spatial_join);
+	}
+}
+
+void SpatialJoinOptimizer::Optimize(ClientContext &context, OptimizerExtensionInfo *info,
+                                    unique_ptr<LogicalOperator> &plan) {
+	Value enabled;
+	if (context.TryGetCurrentSetting("geo_spatial_join", enabled) &&
+	    !BooleanValue::Get(enabled.DefaultCastAs(LogicalType::BOOLEAN))) {
+		return;
+	}
+	OptimizeSpatialJoins(context, plan);
+}
+
+//===--------------------------------------------------------------------===//
+// Logical Operator
+//===--------------------------------------------------------------------===//
+LogicalSpatialJoin::LogicalSpatialJoin(SpatialJoinCondition condition_p) : condition(condition_p) {
+}
+
+vector<ColumnBinding> LogicalSpatialJoin::GetColumnBindings() {
+	auto result = children[0]->GetColumnBindings();
+	auto right_bindings = children[1]->GetColumnBindings();
+	result.insert(result.end(), right_bindings.begin(), right_bindings.end());
+	return result;
+}
+
+void LogicalSpatialJoin::ResolveTypes() {
+	types = children[0]->types;
+	types.insert(types.end(), children[1]->types.begin(), children[1]->types.end());
+}
+
+unique_ptr<PhysicalOperator> LogicalSpatialJoin::CreatePlan(ClientContext &context,
+                                                            PhysicalPlanGenerator &generator) {
+	auto left = generator.CreatePlan(move(children[0]));
+	auto right = generator.CreatePlan(move(children[1]));
+	return make_unique<PhysicalSpatialJoin>(*this, move(left), move(right), condition, estimated_cardinality);
+}
+
+void LogicalSpatialJoin::Serialize(FieldWriter &writer) const {
+	// Plans are only serialized once bound (to verify them), before the optimizer extensions plan spatial joins
+	throw InternalException("A spatial join is only planned by the optimizer and is never serialized");
+}
+
+string LogicalSpatialJoin::GetName() const {
+	return "SPATIAL_JOIN";
+}
+
+string LogicalSpatialJoin::ParamsToString() const {
+	return condition.ToString();
+}
+
+//===--------------------------------------------------------------------===//
+// Physical Operator
+//===--------------------------------------------------------------------===//
+PhysicalSpatialJoin::PhysicalSpatialJoin(LogicalOperator &op, unique_ptr<PhysicalOperator> left,
+                                         unique_ptr<PhysicalOperator> right, SpatialJoinCondition condition_p,
+                                         idx_t estimated_cardinality)
+    : PhysicalJoin(op, PhysicalOperatorType::EXTENSION, JoinType::INNER, estimated_cardinality),
+      condition(condition_p) {
+	children.push_back(move(left));
+	children.push_back(move(right));
+}
+
+//! A non-empty geometry of the right side, decoded once and shared by all probing threads
+struct SpatialJoinEntry {
+	LWGEOM *geom;
+	//! The GEOS form of geom for the predicates evaluated by GEOS, otherwise NULL
+	GEOSGeometry *geos_geom;
+	GBOX box;
+	idx_t chunk_idx;
+	idx_t row_idx;
+};
+
+//! STRtree bounds over planar boxes, with a zero z range, or over boxes on the unit sphere
+struct SpatialJoinBoxTraits {
+	using BoundsType = GBOX;
+	using TwoDimensional = std::true_type;
+
+	static bool intersects(const GBOX &a, const GBOX &b) {
+		return a.xmin <= b.xmax && b.xmin <= a.xmax && a.ymin <= b.ymax && b.ymin <= a.ymax && a.zmin <= b.zmax &&
+		       b.zmin <= a.zmax;
+	}
+
+	static double size(const GBOX &a) {
+		return (a.xmax - a.xmin) * (a.ymax - a.ymin);
+	}
+
+	static double getX(const GBOX &a) {
+		return a.xmin + a.xmax;
+	}
+
+	static double getY(const GBOX &a) {
+		return a.ymin + a.ymax;
+	}
+
+	static void expandToInclude(GBOX &a, const GBOX &b) {
+		a.xmin = MinValue(a.xmin, b.xmin);
+		a.xmax = MaxValue(a.xmax, b.xmax);
+		a.ymin = MinValue(a.ymin, b.ymin);
+		a.ymax = MaxValue(a.ymax, b.ymax);
+		a.zmin = MinValue(a.zmin, b.zmin);
+		a.zmax = MaxValue(a.zmax, b.zmax);
+	}
+
+	static bool isNull(const GBOX &a) {
+		return false;
+	}
+};
+
+//! Give every component its bounding box up front, the predicates would otherwise add them lazily while the
+//! geometry is read concurrently
+static void AddBoundingBoxes(LWGEOM *geom) {
+	lwgeom_add_bbox(geom);
+	if (lwgeom_is_collection(geom)) {
+		auto collection = (LWCOLLECTION *)geom;
+		for (uint32_t i = 0; i < collection->ngeoms; i++) {
+			AddBoundingBoxes(collection->geoms[i]);
+		}
+	}
+}
+
+class SpatialJoinLocalSinkState : public LocalSinkState {
+public:
+	~SpatialJoinLocalSinkState() override {
+		for (auto &entry : entries) {
+			Geometry::DestroyLWGeom(entry.geom);
+			if (entry.geos_geom) {
+				GEOSGeom_destroy(entry.geos_geom);
+			}
+		}
+	}
+
+	vector<unique_ptr<DataChunk>> chunks;
+	vector<SpatialJoinEntry> entries;
+};
+
+class SpatialJoinGlobalSinkState : public GlobalSinkState {
+public:
+	~SpatialJoinGlobalSinkState() override {
+		for (auto &entry : entries) {
+			Geometry::DestroyLWGeom(entry.geom);
+			if (entry.geos_geom) {
+				GEOSGeom_destroy(entry.geos_geom);
+			}
+		}
+	}
+
+	mutex lock;
+	//! The materialized right side, the entries point to their rows in here
+	vector<unique_ptr<DataChunk>> chunks;
+	vector<SpatialJoinEntry> entries;
+	//! Bounding boxes of the entries, the items are positions in entries
+	geos::index::strtree::TemplateSTRtree<idx_t, SpatialJoinBoxTraits> tree;
+};
+
+unique_ptr<GlobalSinkState> PhysicalSpatialJoin::GetGlobalSinkState(ClientContext &context) const {
+	return make_unique<SpatialJoinGlobalSinkState>();
+}
+
+unique_ptr<LocalSinkState> PhysicalSpatialJoin::GetLocalSinkState(ExecutionContext &context) const {
+	return make_unique<SpatialJoinLocalSinkState>();
+}
+
+SinkResultType PhysicalSpatialJoin::Sink(ExecutionContext &context, GlobalSinkState &gstate,
+                                         LocalSinkState &lstate_p, DataChunk &input) const {
+	auto &lstate = (SpatialJoinLocalSinkState &)lstate_p;
+	auto chunk = make_unique<DataChunk>();
+	chunk->Initialize(Allocator::Get(context.client), input.GetTypes());
+	input.Copy(*chunk);
+
+	auto &geom_vec = chunk->data[condition.right_column];
+	auto geoms = FlatVector::GetData<string_t>(geom_vec);
+	auto &validity = FlatVector::Validity(geom_vec);
+	for (idx_t i = 0; i < chunk->size(); i++) {
+		if (!validity.RowIsValid(i) || geoms[i].GetSize() == 0) {
+			continue;
+		}
+		auto lwgeom = Geometry::GetLWGeom(geoms[i]);
+		if (!lwgeom) {
+			throw ConversionException("Failure in spatial join: could not read geometry");
+		}
+		// None of the predicates holds for an empty geometry
+		if (lwgeom_is_empty(lwgeom)) {
+			Geometry::DestroyLWGeom(lwgeom);
+			continue;
+		}
+		AddBoundingBoxes(lwgeom);
+		SpatialJoinEntry entry {lwgeom, nullptr, GBOX(), lstate.chunks.size(), i};
+		lstate.entries.push_back(entry);
+		auto &added = lstate.entries.back();
+		condition.GetBoundingBox(lwgeom, false, added.box);
+		// Converted once here rather than on every candidate pair
+		if (condition.IsPrepared()) {
+			added.geos_geom = LWGEOM2GEOS_shared(lwgeom);
+		}
+	}
+	lstate.chunks.push_back(move(chunk));
+	return SinkResultType::NEED_MORE_INPUT;
+}
+
+void PhysicalSpatialJoin::Combine(ExecutionContext &context, GlobalSinkState &gstate_p,
+                                  LocalSinkState &lstate_p) const {
+	auto &gstate = (SpatialJoinGlobalSinkState &)gstate_p;
+	auto &lstate = (SpatialJoinLocalSinkState &)lstate_p;
+	lock_guard<mutex> guard(gstate.lock);
+	auto chunk_offset = gstate.chunks.size();
+	for (auto &chunk : lstate.chunks) {
+		gstate.chunks.push_back(move(chunk));
+	}
+	for (auto &entry : lstate.entries) {
+		entry.chunk_idx += chunk_offset;
+		gstate.entries.push_back(entry);
+	}
+	lstate.chunks.clear();
+	lstate.entries.clear();
+}
+
+SinkFinalizeType PhysicalSpatialJoin::Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
+                                               GlobalSinkState &gstate_p) const {
+	auto &gstate = (SpatialJoinGlobalSinkState &)gstate_p;
+	if (gstate.entries.empty()) {
+		return SinkFinalizeType::NO_OUTPUT_POSSIBLE;
+	}
+	for (idx_t i = 0; i < gstate.entries.size(); i++) {
+		gstate.tree.insert(gstate.entries[i].box, i);
+	}
+	gstate.tree.build();
+	return SinkFinalizeType::READY;
+}
+
+class SpatialJoinOperatorState : public CachingOperatorState {
+public:
+	explicit SpatialJoinOperatorState(bool arena) : arena(arena) {
+	}
+
+	//! The geo_arena_allocator setting of the connection running the join
+	bool arena;
+	//! Prepared forms of the entries this thread has probed, by entry
+	PreparedGeomSet prepared;
+	//! Matching (left row, entry) pairs of the current input chunk
+	vector<std::pair<idx_t, idx_t>> matches;
+	idx_t match_offset = 0;
+	bool probed = false;
+};
+
+unique_ptr<OperatorState> PhysicalSpatialJoin::GetOperatorState(ExecutionContext &context) const {
+	return make_unique<SpatialJoinOperatorState>(GeoFunctions::ArenaEnabled(context.client));
+}
+
+static void ProbeSpatialJoin(const SpatialJoinCondition &condition, SpatialJoinGlobalSinkState &gstate,
+                             DataChunk &input, SpatialJoinOperatorState &state) {
+	LWArenaScope arena(state.arena);
+	auto &matches = state.matches;
+	auto relation = condition.IsPrepared() ? condition.GetPreparedRelation() : PreparedRelation::INTERSECTS;
+	UnifiedVectorFormat format;
+	input.data[condition.left_column].ToUnifiedFormat(input.size(), format);
+	auto geoms = (string_t *)format.data;
+	for (idx_t i = 0; i < input.size(); i++) {
+		auto idx = format.sel->get_index(i);
+		if (!format.validity.RowIsValid(idx) || geoms[idx].GetSize() == 0) {
+			continue;
+		}
+		auto lwgeom = Geometry::GetLWGeom(geoms[idx]);
+		if (!lwgeom) {
+			throw ConversionException("Failure in spatial join: could not read geometry");
+		}
+		if (!lwgeom_is_empty(lwgeom)) {
+			GBOX box;
+			condition.GetBoundingBox(lwgeom, true, box);
+			// Converted to GEOS for the first candidate only
+			unique_ptr<GEOSGeometry, void (*)(GEOSGeometry *)> geos_geom(nullptr, GEOSGeom_destroy);
+			gstate.tree.query(box, [&](const idx_t &entry_idx) {
+				auto &entry = gstate.entries[entry_idx];
+				bool match;
+				if (entry.geos_geom) {
+					lwgeom_error_if_srid_mismatch(lwgeom, entry.geom, "spatial join");
+					if (!geos_geom) {
+						geos_geom.reset(LWGEOM2GEOS_shared(lwgeom));
+					}
+					match = state.prepared.Relate(relation, entry_idx, entry.geos_geom, geos_geom.get());
+				} else {
+					match = condition.Evaluate(lwgeom, entry.geom);
+				}
+				if (match) {
+					matches.emplace_back(i, entry_idx);
+				}
+			});
+		}
+		Geometry::DestroyLWGeom(lwgeom);
+	}
+	// Entries are ordered by the chunk they were sunk in
+	std::sort(matches.begin(), matches.end(),
+	          [](const std::pair<idx_t, idx_t> &a, const std::pair<idx_t, idx_t> &b) { return a.second < b.second; });
+}
+
+OperatorResultType PhysicalSpatialJoin::ExecuteInternal(ExecutionContext &context, DataChunk &input,
+                                                        DataChunk &chunk, GlobalOperatorState &gstate_p,
+                                                        OperatorState &state_p) const {
+	auto &gstate = (SpatialJoinGlobalSinkState &)*sink_state;
+	auto &state = (SpatialJoinOperatorState &)state_p;
+	if (!state.probed) {
+		state.matches.clear();
+		state.match_offset = 0;
+		ProbeSpatialJoin(condition, gstate, input, state);
+		state.probed = true;
+	}
+
+	auto count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, state.matches.size() - state.match_offset);
+	auto matches = state.matches.data() + state.match_offset;
+	auto left_columns = input.ColumnCount();
+
+	SelectionVector left_sel(STANDARD_VECTOR_SIZE);
+	for (idx_t i = 0; i < count; i++) {
+		left_sel.set_index(i, matches[i].first);
+	}
+	for (idx_t col_idx = 0; col_idx < left_columns; col_idx++) {
+		chunk.data[col_idx].Slice(input.data[col_idx], left_sel, count);
+	}
+
+	// The right columns are gathered a run of matches from the same materialized chunk at a time
+	SelectionVector right_sel(STANDARD_VECTOR_SIZE);
+	for (idx_t run_start = 0; run_start < count;) {
+		auto chunk_idx = gstate.entries[matches[run_start].second].chunk_idx;
+		idx_t run_count = 0;
+		for (; run_start + run_count < count; run_count++) {
+			auto &entry = gstate.entries[matches[run_start + run_count].second];
+			if (entry.chunk_idx != chunk_idx) {
+				break;
+			}
+			right_sel.set_index(run_count, entry.row_idx);
+		}
+		auto &right_chunk = *gstate.chunks[chunk_idx];
+		for (idx_t col_idx = 0; col_idx < right_chunk.ColumnCount(); col_idx++) {
+			VectorOperations::Copy(right_chunk.data[col_idx], chunk.data[left_columns + col_idx], right_sel, run_count,
+			                       0, run_start);
+		}
+		run_start += run_count;
+	}
+	chunk.SetCardinality(count);
+
+	state.match_offset += count;
+	if (state.match_offset < state.matches.size()) {
+		return OperatorResultType::HAVE_MORE_OUTPUT;
+	}
+	state.probed = false;
+	return OperatorResultType::NEED_MORE_INPUT;
+}
+
+string PhysicalSpatialJoin::GetName() const {
+	return "SPATIAL_JOIN";
+}
+
+string PhysicalSpatialJoin::ParamsToString() const {
+	return condition.ToString();
+}
+
+} // namespace duckdb
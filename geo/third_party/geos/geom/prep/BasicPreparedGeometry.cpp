@@ -0,0 +1,110 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2006 Refractions Research Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: geom/prep/BasicPreparedGeometry.java rev. 1.5 (JTS-1.10)
+ *
+ **********************************************************************/
+
+#include <geos/algorithm/PointLocator.hpp>
+#include <geos/geom/Envelope.hpp>
+#include <geos/geom/Geometry.hpp>
+#include <geos/geom/Location.hpp>
+#include <geos/geom/prep/BasicPreparedGeometry.hpp>
+#include <geos/geom/util/ComponentCoordinateExtracter.hpp>
+
+namespace geos {
+namespace geom { // geos.geom
+namespace prep { // geos.geom.prep
+
+/*            *
+ * protected: *
+ *            */
+
+void BasicPreparedGeometry::setGeometry(const geom::Geometry *geom) {
+	baseGeom = geom;
+	geom::util::ComponentCoordinateExtracter::getCoordinates(*baseGeom, representativePts);
+}
+
+bool BasicPreparedGeometry::envelopesIntersect(const geom::Geometry *g) const {
+	return baseGeom->getEnvelopeInternal()->intersects(g->getEnvelopeInternal());
+}
+
+bool BasicPreparedGeometry::envelopeCovers(const geom::Geometry *g) const {
+	return baseGeom->getEnvelopeInternal()->covers(*g->getEnvelopeInternal());
+}
+
+/*
+ * public:
+ */
+BasicPreparedGeometry::BasicPreparedGeometry(const Geometry *geom) {
+	setGeometry(geom);
+}
+
+bool BasicPreparedGeometry::isAnyTargetComponentInTest(const geom::Geometry *testGeom) const {
+	algorithm::PointLocator locator;
+
+	for (const CoordinateXY *c : representativePts) {
+		if (locator.locate(*c, testGeom) != Location::EXTERIOR) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool BasicPreparedGeometry::contains(const geom::Geometry *g) const {
+	return baseGeom->contains(g);
+}
+
+bool BasicPreparedGeometry::containsProperly(const geom::Geometry *g) const {
+	// since raw relate is used, provide some optimizations
+
+	// short-circuit test
+	if (!envelopeCovers(g)) {
+		return false;
+	}
+
+	// otherwise, compute using relate mask
+	return baseGeom->relate(g, "T**FF*FF*");
+}
+
+bool BasicPreparedGeometry::coveredBy(const geom::Geometry *g) const {
+	return baseGeom->relate(g, "**F**F***");
+}
+
+bool BasicPreparedGeometry::covers(const geom::Geometry *g) const {
+	if (!envelopeCovers(g)) {
+		return false;
+	}
+	return baseGeom->relate(g, "******FF*");
+}
+
+bool BasicPreparedGeometry::disjoint(const geom::Geometry *g) const {
+	return !intersects(g);
+}
+
+bool BasicPreparedGeometry::intersects(const geom::Geometry *g) const {
+	return baseGeom->intersects(g);
+}
+
+bool BasicPreparedGeometry::touches(const geom::Geometry *g) const {
+	return baseGeom->touches(g);
+}
+
+bool BasicPreparedGeometry::within(const geom::Geometry *g) const {
+	return g->contains(baseGeom);
+}
+
+} // namespace prep
+} // namespace geom
+} // namespace geos
@@ -0,0 +1,62 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2006 Refractions Research Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: geom/prep/PreparedLineString.java rev 1.3 (JTS-1.10)
+ *
+ **********************************************************************/
+
+#include <geos/geom/prep/PreparedLineString.hpp>
+#include <geos/geom/prep/PreparedLineStringIntersects.hpp>
+#include <geos/noding/FastSegmentSetIntersectionFinder.hpp>
+#include <geos/noding/SegmentStringUtil.hpp>
+
+namespace geos {
+namespace geom { // geos.geom
+namespace prep { // geos.geom.prep
+
+/*
+ * public:
+ */
+PreparedLineString::~PreparedLineString() {
+	for (std::size_t i = 0, ni = segStrings.size(); i < ni; i++) {
+		delete segStrings[i];
+	}
+}
+
+noding::FastSegmentSetIntersectionFinder *PreparedLineString::getIntersectionFinder() const {
+	if (!segIntFinder) {
+		noding::SegmentStringUtil::extractSegmentStrings(&getGeometry(), segStrings);
+		segIntFinder.reset(new noding::FastSegmentSetIntersectionFinder(&segStrings));
+	}
+	return segIntFinder.get();
+}
+
+bool PreparedLineString::intersects(const geom::Geometry *g) const {
+	if (!envelopesIntersect(g)) {
+		return false;
+	}
+
+	// mixed collections are not handled by the prepared algorithm
+	if (g->getGeometryTypeId() == GEOS_GEOMETRYCOLLECTION) {
+		return BasicPreparedGeometry::intersects(g);
+	}
+
+	PreparedLineString &prep = *(const_cast<PreparedLineString *>(this));
+
+	return PreparedLineStringIntersects::intersects(prep, g);
+}
+
+} // namespace prep
+} // namespace geom
+} // namespace geos
@@ -0,0 +1,84 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2006 Refractions Research Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: geom/prep/PreparedLineStringIntersects.java r338 (JTS-1.12)
+ *
+ **********************************************************************/
+
+#include <geos/algorithm/PointLocator.hpp>
+#include <geos/geom/Location.hpp>
+#include <geos/geom/prep/PreparedLineStringIntersects.hpp>
+#include <geos/geom/util/ComponentCoordinateExtracter.hpp>
+#include <geos/noding/SegmentStringUtil.hpp>
+
+namespace geos {
+namespace geom { // geos.geom
+namespace prep { // geos.geom.prep
+
+bool PreparedLineStringIntersects::isAnyTestPointInTarget(const geom::Geometry *testGeom) const {
+	/*
+	 * This could be optimized by using the segment index on the lineal target.
+	 * However, it seems like the L/P case would be pretty rare in practice.
+	 */
+	algorithm::PointLocator locator;
+
+	std::vector<const geom::CoordinateXY *> coords;
+	geom::util::ComponentCoordinateExtracter::getCoordinates(*testGeom, coords);
+
+	for (const geom::CoordinateXY *c : coords) {
+		if (locator.locate(*c, &(prepLine.getGeometry())) != geom::Location::EXTERIOR) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool PreparedLineStringIntersects::intersects(const geom::Geometry *g) const {
+	noding::SegmentString::ConstVect lineSegStr;
+	noding::SegmentStringUtil::extractSegmentStrings(g, lineSegStr);
+
+	bool segsIntersect = false;
+	if (!lineSegStr.empty()) {
+		segsIntersect = prepLine.getIntersectionFinder()->intersects(&lineSegStr);
+	}
+
+	for (std::size_t i = 0, ni = lineSegStr.size(); i < ni; i++) {
+		delete lineSegStr[i];
+	}
+
+	if (segsIntersect) {
+		return true;
+	}
+
+	// For L/L case we are done
+	if (g->getDimension() == 1) {
+		return false;
+	}
+
+	// For L/A case, need to check for proper inclusion of the target in the test
+	if (g->getDimension() == 2 && prepLine.isAnyTargetComponentInTest(g)) {
+		return true;
+	}
+
+	// For L/P case, need to check if any points lie on line(s)
+	if (g->isPuntal()) {
+		return isAnyTestPointInTarget(g);
+	}
+
+	return false;
+}
+
+} // namespace prep
+} // namespace geom
+} // namespace geos
@@ -0,0 +1,36 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2006 Refractions Research Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: geom/prep/PreparedPoint.java rev. 1.2 (JTS-1.10)
+ *
+ **********************************************************************/
+
+#include <geos/geom/prep/PreparedPoint.hpp>
+
+namespace geos {
+namespace geom { // geos.geom
+namespace prep { // geos.geom.prep
+
+bool PreparedPoint::intersects(const geom::Geometry *g) const {
+	if (!envelopesIntersect(g)) {
+		return false;
+	}
+
+	// This avoids computing topology for the test geometry
+	return isAnyTargetComponentInTest(g);
+}
+
+} // namespace prep
+} // namespace geom
+} // namespace geos
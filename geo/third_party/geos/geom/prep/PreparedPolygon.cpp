@@ -0,0 +1,122 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2006 Refractions Research Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: geom/prep/PreparedPolygon.java rev 1.7 (JTS-1.10)
+ *
+ **********************************************************************/
+
+#include <geos/algorithm/locate/IndexedPointInAreaLocator.hpp>
+#include <geos/algorithm/locate/PointOnGeometryLocator.hpp>
+#include <geos/geom/Polygon.hpp>
+#include <geos/geom/prep/PreparedPolygon.hpp>
+#include <geos/geom/prep/PreparedPolygonContains.hpp>
+#include <geos/geom/prep/PreparedPolygonCovers.hpp>
+#include <geos/geom/prep/PreparedPolygonIntersects.hpp>
+#include <geos/noding/FastSegmentSetIntersectionFinder.hpp>
+#include <geos/noding/SegmentStringUtil.hpp>
+#include <geos/operation/predicate/RectangleContains.hpp>
+#include <geos/operation/predicate/RectangleIntersects.hpp>
+
+namespace geos {
+namespace geom { // geos.geom
+namespace prep { // geos.geom.prep
+
+//
+// public:
+//
+PreparedPolygon::PreparedPolygon(const geom::Geometry *geom) : BasicPreparedGeometry(geom) {
+	isRectangle = getGeometry().isRectangle();
+}
+
+PreparedPolygon::~PreparedPolygon() {
+	for (std::size_t i = 0, ni = segStrings.size(); i < ni; i++) {
+		delete segStrings[i];
+	}
+}
+
+noding::FastSegmentSetIntersectionFinder *PreparedPolygon::getIntersectionFinder() const {
+	if (!segIntFinder) {
+		noding::SegmentStringUtil::extractSegmentStrings(&getGeometry(), segStrings);
+		segIntFinder.reset(new noding::FastSegmentSetIntersectionFinder(&segStrings));
+	}
+	return segIntFinder.get();
+}
+
+algorithm::locate::PointOnGeometryLocator *PreparedPolygon::getPointLocator() const {
+	if (!ptOnGeomLoc) {
+		ptOnGeomLoc.reset(new algorithm::locate::IndexedPointInAreaLocator(getGeometry()));
+	}
+	return ptOnGeomLoc.get();
+}
+
+bool PreparedPolygon::contains(const geom::Geometry *g) const {
+	// short-circuit test
+	if (!envelopeCovers(g)) {
+		return false;
+	}
+
+	// optimization - rectangles always have no holes and are convex
+	if (isRectangle) {
+		const geom::Polygon *poly = dynamic_cast<const geom::Polygon *>(&getGeometry());
+		return operation::predicate::RectangleContains::contains(*poly, *g);
+	}
+
+	// mixed collections are not handled by the prepared algorithms
+	if (g->getGeometryTypeId() == GEOS_GEOMETRYCOLLECTION) {
+		return BasicPreparedGeometry::contains(g);
+	}
+
+	return PreparedPolygonContains::contains(this, g);
+}
+
+bool PreparedPolygon::covers(const geom::Geometry *g) const {
+	// short-circuit test
+	if (!envelopeCovers(g)) {
+		return false;
+	}
+
+	// optimization - rectangle arguments are always covered.
+	if (isRectangle) {
+		return true;
+	}
+
+	if (g->getGeometryTypeId() == GEOS_GEOMETRYCOLLECTION) {
+		return BasicPreparedGeometry::covers(g);
+	}
+
+	return PreparedPolygonCovers::covers(this, g);
+}
+
+bool PreparedPolygon::intersects(const geom::Geometry *g) const {
+	// envelope test
+	if (!envelopesIntersect(g)) {
+		return false;
+	}
+
+	// optimization - rectangles always have no holes and are convex
+	if (isRectangle) {
+		const geom::Polygon *poly = dynamic_cast<const geom::Polygon *>(&getGeometry());
+		return operation::predicate::RectangleIntersects::intersects(*poly, *g);
+	}
+
+	if (g->getGeometryTypeId() == GEOS_GEOMETRYCOLLECTION) {
+		return BasicPreparedGeometry::intersects(g);
+	}
+
+	return PreparedPolygonIntersects::intersects(this, g);
+}
+
+} // namespace prep
+} // namespace geom
+} // namespace geos
@@ -0,0 +1,48 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2006 Refractions Research Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: geom/prep/PreparedPolygonCovers.java rev 1.5 (JTS-1.10)
+ *
+ **********************************************************************/
+
+#include <geos/geom/Geometry.hpp>
+#include <geos/geom/prep/AbstractPreparedPolygonContains.hpp>
+#include <geos/geom/prep/PreparedPolygon.hpp>
+#include <geos/geom/prep/PreparedPolygonCovers.hpp>
+
+namespace geos {
+namespace geom { // geos.geom
+namespace prep { // geos.geom.prep
+
+//
+// private:
+//
+
+//
+// protected:
+//
+bool PreparedPolygonCovers::fullTopologicalPredicate(const geom::Geometry *geom) {
+	bool result = prepPoly->getGeometry().relate(geom, "******FF*");
+	return result;
+}
+
+//
+// public:
+//
+PreparedPolygonCovers::PreparedPolygonCovers(const PreparedPolygon *const prepPoly) : AbstractPreparedPolygonContains(prepPoly, false) {
+}
+
+} // namespace prep
+} // namespace geom
+} // namespace geos
@@ -0,0 +1,109 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2006 Refractions Research Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: geom/prep/PreparedPolygonPredicate.java rev. 1.4 (JTS-1.10)
+ * (2009-07-15)
+ *
+ **********************************************************************/
+
+#include <geos/algorithm/locate/PointOnGeometryLocator.hpp>
+#include <geos/algorithm/locate/SimplePointInAreaLocator.hpp>
+#include <geos/geom/Geometry.hpp>
+#include <geos/geom/Location.hpp>
+#include <geos/geom/prep/PreparedPolygon.hpp>
+#include <geos/geom/prep/PreparedPolygonPredicate.hpp>
+#include <geos/geom/util/ComponentCoordinateExtracter.hpp>
+
+namespace geos {
+namespace geom { // geos.geom
+namespace prep { // geos.geom.prep
+
+//
+// private:
+//
+
+//
+// protected:
+//
+
+bool PreparedPolygonPredicate::isAllTestComponentsInTarget(const geom::Geometry *testGeom) const {
+	std::vector<const geom::CoordinateXY *> pts;
+	geom::util::ComponentCoordinateExtracter::getCoordinates(*testGeom, pts);
+
+	for (const geom::CoordinateXY *pt : pts) {
+		const geom::Location loc = prepPoly->getPointLocator()->locate(pt);
+		if (geom::Location::EXTERIOR == loc) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool PreparedPolygonPredicate::isAllTestComponentsInTargetInterior(const geom::Geometry *testGeom) const {
+	std::vector<const geom::CoordinateXY *> pts;
+	geom::util::ComponentCoordinateExtracter::getCoordinates(*testGeom, pts);
+
+	for (const geom::CoordinateXY *pt : pts) {
+		const geom::Location loc = prepPoly->getPointLocator()->locate(pt);
+		if (geom::Location::INTERIOR != loc) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool PreparedPolygonPredicate::isAnyTestComponentInTarget(const geom::Geometry *testGeom) const {
+	std::vector<const geom::CoordinateXY *> pts;
+	geom::util::ComponentCoordinateExtracter::getCoordinates(*testGeom, pts);
+
+	for (const geom::CoordinateXY *pt : pts) {
+		const geom::Location loc = prepPoly->getPointLocator()->locate(pt);
+		if (geom::Location::EXTERIOR != loc) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool PreparedPolygonPredicate::isAnyTestComponentInTargetInterior(const geom::Geometry *testGeom) const {
+	std::vector<const geom::CoordinateXY *> pts;
+	geom::util::ComponentCoordinateExtracter::getCoordinates(*testGeom, pts);
+
+	for (const geom::CoordinateXY *pt : pts) {
+		const geom::Location loc = prepPoly->getPointLocator()->locate(pt);
+		if (geom::Location::INTERIOR == loc) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool PreparedPolygonPredicate::isAnyTargetComponentInAreaTest(
+    const geom::Geometry *testGeom, const std::vector<const geom::CoordinateXY *> *targetRepPts) const {
+	for (const geom::CoordinateXY *pt : *targetRepPts) {
+		const geom::Location loc = algorithm::locate::SimplePointInAreaLocator::locate(*pt, testGeom);
+		if (geom::Location::EXTERIOR != loc) {
+			return true;
+		}
+	}
+	return false;
+}
+
+//
+// public:
+//
+
+} // namespace prep
+} // namespace geom
+} // namespace geos
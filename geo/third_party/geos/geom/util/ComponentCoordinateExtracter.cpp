@@ -0,0 +1,52 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2006 Refractions Research Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/geom/Geometry.hpp>
+#include <geos/geom/GeometryComponentFilter.hpp>
+#include <geos/geom/LineString.hpp>
+#include <geos/geom/Point.hpp>
+#include <geos/geom/util/ComponentCoordinateExtracter.hpp>
+#include <vector>
+
+namespace geos {
+namespace geom { // geos.geom
+namespace util { // geos.geom.util
+
+ComponentCoordinateExtracter::ComponentCoordinateExtracter(std::vector<const CoordinateXY *> &newComps)
+    : comps(newComps) {
+}
+
+void ComponentCoordinateExtracter::filter_rw(Geometry *geom) {
+	filter_ro(geom);
+}
+
+void ComponentCoordinateExtracter::filter_ro(const Geometry *geom) {
+	if (geom->isEmpty()) {
+		return;
+	}
+	// Polygons contribute through their rings, collections through their elements
+	if (geom->getGeometryTypeId() == GEOS_POINT || geom->getGeometryTypeId() == GEOS_LINESTRING ||
+	    geom->getGeometryTypeId() == GEOS_LINEARRING) {
+		comps.push_back(geom->getCoordinate());
+	}
+}
+
+void ComponentCoordinateExtracter::getCoordinates(const Geometry &geom, std::vector<const CoordinateXY *> &ret) {
+	ComponentCoordinateExtracter cce(ret);
+	geom.apply_ro(&cce);
+}
+
+} // namespace util
+} // namespace geom
+} // namespace geos
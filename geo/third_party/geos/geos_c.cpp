@@ -17,6 +17,7 @@
 
 #include <geos/geom/CoordinateSequence.hpp>
 #include <geos/geom/Geometry.hpp>
+#include <geos/geom/prep/PreparedGeometry.hpp>
 #include <geos/index/strtree/STRtree.hpp>
 #include <geos/util/Interrupt.hpp>
 #include <new>
@@ -26,6 +27,7 @@
 #define GEOSGeometry      geos::geom::Geometry
 #define GEOSCoordSequence geos::geom::CoordinateSequence
 #define GEOSSTRtree       geos::index::strtree::STRtree
+#define GEOSPreparedGeometry geos::geom::prep::PreparedGeometry
 typedef struct GEOSBufParams_t GEOSBufferParams;
 
 #include "geos_c.hpp"
@@ -37,19 +39,48 @@ using geos::geom::Geometry;
 // ## GLOBALS ################################################
 
 // NOTE: SRID will have to be changed after geometry creation
-GEOSContextHandle_t handle = NULL;
+
+namespace {
+
+// Owns the context of one thread and releases it when the thread exits
+struct GEOSThreadContext {
+	GEOSContextHandle_t handle = NULL;
+	GEOSMessageHandler notice = NULL;
+	GEOSMessageHandler error = NULL;
+
+	~GEOSThreadContext() {
+		if (handle) {
+			GEOS_finish_r(handle);
+		}
+	}
+};
+
+thread_local GEOSThreadContext context;
+
+} // namespace
+
+// Context used by the non-reentrant wrappers below, one per thread
+thread_local GEOSContextHandle_t handle = NULL;
 
 extern "C" {
 
 void initGEOS(GEOSMessageHandler nf, GEOSMessageHandler ef) {
-	if (!handle) {
-		handle = initGEOS_r(nf, ef);
-	} else {
+	if (!context.handle) {
+		context.handle = initGEOS_r(nf, ef);
+		context.notice = nf;
+		context.error = ef;
+		handle = context.handle;
+	} else if (context.notice != nf || context.error != ef) {
 		GEOSContext_setNoticeHandler_r(handle, nf);
 		GEOSContext_setErrorHandler_r(handle, ef);
+		context.notice = nf;
+		context.error = ef;
 	}
 
-	geos::util::Interrupt::cancel();
+	// The interrupt flag is shared by all threads, only touch it when set
+	if (geos::util::Interrupt::check()) {
+		geos::util::Interrupt::cancel();
+	}
 }
 
 // Return postgis geometry type index
@@ -198,6 +229,10 @@ void GEOSGeom_destroy(Geometry *a) {
 	return GEOSGeom_destroy_r(handle, a);
 }
 
+Geometry *GEOSGeom_clone(const Geometry *g) {
+	return GEOSGeom_clone_r(handle, g);
+}
+
 //-------------------------------------------------------------------
 // GEOS functions that return geometries
 //-------------------------------------------------------------------
@@ -234,6 +269,46 @@ Geometry *GEOSGetCentroid(const Geometry *g) {
 // Prepared Geometry
 //-----------------------------------------------------------------
 
+const geos::geom::prep::PreparedGeometry *GEOSPrepare(const Geometry *g) {
+	return GEOSPrepare_r(handle, g);
+}
+
+void GEOSPreparedGeom_destroy(const geos::geom::prep::PreparedGeometry *a) {
+	GEOSPreparedGeom_destroy_r(handle, a);
+}
+
+char GEOSPreparedContains(const geos::geom::prep::PreparedGeometry *pg1, const Geometry *g2) {
+	return GEOSPreparedContains_r(handle, pg1, g2);
+}
+
+char GEOSPreparedContainsProperly(const geos::geom::prep::PreparedGeometry *pg1, const Geometry *g2) {
+	return GEOSPreparedContainsProperly_r(handle, pg1, g2);
+}
+
+char GEOSPreparedCoveredBy(const geos::geom::prep::PreparedGeometry *pg1, const Geometry *g2) {
+	return GEOSPreparedCoveredBy_r(handle, pg1, g2);
+}
+
+char GEOSPreparedCovers(const geos::geom::prep::PreparedGeometry *pg1, const Geometry *g2) {
+	return GEOSPreparedCovers_r(handle, pg1, g2);
+}
+
+char GEOSPreparedDisjoint(const geos::geom::prep::PreparedGeometry *pg1, const Geometry *g2) {
+	return GEOSPreparedDisjoint_r(handle, pg1, g2);
+}
+
+char GEOSPreparedIntersects(const geos::geom::prep::PreparedGeometry *pg1, const Geometry *g2) {
+	return GEOSPreparedIntersects_r(handle, pg1, g2);
+}
+
+char GEOSPreparedTouches(const geos::geom::prep::PreparedGeometry *pg1, const Geometry *g2) {
+	return GEOSPreparedTouches_r(handle, pg1, g2);
+}
+
+char GEOSPreparedWithin(const geos::geom::prep::PreparedGeometry *pg1, const Geometry *g2) {
+	return GEOSPreparedWithin_r(handle, pg1, g2);
+}
+
 GEOSBufferParams *GEOSBufferParams_create() {
 	return GEOSBufferParams_create_r(handle);
 }
@@ -24,6 +24,8 @@
 #include <geos/geom/GeometryFactory.hpp>
 #include <geos/geom/LineString.hpp>
 #include <geos/geom/Point.hpp>
+#include <geos/geom/prep/PreparedGeometry.hpp>
+#include <geos/geom/prep/PreparedGeometryFactory.hpp>
 #include <geos/index/strtree/SimpleSTRtree.hpp>
 #include <geos/operation/buffer/BufferOp.hpp>
 #include <geos/operation/buffer/BufferParameters.hpp>
@@ -52,6 +54,7 @@
 #define GEOSCoordSequence geos::geom::CoordinateSequence
 #define GEOSBufferParams  geos::operation::buffer::BufferParameters
 #define GEOSSTRtree       geos::index::strtree::SimpleSTRtree
+#define GEOSPreparedGeometry geos::geom::prep::PreparedGeometry
 
 #include "geos_c.hpp"
 
@@ -290,6 +293,11 @@ GEOSContextHandle_t GEOS_init_r() {
 	return static_cast<GEOSContextHandle_t>(handle);
 }
 
+void GEOS_finish_r(GEOSContextHandle_t extHandle) {
+	GEOSContextHandleInternal_t *handle = reinterpret_cast<GEOSContextHandleInternal_t *>(extHandle);
+	delete handle;
+}
+
 // Return postgis geometry type index
 int GEOSGeomTypeId_r(GEOSContextHandle_t extHandle, const Geometry *g1) {
 	return execute(extHandle, -1, [&]() { return static_cast<int>(g1->getGeometryTypeId()); });
@@ -659,6 +667,10 @@ void GEOSGeom_destroy_r(GEOSContextHandle_t extHandle, Geometry *a) {
 	});
 }
 
+Geometry *GEOSGeom_clone_r(GEOSContextHandle_t extHandle, const Geometry *g) {
+	return execute(extHandle, [&]() { return g->clone().release(); });
+}
+
 //-------------------------------------------------------------------
 // GEOS functions that return geometries
 //-------------------------------------------------------------------
@@ -872,4 +884,56 @@ char GEOSRelatePattern_r(GEOSContextHandle_t extHandle, const Geometry *g1, cons
 	});
 }
 
+//-----------------------------------------------------------------
+// Prepared Geometry
+//-----------------------------------------------------------------
+
+const geos::geom::prep::PreparedGeometry *GEOSPrepare_r(GEOSContextHandle_t extHandle, const Geometry *g) {
+	return execute(extHandle, [&]() { return geos::geom::prep::PreparedGeometryFactory::prepare(g).release(); });
+}
+
+void GEOSPreparedGeom_destroy_r(GEOSContextHandle_t extHandle, const geos::geom::prep::PreparedGeometry *a) {
+	execute(extHandle, [&]() { delete a; });
+}
+
+char GEOSPreparedContains_r(GEOSContextHandle_t extHandle, const geos::geom::prep::PreparedGeometry *pg,
+                            const Geometry *g) {
+	return execute(extHandle, 2, [&]() { return pg->contains(g); });
+}
+
+char GEOSPreparedContainsProperly_r(GEOSContextHandle_t extHandle, const geos::geom::prep::PreparedGeometry *pg,
+                                    const Geometry *g) {
+	return execute(extHandle, 2, [&]() { return pg->containsProperly(g); });
+}
+
+char GEOSPreparedCoveredBy_r(GEOSContextHandle_t extHandle, const geos::geom::prep::PreparedGeometry *pg,
+                             const Geometry *g) {
+	return execute(extHandle, 2, [&]() { return pg->coveredBy(g); });
+}
+
+char GEOSPreparedCovers_r(GEOSContextHandle_t extHandle, const geos::geom::prep::PreparedGeometry *pg,
+                          const Geometry *g) {
+	return execute(extHandle, 2, [&]() { return pg->covers(g); });
+}
+
+char GEOSPreparedDisjoint_r(GEOSContextHandle_t extHandle, const geos::geom::prep::PreparedGeometry *pg,
+                            const Geometry *g) {
+	return execute(extHandle, 2, [&]() { return pg->disjoint(g); });
+}
+
+char GEOSPreparedIntersects_r(GEOSContextHandle_t extHandle, const geos::geom::prep::PreparedGeometry *pg,
+                              const Geometry *g) {
+	return execute(extHandle, 2, [&]() { return pg->intersects(g); });
+}
+
+char GEOSPreparedTouches_r(GEOSContextHandle_t extHandle, const geos::geom::prep::PreparedGeometry *pg,
+                           const Geometry *g) {
+	return execute(extHandle, 2, [&]() { return pg->touches(g); });
+}
+
+char GEOSPreparedWithin_r(GEOSContextHandle_t extHandle, const geos::geom::prep::PreparedGeometry *pg,
+                          const Geometry *g) {
+	return execute(extHandle, 2, [&]() { return pg->within(g); });
+}
+
 } /* extern "C" */
@@ -0,0 +1,146 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2006 Refractions Research Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: geom/prep/PreparedGeometry.java rev. 1.11 (JTS-1.10)
+ *
+ **********************************************************************/
+
+#pragma once
+
+#include <geos/export.hpp>
+
+namespace geos {
+namespace geom {
+class Geometry;
+}
+} // namespace geos
+
+namespace geos {
+namespace geom { // geos::geom
+namespace prep { // geos::geom::prep
+
+/**
+ * \class PreparedGeometry
+ *
+ * \brief
+ * An interface for classes which prepare {@link Geometry}s
+ * in order to optimize the performance
+ * of repeated calls to specific geometric operations.
+ *
+ * A given implementation may provide optimized implementations
+ * for only some of the specified methods,
+ * and delegate the remaining methods to the original {@link Geometry} operations.
+ * An implementation may also only optimize certain situations,
+ * and delegate others.
+ * See the implementing classes for documentation about which methods and situations
+ * they optimize.
+ *
+ * The indexes of the prepared state are built lazily and are not
+ * guarded, so a PreparedGeometry must not be shared between threads.
+ */
+class GEOS_DLL PreparedGeometry {
+public:
+	virtual ~PreparedGeometry() {
+	}
+
+	/** \brief
+	 * Gets the original {@link Geometry} which has been prepared.
+	 *
+	 * @return the base geometry
+	 */
+	virtual const geom::Geometry &getGeometry() const = 0;
+
+	/** \brief
+	 * Tests whether the base {@link Geometry} contains a given geometry.
+	 *
+	 * @param geom the Geometry to test
+	 * @return true if this Geometry contains the given Geometry
+	 *
+	 * @see Geometry#contains(Geometry)
+	 */
+	virtual bool contains(const geom::Geometry *geom) const = 0;
+
+	/** \brief
+	 * Tests whether the base {@link Geometry} properly contains
+	 * a given geometry.
+	 *
+	 * The <code>containsProperly</code> predicate has the following
+	 * equivalent definitions:
+	 *
+	 * - Every point of the other geometry is a point of this
+	 *   geometry's interior.
+	 * - The DE-9IM Intersection Matrix for the two geometries matches
+	 *   <code>[T**FF*FF*]</code>
+	 *
+	 * @param geom the Geometry to test
+	 * @return true if this Geometry properly contains the given Geometry
+	 */
+	virtual bool containsProperly(const geom::Geometry *geom) const = 0;
+
+	/** \brief
+	 * Tests whether the base {@link Geometry} is covered by a given geometry.
+	 *
+	 * @param geom the Geometry to test
+	 * @return true if this Geometry is covered by the given Geometry
+	 */
+	virtual bool coveredBy(const geom::Geometry *geom) const = 0;
+
+	/** \brief
+	 * Tests whether the base {@link Geometry} covers a given geometry.
+	 *
+	 * @param geom the Geometry to test
+	 * @return true if this Geometry covers the given Geometry
+	 */
+	virtual bool covers(const geom::Geometry *geom) const = 0;
+
+	/** \brief
+	 * Tests whether the base {@link Geometry} is disjoint from a given geometry.
+	 *
+	 * This method supports {@link GeometryCollection}s as input
+	 *
+	 * @param geom the Geometry to test
+	 * @return true if this Geometry is disjoint from the given Geometry
+	 */
+	virtual bool disjoint(const geom::Geometry *geom) const = 0;
+
+	/** \brief
+	 * Tests whether the base {@link Geometry} intersects a given geometry.
+	 *
+	 * This method supports {@link GeometryCollection}s as input
+	 *
+	 * @param geom the Geometry to test
+	 * @return true if this Geometry intersects the given Geometry
+	 */
+	virtual bool intersects(const geom::Geometry *geom) const = 0;
+
+	/** \brief
+	 * Tests whether the base {@link Geometry} touches a given geometry.
+	 *
+	 * @param geom the Geometry to test
+	 * @return true if this Geometry touches the given Geometry
+	 */
+	virtual bool touches(const geom::Geometry *geom) const = 0;
+
+	/** \brief
+	 * Tests whether the base {@link Geometry} is within a given geometry.
+	 *
+	 * @param geom the Geometry to test
+	 * @return true if this Geometry is within the given Geometry
+	 */
+	virtual bool within(const geom::Geometry *geom) const = 0;
+};
+
+} // namespace prep
+} // namespace geom
+} // namespace geos
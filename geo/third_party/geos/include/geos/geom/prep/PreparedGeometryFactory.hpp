@@ -0,0 +1,74 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2006 Refractions Research Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: geom/prep/PreparedGeometryFactory.java rev. 1.4 (JTS-1.10)
+ *
+ **********************************************************************/
+
+#pragma once
+
+#include <geos/geom/prep/PreparedGeometry.hpp>
+
+#include <memory>
+
+namespace geos {
+namespace geom {
+class Geometry;
+}
+} // namespace geos
+
+namespace geos {
+namespace geom { // geos::geom
+namespace prep { // geos::geom::prep
+
+/**
+ * \brief
+ * A factory for creating {@link PreparedGeometry}s.
+ *
+ * It chooses an appropriate implementation of PreparedGeometry
+ * based on the geometric type of the input geometry.
+ * In the future, the factory may accept hints that indicate
+ * special optimizations which can be performed.
+ *
+ * The returned PreparedGeometry keeps a reference to the input
+ * geometry, which must outlive it.
+ *
+ * @author Martin Davis
+ *
+ */
+class PreparedGeometryFactory {
+public:
+	/**
+	 * Creates a new {@link PreparedGeometry} appropriate for the argument {@link Geometry}.
+	 *
+	 * @param geom the geometry to prepare
+	 * @return the prepared geometry
+	 */
+	static std::unique_ptr<PreparedGeometry> prepare(const geom::Geometry *geom) {
+		PreparedGeometryFactory pf;
+		return pf.create(geom);
+	}
+
+	/**
+	 * Creates a new {@link PreparedGeometry} appropriate for the argument {@link Geometry}.
+	 *
+	 * @param geom the geometry to prepare
+	 * @return the prepared geometry
+	 */
+	std::unique_ptr<PreparedGeometry> create(const geom::Geometry *geom) const;
+};
+
+} // namespace prep
+} // namespace geom
+} // namespace geos
@@ -0,0 +1,60 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2006 Refractions Research Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: geom/prep/PreparedLineString.java rev 1.3 (JTS-1.10)
+ *
+ **********************************************************************/
+
+#pragma once
+
+#include <geos/geom/prep/BasicPreparedGeometry.hpp> // for inheritance
+#include <geos/noding/FastSegmentSetIntersectionFinder.hpp>
+#include <geos/noding/SegmentString.hpp>
+
+#include <memory>
+
+namespace geos {
+namespace geom { // geos::geom
+namespace prep { // geos::geom::prep
+
+/**
+ * \brief
+ * A prepared version of {@link LinearRing}, {@link LineString} or {@link MultiLineString} geometries.
+ *
+ * @author mbdavis
+ *
+ */
+class PreparedLineString : public BasicPreparedGeometry {
+private:
+	mutable std::unique_ptr<noding::FastSegmentSetIntersectionFinder> segIntFinder;
+	mutable noding::SegmentString::ConstVect segStrings;
+
+	// Declare type as noncopyable
+	PreparedLineString(const PreparedLineString &other) = delete;
+	PreparedLineString &operator=(const PreparedLineString &rhs) = delete;
+
+public:
+	PreparedLineString(const Geometry *geom) : BasicPreparedGeometry(geom) {
+	}
+
+	~PreparedLineString() override;
+
+	noding::FastSegmentSetIntersectionFinder *getIntersectionFinder() const;
+
+	bool intersects(const geom::Geometry *g) const override;
+};
+
+} // namespace prep
+} // namespace geom
+} // namespace geos
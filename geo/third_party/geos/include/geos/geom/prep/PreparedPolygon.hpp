@@ -0,0 +1,67 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2006 Refractions Research Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: geom/prep/PreparedPolygon.java rev 1.7 (JTS-1.10)
+ *
+ **********************************************************************/
+
+#pragma once
+
+#include <geos/algorithm/locate/PointOnGeometryLocator.hpp>
+#include <geos/geom/prep/BasicPreparedGeometry.hpp> // for inheritance
+#include <geos/noding/FastSegmentSetIntersectionFinder.hpp>
+#include <geos/noding/SegmentString.hpp>
+
+#include <memory>
+
+namespace geos {
+namespace geom { // geos::geom
+namespace prep { // geos::geom::prep
+
+/**
+ * \brief
+ * A prepared version of {@link Polygon} or {@link MultiPolygon} geometries.
+ *
+ * The segment index and point-in-area index are built lazily, the first
+ * time a predicate needs them, and reused for every later test.
+ *
+ * @author mbdavis
+ *
+ */
+class PreparedPolygon : public BasicPreparedGeometry {
+private:
+	bool isRectangle;
+	mutable std::unique_ptr<noding::FastSegmentSetIntersectionFinder> segIntFinder;
+	mutable std::unique_ptr<algorithm::locate::PointOnGeometryLocator> ptOnGeomLoc;
+	mutable noding::SegmentString::ConstVect segStrings;
+
+	// Declare type as noncopyable
+	PreparedPolygon(const PreparedPolygon &other) = delete;
+	PreparedPolygon &operator=(const PreparedPolygon &rhs) = delete;
+
+public:
+	PreparedPolygon(const geom::Geometry *geom);
+	~PreparedPolygon() override;
+
+	noding::FastSegmentSetIntersectionFinder *getIntersectionFinder() const;
+	algorithm::locate::PointOnGeometryLocator *getPointLocator() const;
+
+	bool contains(const geom::Geometry *g) const override;
+	bool covers(const geom::Geometry *g) const override;
+	bool intersects(const geom::Geometry *g) const override;
+};
+
+} // namespace prep
+} // namespace geom
+} // namespace geos
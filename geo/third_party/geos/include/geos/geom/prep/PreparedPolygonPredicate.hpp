@@ -0,0 +1,129 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2006 Refractions Research Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: geom/prep/PreparedPolygonPredicate.java rev. 1.4 (JTS-1.10)
+ * (2009-07-15)
+ *
+ **********************************************************************/
+
+#pragma once
+
+#include <geos/geom/Coordinate.hpp>
+#include <geos/geom/Location.hpp>
+
+namespace geos {
+namespace geom {
+class Geometry;
+
+namespace prep {
+class PreparedPolygon;
+}
+} // namespace geom
+} // namespace geos
+
+namespace geos {
+namespace geom { // geos::geom
+namespace prep { // geos::geom::prep
+
+/**
+ * \brief
+ * A base class for predicate operations on {@link PreparedPolygon}s.
+ *
+ * @author mbdavis
+ *
+ */
+class PreparedPolygonPredicate {
+private:
+	// Declare type as noncopyable
+	PreparedPolygonPredicate(const PreparedPolygonPredicate &other) = delete;
+	PreparedPolygonPredicate &operator=(const PreparedPolygonPredicate &rhs) = delete;
+
+protected:
+	const PreparedPolygon *const prepPoly;
+
+	/** \brief
+	 * Tests whether all components of the test Geometry
+	 * are contained in the target geometry.
+	 *
+	 * Handles both linear and point components.
+	 *
+	 * @param testGeom a geometry to test
+	 * @return true if all components of the argument are contained
+	 *              in the target geometry
+	 */
+	bool isAllTestComponentsInTarget(const geom::Geometry *testGeom) const;
+
+	/** \brief
+	 * Tests whether all components of the test Geometry
+	 * are contained in the interior of the target geometry.
+	 *
+	 * Handles both linear and point components.
+	 *
+	 * @param testGeom a geometry to test
+	 * @return true if all components of the argument are contained in
+	 *              the target geometry interior
+	 */
+	bool isAllTestComponentsInTargetInterior(const geom::Geometry *testGeom) const;
+
+	/** \brief
+	 * Tests whether any component of the test Geometry intersects
+	 * the area of the target geometry.
+	 *
+	 * Handles test geometries with both linear and point components.
+	 *
+	 * @param testGeom a geometry to test
+	 * @return true if any component of the argument intersects the
+	 *              prepared geometry
+	 */
+	bool isAnyTestComponentInTarget(const geom::Geometry *testGeom) const;
+
+	/** \brief
+	 * Tests whether any component of the test Geometry intersects
+	 * the interior of the target geometry.
+	 *
+	 * Handles test geometries with both linear and point components.
+	 *
+	 * @param testGeom a geometry to test
+	 * @return true if any component of the argument intersects the
+	 *              prepared area geometry interior
+	 */
+	bool isAnyTestComponentInTargetInterior(const geom::Geometry *testGeom) const;
+
+	/**
+	 * Tests whether any component of the target geometry
+	 * intersects the test geometry (which must be an areal geometry)
+	 *
+	 * @param testGeom the test geometry
+	 * @param targetRepPts the representative points of the target geometry
+	 * @return true if any component intersects the areal test geometry
+	 */
+	bool isAnyTargetComponentInAreaTest(const geom::Geometry *testGeom,
+	                                    const std::vector<const geom::CoordinateXY *> *targetRepPts) const;
+
+public:
+	/** \brief
+	 * Creates an instance of this operation.
+	 *
+	 * @param p_prepPoly the PreparedPolygon to evaluate
+	 */
+	PreparedPolygonPredicate(const PreparedPolygon *const p_prepPoly) : prepPoly(p_prepPoly) {
+	}
+
+	virtual ~PreparedPolygonPredicate() {
+	}
+};
+
+} // namespace prep
+} // namespace geom
+} // namespace geos
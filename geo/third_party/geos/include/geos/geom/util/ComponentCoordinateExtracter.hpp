@@ -0,0 +1,58 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2006 Refractions Research Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#pragma once
+
+#include <geos/export.hpp>
+#include <geos/geom/Coordinate.hpp>
+#include <geos/geom/GeometryComponentFilter.hpp>
+#include <vector>
+
+namespace geos {
+namespace geom { // geos::geom
+namespace util { // geos::geom::util
+
+/**
+ * Extracts a single representative {@link Coordinate}
+ * from each connected component of a {@link Geometry}.
+ */
+class GEOS_DLL ComponentCoordinateExtracter : public GeometryComponentFilter {
+public:
+	/**
+	 * Push the representative coordinates of the components of the
+	 * given geometry into the provided vector.
+	 */
+	static void getCoordinates(const Geometry &geom, std::vector<const CoordinateXY *> &ret);
+
+	/**
+	 * Constructs a ComponentCoordinateFilter with a list in which
+	 * to store Coordinates found.
+	 */
+	ComponentCoordinateExtracter(std::vector<const CoordinateXY *> &newComps);
+
+	void filter_rw(Geometry *geom) override;
+
+	void filter_ro(const Geometry *geom) override;
+
+private:
+	std::vector<const CoordinateXY *> &comps;
+
+	// Declare type as noncopyable
+	ComponentCoordinateExtracter(const ComponentCoordinateExtracter &other) = delete;
+	ComponentCoordinateExtracter &operator=(const ComponentCoordinateExtracter &rhs) = delete;
+};
+
+} // namespace util
+} // namespace geom
+} // namespace geos
@@ -0,0 +1,64 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2006 Refractions Research Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: noding/FastSegmentSetIntersectionFinder.java r388 (JTS-1.12)
+ *
+ **********************************************************************/
+
+#pragma once
+
+#include <geos/algorithm/LineIntersector.hpp>
+#include <geos/noding/MCIndexSegmentSetMutualIntersector.hpp>
+#include <geos/noding/SegmentIntersectionDetector.hpp>
+#include <geos/noding/SegmentSetMutualIntersector.hpp>
+#include <geos/noding/SegmentString.hpp>
+#include <memory>
+
+namespace geos {
+namespace noding { // geos::noding
+
+/** \brief
+ * Finds if two sets of [SegmentStrings](@ref SegmentString) intersect.
+ *
+ * Uses indexing for fast performance and to optimize repeated tests
+ * against a target set of lines.
+ * Short-circuited to return as soon an intersection is found.
+ */
+class FastSegmentSetIntersectionFinder {
+private:
+	std::unique_ptr<MCIndexSegmentSetMutualIntersector> segSetMutInt;
+	std::unique_ptr<algorithm::LineIntersector> lineIntersector;
+
+public:
+	FastSegmentSetIntersectionFinder(SegmentString::ConstVect *baseSegStrings);
+
+	~FastSegmentSetIntersectionFinder() = default;
+
+	/**\brief
+	 * Gets the segment set intersector used by this class.
+	 *
+	 * This allows other uses of the same underlying indexed structure.
+	 *
+	 * @return the segment set intersector used
+	 */
+	const SegmentSetMutualIntersector *getSegmentSetIntersector() const {
+		return segSetMutInt.get();
+	}
+
+	bool intersects(SegmentString::ConstVect *segStrings);
+	bool intersects(SegmentString::ConstVect *segStrings, SegmentIntersectionDetector *intDetector);
+};
+
+} // namespace noding
+} // namespace geos
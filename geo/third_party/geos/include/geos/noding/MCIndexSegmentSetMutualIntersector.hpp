@@ -0,0 +1,86 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2006 Refractions Research Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: noding/MCIndexSegmentSetMutualIntersector.java r388 (JTS-1.12)
+ *
+ **********************************************************************/
+
+#pragma once
+
+#include <geos/index/chain/MonotoneChain.hpp>
+#include <geos/index/chain/MonotoneChainOverlapAction.hpp> // inherited
+#include <geos/index/strtree/TemplateSTRtree.hpp>          // for composition
+#include <geos/noding/SegmentSetMutualIntersector.hpp>     // inherited
+#include <vector>
+
+namespace geos {
+namespace noding { // geos::noding
+
+/** \brief
+ * Intersects two sets of [SegmentStrings](@ref SegmentString) using a index based
+ * on [MonotoneChains](@ref index::chain::MonotoneChain) and a
+ * [STRtree](@ref index::strtree::TemplateSTRtree).
+ *
+ * The base set is indexed once and can then be intersected with any
+ * number of test sets, which is what a prepared geometry needs.
+ */
+class MCIndexSegmentSetMutualIntersector : public SegmentSetMutualIntersector {
+public:
+	MCIndexSegmentSetMutualIntersector() : indexBuilt(false) {
+	}
+
+	~MCIndexSegmentSetMutualIntersector() override {
+	}
+
+	void setBaseSegments(SegmentString::ConstVect *segStrings) override;
+
+	// NOTE: re-populates the MonotoneChain vector with newly created chains
+	void process(SegmentString::ConstVect *segStrings) override;
+
+	class SegmentOverlapAction : public index::chain::MonotoneChainOverlapAction {
+	private:
+		SegmentIntersector &si;
+
+	public:
+		SegmentOverlapAction(SegmentIntersector &p_si) : index::chain::MonotoneChainOverlapAction(), si(p_si) {
+		}
+
+		void overlap(const index::chain::MonotoneChain &mc1, std::size_t start1, const index::chain::MonotoneChain &mc2,
+		             std::size_t start2) override;
+
+		// Declare type as noncopyable
+		SegmentOverlapAction(const SegmentOverlapAction &other) = delete;
+		SegmentOverlapAction &operator=(const SegmentOverlapAction &rhs) = delete;
+	};
+
+private:
+	typedef std::vector<index::chain::MonotoneChain> MonoChains;
+
+	/// The index of the base segments
+	index::strtree::TemplateSTRtree<const index::chain::MonotoneChain *> index;
+	/// Chains of the base segments, referenced by the index
+	MonoChains indexChains;
+	/// Chains of the test segments, rebuilt by every call to process
+	MonoChains monoChains;
+	bool indexBuilt;
+
+	void addToIndex(SegmentString *segStr);
+
+	void intersectChains();
+
+	void addToMonoChains(SegmentString *segStr);
+};
+
+} // namespace noding
+} // namespace geos
@@ -0,0 +1,132 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2006 Refractions Research Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: noding/SegmentIntersectionDetector.java r388 (JTS-1.12)
+ *
+ **********************************************************************/
+
+#pragma once
+
+#include <geos/algorithm/LineIntersector.hpp>
+#include <geos/geom/Coordinate.hpp>
+#include <geos/noding/SegmentIntersector.hpp>
+#include <geos/noding/SegmentString.hpp>
+
+namespace geos {
+namespace noding { // geos::noding
+
+/** \brief
+ * Detects and records an intersection between two {@link SegmentString}s,
+ * if one exists.
+ *
+ * This strategy can be configured to search for proper intersections.
+ * In this case, the presence of any intersection will still be recorded,
+ * but searching will continue until either a proper intersection has been
+ * found or no intersections are detected.
+ *
+ * Only a single intersection is recorded.
+ */
+class SegmentIntersectionDetector : public SegmentIntersector {
+private:
+	algorithm::LineIntersector *li;
+
+	bool findProper;
+	bool findAllTypes;
+
+	bool _hasIntersection;
+	bool _hasProperIntersection;
+	bool _hasNonProperIntersection;
+
+	geom::Coordinate intPt;
+
+public:
+	SegmentIntersectionDetector(algorithm::LineIntersector *p_li)
+	    : li(p_li), findProper(false), findAllTypes(false), _hasIntersection(false), _hasProperIntersection(false),
+	      _hasNonProperIntersection(false) {
+	}
+
+	void setFindProper(bool p_findProper) {
+		this->findProper = p_findProper;
+	}
+
+	void setFindAllIntersectionTypes(bool p_findAllTypes) {
+		this->findAllTypes = p_findAllTypes;
+	}
+
+	/** \brief
+	 * Tests whether an intersection was found.
+	 *
+	 * @return true if an intersection was found
+	 */
+	bool hasIntersection() const {
+		return _hasIntersection;
+	}
+
+	/** \brief
+	 * Tests whether a proper intersection was found.
+	 *
+	 * @return true if a proper intersection was found
+	 */
+	bool hasProperIntersection() const {
+		return _hasProperIntersection;
+	}
+
+	/** \brief
+	 * Tests whether a non-proper intersection was found.
+	 *
+	 * @return true if a non-proper intersection was found
+	 */
+	bool hasNonProperIntersection() const {
+		return _hasNonProperIntersection;
+	}
+
+	/** \brief
+	 * Gets the computed location of the intersection.
+	 * Due to round-off, the location may not be exact.
+	 *
+	 * @return the coordinate for the intersection location
+	 */
+	const geom::Coordinate &getIntersection() const {
+		return intPt;
+	}
+
+	/** \brief
+	 * This method is called by clients of the {@link SegmentIntersector} class to process
+	 * intersections for two segments of the {@link SegmentString}s being intersected.
+	 *
+	 * Note that some clients (such as MonotoneChains) may optimize away
+	 * this call for segment pairs which they have determined do not intersect
+	 * (e.g. by an disjoint envelope test).
+	 */
+	void processIntersections(SegmentString *e0, std::size_t segIndex0, SegmentString *e1,
+	                          std::size_t segIndex1) override;
+
+	bool isDone() const override {
+		// If finding all types, we can stop
+		// when both possible types have been found.
+		if (findAllTypes) {
+			return _hasProperIntersection && _hasNonProperIntersection;
+		}
+
+		// If searching for a proper intersection, only stop if one is found
+		if (findProper) {
+			return _hasProperIntersection;
+		}
+
+		return _hasIntersection;
+	}
+};
+
+} // namespace noding
+} // namespace geos
@@ -0,0 +1,79 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2006 Refractions Research Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: noding/SegmentSetMutualIntersector.java r388 (JTS-1.12)
+ *
+ **********************************************************************/
+
+#pragma once
+
+#include <geos/noding/SegmentIntersector.hpp>
+#include <geos/noding/SegmentString.hpp>
+
+namespace geos {
+namespace noding { // geos::noding
+
+/** \brief
+ * An intersector for the red-blue intersection problem.
+ *
+ * In this class of line arrangement problem,
+ * two disjoint sets of linestrings are intersected.
+ *
+ * Implementing classes must provide a way
+ * of supplying the base set of segment strings to
+ * test against (e.g. in the constructor,
+ * for straightforward thread-safety).
+ *
+ * In order to allow optimizing processing,
+ * the following condition is assumed to hold for each set:
+ * the only intersection between any two linestrings occurs at their endpoints.
+ * Implementations can take advantage of this fact to optimize processing.
+ */
+class SegmentSetMutualIntersector {
+public:
+	SegmentSetMutualIntersector() : segInt(nullptr) {
+	}
+
+	virtual ~SegmentSetMutualIntersector() {
+	}
+
+	/**
+	 * Sets the SegmentIntersector to use with this intersector.
+	 * The SegmentIntersector will either record or add intersection nodes
+	 * for the input segment strings.
+	 *
+	 * @param si the segment intersector to use
+	 */
+	void setSegmentIntersector(SegmentIntersector *si) {
+		segInt = si;
+	}
+
+	/**
+	 * @param segStrings a collection of {@link SegmentString}s to node
+	 */
+	virtual void setBaseSegments(SegmentString::ConstVect *segStrings) = 0;
+
+	/**
+	 * Computes the intersections for two collections of {@link SegmentString}s.
+	 *
+	 * @param segStrings a collection of {@link SegmentString}s to node
+	 */
+	virtual void process(SegmentString::ConstVect *segStrings) = 0;
+
+protected:
+	SegmentIntersector *segInt;
+};
+
+} // namespace noding
+} // namespace geos
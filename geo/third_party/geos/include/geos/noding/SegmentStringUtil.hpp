@@ -0,0 +1,69 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2006 Refractions Research Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: noding/SegmentStringUtil.java rev. 1.2 (JTS-1.9)
+ *
+ **********************************************************************/
+
+#pragma once
+
+#include <geos/geom/CoordinateSequence.hpp>
+#include <geos/geom/LineString.hpp>
+#include <geos/geom/util/LinearComponentExtracter.hpp>
+#include <geos/noding/BasicSegmentString.hpp>
+#include <geos/noding/SegmentString.hpp>
+#include <memory>
+#include <vector>
+
+namespace geos {
+namespace noding { // geos::noding
+
+/** \brief
+ * Utility methods for processing {@link SegmentString}s.
+ */
+class SegmentStringUtil {
+public:
+	/** \brief
+	 * Extracts all linear components from a given {@link geom::Geometry}
+	 * to {@link SegmentString}s.
+	 *
+	 * The SegmentString data item is set to be the source Geometry.
+	 * The returned SegmentStrings borrow the coordinates of the geometry,
+	 * which must outlive them; the caller owns the SegmentStrings.
+	 *
+	 * @param g the geometry to extract from
+	 * @param segStr a List of SegmentStrings (output parameter).
+	 */
+	static void extractSegmentStrings(const geom::Geometry *g, SegmentString::ConstVect &segStr) {
+		std::vector<const geom::LineString *> lines;
+		geom::util::LinearComponentExtracter::getLines(*g, lines);
+
+		for (const geom::LineString *line : lines) {
+			auto pts = const_cast<geom::CoordinateSequence *>(line->getCoordinatesRO());
+			segStr.push_back(new BasicSegmentString(pts, g));
+		}
+	}
+
+	static void extractSegmentStrings(const geom::Geometry *g,
+	                                  std::vector<std::unique_ptr<SegmentString>> &segStr) {
+		SegmentString::ConstVect ss;
+		extractSegmentStrings(g, ss);
+		for (const SegmentString *s : ss) {
+			segStr.emplace_back(const_cast<SegmentString *>(s));
+		}
+	}
+};
+
+} // namespace noding
+} // namespace geos
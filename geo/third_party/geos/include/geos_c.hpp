@@ -112,6 +112,13 @@ typedef void (*GEOSMessageHandler_r)(const char *message, void *userdata);
  */
 typedef struct GEOSGeom_t GEOSGeometry;
 
+/**
+ * Prepared geometry type.
+ * \see GEOSPrepare()
+ * \see GEOSPreparedGeom_destroy()
+ */
+typedef struct GEOSPrepGeom_t GEOSPreparedGeometry;
+
 /**
  * Coordinate sequence.
  * \see GEOSCoordSeq_create()
@@ -200,6 +207,13 @@ extern GEOSContextHandle_t GEOS_DLL GEOS_init_r(void);
  */
 extern GEOSContextHandle_t GEOS_DLL initGEOS_r(GEOSMessageHandler notice_function, GEOSMessageHandler error_function);
 
+/**
+ * Free the memory associated with a \ref GEOSContextHandle_t
+ * when you are finished calling GEOS functions.
+ * \param handle to be freed
+ */
+extern void GEOS_DLL GEOS_finish_r(GEOSContextHandle_t handle);
+
 /* ========== Geometry info ========== */
 
 /** \see GEOSGeomTypeId */
@@ -263,6 +277,46 @@ extern char GEOS_DLL GEOSIntersects_r(GEOSContextHandle_t handle, const GEOSGeom
 extern char GEOS_DLL GEOSRelatePattern_r(GEOSContextHandle_t handle, const GEOSGeometry *g1, const GEOSGeometry *g2,
                                          const char *pat);
 
+/* ========= Prepared Geometry Binary predicates ========= */
+
+/** \see GEOSPrepare */
+extern const GEOSPreparedGeometry GEOS_DLL *GEOSPrepare_r(GEOSContextHandle_t handle, const GEOSGeometry *g);
+
+/** \see GEOSPreparedGeom_destroy */
+extern void GEOS_DLL GEOSPreparedGeom_destroy_r(GEOSContextHandle_t handle, const GEOSPreparedGeometry *g);
+
+/** \see GEOSPreparedContains */
+extern char GEOS_DLL GEOSPreparedContains_r(GEOSContextHandle_t handle, const GEOSPreparedGeometry *pg1,
+                                            const GEOSGeometry *g2);
+
+/** \see GEOSPreparedContainsProperly */
+extern char GEOS_DLL GEOSPreparedContainsProperly_r(GEOSContextHandle_t handle, const GEOSPreparedGeometry *pg1,
+                                                    const GEOSGeometry *g2);
+
+/** \see GEOSPreparedCoveredBy */
+extern char GEOS_DLL GEOSPreparedCoveredBy_r(GEOSContextHandle_t handle, const GEOSPreparedGeometry *pg1,
+                                             const GEOSGeometry *g2);
+
+/** \see GEOSPreparedCovers */
+extern char GEOS_DLL GEOSPreparedCovers_r(GEOSContextHandle_t handle, const GEOSPreparedGeometry *pg1,
+                                          const GEOSGeometry *g2);
+
+/** \see GEOSPreparedDisjoint */
+extern char GEOS_DLL GEOSPreparedDisjoint_r(GEOSContextHandle_t handle, const GEOSPreparedGeometry *pg1,
+                                            const GEOSGeometry *g2);
+
+/** \see GEOSPreparedIntersects */
+extern char GEOS_DLL GEOSPreparedIntersects_r(GEOSContextHandle_t handle, const GEOSPreparedGeometry *pg1,
+                                              const GEOSGeometry *g2);
+
+/** \see GEOSPreparedTouches */
+extern char GEOS_DLL GEOSPreparedTouches_r(GEOSContextHandle_t handle, const GEOSPreparedGeometry *pg1,
+                                           const GEOSGeometry *g2);
+
+/** \see GEOSPreparedWithin */
+extern char GEOS_DLL GEOSPreparedWithin_r(GEOSContextHandle_t handle, const GEOSPreparedGeometry *pg1,
+                                          const GEOSGeometry *g2);
+
 /* ========== Coordinate Sequence functions ========== */
 
 /** \see GEOSCoordSeq_create */
@@ -357,6 +411,9 @@ extern void GEOS_DLL GEOSSTRtree_destroy_r(GEOSContextHandle_t handle, GEOSSTRtr
 /** \see GEOSGeom_destroy */
 extern void GEOS_DLL GEOSGeom_destroy_r(GEOSContextHandle_t handle, GEOSGeometry *g);
 
+/** \see GEOSGeom_clone */
+extern GEOSGeometry GEOS_DLL *GEOSGeom_clone_r(GEOSContextHandle_t handle, const GEOSGeometry *g);
+
 /* ========= Topology Operations ========= */
 
 /** \see GEOSDifference */
@@ -429,9 +486,11 @@ extern GEOSGeometry GEOS_DLL *GEOSBufferWithParams_r(GEOSContextHandle_t handle,
 ///@{
 
 /**
- * For non-reentrant code, set up an execution contact, and associate
+ * Set up the execution context of the calling thread, and associate
  * \ref GEOSMessageHandler functions with it, to pass error and notice
- * messages back to the calling application.
+ * messages back to the calling application. Every thread gets its own
+ * context, created on first use and freed when the thread exits, so the
+ * non-reentrant API may be used from several threads at once.
  * <pre>
  * typedef void (*GEOSMessageHandler)(const char *fmt, ...);
  * </pre>
@@ -582,6 +641,14 @@ extern GEOSGeometry GEOS_DLL *GEOSGeom_createCollection(int type, GEOSGeometry *
  */
 extern void GEOS_DLL GEOSGeom_destroy(GEOSGeometry *g);
 
+/**
+ * Create a new copy of the input geometry.
+ * \param g The geometry to copy
+ * \return A newly allocated geometry. NULL on exception.
+ * Caller is responsible for freeing with GEOSGeom_destroy().
+ */
+extern GEOSGeometry GEOS_DLL *GEOSGeom_clone(const GEOSGeometry *g);
+
 ///@}
 
 /* ========== Geometry info ========== */
@@ -1060,6 +1127,125 @@ extern char GEOS_DLL GEOSIntersects(const GEOSGeometry *g1, const GEOSGeometry *
  */
 extern char GEOS_DLL GEOSRelatePattern(const GEOSGeometry *g1, const GEOSGeometry *g2, const char *pat);
 
+///@}
+
+/* ========== Prepared Geometry Binary Predicates ========== */
+
+/** @name Prepared Geometry
+ * A \ref GEOSPreparedGeometry is a wrapper around \ref GEOSGeometry
+ * that adds in a spatial index on the edges of the geometry. This
+ * internal index allows spatial predicates to evaluate much faster,
+ * so for cases in which the same base geometry will be used over and
+ * over again for predicate tests, wrapping it in a \ref GEOSPreparedGeometry
+ * is a best practice.
+ *
+ * The caller retains ownership of the base geometry, and after
+ * processing is complete, must free **both** the prepared and the
+ * base geometry. (Ideally, destroy the prepared geometry first, as
+ * it has an internal reference to the base geometry.)
+ *
+ * A prepared geometry builds its indexes lazily and must not be
+ * used from more than one thread at a time.
+ */
+///@{
+
+/**
+ * Create a Prepared Geometry.
+ * The caller retains ownership of the base geometry, and after
+ * processing is complete, must free **both** the prepared and the
+ * base geometry.
+ * \param g The base geometry to wrap in a prepared geometry.
+ * \return A prepared geometry. Caller is responsible for freeing with
+ *         GEOSPreparedGeom_destroy()
+ */
+extern const GEOSPreparedGeometry GEOS_DLL *GEOSPrepare(const GEOSGeometry *g);
+
+/**
+ * Free the memory associated with a \ref GEOSPreparedGeometry.
+ * Caller must separately free the base \ref GEOSGeometry used
+ * to create the prepared geometry.
+ * \param g Prepared geometry to destroy.
+ */
+extern void GEOS_DLL GEOSPreparedGeom_destroy(const GEOSPreparedGeometry *g);
+
+/**
+ * Using a \ref GEOSPreparedGeometry do a high performance
+ * calculation of whether the provided geometry is contained.
+ * \param pg1 The prepared geometry
+ * \param g2 The geometry to test
+ * \returns 1 on true, 0 on false, 2 on exception
+ * \see GEOSContains
+ */
+extern char GEOS_DLL GEOSPreparedContains(const GEOSPreparedGeometry *pg1, const GEOSGeometry *g2);
+
+/**
+ * Using a \ref GEOSPreparedGeometry do a high performance
+ * calculation of whether the provided geometry is contained properly.
+ * \param pg1 The prepared geometry
+ * \param g2 The geometry to test
+ * \returns 1 on true, 0 on false, 2 on exception
+ */
+extern char GEOS_DLL GEOSPreparedContainsProperly(const GEOSPreparedGeometry *pg1, const GEOSGeometry *g2);
+
+/**
+ * Using a \ref GEOSPreparedGeometry do a high performance
+ * calculation of whether the prepared geometry is covered by the provided geometry.
+ * \param pg1 The prepared geometry
+ * \param g2 The geometry to test
+ * \returns 1 on true, 0 on false, 2 on exception
+ */
+extern char GEOS_DLL GEOSPreparedCoveredBy(const GEOSPreparedGeometry *pg1, const GEOSGeometry *g2);
+
+/**
+ * Using a \ref GEOSPreparedGeometry do a high performance
+ * calculation of whether the prepared geometry covers the provided geometry.
+ * \param pg1 The prepared geometry
+ * \param g2 The geometry to test
+ * \returns 1 on true, 0 on false, 2 on exception
+ */
+extern char GEOS_DLL GEOSPreparedCovers(const GEOSPreparedGeometry *pg1, const GEOSGeometry *g2);
+
+/**
+ * Using a \ref GEOSPreparedGeometry do a high performance
+ * calculation of whether the prepared geometry is disjoint from the provided geometry.
+ * \param pg1 The prepared geometry
+ * \param g2 The geometry to test
+ * \returns 1 on true, 0 on false, 2 on exception
+ * \see GEOSDisjoint
+ */
+extern char GEOS_DLL GEOSPreparedDisjoint(const GEOSPreparedGeometry *pg1, const GEOSGeometry *g2);
+
+/**
+ * Using a \ref GEOSPreparedGeometry do a high performance
+ * calculation of whether the prepared geometry intersects the provided geometry.
+ * \param pg1 The prepared geometry
+ * \param g2 The geometry to test
+ * \returns 1 on true, 0 on false, 2 on exception
+ * \see GEOSIntersects
+ */
+extern char GEOS_DLL GEOSPreparedIntersects(const GEOSPreparedGeometry *pg1, const GEOSGeometry *g2);
+
+/**
+ * Using a \ref GEOSPreparedGeometry do a high performance
+ * calculation of whether the prepared geometry touches the provided geometry.
+ * \param pg1 The prepared geometry
+ * \param g2 The geometry to test
+ * \returns 1 on true, 0 on false, 2 on exception
+ * \see GEOSTouches
+ */
+extern char GEOS_DLL GEOSPreparedTouches(const GEOSPreparedGeometry *pg1, const GEOSGeometry *g2);
+
+/**
+ * Using a \ref GEOSPreparedGeometry do a high performance
+ * calculation of whether the prepared geometry is within the provided geometry.
+ * \param pg1 The prepared geometry
+ * \param g2 The geometry to test
+ * \returns 1 on true, 0 on false, 2 on exception
+ */
+extern char GEOS_DLL GEOSPreparedWithin(const GEOSPreparedGeometry *pg1, const GEOSGeometry *g2);
+
+///@}
+
 #endif /* #ifndef GEOS_USE_ONLY_R_API */
 
 #ifdef __cplusplus
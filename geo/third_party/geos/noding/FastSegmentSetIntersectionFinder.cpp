@@ -0,0 +1,44 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2006 Refractions Research Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: noding/FastSegmentSetIntersectionFinder.java r388 (JTS-1.12)
+ *
+ **********************************************************************/
+
+#include <geos/noding/FastSegmentSetIntersectionFinder.hpp>
+
+namespace geos {
+namespace noding { // geos::noding
+
+FastSegmentSetIntersectionFinder::FastSegmentSetIntersectionFinder(SegmentString::ConstVect *baseSegStrings)
+    : segSetMutInt(new MCIndexSegmentSetMutualIntersector()), lineIntersector(new algorithm::LineIntersector()) {
+	segSetMutInt->setBaseSegments(baseSegStrings);
+}
+
+bool FastSegmentSetIntersectionFinder::intersects(SegmentString::ConstVect *segStrings) {
+	SegmentIntersectionDetector intFinder(lineIntersector.get());
+
+	return this->intersects(segStrings, &intFinder);
+}
+
+bool FastSegmentSetIntersectionFinder::intersects(SegmentString::ConstVect *segStrings,
+                                                  SegmentIntersectionDetector *intDetector) {
+	segSetMutInt->setSegmentIntersector(intDetector);
+	segSetMutInt->process(segStrings);
+
+	return intDetector->hasIntersection();
+}
+
+} // namespace noding
+} // namespace geos
@@ -0,0 +1,93 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2006 Refractions Research Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: noding/MCIndexSegmentSetMutualIntersector.java r388 (JTS-1.12)
+ *
+ **********************************************************************/
+
+#include <geos/index/chain/MonotoneChain.hpp>
+#include <geos/index/chain/MonotoneChainBuilder.hpp>
+#include <geos/noding/MCIndexSegmentSetMutualIntersector.hpp>
+#include <geos/noding/SegmentIntersector.hpp>
+#include <geos/noding/SegmentString.hpp>
+#include <geos/util/Interrupt.hpp>
+
+using geos::index::chain::MonotoneChain;
+using geos::index::chain::MonotoneChainBuilder;
+
+namespace geos {
+namespace noding { // geos::noding
+
+/*private*/
+void MCIndexSegmentSetMutualIntersector::addToIndex(SegmentString *segStr) {
+	MonotoneChainBuilder::getChains(segStr->getCoordinates(), segStr, indexChains);
+}
+
+/*private*/
+void MCIndexSegmentSetMutualIntersector::addToMonoChains(SegmentString *segStr) {
+	MonotoneChainBuilder::getChains(segStr->getCoordinates(), segStr, monoChains);
+}
+
+/*private*/
+void MCIndexSegmentSetMutualIntersector::intersectChains() {
+	SegmentOverlapAction overlapAction(*segInt);
+
+	for (const MonotoneChain &queryChain : monoChains) {
+		GEOS_CHECK_FOR_INTERRUPTS();
+
+		index.query(queryChain.getEnvelope(), [&queryChain, &overlapAction, this](const MonotoneChain *testChain) {
+			queryChain.computeOverlaps(testChain, &overlapAction);
+			return !segInt->isDone(); // abort early if segInt->isDone()
+		});
+
+		if (segInt->isDone()) {
+			return;
+		}
+	}
+}
+
+/*public*/
+void MCIndexSegmentSetMutualIntersector::setBaseSegments(SegmentString::ConstVect *segStrings) {
+	// NOTE - mloskot: const qualifier is removed silently, dirty.
+	for (const SegmentString *css : *segStrings) {
+		addToIndex(const_cast<SegmentString *>(css));
+	}
+	// The chains must not move once they are in the index
+	for (const MonotoneChain &mc : indexChains) {
+		index.insert(mc.getEnvelope(), &mc);
+	}
+	indexBuilt = true;
+}
+
+/*public*/
+void MCIndexSegmentSetMutualIntersector::process(SegmentString::ConstVect *segStrings) {
+	monoChains.clear();
+
+	for (const SegmentString *css : *segStrings) {
+		addToMonoChains(const_cast<SegmentString *>(css));
+	}
+	intersectChains();
+}
+
+/* public */
+void MCIndexSegmentSetMutualIntersector::SegmentOverlapAction::overlap(const MonotoneChain &mc1, std::size_t start1,
+                                                                        const MonotoneChain &mc2, std::size_t start2) {
+	SegmentString *ss1 = const_cast<SegmentString *>(static_cast<const SegmentString *>(mc1.getContext()));
+	SegmentString *ss2 = const_cast<SegmentString *>(static_cast<const SegmentString *>(mc2.getContext()));
+
+	si.processIntersections(ss1, start1, ss2, start2);
+}
+
+} // namespace noding
+} // namespace geos
@@ -0,0 +1,66 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2006 Refractions Research Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: noding/SegmentIntersectionDetector.java r388 (JTS-1.12)
+ *
+ **********************************************************************/
+
+#include <geos/noding/SegmentIntersectionDetector.hpp>
+
+namespace geos {
+namespace noding { // geos::noding
+
+void SegmentIntersectionDetector::processIntersections(SegmentString *e0, std::size_t segIndex0, SegmentString *e1,
+                                                       std::size_t segIndex1) {
+	// don't bother intersecting a segment with itself
+	if (e0 == e1 && segIndex0 == segIndex1) {
+		return;
+	}
+
+	const geom::Coordinate &p00 = e0->getCoordinate(segIndex0);
+	const geom::Coordinate &p01 = e0->getCoordinate(segIndex0 + 1);
+	const geom::Coordinate &p10 = e1->getCoordinate(segIndex1);
+	const geom::Coordinate &p11 = e1->getCoordinate(segIndex1 + 1);
+
+	li->computeIntersection(p00, p01, p10, p11);
+
+	if (li->hasIntersection()) {
+		// record intersection info
+		_hasIntersection = true;
+
+		bool isProper = li->isProper();
+
+		if (isProper) {
+			_hasProperIntersection = true;
+		} else {
+			_hasNonProperIntersection = true;
+		}
+
+		// If this is the kind of intersection we are searching for
+		// OR no location has yet been recorded
+		// save the location data
+		bool saveLocation = true;
+		if (findProper && !isProper) {
+			saveLocation = false;
+		}
+
+		if (saveLocation) {
+			// record intersection location (approximate)
+			intPt = li->getIntersection(0);
+		}
+	}
+}
+
+} // namespace noding
+} // namespace geos
@@ -0,0 +1,47 @@
+#!/usr/bin/env bash
+# Regenerates the WKT lexer and parser from geo/parser/lwin_wkt_lex.l and
+# geo/parser/lwin_wkt_parse.y. The generated files are committed, so only run
+# this after editing the grammar, with the pinned tool versions below.
+set -euo pipefail
+
+FLEX_VERSION=2.6.4
+BISON_VERSION=3.8.2
+
+ROOT="$(cd "$(dirname "$0")/.." && pwd)"
+FLEX="${FLEX:-flex}"
+BISON="${BISON:-bison}"
+
+check_version() {
+	local tool="$1" want="$2" got
+	got="$("$tool" --version | head -n 1 | grep -Eo '[0-9]+\.[0-9]+(\.[0-9]+)?' | head -n 1)"
+	if [ "$got" != "$want" ]; then
+		echo "$tool $want is required, found ${got:-none}" >&2
+		exit 1
+	fi
+}
+check_version "$FLEX" "$FLEX_VERSION"
+check_version "$BISON" "$BISON_VERSION"
+
+# Generate from a copy laid out as in the DuckDB tree, so the #line
+# directives and the include guard stay the same as in the committed files.
+WORK="$(mktemp -d)"
+trap 'rm -rf "$WORK"' EXIT
+mkdir -p "$WORK/extension/geo/parser" "$WORK/extension/geo/include/parser"
+cp "$ROOT/geo/parser/lwin_wkt_lex.l" "$ROOT/geo/parser/lwin_wkt_parse.y" "$WORK/extension/geo/parser/"
+
+cd "$WORK"
+"$BISON" -o extension/geo/parser/lwin_wkt_parse.cpp \
+	--defines=extension/geo/include/parser/lwin_wkt_parse.hpp extension/geo/parser/lwin_wkt_parse.y
+"$FLEX" -o extension/geo/parser/lwin_wkt_lex.cpp extension/geo/parser/lwin_wkt_lex.l
+
+# Everything else in the extension lives in the duckdb namespace
+awk 'skip && /^$/ { skip = 0; next } { print }
+     /^# define YY_WKT_YY_.*_INCLUDED$/ { print ""; print "namespace duckdb {"; print "" }
+     /^int wkt_yyparse/ { print ""; print ""; print "} // namespace duckdb"; skip = 1 }' \
+	extension/geo/include/parser/lwin_wkt_parse.hpp >"$ROOT/geo/include/parser/lwin_wkt_parse.hpp"
+sed -e 's|^/\*namespace duckdb {\*/$|namespace duckdb {|' -e '${/^$/d;}' extension/geo/parser/lwin_wkt_parse.cpp \
+	>"$ROOT/geo/parser/lwin_wkt_parse.cpp"
+echo "} // namespace duckdb" >>"$ROOT/geo/parser/lwin_wkt_parse.cpp"
+awk '{ print } /^#define FLEXINT_H$/ { print "namespace duckdb {" }' extension/geo/parser/lwin_wkt_lex.cpp \
+	>"$ROOT/geo/parser/lwin_wkt_lex.cpp"
+printf '\n} // namespace duckdb\n' >>"$ROOT/geo/parser/lwin_wkt_lex.cpp"